@@ -40,11 +40,27 @@ static char _AlgTstFourier_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/time.h>
 #include <Alc.h>
 #include <Alg.h>
 
+static AlgError			AlgTstFourPlan(
+				  int d,
+				  int n,
+				  int realFlg,
+				  int inv,
+				  double *a10,
+				  double *a11,
+				  double **a20,
+				  double **a21,
+				  double ***a30,
+				  double ***a31);
+static double			AlgTstFourMaxDiff(
+				  size_t cnt,
+				  double *a,
+				  double *b);
 static void    			AlgTstFourOutput(
 				  int d,
 				  int n,
@@ -89,6 +105,7 @@ int             main(int argc, char **argv)
   		n = 8,
 		asyFlg = 0,
 		outFlg = 1,
+		planFlg = 0,
 		rndFlg = 0,
 		realFlg = 0,
 		scaleFlg = 0,
@@ -97,18 +114,24 @@ int             main(int argc, char **argv)
 		option,
   		ok = 1,
 		usage = 0;
+  size_t	cnt = 0;
   double	scale = 1.0,
   		z = 0.0;
-  double	*a1[2];
-  double	**a2[2];
-  double	***a3[2];
+  double	*a1[2],
+  		*p1[2];
+  double	**a2[2],
+  		**p2[2];
+  double	***a3[2],
+  		***p3[2];
+  double	*aBase = NULL,
+  		*pBase = NULL;
   struct timeval times[3];
   const	double	asy = ((1.0 / 7.0) + ALG_M_PI) * ALG_M_E / 13;
-  static char	optList[] = "chrsuyNRTd:n:z:";
+  static char	optList[] = "chprsuyNRTd:n:z:";
 
-  a1[0] = a1[1] = NULL;
-  a2[0] = a2[1] = NULL;
-  a3[0] = a3[1] = NULL;
+  a1[0] = a1[1] = p1[0] = p1[1] = NULL;
+  a2[0] = a2[1] = p2[0] = p2[1] = NULL;
+  a3[0] = a3[1] = p3[0] = p3[1] = NULL;
   while((usage == 0) && ((option = getopt(argc, argv, optList)) != -1))
   {
     switch(option)
@@ -116,6 +139,9 @@ int             main(int argc, char **argv)
       case 'c':
 	realFlg = 0;
 	break;
+      case 'p':
+	planFlg = 1;
+	break;
       case 'r':
 	realFlg = 1;
 	break;
@@ -276,6 +302,58 @@ int             main(int argc, char **argv)
       default:
         break;
     }
+    /* Copy the array(s) for the plan based transforms. */
+    if(ok && planFlg)
+    {
+      switch(d)
+      {
+        case 1:
+	  cnt = n2;
+	  if((p1[0] = AlcMalloc(cnt * sizeof(double))) == NULL)
+	  {
+	    ok = 0;
+	  }
+	  else
+	  {
+	    aBase = a1[0];
+	    pBase = p1[0];
+	    p1[1] = (realFlg)? NULL: p1[0] + n;
+	  }
+	  break;
+	case 2:
+	  cnt = n2 * n;
+	  if(AlcDouble2Malloc(&(p2[0]), n2, n) != ALC_ER_NONE)
+	  {
+	    ok = 0;
+	  }
+	  else
+	  {
+	    aBase = *(a2[0]);
+	    pBase = *(p2[0]);
+	    p2[1] = (realFlg)? NULL: p2[0] + n;
+	  }
+	  break;
+	case 3:
+	  cnt = n2 * n * n;
+	  if(AlcDouble3Malloc(&(p3[0]), n2, n, n) != ALC_ER_NONE)
+	  {
+	    ok = 0;
+	  }
+	  else
+	  {
+	    aBase = **(a3[0]);
+	    pBase = **(p3[0]);
+	    p3[1] = (realFlg)? NULL: p3[0] + n;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      if(ok)
+      {
+        (void )memcpy(pBase, aBase, cnt * sizeof(double));
+      }
+    }
     if(ok == 0)
     {
       (void )fprintf(stderr,
@@ -345,6 +423,25 @@ int             main(int argc, char **argv)
 		     (1000000.0 * times[2].tv_sec) + times[2].tv_usec);
     }
   }
+  if(ok && planFlg)
+  {
+    double	dif,
+    		tol;
+
+    /* Compare the plan based and legacy forward transforms. */
+    ok = (AlgTstFourPlan(d, n, realFlg, 0, p1[0], p1[1], p2[0], p2[1],
+                         p3[0], p3[1]) == ALG_ERR_NONE);
+    if(ok)
+    {
+      tol = 1.0e-10 * cnt;
+      dif = AlgTstFourMaxDiff(cnt, aBase, pBase);
+      ok = (dif < tol);
+      (void )fprintf(stderr,
+                     "%s: plan and legacy forward transform maximum difference "
+		     "%g (%s)\n",
+		     *argv, dif, (ok)? "pass": "FAIL");
+    }
+  }
   if(ok)
   {
     /* Output array values. */
@@ -406,6 +503,25 @@ int             main(int argc, char **argv)
 		     (1000000.0 * times[2].tv_sec) + times[2].tv_usec);
     }
   }
+  if(ok && planFlg)
+  {
+    double	dif,
+    		tol;
+
+    /* Compare the plan based and legacy inverse transforms. */
+    ok = (AlgTstFourPlan(d, n, realFlg, 1, p1[0], p1[1], p2[0], p2[1],
+                         p3[0], p3[1]) == ALG_ERR_NONE);
+    if(ok)
+    {
+      tol = 1.0e-10 * cnt;
+      dif = AlgTstFourMaxDiff(cnt, aBase, pBase);
+      ok = (dif < tol);
+      (void )fprintf(stderr,
+                     "%s: plan and legacy inverse transform maximum difference "
+		     "%g (%s)\n",
+		     *argv, dif, (ok)? "pass": "FAIL");
+    }
+  }
   if(ok)
   {
     /* Output array values. */
@@ -418,14 +534,19 @@ int             main(int argc, char **argv)
   AlcFree(a1[0]);
   AlcDouble2Free(a2[0]);
   AlcDouble3Free(a3[0]);
+  AlcFree(p1[0]);
+  AlcDouble2Free(p2[0]);
+  AlcDouble3Free(p3[0]);
   if(usage)
   {
     (void )fprintf(stderr,
-    "Usage: %s [-h] [-c] [-r] [-u] [-y] [-N] [-R] [-T]\n"
+    "Usage: %s [-h] [-c] [-p] [-r] [-u] [-y] [-N] [-R] [-T]\n"
     "\t\t[-d #] [-n #] [-z #]\n"
     "Tests for the libAlg Fourier transform code.\n"
     "Options are:\n"
     "  -c  Complex transforms, as opposed to real (value %s).\n"
+    "  -p  Also compute the transforms using transform plans and\n"
+    "      compare these with the legacy transforms (value %s).\n"
     "  -r  Real transforms, as opposed to complex (value %s).\n"
     "  -s  Rescale output (value %s).\n"
     "  -u  Use buffers (value %s).\n"
@@ -439,6 +560,7 @@ int             main(int argc, char **argv)
     "      considered zero in output (value %lg)\n",
     *argv,
     (realFlg)? "false": "true",
+    (planFlg)? "true": "false",
     (realFlg)? "true": "false",
     (scaleFlg)? "true": "false",
     (useBuf)? "true": "false",
@@ -452,6 +574,85 @@ int             main(int argc, char **argv)
   return(!ok);
 }
 
+/*!
+* \return	Alg error code.
+* \ingroup	AlgTst
+* \brief	Computes a transform of the array values in place using
+*		transform plans.
+* \param	d			Array dimension.
+* \param	n			Array size.
+* \param	realFlg			Real data if non zero.
+* \param	inv			Inverse transform if non zero.
+* \param	a10			Array for 1D real / complex conjugate.
+* \param	a11			Array for 1D imaginary.
+* \param	a20			Array for 2D real / complex conjugate.
+* \param	a21			Array for 2D imaginary.
+* \param	a30			Array for 3D real / complex conjugate.
+* \param	a31			Array for 3D imaginary.
+*/
+static AlgError	AlgTstFourPlan(int d, int n, int realFlg, int inv,
+			       double *a10, double *a11,
+			       double **a20, double **a21,
+			       double ***a30, double ***a31)
+{
+  AlgFourPlan	*plan;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan = AlgFourPlanNew(n, &errNum)) != NULL)
+  {
+    switch(d)
+    {
+      case 1:
+	errNum = (realFlg)?
+		 AlgFourPlanExecReal1D(plan, a10, 1, inv):
+		 AlgFourPlanExec1D(plan, a10, a11, 1, inv);
+	break;
+      case 2:
+	errNum = (realFlg)?
+		 AlgFourPlanExecReal2D(plan, plan, a20, inv):
+		 AlgFourPlanExec2D(plan, plan, a20, a21, inv);
+	break;
+      case 3:
+	errNum = (realFlg)?
+		 AlgFourPlanExecReal3D(plan, plan, plan, a30, inv):
+		 AlgFourPlanExec3D(plan, plan, plan, a30, a31, inv);
+	break;
+      default:
+	errNum = ALG_ERR_FUNC;
+	break;
+    }
+    AlgFourPlanFree(plan);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Maximum absolute difference.
+* \ingroup	AlgTst
+* \brief	Computes the maximum absolute difference between the
+*		values of two arrays.
+* \param	cnt			Number of values in each array.
+* \param	a			First array.
+* \param	b			Second array.
+*/
+static double	AlgTstFourMaxDiff(size_t cnt, double *a, double *b)
+{
+  size_t	i;
+  double	dif = 0.0;
+
+  for(i = 0; i < cnt; ++i)
+  {
+    double	d;
+
+    d = fabs(a[i] - b[i]);
+    if(d > dif)
+    {
+      dif = d;
+    }
+  }
+  return(dif);
+}
+
 /*!
 * \ingroup	AlgTst
 * \brief	Outputs the array values.
@@ -0,0 +1,364 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgTstMatrixCGSolve3_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binAlgTst/AlgTstMatrixCGSolve3.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test comparing the solutions of AlgMatrixCGSolve() and
+* 		AlgMatrixCGSolveFn() with that of AlgMatrixSVSolve().
+* \ingroup	binAlgTst
+*/
+#include <stdio.h>
+#include <float.h>
+#include <Alc.h>
+#include <Alg.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+/*!
+* \struct	_AlgTstCGPreData
+* \ingroup	binAlgTst
+* \brief	Data for the Jacobi preconditioning function.
+*/
+typedef struct _AlgTstCGPreData
+{
+  size_t	n;			/*!< Number of elements. */
+  double	*iD;			/*!< Inverse of the matrix diagonal. */
+} AlgTstCGPreData;
+
+static void			AlgTstCGMul(
+				  void *aDat,
+				  double *xV,
+				  double *yV);
+static void			AlgTstCGPre(
+				  void *pDat,
+				  double *rV,
+				  double *zV);
+static double			AlgTstCGMaxDiff(
+				  size_t n,
+				  double *aV,
+				  double *bV);
+
+int		main(int argc, char *argv[])
+{
+  int		id0,
+		id1,
+		option,
+		ok = 1,
+		usage = 0,
+		verbose = 0,
+		itr[2],
+  		maxItr = 1000;
+  long		seed = 0;
+  size_t	sz = 200;
+  double	shape = 0.1,
+		tol = 1.0e-12,
+		maxErr = 1.0e-11;
+  double	err[2],
+		resid[2];
+  AlgMatrix	a,
+  		s,
+  		w;
+  AlgTstCGPreData pDat;
+  double	*b = NULL,
+  		*p = NULL,
+  		*x[3];
+  AlgError	errCode = ALG_ERR_NONE;
+  const char	*optList = "d:e:hi:n:s:t:v";
+
+  a.core = s.core = w.core = NULL;
+  x[0] = x[1] = x[2] = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'd':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'e':
+        if((sscanf(optarg, "%lg", &maxErr) != 1) || (maxErr < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'i':
+        if((sscanf(optarg, "%d", &maxItr) != 1) || (maxItr < 0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+        if((sscanf(optarg, "%zd", &sz) != 1) || (sz < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if((sscanf(optarg, "%lg", &shape) != 1) || (shape <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 't':
+        if((sscanf(optarg, "%lg", &tol) != 1) || (tol < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0);
+  if(ok)
+  {
+    a.rect = AlgMatrixRectNew(sz, sz, &errCode);
+    if(errCode == ALG_ERR_NONE)
+    {
+      s.rect = AlgMatrixRectNew(sz, sz, &errCode);
+    }
+    if(errCode == ALG_ERR_NONE)
+    {
+      w.rect = AlgMatrixRectNew(4, sz, &errCode);
+    }
+    if(errCode == ALG_ERR_NONE)
+    {
+      if(((b = (double *)AlcMalloc(sz * sizeof(double))) == NULL) ||
+         ((p = (double *)AlcMalloc(sz * sizeof(double))) == NULL) ||
+         ((x[0] = (double *)AlcMalloc(sz * sizeof(double))) == NULL) ||
+         ((x[1] = (double *)AlcMalloc(sz * sizeof(double))) == NULL) ||
+         ((x[2] = (double *)AlcMalloc(sz * sizeof(double))) == NULL))
+      {
+        errCode = ALG_ERR_MALLOC;
+      }
+    }
+    if(errCode != ALG_ERR_NONE)
+    {
+      (void )fprintf(stderr, "%s: Failed to allocate matrices\n", *argv);
+      ok = 0;
+    }
+  }
+  if(ok)
+  {
+    double	*pos;
+
+    /* Build a symmetric positive definite inverse multiquadric
+     * interpolation matrix from random points in the unit cube, with
+     * a random right hand side. */
+    pos = x[2];
+    AlgRandSeed(seed);
+    for(id0 = 0; id0 < sz; ++id0)
+    {
+      x[0][id0] = AlgRandUniform();
+      x[1][id0] = AlgRandUniform();
+      pos[id0] = AlgRandUniform();
+      b[id0] = AlgRandUniform() - 0.5;
+    }
+    for(id1 = 0; id1 < sz; ++id1)
+    {
+      for(id0 = 0; id0 <= id1; ++id0)
+      {
+	double	d,
+		  r2;
+
+	d = x[0][id1] - x[0][id0];
+	r2 = d * d;
+	d = x[1][id1] - x[1][id0];
+	r2 += d * d;
+	d = pos[id1] - pos[id0];
+	r2 += d * d;
+	d = 1.0 / sqrt(r2 + shape * shape);
+	a.rect->array[id1][id0] = a.rect->array[id0][id1] = d;
+      }
+      p[id1] = 1.0 / a.rect->array[id1][id1];
+    }
+    /* Solve using the singular value decomposition. */
+    AlgMatrixCopy(s, a);
+    AlgVectorCopy(x[2], b, sz);
+    errCode = AlgMatrixSVSolve(s, x[2], DBL_EPSILON, NULL);
+    if(errCode != ALG_ERR_NONE)
+    {
+      (void )fprintf(stderr, "%s: Failed to solve using SVD, error code = %d\n",
+                     *argv, (int )errCode);
+      ok = 0;
+    }
+  }
+  if(ok)
+  {
+    /* Solve using the conjugate gradient method, with the matrix and
+     * then matrix free with a Jacobi preconditioner. */
+    AlgVectorZero(x[0], sz);
+    errCode = AlgMatrixCGSolve(a, x[0], b, w, NULL, NULL, tol, maxItr,
+                               resid + 0, itr + 0);
+    if(errCode == ALG_ERR_NONE)
+    {
+      pDat.n = sz;
+      pDat.iD = p;
+      AlgVectorZero(x[1], sz);
+      errCode = AlgMatrixCGSolveFn(sz, AlgTstCGMul, &a, x[1], b, w,
+                                   AlgTstCGPre, &pDat, tol, maxItr,
+				   resid + 1, itr + 1);
+    }
+    if(errCode != ALG_ERR_NONE)
+    {
+      (void )fprintf(stderr, "%s: Failed to solve using CG, error code = %d\n",
+                     *argv, (int )errCode);
+      ok = 0;
+    }
+  }
+  if(ok)
+  {
+    double	nrm;
+
+    nrm = AlgTstCGMaxDiff(sz, x[2], NULL);
+    if(nrm < DBL_EPSILON)
+    {
+      nrm = 1.0;
+    }
+    for(id0 = 0; id0 < 2; ++id0)
+    {
+      err[id0] = AlgTstCGMaxDiff(sz, x[id0], x[2]) / nrm;
+      if(err[id0] > maxErr)
+      {
+        ok = 0;
+      }
+    }
+    if(verbose)
+    {
+      (void )printf("AlgMatrixCGSolve():   itr = %d, resid = %g\n",
+                    itr[0], resid[0]);
+      (void )printf("AlgMatrixCGSolveFn(): itr = %d, resid = %g\n",
+                    itr[1], resid[1]);
+    }
+    (void )printf("%s: CG and SVD solution relative difference %g %g (%s)\n",
+                  *argv, err[0], err[1], (ok)? "pass": "FAIL");
+  }
+  (void )AlgMatrixFree(a);
+  (void )AlgMatrixFree(s);
+  (void )AlgMatrixFree(w);
+  AlcFree(b);
+  AlcFree(p);
+  AlcFree(x[0]);
+  AlcFree(x[1]);
+  AlcFree(x[2]);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v] [-d#] [-e#] [-i#] [-n#] [-s#] [-t#]\n%s",
+    *argv,
+    "Test comparing the solutions of AlgMatrixCGSolve() and\n"
+    "AlgMatrixCGSolveFn() with that of AlgMatrixSVSolve() for a\n"
+    "symmetric positive definite inverse multiquadric matrix.\n"
+    "  -d  Seed for random values.\n"
+    "  -e  Maximum relative difference of the solutions.\n"
+    "  -h  Output this help message.\n"
+    "  -i  Maximum number of iterations.\n"
+    "  -n  Matrix size.\n"
+    "  -s  Inverse multiquadric shape parameter.\n"
+    "  -t  Conjugate gradient tolerance.\n"
+    "  -v  Verbose output.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \ingroup	binAlgTst
+* \brief	Matrix multiplication function for AlgMatrixCGSolveFn().
+* \param	aDat			The matrix.
+* \param	xV			Given vector.
+* \param	yV			Destination vector.
+*/
+static void	AlgTstCGMul(void *aDat, double *xV, double *yV)
+{
+  AlgMatrixVectorMul(yV, *(AlgMatrix *)aDat, xV);
+}
+
+/*!
+* \ingroup	binAlgTst
+* \brief	Jacobi preconditioning function for AlgMatrixCGSolveFn().
+* \param	pDat			Preconditioning data.
+* \param	rV			Given vector.
+* \param	zV			Destination vector.
+*/
+static void	AlgTstCGPre(void *pDat, double *rV, double *zV)
+{
+  size_t	idx;
+  AlgTstCGPreData *pD;
+
+  pD = (AlgTstCGPreData *)pDat;
+  for(idx = 0; idx < pD->n; ++idx)
+  {
+    zV[idx] = pD->iD[idx] * rV[idx];
+  }
+}
+
+/*!
+* \return	Maximum absolute difference.
+* \ingroup	binAlgTst
+* \brief	Computes the maximum absolute difference between two
+* 		vectors, or the maximum absolute value of the first if
+* 		the second is NULL.
+* \param	n			Number of elements.
+* \param	aV			First vector.
+* \param	bV			Second vector, may be NULL.
+*/
+static double	AlgTstCGMaxDiff(size_t n, double *aV, double *bV)
+{
+  size_t	idx;
+  double	d,
+		m = 0.0;
+
+  for(idx = 0; idx < n; ++idx)
+  {
+    d = fabs(aV[idx] - ((bV)? bV[idx]: 0.0));
+    if(d > m)
+    {
+      m = d;
+    }
+  }
+  return(m);
+}
@@ -51,8 +51,8 @@ static char _WlzCMeshDistance_c[] = "University of Edinburgh $Id$";
 WlzCMeshDistance - computes distances within conforming meshes.
 \par Synopsis
 \verbatim
-WlzCMeshDistance [-b] [-h] [-i] [-L] [-o<out obj file>] [-r<ref obj file>]
-                 [-s #,#,#] [<input mesh file>]
+WlzCMeshDistance [-b] [-h] [-i] [-L] [-P] [-o<out obj file>]
+                 [-r<ref obj file>] [-s #,#,#] [<input mesh file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -73,6 +73,11 @@ WlzCMeshDistance [-b] [-h] [-i] [-L] [-o<out obj file>] [-r<ref obj file>]
     <td><b>-L</b></td>
     <td>Use expensive interpolation (mainly useful as a test)..</td>
   </tr>
+  <tr> 
+    <td><b>-P</b></td>
+    <td>Compute the distances using the concurrent fast iterative method
+        rather than fast marching.</td>
+  </tr>
   <tr> 
     <td><b>-o</b></td>
     <td>Output object file.</td>
@@ -103,6 +108,8 @@ line 200, plane 0). The new domain object is written to the file out.wlz.
 \ref BinWlz "WlzIntro(1)"
 \ref WlzCMeshDistance2D "WlzCMeshDistance2D(3)"
 \ref WlzCMeshDistance3D "WlzCMeshDistance3D(3)"
+\ref WlzCMeshDistanceFIM2D "WlzCMeshDistanceFIM2D(3)"
+\ref WlzCMeshDistanceFIM3D "WlzCMeshDistanceFIM3D(3)"
 */
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -131,6 +138,7 @@ int		main(int argc, char *argv[])
 		boundFlg = 0,
 		imgFlg = 0,
 		interp = 0,
+		fimFlg = 0,
   		seedFlg = 0,
   		ok = 1,
   		option,
@@ -152,7 +160,7 @@ int		main(int argc, char *argv[])
   		*refObj = NULL;
   WlzCMeshP 	mesh;
   WlzCMeshNodP	nod;
-  static char   optList[] = "bhiLo:r:s:";
+  static char   optList[] = "bhiLPo:r:s:";
   const char    meshFileStrDef[] = "-",
   	        outObjFileStrDef[] = "-";
 
@@ -190,6 +198,9 @@ int		main(int argc, char *argv[])
       case 'L':
         interp = 1;
 	break;
+      case 'P':
+        fimFlg = 1;
+	break;
       case 'h': /* FALLTHROUGH */
       default:
 	usage = 1;
@@ -398,7 +409,8 @@ int		main(int argc, char *argv[])
 	}
 	if(errNum == WLZ_ERR_NONE)
 	{
-	  outObj = WlzCMeshDistance2D(mshObj, outObjType,
+	  outObj = ((fimFlg)? WlzCMeshDistanceFIM2D: WlzCMeshDistance2D)(
+	                              mshObj, outObjType,
 	                              nSeeds, seeds.d2,
 				      (interp)? WLZ_INTERPOLATION_KRIG:
 				                WLZ_INTERPOLATION_BARYCENTRIC,
@@ -451,7 +463,8 @@ int		main(int argc, char *argv[])
 	}
 	if(errNum == WLZ_ERR_NONE)
 	{
-	  outObj = WlzCMeshDistance3D(mshObj, outObjType,
+	  outObj = ((fimFlg)? WlzCMeshDistanceFIM3D: WlzCMeshDistance3D)(
+	                              mshObj, outObjType,
 	  	                      nSeeds, seeds.d3,
 				      (interp)? WLZ_INTERPOLATION_KRIG:
 				                WLZ_INTERPOLATION_BARYCENTRIC,
@@ -498,7 +511,7 @@ int		main(int argc, char *argv[])
   {
     fprintf(stderr,
             "Usage: %s [-b] [-h] [-o<out obj file>] [-r<ref obj file>]\n"
-	    "                        [-L] [-s #,#,#] [<input mesh file>]\n"
+	    "                        [-L] [-P] [-s #,#,#] [<input mesh file>]\n"
 	    "Constructs a 2D or 3D domain object the values of which are\n"
 	    "the minimum distance from the given seeds points in the given\n"
 	    "conforming mesh. The domain of the output object covers the\n"
@@ -510,6 +523,8 @@ int		main(int argc, char *argv[])
 	    "      interpolated distance values rather than a mesh with\n"
 	    "      indexed values.\n"
 	    "  -L  Use expensive interpolation (mainly useful as a test).\n"
+	    "  -P  Compute the distances using the concurrent fast iterative\n"
+	    "      method rather than fast marching.\n"
 	    "  -o  Output object.\n"
 	    "  -b  Set seed points around the boundary of the mesh.\n"
 	    "  -s  Single seed position.\n"
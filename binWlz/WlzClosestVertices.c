@@ -124,7 +124,7 @@ static int			WlzClosestEnsureDVtx(
 				  WlzVertexP *vP,
 				  WlzVertexType *vType,
 				  int dim);
-static void			WlzVerticesClosestKDTree(
+static int			WlzVerticesClosestKDTree(
 				  AlcKDTTree *tree,
 				  int nTV,
 				  WlzVertexP tV,
@@ -161,7 +161,6 @@ int             main(int argc, char **argv)
   WlzVertexP	sV,
   		tV;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  int		*shfBuf = NULL;
   double	**ioA = NULL;
   AlcKDTTree 	*tree = NULL;
   WlzObject	*obj = NULL;
@@ -344,25 +343,26 @@ int             main(int argc, char **argv)
   {
     if(nSV > thrForKDTree)
     {
-      if(((shfBuf = (int *)AlcMalloc(nTV * sizeof(int))) == NULL) ||
-         ((tree = WlzVerticesBuildTree(tVType, nTV, tV, shfBuf,
-	 			       &errNum)) == NULL))
+      if((tree = WlzVerticesBuildTree(tVType, nTV, tV, NULL,
+				      &errNum)) == NULL)
       {
         ok = 0;
 	(void )fprintf(stderr,
 		       "%s: Failed to compute kD-tree.\n",
 		       *argv);
       }
-      else
+      else if(WlzVerticesClosestKDTree(tree, nTV, tV, nSV, sV, dim) == 0)
       {
-        WlzVerticesClosestKDTree(tree, nTV, tV, nSV, sV, dim);
+        ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Failed to find closest vertices.\n",
+		       *argv);
       }
     }
     else
     {
       WlzVerticesClosestDumb(nTV, tV, nSV, sV, dim);
     }
-    (void )AlcFree(shfBuf); shfBuf = NULL;
     (void )AlcKDTTreeFree(tree); tree = NULL;
   }
   /* Output the closest target vertices. */
@@ -654,9 +654,10 @@ static void	WlzVerticesClosestDumb(int nTV, WlzVertexP tV,
 }
 
 /*!
-* \return	void
+* \return	Non-zero on success, zero if memory allocation failed.
 * \brief	For each of the source vertices finds the closest target
-*		vertex in the kD-tree.
+*		vertex in the kD-tree, with the queries shared between
+*		threads by AlcKDTGetKNNBatch().
 * \param	tree			kD-tree of target vertices.
 * \param        nTV                     Number of target vertices.
 * \param        tV                      Target vertices.
@@ -665,34 +666,58 @@ static void	WlzVerticesClosestDumb(int nTV, WlzVertexP tV,
 *					target vertices on return.
 * \param	dim			Dimension == 2 || 3.
 */
-static void	WlzVerticesClosestKDTree(AlcKDTTree *tree,
+static int	WlzVerticesClosestKDTree(AlcKDTTree *tree,
 					 int nTV, WlzVertexP tV,
 					 int nSV, WlzVertexP sV, int dim)
 {
-  int		idS;
-  AlcKDTNode	*node;
-  double	pos[3];
+  int		idS,
+  		ok = 0;
+  double	*pos = NULL;
+  AlcKDTNode	**nodes = NULL;
 
-  if(dim == 2)
+  if(((pos = (double *)AlcMalloc(sizeof(double) * dim * nSV)) != NULL) &&
+     ((nodes = (AlcKDTNode **)
+               AlcMalloc(sizeof(AlcKDTNode *) * nSV)) != NULL))
   {
-    for(idS = 0; idS < nSV; ++idS)
+    if(dim == 2)
+    {
+      for(idS = 0; idS < nSV; ++idS)
+      {
+	*(pos + (2 * idS)) = (sV.d2 + idS)->vtX;
+	*(pos + (2 * idS) + 1) = (sV.d2 + idS)->vtY;
+      }
+    }
+    else /* dim == 3 */
     {
-      pos[0] = (sV.d2 + idS)->vtX;
-      pos[1] = (sV.d2 + idS)->vtY;
-      node = AlcKDTGetNN(tree, pos, DBL_MAX, NULL, NULL);
-      *(sV.d2 + idS) = *(tV.d2 + node->idx);
+      for(idS = 0; idS < nSV; ++idS)
+      {
+	*(pos + (3 * idS)) = (sV.d3 + idS)->vtX;
+	*(pos + (3 * idS) + 1) = (sV.d3 + idS)->vtY;
+	*(pos + (3 * idS) + 2) = (sV.d3 + idS)->vtZ;
+      }
     }
+    ok = AlcKDTGetKNNBatch(tree, nSV, pos, 1, DBL_MAX, nodes,
+    			   NULL, NULL) == ALC_ER_NONE;
   }
-  else /* dim == 3 */
+  if(ok)
   {
-    for(idS = 0; idS < nSV; ++idS)
+    if(dim == 2)
+    {
+      for(idS = 0; idS < nSV; ++idS)
+      {
+	*(sV.d2 + idS) = *(tV.d2 + (*(nodes + idS))->idx);
+      }
+    }
+    else /* dim == 3 */
     {
-      pos[0] = (sV.d3 + idS)->vtX;
-      pos[1] = (sV.d3 + idS)->vtY;
-      pos[2] = (sV.d3 + idS)->vtZ;
-      node = AlcKDTGetNN(tree, pos, DBL_MAX, NULL, NULL);
-      *(sV.d3 + idS) = *(tV.d3 + node->idx);
+      for(idS = 0; idS < nSV; ++idS)
+      {
+	*(sV.d3 + idS) = *(tV.d3 + (*(nodes + idS))->idx);
+      }
     }
   }
+  AlcFree(pos);
+  AlcFree(nodes);
+  return(ok);
 }
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -51,7 +51,7 @@ WlzTiledObjFromDomain  - creates an object with a tiled value table.
 \par Synopsis
 \verbatim
 WlzTiledObjFromDomain  [-b #] [-c] [-g ] [-h] [-o<output file>]
-                       [-s #,#,#] [<input file>]
+                       [-s #,#,#] [-z] [<input file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -77,6 +77,11 @@ WlzTiledObjFromDomain  [-b #] [-c] [-g ] [-h] [-o<output file>]
     <td><b>-h</b></td>
     <td>Help, prints usage message.</td>
   </tr>
+  <tr>
+    <td><b>-z</b></td>
+    <td>Compress the tiles in the output file using the built in
+        delta and run length encoding codec.</td>
+  </tr>
 </table>
 \par Description
 WlzTiledObjFromDomain creates an object with a tiled value table from
@@ -117,6 +122,7 @@ int		main(int argc, char *argv[])
   		ok = 1,
 		usage = 0,
 		voxSzSet = 0;
+  WlzTiledValueCodec codec = WLZ_TILED_CODEC_NONE;
   WlzGreyType	gType = WLZ_GREY_UBYTE;
   WlzFVertex3	voxSz;
   WlzPixelV	bgdV;
@@ -129,7 +135,7 @@ int		main(int argc, char *argv[])
   int		iBuf[4];
   const char	*errMsg;
   const size_t	tlSz = 4096;
-  static char	optList[] = "chb:g:o:s:",
+  static char	optList[] = "chzb:g:o:s:",
   		inFileStrDef[] = "-",
 		outFileStrDef[] = "-";
 
@@ -259,6 +265,9 @@ int		main(int argc, char *argv[])
 	  usage = 1;
 	}
         break;
+      case 'z':
+        codec = WLZ_TILED_CODEC_DRLE;
+	break;
       case 'h': /* FALLTHROUGH */
       default:
 	usage = 1;
@@ -347,6 +356,10 @@ int		main(int argc, char *argv[])
       outObj = WlzMakeTiledValuesFromObj(domObj, tlSz, copy, gType, bgdV,
       					 &errNum);
     }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      outObj->values.t->codec = codec;
+    }
     if(errNum != WLZ_ERR_NONE)
     {
       ok = 0;
@@ -382,7 +395,7 @@ int		main(int argc, char *argv[])
     (void )fprintf(stderr,
     "Usage: %s%s%s%s",
     *argv,
-    " [-o<output object>] [-h] [-b #] [-g #] [-s #,#,#]\n"
+    " [-o<output object>] [-h] [-b #] [-g #] [-s #,#,#] [-z]\n"
     "                             [<input object>]\n"
     "Creates an object with a tiled value table from an object with a\n"
     "valid spatial domain.\n"
@@ -399,7 +412,9 @@ int		main(int argc, char *argv[])
     "      float, double or RGBA.\n"
     "  -h  Prints this usage information.\n"
     "  -s  Voxel size (x,y,z).\n"
-    "  -o  Output tiled object.\n");
+    "  -o  Output tiled object.\n"
+    "  -z  Compress the tiles using the built in delta and run length\n"
+    "      encoding codec.\n");
   }
   return(!ok);
 }
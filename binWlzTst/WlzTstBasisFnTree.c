@@ -0,0 +1,383 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstBasisFnTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstBasisFnTree.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the tree code evaluation of radial basis
+* 		function transforms, see WlzBasisFnTransformSetTol().
+* 		Basis function transforms are computed from random
+* 		control points and then evaluated at random positions,
+* 		both exactly and using the tree code. The test fails
+* 		if any displacement component differs by more than
+* 		the tolerance.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+static WlzErrorNum		WlzTstBasisFnTreeEval(
+				  WlzBasisFnTransform *basisTr,
+				  int dim,
+				  int nPts,
+				  WlzDVertex3 *pts,
+				  WlzDVertex3 *val);
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		dim = 2,
+		nCPts = 1000,
+		nTPts = 1000,
+		nBad = 0,
+  		ok = 1,
+  		option,
+  		usage = 0,
+		verbose = 0;
+  long		seed = 0;
+  double	tol = 1.0e-1,
+  		maxErr = 0.0,
+		rng = 1000.0,
+		dspRng = 10.0;
+  char		*fnStr = "imq";
+  WlzFnType	fnType = WLZ_FN_BASIS_2DIMQ;
+  WlzDVertex3	*sPts = NULL,
+  		*dPts = NULL,
+		*tPts = NULL,
+		*eVal = NULL,
+		*aVal = NULL;
+  WlzBasisFnTransform *basisTr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  static char   optList[] = "23hvf:n:p:s:t:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'f':
+        fnStr = optarg;
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nCPts) != 1) || (nCPts < 4))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'p':
+        if((sscanf(optarg, "%d", &nTPts) != 1) || (nTPts < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 't':
+        if((sscanf(optarg, "%lg", &tol) != 1) || (tol <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  if(usage == 0)
+  {
+    if(strcmp(fnStr, "imq") == 0)
+    {
+      fnType = (dim == 2)? WLZ_FN_BASIS_2DIMQ: WLZ_FN_BASIS_3DIMQ;
+    }
+    else if(strcmp(fnStr, "mq") == 0)
+    {
+      fnType = (dim == 2)? WLZ_FN_BASIS_2DMQ: WLZ_FN_BASIS_3DMQ;
+    }
+    else if((strcmp(fnStr, "tps") == 0) && (dim == 2))
+    {
+      fnType = WLZ_FN_BASIS_2DTPS;
+    }
+    else
+    {
+      usage = 1;
+    }
+  }
+  ok = (usage == 0);
+  /* Create random control points and test positions. */
+  if(ok)
+  {
+    if(((sPts = (WlzDVertex3 *)
+                AlcCalloc(nCPts, sizeof(WlzDVertex3))) == NULL) ||
+       ((dPts = (WlzDVertex3 *)
+                AlcCalloc(nCPts, sizeof(WlzDVertex3))) == NULL) ||
+       ((tPts = (WlzDVertex3 *)
+                AlcCalloc(nTPts, sizeof(WlzDVertex3))) == NULL) ||
+       ((eVal = (WlzDVertex3 *)
+                AlcCalloc(nTPts, sizeof(WlzDVertex3))) == NULL) ||
+       ((aVal = (WlzDVertex3 *)
+                AlcCalloc(nTPts, sizeof(WlzDVertex3))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      AlgRandSeed(seed);
+      for(idx = 0; idx < nCPts; ++idx)
+      {
+	sPts[idx].vtX = rng * AlgRandUniform();
+	sPts[idx].vtY = rng * AlgRandUniform();
+	dPts[idx].vtX = sPts[idx].vtX + dspRng * (AlgRandUniform() - 0.5);
+	dPts[idx].vtY = sPts[idx].vtY + dspRng * (AlgRandUniform() - 0.5);
+	if(dim == 3)
+	{
+	  sPts[idx].vtZ = rng * AlgRandUniform();
+	  dPts[idx].vtZ = sPts[idx].vtZ + dspRng * (AlgRandUniform() - 0.5);
+	}
+      }
+      for(idx = 0; idx < nTPts; ++idx)
+      {
+	tPts[idx].vtX = rng * AlgRandUniform();
+	tPts[idx].vtY = rng * AlgRandUniform();
+	if(dim == 3)
+	{
+	  tPts[idx].vtZ = rng * AlgRandUniform();
+	}
+      }
+    }
+  }
+  /* Compute the basis function transform. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    if(dim == 2)
+    {
+      WlzDVertex2 *sPts2 = NULL,
+      		  *dPts2 = NULL;
+
+      if(((sPts2 = (WlzDVertex2 *)
+                   AlcMalloc(nCPts * sizeof(WlzDVertex2))) == NULL) ||
+         ((dPts2 = (WlzDVertex2 *)
+                   AlcMalloc(nCPts * sizeof(WlzDVertex2))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	for(idx = 0; idx < nCPts; ++idx)
+	{
+	  sPts2[idx].vtX = sPts[idx].vtX;
+	  sPts2[idx].vtY = sPts[idx].vtY;
+	  dPts2[idx].vtX = dPts[idx].vtX;
+	  dPts2[idx].vtY = dPts[idx].vtY;
+	}
+	basisTr = WlzBasisFnTrFromCPts2D(fnType, 0, nCPts, dPts2,
+					 nCPts, sPts2, NULL, &errNum);
+      }
+      AlcFree(sPts2);
+      AlcFree(dPts2);
+    }
+    else
+    {
+      basisTr = WlzBasisFnTrFromCPts3D(fnType, 0, nCPts, dPts,
+				       nCPts, sPts, NULL, &errNum);
+    }
+  }
+  /* Evaluate the transform exactly and then using the tree code. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    errNum = WlzTstBasisFnTreeEval(basisTr, dim, nTPts, tPts, eVal);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    errNum = WlzBasisFnTransformSetTol(basisTr, tol);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    errNum = WlzTstBasisFnTreeEval(basisTr, dim, nTPts, tPts, aVal);
+  }
+  /* Compare the exact and approximate values. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    for(idx = 0; idx < nTPts; ++idx)
+    {
+      double	err;
+      WlzDVertex3 d;
+
+      WLZ_VTX_3_SUB(d, eVal[idx], aVal[idx]);
+      err = WLZ_MAX(fabs(d.vtX), fabs(d.vtY));
+      err = WLZ_MAX(err, fabs(d.vtZ));
+      if(err > maxErr)
+      {
+        maxErr = err;
+      }
+      if(err > tol)
+      {
+        ++nBad;
+	if(verbose)
+	{
+	  (void )fprintf(stderr,
+	                 "%s: position %d (%g,%g,%g) error %g\n",
+			 *argv, idx,
+			 tPts[idx].vtX, tPts[idx].vtY, tPts[idx].vtZ, err);
+	}
+      }
+    }
+    ok = (nBad == 0);
+    (void )printf("%s: %dD %s, %d control points, %d positions, "
+                  "tolerance %g, maximum error %g, %d errors (%s)\n",
+		  *argv, dim, fnStr, nCPts, nTPts, tol, maxErr, nBad,
+		  (ok)? "pass": "FAIL");
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+                   "%s: Failed to compute or evaluate the basis function\n"
+		   "transform (%s).\n",
+		   *argv, errMsgStr);
+  }
+  (void )WlzBasisFnFreeTransform(basisTr);
+  AlcFree(sPts);
+  AlcFree(dPts);
+  AlcFree(tPts);
+  AlcFree(eVal);
+  AlcFree(aVal);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2|3] [-h] [-v] [-f <fn>] [-n #] [-p #] [-s #] [-t #]\n"
+    "Tests the tree code evaluation of radial basis function transforms\n"
+    "by comparing it with exact evaluation at random positions.\n"
+    "Options are:\n"
+    "  -2  Two dimensional transform (default).\n"
+    "  -3  Three dimensional transform.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, prints the positions with errors greater than\n"
+    "      the tolerance.\n"
+    "  -f  Basis function: imq, mq or (2D only) tps (default %s).\n"
+    "  -n  Number of random control points (default %d).\n"
+    "  -p  Number of random test positions (default %d).\n"
+    "  -s  Seed for the pseudo-random number generator (default %ld).\n"
+    "  -t  Tolerance, the maximum absolute displacement error\n"
+    "      (default %g).\n"
+    "The control points and test positions are within a square or cube\n"
+    "with sides of length %g and the control point displacements are\n"
+    "within +/-%g.\n"
+    "Example:\n"
+    "  %s -3 -f mq -n 10000 -t 0.1\n"
+    "compares tree and exact evaluation of a 3D multiquadric transform with\n"
+    "10000 control points, using a tolerance of 0.1.\n",
+    *argv, fnStr, nCPts, nTPts, seed, tol, rng, dspRng / 2.0, *argv);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Evaluates the given basis function transform at the
+* 		given positions.
+* \param	basisTr			Given basis function transform.
+* \param	dim			Dimension of the transform.
+* \param	nPts			Number of positions.
+* \param	pts			Positions.
+* \param	val			Array for the transformed positions.
+*/
+static WlzErrorNum WlzTstBasisFnTreeEval(WlzBasisFnTransform *basisTr,
+				int dim, int nPts, WlzDVertex3 *pts,
+				WlzDVertex3 *val)
+{
+  int		idx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nPts); ++idx)
+  {
+    if(dim == 2)
+    {
+      WlzDVertex2 p,
+      		  q;
+
+      p.vtX = pts[idx].vtX;
+      p.vtY = pts[idx].vtY;
+      q = WlzBasisFnTransformVertexD(basisTr, p, &errNum);
+      val[idx].vtX = q.vtX;
+      val[idx].vtY = q.vtY;
+      val[idx].vtZ = 0.0;
+    }
+    else
+    {
+      switch(basisTr->basisFn->type)
+      {
+        case WLZ_FN_BASIS_3DIMQ:
+	  val[idx] = WlzBasisFnValueIMQ3D(basisTr->basisFn, pts[idx]);
+	  break;
+        case WLZ_FN_BASIS_3DMQ:
+	  val[idx] = WlzBasisFnValueMQ3D(basisTr->basisFn, pts[idx]);
+	  break;
+	default:
+	  errNum = WLZ_ERR_TRANSFORM_TYPE;
+	  break;
+      }
+    }
+  }
+  return(errNum);
+}
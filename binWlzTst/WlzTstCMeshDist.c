@@ -36,7 +36,9 @@ static char _WlzTstCMeshDist_c[] = "University of Edinburgh $Id$";
 * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
 * Boston, MA  02110-1301, USA.
 * \brief	Test for 2D and 3D distance computation using fast marching
-* 		methods within simplical conforming meshes.
+* 		methods within simplical conforming meshes. Optionally
+* 		the distances are also computed using the fast iterative
+* 		method and compared with those computed by fast marching.
 * \ingroup	BinWlzTst
 */
 
@@ -67,6 +69,7 @@ int		main(int argc, char *argv[])
 {
   int		idN,
   		nSeeds = 0,
+		cmpFIM = 0,
   		ok = 1,
   		option,
 		repeats = 1,
@@ -74,7 +77,9 @@ int		main(int argc, char *argv[])
 		maxNod = 0,
 		seedType = WLZTST_SEED_SEEDS,
 		outType = WLZTST_OUT_TXT;
-  double	*dist = NULL;
+  double	maxErr = 0.25;
+  double	*dist = NULL,
+  		*fimDist = NULL;
   double	**inSeeds = NULL;
   size_t	inRow = 0,
   		inCol = 0;
@@ -89,7 +94,7 @@ int		main(int argc, char *argv[])
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzObject	*inObj = NULL;
   WlzCMeshP 	mesh;
-  static char   optList[] = "bhnto:s:R:S:";
+  static char   optList[] = "bfhnte:o:s:R:S:";
   const char    inObjFileStrDef[] = "-",
   	        outFileStrDef[] = "-";
 
@@ -105,6 +110,15 @@ int		main(int argc, char *argv[])
       case 'b':
 	seedType = WLZTST_SEED_BOUNDARY;
         break;
+      case 'e':
+        if((sscanf(optarg, "%lg", &maxErr) != 1) || (maxErr < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'f':
+        cmpFIM = 1;
+	break;
       case 'n':
 	outType = WLZTST_OUT_NONE;
         break;
@@ -250,7 +264,8 @@ int		main(int argc, char *argv[])
   }
   if(ok)
   {
-    if((dist = AlcCalloc(maxNod, sizeof(double))) == NULL)
+    if(((dist = AlcCalloc(maxNod, sizeof(double))) == NULL) ||
+       (cmpFIM && ((fimDist = AlcCalloc(maxNod, sizeof(double))) == NULL)))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
       ok = 0;
@@ -341,6 +356,129 @@ int		main(int argc, char *argv[])
       }
     }
   }
+  if(ok && cmpFIM)
+  {
+    int		nNod = 0,
+    		nBad = 0,
+		nFMMUnr = 0,
+		nFIMUnr = 0,
+		nBothUnr = 0;
+    double	maxEdgLen = 0.0,
+		maxDiff = 0.0,
+		maxRelDiff = 0.0;
+
+    switch(inObj->type)
+    {
+      case WLZ_CMESH_2D:
+        errNum = WlzCMeshFIMNodes2D(mesh.m2, fimDist, nSeeds, seeds.d2);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzCMeshUpdateMaxSqEdgLen2D(mesh.m2);
+	  maxEdgLen = sqrt(mesh.m2->maxSqEdgLen);
+	}
+	break;
+      case WLZ_CMESH_3D:
+        errNum = WlzCMeshFIMNodes3D(mesh.m3, fimDist, nSeeds, seeds.d3);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  WlzCMeshUpdateMaxSqEdgLen3D(mesh.m3);
+	  maxEdgLen = sqrt(mesh.m3->maxSqEdgLen);
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+		     "%s Failed to compute distances in mesh using the fast\n"
+		     "iterative method (%s).\n",
+		     argv[0],
+		     errMsgStr);
+    }
+    else
+    {
+      /* Compare the distances of the valid nodes. Nodes that either
+       * method leaves unreached (with distance DBL_MAX) are counted
+       * separately. Otherwise the difference must be within the given
+       * fraction of the fast marching distance or, close to the seeds,
+       * of the maximum edge length. */
+      for(idN = 0; idN < maxNod; ++idN)
+      {
+	int	valid;
+
+	if(inObj->type == WLZ_CMESH_2D)
+	{
+	  nod2 = (WlzCMeshNod2D *)AlcVectorItemGet(mesh.m2->res.nod.vec, idN);
+	  valid = nod2->idx >= 0;
+	}
+	else
+	{
+	  nod3 = (WlzCMeshNod3D *)AlcVectorItemGet(mesh.m3->res.nod.vec, idN);
+	  valid = nod3->idx >= 0;
+	}
+	if(valid)
+	{
+	  int	fmmUnr,
+	  	fimUnr;
+
+	  ++nNod;
+	  fmmUnr = dist[idN] > DBL_MAX / 2.0;
+	  fimUnr = fimDist[idN] > DBL_MAX / 2.0;
+	  if(fmmUnr && fimUnr)
+	  {
+	    ++nBothUnr;
+	  }
+	  else if(fmmUnr)
+	  {
+	    ++nFMMUnr;
+	  }
+	  else if(fimUnr)
+	  {
+	    ++nFIMUnr;
+	  }
+	  else
+	  {
+	    double d,
+	    	   r = 0.0;
+
+	    d = fabs(fimDist[idN] - dist[idN]);
+	    if(d > 0.0)
+	    {
+	      r = d / ALG_MAX(dist[idN], maxEdgLen);
+	    }
+	    if(d > maxDiff)
+	    {
+	      maxDiff = d;
+	    }
+	    if(r > maxRelDiff)
+	    {
+	      maxRelDiff = r;
+	    }
+	    if(r > maxErr)
+	    {
+	      ++nBad;
+	    }
+	  }
+	}
+      }
+      /* Nodes only reached by fast marching are failures of the fast
+       * iterative method. */
+      ok = (nBad == 0) && (nFIMUnr == 0);
+      (void )fprintf(stderr,
+                     "%s: %d nodes, maximum difference between fast\n"
+		     "iterative and fast marching distances %g (relative %g),\n"
+		     "maximum edge length %g, %d nodes exceed relative\n"
+		     "difference %g, unreached nodes: %d by fast marching only,\n"
+		     "%d by fast iterative only, %d by both (%s).\n",
+		     argv[0], nNod, maxDiff, maxRelDiff, maxEdgLen,
+		     nBad, maxErr, nFMMUnr, nFIMUnr, nBothUnr,
+		     (ok)? "pass": "FAIL");
+    }
+  }
   if(ok)
   {
     switch(outType)
@@ -424,11 +562,14 @@ int		main(int argc, char *argv[])
 	break;
     }
   }
+  AlcFree(dist);
+  AlcFree(fimDist);
+  AlcFree(seeds.v);
   (void )WlzFreeObj(inObj);
   if(usage)
   {
     (void )fprintf(stderr,
-    "Usage: %s [-h] [-o<output file>]\n"
+    "Usage: %s [-h] [-o<output file>] [-e<max difference>] [-f]\n"
     "       [-b] [-s<seed>] [-R<repeats>] [-S<seed file>]\n"
     "       [-n] [-t] [<input cmesh object>]\n"
     "Reads a conforming mesh and then computes distances from the given\n"
@@ -445,9 +586,19 @@ int		main(int argc, char *argv[])
     "Image output is a double valued image with the same domain as the\n"
     "input object. Values within the output image are either 0.0 or the\n"
     "computed distance at the mesh nodes.\n"
+    "If the fast iterative method comparison is enabled then the distances\n"
+    "are also computed using the fast iterative method and the test fails\n"
+    "if, at any node, these differ from those computed by fast marching by\n"
+    "more than the maximum difference times the larger of the fast marching\n"
+    "distance and the maximum mesh edge length. Nodes which either method\n"
+    "leaves unreached are not compared but are counted separately, the\n"
+    "test fails if any are reached by fast marching alone.\n"
     "Options are:\n"
     "  -h  Help, prints this usage message.\n"
     "  -o  Output file.\n"
+    "  -e  Maximum difference as a fraction of the fast marching distance\n"
+    "      or maximum edge length (default %g).\n"
+    "  -f  Compare the fast iterative method with fast marching.\n"
     "  -b  Compute distances from boundary nodes.\n"
     "  -s  Compute distances from given seed point, which must be within\n"
     "      the mesh.\n"
@@ -455,7 +606,7 @@ int		main(int argc, char *argv[])
     "  -S  File of seed points, each as of which must be within the mesh.\n"
     "  -n  No output.\n"
     "  -t  Output text data.\n",
-    argv[0]);
+    argv[0], maxErr);
 
   }
   return(!ok);
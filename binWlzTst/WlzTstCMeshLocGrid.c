@@ -0,0 +1,472 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstCMeshLocGrid_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstCMeshLocGrid.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the element location grids of conforming
+* 		meshes, see WlzCMeshSetLocGrid2D() and
+* 		WlzCMeshSetLocGrid3D().
+* 		A mesh is made from a circle or sphere and the elements
+* 		enclosing random positions are found by a brute force
+* 		scan of all the mesh elements. These are compared with
+* 		the elements found using the location grid directly and
+* 		by the non-exhaustive search both with and without the
+* 		location grid. The location grid is built once and is
+* 		only freed for the last of these. The test fails if any
+* 		of these differ, other than for positions on the
+* 		boundary between elements.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+static int			WlzTstCMeshLocGridRefElm(
+				  WlzCMeshP mesh,
+				  WlzDVertex3 pos);
+static int			WlzTstCMeshLocGridElm(
+				  WlzCMeshP mesh,
+				  int method,
+				  int lastElmIdx,
+				  WlzDVertex3 pos);
+static int			WlzTstCMeshLocGridAgree(
+				  WlzCMeshP mesh,
+				  WlzDVertex3 pos,
+				  int refElmIdx,
+				  int elmIdx);
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idM,
+  		idP,
+  		dim = 2,
+		nPos = 1000,
+		nIn = 0,
+  		ok = 1,
+  		option,
+  		usage = 0,
+		verbose = 0;
+  int		nBad[3];
+  int		*refElmIdx = NULL;
+  long		seed = 0;
+  double	radius = 0.0,
+  		minElmSz = 0.0,
+		maxElmSz = 10.0;
+  WlzDVertex3	bBoxMin,
+		bBoxSz;
+  WlzDVertex3	*pos = NULL;
+  WlzObject	*obj = NULL;
+  WlzCMeshP	mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const char	*methodStr[3] = {"location grid",
+				 "search with location grid",
+  				 "search without location grid"};
+  static char   optList[] = "23hvm:M:n:r:s:";
+
+  opterr = 0;
+  mesh.v = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'm':
+        if((sscanf(optarg, "%lg", &minElmSz) != 1) || (minElmSz <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'M':
+        if((sscanf(optarg, "%lg", &maxElmSz) != 1) || (maxElmSz <= 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nPos) != 1) || (nPos < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 2.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0);
+  /* Make a mesh from a circle or sphere. The defaults for a sphere give
+   * a much smaller mesh than for a circle so that the brute force scans
+   * are quick. */
+  if(ok)
+  {
+    if(radius < 1.0)
+    {
+      radius = (dim == 2)? 50.0: 20.0;
+    }
+    if(minElmSz < DBL_EPSILON)
+    {
+      minElmSz = (dim == 2)? 1.0: 2.0;
+    }
+    if(dim == 2)
+    {
+      obj = WlzMakeCircleObject(radius, radius, radius, &errNum);
+    }
+    else
+    {
+      obj = WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, radius,
+      				radius, radius, radius, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj = WlzAssignObject(obj, NULL);
+      mesh = WlzCMeshFromObj(obj, minElmSz, maxElmSz, NULL, 1, &errNum);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to create conforming mesh (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  /* Build the location grid, this is kept for all but the last of the
+   * methods. */
+  if(ok)
+  {
+    errNum = (dim == 2)? WlzCMeshSetLocGrid2D(mesh.m2):
+                         WlzCMeshSetLocGrid3D(mesh.m3);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(((pos = (WlzDVertex3 *)
+                 AlcMalloc(nPos * sizeof(WlzDVertex3))) == NULL) ||
+	 ((refElmIdx = (int *)AlcMalloc(nPos * sizeof(int))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to create location grid (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  /* Find the elements enclosing random positions within the mesh
+   * bounding box, which is expanded so that some positions are outside
+   * the mesh, using a brute force scan of all the elements. */
+  if(ok)
+  {
+    if(dim == 2)
+    {
+      bBoxMin.vtX = mesh.m2->bBox.xMin;
+      bBoxMin.vtY = mesh.m2->bBox.yMin;
+      bBoxMin.vtZ = 0.0;
+      bBoxSz.vtX = mesh.m2->bBox.xMax - mesh.m2->bBox.xMin;
+      bBoxSz.vtY = mesh.m2->bBox.yMax - mesh.m2->bBox.yMin;
+      bBoxSz.vtZ = 0.0;
+    }
+    else
+    {
+      bBoxMin.vtX = mesh.m3->bBox.xMin;
+      bBoxMin.vtY = mesh.m3->bBox.yMin;
+      bBoxMin.vtZ = mesh.m3->bBox.zMin;
+      bBoxSz.vtX = mesh.m3->bBox.xMax - mesh.m3->bBox.xMin;
+      bBoxSz.vtY = mesh.m3->bBox.yMax - mesh.m3->bBox.yMin;
+      bBoxSz.vtZ = mesh.m3->bBox.zMax - mesh.m3->bBox.zMin;
+    }
+    WLZ_VTX_3_SCALE_ADD(bBoxMin, bBoxSz, -0.1, bBoxMin);
+    WLZ_VTX_3_SCALE(bBoxSz, bBoxSz, 1.2);
+    AlgRandSeed(seed);
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      pos[idP].vtX = bBoxMin.vtX + bBoxSz.vtX * AlgRandUniform();
+      pos[idP].vtY = bBoxMin.vtY + bBoxSz.vtY * AlgRandUniform();
+      pos[idP].vtZ = bBoxMin.vtZ + bBoxSz.vtZ * AlgRandUniform();
+      refElmIdx[idP] = WlzTstCMeshLocGridRefElm(mesh, pos[idP]);
+      if(refElmIdx[idP] >= 0)
+      {
+        ++nIn;
+      }
+    }
+    /* Compare with the elements found by each of the methods, freeing
+     * the location grid before the last. */
+    for(idM = 0; idM < 3; ++idM)
+    {
+      int	lastElmIdx = -1;
+
+      nBad[idM] = 0;
+      if(idM == 2)
+      {
+	if(dim == 2)
+	{
+	  WlzCMeshFreeLocGrid2D(mesh.m2);
+	}
+	else
+	{
+	  WlzCMeshFreeLocGrid3D(mesh.m3);
+	}
+      }
+      for(idP = 0; idP < nPos; ++idP)
+      {
+	int	elmIdx;
+
+	elmIdx = WlzTstCMeshLocGridElm(mesh, idM, lastElmIdx, pos[idP]);
+	if(!WlzTstCMeshLocGridAgree(mesh, pos[idP], refElmIdx[idP], elmIdx))
+	{
+	  ++nBad[idM];
+	  if(verbose)
+	  {
+	    (void )fprintf(stderr,
+	                   "%s: position %d (%g,%g,%g) %s element %d, "
+			   "brute force scan element %d\n",
+			   *argv, idP, pos[idP].vtX, pos[idP].vtY, pos[idP].vtZ,
+			   methodStr[idM], elmIdx, refElmIdx[idP]);
+	  }
+	}
+	if(elmIdx >= 0)
+	{
+	  lastElmIdx = elmIdx;
+	}
+      }
+    }
+    ok = (nBad[0] == 0) && (nBad[1] == 0) && (nBad[2] == 0);
+    (void )printf("%s: %dD mesh with %d elements, %d positions (%d inside), "
+                  "errors %d %d %d (%s)\n",
+		  *argv, dim,
+		  (dim == 2)? mesh.m2->res.elm.numEnt: mesh.m3->res.elm.numEnt,
+		  nPos, nIn, nBad[0], nBad[1], nBad[2],
+		  (ok)? "pass": "FAIL");
+  }
+  AlcFree(pos);
+  AlcFree(refElmIdx);
+  if(mesh.v)
+  {
+    (void )WlzCMeshFree(mesh);
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2|3] [-h] [-v] [-m #] [-M #] [-n #] [-r #] [-s #]\n"
+    "Tests the element location grids of conforming meshes. A mesh is\n"
+    "made from a circle or sphere and the elements enclosing random\n"
+    "positions are found by a brute force scan of the elements, using the\n"
+    "location grid directly and by the non-exhaustive search with and then\n"
+    "without the location grid. The output gives the number of positions\n"
+    "for which each of these differs from the brute force scan.\n"
+    "Options are:\n"
+    "  -2  Two dimensional mesh (default).\n"
+    "  -3  Three dimensional mesh.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, prints the positions with errors.\n"
+    "  -m  Minimum mesh element size (default 1 for 2D, 2 for 3D).\n"
+    "  -M  Maximum mesh element size (default %g).\n"
+    "  -n  Number of random positions (default %d).\n"
+    "  -r  Radius of the circle or sphere (default 50 for 2D, 20 for 3D).\n"
+    "  -s  Seed for the pseudo-random number generator (default %ld).\n",
+    *argv, maxElmSz, nPos, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Index of the first element found which encloses the
+* 		given position or negative value if there is none.
+* \ingroup	BinWlzTst
+* \brief	Finds an element of the given mesh which encloses the
+* 		given position by a brute force scan of all the elements
+* 		of the mesh.
+* \param	mesh			Given mesh.
+* \param	pos			Given position.
+*/
+static int	WlzTstCMeshLocGridRefElm(WlzCMeshP mesh, WlzDVertex3 pos)
+{
+  int		idx,
+  		elmIdx = -1;
+
+  if(mesh.m2->type == WLZ_CMESH_2D)
+  {
+    WlzDVertex2	pos2;
+
+    pos2.vtX = pos.vtX;
+    pos2.vtY = pos.vtY;
+    for(idx = 0; (elmIdx < 0) && (idx < mesh.m2->res.elm.maxEnt); ++idx)
+    {
+      WlzCMeshElm2D *elm;
+
+      elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh.m2->res.elm.vec, idx);
+      if((elm->idx >= 0) && WlzCMeshElmEnclosesPos2D(elm, pos2))
+      {
+        elmIdx = elm->idx;
+      }
+    }
+  }
+  else
+  {
+    for(idx = 0; (elmIdx < 0) && (idx < mesh.m3->res.elm.maxEnt); ++idx)
+    {
+      WlzCMeshElm3D *elm;
+
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh.m3->res.elm.vec, idx);
+      if((elm->idx >= 0) && WlzCMeshElmEnclosesPos3D(elm, pos))
+      {
+        elmIdx = elm->idx;
+      }
+    }
+  }
+  return(elmIdx);
+}
+
+/*!
+* \return	Index of the enclosing element or negative value if
+* 		no enclosing element is found.
+* \ingroup	BinWlzTst
+* \brief	Finds the element of the given mesh which encloses the
+* 		given position using either the location grid directly
+* 		(method 0) or the non-exhaustive search (other methods),
+* 		which uses the location grid only if the mesh has one.
+* \param	mesh			Given mesh.
+* \param	method			Method.
+* \param	lastElmIdx		Index of the element found by the
+* 					previous search using the same
+* 					method, may be negative.
+* \param	pos			Given position.
+*/
+static int	WlzTstCMeshLocGridElm(WlzCMeshP mesh, int method,
+				      int lastElmIdx, WlzDVertex3 pos)
+{
+  int		elmIdx = -1;
+
+  if(mesh.m2->type == WLZ_CMESH_2D)
+  {
+    WlzDVertex2	pos2;
+
+    pos2.vtX = pos.vtX;
+    pos2.vtY = pos.vtY;
+    elmIdx = (method == 0)?
+	     WlzCMeshLocGridElmPos2D(mesh.m2, pos2):
+	     WlzCMeshElmEnclosingPos2D(mesh.m2, lastElmIdx,
+	     			       pos.vtX, pos.vtY, 0, NULL);
+  }
+  else
+  {
+    elmIdx = (method == 0)?
+	     WlzCMeshLocGridElmPos3D(mesh.m3, pos):
+	     WlzCMeshElmEnclosingPos3D(mesh.m3, lastElmIdx,
+	     			       pos.vtX, pos.vtY, pos.vtZ, 0, NULL);
+  }
+  return(elmIdx);
+}
+
+/*!
+* \return	Non-zero if the elements agree.
+* \ingroup	BinWlzTst
+* \brief	Checks whether an element found for the given position
+* 		agrees with that found by a brute force scan. The
+* 		elements agree if they are the same or if both are
+* 		valid and the given element also encloses the position,
+* 		as happens for positions on the boundary between
+* 		elements.
+* \param	mesh			Given mesh.
+* \param	pos			Given position.
+* \param	refElmIdx		Element index found by a brute
+* 					force scan.
+* \param	elmIdx			Element index to check.
+*/
+static int	WlzTstCMeshLocGridAgree(WlzCMeshP mesh, WlzDVertex3 pos,
+				        int refElmIdx, int elmIdx)
+{
+  int		agree;
+
+  agree = (elmIdx == refElmIdx);
+  if(!agree && (elmIdx >= 0) && (refElmIdx >= 0))
+  {
+    if(mesh.m2->type == WLZ_CMESH_2D)
+    {
+      WlzDVertex2 pos2;
+      WlzCMeshElm2D *elm;
+
+      pos2.vtX = pos.vtX;
+      pos2.vtY = pos.vtY;
+      elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh.m2->res.elm.vec, elmIdx);
+      agree = WlzCMeshElmEnclosesPos2D(elm, pos2);
+    }
+    else
+    {
+      WlzCMeshElm3D *elm;
+
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh.m3->res.elm.vec, elmIdx);
+      agree = WlzCMeshElmEnclosesPos3D(elm, pos);
+    }
+  }
+  return(agree);
+}
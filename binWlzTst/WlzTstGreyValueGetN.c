@@ -0,0 +1,475 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstGreyValueGetN_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstGreyValueGetN.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the batched grey value lookup of
+* 		WlzGreyValueGetN().
+* 		A circle or sphere object with random double grey
+* 		values is made and values at random positions are
+* 		found using WlzGreyValueGetN() with nearest neighbour,
+* 		linear and cubic interpolation. These are compared with
+* 		reference values computed from the values at integer
+* 		coordinates given by WlzGreyValueGet(). The test fails
+* 		if any value differs by more than the tolerance.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+static double			WlzTstGreyValueGetNRef(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzInterpolationType interp,
+				  int dim,
+				  WlzDVertex3 pos);
+static double			WlzTstGreyValueGetNInt(
+				  WlzGreyValueWSpace *gVWSp,
+				  int pl,
+				  int ln,
+				  int kl);
+static void			WlzTstGreyValueGetNWeights(
+				  WlzInterpolationType interp,
+				  double t,
+				  int *dstI0,
+				  int *dstN,
+				  double *w);
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idI,
+  		idP,
+  		dim = 2,
+		nPos = 1000,
+  		ok = 1,
+  		option,
+  		usage = 0,
+		verbose = 0;
+  int		nBad[3];
+  long		seed = 0;
+  double	radius = 20.0,
+  		tol = 1.0e-10;
+  double	maxErr[3];
+  double	*val = NULL;
+  double	**dat = NULL;
+  WlzDVertex3	*pos = NULL;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL,
+		*sObj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL,
+  		*rVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const WlzInterpolationType interp[3] = {WLZ_INTERPOLATION_NEAREST,
+  					  WLZ_INTERPOLATION_LINEAR,
+					  WLZ_INTERPOLATION_CUBIC};
+  const char	*interpStr[3] = {"nearest", "linear", "cubic"};
+  static char   optList[] = "23hve:n:r:s:";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'e':
+        if((sscanf(optarg, "%lg", &tol) != 1) || (tol < 0.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nPos) != 1) || (nPos < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 2.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0);
+  /* Make a circle or sphere object with random grey values by applying
+   * it as a template to a rectangle or cuboid with random values. */
+  if(ok)
+  {
+    int		sz;
+
+    AlgRandSeed(seed);
+    sz = (int )ceil(2.0 * radius);
+    bgdV.type = WLZ_GREY_DOUBLE;
+    bgdV.v.dbv = 0.0;
+    if(dim == 2)
+    {
+      if(AlcDouble2Calloc(&dat, sz + 1, sz + 1) != ALC_ER_NONE)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	rObj = WlzMakeRect(0, sz, 0, sz, WLZ_GREY_DOUBLE, (int *)*dat, bgdV,
+			   NULL, NULL, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        sObj = WlzMakeCircleObject(radius, radius, radius, &errNum);
+      }
+    }
+    else
+    {
+      rObj = WlzMakeCuboid(0, sz, 0, sz, 0, sz, WLZ_GREY_DOUBLE, bgdV,
+      			   NULL, NULL, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        sObj = WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, radius,
+				   radius, radius, radius, &errNum);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzAssignObject(rObj, NULL);
+      sObj = WlzAssignObject(sObj, NULL);
+      rVWSp = WlzGreyValueMakeWSp(rObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idK,
+      		idL,
+		idZ;
+
+      for(idZ = 0; idZ <= ((dim == 2)? 0: sz); ++idZ)
+      {
+	for(idL = 0; idL <= sz; ++idL)
+	{
+	  for(idK = 0; idK <= sz; ++idK)
+	  {
+	    WlzGreyValueGet(rVWSp, idZ, idL, idK);
+	    *(rVWSp->gPtr[0].dbp) = 100.0 * AlgRandUniform();
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(rVWSp);
+      rVWSp = NULL;
+      bgdV.v.dbv = 50.0;
+      obj = WlzAssignObject(WlzGreyTemplate(rObj, sObj, bgdV, &errNum),
+      			    NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzSetBackground(obj, bgdV);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(((pos = (WlzDVertex3 *)
+                 AlcMalloc(nPos * sizeof(WlzDVertex3))) == NULL) ||
+	 ((val = (double *)AlcMalloc(nPos * sizeof(double))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to create test object (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  /* Random positions within the object's bounding box, which is
+   * expanded so that some positions and interpolation neighbourhoods
+   * are outside the object. */
+  if(ok)
+  {
+    double	lo,
+    		hi;
+
+    lo = -2.0;
+    hi = 2.0 * radius + 2.0;
+    for(idP = 0; idP < nPos; ++idP)
+    {
+      pos[idP].vtX = lo + (hi - lo) * AlgRandUniform();
+      pos[idP].vtY = lo + (hi - lo) * AlgRandUniform();
+      pos[idP].vtZ = (dim == 2)? 0.0: lo + (hi - lo) * AlgRandUniform();
+    }
+    for(idI = 0; idI < 3; ++idI)
+    {
+      nBad[idI] = 0;
+      maxErr[idI] = 0.0;
+      errNum = WlzGreyValueGetN(gVWSp, interp[idI], nPos, pos, val);
+      if(errNum != WLZ_ERR_NONE)
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	(void )fprintf(stderr,
+		       "%s: Failed to get %s interpolated values (%s).\n",
+		       *argv, interpStr[idI], errMsgStr);
+        break;
+      }
+      for(idP = 0; idP < nPos; ++idP)
+      {
+        double	err,
+		ref;
+
+	ref = WlzTstGreyValueGetNRef(rVWSp, interp[idI], dim, pos[idP]);
+	err = fabs(val[idP] - ref);
+	if(err > maxErr[idI])
+	{
+	  maxErr[idI] = err;
+	}
+	if(err > tol)
+	{
+	  ++nBad[idI];
+	  if(verbose)
+	  {
+	    (void )fprintf(stderr,
+	                   "%s: %s position %d (%g,%g,%g) value %g, "
+			   "reference %g\n",
+			   *argv, interpStr[idI], idP,
+			   pos[idP].vtX, pos[idP].vtY, pos[idP].vtZ,
+			   val[idP], ref);
+	  }
+	}
+      }
+    }
+  }
+  if(ok)
+  {
+    ok = (nBad[0] == 0) && (nBad[1] == 0) && (nBad[2] == 0);
+    (void )printf("%s: %dD, %d positions, maximum differences %g %g %g, "
+                  "errors %d %d %d (%s)\n",
+		  *argv, dim, nPos, maxErr[0], maxErr[1], maxErr[2],
+		  nBad[0], nBad[1], nBad[2], (ok)? "pass": "FAIL");
+  }
+  AlcFree(pos);
+  AlcFree(val);
+  WlzGreyValueFreeWSp(gVWSp);
+  WlzGreyValueFreeWSp(rVWSp);
+  (void )WlzFreeObj(obj);
+  (void )WlzFreeObj(rObj);
+  (void )WlzFreeObj(sObj);
+  if(dat)
+  {
+    Alc2Free((void **)dat);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2|3] [-h] [-v] [-e #] [-n #] [-r #] [-s #]\n"
+    "Tests WlzGreyValueGetN() by comparing the values it gives at random\n"
+    "positions, using nearest neighbour, linear and cubic interpolation,\n"
+    "with reference values computed from those at integer coordinates\n"
+    "given by WlzGreyValueGet(). The object is a circle or sphere with\n"
+    "random double grey values.\n"
+    "Options are:\n"
+    "  -2  Two dimensional object (default).\n"
+    "  -3  Three dimensional object.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output, prints the positions with errors.\n"
+    "  -e  Maximum absolute difference (default %g).\n"
+    "  -n  Number of random positions (default %d).\n"
+    "  -r  Radius of the circle or sphere (default %g).\n"
+    "  -s  Seed for the pseudo-random number generator (default %ld).\n",
+    *argv, tol, nPos, radius, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Reference grey value.
+* \ingroup	BinWlzTst
+* \brief	Computes a reference interpolated grey value at the
+* 		given position from the values at integer coordinates
+* 		given by WlzGreyValueGet(). Linear interpolation is
+* 		bi/tri-linear and cubic interpolation is separable
+* 		Catmull-Rom.
+* \param	gVWSp			Grey value work space.
+* \param	interp			Interpolation method.
+* \param	dim			Dimension of the object.
+* \param	pos			Given position.
+*/
+static double	WlzTstGreyValueGetNRef(WlzGreyValueWSpace *gVWSp,
+				       WlzInterpolationType interp,
+				       int dim, WlzDVertex3 pos)
+{
+  int		idK,
+  		idL,
+		idP;
+  int		i0[3],
+  		n[3];
+  double	v = 0.0;
+  double	w[3][4];
+
+  if(interp == WLZ_INTERPOLATION_NEAREST)
+  {
+    v = WlzTstGreyValueGetNInt(gVWSp, WLZ_NINT(pos.vtZ),
+    			       WLZ_NINT(pos.vtY), WLZ_NINT(pos.vtX));
+  }
+  else
+  {
+    WlzTstGreyValueGetNWeights(interp, pos.vtX, i0 + 0, n + 0, w[0]);
+    WlzTstGreyValueGetNWeights(interp, pos.vtY, i0 + 1, n + 1, w[1]);
+    if(dim == 2)
+    {
+      i0[2] = 0;
+      n[2] = 1;
+      w[2][0] = 1.0;
+    }
+    else
+    {
+      WlzTstGreyValueGetNWeights(interp, pos.vtZ, i0 + 2, n + 2, w[2]);
+    }
+    for(idP = 0; idP < n[2]; ++idP)
+    {
+      for(idL = 0; idL < n[1]; ++idL)
+      {
+	for(idK = 0; idK < n[0]; ++idK)
+	{
+	  v += w[2][idP] * w[1][idL] * w[0][idK] *
+	       WlzTstGreyValueGetNInt(gVWSp, i0[2] + idP, i0[1] + idL,
+	                              i0[0] + idK);
+	}
+      }
+    }
+  }
+  return(v);
+}
+
+/*!
+* \return	Grey value.
+* \ingroup	BinWlzTst
+* \brief	Gets the double grey value at the given integer
+* 		coordinates, which is the background value if outside
+* 		the object.
+* \param	gVWSp			Grey value work space.
+* \param	pl			Plane coordinate.
+* \param	ln			Line coordinate.
+* \param	kl			Column coordinate.
+*/
+static double	WlzTstGreyValueGetNInt(WlzGreyValueWSpace *gVWSp,
+				       int pl, int ln, int kl)
+{
+  WlzGreyValueGet(gVWSp, pl, ln, kl);
+  return(gVWSp->gVal[0].dbv);
+}
+
+/*!
+* \ingroup	BinWlzTst
+* \brief	Computes the first integer coordinate, number of
+* 		coordinates and their weights for linear or Catmull-Rom
+* 		cubic interpolation at the given coordinate.
+* \param	interp			Interpolation method, linear or
+* 					cubic.
+* \param	t			Given coordinate.
+* \param	dstI0			Destination pointer for the first
+* 					integer coordinate.
+* \param	dstN			Destination pointer for the number
+* 					of integer coordinates.
+* \param	w			Array of at least four for the
+* 					weights.
+*/
+static void	WlzTstGreyValueGetNWeights(WlzInterpolationType interp,
+					   double t, int *dstI0, int *dstN,
+					   double *w)
+{
+  int		i;
+  double	f,
+  		f2,
+		f3;
+
+  i = (int )floor(t);
+  f = t - i;
+  if(interp == WLZ_INTERPOLATION_LINEAR)
+  {
+    *dstI0 = i;
+    *dstN = 2;
+    w[0] = 1.0 - f;
+    w[1] = f;
+  }
+  else
+  {
+    f2 = f * f;
+    f3 = f2 * f;
+    *dstI0 = i - 1;
+    *dstN = 4;
+    w[0] = 0.5 * (-f3 + (2.0 * f2) - f);
+    w[1] = 0.5 * ((3.0 * f3) - (5.0 * f2) + 2.0);
+    w[2] = 0.5 * ((-3.0 * f3) + (4.0 * f2) + f);
+    w[3] = 0.5 * (f3 - f2);
+  }
+}
@@ -0,0 +1,471 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstStructGrey_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstStructGrey.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the flat grey level dilation and erosion of
+* 		WlzStructGreyDilation() and WlzStructGreyErosion().
+* 		A circle or sphere object with random integer grey
+* 		values is dilated and eroded by a box, a disc or sphere
+* 		and a box which does not contain the origin. The values
+* 		are compared with those found by a brute force search
+* 		for the maximum or minimum value over the structuring
+* 		element. The test fails if any value differs.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <Wlz.h>
+
+static int			WlzTstStructGreyCheck(
+				  WlzObject *gObj,
+				  WlzObject *sObj,
+				  WlzObject *rObj,
+				  int dilate,
+				  int *dstNPos,
+				  WlzErrorNum *dstErr);
+
+/* Externals required by getopt  - not in ANSI C standard */
+#ifdef __STDC__ /* [ */
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+#endif /* __STDC__ ] */
+
+int		main(int argc, char *argv[])
+{
+  int		idD,
+  		idE,
+  		dim = 2,
+		nFail = 0,
+  		ok = 1,
+  		option,
+  		usage = 0,
+		verbose = 0;
+  long		seed = 0;
+  double	radius = 0.0,
+  		elmRadius = 3.0;
+  int		**dat = NULL;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL,
+		*sObj = NULL;
+  WlzObject	*elm[3];
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const char	*errMsgStr;
+  const char	*elmStr[3] = {"box", "ball", "offset box"};
+  static char   optList[] = "23hve:r:s:";
+
+  opterr = 0;
+  elm[0] = elm[1] = elm[2] = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case '2':
+        dim = 2;
+	break;
+      case '3':
+        dim = 3;
+	break;
+      case 'e':
+        if((sscanf(optarg, "%lg", &elmRadius) != 1) || (elmRadius < 1.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'r':
+        if((sscanf(optarg, "%lg", &radius) != 1) || (radius < 1.0))
+	{
+	  usage = 1;
+	}
+	break;
+      case 's':
+        if(sscanf(optarg, "%ld", &seed) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+        usage = 1;
+	break;
+    }
+  }
+  ok = (usage == 0);
+  /* Make a circle or sphere object with random grey values by applying
+   * it as a template to a rectangle or cuboid with random values and
+   * make the structuring elements. */
+  if(ok)
+  {
+    int		sz;
+
+    if(radius < 1.0)
+    {
+      radius = (dim == 2)? 20.0: 10.0;
+    }
+    AlgRandSeed(seed);
+    sz = (int )ceil(2.0 * radius);
+    bgdV.type = WLZ_GREY_INT;
+    bgdV.v.inv = 0;
+    if(dim == 2)
+    {
+      if(AlcInt2Calloc(&dat, sz + 1, sz + 1) != ALC_ER_NONE)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	rObj = WlzMakeRect(0, sz, 0, sz, WLZ_GREY_INT, *dat, bgdV,
+			   NULL, NULL, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        sObj = WlzMakeCircleObject(radius, radius, radius, &errNum);
+      }
+    }
+    else
+    {
+      rObj = WlzMakeCuboid(0, sz, 0, sz, 0, sz, WLZ_GREY_INT, bgdV,
+      			   NULL, NULL, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        sObj = WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, radius,
+				   radius, radius, radius, &errNum);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzAssignObject(rObj, NULL);
+      sObj = WlzAssignObject(sObj, NULL);
+      gVWSp = WlzGreyValueMakeWSp(rObj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idK,
+      		idL,
+		idZ;
+
+      for(idZ = 0; idZ <= ((dim == 2)? 0: sz); ++idZ)
+      {
+	for(idL = 0; idL <= sz; ++idL)
+	{
+	  for(idK = 0; idK <= sz; ++idK)
+	  {
+	    WlzGreyValueGet(gVWSp, idZ, idL, idK);
+	    *(gVWSp->gPtr[0].inp) = (int )floor(1000.0 * AlgRandUniform());
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(gVWSp);
+      gVWSp = NULL;
+      obj = WlzAssignObject(WlzGreyTemplate(rObj, sObj, bgdV, &errNum),
+      			    NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      elm[0] = (dim == 2)?
+	       WlzMakeRectangleObject(elmRadius, elmRadius, 0.0, 0.0,
+	       			      &errNum):
+	       WlzMakeCuboidObject(WLZ_3D_DOMAINOBJ,
+	       			   elmRadius, elmRadius, elmRadius,
+				   0.0, 0.0, 0.0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      elm[1] = (dim == 2)?
+	       WlzMakeCircleObject(elmRadius, 0.0, 0.0, &errNum):
+	       WlzMakeSphereObject(WLZ_3D_DOMAINOBJ, elmRadius,
+	       			   0.0, 0.0, 0.0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      elm[2] = (dim == 2)?
+	       WlzMakeRectangleObject(elmRadius, 1.0, elmRadius + 1.0, 0.0,
+	       			      &errNum):
+	       WlzMakeCuboidObject(WLZ_3D_DOMAINOBJ, elmRadius, 1.0, 1.0,
+				   elmRadius + 1.0, 0.0, 0.0, &errNum);
+    }
+    for(idE = 0; idE < 3; ++idE)
+    {
+      elm[idE] = WlzAssignObject(elm[idE], NULL);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to create test objects (%s).\n",
+		     *argv, errMsgStr);
+    }
+  }
+  /* Dilate and erode by each of the structuring elements and check
+   * the values. */
+  for(idE = 0; ok && (idE < 3); ++idE)
+  {
+    for(idD = 0; ok && (idD < 2); ++idD)
+    {
+      int	nPos = 0,
+      		nBad = 0;
+      WlzObject	*tObj;
+
+      tObj = (idD == 0)? WlzStructGreyDilation(obj, elm[idE], &errNum):
+                         WlzStructGreyErosion(obj, elm[idE], &errNum);
+      tObj = WlzAssignObject(tObj, NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nBad = WlzTstStructGreyCheck(obj, elm[idE], tObj, idD == 0,
+				     &nPos, &errNum);
+      }
+      (void )WlzFreeObj(tObj);
+      if(errNum != WLZ_ERR_NONE)
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	(void )fprintf(stderr,
+		       "%s: Failed to %s by %s (%s).\n",
+		       *argv, (idD == 0)? "dilate": "erode", elmStr[idE],
+		       errMsgStr);
+      }
+      else
+      {
+        if(nBad > 0)
+	{
+	  ++nFail;
+	}
+        if(verbose || (nBad > 0))
+	{
+	  (void )fprintf(stderr,
+	  		 "%s: %s by %s, %d positions, %d errors\n",
+			 *argv, (idD == 0)? "dilation": "erosion",
+			 elmStr[idE], nPos, nBad);
+	}
+      }
+    }
+  }
+  if(ok)
+  {
+    ok = (nFail == 0);
+    (void )printf("%s: %dD, %d of 6 dilations and erosions with errors "
+                  "(%s)\n",
+		  *argv, dim, nFail, (ok)? "pass": "FAIL");
+  }
+  for(idE = 0; idE < 3; ++idE)
+  {
+    (void )WlzFreeObj(elm[idE]);
+  }
+  (void )WlzFreeObj(obj);
+  (void )WlzFreeObj(rObj);
+  (void )WlzFreeObj(sObj);
+  if(dat)
+  {
+    Alc2Free((void **)dat);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-2|3] [-h] [-v] [-e #] [-r #] [-s #]\n"
+    "Tests WlzStructGreyDilation() and WlzStructGreyErosion() by\n"
+    "comparing the values they give for a circle or sphere with random\n"
+    "integer values with those found by a brute force search for the\n"
+    "maximum or minimum value over the structuring element. Each is\n"
+    "tested using a box, a disc or sphere and a box which does not\n"
+    "contain the origin.\n"
+    "Options are:\n"
+    "  -2  Two dimensional object (default).\n"
+    "  -3  Three dimensional object.\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n"
+    "  -e  Radius of the structuring elements (default %g).\n"
+    "  -r  Radius of the circle or sphere (default 20 for 2D, 10 for 3D).\n"
+    "  -s  Seed for the pseudo-random number generator (default %ld).\n",
+    *argv, elmRadius, seed);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Number of positions at which the values differ.
+* \ingroup	BinWlzTst
+* \brief	Checks the values of a flat grey level dilation or
+* 		erosion by a brute force search. The dilated value at
+* 		\f$p\f$ should be the maximum of the given values at
+* 		\f$p - s\f$ and the eroded value the minimum of the
+* 		given values at \f$p + s\f$, for all \f$s\f$ in the
+* 		structuring element for which these positions are within
+* 		the given object's domain, or the background value if
+* 		there are none.
+* \param	gObj			Given object with integer values.
+* \param	sObj			Structuring element.
+* \param	rObj			Dilated or eroded object to check.
+* \param	dilate			Dilation if non-zero, otherwise
+* 					erosion.
+* \param	dstNPos			Destination pointer for the number
+* 					of positions checked.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzTstStructGreyCheck(WlzObject *gObj, WlzObject *sObj,
+				      WlzObject *rObj, int dilate,
+				      int *dstNPos, WlzErrorNum *dstErr)
+{
+  int		idS,
+  		nS = 0,
+  		nPos = 0,
+		nBad = 0;
+  WlzIVertex3	pos;
+  WlzIBox3	gBox,
+  		sBox;
+  WlzPixelV	bgdV;
+  WlzIVertex3	*sOff = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL,
+  		*rVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Find the offsets of the structuring element. */
+  sBox = WlzBoundingBox3I(sObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gBox = WlzBoundingBox3I(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((sOff = (WlzIVertex3 *)
+               AlcMalloc((sBox.xMax - sBox.xMin + 1) *
+	                 (sBox.yMax - sBox.yMin + 1) *
+			 (sBox.zMax - sBox.zMin + 1) *
+			 sizeof(WlzIVertex3))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pos.vtZ = sBox.zMin; pos.vtZ <= sBox.zMax; ++pos.vtZ)
+    {
+      for(pos.vtY = sBox.yMin; pos.vtY <= sBox.yMax; ++pos.vtY)
+      {
+	for(pos.vtX = sBox.xMin; pos.vtX <= sBox.xMax; ++pos.vtX)
+	{
+	  if(WlzInsideDomain(sObj, pos.vtZ, pos.vtY, pos.vtX, NULL))
+	  {
+	    sOff[nS++] = pos;
+	  }
+	}
+      }
+    }
+    bgdV = WlzGetBackground(rObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgdV, bgdV, WLZ_GREY_INT);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rVWSp = WlzGreyValueMakeWSp(rObj, &errNum);
+  }
+  /* Check the value at each position of the given object's domain. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pos.vtZ = gBox.zMin; pos.vtZ <= gBox.zMax; ++pos.vtZ)
+    {
+      for(pos.vtY = gBox.yMin; pos.vtY <= gBox.yMax; ++pos.vtY)
+      {
+	for(pos.vtX = gBox.xMin; pos.vtX <= gBox.xMax; ++pos.vtX)
+	{
+	  if(WlzInsideDomain(gObj, pos.vtZ, pos.vtY, pos.vtX, NULL))
+	  {
+	    int	  n = 0,
+	    	  v = 0;
+
+	    for(idS = 0; idS < nS; ++idS)
+	    {
+	      WlzIVertex3 q;
+
+	      if(dilate)
+	      {
+		WLZ_VTX_3_SUB(q, pos, sOff[idS]);
+	      }
+	      else
+	      {
+		WLZ_VTX_3_ADD(q, pos, sOff[idS]);
+	      }
+	      if(WlzInsideDomain(gObj, q.vtZ, q.vtY, q.vtX, NULL))
+	      {
+		int	u;
+
+		WlzGreyValueGet(gVWSp, q.vtZ, q.vtY, q.vtX);
+		u = gVWSp->gVal[0].inv;
+		if((n == 0) || (dilate && (u > v)) || (!dilate && (u < v)))
+		{
+		  v = u;
+		}
+		++n;
+	      }
+	    }
+	    if(n == 0)
+	    {
+	      v = bgdV.v.inv;
+	    }
+	    WlzGreyValueGet(rVWSp, pos.vtZ, pos.vtY, pos.vtX);
+	    if(rVWSp->gVal[0].inv != v)
+	    {
+	      ++nBad;
+	    }
+	    ++nPos;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(sOff);
+  WlzGreyValueFreeWSp(gVWSp);
+  WlzGreyValueFreeWSp(rVWSp);
+  *dstNPos = nPos;
+  *dstErr = errNum;
+  return(nBad);
+}
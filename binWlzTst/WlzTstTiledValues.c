@@ -42,6 +42,7 @@ static char _WlzTstTiledValues_c[] = "University of Edinburgh $Id$";
 
 
 #include <sys/time.h>
+#include <stdlib.h>
 #include <limits.h>
 #include <float.h>
 #include <string.h>
@@ -54,6 +55,14 @@ extern int	optind,
 		opterr,
 		optopt;
 
+static WlzErrorNum		WlzTstTiledValuesConcurrent(
+				  WlzObject *tlObj,
+				  int *dstNBad);
+static WlzUByte			WlzTstTiledValuesFn(
+				  int x,
+				  int y,
+				  int z);
+
 int		main(int argc, char *argv[])
 {
   int		option,
@@ -61,7 +70,8 @@ int		main(int argc, char *argv[])
 		usage = 0,
 		dim = 2,
 		section = 0,
-		timer = 0;
+		timer = 0,
+		concurrent = 0;
   double	yaw = 0.0,
   		pitch = 0.0,
 		roll =  0.0,
@@ -83,7 +93,7 @@ int		main(int argc, char *argv[])
   struct timeval times[3];
   const char	*errMsg;
   const size_t	tlSz = 4096;
-  static char	optList[] = "hsto:S:",
+  static char	optList[] = "chsto:S:",
   		inFileStrDef[] = "-";
 
   opterr = 0;
@@ -99,6 +109,9 @@ int		main(int argc, char *argv[])
   {
     switch(option)
     {
+      case 'c':
+        concurrent = 1;
+	break;
       case 'o':
         outFileStr = optarg;
 	break;
@@ -208,6 +221,21 @@ int		main(int argc, char *argv[])
 		     *argv, errMsg);
     }
   }
+  if(ok && concurrent)
+  {
+    int		nBad = 0;
+
+    errNum = WlzTstTiledValuesConcurrent(tlObj, &nBad);
+    if((errNum != WLZ_ERR_NONE) || (nBad > 0))
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Concurrent access through a tile cache failed,\n"
+		     "%d incorrect values (%s).\n",
+		     *argv, nBad, errMsg);
+    }
+  }
   if(ok && (outFileStr != NULL))
   {
     if(((fP = (strcmp(outFileStr, "-")? fopen(outFileStr, "w"):
@@ -284,10 +312,13 @@ int		main(int argc, char *argv[])
     (void )fprintf(stderr,
     "Usage: %s%s",
     *argv,
-    " [-o<output object>] [-h] [-o <file>] [-s] [-S <file>] [-t]\n"
+    " [-o<output object>] [-c] [-h] [-o <file>] [-s] [-S <file>] [-t]\n"
     "                  [<input object>]\n"
     "Copied the input object to an object with tiled values.\n"
     "Options:\n"
+    "  -c  Check concurrent reading and writing of the tiled values\n"
+    "      through a small (1MB) tile cache. The object should cover\n"
+    "      more tiles than fit in the cache.\n"
     "  -h  Prints this usage information.\n"
     "  -o  Output tiled object.\n"
     "  -s  Cut section from tiled object.\n"
@@ -296,3 +327,211 @@ int		main(int argc, char *argv[])
   }
   return(!ok);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Checks concurrent reading and writing of tiled values
+* 		through a tile cache. The tiled object is written to a
+* 		temporary file which is then read back with a 1MB tile
+* 		cache. All values are cleared and then set in parallel
+* 		over the lines, so that each tile is modified by several
+* 		threads, while values of the neighbouring lines are read
+* 		and checked to be either cleared or set. Finally all
+* 		values are checked to have been set.
+* \param	tlObj			Given object with unsigned byte
+* 					tiled values.
+* \param	dstNBad			Destination pointer for the number
+* 					of incorrect values.
+*/
+static WlzErrorNum WlzTstTiledValuesConcurrent(WlzObject *tlObj,
+					       int *dstNBad)
+{
+  int		idL,
+  		nLn = 0,
+		nBad = 0;
+  WlzIBox3	bBox;
+  FILE		*fP = NULL;
+  WlzObject	*cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((fP = tmpfile()) == NULL)
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else
+  {
+    errNum = WlzWriteObj(fP, tlObj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )fflush(fP);
+    rewind(fP);
+    (void )setenv("WLZ_TILED_VALUES_CACHE", "1", 1);
+    cObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+    (void )unsetenv("WLZ_TILED_VALUES_CACHE");
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((WlzGreyTableIsTiled(cObj->values.core->type) !=
+        WLZ_GREY_TAB_TILED) || (cObj->values.t->cache == NULL))
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+    else
+    {
+      bBox = WlzBoundingBox3I(cObj, &errNum);
+      nLn = (bBox.zMax - bBox.zMin + 1) * (bBox.yMax - bBox.yMin + 1);
+    }
+  }
+  /* Clear all values. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzGreyValueWSpace *gVWSp;
+
+    gVWSp = WlzGreyValueMakeWSp(cObj, &errNum);
+    for(idL = 0; (errNum == WLZ_ERR_NONE) && (idL < nLn); ++idL)
+    {
+      int	x,
+		y,
+		z;
+
+      y = bBox.yMin + (idL % (bBox.yMax - bBox.yMin + 1));
+      z = bBox.zMin + (idL / (bBox.yMax - bBox.yMin + 1));
+      for(x = bBox.xMin; x <= bBox.xMax; ++x)
+      {
+	if(WlzInsideDomain(cObj, z, y, x, NULL))
+	{
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  *(gVWSp->gPtr[0].ubp) = 0;
+	}
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  /* Set the values with neighbouring lines being set by different
+   * threads, while reading the values of the next line. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel reduction(+:nBad)
+#endif
+    {
+      WlzGreyValueWSpace *gVWSp[2] = {NULL};
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if((gVWSp[0] = WlzGreyValueMakeWSp(cObj, &errNum2)) != NULL)
+      {
+        gVWSp[1] = WlzGreyValueMakeWSp(cObj, &errNum2);
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(static, 1)
+#endif
+      for(idL = 0; idL < nLn; ++idL)
+      {
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  int	x,
+		y,
+		yN,
+		z;
+
+	  y = bBox.yMin + (idL % (bBox.yMax - bBox.yMin + 1));
+	  z = bBox.zMin + (idL / (bBox.yMax - bBox.yMin + 1));
+	  yN = (y < bBox.yMax)? y + 1: y - 1;
+	  for(x = bBox.xMin; x <= bBox.xMax; ++x)
+	  {
+	    if(WlzInsideDomain(cObj, z, y, x, NULL))
+	    {
+	      WlzGreyValueGet(gVWSp[0], z, y, x);
+	      *(gVWSp[0]->gPtr[0].ubp) = WlzTstTiledValuesFn(x, y, z);
+	    }
+	    if(WlzInsideDomain(cObj, z, yN, x, NULL))
+	    {
+	      WlzUByte	v;
+
+	      WlzGreyValueGet(gVWSp[1], z, yN, x);
+	      v = gVWSp[1]->gVal[0].ubv;
+	      if((v != 0) && (v != WlzTstTiledValuesFn(x, yN, z)))
+	      {
+		++nBad;
+	      }
+	    }
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(gVWSp[0]);
+      WlzGreyValueFreeWSp(gVWSp[1]);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzTstTiledValuesConcurrent)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  /* Check that all values have been set. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzGreyValueWSpace *gVWSp;
+
+    gVWSp = WlzGreyValueMakeWSp(cObj, &errNum);
+    for(idL = 0; (errNum == WLZ_ERR_NONE) && (idL < nLn); ++idL)
+    {
+      int	x,
+		y,
+		z;
+
+      y = bBox.yMin + (idL % (bBox.yMax - bBox.yMin + 1));
+      z = bBox.zMin + (idL / (bBox.yMax - bBox.yMin + 1));
+      for(x = bBox.xMin; x <= bBox.xMax; ++x)
+      {
+	if(WlzInsideDomain(cObj, z, y, x, NULL))
+	{
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  if(gVWSp->gVal[0].ubv != WlzTstTiledValuesFn(x, y, z))
+	  {
+	    ++nBad;
+	  }
+	}
+      }
+    }
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  if(cObj)
+  {
+    WlzErrorNum	errNum2;
+
+    errNum2 = WlzFreeObj(cObj);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = errNum2;
+    }
+  }
+  if(fP)
+  {
+    (void )fclose(fP);
+  }
+  *dstNBad = nBad;
+  return(errNum);
+}
+
+/*!
+* \return	Non-zero value for the given position.
+* \ingroup	BinWlzTst
+* \brief	Computes the value set at a position by the concurrent tile
+* 		cache check.
+* \param	x			Column coordinate.
+* \param	y			Line coordinate.
+* \param	z			Plane coordinate.
+*/
+static WlzUByte WlzTstTiledValuesFn(int x, int y, int z)
+{
+  return((WlzUByte )(((x + (3 * y) + (7 * z)) & 0x7f) + 1));
+}
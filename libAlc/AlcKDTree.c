@@ -45,6 +45,44 @@ static char _AlcKDTree_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <limits.h>
 #include <Alc.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_AlcKDTBuildJob
+* \ingroup	AlcKDTree
+* \brief	A subtree for which building has been deferred so that
+*		it can be built concurrently with other subtrees.
+*/
+typedef struct _AlcKDTBuildJob
+{
+  AlcKDTNode	*parent;	/*!< Parent of the subtree. */
+  int		cmp;		/*!< Child of the parent: +ve for childP,
+  				     -ve for childN. */
+  size_t	off;		/*!< Offset into the permutation array. */
+  size_t	cnt;		/*!< Number of keys in the subtree. */
+} AlcKDTBuildJob;
+
+/*!
+* \struct	_AlcKDTBuildWSp
+* \ingroup	AlcKDTree
+* \brief	Workspace used while building a balanced tree.
+*/
+typedef struct _AlcKDTBuildWSp
+{
+  AlcKDTTree	*tree;		/*!< The tree being built. */
+  AlcPointP	keys;		/*!< Array of all the keys. */
+  size_t	*perm;		/*!< Permutation of key indices which is
+  				     partitioned as the tree is built. */
+  AlcKDTNode	*nodes;		/*!< Nodes, one per key with the node
+  				     for a subtree placed at the position
+				     of it's median in the permutation. */
+  int		jobDepth;	/*!< Depth at which subtrees are deferred,
+  				     not used if jobs is NULL. */
+  int		nJobs;		/*!< Number of deferred subtrees. */
+  AlcKDTBuildJob *jobs;		/*!< Deferred subtrees. */
+} AlcKDTBuildWSp;
 
 static void			AlcKDTBoundSet(
 				  AlcKDTTree *tree,
@@ -65,6 +103,32 @@ static int			AlcKDTNodeValueCompare(
 				  AlcKDTTree *tree,
 				  AlcKDTNode *node,
 				  AlcPointP key);
+static int			AlcKDTKeyCompare(
+				  AlcKDTTree *tree,
+				  int split,
+				  AlcPointP key0,
+				  AlcPointP key1);
+static size_t			AlcKDTKeyMedian3(
+				  AlcKDTBuildWSp *wSp,
+				  int split,
+				  size_t i0,
+				  size_t i1,
+				  size_t i2);
+static void			AlcKDTKeyPartition(
+				  AlcKDTBuildWSp *wSp,
+				  int split,
+				  AlcPointP pKey,
+				  size_t lo,
+				  size_t hi,
+				  size_t *dstLo,
+				  size_t *dstHi);
+static AlcPointP		AlcKDTKeyAt(
+				  AlcKDTBuildWSp *wSp,
+				  size_t idx);
+static double			AlcKDTNodeBoxDistSq(
+				  AlcKDTTree *tree,
+				  AlcKDTNode *node,
+				  AlcPointP key);
 static int			AlcKDTNodeIntersectsSphere(
 				  AlcKDTTree *tree,
 				  AlcKDTNode *node,
@@ -85,6 +149,22 @@ static AlcKDTNode 		*AlcKDTNodeGetNN(
 				  AlcPointP key,
 				  double minDist,
 				  double *dstDist);
+static AlcKDTNode		*AlcKDTNodeBuild(
+				  AlcKDTBuildWSp *wSp,
+				  AlcKDTNode *parent,
+				  int cmp,
+				  size_t off,
+				  size_t cnt,
+				  int depth);
+static void			AlcKDTNodeGetKNN(
+				  AlcKDTTree *tree,
+				  AlcKDTNode *node,
+				  AlcPointP key,
+				  int k,
+				  double maxDistSq,
+				  int *nFnd,
+				  AlcKDTNode **nodes,
+				  double *distSq);
 
 /*!
 * \return     	KD-tree data structure, or NULL on error.
@@ -157,6 +237,182 @@ AlcKDTTree	*AlcKDTTreeNew(AlcPointType type, int dim, double tol,
   return(tree);
 }
 
+/*!
+* \return     	KD-tree data structure, or NULL on error.
+* \ingroup	AlcKDTree
+* \brief        Creates a balanced KD-tree from the given array of keys.
+*		Rather than inserting the keys one at a time the tree
+*		is built top down, each node taking the median key
+*		of it's subtree (using the same comparison as
+*		AlcKDTInsert()) with all nodes and their keys being
+*		allocated as a single block. Keys which match a key
+*		already in the tree (within the tolerance) are not
+*		added to the tree, just as for AlcKDTInsert(), of a
+*		set of matching keys only the one with the lowest
+*		index is kept. The index of each node is the index
+*		of it's key in the given array. When built with
+*		OpenMP the subtrees below the first few levels are
+*		built concurrently.
+*		Further nodes may be added to the tree using
+*		AlcKDTInsert() and the tree is free'd using
+*		AlcKDTTreeFree() as usual.
+* \param        type			Type of tree node key.
+* \param	dim			Dimension of tree (must be >= 1).
+* \param	tol			Tollerance for key comparision,
+*					see AlcKDTTreeNew().
+* \param	nKeys			Number of keys.
+* \param	keys			Array of nKeys * dim key values
+*					which must be of the given type.
+* \param        dstErr		    	Destination pointer for error
+*                                       code, may be NULL.
+*/
+AlcKDTTree	*AlcKDTTreeBuild(AlcPointType type, int dim, double tol,
+				 size_t nKeys, void *keys, AlcErrno *dstErr)
+{
+  int		nThr = 1;
+  size_t	idx,
+  		nUsed = 0;
+  AlcKDTNode	*node;
+  AlcKDTTree	*tree = NULL;
+  AlcBlockStack	*nStk,
+		*kStk;
+  AlcKDTBuildWSp wSp;
+  AlcErrno	errNum = ALC_ER_NONE;
+  const size_t	minJobSz = 1024;
+
+  wSp.perm = NULL;
+  wSp.jobs = NULL;
+  wSp.nJobs = 0;
+  wSp.jobDepth = 0;
+  if((nKeys > 0) && (keys == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else
+  {
+    tree = AlcKDTTreeNew(type, dim, tol, nKeys, &errNum);
+  }
+  if((errNum == ALC_ER_NONE) && (nKeys > 0))
+  {
+    wSp.tree = tree;
+    wSp.keys.kV = keys;
+    if((wSp.perm = (size_t *)AlcMalloc(nKeys * sizeof(size_t))) == NULL)
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+    else
+    {
+      nStk = AlcBlockStackNew(nKeys, sizeof(AlcKDTNode), tree->freeStack,
+      			      &errNum);
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      tree->freeStack = nStk;
+      kStk = AlcBlockStackNew(nKeys, 3 * tree->keySz, tree->freeStack,
+      			      &errNum);
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      tree->freeStack = kStk;
+      nStk->elmCnt = nStk->maxElm;
+      kStk->elmCnt = kStk->maxElm;
+      wSp.nodes = (AlcKDTNode *)(nStk->elements);
+      for(idx = 0; idx < nKeys; ++idx)
+      {
+        node = wSp.nodes + idx;
+	node->split = -1;
+	if(tree->type == ALC_POINTTYPE_INT)
+	{
+	  node->key.kI = (int *)(kStk->elements) + (3 * dim * idx);
+	  node->boundN.kI = node->key.kI + dim;
+	  node->boundP.kI = node->key.kI + (2 * dim);
+	}
+	else /* tree->type == ALC_POINTTYPE_DBL */
+	{
+	  node->key.kD = (double *)(kStk->elements) + (3 * dim * idx);
+	  node->boundN.kD = node->key.kD + dim;
+	  node->boundP.kD = node->key.kD + (2 * dim);
+	}
+        *(wSp.perm + idx) = idx;
+      }
+#ifdef _OPENMP
+      nThr = omp_get_max_threads();
+#endif
+      /* Subtrees at depth jobDepth are deferred as jobs which can be built
+       * concurrently once the top of the tree is in place. */
+      if(nThr > 1)
+      {
+        while(((1 << wSp.jobDepth) < (4 * nThr)) &&
+	      ((nKeys >> wSp.jobDepth) > minJobSz))
+	{
+	  ++(wSp.jobDepth);
+	}
+      }
+      if((wSp.jobDepth > 0) &&
+         ((wSp.jobs = (AlcKDTBuildJob *)
+	              AlcMalloc((1 << wSp.jobDepth) *
+		                sizeof(AlcKDTBuildJob))) == NULL))
+      {
+        errNum = ALC_ER_ALLOC;
+      }
+    }
+    if(errNum == ALC_ER_NONE)
+    {
+      int	idJ;
+
+      tree->root = AlcKDTNodeBuild(&wSp, NULL, 0, 0, nKeys, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idJ = 0; idJ < wSp.nJobs; ++idJ)
+      {
+        AlcKDTNode *child;
+	AlcKDTBuildJob *job;
+
+	job = wSp.jobs + idJ;
+	child = AlcKDTNodeBuild(&wSp, job->parent, job->cmp,
+				job->off, job->cnt, wSp.jobDepth + 1);
+	if(job->cmp > 0)
+	{
+	  job->parent->childP = child;
+	}
+	else
+	{
+	  job->parent->childN = child;
+	}
+      }
+      /* Nodes not used because of matching keys are made available for
+       * subsequent insertions. */
+      for(idx = 0; idx < nKeys; ++idx)
+      {
+        node = wSp.nodes + idx;
+	if(node->split < 0)
+	{
+	  node->childN = tree->nodeStack;
+	  tree->nodeStack = node;
+	}
+	else
+	{
+	  ++nUsed;
+	}
+      }
+      tree->nNodes = nUsed;
+    }
+  }
+  AlcFree(wSp.perm);
+  AlcFree(wSp.jobs);
+  if(errNum != ALC_ER_NONE)
+  {
+    (void )AlcKDTTreeFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
 /*!
 * \return      	Number of nodes.
 * \ingroup	AlcKDTree
@@ -835,6 +1091,281 @@ static AlcKDTNode *AlcKDTNodeGetNN(AlcKDTTree *tree,  AlcKDTNode *node,
   return(nNNode);
 }
 
+/*!
+* \return	Number of nearest neighbours found, which will be less
+*		than k if the tree has fewer than k nodes within the
+*		maximum distance of the given key.
+* \ingroup	AlcKDTree
+* \brief	Searches for the k nearest neighbour nodes to the given
+*		key within the tree. Unlike AlcKDTGetNN() the search
+*		descends from the root, pruning subtrees using the
+*		distance from the key to their bounding boxes. The tree
+*		is not modified so this function may be called
+*		concurrently for the same tree.
+* \param	tree			Given tree.
+* \param	keyVal			Key values which must be
+*					consistent with the tree's node
+*					key type and dimension.
+* \param	k			Maximum number of nearest
+*					neighbours to find.
+* \param	maxDist			Maximum distance between the given
+*					key and a nearest neighbour, any
+*					node at this or a greater distance
+*					is not a nearest neighbour.
+* \param	dstNodes		Destination array for at least k
+*					nodes, set in order of increasing
+*					distance.
+* \param	dstDist			Destination array for at least k
+*					distances to the nodes, may be NULL.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+int		AlcKDTGetKNN(AlcKDTTree *tree, void *keyVal, int k,
+			     double maxDist, AlcKDTNode **dstNodes,
+			     double *dstDist, AlcErrno *dstErr)
+{
+  int		idx,
+  		nFnd = 0;
+  AlcPointP	key;
+  double	*distSq;
+  double	distBuf[16];
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (keyVal == NULL) || (dstNodes == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(k < 1)
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if((distSq = (dstDist)? dstDist:
+                    (k <= 16)? distBuf:
+		    (double *)AlcMalloc(k * sizeof(double))) == NULL)
+  {
+    errNum = ALC_ER_ALLOC;
+  }
+  else
+  {
+    key.kV = keyVal;
+    AlcKDTNodeGetKNN(tree, tree->root, key, k, maxDist * maxDist,
+    		     &nFnd, dstNodes, distSq);
+    if(dstDist)
+    {
+      for(idx = 0; idx < nFnd; ++idx)
+      {
+	*(dstDist + idx) = sqrt(*(dstDist + idx));
+      }
+    }
+    else if(distSq != distBuf)
+    {
+      AlcFree(distSq);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nFnd);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDTree
+* \brief	Searches for the k nearest neighbour nodes to each of
+*		the given keys within the tree. This is equivalent to
+*		calling AlcKDTGetKNN() for each key in turn, but when
+*		built with OpenMP the queries are shared between
+*		threads.
+* \param	tree			Given tree.
+* \param	nKeys			Number of keys.
+* \param	keyVal			Array of nKeys * dimension key
+*					values which must be consistent
+*					with the tree's node key type.
+* \param	k			Maximum number of nearest
+*					neighbours to find for each key.
+* \param	maxDist			Maximum distance between a key and
+*					a nearest neighbour.
+* \param	dstNodes		Destination array for at least
+*					nKeys * k nodes, with the nodes for
+*					the i'th key starting at i * k.
+* \param	dstDist			Destination array for at least
+*					nKeys * k distances, may be NULL.
+* \param	dstCnt			Destination array for the number
+*					of nearest neighbours found for
+*					each key, may be NULL if k == 1
+*					in which case a NULL node indicates
+*					no nearest neighbour was found.
+*/
+AlcErrno	AlcKDTGetKNNBatch(AlcKDTTree *tree, size_t nKeys,
+				  void *keyVal, int k, double maxDist,
+				  AlcKDTNode **dstNodes, double *dstDist,
+				  int *dstCnt)
+{
+  long		idx;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (dstNodes == NULL) ||
+     ((nKeys > 0) && (keyVal == NULL)) ||
+     ((dstCnt == NULL) && (k != 1)))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(k < 1)
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idx = 0; idx < (long )nKeys; ++idx)
+    {
+      int	nFnd;
+      AlcPointP	key;
+
+      if(tree->type == ALC_POINTTYPE_INT)
+      {
+        key.kI = (int *)keyVal + (idx * tree->dim);
+      }
+      else /* tree->type == ALC_POINTTYPE_DBL */
+      {
+        key.kD = (double *)keyVal + (idx * tree->dim);
+      }
+      nFnd = AlcKDTGetKNN(tree, key.kV, k, maxDist, dstNodes + (idx * k),
+      			  (dstDist)? dstDist + (idx * k): NULL, NULL);
+      if(dstCnt)
+      {
+        *(dstCnt + idx) = nFnd;
+      }
+      else if(nFnd == 0)
+      {
+        *(dstNodes + idx) = NULL;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	<void>
+* \ingroup	AlcKDTree
+* \brief	Recursively searches the subtree with the given node at
+*		it's root for the k nearest neighbours to the given key,
+*		updating the ordered arrays of nodes and squared
+*		distances found so far. The child on the same side of
+*		the node as the key is searched first.
+* \param	tree			Given tree.
+* \param	node			Root of the subtree, may be NULL.
+* \param	key			Given key.
+* \param	k			Maximum number of nearest
+*					neighbours.
+* \param	maxDistSq		Square of the maximum distance.
+* \param	nFnd			Number of nearest neighbours
+*					found so far.
+* \param	nodes			Nearest neighbours found so far.
+* \param	distSq			Squared distances of the nearest
+*					neighbours found so far.
+*/
+static void	AlcKDTNodeGetKNN(AlcKDTTree *tree, AlcKDTNode *node,
+				 AlcPointP key, int k, double maxDistSq,
+				 int *nFnd, AlcKDTNode **nodes,
+				 double *distSq)
+{
+  int		idx;
+  double	dSq,
+  		rSq;
+
+  if(node)
+  {
+    rSq = (*nFnd < k)? maxDistSq: *(distSq + k - 1);
+    if(AlcKDTNodeBoxDistSq(tree, node, key) < rSq)
+    {
+      dSq = AlcKDTKeyDistSq(tree, node->key, key);
+      if(dSq < rSq)
+      {
+	idx = (*nFnd < k)? (*nFnd)++: k - 1;
+	while((idx > 0) && (*(distSq + idx - 1) > dSq))
+	{
+	  *(distSq + idx) = *(distSq + idx - 1);
+	  *(nodes + idx) = *(nodes + idx - 1);
+	  --idx;
+	}
+	*(distSq + idx) = dSq;
+	*(nodes + idx) = node;
+      }
+      if(AlcKDTNodeValueCompare(tree, node, key) > 0)
+      {
+	AlcKDTNodeGetKNN(tree, node->childP, key, k, maxDistSq,
+			 nFnd, nodes, distSq);			/* Recursive */
+	AlcKDTNodeGetKNN(tree, node->childN, key, k, maxDistSq,
+			 nFnd, nodes, distSq);			/* Recursive */
+      }
+      else
+      {
+	AlcKDTNodeGetKNN(tree, node->childN, key, k, maxDistSq,
+			 nFnd, nodes, distSq);			/* Recursive */
+	AlcKDTNodeGetKNN(tree, node->childP, key, k, maxDistSq,
+			 nFnd, nodes, distSq);			/* Recursive */
+      }
+    }
+  }
+}
+
+/*!
+* \return	Square of the distance from the key to the bounding box.
+* \ingroup	AlcKDTree
+* \brief	Computes the squared distance from the given key to the
+*		bounding box of the given node, this is zero if the key
+*		is within the box. For floating point keys the box is
+*		expanded by the tree's tolerance, since keys which
+*		match within the tolerance in the splitting dimension
+*		may lie on either side of a split.
+* \param	tree			Given tree.
+* \param	node			Given node.
+* \param	key			Given key.
+*/
+static double	AlcKDTNodeBoxDistSq(AlcKDTTree *tree, AlcKDTNode *node,
+				    AlcPointP key)
+{
+  int		idx;
+  double	tD0,
+  		distSq = 0.0;
+
+  if(tree->type == ALC_POINTTYPE_INT)
+  {
+    for(idx = 0; idx < tree->dim; ++idx)
+    {
+      if((tD0 = (double )*(node->boundN.kI + idx) -
+                (double )*(key.kI + idx)) <= 0.0)
+      {
+	tD0 = (double )*(key.kI + idx) - (double )*(node->boundP.kI + idx);
+      }
+      if(tD0 > 0.0)
+      {
+	distSq += tD0 * tD0;
+      }
+    }
+  }
+  else /* tree->type == ALC_POINTTYPE_DBL */
+  {
+    for(idx = 0; idx < tree->dim; ++idx)
+    {
+      if((tD0 = *(node->boundN.kD + idx) - *(key.kD + idx)) <= 0.0)
+      {
+	tD0 = *(key.kD + idx) - *(node->boundP.kD + idx);
+      }
+      tD0 -= tree->tol;
+      if(tD0 > 0.0)
+      {
+	distSq += tD0 * tD0;
+      }
+    }
+  }
+  return(distSq);
+}
+
 
 /*!
 * \return	Non zero if the given node intersects the given sphere.
@@ -965,6 +1496,25 @@ static double	AlcKDTKeyDistSq(AlcKDTTree *tree,
 */
 static int	AlcKDTNodeValueCompare(AlcKDTTree *tree, AlcKDTNode *node,
 				       AlcPointP key)
+{
+  return(AlcKDTKeyCompare(tree, node->split, node->key, key));
+}
+
+/*!
+* \return	Result of comparision 0, -ve or +ve.
+* \ingroup	AlcKDTree
+* \brief  	Compares the values of the two given keys, starting with
+*		the given splitting dimension and then cycling through
+*		the remaining dimensions until a difference is found.
+* \param     	tree			Tree, used to determine key type
+*					and tolerance.
+* \param	split			Splitting dimension.
+* \param	key0			First key.
+* \param	key1			Second key, the result is the sign
+*					of key0 - key1.
+*/
+static int	AlcKDTKeyCompare(AlcKDTTree *tree, int split,
+				 AlcPointP key0, AlcPointP key1)
 {
   int		jIdx,
 		kIdx,
@@ -972,20 +1522,20 @@ static int	AlcKDTNodeValueCompare(AlcKDTTree *tree, AlcKDTNode *node,
 
   if(tree->type == ALC_POINTTYPE_INT)
   {
-    jIdx = kIdx = node->split;
+    jIdx = kIdx = split;
     do
     {
-      cmp = *(node->key.kI + jIdx) - *(key.kI + jIdx);
+      cmp = *(key0.kI + jIdx) - *(key1.kI + jIdx);
     } while((cmp == 0) && ((jIdx = (jIdx + 1) % tree->dim) != kIdx));
   }
   else /* tree->type == ALC_POINTTYPE_DBL */
   {
-    jIdx = kIdx = node->split;
+    jIdx = kIdx = split;
     do
     {
       double	diff;
 
-      diff = *(node->key.kD + jIdx) - *(key.kD + jIdx);
+      diff = *(key0.kD + jIdx) - *(key1.kD + jIdx);
       if(fabs(diff) > tree->tol)
       {
 	cmp = (diff > 0)? +1: -1;
@@ -995,6 +1545,221 @@ static int	AlcKDTNodeValueCompare(AlcKDTTree *tree, AlcKDTNode *node,
   return(cmp);
 }
 
+/*!
+* \return	New subtree root node, NULL if the subtree is empty or
+*		has been deferred as a build job.
+* \ingroup	AlcKDTree
+* \brief	Recursively builds the balanced subtree for the keys
+*		indexed by the given range of the permutation array.
+*		The median key becomes the node, keys which compare
+*		less than it are used to build the childP subtree and
+*		those which compare greater the childN subtree.
+* \param	wSp			Build workspace.
+* \param	parent			Parent node, NULL for the root.
+* \param	cmp			Which of the parent's children
+*					the subtree root will be:
+*					  - = 0, parent == null
+*					  - > 0, childP
+*					  - < 0, childN
+* \param	off			Offset of the range in the
+*					permutation array.
+* \param	cnt			Number of keys in the range.
+* \param	depth			Depth of the subtree root in the
+*					tree.
+*/
+static AlcKDTNode *AlcKDTNodeBuild(AlcKDTBuildWSp *wSp, AlcKDTNode *parent,
+				   int cmp, size_t off, size_t cnt, int depth)
+{
+  int		split;
+  size_t	idx,
+		kIdx,
+  		lo,
+		hi,
+		tgt,
+		nLo,
+		nHi;
+  AlcPointP	pKey;
+  AlcKDTNode	*node = NULL;
+  AlcKDTTree	*tree;
+
+  tree = wSp->tree;
+  if(cnt == 0)
+  {
+    return(NULL);
+  }
+  if(wSp->jobs && (depth == wSp->jobDepth))
+  {
+    AlcKDTBuildJob *job;
+
+    job = wSp->jobs + wSp->nJobs++;
+    job->parent = parent;
+    job->cmp = cmp;
+    job->off = off;
+    job->cnt = cnt;
+    return(NULL);
+  }
+  split = (parent == NULL)? 0: (parent->split + 1) % tree->dim;
+  /* Find the median using quickselect. */
+  lo = off;
+  hi = off + cnt;
+  tgt = off + (cnt / 2);
+  while(hi - lo > 1)
+  {
+    kIdx = AlcKDTKeyMedian3(wSp, split, *(wSp->perm + lo),
+			    *(wSp->perm + (lo + hi) / 2),
+			    *(wSp->perm + hi - 1));
+    pKey = AlcKDTKeyAt(wSp, kIdx);
+    AlcKDTKeyPartition(wSp, split, pKey, lo, hi, &nLo, &nHi);
+    if(tgt < nLo)
+    {
+      hi = nLo;
+    }
+    else if(tgt >= nHi)
+    {
+      lo = nHi;
+    }
+    else
+    {
+      break;
+    }
+  }
+  /* Partition the whole range about the median so that the children are
+   * consistent with AlcKDTNodeValueCompare() even if the tolerance makes
+   * the comparison intransitive. */
+  pKey = AlcKDTKeyAt(wSp, *(wSp->perm + tgt));
+  AlcKDTKeyPartition(wSp, split, pKey, off, off + cnt, &nLo, &nHi);
+  kIdx = *(wSp->perm + nLo);
+  for(idx = nLo + 1; idx < nHi; ++idx)
+  {
+    if(*(wSp->perm + idx) < kIdx)
+    {
+      kIdx = *(wSp->perm + idx);
+    }
+  }
+  node = wSp->nodes + nLo;
+  node->idx = kIdx;
+  node->split = split;
+  node->parent = parent;
+  AlcKDTValuesSet(tree, node->key, AlcKDTKeyAt(wSp, kIdx));
+  AlcKDTBoundSet(tree, node, cmp);
+  node->childP = AlcKDTNodeBuild(wSp, node, 1, off, nLo - off,
+  				 depth + 1); 			/* Recursive */
+  node->childN = AlcKDTNodeBuild(wSp, node, -1, nHi, off + cnt - nHi,
+  				 depth + 1); 			/* Recursive */
+  return(node);
+}
+
+/*!
+* \return	Key in the build workspace's key array.
+* \ingroup	AlcKDTree
+* \brief	Gets the key with the given index from the build
+*		workspace's key array.
+* \param	wSp			Build workspace.
+* \param	idx			Index of the key.
+*/
+static AlcPointP AlcKDTKeyAt(AlcKDTBuildWSp *wSp, size_t idx)
+{
+  AlcPointP	key;
+
+  if(wSp->tree->type == ALC_POINTTYPE_INT)
+  {
+    key.kI = wSp->keys.kI + (idx * wSp->tree->dim);
+  }
+  else /* wSp->tree->type == ALC_POINTTYPE_DBL */
+  {
+    key.kD = wSp->keys.kD + (idx * wSp->tree->dim);
+  }
+  return(key);
+}
+
+/*!
+* \return	Index of the median key.
+* \ingroup	AlcKDTree
+* \brief	Finds the median of three keys, used to choose a pivot
+*		when partitioning.
+* \param	wSp			Build workspace.
+* \param	split			Splitting dimension.
+* \param	i0			Index of the first key.
+* \param	i1			Index of the second key.
+* \param	i2			Index of the third key.
+*/
+static size_t	AlcKDTKeyMedian3(AlcKDTBuildWSp *wSp, int split,
+				 size_t i0, size_t i1, size_t i2)
+{
+  size_t	tI;
+  AlcKDTTree	*tree;
+
+  tree = wSp->tree;
+  if(AlcKDTKeyCompare(tree, split, AlcKDTKeyAt(wSp, i0),
+  		      AlcKDTKeyAt(wSp, i1)) > 0)
+  {
+    tI = i0; i0 = i1; i1 = tI;
+  }
+  if(AlcKDTKeyCompare(tree, split, AlcKDTKeyAt(wSp, i1),
+  		      AlcKDTKeyAt(wSp, i2)) > 0)
+  {
+    i1 = i2;
+    if(AlcKDTKeyCompare(tree, split, AlcKDTKeyAt(wSp, i0),
+			AlcKDTKeyAt(wSp, i1)) > 0)
+    {
+      i1 = i0;
+    }
+  }
+  return(i1);
+}
+
+/*!
+* \return	<void>
+* \ingroup	AlcKDTree
+* \brief	Three way partitions the given range of the build
+*		workspace's permutation array about the given pivot
+*		key, so that on return the range [lo, nLo) indexes
+*		keys less than the pivot, [nLo, nHi) keys which match
+*		it and [nHi, hi) keys greater than it.
+* \param	wSp			Build workspace.
+* \param	split			Splitting dimension.
+* \param	pKey			Pivot key, which must not be moved
+*					by the partition.
+* \param	lo			Start of the range.
+* \param	hi			End of the range (not included).
+* \param	dstLo			Destination pointer for nLo.
+* \param	dstHi			Destination pointer for nHi.
+*/
+static void	AlcKDTKeyPartition(AlcKDTBuildWSp *wSp, int split,
+				   AlcPointP pKey, size_t lo, size_t hi,
+				   size_t *dstLo, size_t *dstHi)
+{
+  int		cmp;
+  size_t	idx,
+  		tI;
+  size_t	*perm;
+
+  idx = lo;
+  perm = wSp->perm;
+  while(idx < hi)
+  {
+    cmp = AlcKDTKeyCompare(wSp->tree, split, pKey,
+    			   AlcKDTKeyAt(wSp, *(perm + idx)));
+    if(cmp > 0)
+    {
+      tI = *(perm + lo); *(perm + lo) = *(perm + idx); *(perm + idx) = tI;
+      ++lo;
+      ++idx;
+    }
+    else if(cmp < 0)
+    {
+      --hi;
+      tI = *(perm + hi); *(perm + hi) = *(perm + idx); *(perm + idx) = tI;
+    }
+    else
+    {
+      ++idx;
+    }
+  }
+  *dstLo = lo;
+  *dstHi = hi;
+}
+
 #ifdef ALC_KDT_TEST
 int		main(int argc, char *argv[])
 {
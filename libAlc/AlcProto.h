@@ -536,6 +536,13 @@ extern AlcKDTTree	       *AlcKDTTreeNew(
 				  double tol,
 				  size_t nNodes,
 				  AlcErrno *dstErr);
+extern AlcKDTTree	       *AlcKDTTreeBuild(
+				  AlcPointType type,
+				  int dim,
+				  double tol,
+				  size_t nKeys,
+				  void *keys,
+				  AlcErrno *dstErr);
 extern AlcErrno 	  	AlcKDTTreeFree(
 				    AlcKDTTree *tree);
 extern AlcKDTNode		*AlcKDTNodeNew(
@@ -569,6 +576,23 @@ extern AlcKDTNode	       *AlcKDTGetNN(
 				  double minDist,
 				  double *dstNNDist,
 				  AlcErrno *dstErr);
+extern int			AlcKDTGetKNN(
+				  AlcKDTTree *tree,
+				  void *keyVal,
+				  int k,
+				  double maxDist,
+				  AlcKDTNode **dstNodes,
+				  double *dstDist,
+				  AlcErrno *dstErr);
+extern AlcErrno			AlcKDTGetKNNBatch(
+				  AlcKDTTree *tree,
+				  size_t nKeys,
+				  void *keyVal,
+				  int k,
+				  double maxDist,
+				  AlcKDTNode **dstNodes,
+				  double *dstDist,
+				  int *dstCnt);
 
 /************************************************************************
 * AlcLRUCache.c
@@ -52,6 +52,11 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 * \brief	Cross correlates the given 2D double arrays leaving
 *		the result in the first of the two arrays.
 *		The cross correlation data are un-normalized.
+*		The Fourier transforms are computed using cached
+*		transform plans (see AlgFourPlanGet()) so the array
+*		sizes need not be powers of two, although sizes with
+*		only small prime factors (see AlgFourPlanNiceNum())
+*		are transformed most efficiently.
 * \param	data0			Data for/with obj0's FFT 
 *					(source: AlcDouble2Malloc)
 *					which holds the cross	
@@ -66,18 +71,20 @@ static char _AlgCrossCorr_c[] = "University of Edinburgh $Id$";
 AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 			            int nX, int nY)
 {
-  int		tI0,
-		tI1,
-		idX,
+  int		idX,
 		idY,
   		nX2,
-		nY2;
+		nY2,
+		nPX,
+		nPY;
   double	tD1,
 		tD2,
 		tD3,
 		tD4;
   double	*tDP1,
 		*tDP2;
+  AlgFourPlan	*pX = NULL,
+  		*pY = NULL;
   AlgError	errNum = ALG_ERR_NONE;
   const int	minN = 8,
   		maxN = 1048576;
@@ -87,26 +94,29 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
   {
      errNum = ALG_ERR_FUNC;
   }
-  else
+  else if(((pX = AlgFourPlanGet(nX, &errNum)) != NULL) &&
+          ((pY = AlgFourPlanGet(nY, &errNum)) != NULL))
   {
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI0, nX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&tI1, nY);
-    if((tI0 != nX) || (tI1 != nY))
+    errNum = AlgFourPlanExecReal2D(pX, pY, data0, 0);
+    if(errNum == ALG_ERR_NONE)
     {
-      errNum = ALG_ERR_FUNC;
+      errNum = AlgFourPlanExecReal2D(pX, pY, data1, 0);
     }
   }
   if(errNum == ALG_ERR_NONE)
   {
-    AlgFourReal2D(data0, 1, nX, nY);
-    AlgFourReal2D(data1, 1, nX, nY);
+    /* Multiply the transform of data0 by the complex conjugate of the
+     * transform of data1, with the data packed as by
+     * AlgFourPlanExecReal2D(). */
     nX2 = nX / 2;
     nY2 = nY / 2;
+    nPX = (nX - 1) / 2;
+    nPY = (nY - 1) / 2;
     for(idY = 0; idY < nY; ++idY)
     {
       tDP1 = *(data0 + idY) + 1;
       tDP2 = *(data1 + idY) + 1;
-      for(idX = 1; idX < nX2; ++idX)
+      for(idX = 1; idX <= nPX; ++idX)
       {
 	tD1 = *tDP1;
 	tD2 = *(tDP1 + nX2);
@@ -118,26 +128,31 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
 	++tDP2;
       }
     }
-    for(idX = 0; idX < nX; idX += nX2)
+    for(idX = 0; idX < nX - 2 * nPX; ++idX)
     {
-      for(idY = 1; idY < nY2; ++idY)
+      int	colX;
+
+      colX = idX * nX2;
+      for(idY = 1; idY <= nPY; ++idY)
       {
-	tDP1 = *(data0 + idY) + idX;
-	tDP2 = *(data0 + nY2 + idY) + idX;
+	tDP1 = *(data0 + idY) + colX;
+	tDP2 = *(data0 + nY2 + idY) + colX;
 	tD1 = *tDP1;
 	tD2 = *tDP2;
-	tD3 = *(*(data1 + idY) + idX);
-	tD4 = -*(*(data1 + nY2 + idY) + idX);
+	tD3 = *(*(data1 + idY) + colX);
+	tD4 = -*(*(data1 + nY2 + idY) + colX);
 	*tDP1 = tD1 * tD3 - tD2 * tD4;
 	*tDP2 = tD1 * tD4 + tD2 * tD3;
       }
+      for(idY = 0; idY < nY - 2 * nPY; ++idY)
+      {
+	*(*(data0 + idY * nY2) + colX) *= *(*(data1 + idY * nY2) + colX);
+      }
     }
-    **data0 *= **data1;
-    **(data0 + nY2) *= **(data1 + nY2);
-    *(*data0 + nX2) *= *(*data1 + nX2);
-    *(*(data0 + nY2) + nX2) *= *(*(data1 + nY2) + nX2);
-    AlgFourRealInv2D(data0, 1, nX, nY);
+    errNum = AlgFourPlanExecReal2D(pX, pY, data0, 1);
   }
+  AlgFourPlanFree(pX);
+  AlgFourPlanFree(pY);
   return(errNum);
 }
 
@@ -0,0 +1,1912 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgFourPlan_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libAlg/AlgFourPlan.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Plan based fast Fourier transforms of arbitrary length.
+* \par
+*		A plan (see AlgFourPlan) is created for a given transform
+*		length and then used for any number of transforms of that
+*		length. The plan holds the mixed radix factorisation of
+*		the length together with the twiddle factors, so these
+*		are not recomputed for each transform. Lengths which have
+*		a prime factor greater than ALG_FOURPLAN_MAXRADIX are
+*		transformed using Bluestein's algorithm, in which the
+*		transform is computed as a convolution using a power of
+*		two length transform.
+* \par
+*		The transforms are compatible with those of AlgFourier.c
+*		for power of two lengths: They are not scaled, so a
+*		forward transform followed by an inverse transform
+*		multiplies the data by the number of data. Real data
+*		transforms use the same packing as AlgFourReal1D(),
+*		with the real components of the first \f$n/2 + 1\f$
+*		coefficients followed by the imaginary components of
+*		the coefficients \f$1, \ldots, (n - 1)/2\f$. The
+*		multi-dimensional real data transforms use the same
+*		layout as AlgFourReal2D() but are true discrete Fourier
+*		transforms in all dimensions.
+* \par
+*		The multi-dimensional transforms are computed in parallel
+*		using per-thread buffers so that all one dimensional
+*		transforms are of contiguous data.
+* \ingroup      AlgFourier
+* \todo         -
+* \bug          None known.
+*/
+
+#include <Alg.h>
+#include <math.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		ALG_FOURPLAN_MAXRADIX
+* \brief	Maximum radix for the mixed radix transforms, lengths with
+* 		larger prime factors use Bluestein's algorithm.
+*/
+#define ALG_FOURPLAN_MAXRADIX	(32)
+
+/*!
+* \def		ALG_FOURPLAN_CACHE_SZ
+* \brief	Number of plans kept in the plan cache.
+*/
+#define ALG_FOURPLAN_CACHE_SZ	(16)
+
+static void			AlgFourPlanRelease(
+				  AlgFourPlan *plan);
+static void			AlgFourPlanWork(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  const double *in,
+				  int fStride,
+				  const int *fac);
+static void			AlgFourPlanBfly2(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  int fStride,
+				  int m);
+static void			AlgFourPlanBfly3(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  int fStride,
+				  int m);
+static void			AlgFourPlanBfly4(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  int fStride,
+				  int m);
+static void			AlgFourPlanBfly5(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  int fStride,
+				  int m);
+static void			AlgFourPlanBflyN(
+				  const AlgFourPlan *plan,
+				  double *out,
+				  int fStride,
+				  int m,
+				  int p);
+static void			AlgFourPlanCpx(
+				  const AlgFourPlan *plan,
+				  const double *in,
+				  double *out,
+				  double *wrk);
+static void			AlgFourPlanRealFwd(
+				  const AlgFourPlan *plan,
+				  const double *x,
+				  double *f,
+				  double *wrk);
+static void			AlgFourPlanRealInv(
+				  const AlgFourPlan *plan,
+				  const double *f,
+				  double *x,
+				  double *wrk);
+static void			AlgFourPlanCpxLine(
+				  const AlgFourPlan *plan,
+				  double *buf,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanRealLine(
+				  const AlgFourPlan *plan,
+				  double *buf,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanColCpx(
+				  const AlgFourPlan *plan,
+				  double **real,
+				  int xR,
+				  double **imag,
+				  int xI,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanColReal(
+				  const AlgFourPlan *plan,
+				  double **data,
+				  int x,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanZCpx(
+				  const AlgFourPlan *plan,
+				  double ***real,
+				  int yR,
+				  int xR,
+				  double ***imag,
+				  int yI,
+				  int xI,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanZReal(
+				  const AlgFourPlan *plan,
+				  double ***data,
+				  int y,
+				  int x,
+				  double *wrk,
+				  int inv);
+static void			AlgFourPlanReal2DRows(
+				  const AlgFourPlan *pX,
+				  double **data,
+				  int numY,
+				  double *buf,
+				  size_t bufSz,
+				  int inv);
+static void			AlgFourPlanReal2DCols(
+				  const AlgFourPlan *pX,
+				  const AlgFourPlan *pY,
+				  double **data,
+				  double *buf,
+				  size_t bufSz,
+				  int inv);
+static size_t			AlgFourPlanCpxWrkSz(
+				  const AlgFourPlan *plan);
+static double			*AlgFourPlanThrBuf(
+				  size_t *dstBufSz,
+				  const AlgFourPlan *p0,
+				  const AlgFourPlan *p1,
+				  const AlgFourPlan *p2,
+				  AlgError *dstErr);
+static AlgFourPlan		*AlgFourPlanMake(
+				  int num,
+				  int real,
+				  AlgError *dstErr);
+
+static int			algFourPlanCacheCnt = 0;
+static AlgFourPlan		*algFourPlanCache[ALG_FOURPLAN_CACHE_SZ];
+
+/*!
+* \return	New plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Creates a new plan for computing complex and real
+* 		Fourier transforms of the given length. The plan should
+* 		be freed using AlgFourPlanFree().
+* \param	num			Transform length, must be greater
+* 					than zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+AlgFourPlan	*AlgFourPlanNew(int num, AlgError *dstErr)
+{
+  AlgFourPlan	*plan;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanNew FE %d\n", num));
+  plan = AlgFourPlanMake(num, 1, dstErr);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanNew FX %p\n", plan));
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Frees a plan created by AlgFourPlanNew() or releases
+* 		a plan obtained using AlgFourPlanGet(). The plan is
+* 		only freed when it is no longer referenced.
+* \param	plan			Given plan, may be NULL.
+*/
+void		AlgFourPlanFree(AlgFourPlan *plan)
+{
+  if(plan)
+  {
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+    {
+      AlgFourPlanRelease(plan);
+    }
+  }
+}
+
+/*!
+* \return	Plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Gets a plan for the given transform length from the plan
+* 		cache, creating and caching a new plan if there is no
+* 		cached plan of the required length. The cache holds
+* 		the most recently used plans, so repeated transforms
+* 		of the same length only create a single plan.
+* 		The returned plan must be released using
+* 		AlgFourPlanFree().
+* \param	num			Transform length, must be greater
+* 					than zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+AlgFourPlan	*AlgFourPlanGet(int num, AlgError *dstErr)
+{
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+  {
+    int		idx;
+
+    for(idx = 0; idx < algFourPlanCacheCnt; ++idx)
+    {
+      if(algFourPlanCache[idx]->num == num)
+      {
+	plan = algFourPlanCache[idx];
+	break;
+      }
+    }
+    if(plan == NULL)
+    {
+      if((plan = AlgFourPlanMake(num, 1, &errNum)) != NULL)
+      {
+	/* The cache holds a reference to the plan too. */
+	++(plan->refCnt);
+	if(algFourPlanCacheCnt >= ALG_FOURPLAN_CACHE_SZ)
+	{
+	  AlgFourPlanRelease(algFourPlanCache[--algFourPlanCacheCnt]);
+	}
+	idx = algFourPlanCacheCnt++;
+      }
+    }
+    else
+    {
+      ++(plan->refCnt);
+    }
+    if(plan)
+    {
+      /* Move the plan to the front of the cache. */
+      for(; idx > 0; --idx)
+      {
+	algFourPlanCache[idx] = algFourPlanCache[idx - 1];
+      }
+      algFourPlanCache[0] = plan;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Releases all plans held by the plan cache. Plans which
+* 		are still in use are freed when they are released by
+* 		AlgFourPlanFree().
+*/
+void		AlgFourPlanCacheFree(void)
+{
+#ifdef _OPENMP
+#pragma omp critical (AlgFourPlanCache)
+#endif
+  {
+    while(algFourPlanCacheCnt > 0)
+    {
+      AlgFourPlanRelease(algFourPlanCache[--algFourPlanCacheCnt]);
+    }
+  }
+}
+
+/*!
+* \return	Transform length.
+* \ingroup	AlgFourier
+* \brief	Computes the smallest length which is greater than or
+* 		equal to the given length and which has no prime factors
+* 		other than 2, 3 and 5. Such lengths can be transformed
+* 		efficiently and are generally much closer to the given
+* 		length than the next power of two.
+* \param	num			Given length.
+*/
+int		AlgFourPlanNiceNum(int num)
+{
+  int		n,
+  		m;
+
+  if(num < 1)
+  {
+    num = 1;
+  }
+  for(n = num; ; ++n)
+  {
+    m = n;
+    while((m % 2) == 0)
+    {
+      m /= 2;
+    }
+    while((m % 3) == 0)
+    {
+      m /= 3;
+    }
+    while((m % 5) == 0)
+    {
+      m /= 5;
+    }
+    if(m == 1)
+    {
+      break;
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex data in place using the given plan.
+*		The transformed data are not scaled.
+* \param	plan			Plan for the data length.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExec1D(AlgFourPlan *plan, double *real,
+				  double *imag, int step, int inv)
+{
+  int		idx,
+  		num;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (real == NULL) || (imag == NULL) || (step < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((buf = (double *)AlcMalloc(sizeof(double) *
+				     (2 * plan->num + plan->wrkSz))) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    num = plan->num;
+    for(idx = 0; idx < num; ++idx)
+    {
+      buf[2 * idx] = real[idx * step];
+      buf[2 * idx + 1] = imag[idx * step];
+    }
+    AlgFourPlanCpxLine(plan, buf, buf + 2 * num, inv);
+    for(idx = 0; idx < num; ++idx)
+    {
+      real[idx * step] = buf[2 * idx];
+      imag[idx * step] = buf[2 * idx + 1];
+    }
+    AlcFree(buf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional real data in place using the given plan.
+*		The forward transform data are packed as by
+*		AlgFourReal1D(), with the real components of the
+*		coefficients \f$0, \ldots, n/2\f$ followed by the
+*		imaginary components of the coefficients
+*		\f$1, \ldots, (n - 1)/2\f$. The inverse transform
+*		takes packed data and gives real data.
+*		The transformed data are not scaled.
+* \param	plan			Plan for the data length.
+* \param	data			Given data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExecReal1D(AlgFourPlan *plan, double *data,
+				      int step, int inv)
+{
+  int		idx,
+  		num;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || (data == NULL) || (step < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((buf = (double *)AlcMalloc(sizeof(double) *
+				     (plan->num + plan->wrkSz))) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    num = plan->num;
+    for(idx = 0; idx < num; ++idx)
+    {
+      buf[idx] = data[idx * step];
+    }
+    AlgFourPlanRealLine(plan, buf, buf + num, inv);
+    for(idx = 0; idx < num; ++idx)
+    {
+      data[idx * step] = buf[idx];
+    }
+    AlcFree(buf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given two
+*		dimensional complex data in place using the given plans.
+*		The transformed data are not scaled.
+* \param	pX			Plan for the row length.
+* \param	pY			Plan for the column length.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExec2D(AlgFourPlan *pX, AlgFourPlan *pY,
+				  double **real, double **imag, int inv)
+{
+  int		idx;
+  size_t	bufSz;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExec2D FE %p %p %p %p %d\n",
+	   pX, pY, real, imag, inv));
+  if((pX == NULL) || (pY == NULL) || (real == NULL) || (imag == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    buf = AlgFourPlanThrBuf(&bufSz, pX, pY, NULL, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    const int	numX = pX->num,
+    		numY = pY->num;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < numY; ++idx)
+    {
+      int	thrId = 0;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      AlgFourPlanColCpx(pX, real + idx, -1, imag + idx, -1,
+			buf + thrId * bufSz, inv);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < numX; ++idx)
+    {
+      int	thrId = 0;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      AlgFourPlanColCpx(pY, real, idx, imag, idx, buf + thrId * bufSz, inv);
+    }
+  }
+  AlcFree(buf);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExec2D FX %d\n", errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given two
+*		dimensional real data in place using the given plans.
+*		The rows are transformed and packed as by
+*		AlgFourPlanExecReal1D(). The first column and (for even
+*		row lengths) the column \f$n_x/2\f$ then hold real data
+*		and are transformed using real transforms, while the
+*		remaining columns \f$x\f$ and \f$n_x/2 + x\f$ hold the
+*		real and imaginary components of complex data and are
+*		transformed using complex transforms. This is the same
+*		layout as AlgFourReal2D(). The inverse transform takes
+*		packed data and gives real data.
+*		The transformed data are not scaled.
+* \param	pX			Plan for the row length.
+* \param	pY			Plan for the column length.
+* \param	data			Given data.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExecReal2D(AlgFourPlan *pX, AlgFourPlan *pY,
+				      double **data, int inv)
+{
+  size_t	bufSz;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExecReal2D FE %p %p %p %d\n",
+	   pX, pY, data, inv));
+  if((pX == NULL) || (pY == NULL) || (data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    buf = AlgFourPlanThrBuf(&bufSz, pX, pY, NULL, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    if(inv)
+    {
+      AlgFourPlanReal2DCols(pX, pY, data, buf, bufSz, inv);
+      AlgFourPlanReal2DRows(pX, data, pY->num, buf, bufSz, inv);
+    }
+    else
+    {
+      AlgFourPlanReal2DRows(pX, data, pY->num, buf, bufSz, inv);
+      AlgFourPlanReal2DCols(pX, pY, data, buf, bufSz, inv);
+    }
+  }
+  AlcFree(buf);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExecReal2D FX %d\n", errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given three
+*		dimensional complex data in place using the given plans.
+*		The transformed data are not scaled.
+* \param	pX			Plan for the row length.
+* \param	pY			Plan for the column length.
+* \param	pZ			Plan for the number of planes.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExec3D(AlgFourPlan *pX, AlgFourPlan *pY,
+				  AlgFourPlan *pZ,
+				  double ***real, double ***imag, int inv)
+{
+  int		idx;
+  size_t	bufSz;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExec3D FE %p %p %p %p %p %d\n",
+	   pX, pY, pZ, real, imag, inv));
+  if((pX == NULL) || (pY == NULL) || (pZ == NULL) ||
+     (real == NULL) || (imag == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    buf = AlgFourPlanThrBuf(&bufSz, pX, pY, pZ, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    const int	numX = pX->num,
+    		numY = pY->num,
+		numZ = pZ->num;
+
+    /* Rows. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < numZ * numY; ++idx)
+    {
+      int	thrId = 0,
+      		idY,
+      		idZ;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      idZ = idx / numY;
+      idY = idx % numY;
+      AlgFourPlanColCpx(pX, real[idZ] + idY, -1, imag[idZ] + idY, -1,
+			buf + thrId * bufSz, inv);
+    }
+    /* Columns. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < numZ * numX; ++idx)
+    {
+      int	thrId = 0,
+      		idX,
+      		idZ;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      idZ = idx / numX;
+      idX = idx % numX;
+      AlgFourPlanColCpx(pY, real[idZ], idX, imag[idZ], idX,
+			buf + thrId * bufSz, inv);
+    }
+    /* Planes. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < numY * numX; ++idx)
+    {
+      int	thrId = 0,
+      		idX,
+      		idY;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      idY = idx / numX;
+      idX = idx % numX;
+      AlgFourPlanZCpx(pZ, real, idY, idX, imag, idY, idX,
+		      buf + thrId * bufSz, inv);
+    }
+  }
+  AlcFree(buf);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExec3D FX %d\n", errNum));
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the Fourier transform of the given three
+*		dimensional real data in place using the given plans.
+*		Each plane is transformed as by AlgFourPlanExecReal2D()
+*		and then the lines through the planes are transformed,
+*		with real transforms used for the columns \f$0\f$ and
+*		(for even row lengths) \f$n_x/2\f$ of every plane and
+*		complex transforms for the remaining columns \f$x\f$
+*		and \f$n_x/2 + x\f$. This is the same layout as
+*		AlgFourReal3D(). The inverse transform takes packed
+*		data and gives real data.
+*		The transformed data are not scaled.
+* \param	pX			Plan for the row length.
+* \param	pY			Plan for the column length.
+* \param	pZ			Plan for the number of planes.
+* \param	data			Given data.
+* \param	inv			Non-zero for the inverse transform.
+*/
+AlgError	AlgFourPlanExecReal3D(AlgFourPlan *pX, AlgFourPlan *pY,
+				      AlgFourPlan *pZ,
+				      double ***data, int inv)
+{
+  int		idx;
+  size_t	bufSz;
+  double	*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExecReal3D FE %p %p %p %p %d\n",
+	   pX, pY, pZ, data, inv));
+  inv = (inv != 0);
+  if((pX == NULL) || (pY == NULL) || (pZ == NULL) || (data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    buf = AlgFourPlanThrBuf(&bufSz, pX, pY, pZ, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    int		idZ,
+    		pass;
+    const int	numY = pY->num,
+		numZ = pZ->num,
+		halfX = pX->num / 2,
+		nPairX = (pX->num - 1) / 2,
+		nRealX = pX->num - 2 * nPairX,
+		nJob = (nPairX + nRealX) * numY;
+
+    for(pass = 0; pass < 2; ++pass)
+    {
+      if(pass == inv)
+      {
+	/* Each plane. */
+	for(idZ = 0; idZ < numZ; ++idZ)
+	{
+	  if(inv)
+	  {
+	    AlgFourPlanReal2DCols(pX, pY, data[idZ], buf, bufSz, inv);
+	    AlgFourPlanReal2DRows(pX, data[idZ], numY, buf, bufSz, inv);
+	  }
+	  else
+	  {
+	    AlgFourPlanReal2DRows(pX, data[idZ], numY, buf, bufSz, inv);
+	    AlgFourPlanReal2DCols(pX, pY, data[idZ], buf, bufSz, inv);
+	  }
+	}
+      }
+      else
+      {
+	/* Lines through the planes. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(idx = 0; idx < nJob; ++idx)
+	{
+	  int	idX,
+		idY,
+		thrId = 0;
+	  double *wrk;
+
+#ifdef _OPENMP
+	  thrId = omp_get_thread_num();
+#endif
+	  wrk = buf + thrId * bufSz;
+	  idX = idx / numY;
+	  idY = idx % numY;
+	  if(idX < nRealX)
+	  {
+	    AlgFourPlanZReal(pZ, data, idY, idX * halfX, wrk, inv);
+	  }
+	  else
+	  {
+	    idX -= nRealX - 1;
+	    AlgFourPlanZCpx(pZ, data, idY, idX, data, idY, halfX + idX,
+			    wrk, inv);
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(buf);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourPlanExecReal3D FX %d\n", errNum));
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms the rows of real 2D data in parallel.
+* \param	pX			Plan for the row length.
+* \param	data			Given data.
+* \param	numY			Number of rows.
+* \param	buf			Per-thread buffers.
+* \param	bufSz			Size of each per-thread buffer.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanReal2DRows(const AlgFourPlan *pX, double **data,
+				      int numY, double *buf, size_t bufSz,
+				      int inv)
+{
+  int		idY;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(idY = 0; idY < numY; ++idY)
+  {
+    int		thrId = 0;
+
+#ifdef _OPENMP
+    thrId = omp_get_thread_num();
+#endif
+    AlgFourPlanRealLine(pX, data[idY], buf + thrId * bufSz, inv);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms the columns of 2D data in parallel, for
+* 		which the rows have been transformed by real transforms.
+* \param	pX			Plan for the row length.
+* \param	pY			Plan for the column length.
+* \param	data			Given data.
+* \param	buf			Per-thread buffers.
+* \param	bufSz			Size of each per-thread buffer.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanReal2DCols(const AlgFourPlan *pX,
+				      const AlgFourPlan *pY, double **data,
+				      double *buf, size_t bufSz, int inv)
+{
+  int		idx;
+  const int	halfX = pX->num / 2,
+  		nPairX = (pX->num - 1) / 2,
+		nRealX = pX->num - 2 * nPairX;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for(idx = 0; idx < nRealX + nPairX; ++idx)
+  {
+    int		thrId = 0;
+    double	*wrk;
+
+#ifdef _OPENMP
+    thrId = omp_get_thread_num();
+#endif
+    wrk = buf + thrId * bufSz;
+    if(idx < nRealX)
+    {
+      AlgFourPlanColReal(pY, data, idx * halfX, wrk, inv);
+    }
+    else
+    {
+      int	idX;
+
+      idX = idx - nRealX + 1;
+      AlgFourPlanColCpx(pY, data, idX, data, halfX + idX, wrk, inv);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms a single column (or row) of complex data in
+* 		place. If the column indices are negative then the
+* 		real and imaginary pointers are to single rows of data
+* 		which are transformed, otherwise the given columns
+* 		of the 2D arrays are transformed.
+* \param	plan			Plan for the column length.
+* \param	real			Real data.
+* \param	xR			Column of the real data.
+* \param	imag			Imaginary data.
+* \param	xI			Column of the imaginary data.
+* \param	wrk			Workspace.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanColCpx(const AlgFourPlan *plan,
+				  double **real, int xR,
+				  double **imag, int xI,
+				  double *wrk, int inv)
+{
+  int		idx;
+  const int	num = plan->num;
+
+  if(xR < 0)
+  {
+    double	*r,
+    		*i;
+
+    r = *real;
+    i = *imag;
+    for(idx = 0; idx < num; ++idx)
+    {
+      wrk[2 * idx] = r[idx];
+      wrk[2 * idx + 1] = i[idx];
+    }
+    AlgFourPlanCpxLine(plan, wrk, wrk + 2 * num, inv);
+    for(idx = 0; idx < num; ++idx)
+    {
+      r[idx] = wrk[2 * idx];
+      i[idx] = wrk[2 * idx + 1];
+    }
+  }
+  else
+  {
+    for(idx = 0; idx < num; ++idx)
+    {
+      wrk[2 * idx] = real[idx][xR];
+      wrk[2 * idx + 1] = imag[idx][xI];
+    }
+    AlgFourPlanCpxLine(plan, wrk, wrk + 2 * num, inv);
+    for(idx = 0; idx < num; ++idx)
+    {
+      real[idx][xR] = wrk[2 * idx];
+      imag[idx][xI] = wrk[2 * idx + 1];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms a single column of real data in place.
+* \param	plan			Plan for the column length.
+* \param	data			Data.
+* \param	x			Column of the data.
+* \param	wrk			Workspace.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanColReal(const AlgFourPlan *plan, double **data,
+				   int x, double *wrk, int inv)
+{
+  int		idx;
+  const int	num = plan->num;
+
+  for(idx = 0; idx < num; ++idx)
+  {
+    wrk[idx] = data[idx][x];
+  }
+  AlgFourPlanRealLine(plan, wrk, wrk + num, inv);
+  for(idx = 0; idx < num; ++idx)
+  {
+    data[idx][x] = wrk[idx];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms a single line of complex data through the
+* 		planes of 3D arrays in place.
+* \param	plan			Plan for the number of planes.
+* \param	real			Real data.
+* \param	yR			Line of the real data.
+* \param	xR			Column of the real data.
+* \param	imag			Imaginary data.
+* \param	yI			Line of the imaginary data.
+* \param	xI			Column of the imaginary data.
+* \param	wrk			Workspace.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanZCpx(const AlgFourPlan *plan,
+				double ***real, int yR, int xR,
+				double ***imag, int yI, int xI,
+				double *wrk, int inv)
+{
+  int		idx;
+  const int	num = plan->num;
+
+  for(idx = 0; idx < num; ++idx)
+  {
+    wrk[2 * idx] = real[idx][yR][xR];
+    wrk[2 * idx + 1] = imag[idx][yI][xI];
+  }
+  AlgFourPlanCpxLine(plan, wrk, wrk + 2 * num, inv);
+  for(idx = 0; idx < num; ++idx)
+  {
+    real[idx][yR][xR] = wrk[2 * idx];
+    imag[idx][yI][xI] = wrk[2 * idx + 1];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms a single line of real data through the
+* 		planes of a 3D array in place.
+* \param	plan			Plan for the number of planes.
+* \param	data			Data.
+* \param	y			Line of the data.
+* \param	x			Column of the data.
+* \param	wrk			Workspace.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanZReal(const AlgFourPlan *plan, double ***data,
+				 int y, int x, double *wrk, int inv)
+{
+  int		idx;
+  const int	num = plan->num;
+
+  for(idx = 0; idx < num; ++idx)
+  {
+    wrk[idx] = data[idx][y][x];
+  }
+  AlgFourPlanRealLine(plan, wrk, wrk + num, inv);
+  for(idx = 0; idx < num; ++idx)
+  {
+    data[idx][y][x] = wrk[idx];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms contiguous interleaved complex data in place.
+* \param	plan			Plan for the data length.
+* \param	buf			Interleaved complex data.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					doubles.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanCpxLine(const AlgFourPlan *plan, double *buf,
+				   double *wrk, int inv)
+{
+  int		idx;
+  const int	num2 = 2 * plan->num;
+
+  /* The inverse transform is the conjugate of the forward transform
+   * of the conjugate. */
+  if(inv)
+  {
+    for(idx = 1; idx < num2; idx += 2)
+    {
+      buf[idx] = -buf[idx];
+    }
+  }
+  AlgFourPlanCpx(plan, buf, wrk, wrk + num2);
+  if(inv)
+  {
+    for(idx = 0; idx < num2; idx += 2)
+    {
+      buf[idx] = wrk[idx];
+      buf[idx + 1] = -wrk[idx + 1];
+    }
+  }
+  else
+  {
+    (void )memcpy(buf, wrk, sizeof(double) * num2);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Transforms contiguous real data in place.
+* \param	plan			Plan for the data length.
+* \param	buf			Real or packed data.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					doubles.
+* \param	inv			Non-zero for the inverse transform.
+*/
+static void	AlgFourPlanRealLine(const AlgFourPlan *plan, double *buf,
+				    double *wrk, int inv)
+{
+  const int	num = plan->num;
+
+  if(inv)
+  {
+    AlgFourPlanRealInv(plan, buf, wrk, wrk + num);
+  }
+  else
+  {
+    AlgFourPlanRealFwd(plan, buf, wrk, wrk + num);
+  }
+  (void )memcpy(buf, wrk, sizeof(double) * num);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the forward transform of real data giving
+* 		packed data. For even lengths the data are treated as
+* 		complex data of half the length, which are transformed
+* 		and then separated into the transform of the real data.
+* \param	plan			Plan for the data length.
+* \param	x			Given real data.
+* \param	f			Destination for the packed transform.
+* \param	wrk			Workspace.
+*/
+static void	AlgFourPlanRealFwd(const AlgFourPlan *plan, const double *x,
+				   double *f, double *wrk)
+{
+  int		k;
+  const int	num = plan->num,
+  		half = num / 2;
+
+  if(plan->halfPlan)
+  {
+    double	*z;
+
+    z = wrk;
+    AlgFourPlanCpx(plan->halfPlan, x, z, wrk + num);
+    f[0] = z[0] + z[1];
+    f[half] = z[0] - z[1];
+    for(k = 1; k < half; ++k)
+    {
+      int	j;
+      double	eR,
+		eI,
+		oR,
+		oI,
+		wR,
+		wI;
+
+      /* E = (Z_k + conj(Z_{h-k}))/2, O = -i(Z_k - conj(Z_{h-k}))/2,
+       * F_k = E + W^k O. */
+      j = half - k;
+      eR = 0.5 * (z[2 * k] + z[2 * j]);
+      eI = 0.5 * (z[2 * k + 1] - z[2 * j + 1]);
+      oR = 0.5 * (z[2 * k + 1] + z[2 * j + 1]);
+      oI = -0.5 * (z[2 * k] - z[2 * j]);
+      wR = plan->tw[2 * k];
+      wI = plan->tw[2 * k + 1];
+      f[k] = eR + wR * oR - wI * oI;
+      f[half + k] = eI + wR * oI + wI * oR;
+    }
+  }
+  else
+  {
+    double	*z0,
+    		*z1;
+
+    z0 = wrk;
+    z1 = wrk + 2 * num;
+    for(k = 0; k < num; ++k)
+    {
+      z0[2 * k] = x[k];
+      z0[2 * k + 1] = 0.0;
+    }
+    AlgFourPlanCpx(plan, z0, z1, wrk + 4 * num);
+    for(k = 0; k <= half; ++k)
+    {
+      f[k] = z1[2 * k];
+    }
+    for(k = 1; k < num - half; ++k)
+    {
+      f[half + k] = z1[2 * k + 1];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the inverse transform of packed data giving
+* 		real data, this is the inverse of AlgFourPlanRealFwd()
+* 		but the data are not scaled.
+* \param	plan			Plan for the data length.
+* \param	f			Given packed transform data.
+* \param	x			Destination for the real data.
+* \param	wrk			Workspace.
+*/
+static void	AlgFourPlanRealInv(const AlgFourPlan *plan, const double *f,
+				   double *x, double *wrk)
+{
+  int		k;
+  const int	num = plan->num,
+  		half = num / 2;
+
+  if(plan->halfPlan)
+  {
+    double	*z;
+
+    /* Build the conjugate of the half length spectrum
+     * Z_k = (F_k + conj(F_{h-k})) + i conj(W^k) (F_k - conj(F_{h-k})),
+     * transform it and conjugate the result. */
+    z = wrk;
+    z[0] = f[0] + f[half];
+    z[1] = -(f[0] - f[half]);
+    for(k = 1; k < half; ++k)
+    {
+      int	j;
+      double	aR,
+		aI,
+		bR,
+		bI,
+		wR,
+		wI;
+
+      j = half - k;
+      aR = f[k] + f[j];
+      aI = f[half + k] - ((j > 0)? f[half + j]: 0.0);
+      bR = f[k] - f[j];
+      bI = f[half + k] + ((j > 0)? f[half + j]: 0.0);
+      wR = plan->tw[2 * k];
+      wI = -plan->tw[2 * k + 1];
+      /* z = a + i w b */
+      z[2 * k] = aR - (wR * bI + wI * bR);
+      z[2 * k + 1] = -(aI + (wR * bR - wI * bI));
+    }
+    AlgFourPlanCpx(plan->halfPlan, z, x, wrk + num);
+    for(k = 1; k < num; k += 2)
+    {
+      x[k] = -x[k];
+    }
+  }
+  else
+  {
+    double	*z0,
+    		*z1;
+
+    z0 = wrk;
+    z1 = wrk + 2 * num;
+    z0[0] = f[0];
+    z0[1] = 0.0;
+    for(k = 1; k <= half; ++k)
+    {
+      double	re,
+      		im;
+
+      re = f[k];
+      im = (k < num - half)? f[half + k]: 0.0;
+      z0[2 * k] = re;
+      z0[2 * k + 1] = -im;
+      z0[2 * (num - k)] = re;
+      z0[2 * (num - k) + 1] = im;
+    }
+    AlgFourPlanCpx(plan, z0, z1, wrk + 4 * num);
+    for(k = 0; k < num; ++k)
+    {
+      x[k] = z1[2 * k];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the forward transform of contiguous interleaved
+* 		complex data.
+* \param	plan			Plan for the data length.
+* \param	in			Given data, not modified.
+* \param	out			Destination for the transformed data
+* 					which must not overlap the given
+* 					data.
+* \param	wrk			Workspace for Bluestein's algorithm.
+*/
+static void	AlgFourPlanCpx(const AlgFourPlan *plan, const double *in,
+			       double *out, double *wrk)
+{
+  if(plan->blueNum > 0)
+  {
+    int		k;
+    double	*a,
+    		*b;
+    const int	num = plan->num,
+    		bNum = plan->blueNum;
+    const double *c = plan->blueChirp,
+    		*fc = plan->blueFChirp;
+
+    a = wrk;
+    b = wrk + 2 * bNum;
+    for(k = 0; k < num; ++k)
+    {
+      a[2 * k] = in[2 * k] * c[2 * k] - in[2 * k + 1] * c[2 * k + 1];
+      a[2 * k + 1] = in[2 * k] * c[2 * k + 1] + in[2 * k + 1] * c[2 * k];
+    }
+    (void )memset(a + 2 * num, 0, sizeof(double) * 2 * (bNum - num));
+    AlgFourPlanCpx(plan->bluePlan, a, b, wrk + 4 * bNum);
+    for(k = 0; k < bNum; ++k)
+    {
+      double	tR,
+      		tI;
+
+      tR = b[2 * k] * fc[2 * k] - b[2 * k + 1] * fc[2 * k + 1];
+      tI = b[2 * k] * fc[2 * k + 1] + b[2 * k + 1] * fc[2 * k];
+      b[2 * k] = tR;
+      b[2 * k + 1] = -tI;
+    }
+    AlgFourPlanCpx(plan->bluePlan, b, a, wrk + 4 * bNum);
+    for(k = 0; k < num; ++k)
+    {
+      out[2 * k] = c[2 * k] * a[2 * k] + c[2 * k + 1] * a[2 * k + 1];
+      out[2 * k + 1] = c[2 * k + 1] * a[2 * k] - c[2 * k] * a[2 * k + 1];
+    }
+  }
+  else if(plan->nFac == 0)
+  {
+    out[0] = in[0];
+    out[1] = in[1];
+  }
+  else
+  {
+    AlgFourPlanWork(plan, out, in, 1, plan->fac);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Recursive decimation in time mixed radix transform.
+* \param	plan			Plan for the data length.
+* \param	out			Destination for the transformed data.
+* \param	in			Given data.
+* \param	fStride			Stride through the given data and
+* 					twiddle factors.
+* \param	fac			Remaining radix and length pairs.
+*/
+static void	AlgFourPlanWork(const AlgFourPlan *plan, double *out,
+				const double *in, int fStride, const int *fac)
+{
+  int		q;
+  const int	p = fac[0],
+  		m = fac[1];
+
+  if(m == 1)
+  {
+    for(q = 0; q < p; ++q)
+    {
+      out[2 * q] = in[0];
+      out[2 * q + 1] = in[1];
+      in += 2 * fStride;
+    }
+  }
+  else
+  {
+    for(q = 0; q < p; ++q)
+    {
+      AlgFourPlanWork(plan, out + 2 * q * m, in, fStride * p, fac + 2);
+      in += 2 * fStride;
+    }
+  }
+  switch(p)
+  {
+    case 2:
+      AlgFourPlanBfly2(plan, out, fStride, m);
+      break;
+    case 3:
+      AlgFourPlanBfly3(plan, out, fStride, m);
+      break;
+    case 4:
+      AlgFourPlanBfly4(plan, out, fStride, m);
+      break;
+    case 5:
+      AlgFourPlanBfly5(plan, out, fStride, m);
+      break;
+    default:
+      AlgFourPlanBflyN(plan, out, fStride, m, p);
+      break;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Radix 2 butterfly.
+* \param	plan			Plan for the data length.
+* \param	out			Data.
+* \param	fStride			Twiddle factor stride.
+* \param	m			Length of the sub-transforms.
+*/
+static void	AlgFourPlanBfly2(const AlgFourPlan *plan, double *out,
+				 int fStride, int m)
+{
+  int		k;
+  double	*o0,
+  		*o1;
+  const double	*tw;
+
+  o0 = out;
+  o1 = out + 2 * m;
+  tw = plan->tw;
+  for(k = 0; k < m; ++k)
+  {
+    double	tR,
+    		tI;
+
+    tR = o1[0] * tw[0] - o1[1] * tw[1];
+    tI = o1[0] * tw[1] + o1[1] * tw[0];
+    o1[0] = o0[0] - tR;
+    o1[1] = o0[1] - tI;
+    o0[0] += tR;
+    o0[1] += tI;
+    o0 += 2;
+    o1 += 2;
+    tw += 2 * fStride;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Radix 3 butterfly.
+* \param	plan			Plan for the data length.
+* \param	out			Data.
+* \param	fStride			Twiddle factor stride.
+* \param	m			Length of the sub-transforms.
+*/
+static void	AlgFourPlanBfly3(const AlgFourPlan *plan, double *out,
+				 int fStride, int m)
+{
+  int		k;
+  double	*o0,
+  		*o1,
+		*o2;
+  const double	*tw1,
+  		*tw2;
+  const double	epi3 = plan->tw[2 * fStride * m + 1];
+
+  o0 = out;
+  o1 = out + 2 * m;
+  o2 = out + 4 * m;
+  tw1 = tw2 = plan->tw;
+  for(k = 0; k < m; ++k)
+  {
+    double	s0[2],
+    		s1[2],
+		s2[2],
+		s3[2];
+
+    s1[0] = o1[0] * tw1[0] - o1[1] * tw1[1];
+    s1[1] = o1[0] * tw1[1] + o1[1] * tw1[0];
+    s2[0] = o2[0] * tw2[0] - o2[1] * tw2[1];
+    s2[1] = o2[0] * tw2[1] + o2[1] * tw2[0];
+    s3[0] = s1[0] + s2[0];
+    s3[1] = s1[1] + s2[1];
+    s0[0] = (s1[0] - s2[0]) * epi3;
+    s0[1] = (s1[1] - s2[1]) * epi3;
+    o1[0] = o0[0] - 0.5 * s3[0];
+    o1[1] = o0[1] - 0.5 * s3[1];
+    o0[0] += s3[0];
+    o0[1] += s3[1];
+    o2[0] = o1[0] + s0[1];
+    o2[1] = o1[1] - s0[0];
+    o1[0] -= s0[1];
+    o1[1] += s0[0];
+    o0 += 2;
+    o1 += 2;
+    o2 += 2;
+    tw1 += 2 * fStride;
+    tw2 += 4 * fStride;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Radix 4 butterfly.
+* \param	plan			Plan for the data length.
+* \param	out			Data.
+* \param	fStride			Twiddle factor stride.
+* \param	m			Length of the sub-transforms.
+*/
+static void	AlgFourPlanBfly4(const AlgFourPlan *plan, double *out,
+				 int fStride, int m)
+{
+  int		k;
+  double	*o0,
+  		*o1,
+		*o2,
+		*o3;
+  const double	*tw1,
+  		*tw2,
+		*tw3;
+
+  o0 = out;
+  o1 = out + 2 * m;
+  o2 = out + 4 * m;
+  o3 = out + 6 * m;
+  tw1 = tw2 = tw3 = plan->tw;
+  for(k = 0; k < m; ++k)
+  {
+    double	s0[2],
+    		s1[2],
+		s2[2],
+		s3[2],
+		s4[2],
+		s5[2];
+
+    s0[0] = o1[0] * tw1[0] - o1[1] * tw1[1];
+    s0[1] = o1[0] * tw1[1] + o1[1] * tw1[0];
+    s1[0] = o2[0] * tw2[0] - o2[1] * tw2[1];
+    s1[1] = o2[0] * tw2[1] + o2[1] * tw2[0];
+    s2[0] = o3[0] * tw3[0] - o3[1] * tw3[1];
+    s2[1] = o3[0] * tw3[1] + o3[1] * tw3[0];
+    s5[0] = o0[0] - s1[0];
+    s5[1] = o0[1] - s1[1];
+    o0[0] += s1[0];
+    o0[1] += s1[1];
+    s3[0] = s0[0] + s2[0];
+    s3[1] = s0[1] + s2[1];
+    s4[0] = s0[0] - s2[0];
+    s4[1] = s0[1] - s2[1];
+    o2[0] = o0[0] - s3[0];
+    o2[1] = o0[1] - s3[1];
+    o0[0] += s3[0];
+    o0[1] += s3[1];
+    o1[0] = s5[0] + s4[1];
+    o1[1] = s5[1] - s4[0];
+    o3[0] = s5[0] - s4[1];
+    o3[1] = s5[1] + s4[0];
+    o0 += 2;
+    o1 += 2;
+    o2 += 2;
+    o3 += 2;
+    tw1 += 2 * fStride;
+    tw2 += 4 * fStride;
+    tw3 += 6 * fStride;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Radix 5 butterfly.
+* \param	plan			Plan for the data length.
+* \param	out			Data.
+* \param	fStride			Twiddle factor stride.
+* \param	m			Length of the sub-transforms.
+*/
+static void	AlgFourPlanBfly5(const AlgFourPlan *plan, double *out,
+				 int fStride, int m)
+{
+  int		q,
+  		u;
+  double	*o[5];
+  const double	*tw = plan->tw;
+  const double	yaR = tw[2 * fStride * m],
+  		yaI = tw[2 * fStride * m + 1],
+		ybR = tw[4 * fStride * m],
+		ybI = tw[4 * fStride * m + 1];
+
+  for(q = 0; q < 5; ++q)
+  {
+    o[q] = out + 2 * q * m;
+  }
+  for(u = 0; u < m; ++u)
+  {
+    double	s[13][2];
+
+    s[0][0] = o[0][0];
+    s[0][1] = o[0][1];
+    for(q = 1; q < 5; ++q)
+    {
+      const double *t = tw + 2 * q * u * fStride;
+
+      s[q][0] = o[q][0] * t[0] - o[q][1] * t[1];
+      s[q][1] = o[q][0] * t[1] + o[q][1] * t[0];
+    }
+    s[7][0] = s[1][0] + s[4][0];
+    s[7][1] = s[1][1] + s[4][1];
+    s[10][0] = s[1][0] - s[4][0];
+    s[10][1] = s[1][1] - s[4][1];
+    s[8][0] = s[2][0] + s[3][0];
+    s[8][1] = s[2][1] + s[3][1];
+    s[9][0] = s[2][0] - s[3][0];
+    s[9][1] = s[2][1] - s[3][1];
+    o[0][0] += s[7][0] + s[8][0];
+    o[0][1] += s[7][1] + s[8][1];
+    s[5][0] = s[0][0] + s[7][0] * yaR + s[8][0] * ybR;
+    s[5][1] = s[0][1] + s[7][1] * yaR + s[8][1] * ybR;
+    s[6][0] = s[10][1] * yaI + s[9][1] * ybI;
+    s[6][1] = -s[10][0] * yaI - s[9][0] * ybI;
+    o[1][0] = s[5][0] - s[6][0];
+    o[1][1] = s[5][1] - s[6][1];
+    o[4][0] = s[5][0] + s[6][0];
+    o[4][1] = s[5][1] + s[6][1];
+    s[11][0] = s[0][0] + s[7][0] * ybR + s[8][0] * yaR;
+    s[11][1] = s[0][1] + s[7][1] * ybR + s[8][1] * yaR;
+    s[12][0] = -s[10][1] * ybI + s[9][1] * yaI;
+    s[12][1] = s[10][0] * ybI - s[9][0] * yaI;
+    o[2][0] = s[11][0] + s[12][0];
+    o[2][1] = s[11][1] + s[12][1];
+    o[3][0] = s[11][0] - s[12][0];
+    o[3][1] = s[11][1] - s[12][1];
+    for(q = 0; q < 5; ++q)
+    {
+      o[q] += 2;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Generic radix butterfly for radices up to
+* 		ALG_FOURPLAN_MAXRADIX.
+* \param	plan			Plan for the data length.
+* \param	out			Data.
+* \param	fStride			Twiddle factor stride.
+* \param	m			Length of the sub-transforms.
+* \param	p			Radix.
+*/
+static void	AlgFourPlanBflyN(const AlgFourPlan *plan, double *out,
+				 int fStride, int m, int p)
+{
+  int		u,
+  		k,
+		q,
+		q1,
+		twIdx;
+  double	scr[2 * ALG_FOURPLAN_MAXRADIX];
+  const int	num = plan->num;
+  const double	*tw = plan->tw;
+
+  for(u = 0; u < m; ++u)
+  {
+    k = u;
+    for(q1 = 0; q1 < p; ++q1)
+    {
+      scr[2 * q1] = out[2 * k];
+      scr[2 * q1 + 1] = out[2 * k + 1];
+      k += m;
+    }
+    k = u;
+    for(q1 = 0; q1 < p; ++q1)
+    {
+      double	oR,
+      		oI;
+
+      twIdx = 0;
+      oR = scr[0];
+      oI = scr[1];
+      for(q = 1; q < p; ++q)
+      {
+	twIdx += fStride * k;
+	if(twIdx >= num)
+	{
+	  twIdx -= num;
+	}
+	oR += scr[2 * q] * tw[2 * twIdx] - scr[2 * q + 1] * tw[2 * twIdx + 1];
+	oI += scr[2 * q] * tw[2 * twIdx + 1] + scr[2 * q + 1] * tw[2 * twIdx];
+      }
+      out[2 * k] = oR;
+      out[2 * k + 1] = oI;
+      k += m;
+    }
+  }
+}
+
+/*!
+* \return	Number of doubles of workspace.
+* \ingroup	AlgFourier
+* \brief	Computes the workspace required by AlgFourPlanCpx().
+* \param	plan			Given plan.
+*/
+static size_t	AlgFourPlanCpxWrkSz(const AlgFourPlan *plan)
+{
+  size_t	sz = 0;
+
+  if(plan && (plan->blueNum > 0))
+  {
+    sz = 4 * plan->blueNum + AlgFourPlanCpxWrkSz(plan->bluePlan);
+  }
+  return(sz);
+}
+
+/*!
+* \return	Per-thread buffers or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Allocates buffers for the transform of multi-dimensional
+* 		data, with a buffer for each thread which is sufficient
+* 		for a single line transform using any of the given plans.
+* \param	dstBufSz		Destination for the number of
+* 					doubles in each thread's buffer.
+* \param	p0			First plan.
+* \param	p1			Second plan.
+* \param	p2			Third plan, may be NULL.
+* \param	dstErr			Destination error pointer.
+*/
+static double	*AlgFourPlanThrBuf(size_t *dstBufSz, const AlgFourPlan *p0,
+				   const AlgFourPlan *p1,
+				   const AlgFourPlan *p2, AlgError *dstErr)
+{
+  int		idx,
+  		nThr = 1;
+  size_t	sz,
+  		bufSz = 0;
+  double	*buf = NULL;
+  const AlgFourPlan *p[3];
+
+#ifdef _OPENMP
+  nThr = omp_get_max_threads();
+#endif
+  p[0] = p0;
+  p[1] = p1;
+  p[2] = p2;
+  for(idx = 0; idx < 3; ++idx)
+  {
+    if(p[idx])
+    {
+      sz = 2 * p[idx]->num + p[idx]->wrkSz;
+      bufSz = ALG_MAX(bufSz, sz);
+    }
+  }
+  if((buf = (double *)AlcMalloc(sizeof(double) * nThr * bufSz)) == NULL)
+  {
+    *dstErr = ALG_ERR_MALLOC;
+  }
+  *dstBufSz = bufSz;
+  return(buf);
+}
+
+/*!
+* \return	New plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Creates a new plan.
+* \param	num			Transform length.
+* \param	real			Non-zero if the plan is to support
+* 					real transforms.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static AlgFourPlan *AlgFourPlanMake(int num, int real, AlgError *dstErr)
+{
+  AlgFourPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if(num < 1)
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(((plan = (AlgFourPlan *)
+		   AlcCalloc(1, sizeof(AlgFourPlan))) == NULL) ||
+	  ((plan->tw = (double *)
+	               AlcMalloc(sizeof(double) * 2 * num)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    int		k,
+		n,
+		p,
+		maxP = 0;
+    double	s;
+
+    plan->num = num;
+    plan->refCnt = 1;
+    s = 2.0 * ALG_M_PI / num;
+    for(k = 0; k < num; ++k)
+    {
+      plan->tw[2 * k] = cos(s * k);
+      plan->tw[2 * k + 1] = -sin(s * k);
+    }
+    /* Factorise the length, using radix 4 where possible. */
+    n = num;
+    p = 4;
+    while(n > 1)
+    {
+      while(n % p)
+      {
+	switch(p)
+	{
+	  case 4:
+	    p = 2;
+	    break;
+	  case 2:
+	    p = 3;
+	    break;
+	  default:
+	    p += 2;
+	    break;
+	}
+	if(p * p > n)
+	{
+	  p = n;
+	}
+      }
+      n /= p;
+      plan->fac[2 * plan->nFac] = p;
+      plan->fac[2 * plan->nFac + 1] = n;
+      ++(plan->nFac);
+      maxP = ALG_MAX(maxP, p);
+    }
+    if(maxP > ALG_FOURPLAN_MAXRADIX)
+    {
+      /* Use Bluestein's algorithm with the chirp
+       * w_k = exp(-i pi k^2 / n). */
+      int	bNum;
+      double	*b = NULL;
+
+      plan->nFac = 0;
+      bNum = 1;
+      while(bNum < 2 * num - 1)
+      {
+	bNum *= 2;
+      }
+      plan->blueNum = bNum;
+      if(((plan->blueChirp = (double *)
+			     AlcMalloc(sizeof(double) * 2 * num)) == NULL) ||
+	 ((plan->blueFChirp = (double *)
+			      AlcMalloc(sizeof(double) * 2 * bNum)) == NULL) ||
+	 ((b = (double *)AlcCalloc(2 * bNum, sizeof(double))) == NULL))
+      {
+	errNum = ALG_ERR_MALLOC;
+      }
+      else
+      {
+	plan->bluePlan = AlgFourPlanMake(bNum, 0, &errNum);
+      }
+      if(errNum == ALG_ERR_NONE)
+      {
+	s = ALG_M_PI / num;
+	for(k = 0; k < num; ++k)
+	{
+	  long long	k2;
+
+	  k2 = ((long long )k * k) % (2 * num);
+	  plan->blueChirp[2 * k] = cos(s * k2);
+	  plan->blueChirp[2 * k + 1] = -sin(s * k2);
+	  b[2 * k] = plan->blueChirp[2 * k];
+	  b[2 * k + 1] = -plan->blueChirp[2 * k + 1];
+	  if(k > 0)
+	  {
+	    b[2 * (bNum - k)] = b[2 * k];
+	    b[2 * (bNum - k) + 1] = b[2 * k + 1];
+	  }
+	}
+	AlgFourPlanCpx(plan->bluePlan, b, plan->blueFChirp, NULL);
+	s = 1.0 / bNum;
+	for(k = 0; k < 2 * bNum; ++k)
+	{
+	  plan->blueFChirp[k] *= s;
+	}
+      }
+      AlcFree(b);
+    }
+  }
+  if((errNum == ALG_ERR_NONE) && real && (num > 1) && ((num % 2) == 0))
+  {
+    plan->halfPlan = AlgFourPlanMake(num / 2, 0, &errNum);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    plan->wrkSz = 5 * num + AlgFourPlanCpxWrkSz(plan) +
+                  AlgFourPlanCpxWrkSz(plan->halfPlan);
+  }
+  else if(plan)
+  {
+    plan->refCnt = 1;
+    AlgFourPlanRelease(plan);
+    plan = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Decrements the plan's reference count and frees it if it
+* 		is no longer referenced. This function does not lock the
+* 		plan cache.
+* \param	plan			Given plan.
+*/
+static void	AlgFourPlanRelease(AlgFourPlan *plan)
+{
+  if(--(plan->refCnt) <= 0)
+  {
+    if(plan->bluePlan)
+    {
+      AlgFourPlanRelease(plan->bluePlan);
+    }
+    if(plan->halfPlan)
+    {
+      AlgFourPlanRelease(plan->halfPlan);
+    }
+    AlcFree(plan->tw);
+    AlcFree(plan->blueChirp);
+    AlcFree(plan->blueFChirp);
+    AlcFree(plan);
+  }
+}
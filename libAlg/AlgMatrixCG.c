@@ -62,6 +62,30 @@ static void			AlgMatrixCGDebug(
 				  int nDat);
 #endif /* ALG_MATRIXCG_DEBUG */
 
+/*!
+* \struct	_AlgMatrixCGMatDat
+* \ingroup	AlgMatrix
+* \brief	Data passed to the matrix multiplication and preconditioning
+* 		adaptor functions used when solving a system with an
+* 		explicitly stored matrix.
+*/
+typedef struct _AlgMatrixCGMatDat
+{
+  AlgMatrix	aM;			/*!< The stored matrix. */
+  void		(*pFn)(void *, AlgMatrix,
+                       double *, double *); /*!< Preconditioning function. */
+  void		*pDat;			/*!< Preconditioning data. */
+} AlgMatrixCGMatDat;
+
+static void			AlgMatrixCGMatMul(
+				  void *dat,
+				  double *xV,
+				  double *yV);
+static void			AlgMatrixCGMatPre(
+				  void *dat,
+				  double *rV,
+				  double *zV);
+
 /*!
 * \return	Error code.
 * \ingroup	AlgMatrix
@@ -108,10 +132,94 @@ AlgError	AlgMatrixCGSolve(
 				 	     double *, double *),
 				 void *pDat, double tol, int maxItr,
 				 double *dstTol, int *dstItr)
+{
+  AlgMatrixCGMatDat matDat;
+  AlgError	errCode = ALG_ERR_NONE;
+
+  if((aM.core == NULL) || (aM.core->nR < 1) || (aM.core->nR != aM.core->nC))
+  {
+    errCode = ALG_ERR_FUNC;
+  }
+  else
+  {
+    switch(aM.core->type)
+    {
+      case ALG_MATRIX_LLR:  /* FALLTHROUGH */
+      case ALG_MATRIX_RECT: /* FALLTHROUGH */
+      case ALG_MATRIX_SYM:
+	break;
+      default:
+        errCode = ALG_ERR_FUNC;
+	break;
+    }
+  }
+  if(errCode == ALG_ERR_NONE)
+  {
+    matDat.aM = aM;
+    matDat.pFn = pFn;
+    matDat.pDat = pDat;
+    errCode = AlgMatrixCGSolveFn(aM.core->nR, AlgMatrixCGMatMul, &matDat,
+                                 xV, bV, wM,
+				 (pFn)? AlgMatrixCGMatPre: NULL, &matDat,
+				 tol, maxItr, dstTol, dstItr);
+  }
+  return(errCode);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgMatrix
+* \brief	Matrix free Conjugate Gradient iterative method with
+*		preconditioning for the solution of linear systems with the
+*		form \f$\mathbf{A} \mathbf{x} = \mathbf{b}\f$.
+*		This is the same as AlgMatrixCGSolve() except that the
+*		matrix \f$\mathbf{A}\f$ is never stored, instead the
+*		given function is called to compute
+*		\f$\mathbf{y} = \mathbf{A} \mathbf{x}\f$ as
+*		(*aFn)(void *aDat, double *x, double *y). This allows
+*		large dense systems to be solved using storage which is
+*		only linear in the number of unknowns.
+*		\f$\mathbf{A}\f$ must be either symmetric positive definite
+*		or symmetric negative definite, in which case the
+*		preconditioner (if given) must also be negative definite.
+*		If the preconditioning function pFn is non NULL then
+*		it is called, passing the preconditioning data pDat, as:
+*		(*pFn)(void *pDat, double *r, double *z)
+*		to approximately solve \f$\mathbf{A} \mathbf{z} = \mathbf{r}\f$
+*		for \f$\mathbf{z}\f$.
+* \param	nN			Number of unknowns.
+* \param	aFn			Matrix multiplication function.
+* \param	aDat			Data to be passed to the matrix
+* 					multiplication function.
+* \param	xV			Vector \f$\mathbf{x}\f$ which
+*					should contain an initial estimate
+*					although this may be \f$\mathbf{0}\f$.
+* \param	bV			Vector \f$\mathbf{b}\f$.
+* \param	wM			Matrix with dimensions [4, nN],
+*					this must be a rectangular matrix.
+* \param	pFn			Preconditioning function, may be NULL.
+* \param	pDat			Data to be passed to preconditioning
+* 					function.
+* \param	tol			Tolerance required, \f$\delta\f$.
+* \param	maxItr			The maximum number of itterations.
+* \param	dstTol			Destination pointer for the residual
+*					after the final iteration, may be NULL.
+* \param	dstItr			Destination pointer for the actual
+*					number of itterations performed,
+*					may be NULL.
+*/
+AlgError	AlgMatrixCGSolveFn(
+				 size_t nN,
+				 void (*aFn)(void *, double *, double *),
+				 void *aDat,
+				 double *xV, double *bV,
+				 AlgMatrix wM,
+				 void (*pFn)(void *, double *, double *),
+				 void *pDat, double tol, int maxItr,
+				 double *dstTol, int *dstItr)
 {
   int		itr = 0,
   		conv = 0;
-  size_t	nN;
   double	alpha,
 		beta,
   		resid = DBL_MAX,
@@ -124,43 +232,31 @@ AlgError	AlgMatrixCGSolve(
   AlgError	errCode = ALG_ERR_NONE;
 
   rho[0] = rho[1] = 0.0;
-  if((aM.core == NULL) || (aM.core->nR < 1) || (aM.core->nR != aM.core->nC) ||
+  if((nN < 1) || (aFn == NULL) ||
      (wM.core == NULL) || (wM.core->type != ALG_MATRIX_RECT) ||
-     (wM.core->nR != 4) || (wM.core->nC != aM.core->nC) ||
+     (wM.core->nR != 4) || (wM.core->nC != nN) ||
      (xV == NULL) || (bV == NULL) || (tol < 0.0) || (maxItr < 0))
   {
     errCode = ALG_ERR_FUNC;
   }
-  else
-  {
-    switch(aM.core->type)
-    {
-      case ALG_MATRIX_LLR:  /* FALLTHROUGH */
-      case ALG_MATRIX_RECT: /* FALLTHROUGH */
-      case ALG_MATRIX_SYM:
-	break;
-      default:
-        errCode = ALG_ERR_FUNC;
-	break;
-    }
-  }
   if(errCode == ALG_ERR_NONE)
   {
-    nN = aM.core->nR;
     AlgMatrixZero(wM);
     r = wM.rect->array[0];
     p = wM.rect->array[1];
     z = wM.rect->array[2];
     q = wM.rect->array[3];
-    nrmB = AlgVectorNorm(bV, aM.core->nR);
+    /* The norms are computed directly since AlgVectorNorm() does not
+     * take the square root of small values. */
+    nrmB = sqrt(AlgVectorDot(bV, bV, nN));
     /* r = b - A x */
-    AlgMatrixVectorMul(r, aM, xV);
-    AlgVectorSub(r, bV, r, aM.core->nR);
+    (*aFn)(aDat, xV, r);
+    AlgVectorSub(r, bV, r, nN);
     if(nrmB < DBL_EPSILON) 
     {
       nrmB = 1.0;
     }
-    if((resid = AlgVectorNorm(r, nN) / nrmB) <= tol)
+    if((resid = sqrt(AlgVectorDot(r, r, nN)) / nrmB) <= tol)
     {
       conv = 1;
     }
@@ -174,7 +270,7 @@ AlgError	AlgMatrixCGSolve(
       /* Pre-conditioning: Solve aM z = r for z. */
       if(pFn)
       {
-	(*pFn)(pDat, aM, r, z);
+	(*pFn)(pDat, r, z);
       }
       else
       {
@@ -192,13 +288,13 @@ AlgError	AlgMatrixCGSolve(
 	AlgVectorScaleAdd(p, p, z, beta, nN);
       }
       /* q = A p */
-      AlgMatrixVectorMul(q, aM, p);
+      (*aFn)(aDat, p, q);
       alpha = rho[0] / AlgVectorDot(p, q, nN);
       /* x = x + alpha p */
       AlgVectorScaleAdd(xV, p, xV, alpha, nN);
       /* r = r - alpha * q */
       AlgVectorScaleAdd(r, q, r, -alpha, nN);
-      if((resid = AlgVectorNorm(r, nN) / nrmB) <= tol)
+      if((resid = sqrt(AlgVectorDot(r, r, nN)) / nrmB) <= tol)
       {
 	tol = resid;
 	conv = 1;
@@ -225,6 +321,36 @@ AlgError	AlgMatrixCGSolve(
   return(errCode);
 }
 
+/*!
+* \ingroup	AlgMatrix
+* \brief	Matrix multiplication adaptor for AlgMatrixCGSolve().
+* \param	dat			Matrix data.
+* \param	xV			Vector to be multiplied.
+* \param	yV			Destination vector.
+*/
+static void	AlgMatrixCGMatMul(void *dat, double *xV, double *yV)
+{
+  AlgMatrixCGMatDat *matDat;
+
+  matDat = (AlgMatrixCGMatDat *)dat;
+  AlgMatrixVectorMul(yV, matDat->aM, xV);
+}
+
+/*!
+* \ingroup	AlgMatrix
+* \brief	Preconditioning adaptor for AlgMatrixCGSolve().
+* \param	dat			Matrix data.
+* \param	rV			Residual vector.
+* \param	zV			Destination vector.
+*/
+static void	AlgMatrixCGMatPre(void *dat, double *rV, double *zV)
+{
+  AlgMatrixCGMatDat *matDat;
+
+  matDat = (AlgMatrixCGMatDat *)dat;
+  (*(matDat->pFn))(matDat->pDat, matDat->aM, rV, zV);
+}
+
 #ifdef ALG_MATRIXCG_DEBUG
 static void	AlgMatrixCGDebug(FILE *fP, const char *name,
 				 double *dat, int nDat)
@@ -225,6 +225,54 @@ extern AlgError        		AlgFourRealInv3D(
 				  int numY,
 				  int numZ);
 
+/* From AlgFourPlan.c */
+extern AlgFourPlan		*AlgFourPlanNew(
+				  int num,
+				  AlgError *dstErr);
+extern void			AlgFourPlanFree(
+				  AlgFourPlan *plan);
+extern AlgFourPlan		*AlgFourPlanGet(
+				  int num,
+				  AlgError *dstErr);
+extern void			AlgFourPlanCacheFree(void);
+extern int			AlgFourPlanNiceNum(
+				  int num);
+extern AlgError			AlgFourPlanExec1D(
+				  AlgFourPlan *plan,
+				  double *real,
+				  double *imag,
+				  int step,
+				  int inv);
+extern AlgError			AlgFourPlanExecReal1D(
+				  AlgFourPlan *plan,
+				  double *data,
+				  int step,
+				  int inv);
+extern AlgError			AlgFourPlanExec2D(
+				  AlgFourPlan *pX,
+				  AlgFourPlan *pY,
+				  double **real,
+				  double **imag,
+				  int inv);
+extern AlgError			AlgFourPlanExecReal2D(
+				  AlgFourPlan *pX,
+				  AlgFourPlan *pY,
+				  double **data,
+				  int inv);
+extern AlgError			AlgFourPlanExec3D(
+				  AlgFourPlan *pX,
+				  AlgFourPlan *pY,
+				  AlgFourPlan *pZ,
+				  double ***real,
+				  double ***imag,
+				  int inv);
+extern AlgError			AlgFourPlanExecReal3D(
+				  AlgFourPlan *pX,
+				  AlgFourPlan *pY,
+				  AlgFourPlan *pZ,
+				  double ***data,
+				  int inv);
+
 /* From AlgGamma.c */
 extern double			AlgGammaLog(
 				  double x,
@@ -677,6 +725,24 @@ extern AlgError			AlgMatrixCGSolve(
                                   double *dstTol,
 				  int *dstItr);
 
+extern AlgError			AlgMatrixCGSolveFn(
+				  size_t nN,
+				  void (*aFn)(void *,
+				              double *,
+					      double *),
+				  void *aDat,
+                                  double *xV, 
+				  double *bV,
+                                  AlgMatrix wM,
+                                  void (*pFn)(void *,
+                                              double *,
+					      double *),
+                                  void *pDat,
+				  double tol,
+				  int maxItr,
+                                  double *dstTol,
+				  int *dstItr);
+
 /* From AlgMatrixRSEigen.c */
 extern AlgError        		AlgMatrixRSEigen(
 				  AlgMatrix aM,
@@ -240,6 +240,47 @@ typedef struct _ComplexD
   double	im;
 } ComplexD;
 
+/*!
+* \def		ALG_FOURPLAN_MAXFAC
+* \brief	Maximum number of factors in a Fourier transform plan.
+*/
+#define ALG_FOURPLAN_MAXFAC	(32)
+
+/*!
+* \struct	_AlgFourPlan
+* \brief	A plan for computing discrete Fourier transforms of a
+* 		fixed length. The plan holds the factorisation of the
+* 		length and precomputed twiddle factors so that it may
+* 		be created once and then used for any number of
+* 		transforms. Lengths with large prime factors are
+* 		transformed using Bluestein's algorithm. Once created
+* 		a plan is not modified by the transform functions and
+* 		so may be shared between threads.
+* 		Typedef: ::AlgFourPlan.
+*/
+typedef struct _AlgFourPlan
+{
+  int		num;		/*!< Transform length. */
+  int		refCnt;		/*!< Reference count. */
+  int		nFac;		/*!< Number of factors of num. */
+  int		fac[2 * ALG_FOURPLAN_MAXFAC]; /*!< Radix and remaining
+  				     length pairs, one for each factor. */
+  size_t	wrkSz;		/*!< Number of doubles of workspace required
+  				     for a single transform. */
+  double	*tw;		/*!< Interleaved complex twiddle factors
+  				     \f$e^{-2 \pi i k/n}\f$ for
+				     \f$k = 0, \ldots, n - 1\f$. */
+  int		blueNum;	/*!< Bluestein convolution length or zero
+  				     if Bluestein's algorithm is not used. */
+  double	*blueChirp;	/*!< Interleaved complex Bluestein chirp. */
+  double	*blueFChirp;	/*!< Interleaved complex scaled Fourier
+  				     transform of the conjugate chirp. */
+  struct _AlgFourPlan *bluePlan; /*!< Plan for the Bluestein convolution. */
+  struct _AlgFourPlan *halfPlan; /*!< Plan for half length complex
+  				     transforms used by the real transforms
+				     of even length data. */
+} AlgFourPlan;
+
 
 /*
 * \enum		_AlgError
@@ -44,6 +44,15 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Size of the blocks of section pixels which are sampled together when the
+ * given object's values are not tiled (when they are the tile width is
+ * used). */
+#define WLZ_GETSUBSEC_BLKSZ	(32)
+
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject 		*obj,
   WlzObject		*subDomain,
@@ -51,6 +60,22 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzInterpolationType	interp,
   WlzObject		**maskRtn,
   WlzErrorNum 		*dstErr);
+static WlzErrorNum WlzGetSubSectionScan(
+  WlzObject		*obj,
+  WlzObject		*secObj,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			maskFlg);
+static WlzErrorNum WlzGetSubSectionRun(
+  WlzObject		*obj,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			ln,
+  int			lft,
+  int			rgt,
+  WlzGreyP		gP,
+  size_t		off);
 
 
 /*!
@@ -175,9 +200,6 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
 			*mask = NULL;
   WlzDomain		domain;
   WlzValues		values;
-  WlzGreyValueWSpace	*gVWSp = NULL;
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
   int			maskFlg = 0,
   			greyFlg = 0;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
@@ -308,209 +330,13 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   /* Scan object setting values */
   if((errNum == WLZ_ERR_NONE) && greyFlg)
   {
-    if((gVWSp = WlzGreyValueMakeWSp(obj, &errNum)))
-    {
-      errNum = WlzInitGreyScan(newObj, &iwsp, &gwsp);
-      while((errNum == WLZ_ERR_NONE) && 
-	    ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-      {
-        int 	k,
-		yp;
-	WlzDVertex3 vty;
-
-	yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-	vty.vtX = viewStr->yp_to_x[yp];
-	vty.vtY = viewStr->yp_to_y[yp];
-	vty.vtZ = viewStr->yp_to_z[yp];
-	switch(interp)
-	{
-	  case WLZ_INTERPOLATION_NEAREST:
-	    switch(gVWSp->gType){
-	      case WLZ_GREY_INT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.inp)++ = gVWSp->gVal[0].inv;
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.shp)++ = gVWSp->gVal[0].shv;
-		}
-		break;
-	      case WLZ_GREY_UBYTE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.ubp)++ = gVWSp->gVal[0].ubv;
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.flp)++ = gVWSp->gVal[0].flv;
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.dbp)++ = gVWSp->gVal[0].dbv;
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		{
-                  WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
-	          *(gwsp.u_grintptr.rgbp)++ = gVWSp->gVal[0].rgbv;
-		}
-		break;
-	      default:
-		break;
-	    }
-	    break;
-	  case WLZ_INTERPOLATION_LINEAR:
-	    {
-	      double		tD0;
-	      WlzDVertex3	tDV0,
-				tDV1;
-
-	      switch(gVWSp->gType){
-		case WLZ_GREY_INT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
-		    *(gwsp.u_grintptr.inp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_SHORT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
-		    *(gwsp.u_grintptr.shp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_UBYTE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    tD0 = WLZ_CLAMP(tD0, 0, 255);
-		    *(gwsp.u_grintptr.ubp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		case WLZ_GREY_FLOAT:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.flp)++ = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		  }
-		  break;
-		case WLZ_GREY_DOUBLE:
-		  for(k = iwsp.lftpos; k <= iwsp.rgtpos; ++k)
-		  {
-		    WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
-		    tD0 =
-		      ((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		      ((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		      ((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		    *(gwsp.u_grintptr.dbp)++ = WLZ_NINT(tD0);
-		  }
-		  break;
-		default:
-		  errNum = WLZ_ERR_GREY_TYPE;
-		  break;
-	      }
-	    }
-	    break;
-	  default:
-	    errNum = WLZ_ERR_UNIMPLEMENTED;
-	    break;
-	}
-      }
-      if(errNum == WLZ_ERR_EOO)	   /* Reset error from end of intervals */ 
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      WlzGreyValueFreeWSp(gVWSp);
-    }
+    errNum = WlzGetSubSectionScan(obj, newObj, viewStr, interp, 0);
   }
 
   /* Check if mask required */
   if((errNum == WLZ_ERR_NONE) && maskFlg)
   {
-    errNum = WlzInitGreyScan(mask, &iwsp, &gwsp);
-    while((errNum == WLZ_ERR_NONE) && 
-	  ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-    {
-      int 	k,
-      		yp;
-      WlzDVertex3 vty;
-
-      yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-      vty.vtX = viewStr->yp_to_x[yp];
-      vty.vtY = viewStr->yp_to_y[yp];
-      vty.vtZ = viewStr->yp_to_z[yp];
-      for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++)
-      {
-	int	xp;
-        WlzDVertex3 vtx;
-
-	xp = k - WLZ_NINT(viewStr->minvals.vtX);
-        WLZ_GETSUBSEC_POS(vtx, viewStr, xp, vty)
-	*(gwsp.u_grintptr.ubp)++ = WlzInsideDomain(obj,
-	    WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY), WLZ_NINT(vtx.vtX), NULL);
-      }
-    }
-    if(errNum == WLZ_ERR_EOO)	   /* Reset EOO error from end of intervals */ 
-    {
-      errNum = WLZ_ERR_NONE;
-    }
+    errNum = WlzGetSubSectionScan(obj, mask, viewStr, interp, 1);
     /* Threshold to determine the mask */
     if(errNum == WLZ_ERR_NONE)
     {
@@ -555,3 +381,362 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   }
   return(newObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Fills the rectangular value table of the given section
+*		object by sampling the given 3D object. When the mask flag
+*		is set the section values are set to non-zero where the
+*		sampled position is within the 3D object's domain, otherwise
+*		they are set to the 3D object's grey values.
+*		The section is sampled in bands of lines which are
+*		processed in parallel, each band having its own grey value
+*		work space. Within a band the lines are walked in blocks
+*		of columns so that neighbouring section pixels (which map
+*		to neighbouring voxels) are sampled together, this keeping
+*		tiled values within the same tile.
+* \param	obj			Given 3D domain object.
+* \param	secObj			Section object with a rectangular
+*					value table covering its domain.
+* \param	viewStr			Initialised view structure.
+* \param	interp			Interpolation method.
+* \param	maskFlg			Set the section values to a mask of
+*					the 3D object's domain if non-zero.
+*/
+static WlzErrorNum WlzGetSubSectionScan(
+  WlzObject		*obj,
+  WlzObject		*secObj,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			maskFlg)
+{
+  int			blkSz,
+  			nBnd,
+			lastKl;
+  WlzIntervalDomain	*iDom;
+  WlzRectValues		*rVal;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  if(secObj->type != WLZ_2D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((secObj->domain.core == NULL) || (secObj->values.core == NULL))
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(WlzGreyTableTypeToTableType(secObj->values.core->type,
+                                      &errNum) != WLZ_GREY_TAB_RECT)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idB;
+
+    iDom = secObj->domain.i;
+    rVal = secObj->values.r;
+    lastKl = iDom->lastkl;
+    blkSz = WLZ_GETSUBSEC_BLKSZ;
+    if(!maskFlg)
+    {
+      if(WlzGreyTableIsTiled(obj->values.core->type))
+      {
+	blkSz = ALG_MAX(obj->values.t->tileWidth, 2);
+      }
+    }
+    nBnd = (iDom->lastln - iDom->line1 + blkSz) / blkSz;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idB = 0; idB < nBnd; ++idB)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int		bLn0,
+		      	bLn1,
+			kB;
+	WlzGreyValueWSpace *gVWSp = NULL;
+	WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	bLn0 = iDom->line1 + (idB * blkSz);
+	bLn1 = ALG_MIN(bLn0 + blkSz - 1, iDom->lastln);
+	if(!maskFlg)
+	{
+	  gVWSp = WlzGreyValueMakeWSp(obj, &errNum2);
+	}
+	for(kB = iDom->kol1; (errNum2 == WLZ_ERR_NONE) && (kB <= lastKl);
+	    kB += blkSz)
+	{
+	  int		ln,
+	  		kB1;
+
+	  kB1 = ALG_MIN(kB + blkSz - 1, lastKl);
+	  for(ln = bLn0; (errNum2 == WLZ_ERR_NONE) && (ln <= bLn1); ++ln)
+	  {
+	    int		idI,
+	    		nItv;
+	    WlzInterval	*itv = NULL;
+	    WlzInterval	rItv;
+
+	    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+	    {
+	      nItv = 1;
+	      rItv.ileft = 0;
+	      rItv.iright = lastKl - iDom->kol1;
+	      itv = &rItv;
+	    }
+	    else
+	    {
+	      WlzIntervalLine *itvLn;
+
+	      itvLn = iDom->intvlines + ln - iDom->line1;
+	      nItv = itvLn->nintvs;
+	      itv = itvLn->intvs;
+	    }
+	    for(idI = 0; (errNum2 == WLZ_ERR_NONE) && (idI < nItv); ++idI)
+	    {
+	      int	lft,
+	      		rgt;
+
+	      lft = ALG_MAX(itv[idI].ileft + iDom->kol1, kB);
+	      rgt = ALG_MIN(itv[idI].iright + iDom->kol1, kB1);
+	      if(lft <= rgt)
+	      {
+		errNum2 = WlzGetSubSectionRun(obj, gVWSp, viewStr, interp,
+					      ln, lft, rgt, rVal->values,
+					      ((ln - rVal->line1) * rVal->width) +
+					      lft - rVal->kol1);
+	      }
+	    }
+	  }
+	}
+	WlzGreyValueFreeWSp(gVWSp);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzGetSubSectionScan)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Samples a single run of section pixels on the given line
+*		and within the given columns, setting the values of the
+*		given array starting at the given offset. If the grey value
+*		work space is NULL the values are set to a mask of the
+*		3D object's domain.
+* \param	obj			Given 3D domain object.
+* \param	gVWSp			Grey value work space for the
+*					given object or NULL for a mask.
+* \param	viewStr			Initialised view structure.
+* \param	interp			Interpolation method.
+* \param	ln			Section line.
+* \param	lft			First column of the run.
+* \param	rgt			Last column of the run.
+* \param	gP			Array of section values.
+* \param	off			Offset into the array for the first
+*					column of the run.
+*/
+static WlzErrorNum WlzGetSubSectionRun(
+  WlzObject		*obj,
+  WlzGreyValueWSpace	*gVWSp,
+  WlzThreeDViewStruct	*viewStr,
+  WlzInterpolationType	interp,
+  int			ln,
+  int			lft,
+  int			rgt,
+  WlzGreyP		gP,
+  size_t		off)
+{
+  int 			k,
+			yp;
+  WlzDVertex3 		vty;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  yp = ln - WLZ_NINT(viewStr->minvals.vtY);
+  vty.vtX = viewStr->yp_to_x[yp];
+  vty.vtY = viewStr->yp_to_y[yp];
+  vty.vtZ = viewStr->yp_to_z[yp];
+  if(gVWSp == NULL)
+  {
+    for(k = lft; k <= rgt; ++k)
+    {
+      int	xp;
+      WlzDVertex3 vtx;
+
+      xp = k - WLZ_NINT(viewStr->minvals.vtX);
+      WLZ_GETSUBSEC_POS(vtx, viewStr, xp, vty)
+      gP.ubp[off++] = WlzInsideDomain(obj,
+	  WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY), WLZ_NINT(vtx.vtX), NULL);
+    }
+  }
+  else
+  {
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST:
+	switch(gVWSp->gType){
+	  case WLZ_GREY_INT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.inp[off++] = gVWSp->gVal[0].inv;
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.shp[off++] = gVWSp->gVal[0].shv;
+	    }
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.ubp[off++] = gVWSp->gVal[0].ubv;
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.flp[off++] = gVWSp->gVal[0].flv;
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.dbp[off++] = gVWSp->gVal[0].dbv;
+	    }
+	    break;
+	  case WLZ_GREY_RGBA:
+	    for(k = lft; k <= rgt; ++k)
+	    {
+	      WLZ_GETSUBSEC_VAL(gVWSp, viewStr, k, vty)
+	      gP.rgbp[off++] = gVWSp->gVal[0].rgbv;
+	    }
+	    break;
+	  default:
+	    break;
+	}
+	break;
+      case WLZ_INTERPOLATION_LINEAR:
+	{
+	  double            tD0;
+	  WlzDVertex3       tDV0,
+			    tDV1;
+
+	  switch(gVWSp->gType){
+	    case WLZ_GREY_INT:
+	      for(k = lft; k <= rgt; ++k)
+	      {
+		WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+		tD0 =
+		  ((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
+		gP.inp[off++] = WLZ_NINT(tD0);
+	      }
+	      break;
+	    case WLZ_GREY_SHORT:
+	      for(k = lft; k <= rgt; ++k)
+	      {
+		WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+		tD0 =
+		  ((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+		gP.shp[off++] = WLZ_NINT(tD0);
+	      }
+	      break;
+	    case WLZ_GREY_UBYTE:
+	      for(k = lft; k <= rgt; ++k)
+	      {
+		WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+		tD0 =
+		  ((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		tD0 = WLZ_CLAMP(tD0, 0, 255);
+		gP.ubp[off++] = WLZ_NINT(tD0);
+	      }
+	      break;
+	    case WLZ_GREY_FLOAT:
+	      for(k = lft; k <= rgt; ++k)
+	      {
+		WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+		tD0 =
+		  ((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		gP.flp[off++] = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
+	      }
+	      break;
+	    case WLZ_GREY_DOUBLE:
+	      for(k = lft; k <= rgt; ++k)
+	      {
+		WLZ_GETSUBSEC_CONVAL(gVWSp, tDV0, tDV1, viewStr, k, vty)
+		tD0 =
+		  ((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		  ((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		  ((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		gP.dbp[off++] = WLZ_NINT(tD0);
+	      }
+	      break;
+	    default:
+	      errNum = WLZ_ERR_GREY_TYPE;
+	      break;
+	  }
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_UNIMPLEMENTED;
+	break;
+    }
+  }
+  return(errNum);
+}
@@ -50,6 +50,45 @@ static char _WlzAffineTransform_c[] = "University of Edinburgh $Id$";
 #include <string.h>
 
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzAffineTransformRectPln
+* \ingroup	WlzTransform
+* \brief	A single plane of a rectangular value source.
+*		Typedef: ::WlzAffineTransformRectPln.
+*/
+typedef struct _WlzAffineTransformRectPln
+{
+  WlzGreyP	values;			/*!< Rectangular values of the plane,
+  					     NULL if the plane is empty. */
+  int		line1;			/*!< First line of the domain. */
+  int		lastln;			/*!< Last line of the domain. */
+  int		kol1;			/*!< First column of the domain. */
+  int		lastkl;			/*!< Last column of the domain. */
+  int		vLine1;			/*!< First line of the values. */
+  int		vKol1;			/*!< First column of the values. */
+  int		width;			/*!< Width of the values. */
+} WlzAffineTransformRectPln;
+
+/*!
+* \struct	_WlzAffineTransformRectSrc
+* \ingroup	WlzTransform
+* \brief	Direct access to the values of a 2D or 3D domain object
+* 		which has rectangular domains and value tables, used to
+* 		avoid interval searches when resampling such objects.
+*		Typedef: ::WlzAffineTransformRectSrc.
+*/
+typedef struct _WlzAffineTransformRectSrc
+{
+  WlzGreyType	gType;			/*!< Grey type of the values. */
+  double	bkd;			/*!< Background value. */
+  int		plane1;			/*!< First plane, zero for 2D. */
+  int		nPln;			/*!< Number of planes, one for 2D. */
+  WlzAffineTransformRectPln *pln;	/*!< Array of planes. */
+} WlzAffineTransformRectSrc;
 
 static int			WlzAffineTransformIsTranslate2(
 				  WlzAffineTransform *trans,
@@ -98,6 +137,45 @@ static WlzErrorNum 		WlzAffineTransformValues3(WlzObject *newObj,
 				  WlzInterpolationType interp,
 				  void *cbData,
 				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum		WlzAffineTransformPlaneValues3(
+				  WlzObject *newObj,
+				  WlzAffineTransformRectSrc *rSrc,
+				  int idP,
+				  int pln,
+				  WlzAffineTransform *invTrans,
+				  WlzGreyType gType,
+				  WlzPixelV bkdV,
+				  WlzInterpolationType interp,
+				  int batch,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzDVertex3 *posBuf,
+				  double *valBuf,
+				  void *cbData,
+				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum		WlzAffineTransformItvValues(
+				  WlzGreyWSpace *gWSp,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzAffineTransformRectSrc *rSrc,
+				  WlzInterpolationType interp,
+				  int trunc,
+				  int count,
+				  int kol0,
+				  WlzDVertex3 org,
+				  WlzDVertex3 inc,
+				  WlzDVertex3 *posBuf,
+				  double *valBuf);
+static int			WlzAffineTransformBatchInterp(
+				  WlzInterpolationType interp,
+				  WlzAffineTransformRectSrc *rSrc);
+static WlzAffineTransformRectSrc *WlzAffineTransformRectSrcMake(
+				  WlzObject *obj,
+				  WlzGreyType gType,
+				  WlzPixelV bkdV);
+static double			WlzAffineTransformRectValue(
+				  WlzAffineTransformRectSrc *src,
+				  int pl,
+				  int ln,
+				  int kl);
 static WlzErrorNum 		WlzAffineTransformPrimSet2(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim prim);
@@ -1099,6 +1177,438 @@ WlzErrorNum 	WlzAffineTransformGMShell(WlzGMShell *shell,
   return(errNum);
 }
 
+/*!
+* \ingroup	WlzTransform
+* \return	New rectangular value source or NULL if the given object
+* 		does not have rectangular values.
+* \brief	Makes a rectangular value source for the given 2D or 3D
+* 		domain object if all of its (non-empty) planes have
+* 		rectangular interval domains with rectangular value
+* 		tables which cover them. The values of such objects can
+* 		be accessed directly by WlzAffineTransformRectValue().
+* 		The source should be freed using AlcFree().
+* \param	obj			Given object.
+* \param	gType			Grey type of the object's values.
+* \param	bkdV			Background value of the object.
+*/
+static WlzAffineTransformRectSrc *WlzAffineTransformRectSrcMake(
+					WlzObject *obj,
+					WlzGreyType gType,
+					WlzPixelV bkdV)
+{
+  int		idP,
+		nPln = 1,
+		rect = 1;
+  WlzDomain	*doms;
+  WlzValues	*vals;
+  WlzAffineTransformRectSrc *src = NULL;
+
+  if((obj == NULL) || (obj->domain.core == NULL) ||
+     (obj->values.core == NULL))
+  {
+    rect = 0;
+  }
+  else if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    doms = &(obj->domain);
+    vals = &(obj->values);
+  }
+  else if((obj->type == WLZ_3D_DOMAINOBJ) &&
+          (obj->domain.p->type == WLZ_PLANEDOMAIN_DOMAIN) &&
+	  (obj->values.vox->type == WLZ_VOXELVALUETABLE_GREY) &&
+	  (obj->values.vox->plane1 == obj->domain.p->plane1) &&
+	  (obj->values.vox->lastpl == obj->domain.p->lastpl))
+  {
+    doms = obj->domain.p->domains;
+    vals = obj->values.vox->values;
+    nPln = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+  }
+  else
+  {
+    rect = 0;
+  }
+  for(idP = 0; rect && (idP < nPln); ++idP)
+  {
+    WlzIntervalDomain *iDom;
+
+    iDom = doms[idP].i;
+    if((iDom != NULL) && (iDom->type != WLZ_EMPTY_DOMAIN))
+    {
+      WlzRectValues *rVal;
+
+      rVal = vals[idP].r;
+      rect = (iDom->type == WLZ_INTERVALDOMAIN_RECT) &&
+	     (rVal != NULL) &&
+	     (WlzGreyTableTypeToTableType(rVal->type,
+	                                  NULL) == WLZ_GREY_TAB_RECT) &&
+	     (WlzGreyTableTypeToGreyType(rVal->type, NULL) == gType) &&
+	     (iDom->line1 >= rVal->line1) && (iDom->lastln <= rVal->lastln) &&
+	     (iDom->kol1 >= rVal->kol1) &&
+	     (iDom->lastkl < rVal->kol1 + rVal->width);
+    }
+  }
+  if(rect)
+  {
+    if((src = (WlzAffineTransformRectSrc *)
+              AlcMalloc(sizeof(WlzAffineTransformRectSrc) +
+		        (nPln * sizeof(WlzAffineTransformRectPln)))) != NULL)
+    {
+      src->gType = gType;
+      src->nPln = nPln;
+      src->plane1 = (nPln > 1)? obj->domain.p->plane1: 0;
+      src->pln = (WlzAffineTransformRectPln *)(src + 1);
+      switch(gType)
+      {
+	case WLZ_GREY_INT:
+	  src->bkd = bkdV.v.inv;
+	  break;
+	case WLZ_GREY_SHORT:
+	  src->bkd = bkdV.v.shv;
+	  break;
+	case WLZ_GREY_UBYTE:
+	  src->bkd = bkdV.v.ubv;
+	  break;
+	case WLZ_GREY_FLOAT:
+	  src->bkd = bkdV.v.flv;
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  src->bkd = bkdV.v.dbv;
+	  break;
+	case WLZ_GREY_RGBA:
+	  src->bkd = bkdV.v.rgbv;
+	  break;
+	default:
+	  src->bkd = 0.0;
+	  break;
+      }
+      for(idP = 0; idP < nPln; ++idP)
+      {
+	WlzIntervalDomain *iDom;
+	WlzAffineTransformRectPln *pln;
+
+	pln = src->pln + idP;
+	iDom = doms[idP].i;
+	if((iDom == NULL) || (iDom->type == WLZ_EMPTY_DOMAIN))
+	{
+	  pln->values.v = NULL;
+	}
+	else
+	{
+	  WlzRectValues *rVal;
+
+	  rVal = vals[idP].r;
+	  pln->values = rVal->values;
+	  pln->line1 = iDom->line1;
+	  pln->lastln = iDom->lastln;
+	  pln->kol1 = iDom->kol1;
+	  pln->lastkl = iDom->lastkl;
+	  pln->vLine1 = rVal->line1;
+	  pln->vKol1 = rVal->kol1;
+	  pln->width = rVal->width;
+	}
+      }
+    }
+  }
+  return(src);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return	Grey value at the given position.
+* \brief	Gets a grey value from a rectangular value source,
+* 		returning the background value for positions outside of
+* 		the source object.
+* \param	src			Rectangular value source.
+* \param	pl			Plane coordinate, always zero for
+* 					2D objects.
+* \param	ln			Line coordinate.
+* \param	kl			Column coordinate.
+*/
+static double	WlzAffineTransformRectValue(WlzAffineTransformRectSrc *src,
+					    int pl, int ln, int kl)
+{
+  double	v;
+  WlzAffineTransformRectPln *pln;
+
+  v = src->bkd;
+  pl -= src->plane1;
+  if((pl >= 0) && (pl < src->nPln))
+  {
+    pln = src->pln + pl;
+    if((pln->values.v != NULL) &&
+       (ln >= pln->line1) && (ln <= pln->lastln) &&
+       (kl >= pln->kol1) && (kl <= pln->lastkl))
+    {
+      size_t	off;
+
+      off = ((size_t )(ln - pln->vLine1) * pln->width) + kl - pln->vKol1;
+      switch(src->gType)
+      {
+	case WLZ_GREY_INT:
+	  v = pln->values.inp[off];
+	  break;
+	case WLZ_GREY_SHORT:
+	  v = pln->values.shp[off];
+	  break;
+	case WLZ_GREY_UBYTE:
+	  v = pln->values.ubp[off];
+	  break;
+	case WLZ_GREY_FLOAT:
+	  v = pln->values.flp[off];
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  v = pln->values.dbp[off];
+	  break;
+	case WLZ_GREY_RGBA:
+	  v = pln->values.rgbp[off];
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+  return(v);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return	Non-zero if the values may be computed using
+* 		WlzAffineTransformItvValues().
+* \brief	Decides whether the batched interval resampler can be
+* 		used for the given interpolation method. Nearest
+* 		neighbour values are only batched for rectangular value
+* 		sources. The classification and callback interpolation
+* 		methods are left to the per-value code.
+* \param	interp			Given interpolation method.
+* \param	rSrc			Rectangular value source, may be
+* 					NULL.
+*/
+static int	WlzAffineTransformBatchInterp(WlzInterpolationType interp,
+					      WlzAffineTransformRectSrc *rSrc)
+{
+  int		batch = 0;
+
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      batch = rSrc != NULL;
+      break;
+    case WLZ_INTERPOLATION_LINEAR: /* FALLTHROUGH */
+    case WLZ_INTERPOLATION_CUBIC:
+      batch = 1;
+      break;
+    default:
+      break;
+  }
+  return(batch);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return	Woolz error code.
+* \brief	Fills in the values of a single interval of a transformed
+* 		object. The source positions of the interval's columns
+* 		are stepped incrementally from the position of the
+* 		line's origin. Nearest neighbour and (other than for
+* 		RGBA values) linear interpolation values are read
+* 		directly from a rectangular value source if one is given,
+* 		otherwise the values for all of the interval are found by
+* 		a single call to WlzGreyValueGetN(), which interpolates
+* 		RGBA values channel by channel.
+* 		Finally the values are converted to the grey type of the
+* 		interval using simple per grey type loops which the
+* 		compiler can vectorize.
+* \param	gWSp			Grey work space with the interval's
+* 					value pointer, this is not modified.
+* \param	gVWSp			Grey value work space for the source
+* 					object.
+* \param	rSrc			Rectangular value source for the
+* 					source object, may be NULL.
+* \param	interp			Interpolation method, must be one
+* 					of those for which
+* 					WlzAffineTransformBatchInterp()
+* 					returns non-zero.
+* \param	trunc			Source positions are truncated to
+* 					integers if non-zero.
+* \param	count			Number of values in the interval.
+* \param	kol0			Column of the first value of the
+* 					interval.
+* \param	org			Source position of column zero
+* 					in the interval's line.
+* \param	inc			Source position increment per
+* 					column.
+* \param	posBuf			Buffer for at least count positions.
+* \param	valBuf			Buffer for at least count values.
+*/
+static WlzErrorNum WlzAffineTransformItvValues(WlzGreyWSpace *gWSp,
+					WlzGreyValueWSpace *gVWSp,
+					WlzAffineTransformRectSrc *rSrc,
+					WlzInterpolationType interp,
+					int trunc, int count, int kol0,
+					WlzDVertex3 org, WlzDVertex3 inc,
+					WlzDVertex3 *posBuf, double *valBuf)
+{
+  int		idx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(trunc)
+  {
+    for(idx = 0; idx < count; ++idx)
+    {
+      double	k;
+
+      k = (double )(kol0 + idx);
+      posBuf[idx].vtX = (int )(org.vtX + (inc.vtX * k));
+      posBuf[idx].vtY = (int )(org.vtY + (inc.vtY * k));
+      posBuf[idx].vtZ = (int )(org.vtZ + (inc.vtZ * k));
+    }
+  }
+  else
+  {
+    for(idx = 0; idx < count; ++idx)
+    {
+      double	k;
+
+      k = (double )(kol0 + idx);
+      posBuf[idx].vtX = org.vtX + (inc.vtX * k);
+      posBuf[idx].vtY = org.vtY + (inc.vtY * k);
+      posBuf[idx].vtZ = org.vtZ + (inc.vtZ * k);
+    }
+  }
+  if(rSrc && (interp == WLZ_INTERPOLATION_NEAREST))
+  {
+    for(idx = 0; idx < count; ++idx)
+    {
+      valBuf[idx] = WlzAffineTransformRectValue(rSrc,
+      						WLZ_NINT(posBuf[idx].vtZ),
+      						WLZ_NINT(posBuf[idx].vtY),
+      						WLZ_NINT(posBuf[idx].vtX));
+    }
+  }
+  else if(rSrc && (interp == WLZ_INTERPOLATION_LINEAR) &&
+          (rSrc->gType != WLZ_GREY_RGBA))
+  {
+    for(idx = 0; idx < count; ++idx)
+    {
+      int	iP;
+      double	v;
+      WlzIVertex3 p0;
+      WlzDVertex3 f;
+
+      p0.vtX = (int )floor(posBuf[idx].vtX);
+      p0.vtY = (int )floor(posBuf[idx].vtY);
+      p0.vtZ = (int )floor(posBuf[idx].vtZ);
+      f.vtX = posBuf[idx].vtX - p0.vtX;
+      f.vtY = posBuf[idx].vtY - p0.vtY;
+      f.vtZ = posBuf[idx].vtZ - p0.vtZ;
+      v = 0.0;
+      for(iP = 0; iP < ((rSrc->nPln > 1)? 2: 1); ++iP)
+      {
+	double	wP;
+
+	wP = (rSrc->nPln > 1)? ((iP)? f.vtZ: 1.0 - f.vtZ): 1.0;
+	v += wP * (((1.0 - f.vtY) *
+	            (((1.0 - f.vtX) *
+		      WlzAffineTransformRectValue(rSrc, p0.vtZ + iP,
+		                                  p0.vtY, p0.vtX)) +
+		     (f.vtX *
+		      WlzAffineTransformRectValue(rSrc, p0.vtZ + iP,
+		                                  p0.vtY, p0.vtX + 1)))) +
+		   (f.vtY *
+	            (((1.0 - f.vtX) *
+		      WlzAffineTransformRectValue(rSrc, p0.vtZ + iP,
+		                                  p0.vtY + 1, p0.vtX)) +
+		     (f.vtX *
+		      WlzAffineTransformRectValue(rSrc, p0.vtZ + iP,
+		                                  p0.vtY + 1, p0.vtX + 1)))));
+      }
+      valBuf[idx] = v;
+    }
+  }
+  else
+  {
+    errNum = WlzGreyValueGetN(gVWSp, interp, count, posBuf, valBuf);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gWSp->pixeltype)
+    {
+      case WLZ_GREY_INT:
+	{
+	  int	*dst;
+
+	  dst = gWSp->u_grintptr.inp;
+	  for(idx = 0; idx < count; ++idx)
+	  {
+	    double v;
+
+	    v = WLZ_CLAMP(valBuf[idx], (double )(INT_MIN), (double )(INT_MAX));
+	    dst[idx] = WLZ_NINT(v);
+	  }
+	}
+	break;
+      case WLZ_GREY_SHORT:
+	{
+	  short	*dst;
+
+	  dst = gWSp->u_grintptr.shp;
+	  for(idx = 0; idx < count; ++idx)
+	  {
+	    double v;
+
+	    v = WLZ_CLAMP(valBuf[idx], (double )(SHRT_MIN),
+	                  (double )(SHRT_MAX));
+	    dst[idx] = (short )WLZ_NINT(v);
+	  }
+	}
+	break;
+      case WLZ_GREY_UBYTE:
+	{
+	  WlzUByte *dst;
+
+	  dst = gWSp->u_grintptr.ubp;
+	  for(idx = 0; idx < count; ++idx)
+	  {
+	    double v;
+
+	    v = WLZ_CLAMP(valBuf[idx], 0.0, 255.0);
+	    dst[idx] = (WlzUByte )WLZ_NINT(v);
+	  }
+	}
+	break;
+      case WLZ_GREY_FLOAT:
+	{
+	  float	*dst;
+
+	  dst = gWSp->u_grintptr.flp;
+	  for(idx = 0; idx < count; ++idx)
+	  {
+	    dst[idx] = (float )WLZ_CLAMP(valBuf[idx], -FLT_MAX, FLT_MAX);
+	  }
+	}
+	break;
+      case WLZ_GREY_DOUBLE:
+	(void )memcpy(gWSp->u_grintptr.dbp, valBuf, sizeof(double) * count);
+	break;
+      case WLZ_GREY_RGBA:
+	{
+	  WlzUInt *dst;
+
+	  dst = gWSp->u_grintptr.rgbp;
+	  for(idx = 0; idx < count; ++idx)
+	  {
+	    dst[idx] = (WlzUInt )(valBuf[idx]);
+	  }
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \ingroup	WlzTransform
 * \return				Error number.
@@ -1128,7 +1638,8 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
 					     void *cbData,
 					     WlzAffineTransformCbFn cbFn)
 {
-  int		count, indx;
+  int		count, indx,
+		batch;
   double	tD0,
   		tD1,
                 tD2,
@@ -1143,6 +1654,11 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
 		lxyy,
 		lyyy;
   double	gTmp[4];
+  double	*valBuf = NULL;
+  WlzDVertex3	org,
+		inc;
+  WlzDVertex3	*posBuf = NULL;
+  WlzAffineTransformRectSrc *rSrc = NULL;
   WlzIVertex2	posI;
   WlzGreyType	newGreyType = WLZ_GREY_ERROR;
   WlzPixelV	bkdV;
@@ -1194,6 +1710,21 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
     {
       gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);	
     }
+    if((errNum == WLZ_ERR_NONE) && (interp != WLZ_INTERPOLATION_CALLBACK))
+    {
+      rSrc = WlzAffineTransformRectSrcMake(srcObj, newGreyType, bkdV);
+    }
+    batch = WlzAffineTransformBatchInterp(interp, rSrc);
+    if((errNum == WLZ_ERR_NONE) && batch)
+    {
+      count = newObj->domain.i->lastkl - newObj->domain.i->kol1 + 1;
+      if(((posBuf = (WlzDVertex3 *)
+                    AlcMalloc(sizeof(WlzDVertex3) * count)) == NULL) ||
+         ((valBuf = (double *)AlcMalloc(sizeof(double) * count)) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
     if(errNum == WLZ_ERR_NONE)
     {
       while((errNum == WLZ_ERR_NONE) &&
@@ -1204,7 +1735,18 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
 	lxyy = (sx * posI.vtY) + tx;
 	lyyy = (cy * posI.vtY) + ty;
 	count = iWSp.rgtpos - iWSp.lftpos + 1;
-	switch(interp)
+	if(batch)
+	{
+	  org.vtX = lxyy;
+	  org.vtY = lyyy;
+	  inc.vtX = cx;
+	  inc.vtY = sy;
+	  org.vtZ = inc.vtZ = 0.0;
+	  errNum = WlzAffineTransformItvValues(&gWSp, gVWSp, rSrc, interp, 0,
+	  				       count, posI.vtX, org, inc,
+					       posBuf, valBuf);
+	}
+	else switch(interp)
 	{
 	  case WLZ_INTERPOLATION_NEAREST:
 	    while(count-- > 0)
@@ -1407,6 +1949,9 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
     }
   }
   WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(posBuf);
+  AlcFree(valBuf);
+  AlcFree(rSrc);
   if(invTrans)
   {
     (void )WlzFreeAffineTransform(invTrans);
@@ -1414,11 +1959,420 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
   return(errNum);
 }
 
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Creates a new 2D value table for a single plane of the
+*		new object and fills in its values. The new object's
+*		voxel value table must already have been created. Planes
+*		are independent of each other, so different planes may
+*		be filled concurrently provided that each is given its
+*		own grey value work space and buffers.
+* \param	newObj			Partialy transformed object
+*					with a valid domain and voxel
+*					value table.
+* \param	rSrc			Rectangular value source for the
+* 					source object, may be NULL.
+* \param	idP			Index of the plane with respect to
+* 					the first plane of the new object.
+* \param	pln			Plane coordinate of the plane.
+* \param	invTrans		Inverse of the given affine
+* 					transform.
+* \param	gType			Grey type of the new values.
+* \param	bkdV			Background value.
+* \param	interp			Level of interpolation to use.
+* \param	batch			Non-zero if values are to be
+* 					computed using
+* 					WlzAffineTransformItvValues().
+* \param	gVWSp			Grey value work space for the
+* 					source object.
+* \param	posBuf			Position buffer with room for the
+* 					longest line of the new object,
+* 					only used if batch is non-zero.
+* \param	valBuf			Value buffer with room for the
+* 					longest line of the new object,
+* 					only used if batch is non-zero.
+* \param	cbData			Data passed to the directly to
+* 					the callback function.
+* \param	cbFn			Callback function.
+*/
+static WlzErrorNum WlzAffineTransformPlaneValues3(WlzObject *newObj,
+					WlzAffineTransformRectSrc *rSrc,
+					int idP, int pln,
+					WlzAffineTransform *invTrans,
+					WlzGreyType gType,
+					WlzPixelV bkdV,
+					WlzInterpolationType interp,
+					int batch,
+					WlzGreyValueWSpace *gVWSp,
+					WlzDVertex3 *posBuf,
+					double *valBuf,
+					void *cbData,
+					WlzAffineTransformCbFn cbFn)
+{
+  int		tI0,
+  		trunc,
+  		count;
+  double	tD0, x, y, z;
+  WlzIVertex3	sPos,
+		dPos;
+  WlzDVertex3	org,
+  		inc,
+		tDV0,
+  		tDV1;
+  WlzValues	tVal,
+  		emptyValues;
+  WlzObject 	*tObj0 = NULL;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzDomain	dom2D;
+  double	tMat[3][3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  emptyValues.core = NULL;
+  trunc = interp == WLZ_INTERPOLATION_NEAREST;
+  if(((dom2D = *(newObj->domain.p->domains + idP)).core != NULL) &&
+     (dom2D.core->type != WLZ_EMPTY_DOMAIN))
+  {
+    dPos.vtZ = pln;
+    tMat[0][0] = invTrans->mat[0][0];
+    tMat[1][0] = invTrans->mat[1][0];
+    tMat[2][0] = invTrans->mat[2][0];
+    tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
+    tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
+    tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
+    /* Make a 2D domain object for the plane. */
+    tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+	*(newObj->domain.p->domains + idP),
+	emptyValues, NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tVal.v = WlzNewValueTb(tObj0,
+			     WlzGreyTableType(WLZ_GREY_TAB_RAGR, gType,
+					      NULL),
+			     bkdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tObj0->values = WlzAssignValues(tVal, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      /* Fill in the values of the new 2D object. */
+      while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+      {
+	dPos.vtX = iWSp.lftpos;
+	dPos.vtY = iWSp.linpos;
+	tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
+	tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
+	tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
+	count = iWSp.rgtpos - iWSp.lftpos + 1;
+	if(batch)
+	{
+	  org.vtX = tMat[0][1];
+	  org.vtY = tMat[1][1];
+	  org.vtZ = tMat[2][1];
+	  inc.vtX = tMat[0][0];
+	  inc.vtY = tMat[1][0];
+	  inc.vtZ = tMat[2][0];
+	  errNum = WlzAffineTransformItvValues(&gWSp, gVWSp, rSrc, interp,
+					       trunc,
+					       count, dPos.vtX, org, inc,
+					       posBuf, valBuf);
+	}
+	else switch(interp)
+	{
+	  case WLZ_INTERPOLATION_NEAREST:
+	    while(count-- > 0)
+	    {
+	      sPos.vtX = (int )(tMat[0][1] +
+				(tMat[0][0] * (double )(dPos.vtX)));
+	      sPos.vtY = (int )(tMat[1][1] +
+				(tMat[1][0] * (double )(dPos.vtX)));
+	      sPos.vtZ = (int )(tMat[2][1] +
+				(tMat[2][0] * (double )(dPos.vtX)));
+	      WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
+			      (double )(sPos.vtY), (double )(sPos.vtX));
+	      switch(gWSp.pixeltype)
+	      {
+		case WLZ_GREY_INT:
+		  *(gWSp.u_grintptr.inp)++ = (*(gVWSp->gVal)).inv;
+		  break;
+		case WLZ_GREY_SHORT:
+		  *(gWSp.u_grintptr.shp)++ = (*(gVWSp->gVal)).shv;
+		  break;
+		case WLZ_GREY_UBYTE:
+		  *(gWSp.u_grintptr.ubp)++ = (*(gVWSp->gVal)).ubv;
+		  break;
+		case WLZ_GREY_FLOAT:
+		  *(gWSp.u_grintptr.flp)++ = (*(gVWSp->gVal)).flv;
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  *(gWSp.u_grintptr.dbp)++ = (*(gVWSp->gVal)).dbv;
+		  break;
+		case WLZ_GREY_RGBA:
+		  *(gWSp.u_grintptr.rgbp)++ = (*(gVWSp->gVal)).rgbv;
+		  break;
+		default:
+		  errNum = WLZ_ERR_GREY_TYPE;
+		  break;
+	      }
+	      ++(dPos.vtX);
+	    }
+	    break;
+	  case WLZ_INTERPOLATION_LINEAR:
+	    while(count-- > 0)
+	    {
+	      x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
+	      y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
+	      z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
+	      WlzGreyValueGetCon(gVWSp, z, y, x);
+	      tDV0.vtX = x - WLZ_NINT(x - 0.5);
+	      tDV0.vtY = y - WLZ_NINT(y - 0.5);
+	      tDV0.vtZ = z - WLZ_NINT(z - 0.5);
+	      tDV1.vtX = 1.0 - tDV0.vtX;
+	      tDV1.vtY = 1.0 - tDV0.vtY;
+	      tDV1.vtZ = 1.0 - tDV0.vtZ;
+	      switch(gWSp.pixeltype)
+	      {
+		case WLZ_GREY_INT:
+		  tD0 = ((gVWSp->gVal[0]).inv *
+		      tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[1]).inv *
+		     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[2]).inv *
+		     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[3]).inv *
+		     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[4]).inv *
+		     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[5]).inv *
+		     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[6]).inv *
+		     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[7]).inv *
+		     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0,
+				  (double )(INT_MIN), (double )(INT_MAX));
+		  tI0 = WLZ_NINT(tD0);
+		  *(gWSp.u_grintptr.inp)++ = tI0;
+		  break;
+		case WLZ_GREY_SHORT:
+		  tD0 = ((gVWSp->gVal[0]).shv *
+		      tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[1]).shv *
+		     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[2]).shv *
+		     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[3]).shv *
+		     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[4]).shv *
+		     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[5]).shv *
+		     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[6]).shv *
+		     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[7]).shv *
+		     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0,
+				  (double )(SHRT_MIN),
+				  (double )(SHRT_MAX));
+		  tI0 = WLZ_NINT(tD0);
+		  *(gWSp.u_grintptr.shp)++ = (short )tI0;
+		  break;
+		case WLZ_GREY_UBYTE:
+		  tD0 = ((gVWSp->gVal[0]).ubv *
+		      tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[1]).ubv *
+		     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[2]).ubv *
+		     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[3]).ubv *
+		     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[4]).ubv *
+		     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[5]).ubv *
+		     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[6]).ubv *
+		     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[7]).ubv *
+		     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		  tI0 = WLZ_NINT(tD0);
+		  *(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
+		  break;
+		case WLZ_GREY_FLOAT:
+		  tD0 = ((gVWSp->gVal[0]).flv *
+		      tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[1]).flv *
+		     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[2]).flv *
+		     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[3]).flv *
+		     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[4]).flv *
+		     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[5]).flv *
+		     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[6]).flv *
+		     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[7]).flv *
+		     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
+		  *(gWSp.u_grintptr.flp)++ = (float )tD0;
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  tD0 = ((gVWSp->gVal[0]).dbv *
+		      tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[1]).dbv *
+		     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[2]).dbv *
+		     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[3]).dbv *
+		     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+		    ((gVWSp->gVal[4]).dbv *
+		     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[5]).dbv *
+		     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[6]).dbv *
+		     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+		    ((gVWSp->gVal[7]).dbv *
+		     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  *(gWSp.u_grintptr.dbp)++ = tD0;
+		  break;
+		case WLZ_GREY_RGBA:
+		  tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		  tI0 = WLZ_NINT(tD0);
+		  WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
+				   (WlzUByte )tI0);
+		  tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		  tI0 = WLZ_NINT(tD0);
+		  WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
+				     (WlzUByte )tI0);
+		  tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		  tI0 = WLZ_NINT(tD0);
+		  WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
+				    (WlzUByte )tI0);
+		  tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
+			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
+			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
+			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+			(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
+			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+		  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		  tI0 = WLZ_NINT(tD0);
+		  WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
+		  ++(gWSp.u_grintptr.rgbp);
+		  break;
+		default:
+		  errNum = WLZ_ERR_GREY_TYPE;
+		  break;
+	      }
+	      ++(dPos.vtX);
+	    }
+	    break;
+	  case WLZ_INTERPOLATION_CALLBACK:
+	    errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
+			     dPos.vtZ, dPos.vtY);
+	    break;
+	  default:
+	    errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	    break;
+	}
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      *(newObj->values.vox->values + idP) =
+	WlzAssignValues(tObj0->values, NULL);
+    }
+    if(tObj0)
+    {
+      (void )WlzFreeObj(tObj0);
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \ingroup	WlzTransform
 * \return				Error number.
 * \brief	Creates new value, fills in the values and adds it
 *		to the given new object.
+*		For nearest neighbour interpolation and where the values
+*		can be computed using WlzAffineTransformItvValues() the
+*		planes are filled in concurrently, each thread having its
+*		own grey value work space. The callback function is always
+*		called from a single thread.
+*		Because this is a static function the parameters are
 *		not checked.
 * \param	newObj			Partialy transformed object
 *					with a valid domain.
@@ -1438,31 +2392,24 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
 					     void *cbData,
 					     WlzAffineTransformCbFn cbFn)
 {
-  int		tI0,
-  		count;
-  double	tD0, x, y, z;
-  WlzIVertex3	idx,
-  		sPos,
-		dPos;
-  WlzDVertex3	tDV0,
-  		tDV1;
+  int		idP,
+  		idT,
+  		nPln,
+		nThr = 1,
+		batch,
+		bufSz;
   WlzIBox3	bBox;
   WlzPixelV	bkdV;
-  WlzValues	tVal,
-  		dstValues,
-  		emptyValues;
-  WlzObject 	*tObj0;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzValues	dstValues;
   WlzAffineTransform *invTrans = NULL;
   WlzGreyType	gType;
-  WlzDomain	dom2D;
-  double	tMat[3][3];
+  double	**valBuf = NULL;
+  WlzDVertex3	**posBuf = NULL;
+  WlzGreyValueWSpace **gVWSp = NULL;
+  WlzAffineTransformRectSrc *rSrc = NULL;
   WlzErrorNum	errNum = WLZ_ERR_UNIMPLEMENTED;
 
   dstValues.core = NULL;
-  emptyValues.core = NULL;
   /* Make a new voxel value table. */
   bkdV = WlzGetBackground(srcObj, &errNum);
   if(errNum == WLZ_ERR_NONE)
@@ -1488,337 +2435,105 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
   {
     invTrans = WlzAffineTransformInverse(trans, &errNum);
   }
-  /* For each plane in the new object make a new value table and
-   * then fill it in. */
+  /* Allocate a grey value work space and buffers for each thread. */
   if(errNum == WLZ_ERR_NONE)
   {
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
+    if(interp != WLZ_INTERPOLATION_CALLBACK)
+    {
+      rSrc = WlzAffineTransformRectSrcMake(srcObj, gType, bkdV);
+    }
+    batch = WlzAffineTransformBatchInterp(interp, rSrc);
+#ifdef _OPENMP
+    if(batch || (interp == WLZ_INTERPOLATION_NEAREST))
+    {
+#pragma omp parallel
+      {
+#pragma omp master
+        {
+	  nThr = omp_get_num_threads();
+	}
+      }
+    }
+#endif
+    nPln = bBox.zMax - bBox.zMin + 1;
+    bufSz = bBox.xMax - bBox.xMin + 1;
+    if(((gVWSp = (WlzGreyValueWSpace **)
+                 AlcCalloc(nThr, sizeof(WlzGreyValueWSpace *))) == NULL) ||
+       ((posBuf = (WlzDVertex3 **)
+                  AlcCalloc(nThr, sizeof(WlzDVertex3 *))) == NULL) ||
+       ((valBuf = (double **)AlcCalloc(nThr, sizeof(double *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    idx.vtZ = 0;
-    dPos.vtZ = bBox.zMin;
-    tMat[0][0] = invTrans->mat[0][0];
-    tMat[1][0] = invTrans->mat[1][0];
-    tMat[2][0] = invTrans->mat[2][0];
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ <= bBox.zMax))
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
     {
-      if(((dom2D = *(newObj->domain.p->domains + idx.vtZ)).core != NULL) &&
-         (dom2D.core->type != WLZ_EMPTY_DOMAIN))
+      gVWSp[idT] = WlzGreyValueMakeWSp(srcObj, &errNum);
+      if((errNum == WLZ_ERR_NONE) && batch)
       {
-	tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
-	tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
-	tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
-	/* Make a 2D domain object for the plane. */
-	tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    *(newObj->domain.p->domains + idx.vtZ),
-	    emptyValues, NULL, NULL, &errNum);
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  tVal.v = WlzNewValueTb(tObj0,
-	  		         WlzGreyTableType(WLZ_GREY_TAB_RAGR, gType,
-				 		  NULL),
-				 bkdV, &errNum);
-	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  tObj0->values = WlzAssignValues(tVal, &errNum);
-	}
-	if(errNum == WLZ_ERR_NONE)
+        if(((posBuf[idT] = (WlzDVertex3 *)
+	                   AlcMalloc(sizeof(WlzDVertex3) * bufSz)) == NULL) ||
+	   ((valBuf[idT] = (double *)
+	                   AlcMalloc(sizeof(double) * bufSz)) == NULL))
 	{
-	  errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+	  errNum = WLZ_ERR_MEM_ALLOC;
 	}
-	if(errNum == WLZ_ERR_NONE)
+      }
+    }
+  }
+  /* For each plane in the new object make a new value table and
+   * then fill it in. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThr)
+#endif
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	thrId = 0;
+	WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	errNum2 = WlzAffineTransformPlaneValues3(newObj, rSrc,
+						 idP, bBox.zMin + idP,
+						 invTrans, gType, bkdV,
+						 interp, batch, gVWSp[thrId],
+						 posBuf[thrId], valBuf[thrId],
+						 cbData, cbFn);
+	if(errNum2 != WLZ_ERR_NONE)
 	{
-	  /* Fill in the values of the new 2D object. */
-	  while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+#ifdef _OPENMP
+#pragma omp critical (WlzAffineTransformValues3)
+#endif
 	  {
-	    dPos.vtX = iWSp.lftpos;
-	    dPos.vtY = iWSp.linpos;
-	    tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
-	    tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
-	    tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
-	    count = iWSp.rgtpos - iWSp.lftpos + 1;
-	    switch(interp)
+	    if(errNum == WLZ_ERR_NONE)
 	    {
-	      case WLZ_INTERPOLATION_NEAREST:
-		while(count-- > 0)
-		{
-		  sPos.vtX = (int )(tMat[0][1] +
-				    (tMat[0][0] * (double )(dPos.vtX)));
-		  sPos.vtY = (int )(tMat[1][1] +
-				    (tMat[1][0] * (double )(dPos.vtX)));
-		  sPos.vtZ = (int )(tMat[2][1] +
-				    (tMat[2][0] * (double )(dPos.vtX)));
-		  WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
-				  (double )(sPos.vtY), (double )(sPos.vtX));
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      *(gWSp.u_grintptr.inp)++ = (*(gVWSp->gVal)).inv;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      *(gWSp.u_grintptr.shp)++ = (*(gVWSp->gVal)).shv;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      *(gWSp.u_grintptr.ubp)++ = (*(gVWSp->gVal)).ubv;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      *(gWSp.u_grintptr.flp)++ = (*(gVWSp->gVal)).flv;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      *(gWSp.u_grintptr.dbp)++ = (*(gVWSp->gVal)).dbv;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      *(gWSp.u_grintptr.rgbp)++ = (*(gVWSp->gVal)).rgbv;
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_LINEAR:
-		while(count-- > 0)
-		{
-		  x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
-		  y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
-		  z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
-		  WlzGreyValueGetCon(gVWSp, z, y, x);
-		  tDV0.vtX = x - WLZ_NINT(x - 0.5);
-		  tDV0.vtY = y - WLZ_NINT(y - 0.5);
-		  tDV0.vtZ = z - WLZ_NINT(z - 0.5);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      tD0 = ((gVWSp->gVal[0]).inv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).inv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(INT_MIN), (double )(INT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.inp)++ = tI0;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      tD0 = ((gVWSp->gVal[0]).shv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).shv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(SHRT_MIN),
-				      (double )(SHRT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.shp)++ = (short )tI0;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      tD0 = ((gVWSp->gVal[0]).ubv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).ubv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      tD0 = ((gVWSp->gVal[0]).flv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).flv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		      *(gWSp.u_grintptr.flp)++ = (float )tD0;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      tD0 = ((gVWSp->gVal[0]).dbv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).dbv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      *(gWSp.u_grintptr.dbp)++ = tD0;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
-		                       (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
-		                         (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
-		                        (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
-		      ++(gWSp.u_grintptr.rgbp);
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_CALLBACK:
-		errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
-				 dPos.vtZ, dPos.vtY);
-		break;
-	      default:
-		errNum = WLZ_ERR_INTERPOLATION_TYPE;
-		break;
+	      errNum = errNum2;
 	    }
 	  }
-          (void )WlzEndGreyScan(&iWSp, &gWSp);
-	}
-	if(errNum == WLZ_ERR_EOO)
-	{
-	  errNum = WLZ_ERR_NONE;
-	}
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  *(newObj->values.vox->values + idx.vtZ) =
-	    WlzAssignValues(tObj0->values, NULL);
-	}
-	if(tObj0)
-	{
-	  (void )WlzFreeObj(tObj0);
 	}
       }
-      ++(idx.vtZ);
-      ++(dPos.vtZ);
     }
   }
-  WlzGreyValueFreeWSp(gVWSp);
+  if(gVWSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyValueFreeWSp(gVWSp[idT]);
+      AlcFree(posBuf[idT]);
+      AlcFree(valBuf[idT]);
+    }
+  }
+  AlcFree(gVWSp);
+  AlcFree(posBuf);
+  AlcFree(valBuf);
+  AlcFree(rSrc);
   if(invTrans)
   {
     (void )WlzFreeAffineTransform(invTrans);
@@ -3204,6 +3919,7 @@ WlzObject	*WlzAffineTransformObjCb(WlzObject *srcObj,
     {
       case WLZ_INTERPOLATION_NEAREST: /* FALLTHROUGH */
       case WLZ_INTERPOLATION_LINEAR: /* FALLTHROUGH */
+      case WLZ_INTERPOLATION_CUBIC: /* FALLTHROUGH */
       case WLZ_INTERPOLATION_CLASSIFY_1:
 	break;
       case WLZ_INTERPOLATION_CALLBACK:
@@ -2103,6 +2103,344 @@ WlzAffineTransform *WlzAffineTransformLSqDQ3D(int nV, double *vW,
   return(trans);
 }
 
+/*!
+* \ingroup	WlzTransform
+* \return	Computed affine transform, may be NULL on error.
+* \brief	Computes the affine transform which minimises the
+*		weighted sum of squared point to plane distances
+*		\f[
+		  \sum_{i=0}^{N-1}{w_i^2 ((\mathbf{T}\mathbf{p}_i -
+		                           {\mathbf{p}_i}') \cdot
+					  \mathbf{n}_i)^2}
+		\f]
+*		where \f${\mathbf{p}_i}'\f$ are the target vertices,
+*		\f$\mathbf{n}_i\f$ the target normals and
+*		\f$\mathbf{p}_i\f$ the source vertices. This is the
+*		error used by point to plane ICP, which converges in
+*		far fewer iterations than point to point ICP when
+*		surfaces slide over each other.
+*		The transform is parameterised as a small change
+*		about the weighted centroid of the source vertices:
+*		for registration transforms the rotation is linearised
+*		and then converted back to a rotation matrix, for affine
+*		transforms the change to the identity matrix is found
+*		directly. The linear system is solved by singular value
+*		decomposition so that any degrees of freedom which are
+*		not constrained by the normals (eg translation along a
+*		plane) are left unchanged.
+*		Translation, registration and general affine transforms
+*		are supported, all other transform types are treated as
+*		general affine.
+* \param	vType			Type of vertices and normals.
+* \param	nV			Number of vertex pairs.
+* \param	vT			Target vertices.
+* \param	nT			Target normals, which should be
+*					of unit length.
+* \param	vS			Source vertices.
+* \param	vW			Vertex pair weights, may be NULL
+*					in which case all weights are 1.
+* \param	trType			Required transform type.
+* \param	dstErr			Destination pointer for error
+*					number, may be NULL.
+*/
+WlzAffineTransform *WlzAffineTransformLSqPlane(WlzVertexType vType,
+				int nV, WlzVertexP vT, WlzVertexP nT,
+				WlzVertexP vS, double *vW,
+				WlzTransformType trType,
+				WlzErrorNum *dstErr)
+{
+  int		idV,
+  		idR,
+		idC,
+		nP = 0,
+		mode = 0;		  /* 0 translation, 1 reg, 2 affine */
+  double	wSq,
+  		rhs,
+		sumW = 0.0;
+  double	row[12],
+  		bV[12];
+  double	**aA,
+  		**trA = NULL;
+  WlzDVertex3	cen,
+  		rel,
+		crs,
+		tV3,
+		sV3,
+		nV3;
+  AlgMatrix	aM;
+  WlzAffineTransform *tr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	eps = 0.000000001;
+
+  aM.core = NULL;
+  WLZ_VTX_3_ZERO(cen);
+  if(nV <= 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((vT.v == NULL) || (nT.v == NULL) || (vS.v == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    switch(trType)
+    {
+      case WLZ_TRANSFORM_2D_TRANS: /* FALLTHROUGH */
+      case WLZ_TRANSFORM_3D_TRANS:
+        mode = 0;
+	break;
+      case WLZ_TRANSFORM_2D_REG: /* FALLTHROUGH */
+      case WLZ_TRANSFORM_3D_REG:
+        mode = 1;
+	break;
+      default:
+        mode = 2;
+	break;
+    }
+    switch(vType)
+    {
+      case WLZ_VERTEX_D2:
+        nP = (mode == 0)? 2: (mode == 1)? 3: 6;
+	break;
+      case WLZ_VERTEX_D3:
+        nP = (mode == 0)? 3: (mode == 1)? 6: 12;
+	break;
+      default:
+        errNum = WLZ_ERR_PARAM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((aM.rect = AlgMatrixRectNew(nP, nP, NULL)) == NULL) ||
+       (AlcDouble2Malloc(&trA, 4, 4) != ALC_ER_NONE))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Weighted centroid of the source vertices. */
+    for(idV = 0; idV < nV; ++idV)
+    {
+      wSq = (vW)? vW[idV] * vW[idV]: 1.0;
+      if(vType == WLZ_VERTEX_D2)
+      {
+	cen.vtX += wSq * vS.d2[idV].vtX;
+	cen.vtY += wSq * vS.d2[idV].vtY;
+      }
+      else /* vType == WLZ_VERTEX_D3 */
+      {
+	cen.vtX += wSq * vS.d3[idV].vtX;
+	cen.vtY += wSq * vS.d3[idV].vtY;
+	cen.vtZ += wSq * vS.d3[idV].vtZ;
+      }
+      sumW += wSq;
+    }
+    if(sumW < DBL_EPSILON)
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WLZ_VTX_3_SCALE(cen, cen, 1.0 / sumW);
+    /* Accumulate the normal equations, one row of the design matrix
+     * for each vertex pair. */
+    aA = aM.rect->array;
+    for(idR = 0; idR < nP; ++idR)
+    {
+      bV[idR] = 0.0;
+      for(idC = 0; idC < nP; ++idC)
+      {
+        aA[idR][idC] = 0.0;
+      }
+    }
+    for(idV = 0; idV < nV; ++idV)
+    {
+      wSq = (vW)? vW[idV] * vW[idV]: 1.0;
+      if(vType == WLZ_VERTEX_D2)
+      {
+        tV3.vtX = vT.d2[idV].vtX; tV3.vtY = vT.d2[idV].vtY; tV3.vtZ = 0.0;
+        sV3.vtX = vS.d2[idV].vtX; sV3.vtY = vS.d2[idV].vtY; sV3.vtZ = 0.0;
+        nV3.vtX = nT.d2[idV].vtX; nV3.vtY = nT.d2[idV].vtY; nV3.vtZ = 0.0;
+      }
+      else /* vType == WLZ_VERTEX_D3 */
+      {
+        tV3 = vT.d3[idV];
+	sV3 = vS.d3[idV];
+	nV3 = nT.d3[idV];
+      }
+      WLZ_VTX_3_SUB(rel, sV3, cen);
+      rhs = nV3.vtX * (tV3.vtX - sV3.vtX) + nV3.vtY * (tV3.vtY - sV3.vtY) +
+            nV3.vtZ * (tV3.vtZ - sV3.vtZ);
+      if(vType == WLZ_VERTEX_D2)
+      {
+        switch(mode)
+	{
+	  case 0:
+	    row[0] = nV3.vtX; row[1] = nV3.vtY;
+	    break;
+	  case 1:
+	    row[0] = nV3.vtY * rel.vtX - nV3.vtX * rel.vtY;
+	    row[1] = nV3.vtX; row[2] = nV3.vtY;
+	    break;
+	  default:
+	    row[0] = nV3.vtX * rel.vtX; row[1] = nV3.vtX * rel.vtY;
+	    row[2] = nV3.vtX;
+	    row[3] = nV3.vtY * rel.vtX; row[4] = nV3.vtY * rel.vtY;
+	    row[5] = nV3.vtY;
+	    break;
+	}
+      }
+      else /* vType == WLZ_VERTEX_D3 */
+      {
+        switch(mode)
+	{
+	  case 0:
+	    row[0] = nV3.vtX; row[1] = nV3.vtY; row[2] = nV3.vtZ;
+	    break;
+	  case 1:
+	    WLZ_VTX_3_CROSS(crs, rel, nV3);
+	    row[0] = crs.vtX; row[1] = crs.vtY; row[2] = crs.vtZ;
+	    row[3] = nV3.vtX; row[4] = nV3.vtY; row[5] = nV3.vtZ;
+	    break;
+	  default:
+	    row[0] = nV3.vtX * rel.vtX; row[1] = nV3.vtX * rel.vtY;
+	    row[2] = nV3.vtX * rel.vtZ; row[3] = nV3.vtX;
+	    row[4] = nV3.vtY * rel.vtX; row[5] = nV3.vtY * rel.vtY;
+	    row[6] = nV3.vtY * rel.vtZ; row[7] = nV3.vtY;
+	    row[8] = nV3.vtZ * rel.vtX; row[9] = nV3.vtZ * rel.vtY;
+	    row[10] = nV3.vtZ * rel.vtZ; row[11] = nV3.vtZ;
+	    break;
+	}
+      }
+      for(idR = 0; idR < nP; ++idR)
+      {
+        double	wR;
+
+	wR = wSq * row[idR];
+	bV[idR] += wR * rhs;
+	for(idC = idR; idC < nP; ++idC)
+	{
+	  aA[idR][idC] += wR * row[idC];
+	}
+      }
+    }
+    for(idR = 1; idR < nP; ++idR)
+    {
+      for(idC = 0; idC < idR; ++idC)
+      {
+        aA[idR][idC] = aA[idC][idR];
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVSolve(aM, bV, eps, NULL));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Build the matrix of the change about the centroid: T(p) = M(p - c) + c
+     * + t, then fold the centroid into the translation. */
+    for(idR = 0; idR < 4; ++idR)
+    {
+      for(idC = 0; idC < 4; ++idC)
+      {
+        trA[idR][idC] = (idR == idC)? 1.0: 0.0;
+      }
+    }
+    if(vType == WLZ_VERTEX_D2)
+    {
+      switch(mode)
+      {
+        case 0:
+	  trA[0][2] = bV[0]; trA[1][2] = bV[1];
+	  break;
+	case 1:
+	  trA[0][0] = cos(bV[0]); trA[0][1] = -sin(bV[0]);
+	  trA[1][0] = sin(bV[0]); trA[1][1] = cos(bV[0]);
+	  trA[0][2] = bV[1]; trA[1][2] = bV[2];
+	  break;
+	default:
+	  trA[0][0] += bV[0]; trA[0][1] += bV[1]; trA[0][2] = bV[2];
+	  trA[1][0] += bV[3]; trA[1][1] += bV[4]; trA[1][2] = bV[5];
+	  break;
+      }
+      for(idR = 0; idR < 2; ++idR)
+      {
+        trA[idR][2] += ((idR == 0)? cen.vtX: cen.vtY) -
+		       (trA[idR][0] * cen.vtX + trA[idR][1] * cen.vtY);
+      }
+      tr = WlzAffineTransformFromMatrix(WLZ_TRANSFORM_2D_AFFINE, trA,
+      					&errNum);
+    }
+    else /* vType == WLZ_VERTEX_D3 */
+    {
+      switch(mode)
+      {
+        case 0:
+	  trA[0][3] = bV[0]; trA[1][3] = bV[1]; trA[2][3] = bV[2];
+	  break;
+	case 1:
+	  {
+	    double	ang,
+	    		cA,
+			sA,
+			vA;
+	    WlzDVertex3	ax;
+
+	    /* Rodrigues' formula for the rotation about axis ax by angle
+	     * ang, with ang * ax the linearised rotation. */
+	    ax.vtX = bV[0]; ax.vtY = bV[1]; ax.vtZ = bV[2];
+	    ang = WLZ_VTX_3_LENGTH(ax);
+	    if(ang > DBL_EPSILON)
+	    {
+	      WLZ_VTX_3_SCALE(ax, ax, 1.0 / ang);
+	      cA = cos(ang);
+	      sA = sin(ang);
+	      vA = 1.0 - cA;
+	      trA[0][0] = cA + ax.vtX * ax.vtX * vA;
+	      trA[0][1] = ax.vtX * ax.vtY * vA - ax.vtZ * sA;
+	      trA[0][2] = ax.vtX * ax.vtZ * vA + ax.vtY * sA;
+	      trA[1][0] = ax.vtY * ax.vtX * vA + ax.vtZ * sA;
+	      trA[1][1] = cA + ax.vtY * ax.vtY * vA;
+	      trA[1][2] = ax.vtY * ax.vtZ * vA - ax.vtX * sA;
+	      trA[2][0] = ax.vtZ * ax.vtX * vA - ax.vtY * sA;
+	      trA[2][1] = ax.vtZ * ax.vtY * vA + ax.vtX * sA;
+	      trA[2][2] = cA + ax.vtZ * ax.vtZ * vA;
+	    }
+	    trA[0][3] = bV[3]; trA[1][3] = bV[4]; trA[2][3] = bV[5];
+	  }
+	  break;
+	default:
+	  for(idR = 0; idR < 3; ++idR)
+	  {
+	    for(idC = 0; idC < 3; ++idC)
+	    {
+	      trA[idR][idC] += bV[(4 * idR) + idC];
+	    }
+	    trA[idR][3] = bV[(4 * idR) + 3];
+	  }
+	  break;
+      }
+      for(idR = 0; idR < 3; ++idR)
+      {
+        trA[idR][3] += ((idR == 0)? cen.vtX: (idR == 1)? cen.vtY: cen.vtZ) -
+		       (trA[idR][0] * cen.vtX + trA[idR][1] * cen.vtY +
+		        trA[idR][2] * cen.vtZ);
+      }
+      tr = WlzAffineTransformFromMatrix(WLZ_TRANSFORM_3D_AFFINE, trA,
+      					&errNum);
+    }
+  }
+  AlgMatrixFree(aM);
+  (void )AlcDouble2Free(trA);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tr);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzTransform
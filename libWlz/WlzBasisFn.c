@@ -60,6 +60,100 @@ typedef struct	_WlzBasisFnMapData3D
   WlzCMeshNod3D *nod[4];
 } WlzBasisFnMapData3D;
 
+/*!
+* \def		WLZ_BASISFN_ITR_MINPTS
+* \ingroup	WlzFunction
+* \brief	Minimum number of control points for which the multiquadric,
+* 		inverse multiquadric and thin plate spline basis function
+* 		coefficients are computed using the iterative solver
+* 		rather than the singular value decomposition of the
+* 		dense design matrix.
+*/
+#define WLZ_BASISFN_ITR_MINPTS	(1000)
+
+/*!
+* \def		WLZ_BASISFN_ITR_BLKSZ
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points in the core of a
+* 		preconditioner block of the iterative solver.
+*/
+#define WLZ_BASISFN_ITR_BLKSZ	(32)
+
+/*!
+* \def		WLZ_BASISFN_ITR_OVLSZ
+* \ingroup	WlzFunction
+* \brief	Number of neighbouring control points added to the core
+* 		of each preconditioner block of the iterative solver.
+*/
+#define WLZ_BASISFN_ITR_OVLSZ	(32)
+
+/*!
+* \def		WLZ_BASISFN_ITR_TOL
+* \ingroup	WlzFunction
+* \brief	Relative residual tolerance of the iterative solver.
+*/
+#define WLZ_BASISFN_ITR_TOL	(1.0e-12)
+
+/*!
+* \def		WLZ_BASISFN_ITR_MAXITR
+* \ingroup	WlzFunction
+* \brief	Maximum number of iterations of the iterative solver.
+*/
+#define WLZ_BASISFN_ITR_MAXITR	(1000)
+
+/*!
+* \struct	_WlzBasisFnItrEnt
+* \ingroup	WlzFunction
+* \brief	A control point and it's index, used while partitioning
+* 		the control points into the blocks of the iterative
+* 		solver's preconditioner.
+*/
+typedef struct _WlzBasisFnItrEnt
+{
+  WlzDVertex3	pos;
+  int		idx;
+} WlzBasisFnItrEnt;
+
+/*!
+* \struct	_WlzBasisFnItr
+* \ingroup	WlzFunction
+* \brief	Iterative solver for the design equations of radial
+* 		basis functions with many control points.
+* 		The matrix of basis function values is never stored,
+* 		instead the system restricted to the complement of the
+* 		polynomial is solved using the matrix free
+* 		preconditioned conjugate gradient method, with an
+* 		additive Schwarz preconditioner built from the
+* 		inverses of the design matrices of small overlapping
+* 		blocks of neighbouring control points.
+*/
+typedef struct _WlzBasisFnItr
+{
+  WlzFnType	type;			/*!< Basis function type. */
+  int		nPts;			/*!< Number of control points. */
+  int		nPoly;			/*!< Number of polynomial terms. */
+  double	delta;			/*!< Basis function delta. */
+  WlzDVertex3	*pos;			/*!< Control points in the
+  					     coordinates of the design
+					     equation. */
+  double	*qV;			/*!< Orthonormal basis for the
+  					     polynomial, nPoly vectors
+					     each of nPts values. */
+  double	rM[16];			/*!< Upper triangular factor of
+  					     the polynomial, with
+					     polynomial values = Q R. */
+  int		nBlk;			/*!< Number of preconditioner
+  					     blocks. */
+  int		*blkOff;		/*!< Offsets of the blocks'
+  					     control point indices. */
+  int		*blkIdx;		/*!< Block control point indices. */
+  double	**blkInv;		/*!< Block inverse matrices. */
+  double	*tV;			/*!< Workspace vector. */
+  double	*xV;			/*!< Solution vector. */
+  double	*bV;			/*!< Right hand side vector. */
+  AlgMatrix	wM;			/*!< Conjugate gradient workspace. */
+} WlzBasisFnItr;
+
 static void			WlzBasisFnEditSV(
 				  int n,
 				  double *vV);
@@ -140,6 +234,67 @@ static WlzHistogramDomain 	*WlzBasisFnScalarMOS3DEvalTb(
 				  double delta,
 				  double tau,
 				  WlzErrorNum *dstErr);
+static void			WlzBasisFnItrFree(
+				  WlzBasisFnItr *itr);
+static void			WlzBasisFnItrProj(
+				  WlzBasisFnItr *itr,
+				  double *vV);
+static void			WlzBasisFnItrPhiMul(
+				  WlzBasisFnItr *itr,
+				  double *xV,
+				  double *yV);
+static void			WlzBasisFnItrMul(
+				  void *dat,
+				  double *xV,
+				  double *yV);
+static void			WlzBasisFnItrPre(
+				  void *dat,
+				  double *rV,
+				  double *zV);
+static int			WlzBasisFnItrPart(
+				  WlzBasisFnItrEnt *ent,
+				  int idx,
+				  int nPts,
+				  int *blkOff);
+static int			WlzBasisFnItrEntCmpX(
+				  const void *p0,
+				  const void *p1);
+static int			WlzBasisFnItrEntCmpY(
+				  const void *p0,
+				  const void *p1);
+static int			WlzBasisFnItrEntCmpZ(
+				  const void *p0,
+				  const void *p1);
+static int			WlzBasisFnItrEntCmpXYZ(
+				  const void *p0,
+				  const void *p1);
+static double			WlzBasisFnItrPhi(
+				  WlzFnType type,
+				  double delta,
+				  double r2);
+static WlzErrorNum		WlzBasisFnItrSolve(
+				  WlzBasisFnItr *itr,
+				  double *bV);
+static WlzErrorNum		WlzBasisFnItrSolveAll(
+				  WlzBasisFnItr *itr,
+				  WlzVertexType vType,
+				  WlzVertexP dPts,
+				  WlzVertexP sPts,
+				  double *sV);
+static WlzErrorNum		WlzBasisFnItrBlkInv(
+				  WlzBasisFnItr *itr,
+				  int nB,
+				  int *idx,
+				  double *inv);
+static WlzBasisFnItr		*WlzBasisFnItrMake(
+				  WlzFnType type,
+				  int nPts,
+				  WlzVertexType vType,
+				  WlzVertexP vtx,
+				  WlzDVertex3 org,
+				  double scale,
+				  double delta,
+				  WlzErrorNum *dstErr);
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzFunction
@@ -158,6 +313,7 @@ WlzErrorNum	WlzBasisFnFree(WlzBasisFn *basisFn)
     AlcFree(basisFn->vertices.v);
     AlcFree(basisFn->sVertices.v);
     AlcFree(basisFn->param);
+    WlzBasisFnTreeFree(basisFn->tree);
     if((basisFn->evalData != NULL))
     {
       (void )WlzFreeHistogramDomain(basisFn->evalData);
@@ -291,23 +447,38 @@ WlzDVertex2 	WlzBasisFnValueMQ2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if((basisFn->tree != NULL) && (basisFn->distFn == NULL))
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
+    WlzDVertex3	tV0,
+    		tV1;
+
+    tV0.vtX = srcVx.vtX;
+    tV0.vtY = srcVx.vtY;
+    tV0.vtZ = 0.0;
+    tV1 = WlzBasisFnTreeSum(basisFn->tree, tV0);
+    newVx.vtX = tV1.vtX;
+    newVx.vtY = tV1.vtY;
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      }
+      tD0 = sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -345,25 +516,32 @@ WlzDVertex3 	WlzBasisFnValueMQ3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
   cPts    = basisFn->vertices.d3;
   basisCo = basisFn->basis.d3;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if((basisFn->tree != NULL) && (basisFn->distFn == NULL))
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD2 = srcVx.vtZ - cPts->vtZ;
-      tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
-    }
-    else
+    newVx = WlzBasisFnTreeSum(basisFn->tree, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD2 = srcVx.vtZ - cPts->vtZ;
+        tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      }
+      tD0 = sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    newVx.vtZ += basisCo->vtZ * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -398,23 +576,38 @@ WlzDVertex2 	WlzBasisFnValueIMQ2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if((basisFn->tree != NULL) && (basisFn->distFn == NULL))
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
+    WlzDVertex3	tV0,
+    		tV1;
+
+    tV0.vtX = srcVx.vtX;
+    tV0.vtY = srcVx.vtY;
+    tV0.vtZ = 0.0;
+    tV1 = WlzBasisFnTreeSum(basisFn->tree, tV0);
+    newVx.vtX = tV1.vtX;
+    newVx.vtY = tV1.vtY;
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+      }
+      tD0 = 1.0 / sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = 1.0 / sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -452,25 +645,32 @@ WlzDVertex3 	WlzBasisFnValueIMQ3D(WlzBasisFn *basisFn, WlzDVertex3 srcVx)
   cPts    = basisFn->vertices.d3;
   basisCo = basisFn->basis.d3;
   delta = *((double *)(basisFn->param));
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if((basisFn->tree != NULL) && (basisFn->distFn == NULL))
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD2 = srcVx.vtZ - cPts->vtZ;
-      tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
-    }
-    else
+    newVx = WlzBasisFnTreeSum(basisFn->tree, srcVx);
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD2 = srcVx.vtZ - cPts->vtZ;
+        tD0 = (tD0 * tD0) + (tD1 * tD1) + (tD2 * tD2);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, &mapData);
+      }
+      tD0 = 1.0 / sqrt(tD0 + delta);
+      newVx.vtX += basisCo->vtX * tD0;
+      newVx.vtY += basisCo->vtY * tD0;
+      newVx.vtZ += basisCo->vtZ * tD0;
+      ++cPts;
+      ++basisCo;
     }
-    tD0 = 1.0 / sqrt(tD0 + delta);
-    newVx.vtX += basisCo->vtX * tD0;
-    newVx.vtY += basisCo->vtY * tD0;
-    newVx.vtZ += basisCo->vtZ * tD0;
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly3D(basisFn->poly.d3, srcVx);
   newVx.vtX = newVx.vtX + polyVx.vtX;
@@ -503,27 +703,42 @@ WlzDVertex2 	WlzBasisFnValueTPS2D(WlzBasisFn *basisFn, WlzDVertex2 srcVx)
   newVx.vtY = 0.0;
   cPts = basisFn->vertices.d2;
   basisCo = basisFn->basis.d2;
-  for(idx = 0; idx < basisFn->nVtx; ++idx)
+  if((basisFn->tree != NULL) && (basisFn->distFn == NULL))
   {
-    if(basisFn->distFn == NULL)
-    {
-      tD0 = srcVx.vtX - cPts->vtX;
-      tD1 = srcVx.vtY - cPts->vtY;
-      tD0 = (tD0 * tD0) + (tD1 * tD1);
-    }
-    else
-    {
-      tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
-      tD0 *= tD0;
-    }
-    if(tD0 > DBL_EPSILON)
+    WlzDVertex3	tV0,
+    		tV1;
+
+    tV0.vtX = srcVx.vtX;
+    tV0.vtY = srcVx.vtY;
+    tV0.vtZ = 0.0;
+    tV1 = WlzBasisFnTreeSum(basisFn->tree, tV0);
+    newVx.vtX = tV1.vtX;
+    newVx.vtY = tV1.vtY;
+  }
+  else
+  {
+    for(idx = 0; idx < basisFn->nVtx; ++idx)
     {
-      tD0 *= log(tD0);
-      newVx.vtX += basisCo->vtX * tD0;
-      newVx.vtY += basisCo->vtY * tD0;
+      if(basisFn->distFn == NULL)
+      {
+        tD0 = srcVx.vtX - cPts->vtX;
+        tD1 = srcVx.vtY - cPts->vtY;
+        tD0 = (tD0 * tD0) + (tD1 * tD1);
+      }
+      else
+      {
+        tD0 = basisFn->distFn(basisFn, idx, sPt, NULL);
+        tD0 *= tD0;
+      }
+      if(tD0 > DBL_EPSILON)
+      {
+        tD0 *= log(tD0);
+        newVx.vtX += basisCo->vtX * tD0;
+        newVx.vtY += basisCo->vtY * tD0;
+      }
+      ++cPts;
+      ++basisCo;
     }
-    ++cPts;
-    ++basisCo;
   }
   polyVx = WlzBasisFnValueRedPoly2D(basisFn->poly.d2, srcVx);
   newVx.vtX = (newVx.vtX * 0.5) + polyVx.vtX;
@@ -2040,7 +2255,7 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
                 tD2,
 		deltaRg,
 		deltaSq,
-		range;
+		range = 1.0;
   double	*bV = NULL,
   		*wV = NULL;
   double	**aA;
@@ -2049,12 +2264,21 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   WlzVertex	sPt;
   WlzDVertex3	tDVx0;
   WlzDBox3	extentDB;
+  int		useItr = 0;
+  double	*sV = NULL;
+  WlzVertexP	dVtxP,
+  		sVtxP;
+  WlzDVertex3	org;
+  WlzBasisFnItr	*itr = NULL;
   WlzBasisFn    *newBasisFn = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const int	stepVx = 10;
 
   aM.core = NULL;
   vM.core = NULL;
+  extentDB.xMin = extentDB.xMax = 0.0;
+  extentDB.yMin = extentDB.yMax = 0.0;
+  extentDB.zMin = extentDB.zMax = 0.0;
   nSys = nPts + 4;
   deltaSq = delta * delta;
   if(mesh != NULL)
@@ -2218,18 +2442,16 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate matrices for solving basis function the design equation. */
-    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
-       ((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL) ||
-       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
-       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    /* Allocate the right hand side vector of the design equation, the
+     * dense matrices are only allocated if the direct solver is used. */
+    useItr = (newBasisFn->distMap == NULL) && (nPts >= WLZ_BASISFN_ITR_MINPTS);
+    if((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    aA = aM.rect->array;
     WlzBasisFnVxExtent3D(&extentDB, dPts, sPts, nPts);
     tD0 = extentDB.xMax - extentDB.xMin;
     tD1 = extentDB.yMax - extentDB.yMin;
@@ -2254,7 +2476,58 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       WlzValueCopyDVertexToDVertex3(newBasisFn->sVertices.d3, sPts, nPts);
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && useItr)
+  {
+    newBasisFn->nPoly = 2;
+    newBasisFn->nBasis = nPts;
+    deltaRg = deltaSq * range * range;
+    *((double *)(newBasisFn->param)) = deltaRg;
+    /* Make the iterative solver and solve for the basis function
+     * weights and polynomial coefficients of all components. If the
+     * design equation is singular (eg coincident control points) or the
+     * iterative solver fails to converge then fall back to the direct
+     * solver. */
+    org.vtX = extentDB.xMin;
+    org.vtY = extentDB.yMin;
+    org.vtZ = extentDB.zMin;
+    dVtxP.d3 = dPts;
+    sVtxP.d3 = sPts;
+    if((sV = (double *)AlcMalloc(sizeof(double) * 3 * nSys)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      itr = WlzBasisFnItrMake(WLZ_FN_BASIS_3DMQ, nPts, WLZ_VERTEX_D3, dVtxP,
+                              org, range, delta, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzBasisFnItrSolveAll(itr, WLZ_VERTEX_D3, dVtxP, sVtxP, sV);
+    }
+    WlzBasisFnItrFree(itr);
+    if((errNum == WLZ_ERR_ALG_SINGULAR) ||
+       (errNum == WLZ_ERR_ALG_CONVERGENCE))
+    {
+      useItr = 0;
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
+  {
+    /* Allocate matrices for solving the basis function design equation. */
+    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
+       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
+       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      aA = aM.rect->array;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
   {
     newBasisFn->nPoly = 2;
     newBasisFn->nBasis = nPts;
@@ -2322,10 +2595,17 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Edit the singular values. */
-    WlzBasisFnEditSV(nSys, wV);
-    /* Solve for lambda and the X polynomial coefficients. */
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV, nSys);
+    }
+    else
+    {
+      /* Edit the singular values. */
+      WlzBasisFnEditSV(nSys, wV);
+      /* Solve for lambda and the X polynomial coefficients. */
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -2342,7 +2622,14 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       idY4 = idY + 4;
       *(bV + idY4) = (sPts + idY)->vtY - (dPts + idY)->vtY;
     }
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV + nSys, nSys);
+    }
+    else
+    {
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
 
   if(errNum == WLZ_ERR_NONE)
@@ -2360,7 +2647,14 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       idY4 = idY + 4;
       *(bV + idY4) = (sPts + idY)->vtZ - (dPts + idY)->vtZ;
     }
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV + 2 * nSys, nSys);
+    }
+    else
+    {
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -2368,6 +2662,7 @@ WlzBasisFn *WlzBasisFnMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
     WlzBasisFnMQCoeff3D(newBasisFn, bV,  &extentDB, range,
     			2, (newBasisFn->distFn)? 0: 1);
   }
+  AlcFree(sV);
   AlcFree(bV);
   AlcFree(wV);
   (void )AlgMatrixFree(aM);
@@ -2792,7 +3087,7 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 		tD1,
                 tD2,
 		deltaSq,
-		range;
+		range = 1.0;
   double	*bV = NULL,
   		*wV = NULL;
   double	**aA;
@@ -2801,6 +3096,12 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   WlzVertex	sPt;
   WlzDVertex3	tDVx0;
   WlzDBox3	extentDB;
+  int		useItr = 0;
+  double	*sV = NULL;
+  WlzVertexP	dVtxP,
+  		sVtxP;
+  WlzDVertex3	org;
+  WlzBasisFnItr	*itr = NULL;
   WlzBasisFn    *newBasisFn = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const int	stepVx = 10;
@@ -2817,6 +3118,9 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
 #endif /* WLZ_BASISFN_DELTA_ENV */
   aM.core = NULL;
   vM.core = NULL;
+  extentDB.xMin = extentDB.xMax = 0.0;
+  extentDB.yMin = extentDB.yMax = 0.0;
+  extentDB.zMin = extentDB.zMax = 0.0;
   nSys = nPts + 4;
   if(mesh != NULL)
   {
@@ -2994,18 +3298,16 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate matrices for solving basis function the design equation. */
-    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
-       ((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL) ||
-       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
-       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    /* Allocate the right hand side vector of the design equation, the
+     * dense matrices are only allocated if the direct solver is used. */
+    useItr = (newBasisFn->distMap == NULL) && (nPts >= WLZ_BASISFN_ITR_MINPTS);
+    if((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    aA = aM.rect->array;
     WlzBasisFnVxExtent3D(&extentDB, dPts, sPts, nPts);
     tD0 = extentDB.xMax - extentDB.xMin;
     tD1 = extentDB.yMax - extentDB.yMin;
@@ -3032,7 +3334,55 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       WlzValueCopyDVertexToDVertex3(newBasisFn->sVertices.d3, sPts, nPts);
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && useItr)
+  {
+    newBasisFn->nPoly = 2;
+    newBasisFn->nBasis = nPts;
+    *((double *)(newBasisFn->param)) = deltaSq;
+    /* Make the iterative solver and solve for the basis function
+     * weights and polynomial coefficients of all components. If the
+     * design equation is singular (eg coincident control points) or the
+     * iterative solver fails to converge then fall back to the direct
+     * solver. */
+    WLZ_VTX_3_ZERO(org);
+    dVtxP.d3 = dPts;
+    sVtxP.d3 = sPts;
+    if((sV = (double *)AlcMalloc(sizeof(double) * 3 * nSys)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      itr = WlzBasisFnItrMake(WLZ_FN_BASIS_3DIMQ, nPts, WLZ_VERTEX_D3, dVtxP,
+                              org, 1.0, delta, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzBasisFnItrSolveAll(itr, WLZ_VERTEX_D3, dVtxP, sVtxP, sV);
+    }
+    WlzBasisFnItrFree(itr);
+    if((errNum == WLZ_ERR_ALG_SINGULAR) ||
+       (errNum == WLZ_ERR_ALG_CONVERGENCE))
+    {
+      useItr = 0;
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
+  {
+    /* Allocate matrices for solving the basis function design equation. */
+    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
+       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
+       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      aA = aM.rect->array;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
   {
     newBasisFn->nPoly = 2;
     newBasisFn->nBasis = nPts;
@@ -3091,12 +3441,19 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Edit the singular values. */
-    WlzBasisFnEditSV(nSys, wV);
-    /* Solve for lambda and the X polynomial coefficients. */
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
-  }
-  if(errNum == WLZ_ERR_NONE)
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV, nSys);
+    }
+    else
+    {
+      /* Edit the singular values. */
+      WlzBasisFnEditSV(nSys, wV);
+      /* Solve for lambda and the X polynomial coefficients. */
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     /* Recover lambda and the x polynomial coefficients, then set up for mu
      * and the y polynomial coefficients. */
@@ -3110,7 +3467,14 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       idY4 = idY + 4;
       *(bV + idY4) = (sPts + idY)->vtY - (dPts + idY)->vtY;
     }
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV + nSys, nSys);
+    }
+    else
+    {
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
 
   if(errNum == WLZ_ERR_NONE)
@@ -3127,13 +3491,21 @@ WlzBasisFn *WlzBasisFnIMQ3DFromCPts(int nPts, WlzDVertex3 *dPts,
       idY4 = idY + 4;
       *(bV + idY4) = (sPts + idY)->vtZ - (dPts + idY)->vtZ;
     }
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV + 2 * nSys, nSys);
+    }
+    else
+    {
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
     /* Recover nu and the z polynomial coefficients. */
     WlzBasisFnMQCoeff3D(newBasisFn, bV,  &extentDB, range, 2, 0);
   }
+  AlcFree(sV);
   AlcFree(bV);
   AlcFree(wV);
   AlgMatrixFree(aM);
@@ -3192,7 +3564,7 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
                 newMaxVx;
   double	tD0,
 		tD1,
-		range;
+		range = 1.0;
   double	*bV = NULL,
   		*wV = NULL;
   double	**aA;
@@ -3201,12 +3573,20 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
   WlzVertex	sPt;
   WlzDVertex2	tDVx0;
   WlzDBox2	extentDB;
+  int		useItr = 0;
+  double	*sV = NULL;
+  WlzVertexP	dVtxP,
+  		sVtxP;
+  WlzDVertex3	org;
+  WlzBasisFnItr	*itr = NULL;
   WlzBasisFn    *newBasisFn = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const int     stepVx = 10;
 
   aM.core = NULL;
   vM.core = NULL;
+  extentDB.xMin = extentDB.xMax = 0.0;
+  extentDB.yMin = extentDB.yMax = 0.0;
   nSys = nPts + 3;
   if(mesh != NULL)
   {
@@ -3363,18 +3743,16 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Allocate matrices for solving basis function the design equation. */
-    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
-       ((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL) ||
-       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
-       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    /* Allocate the right hand side vector of the design equation, the
+     * dense matrices are only allocated if the direct solver is used. */
+    useItr = (newBasisFn->distFn == NULL) && (nPts >= WLZ_BASISFN_ITR_MINPTS);
+    if((bV = (double *)AlcMalloc(sizeof(double) * nSys)) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    aA = aM.rect->array;
     WlzBasisFnVxExtent2D(&extentDB, dPts, sPts, nPts);
     tD0 = extentDB.xMax - extentDB.xMin;
     tD1 = extentDB.yMax - extentDB.yMin;
@@ -3394,7 +3772,56 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
       WlzValueCopyDVertexToDVertex(newBasisFn->sVertices.d2, sPts, nPts);
     }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if((errNum == WLZ_ERR_NONE) && useItr)
+  {
+    newBasisFn->nPoly = 2;
+    newBasisFn->nBasis = nPts;
+    /* Make the iterative solver and solve for the basis function
+     * weights and polynomial coefficients of all components. If the
+     * design equation is singular (eg coincident control points) or the
+     * iterative solver fails to converge then fall back to the direct
+     * solver. */
+    org.vtX = extentDB.xMin;
+    org.vtY = extentDB.yMin;
+    org.vtZ = 0.0;
+    dVtxP.d2 = dPts;
+    sVtxP.d2 = sPts;
+    if((sV = (double *)AlcMalloc(sizeof(double) * 2 * nSys)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      itr = WlzBasisFnItrMake(WLZ_FN_BASIS_2DTPS, nPts, WLZ_VERTEX_D2, dVtxP,
+                              org, range, 0.0, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzBasisFnItrSolveAll(itr, WLZ_VERTEX_D2, dVtxP, sVtxP, sV);
+    }
+    WlzBasisFnItrFree(itr);
+    if((errNum == WLZ_ERR_ALG_SINGULAR) ||
+       (errNum == WLZ_ERR_ALG_CONVERGENCE))
+    {
+      useItr = 0;
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
+  {
+    /* Allocate matrices for solving the basis function design equation. */
+    if(((wV = (double *)AlcCalloc(sizeof(double), nSys)) == NULL) ||
+       ((vM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL) ||
+       ((aM.rect = AlgMatrixRectNew(nSys, nSys, NULL)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      aA = aM.rect->array;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !useItr)
   {
     newBasisFn->nPoly = 2;
     newBasisFn->nBasis = nPts;
@@ -3447,10 +3874,17 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Edit the singular values. */
-    WlzBasisFnEditSV(nSys, wV);
-    /* Solve for lambda and the X polynomial coefficients. */
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV, nSys);
+    }
+    else
+    {
+      /* Edit the singular values. */
+      WlzBasisFnEditSV(nSys, wV);
+      /* Solve for lambda and the X polynomial coefficients. */
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -3462,12 +3896,20 @@ WlzBasisFn *WlzBasisFnTPS2DFromCPts(int nPts,
     {
       *(bV + idY + 3) = (sPts + idY)->vtY - (dPts + idY)->vtY;
     }
-    errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    if(useItr)
+    {
+      AlgVectorCopy(bV, sV + nSys, nSys);
+    }
+    else
+    {
+      errNum = WlzErrorFromAlg(AlgMatrixSVBackSub(aM, wV, vM, bV));
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
     WlzBasisFnTPS2DCoef(newBasisFn, bV,  &extentDB, range, 0);
   }
+  AlcFree(sV);
   AlcFree(bV);
   AlcFree(wV);
   AlgMatrixFree(aM);
@@ -4486,3 +4928,925 @@ static void	WlzBasisFnEditSV(int n, double *vV)
     }
   }
 }
+
+/*!
+* \return	New iterative solver or NULL on error.
+* \ingroup	WlzFunction
+* \brief	Makes an iterative solver for the design equation of a
+* 		multiquadric, inverse multiquadric or thin plate spline
+* 		radial basis function with Euclidean distances.
+* 		The control points are transformed into the
+* 		coordinates of the design equation using
+* 		\f$\mathbf{x'} = (\mathbf{x} - \mathbf{o})/s\f$, with
+* 		the basis function values given by WlzBasisFnItrPhi().
+* 		The control points are partitioned into blocks by
+* 		recursively splitting them at the median of the longest
+* 		side of their bounding box, each block is then extended
+* 		by it's nearest neighbouring control points and the
+* 		inverse of the block's design matrix (restricted to the
+* 		basis function weights) is computed for use as the
+* 		preconditioner.
+* 		The memory used is linear in the number of control points.
+* 		If any control points are coincident the design equation
+* 		is singular, no solver is made and the error
+* 		WLZ_ERR_ALG_SINGULAR is returned.
+* \param	type			Basis function type, which must be
+* 					one of WLZ_FN_BASIS_3DMQ,
+* 					WLZ_FN_BASIS_3DIMQ or
+* 					WLZ_FN_BASIS_2DTPS.
+* \param	nPts			Number of control points.
+* \param	vType			Control point vertex type, which must
+* 					be either WLZ_VERTEX_D2 or
+* 					WLZ_VERTEX_D3.
+* \param	vtx			Control points.
+* \param	org			Origin \f$\mathbf{o}\f$.
+* \param	scale			Scale \f$s\f$.
+* \param	delta			Basis function delta.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzBasisFnItr		*WlzBasisFnItrMake(
+				  WlzFnType type,
+				  int nPts,
+				  WlzVertexType vType,
+				  WlzVertexP vtx,
+				  WlzDVertex3 org,
+				  double scale,
+				  double delta,
+				  WlzErrorNum *dstErr)
+{
+  int		idN,
+		idK,
+		nLeaf = 0,
+		maxLeaf = 0;
+  int		*leafOff = NULL;
+  WlzBasisFnItrEnt *ent = NULL;
+  WlzBasisFnItr	*itr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((nPts <= 0) || (scale < DBL_EPSILON) ||
+     ((vType != WLZ_VERTEX_D2) && (vType != WLZ_VERTEX_D3)))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    maxLeaf = (2 * nPts / WLZ_BASISFN_ITR_BLKSZ) + 2;
+    if(((itr = (WlzBasisFnItr *)
+               AlcCalloc(1, sizeof(WlzBasisFnItr))) == NULL) ||
+       ((itr->pos = (WlzDVertex3 *)
+		    AlcMalloc(nPts * sizeof(WlzDVertex3))) == NULL) ||
+       ((itr->qV = (double *)AlcMalloc(4 * nPts * sizeof(double))) == NULL) ||
+       ((itr->tV = (double *)AlcMalloc(nPts * sizeof(double))) == NULL) ||
+       ((itr->xV = (double *)AlcMalloc(nPts * sizeof(double))) == NULL) ||
+       ((itr->bV = (double *)AlcMalloc(nPts * sizeof(double))) == NULL) ||
+       ((itr->wM.rect = AlgMatrixRectNew(4, nPts, NULL)) == NULL) ||
+       ((ent = (WlzBasisFnItrEnt *)
+               AlcMalloc(nPts * sizeof(WlzBasisFnItrEnt))) == NULL) ||
+       ((leafOff = (int *)AlcMalloc((maxLeaf + 1) * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    itr->type = type;
+    itr->nPts = nPts;
+    itr->nPoly = (vType == WLZ_VERTEX_D2)? 3: 4;
+    itr->delta = delta;
+    for(idN = 0; idN < nPts; ++idN)
+    {
+      WlzDVertex3 p;
+
+      if(vType == WLZ_VERTEX_D2)
+      {
+        p.vtX = vtx.d2[idN].vtX;
+        p.vtY = vtx.d2[idN].vtY;
+	p.vtZ = org.vtZ;
+      }
+      else
+      {
+        p = vtx.d3[idN];
+      }
+      WLZ_VTX_3_SUB(p, p, org);
+      WLZ_VTX_3_SCALE(itr->pos[idN], p, 1.0 / scale);
+      ent[idN].pos = itr->pos[idN];
+      ent[idN].idx = idN;
+    }
+    /* Compute an orthonormal basis for the polynomial using (twice
+     * applied) Gram-Schmidt orthogonalisation, columns which are linearly
+     * dependent on previous columns are set to zero. */
+    for(idK = 0; idK < itr->nPoly; ++idK)
+    {
+      int	idJ,
+      		pass;
+      double	nrm0,
+      		nrm1;
+      double	*q;
+
+      q = itr->qV + idK * nPts;
+      for(idN = 0; idN < nPts; ++idN)
+      {
+        q[idN] = (idK == 0)? 1.0: (&(itr->pos[idN].vtX))[idK - 1];
+      }
+      nrm0 = sqrt(AlgVectorDot(q, q, nPts));
+      for(idJ = 0; idJ < 4; ++idJ)
+      {
+        itr->rM[idJ * 4 + idK] = 0.0;
+      }
+      for(pass = 0; pass < 2; ++pass)
+      {
+	for(idJ = 0; idJ < idK; ++idJ)
+	{
+	  double	d;
+	  double	*qJ;
+
+	  qJ = itr->qV + idJ * nPts;
+	  d = AlgVectorDot(q, qJ, nPts);
+	  AlgVectorScaleAdd(q, qJ, q, -d, nPts);
+	  itr->rM[idJ * 4 + idK] += d;
+	}
+      }
+      nrm1 = sqrt(AlgVectorDot(q, q, nPts));
+      if(nrm1 > 1.0e-09 * nrm0)
+      {
+        AlgVectorScale(q, q, 1.0 / nrm1, nPts);
+	itr->rM[idK * 4 + idK] = nrm1;
+      }
+      else
+      {
+        AlgVectorZero(q, nPts);
+      }
+    }
+    /* Check for coincident control points, for which the design equation
+     * is singular. */
+    qsort(ent, nPts, sizeof(WlzBasisFnItrEnt), WlzBasisFnItrEntCmpXYZ);
+    for(idN = 1; idN < nPts; ++idN)
+    {
+      if(WlzBasisFnItrEntCmpXYZ(ent + idN - 1, ent + idN) == 0)
+      {
+        errNum = WLZ_ERR_ALG_SINGULAR;
+	break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Partition the control points. */
+    nLeaf = WlzBasisFnItrPart(ent, 0, nPts, leafOff);
+    leafOff[nLeaf] = nPts;
+    itr->nBlk = nLeaf;
+    if(((itr->blkOff = (int *)AlcMalloc((nLeaf + 1) * sizeof(int))) == NULL) ||
+       ((itr->blkInv = (double **)
+                       AlcCalloc(nLeaf, sizeof(double *))) == NULL) ||
+       ((itr->blkIdx = (int *)
+                       AlcMalloc(nLeaf *
+		                 (WLZ_BASISFN_ITR_BLKSZ +
+				  WLZ_BASISFN_ITR_OVLSZ) *
+				 sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idB;
+
+    /* Set the offsets of the blocks' indices. */
+    itr->blkOff[0] = 0;
+    for(idB = 0; idB < nLeaf; ++idB)
+    {
+      int	nC;
+
+      nC = leafOff[idB + 1] - leafOff[idB];
+      itr->blkOff[idB + 1] = itr->blkOff[idB] + nC +
+                             ALG_MIN(WLZ_BASISFN_ITR_OVLSZ, nPts - nC);
+    }
+    /* Find the neighbours of each block and compute the block's inverse
+     * design matrix. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idB = 0; idB < nLeaf; ++idB)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	idE,
+		idO,
+		nC,
+		nO,
+		nB;
+	int	*idx;
+	double	ovlD[WLZ_BASISFN_ITR_OVLSZ];
+	WlzDBox3 box;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	nC = leafOff[idB + 1] - leafOff[idB];
+	nB = itr->blkOff[idB + 1] - itr->blkOff[idB];
+	nO = nB - nC;
+	idx = itr->blkIdx + itr->blkOff[idB];
+	box.xMin = box.yMin = box.zMin = DBL_MAX;
+	box.xMax = box.yMax = box.zMax = -DBL_MAX;
+	for(idE = 0; idE < nC; ++idE)
+	{
+	  WlzBasisFnItrEnt *e;
+
+	  e = ent + leafOff[idB] + idE;
+	  idx[idE] = e->idx;
+	  box.xMin = ALG_MIN(box.xMin, e->pos.vtX);
+	  box.xMax = ALG_MAX(box.xMax, e->pos.vtX);
+	  box.yMin = ALG_MIN(box.yMin, e->pos.vtY);
+	  box.yMax = ALG_MAX(box.yMax, e->pos.vtY);
+	  box.zMin = ALG_MIN(box.zMin, e->pos.vtZ);
+	  box.zMax = ALG_MAX(box.zMax, e->pos.vtZ);
+	}
+	/* Find the nO control points nearest to the block's bounding box,
+	 * maintaining them in order of increasing distance. */
+	for(idO = 0; idO < nO; ++idO)
+	{
+	  ovlD[idO] = DBL_MAX;
+	}
+	for(idE = 0; idE < nPts; ++idE)
+	{
+	  if((idE < leafOff[idB]) || (idE >= leafOff[idB + 1]))
+	  {
+	    double	d,
+		  	d2;
+	    WlzBasisFnItrEnt *e;
+
+	    e = ent + idE;
+	    d = ALG_MAX3(box.xMin - e->pos.vtX, e->pos.vtX - box.xMax, 0.0);
+	    d2 = d * d;
+	    d = ALG_MAX3(box.yMin - e->pos.vtY, e->pos.vtY - box.yMax, 0.0);
+	    d2 += d * d;
+	    d = ALG_MAX3(box.zMin - e->pos.vtZ, e->pos.vtZ - box.zMax, 0.0);
+	    d2 += d * d;
+	    if(d2 < ovlD[nO - 1])
+	    {
+	      idO = nO - 1;
+	      while((idO > 0) && (ovlD[idO - 1] > d2))
+	      {
+		ovlD[idO] = ovlD[idO - 1];
+		idx[nC + idO] = idx[nC + idO - 1];
+		--idO;
+	      }
+	      ovlD[idO] = d2;
+	      idx[nC + idO] = e->idx;
+	    }
+	  }
+	}
+	if((itr->blkInv[idB] = (double *)
+	                       AlcMalloc(nB * nB * sizeof(double))) == NULL)
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  errNum2 = WlzBasisFnItrBlkInv(itr, nB, idx, itr->blkInv[idB]);
+	}
+#ifdef _OPENMP
+#pragma omp critical (WlzBasisFnItrMake)
+	{
+#endif
+	  if((errNum == WLZ_ERR_NONE) && (errNum2 != WLZ_ERR_NONE))
+	  {
+	    errNum = errNum2;
+	  }
+#ifdef _OPENMP
+	}
+#endif
+      }
+    }
+  }
+  AlcFree(ent);
+  AlcFree(leafOff);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzBasisFnItrFree(itr);
+    itr = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(itr);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Frees an iterative solver.
+* \param	itr			Given iterative solver, may be NULL.
+*/
+static void			WlzBasisFnItrFree(
+				  WlzBasisFnItr *itr)
+{
+  int		idB;
+
+  if(itr)
+  {
+    if(itr->blkInv)
+    {
+      for(idB = 0; idB < itr->nBlk; ++idB)
+      {
+        AlcFree(itr->blkInv[idB]);
+      }
+      AlcFree(itr->blkInv);
+    }
+    AlcFree(itr->blkOff);
+    AlcFree(itr->blkIdx);
+    AlcFree(itr->pos);
+    AlcFree(itr->qV);
+    AlcFree(itr->tV);
+    AlcFree(itr->xV);
+    AlcFree(itr->bV);
+    (void )AlgMatrixFree(itr->wM);
+    AlcFree(itr);
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Solves the design equation for the basis function weights
+* 		and polynomial coefficients. On entry the given vector
+* 		has the same layout as the right hand side of the dense
+* 		design equation, ie nPoly zeros followed by the nPts
+* 		control point displacements. On return it holds the
+* 		polynomial coefficients followed by the basis function
+* 		weights, as would the solution of the dense design
+* 		equation.
+* 		The weights \f$\lambda\f$ are found by solving
+* 		\f$\Pi \Phi \Pi \lambda = \Pi \mathbf{b}\f$, where
+* 		\f$\Pi = I - Q Q^T\f$ is the projection onto the
+* 		complement of the polynomial, using the preconditioned
+* 		conjugate gradient method. The polynomial coefficients
+* 		are then given by \f$R^{-1} Q^T(\mathbf{b} - \Phi\lambda)\f$.
+* \param	itr			Given iterative solver.
+* \param	bV			Right hand side / solution vector.
+*/
+static WlzErrorNum		WlzBasisFnItrSolve(
+				  WlzBasisFnItr *itr,
+				  double *bV)
+{
+  int		idK,
+		idJ,
+		nItr = 0;
+  double	resid = 0.0;
+  double	gV[4];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  AlgVectorCopy(itr->bV, bV + itr->nPoly, itr->nPts);
+  WlzBasisFnItrProj(itr, itr->bV);
+  AlgVectorZero(itr->xV, itr->nPts);
+  errNum = WlzErrorFromAlg(
+  	   AlgMatrixCGSolveFn(itr->nPts, WlzBasisFnItrMul, itr,
+			      itr->xV, itr->bV, itr->wM,
+			      WlzBasisFnItrPre, itr,
+			      WLZ_BASISFN_ITR_TOL, WLZ_BASISFN_ITR_MAXITR,
+			      &resid, &nItr));
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The weights are the projection of the solution, since the
+     * preconditioner need not preserve the complement of the
+     * polynomial. Recover the polynomial coefficients from the residual
+     * of the basis functions. */
+    WlzBasisFnItrProj(itr, itr->xV);
+    WlzBasisFnItrPhiMul(itr, itr->xV, itr->bV);
+    AlgVectorSub(itr->bV, bV + itr->nPoly, itr->bV, itr->nPts);
+    for(idK = 0; idK < itr->nPoly; ++idK)
+    {
+      gV[idK] = AlgVectorDot(itr->qV + idK * itr->nPts, itr->bV, itr->nPts);
+    }
+    for(idK = itr->nPoly - 1; idK >= 0; --idK)
+    {
+      double	r;
+
+      r = itr->rM[idK * 4 + idK];
+      if(r > DBL_EPSILON)
+      {
+	for(idJ = idK + 1; idJ < itr->nPoly; ++idJ)
+	{
+	  gV[idK] -= itr->rM[idK * 4 + idJ] * bV[idJ];
+	}
+	bV[idK] = gV[idK] / r;
+      }
+      else
+      {
+        bV[idK] = 0.0;
+      }
+    }
+    AlgVectorCopy(bV + itr->nPoly, itr->xV, itr->nPts);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Solves the design equations for all components of the
+* 		control point displacements using WlzBasisFnItrSolve().
+* 		The solutions are stored consecutively in the given
+* 		buffer, each with the layout of the solution of the
+* 		dense design equation.
+* \param	itr			Given iterative solver.
+* \param	vType			Control point vertex type, which must
+* 					be either WLZ_VERTEX_D2 or
+* 					WLZ_VERTEX_D3.
+* \param	dPts			Destination control points.
+* \param	sPts			Source control points.
+* \param	sV			Buffer for the solutions, with room
+* 					for nPoly - 1 solutions each of
+* 					nPoly + nPts values.
+*/
+static WlzErrorNum		WlzBasisFnItrSolveAll(
+				  WlzBasisFnItr *itr,
+				  WlzVertexType vType,
+				  WlzVertexP dPts,
+				  WlzVertexP sPts,
+				  double *sV)
+{
+  int		idC,
+		idN;
+  double	*bV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < itr->nPoly - 1); ++idC)
+  {
+    bV = sV + idC * (itr->nPoly + itr->nPts);
+    for(idN = 0; idN < itr->nPoly; ++idN)
+    {
+      bV[idN] = 0.0;
+    }
+    for(idN = 0; idN < itr->nPts; ++idN)
+    {
+      WlzDVertex3 d;
+
+      if(vType == WLZ_VERTEX_D2)
+      {
+        d.vtX = sPts.d2[idN].vtX - dPts.d2[idN].vtX;
+        d.vtY = sPts.d2[idN].vtY - dPts.d2[idN].vtY;
+	d.vtZ = 0.0;
+      }
+      else
+      {
+        WLZ_VTX_3_SUB(d, sPts.d3[idN], dPts.d3[idN]);
+      }
+      bV[itr->nPoly + idN] = (idC == 0)? d.vtX: (idC == 1)? d.vtY: d.vtZ;
+    }
+    errNum = WlzBasisFnItrSolve(itr, bV);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Projects the given vector onto the complement of the
+* 		polynomial, \f$\mathbf{v} = (I - Q Q^T) \mathbf{v}\f$.
+* \param	itr			Given iterative solver.
+* \param	vV			Vector to project.
+*/
+static void			WlzBasisFnItrProj(
+				  WlzBasisFnItr *itr,
+				  double *vV)
+{
+  int		idK;
+
+  for(idK = 0; idK < itr->nPoly; ++idK)
+  {
+    double	d;
+    double	*q;
+
+    q = itr->qV + idK * itr->nPts;
+    d = AlgVectorDot(q, vV, itr->nPts);
+    AlgVectorScaleAdd(vV, q, vV, -d, itr->nPts);
+  }
+}
+
+/*!
+* \return	Basis function value.
+* \ingroup	WlzFunction
+* \brief	Computes the value of a radial basis function for the
+* 		given squared distance, exactly as in the dense design
+* 		equations.
+* \param	type			Basis function type.
+* \param	delta			Basis function delta.
+* \param	r2			Squared distance.
+*/
+static double			WlzBasisFnItrPhi(
+				  WlzFnType type,
+				  double delta,
+				  double r2)
+{
+  double	v = 0.0;
+
+  switch(type)
+  {
+    case WLZ_FN_BASIS_3DMQ:
+      v = (r2 > DBL_EPSILON)? sqrt(r2 + delta * delta): delta;
+      break;
+    case WLZ_FN_BASIS_3DIMQ:
+      v = (r2 > DBL_EPSILON)? 1.0 / sqrt(r2 + delta * delta): 1.0 / delta;
+      break;
+    case WLZ_FN_BASIS_2DTPS:
+      v = (r2 > DBL_EPSILON)? r2 * log(r2): 0.0;
+      break;
+    default:
+      break;
+  }
+  return(v);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Computes \f$\mathbf{y} = \Phi \mathbf{x}\f$ without
+* 		storing the matrix \f$\Phi\f$ of basis function values.
+* \param	itr			Given iterative solver.
+* \param	xV			Given vector.
+* \param	yV			Destination vector.
+*/
+static void			WlzBasisFnItrPhiMul(
+				  WlzBasisFnItr *itr,
+				  double *xV,
+				  double *yV)
+{
+  int		idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idI = 0; idI < itr->nPts; ++idI)
+  {
+    int		idJ;
+    double	s = 0.0;
+    WlzDVertex3	p,
+    		d;
+
+    p = itr->pos[idI];
+    switch(itr->type)
+    {
+      case WLZ_FN_BASIS_3DMQ:
+	{
+	  double dSq;
+
+	  dSq = itr->delta * itr->delta;
+	  for(idJ = 0; idJ < itr->nPts; ++idJ)
+	  {
+	    WLZ_VTX_3_SUB(d, p, itr->pos[idJ]);
+	    s += xV[idJ] * sqrt(WLZ_VTX_3_SQRLEN(d) + dSq);
+	  }
+	}
+        break;
+      case WLZ_FN_BASIS_3DIMQ:
+	{
+	  double dSq;
+
+	  dSq = itr->delta * itr->delta;
+	  for(idJ = 0; idJ < itr->nPts; ++idJ)
+	  {
+	    WLZ_VTX_3_SUB(d, p, itr->pos[idJ]);
+	    s += xV[idJ] / sqrt(WLZ_VTX_3_SQRLEN(d) + dSq);
+	  }
+	}
+        break;
+      default:
+	for(idJ = 0; idJ < itr->nPts; ++idJ)
+	{
+	  WLZ_VTX_3_SUB(d, p, itr->pos[idJ]);
+	  s += xV[idJ] * WlzBasisFnItrPhi(itr->type, itr->delta,
+	                                  WLZ_VTX_3_SQRLEN(d));
+	}
+        break;
+    }
+    yV[idI] = s;
+  }
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Matrix multiplication function for AlgMatrixCGSolveFn()
+* 		which computes \f$\mathbf{y} = \Pi \Phi \Pi \mathbf{x}\f$.
+* \param	dat			The iterative solver.
+* \param	xV			Given vector.
+* \param	yV			Destination vector.
+*/
+static void			WlzBasisFnItrMul(
+				  void *dat,
+				  double *xV,
+				  double *yV)
+{
+  WlzBasisFnItr	*itr;
+
+  itr = (WlzBasisFnItr *)dat;
+  AlgVectorCopy(itr->tV, xV, itr->nPts);
+  WlzBasisFnItrProj(itr, itr->tV);
+  WlzBasisFnItrPhiMul(itr, itr->tV, yV);
+  WlzBasisFnItrProj(itr, yV);
+}
+
+/*!
+* \ingroup	WlzFunction
+* \brief	Preconditioning function for AlgMatrixCGSolveFn()
+* 		which sums the block inverses applied to the given
+* 		residual vector.
+* \param	dat			The iterative solver.
+* \param	rV			Given residual vector.
+* \param	zV			Destination vector.
+*/
+static void			WlzBasisFnItrPre(
+				  void *dat,
+				  double *rV,
+				  double *zV)
+{
+  int		idB;
+  WlzBasisFnItr	*itr;
+
+  itr = (WlzBasisFnItr *)dat;
+  AlgVectorZero(zV, itr->nPts);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idB = 0; idB < itr->nBlk; ++idB)
+  {
+    int		idI,
+    		idJ,
+		nB;
+    int		*idx;
+    double	*inv;
+
+    nB = itr->blkOff[idB + 1] - itr->blkOff[idB];
+    idx = itr->blkIdx + itr->blkOff[idB];
+    inv = itr->blkInv[idB];
+    for(idI = 0; idI < nB; ++idI)
+    {
+      double	s = 0.0;
+
+      for(idJ = 0; idJ < nB; ++idJ)
+      {
+        s += *inv++ * rV[idx[idJ]];
+      }
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      zV[idx[idI]] += s;
+    }
+  }
+  WlzBasisFnItrProj(itr, zV);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Computes the inverse of the design matrix for a block
+* 		of control points restricted to the basis function weights,
+* 		ie the upper left nB x nB sub-matrix of the pseudo inverse
+* 		of the block's design matrix. The pseudo inverse is computed
+* 		using singular value decomposition with the singular values
+* 		edited as for the dense design equation.
+* \param	itr			Given iterative solver.
+* \param	nB			Number of control points in the block.
+* \param	idx			Indices of the block's control points.
+* \param	inv			Destination for the nB x nB inverse.
+*/
+static WlzErrorNum		WlzBasisFnItrBlkInv(
+				  WlzBasisFnItr *itr,
+				  int nB,
+				  int *idx,
+				  double *inv)
+{
+  int		idI,
+		idJ,
+		idK,
+		nP,
+		nS;
+  double	scale = 0.0;
+  double	*wV = NULL;
+  double	**aA;
+  WlzDVertex3	cen;
+  AlgMatrix	aM,
+  		vM;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  aM.core = NULL;
+  vM.core = NULL;
+  nP = itr->nPoly;
+  nS = nB + nP;
+  if(((wV = (double *)AlcMalloc(nS * sizeof(double))) == NULL) ||
+     ((aM.rect = AlgMatrixRectNew(nS, nS, NULL)) == NULL) ||
+     ((vM.rect = AlgMatrixRectNew(nS, nS, NULL)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The polynomial is centred and scaled to the block, this does not
+     * change the inverse restricted to the weights but does improve the
+     * condition of the block's design matrix. */
+    WLZ_VTX_3_ZERO(cen);
+    for(idI = 0; idI < nB; ++idI)
+    {
+      WLZ_VTX_3_ADD(cen, cen, itr->pos[idx[idI]]);
+    }
+    WLZ_VTX_3_SCALE(cen, cen, 1.0 / nB);
+    for(idI = 0; idI < nB; ++idI)
+    {
+      WlzDVertex3 d;
+
+      WLZ_VTX_3_SUB(d, itr->pos[idx[idI]], cen);
+      scale = ALG_MAX(scale, WLZ_VTX_3_SQRLEN(d));
+    }
+    scale = (scale > DBL_EPSILON)? 1.0 / sqrt(scale): 1.0;
+    aA = aM.rect->array;
+    for(idI = 0; idI < nP; ++idI)
+    {
+      for(idJ = 0; idJ < nP; ++idJ)
+      {
+        aA[idI][idJ] = 0.0;
+      }
+    }
+    for(idI = 0; idI < nB; ++idI)
+    {
+      WlzDVertex3 p,
+      		  d;
+
+      p = itr->pos[idx[idI]];
+      WLZ_VTX_3_SUB(d, p, cen);
+      WLZ_VTX_3_SCALE(d, d, scale);
+      for(idK = 0; idK < nP; ++idK)
+      {
+        aA[nP + idI][idK] = aA[idK][nP + idI] =
+	    (idK == 0)? 1.0: (&(d.vtX))[idK - 1];
+      }
+      for(idJ = 0; idJ <= idI; ++idJ)
+      {
+	WLZ_VTX_3_SUB(d, p, itr->pos[idx[idJ]]);
+        aA[nP + idI][nP + idJ] = aA[nP + idJ][nP + idI] =
+	    WlzBasisFnItrPhi(itr->type, itr->delta, WLZ_VTX_3_SQRLEN(d));
+      }
+    }
+    errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(aM, wV, vM));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    double	**uA,
+    		**vA;
+
+    WlzBasisFnEditSV(nS, wV);
+    for(idK = 0; idK < nS; ++idK)
+    {
+      wV[idK] = (wV[idK] > DBL_EPSILON)? 1.0 / wV[idK]: 0.0;
+    }
+    /* A^+ = V W^+ U^T, symmetrised. */
+    uA = aM.rect->array;
+    vA = vM.rect->array;
+    for(idI = 0; idI < nB; ++idI)
+    {
+      for(idJ = 0; idJ <= idI; ++idJ)
+      {
+        double	s0 = 0.0,
+		s1 = 0.0;
+
+	for(idK = 0; idK < nS; ++idK)
+	{
+	  s0 += vA[nP + idI][idK] * wV[idK] * uA[nP + idJ][idK];
+	  s1 += vA[nP + idJ][idK] * wV[idK] * uA[nP + idI][idK];
+	}
+	inv[idI * nB + idJ] = inv[idJ * nB + idI] = 0.5 * (s0 + s1);
+      }
+    }
+  }
+  AlcFree(wV);
+  (void )AlgMatrixFree(aM);
+  (void )AlgMatrixFree(vM);
+  return(errNum);
+}
+
+/*!
+* \return	Number of blocks.
+* \ingroup	WlzFunction
+* \brief	Recursively partitions the given control points into
+* 		blocks by splitting them at the median of the longest
+* 		side of their bounding box, until each block has no more
+* 		than WLZ_BASISFN_ITR_BLKSZ control points.
+* \param	ent			Control points, which are reordered.
+* \param	idx			Index of the first control point.
+* \param	nPts			Number of control points.
+* \param	blkOff			Destination for the offsets of the
+* 					blocks.
+*/
+static int			WlzBasisFnItrPart(
+				  WlzBasisFnItrEnt *ent,
+				  int idx,
+				  int nPts,
+				  int *blkOff)
+{
+  int		idN,
+  		n0,
+  		nBlk;
+  WlzDBox3	box;
+
+  if(nPts <= WLZ_BASISFN_ITR_BLKSZ)
+  {
+    *blkOff = idx;
+    nBlk = 1;
+  }
+  else
+  {
+    box.xMin = box.xMax = ent[idx].pos.vtX;
+    box.yMin = box.yMax = ent[idx].pos.vtY;
+    box.zMin = box.zMax = ent[idx].pos.vtZ;
+    for(idN = idx + 1; idN < idx + nPts; ++idN)
+    {
+      box.xMin = ALG_MIN(box.xMin, ent[idN].pos.vtX);
+      box.xMax = ALG_MAX(box.xMax, ent[idN].pos.vtX);
+      box.yMin = ALG_MIN(box.yMin, ent[idN].pos.vtY);
+      box.yMax = ALG_MAX(box.yMax, ent[idN].pos.vtY);
+      box.zMin = ALG_MIN(box.zMin, ent[idN].pos.vtZ);
+      box.zMax = ALG_MAX(box.zMax, ent[idN].pos.vtZ);
+    }
+    box.xMax -= box.xMin;
+    box.yMax -= box.yMin;
+    box.zMax -= box.zMin;
+    qsort(ent + idx, nPts, sizeof(WlzBasisFnItrEnt),
+	  ((box.xMax >= box.yMax) && (box.xMax >= box.zMax))?
+	  WlzBasisFnItrEntCmpX:
+	  (box.yMax >= box.zMax)? WlzBasisFnItrEntCmpY: WlzBasisFnItrEntCmpZ);
+    n0 = nPts / 2;
+    nBlk = WlzBasisFnItrPart(ent, idx, n0, blkOff);
+    nBlk += WlzBasisFnItrPart(ent, idx + n0, nPts - n0, blkOff + nBlk);
+  }
+  return(nBlk);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares iterative solver entries by their x coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnItrEntCmpX(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnItrEnt *)p0)->pos.vtX - ((WlzBasisFnItrEnt *)p1)->pos.vtX;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares iterative solver entries by their y coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnItrEntCmpY(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnItrEnt *)p0)->pos.vtY - ((WlzBasisFnItrEnt *)p1)->pos.vtY;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares iterative solver entries by their z coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnItrEntCmpZ(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnItrEnt *)p0)->pos.vtZ - ((WlzBasisFnItrEnt *)p1)->pos.vtZ;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares iterative solver entries by their x, then y and
+* 		then z coordinates.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnItrEntCmpXYZ(
+				  const void *p0,
+				  const void *p1)
+{
+  int		cmp;
+
+  if((cmp = WlzBasisFnItrEntCmpX(p0, p1)) == 0)
+  {
+    if((cmp = WlzBasisFnItrEntCmpY(p0, p1)) == 0)
+    {
+      cmp = WlzBasisFnItrEntCmpZ(p0, p1);
+    }
+  }
+  return(cmp);
+}
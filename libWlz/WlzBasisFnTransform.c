@@ -94,6 +94,50 @@ WlzErrorNum	WlzBasisFnFreeTransform(WlzBasisFnTransform *basisTr)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzTransform
+* \brief	Selects either exact or approximate evaluation of the
+*		given basis function transform. With a tolerance greater
+*		than zero the basis function is evaluated using a tree
+*		of control point clusters (see WlzBasisFnTreeMake()),
+*		which reduces the cost of evaluating the transform at
+*		many positions from being proportional to the number of
+*		control points to roughly proportional to it's logarithm,
+*		while the displacement error is bounded by the tolerance.
+*		Approximate evaluation is only available for multiquadric,
+*		inverse multiquadric and thin plate spline transforms which
+*		use Euclidean distances. A tolerance of zero selects exact
+*		evaluation.
+* \param	basisTr			Given basis function transform.
+* \param	tol			Maximum absolute displacement error,
+*					zero for exact evaluation.
+*/
+WlzErrorNum	WlzBasisFnTransformSetTol(WlzBasisFnTransform *basisTr,
+					  double tol)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisTr == NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_NULL;
+  }
+  else if((basisTr->type != WLZ_TRANSFORM_2D_BASISFN) &&
+          (basisTr->type != WLZ_TRANSFORM_3D_BASISFN))
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if(tol < 0.0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    errNum = WlzBasisFnSetTree(basisTr->basisFn, tol);
+  }
+  return(errNum);
+}
+
 /*!
 * \return	New basis function transform.
 * \ingroup	WlzTransform
@@ -523,6 +567,14 @@ WlzErrorNum	WlzBasisFnTPS2DChangeCPtsParam(WlzBasisFnTransform *basisTr,
 	 break;
     }
   }
+  if((errNum == WLZ_ERR_NONE) && (basisTr->basisFn->tree != NULL))
+  {
+    errNum = WlzBasisFnSetTree(newBasisFn, basisTr->basisFn->tree->tol);
+    if(errNum != WLZ_ERR_NONE)
+    {
+      (void )WlzBasisFnFree(newBasisFn);
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     (void )WlzBasisFnFree(basisTr->basisFn);
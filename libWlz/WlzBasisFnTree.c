@@ -0,0 +1,674 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzBasisFnTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzBasisFnTree.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Tree code for the approximate evaluation of radial basis
+* 		functions with a bounded error.
+* \ingroup	WlzFunction
+*/
+
+#include <float.h>
+#include <string.h>
+#include <Wlz.h>
+
+/*!
+* \def		WLZ_BASISFN_TREE_LEAFSZ
+* \ingroup	WlzFunction
+* \brief	Maximum number of control points in a leaf node of a
+* 		basis function evaluation tree.
+*/
+#define WLZ_BASISFN_TREE_LEAFSZ	(16)
+
+/*!
+* \def		WLZ_BASISFN_TREE_MAXSTK
+* \ingroup	WlzFunction
+* \brief	Size of the node stack used when evaluating a basis
+* 		function tree, this is greater than twice the depth of
+* 		any tree with less than 2^31 control points.
+*/
+#define WLZ_BASISFN_TREE_MAXSTK	(128)
+
+/*!
+* \struct	_WlzBasisFnTreeEnt
+* \ingroup	WlzFunction
+* \brief	A control point and it's coefficients, used while building
+* 		a basis function tree.
+* 		Typedef: ::WlzBasisFnTreeEnt.
+*/
+typedef struct _WlzBasisFnTreeEnt
+{
+  WlzDVertex3	pos;
+  WlzDVertex3	co;
+} WlzBasisFnTreeEnt;
+
+static int			WlzBasisFnTreeBuild(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeEnt *ent,
+				  int idx,
+				  int nPts,
+				  WlzErrorNum *dstErr);
+static int			WlzBasisFnTreeEntCmpX(
+				  const void *p0,
+				  const void *p1);
+static int			WlzBasisFnTreeEntCmpY(
+				  const void *p0,
+				  const void *p1);
+static int			WlzBasisFnTreeEntCmpZ(
+				  const void *p0,
+				  const void *p1);
+
+/*!
+* \return	New basis function tree or NULL on error.
+* \ingroup	WlzFunction
+* \brief	Makes a tree of control point clusters for the approximate
+* 		evaluation of the given radial basis function. The tree
+* 		is a binary space partition of the control points, with
+* 		each node of the tree holding the moments of the
+* 		basis function coefficients (up to second order) about
+* 		the centre of the node's cluster.
+* 		When evaluated using WlzBasisFnTreeSum() the
+* 		contribution of a cluster is computed from a second order
+* 		Taylor expansion of the basis function about the cluster's
+* 		centre whenever a bound on the truncation error of the
+* 		expansion is sufficiently small, otherwise the cluster's
+* 		children (or control points for a leaf) are visited.
+* 		The tolerance is shared between the clusters visited in
+* 		proportion to their sums of absolute coefficients, with
+* 		any part of a cluster's share not used being passed on
+* 		to the clusters visited later, so that the absolute
+* 		error of each component of the evaluated basis function
+* 		is bounded by the given tolerance.
+* 		Only Euclidean distance multiquadric, inverse multiquadric
+* 		and thin plate spline basis functions are supported.
+* \param	basisFn			Given basis function.
+* \param	tol			Maximum absolute error, must be
+* 					greater than zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzBasisFnTree			*WlzBasisFnTreeMake(
+				  WlzBasisFn *basisFn,
+				  double tol,
+				  WlzErrorNum *dstErr)
+{
+  int		idx,
+  		dim = 0;
+  WlzBasisFnTreeEnt *ent = NULL;
+  WlzBasisFnTree *tree = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_NULL;
+  }
+  else if((basisFn->nVtx < 1) || (basisFn->vertices.v == NULL) ||
+          (basisFn->basis.v == NULL))
+  {
+    errNum = WLZ_ERR_TRANSFORM_DATA;
+  }
+  else if(basisFn->distFn != NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_TYPE;
+  }
+  else if(tol < DBL_EPSILON)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(basisFn->type)
+    {
+      case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DMQ:  /* FALLTHROUGH */
+      case WLZ_FN_BASIS_2DTPS:
+        dim = 2;
+	break;
+      case WLZ_FN_BASIS_3DIMQ: /* FALLTHROUGH */
+      case WLZ_FN_BASIS_3DMQ:
+        dim = 3;
+	break;
+      default:
+        errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((tree = (WlzBasisFnTree *)
+                AlcCalloc(1, sizeof(WlzBasisFnTree))) == NULL) ||
+       ((ent = (WlzBasisFnTreeEnt *)
+               AlcMalloc(basisFn->nVtx * sizeof(WlzBasisFnTreeEnt))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tree->type = basisFn->type;
+    tree->nPts = basisFn->nVtx;
+    tree->tol = tol;
+    if((basisFn->type != WLZ_FN_BASIS_2DTPS) && (basisFn->param != NULL))
+    {
+      tree->delta = *(double *)(basisFn->param);
+    }
+    if(dim == 2)
+    {
+      for(idx = 0; idx < tree->nPts; ++idx)
+      {
+        ent[idx].pos.vtX = basisFn->vertices.d2[idx].vtX;
+        ent[idx].pos.vtY = basisFn->vertices.d2[idx].vtY;
+        ent[idx].pos.vtZ = 0.0;
+        ent[idx].co.vtX = basisFn->basis.d2[idx].vtX;
+        ent[idx].co.vtY = basisFn->basis.d2[idx].vtY;
+        ent[idx].co.vtZ = 0.0;
+      }
+    }
+    else
+    {
+      for(idx = 0; idx < tree->nPts; ++idx)
+      {
+        ent[idx].pos = basisFn->vertices.d3[idx];
+        ent[idx].co = basisFn->basis.d3[idx];
+      }
+    }
+    /* Allocate enough nodes for a balanced tree, more are allocated as
+     * needed. */
+    tree->maxNod = 4 * ((tree->nPts + WLZ_BASISFN_TREE_LEAFSZ - 1) /
+                        WLZ_BASISFN_TREE_LEAFSZ);
+    if(((tree->pts = (WlzDVertex3 *)
+                     AlcMalloc(tree->nPts * sizeof(WlzDVertex3))) == NULL) ||
+       ((tree->co = (WlzDVertex3 *)
+                    AlcMalloc(tree->nPts * sizeof(WlzDVertex3))) == NULL) ||
+       ((tree->nod = (WlzBasisFnTreeNod *)
+                     AlcMalloc(tree->maxNod *
+		               sizeof(WlzBasisFnTreeNod))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )WlzBasisFnTreeBuild(tree, ent, 0, tree->nPts, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < tree->nPts; ++idx)
+    {
+      tree->pts[idx] = ent[idx].pos;
+      tree->co[idx] = ent[idx].co;
+    }
+    /* The thin plate spline sum is halved after evaluation so the
+     * tolerance on the sum is doubled. */
+    tree->tolSum = (tree->type == WLZ_FN_BASIS_2DTPS)? 2.0 * tol: tol;
+  }
+  AlcFree(ent);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzBasisFnTreeFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzFunction
+* \brief	Frees the given basis function tree.
+* \param	tree			Given basis function tree, may be NULL.
+*/
+void				WlzBasisFnTreeFree(
+				  WlzBasisFnTree *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->pts);
+    AlcFree(tree->co);
+    AlcFree(tree->nod);
+    AlcFree(tree);
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzFunction
+* \brief	Sets (or removes) the tree used to evaluate the given
+* 		basis function approximately. If the tolerance is greater
+* 		than zero a new tree is made for the basis function (see
+* 		WlzBasisFnTreeMake()) and subsequent evaluations of the
+* 		basis function will use the tree, otherwise any existing
+* 		tree is freed and evaluation will be exact.
+* \param	basisFn			Given basis function.
+* \param	tol			Maximum absolute error of the
+* 					evaluated basis function, or zero
+* 					for exact evaluation.
+*/
+WlzErrorNum			WlzBasisFnSetTree(
+				  WlzBasisFn *basisFn,
+				  double tol)
+{
+  WlzBasisFnTree *tree = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(basisFn == NULL)
+  {
+    errNum = WLZ_ERR_TRANSFORM_NULL;
+  }
+  else
+  {
+    if(tol > 0.0)
+    {
+      tree = WlzBasisFnTreeMake(basisFn, tol, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzBasisFnTreeFree(basisFn->tree);
+      basisFn->tree = tree;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Sum of the radial basis function terms at the given
+* 		position.
+* \ingroup	WlzFunction
+* \brief	Evaluates the sum of the radial basis function terms (ie
+* 		excluding the polynomial terms) at the given position
+* 		using the given tree. The sum is as accumulated by the
+* 		exact evaluation functions, so for thin plate splines
+* 		it must still be halved. This function only reads the
+* 		tree and so may be called concurrently.
+* \param	tree			Given basis function tree.
+* \param	pos			Given position, with the z component
+* 					zero for 2D basis functions.
+*/
+WlzDVertex3			WlzBasisFnTreeSum(
+				  WlzBasisFnTree *tree,
+				  WlzDVertex3 pos)
+{
+  int		nStk = 1;
+  double	delta,
+  		tolRem,
+		wgtRem;
+  WlzDVertex3	sum;
+  int		stk[WLZ_BASISFN_TREE_MAXSTK];
+
+  WLZ_VTX_3_ZERO(sum);
+  stk[0] = 0;
+  delta = tree->delta;
+  tolRem = tree->tolSum;
+  wgtRem = tree->nod[0].wgt;
+  while(nStk > 0)
+  {
+    int		acc = 0;
+    double	s,
+    		q,
+		f0,
+		f1,
+		f2,
+		err = 0.0;
+    WlzDVertex3	v;
+    WlzBasisFnTreeNod *nod;
+
+    nod = tree->nod + stk[--nStk];
+    WLZ_VTX_3_SUB(v, pos, nod->cen);
+    s = WLZ_VTX_3_SQRLEN(v);
+    if(s > nod->rad * nod->rad)
+    {
+      double	k3,
+      		rho;
+
+      /* Bound the third derivatives of the basis function along any
+       * line segment from the centre to a control point of the node,
+       * all of which are at least rho from the given position, and
+       * so bound the error of the second order expansion. */
+      rho = sqrt(s) - nod->rad;
+      q = rho * rho + delta;
+      switch(tree->type)
+      {
+	case WLZ_FN_BASIS_2DTPS:
+	  k3 = 20.0 / rho;
+	  break;
+	case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+	case WLZ_FN_BASIS_3DIMQ:
+	  k3 = 24.0 / (q * q);
+	  break;
+	default:
+	  k3 = 6.0 / q;
+	  break;
+      }
+      err = k3 * nod->m3 / 6.0;
+      acc = (wgtRem > DBL_EPSILON)?
+            (err * wgtRem <= tolRem * nod->wgt): (err <= tolRem);
+    }
+    if(acc)
+    {
+      int	k;
+      double	vM1,
+      		vM2v,
+		trM2;
+
+      /* With the basis function phi(s), s = |v|^2, the second order
+       * expansion of the sum about the centre is
+       * phi m0 - 2 phi' v.m1 + 2 phi'' v^T M2 v + phi' tr(M2). */
+      tolRem -= err;
+      wgtRem -= nod->wgt;
+      q = s + delta;
+      switch(tree->type)
+      {
+	case WLZ_FN_BASIS_2DTPS:
+	  f1 = log(s);
+	  f0 = s * f1;
+	  f1 += 1.0;
+	  f2 = 1.0 / s;
+	  break;
+	case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+	case WLZ_FN_BASIS_3DIMQ:
+	  f0 = 1.0 / sqrt(q);
+	  f1 = -0.5 * f0 / q;
+	  f2 = 0.75 * f0 / (q * q);
+	  break;
+	default:
+	  f0 = sqrt(q);
+	  f1 = 0.5 / f0;
+	  f2 = -0.25 / (q * f0);
+	  break;
+      }
+      for(k = 0; k < 3; ++k)
+      {
+	double	*m2;
+
+	m2 = nod->m2[k];
+	vM1 = WLZ_VTX_3_DOT(v, nod->m1[k]);
+	vM2v = v.vtX * (v.vtX * m2[0] + 2.0 * (v.vtY * m2[1] + v.vtZ * m2[2])) +
+	       v.vtY * (v.vtY * m2[3] + 2.0 * v.vtZ * m2[4]) +
+	       v.vtZ * v.vtZ * m2[5];
+	trM2 = m2[0] + m2[3] + m2[5];
+	(&(sum.vtX))[k] += f0 * (&(nod->m0.vtX))[k] - 2.0 * f1 * vM1 +
+	                   2.0 * f2 * vM2v + f1 * trM2;
+      }
+    }
+    else if(nod->chd[0] >= 0)
+    {
+      double	s0,
+      		s1;
+      WlzDVertex3 v0,
+      		  v1;
+
+      /* Push the nearer child last so that it is visited first, near
+       * clusters are mostly evaluated exactly which leaves more of the
+       * tolerance for the far clusters. */
+      WLZ_VTX_3_SUB(v0, pos, tree->nod[nod->chd[0]].cen);
+      WLZ_VTX_3_SUB(v1, pos, tree->nod[nod->chd[1]].cen);
+      s0 = WLZ_VTX_3_SQRLEN(v0);
+      s1 = WLZ_VTX_3_SQRLEN(v1);
+      stk[nStk++] = nod->chd[(s0 < s1)? 1: 0];
+      stk[nStk++] = nod->chd[(s0 < s1)? 0: 1];
+    }
+    else
+    {
+      int	i,
+      		i1;
+
+      wgtRem -= nod->wgt;
+      i1 = nod->idx + nod->nPts;
+      switch(tree->type)
+      {
+	case WLZ_FN_BASIS_2DTPS:
+	  for(i = nod->idx; i < i1; ++i)
+	  {
+	    WLZ_VTX_3_SUB(v, pos, tree->pts[i]);
+	    s = WLZ_VTX_3_SQRLEN(v);
+	    if(s > DBL_EPSILON)
+	    {
+	      f0 = s * log(s);
+	      WLZ_VTX_3_SCALE_ADD(sum, tree->co[i], f0, sum);
+	    }
+	  }
+	  break;
+	case WLZ_FN_BASIS_2DIMQ: /* FALLTHROUGH */
+	case WLZ_FN_BASIS_3DIMQ:
+	  for(i = nod->idx; i < i1; ++i)
+	  {
+	    WLZ_VTX_3_SUB(v, pos, tree->pts[i]);
+	    f0 = 1.0 / sqrt(WLZ_VTX_3_SQRLEN(v) + delta);
+	    WLZ_VTX_3_SCALE_ADD(sum, tree->co[i], f0, sum);
+	  }
+	  break;
+	default:
+	  for(i = nod->idx; i < i1; ++i)
+	  {
+	    WLZ_VTX_3_SUB(v, pos, tree->pts[i]);
+	    f0 = sqrt(WLZ_VTX_3_SQRLEN(v) + delta);
+	    WLZ_VTX_3_SCALE_ADD(sum, tree->co[i], f0, sum);
+	  }
+	  break;
+      }
+    }
+  }
+  return(sum);
+}
+
+/*!
+* \return	Index of the new node, or -1 on error.
+* \ingroup	WlzFunction
+* \brief	Recursively builds the basis function tree nodes for the
+* 		given range of control points, splitting the points at the
+* 		median of the longest side of their bounding box.
+* \param	tree			The tree being built.
+* \param	ent			Control points and coefficients, which
+* 					are reordered.
+* \param	idx			Index of the first control point.
+* \param	nPts			Number of control points.
+* \param	dstErr			Destination error pointer.
+*/
+static int			WlzBasisFnTreeBuild(
+				  WlzBasisFnTree *tree,
+				  WlzBasisFnTreeEnt *ent,
+				  int idx,
+				  int nPts,
+				  WlzErrorNum *dstErr)
+{
+  int		i,
+  		k,
+		nodIdx = -1;
+  double	r2;
+  WlzDBox3	bBox;
+  WlzBasisFnTreeNod *nod;
+  WlzBasisFnTreeEnt *e;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tree->nNod >= tree->maxNod)
+  {
+    tree->maxNod *= 2;
+    if((tree->nod = (WlzBasisFnTreeNod *)
+                    AlcRealloc(tree->nod, tree->maxNod *
+			       sizeof(WlzBasisFnTreeNod))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nodIdx = tree->nNod++;
+    nod = tree->nod + nodIdx;
+    (void )memset(nod, 0, sizeof(WlzBasisFnTreeNod));
+    nod->idx = idx;
+    nod->nPts = nPts;
+    nod->chd[0] = nod->chd[1] = -1;
+    /* Compute the bounding box, centre and radius of the cluster. */
+    e = ent + idx;
+    bBox.xMin = bBox.xMax = e->pos.vtX;
+    bBox.yMin = bBox.yMax = e->pos.vtY;
+    bBox.zMin = bBox.zMax = e->pos.vtZ;
+    for(i = 1; i < nPts; ++i)
+    {
+      ++e;
+      bBox.xMin = ALG_MIN(bBox.xMin, e->pos.vtX);
+      bBox.xMax = ALG_MAX(bBox.xMax, e->pos.vtX);
+      bBox.yMin = ALG_MIN(bBox.yMin, e->pos.vtY);
+      bBox.yMax = ALG_MAX(bBox.yMax, e->pos.vtY);
+      bBox.zMin = ALG_MIN(bBox.zMin, e->pos.vtZ);
+      bBox.zMax = ALG_MAX(bBox.zMax, e->pos.vtZ);
+    }
+    nod->cen.vtX = 0.5 * (bBox.xMin + bBox.xMax);
+    nod->cen.vtY = 0.5 * (bBox.yMin + bBox.yMax);
+    nod->cen.vtZ = 0.5 * (bBox.zMin + bBox.zMax);
+    /* Compute the moments of the coefficients about the centre. */
+    r2 = 0.0;
+    e = ent + idx;
+    for(i = 0; i < nPts; ++i)
+    {
+      double	a,
+      		d2;
+      WlzDVertex3 d;
+
+      WLZ_VTX_3_SUB(d, e->pos, nod->cen);
+      d2 = WLZ_VTX_3_SQRLEN(d);
+      r2 = ALG_MAX(r2, d2);
+      a = ALG_MAX3(fabs(e->co.vtX), fabs(e->co.vtY), fabs(e->co.vtZ));
+      nod->wgt += a;
+      nod->m3 += a * d2 * sqrt(d2);
+      for(k = 0; k < 3; ++k)
+      {
+        double	c;
+	double	*m2;
+
+	c = (&(e->co.vtX))[k];
+	(&(nod->m0.vtX))[k] += c;
+	nod->m1[k].vtX += c * d.vtX;
+	nod->m1[k].vtY += c * d.vtY;
+	nod->m1[k].vtZ += c * d.vtZ;
+	m2 = nod->m2[k];
+	m2[0] += c * d.vtX * d.vtX;
+	m2[1] += c * d.vtX * d.vtY;
+	m2[2] += c * d.vtX * d.vtZ;
+	m2[3] += c * d.vtY * d.vtY;
+	m2[4] += c * d.vtY * d.vtZ;
+	m2[5] += c * d.vtZ * d.vtZ;
+      }
+      ++e;
+    }
+    nod->rad = sqrt(r2);
+    /* Split the cluster at the median of the longest side of the bounding
+     * box, unless it is small enough to be a leaf. */
+    if((nPts > WLZ_BASISFN_TREE_LEAFSZ) && (nod->rad > DBL_EPSILON))
+    {
+      int	n0,
+      		c0,
+		c1;
+      double	dX,
+      		dY,
+		dZ;
+
+      dX = bBox.xMax - bBox.xMin;
+      dY = bBox.yMax - bBox.yMin;
+      dZ = bBox.zMax - bBox.zMin;
+      qsort(ent + idx, nPts, sizeof(WlzBasisFnTreeEnt),
+            ((dX >= dY) && (dX >= dZ))? WlzBasisFnTreeEntCmpX:
+	    (dY >= dZ)?                 WlzBasisFnTreeEntCmpY:
+	                                WlzBasisFnTreeEntCmpZ);
+      n0 = nPts / 2;
+      c0 = WlzBasisFnTreeBuild(tree, ent, idx, n0, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        c1 = WlzBasisFnTreeBuild(tree, ent, idx + n0, nPts - n0, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* Nodes may have been reallocated. */
+        tree->nod[nodIdx].chd[0] = c0;
+        tree->nod[nodIdx].chd[1] = c1;
+      }
+    }
+  }
+  *dstErr = errNum;
+  return(nodIdx);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares tree entries by their x coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnTreeEntCmpX(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnTreeEnt *)p0)->pos.vtX - ((WlzBasisFnTreeEnt *)p1)->pos.vtX;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares tree entries by their y coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnTreeEntCmpY(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnTreeEnt *)p0)->pos.vtY - ((WlzBasisFnTreeEnt *)p1)->pos.vtY;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzFunction
+* \brief	Compares tree entries by their z coordinate.
+* \param	p0			Pointer to first entry.
+* \param	p1			Pointer to second entry.
+*/
+static int			WlzBasisFnTreeEntCmpZ(
+				  const void *p0,
+				  const void *p1)
+{
+  double	d;
+
+  d = ((WlzBasisFnTreeEnt *)p0)->pos.vtZ - ((WlzBasisFnTreeEnt *)p1)->pos.vtZ;
+  return((d < 0.0)? -1: (d > 0.0)? 1: 0);
+}
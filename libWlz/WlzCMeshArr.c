@@ -0,0 +1,869 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzCMeshArr_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzCMeshArr.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Compact array based 3D conforming meshes, with pool
+* 		allocation of nodes and elements and conversion from
+* 		linked 3D conforming meshes.
+* 		See WlzCMeshFromArr3D() for conversion back to a linked
+* 		3D conforming mesh.
+* \ingroup	WlzMesh
+*/
+
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+static void			WlzCMeshArrFreeAdj3D(
+				  WlzCMeshArr3D *arr);
+static WlzErrorNum		WlzCMeshArrGrowNod3D(
+				  WlzCMeshArr3D *arr,
+				  int nodSz);
+static WlzErrorNum		WlzCMeshArrGrowElm3D(
+				  WlzCMeshArr3D *arr,
+				  int elmSz);
+static WlzErrorNum		WlzCMeshArrSetRing3D(
+				  WlzCMeshArr3D *arr);
+static WlzErrorNum		WlzCMeshArrSetOpp3D(
+				  WlzCMeshArr3D *arr);
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Edge use to element node table for the faces of an element:
+* 		[face][edge use] -> node within the element. This is the
+* 		same as used by WlzCMeshSetElm3D().
+*/
+static const int WlzCMeshArrEduNodTbl3D[4][3] =
+{
+  {0, 1, 2},
+  {0, 3, 1},
+  {0, 2, 3},
+  {2, 1, 3}
+};
+
+/*!
+* \return	New compact 3D mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a new compact 3D mesh with no nodes or elements
+* 		but with space allocated for the given numbers of nodes
+* 		and elements. The mesh should be freed using
+* 		WlzCMeshArrFree3D().
+* \param	nodSz			Number of nodes to allocate space for.
+* \param	elmSz			Number of elements to allocate space
+* 					for.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMeshArr3D	*WlzCMeshArrNew3D(int nodSz, int elmSz, WlzErrorNum *dstErr)
+{
+  WlzCMeshArr3D	*arr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((arr = (WlzCMeshArr3D *)AlcCalloc(1, sizeof(WlzCMeshArr3D))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    arr->nodFree = -1;
+    arr->elmFree = -1;
+    errNum = WlzCMeshArrGrowNod3D(arr, (nodSz > 0)? nodSz: 1);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzCMeshArrGrowElm3D(arr, (elmSz > 0)? elmSz: 1);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      WlzCMeshArrFree3D(arr);
+      arr = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(arr);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees the given compact 3D mesh.
+* \param	arr			Given compact mesh, may be NULL.
+*/
+void		WlzCMeshArrFree3D(WlzCMeshArr3D *arr)
+{
+  if(arr)
+  {
+    AlcFree(arr->nodIdx);
+    AlcFree(arr->nodFlags);
+    AlcFree(arr->nodX);
+    AlcFree(arr->nodY);
+    AlcFree(arr->nodZ);
+    AlcFree(arr->elmIdx);
+    AlcFree(arr->elmFlags);
+    AlcFree(arr->elmNod);
+    AlcFree(arr->elmOpp);
+    WlzCMeshArrFreeAdj3D(arr);
+    AlcFree(arr);
+  }
+}
+
+/*!
+* \return	Index of the new node or -1 on error.
+* \ingroup	WlzMesh
+* \brief	Adds a new node at the given position to the compact
+* 		3D mesh. The node is taken from the free list if it is
+* 		not empty, otherwise the pool is extended. The node
+* 		flags are cleared and the mesh adjacencies are
+* 		invalidated.
+* \param	arr			Given compact mesh.
+* \param	pos			Position of the new node.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+int		WlzCMeshArrNewNod3D(WlzCMeshArr3D *arr, WlzDVertex3 pos,
+				    WlzErrorNum *dstErr)
+{
+  int		idx = -1;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(arr->nodFree >= 0)
+  {
+    idx = arr->nodFree;
+    arr->nodFree = -2 - arr->nodIdx[idx];
+  }
+  else
+  {
+    if(arr->maxNod >= arr->nodSz)
+    {
+      errNum = WlzCMeshArrGrowNod3D(arr, 2 * arr->nodSz);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      idx = arr->maxNod++;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ++(arr->nNod);
+    arr->nodIdx[idx] = idx;
+    arr->nodFlags[idx] = 0;
+    arr->nodX[idx] = pos.vtX;
+    arr->nodY[idx] = pos.vtY;
+    arr->nodZ[idx] = pos.vtZ;
+    arr->adjValid = 0;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idx);
+}
+
+/*!
+* \return	Index of the new element or -1 on error.
+* \ingroup	WlzMesh
+* \brief	Adds a new element with the given nodes to the compact
+* 		3D mesh. The element is taken from the free list if it
+* 		is not empty, otherwise the pool is extended. The nodes
+* 		are given in the order of WLZ_CMESH_ELM3D_GET_NODE_0()
+* 		to WLZ_CMESH_ELM3D_GET_NODE_3(). The element flags are
+* 		cleared and the mesh adjacencies are invalidated.
+* \param	arr			Given compact mesh.
+* \param	nod0			Index of the first node.
+* \param	nod1			Index of the second node.
+* \param	nod2			Index of the third node.
+* \param	nod3			Index of the fourth node.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+int		WlzCMeshArrNewElm3D(WlzCMeshArr3D *arr,
+				    int nod0, int nod1, int nod2, int nod3,
+				    WlzErrorNum *dstErr)
+{
+  int		idN,
+  		idx = -1;
+  int		nod[4];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nod[0] = nod0;
+  nod[1] = nod1;
+  nod[2] = nod2;
+  nod[3] = nod3;
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    for(idN = 0; idN < 4; ++idN)
+    {
+      if((nod[idN] < 0) || (nod[idN] >= arr->maxNod) ||
+         (arr->nodIdx[nod[idN]] < 0))
+      {
+        errNum = WLZ_ERR_PARAM_DATA;
+	break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(arr->elmFree >= 0)
+    {
+      idx = arr->elmFree;
+      arr->elmFree = -2 - arr->elmIdx[idx];
+    }
+    else
+    {
+      if(arr->maxElm >= arr->elmSz)
+      {
+	errNum = WlzCMeshArrGrowElm3D(arr, 2 * arr->elmSz);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	idx = arr->maxElm++;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ++(arr->nElm);
+    arr->elmIdx[idx] = idx;
+    arr->elmFlags[idx] = 0;
+    for(idN = 0; idN < 4; ++idN)
+    {
+      arr->elmNod[4 * idx + idN] = nod[idN];
+      arr->elmOpp[4 * idx + idN] = -1;
+    }
+    arr->adjValid = 0;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idx);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Deletes the given node from the compact 3D mesh, returning
+* 		it to the free list. The node must not be used by any
+* 		element. The mesh adjacencies are invalidated.
+* \param	arr			Given compact mesh.
+* \param	idx			Index of the node.
+*/
+WlzErrorNum	WlzCMeshArrDelNod3D(WlzCMeshArr3D *arr, int idx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((idx < 0) || (idx >= arr->maxNod) || (arr->nodIdx[idx] < 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    arr->nodIdx[idx] = -2 - arr->nodFree;
+    arr->nodFree = idx;
+    --(arr->nNod);
+    arr->adjValid = 0;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Deletes the given element from the compact 3D mesh,
+* 		returning it to the free list. The element's nodes are
+* 		not deleted. The mesh adjacencies are invalidated.
+* \param	arr			Given compact mesh.
+* \param	idx			Index of the element.
+*/
+WlzErrorNum	WlzCMeshArrDelElm3D(WlzCMeshArr3D *arr, int idx)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((idx < 0) || (idx >= arr->maxElm) || (arr->elmIdx[idx] < 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    arr->elmIdx[idx] = -2 - arr->elmFree;
+    arr->elmFree = idx;
+    --(arr->nElm);
+    arr->adjValid = 0;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes the adjacencies (opposite faces and node edge
+* 		use rings) of the given compact 3D mesh from it's element
+* 		nodes, unless they are already valid. The edge uses of
+* 		each node's ring are in element order.
+* \param	arr			Given compact mesh.
+*/
+WlzErrorNum	WlzCMeshArrSetAdj3D(WlzCMeshArr3D *arr)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(arr->adjValid == 0)
+  {
+    errNum = WlzCMeshArrSetRing3D(arr);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzCMeshArrSetOpp3D(arr);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      arr->adjValid = 1;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New compact 3D mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a compact 3D mesh from the given 3D conforming mesh.
+* 		The node and element indices are preserved, with the
+* 		deleted nodes and elements of the given mesh being put
+* 		on the free lists of the compact mesh. The opposite faces
+* 		are copied and the edge use rings of the nodes are
+* 		copied in the order in which they are linked in the given
+* 		mesh, so traversals of the compact mesh visit the edge
+* 		uses in the same order as the given mesh.
+* \param	mesh			Given mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMeshArr3D	*WlzCMeshArrFromCMesh3D(WlzCMesh3D *mesh, WlzErrorNum *dstErr)
+{
+  int		idE,
+  		idN,
+		maxElm,
+		maxNod;
+  WlzCMeshArr3D	*arr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    maxNod = mesh->res.nod.maxEnt;
+    maxElm = mesh->res.elm.maxEnt;
+    arr = WlzCMeshArrNew3D(maxNod, maxElm, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    arr->maxNod = maxNod;
+    arr->maxElm = maxElm;
+    arr->nNod = mesh->res.nod.numEnt;
+    arr->nElm = mesh->res.elm.numEnt;
+    if((arr->ringOff = (int *)AlcMalloc(sizeof(int) * (maxNod + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Copy the nodes and count their edge uses. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idN = 0; idN < maxNod; ++idN)
+    {
+      int	cnt = 0;
+      WlzCMeshNod3D *nod;
+
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+      if(nod->idx >= 0)
+      {
+	WlzCMeshEdgU3D *edu;
+
+	arr->nodIdx[idN] = idN;
+	arr->nodFlags[idN] = nod->flags;
+	arr->nodX[idN] = nod->pos.vtX;
+	arr->nodY[idN] = nod->pos.vtY;
+	arr->nodZ[idN] = nod->pos.vtZ;
+	if((edu = nod->edu) != NULL)
+	{
+	  do
+	  {
+	    ++cnt;
+	    edu = edu->nnxt;
+	  } while(edu != nod->edu);
+	}
+      }
+      else
+      {
+	arr->nodFlags[idN] = 0;
+	arr->nodX[idN] = arr->nodY[idN] = arr->nodZ[idN] = 0.0;
+      }
+      arr->ringOff[idN + 1] = cnt;
+    }
+    /* Copy the elements. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idE = 0; idE < maxElm; ++idE)
+    {
+      int	idF;
+      int	*eNod,
+      		*eOpp;
+      WlzCMeshElm3D *elm;
+
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      eNod = arr->elmNod + 4 * idE;
+      eOpp = arr->elmOpp + 4 * idE;
+      if(elm->idx >= 0)
+      {
+	arr->elmIdx[idE] = idE;
+	arr->elmFlags[idE] = elm->flags;
+	eNod[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm)->idx;
+	eNod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm)->idx;
+	eNod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm)->idx;
+	eNod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm)->idx;
+	for(idF = 0; idF < 4; ++idF)
+	{
+	  WlzCMeshFace *opp;
+
+	  opp = elm->face[idF].opp;
+	  eOpp[idF] = ((opp == NULL) || (opp->elm == NULL) ||
+	               (opp->elm->idx < 0))?
+	              -1: (4 * opp->elm->idx) + (int )(opp - opp->elm->face);
+	}
+      }
+      else
+      {
+	arr->elmFlags[idE] = 0;
+	for(idF = 0; idF < 4; ++idF)
+	{
+	  eNod[idF] = eOpp[idF] = -1;
+	}
+      }
+    }
+    /* Build the free lists so that the lowest free index is first. */
+    for(idN = maxNod - 1; idN >= 0; --idN)
+    {
+      if(((WlzCMeshNod3D *)
+          AlcVectorItemGet(mesh->res.nod.vec, idN))->idx < 0)
+      {
+	arr->nodIdx[idN] = -2 - arr->nodFree;
+	arr->nodFree = idN;
+      }
+    }
+    for(idE = maxElm - 1; idE >= 0; --idE)
+    {
+      if(((WlzCMeshElm3D *)
+          AlcVectorItemGet(mesh->res.elm.vec, idE))->idx < 0)
+      {
+	arr->elmIdx[idE] = -2 - arr->elmFree;
+	arr->elmFree = idE;
+      }
+    }
+    /* Offsets of the edge use rings. */
+    arr->ringOff[0] = 0;
+    for(idN = 0; idN < maxNod; ++idN)
+    {
+      arr->ringOff[idN + 1] += arr->ringOff[idN];
+    }
+    arr->ringSz = arr->ringOff[maxNod];
+    if(((arr->ringNod = (int *)
+                        AlcMalloc(sizeof(int) * (arr->ringSz + 1))) == NULL) ||
+       ((arr->ringElm = (int *)
+                        AlcMalloc(sizeof(int) * (arr->ringSz + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Copy the edge use rings. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idN = 0; idN < maxNod; ++idN)
+    {
+      int	idR;
+      WlzCMeshNod3D *nod;
+
+      idR = arr->ringOff[idN];
+      nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+      if((nod->idx >= 0) && (nod->edu != NULL))
+      {
+	WlzCMeshEdgU3D *edu;
+
+	edu = nod->edu;
+	do
+	{
+	  WlzCMeshFace *fce;
+
+	  fce = edu->face;
+	  arr->ringNod[idR] = edu->next->nod->idx;
+	  arr->ringElm[idR] = (4 * fce->elm->idx) +
+	                      (int )(fce - fce->elm->face);
+	  ++idR;
+	  edu = edu->nnxt;
+	} while(edu != nod->edu);
+      }
+    }
+    arr->adjValid = 1;
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzCMeshArrFree3D(arr);
+    arr = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(arr);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees the edge use rings of the given compact 3D mesh.
+* \param	arr			Given compact mesh.
+*/
+static void	WlzCMeshArrFreeAdj3D(WlzCMeshArr3D *arr)
+{
+  AlcFree(arr->ringOff);
+  AlcFree(arr->ringNod);
+  AlcFree(arr->ringElm);
+  arr->ringOff = arr->ringNod = arr->ringElm = NULL;
+  arr->ringSz = 0;
+  arr->adjValid = 0;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Extends the node arrays of the given compact 3D mesh so
+* 		that they have space for the given number of nodes.
+* \param	arr			Given compact mesh.
+* \param	nodSz			Required number of nodes.
+*/
+static WlzErrorNum WlzCMeshArrGrowNod3D(WlzCMeshArr3D *arr, int nodSz)
+{
+  int		*nodIdx;
+  unsigned int	*nodFlags;
+  double	*nodX,
+  		*nodY,
+		*nodZ;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nodSz > arr->nodSz)
+  {
+    if((nodIdx = (int *)AlcRealloc(arr->nodIdx,
+                                   sizeof(int) * nodSz)) != NULL)
+    {
+      arr->nodIdx = nodIdx;
+    }
+    if((nodFlags = (unsigned int *)AlcRealloc(arr->nodFlags,
+                                   sizeof(unsigned int) * nodSz)) != NULL)
+    {
+      arr->nodFlags = nodFlags;
+    }
+    if((nodX = (double *)AlcRealloc(arr->nodX,
+                                    sizeof(double) * nodSz)) != NULL)
+    {
+      arr->nodX = nodX;
+    }
+    if((nodY = (double *)AlcRealloc(arr->nodY,
+                                    sizeof(double) * nodSz)) != NULL)
+    {
+      arr->nodY = nodY;
+    }
+    if((nodZ = (double *)AlcRealloc(arr->nodZ,
+                                    sizeof(double) * nodSz)) != NULL)
+    {
+      arr->nodZ = nodZ;
+    }
+    if((nodIdx == NULL) || (nodFlags == NULL) ||
+       (nodX == NULL) || (nodY == NULL) || (nodZ == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      arr->nodSz = nodSz;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Extends the element arrays of the given compact 3D mesh so
+* 		that they have space for the given number of elements.
+* \param	arr			Given compact mesh.
+* \param	elmSz			Required number of elements.
+*/
+static WlzErrorNum WlzCMeshArrGrowElm3D(WlzCMeshArr3D *arr, int elmSz)
+{
+  int		*elmIdx,
+  		*elmNod,
+		*elmOpp;
+  unsigned int	*elmFlags;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(elmSz > arr->elmSz)
+  {
+    if((elmIdx = (int *)AlcRealloc(arr->elmIdx,
+                                   sizeof(int) * elmSz)) != NULL)
+    {
+      arr->elmIdx = elmIdx;
+    }
+    if((elmFlags = (unsigned int *)AlcRealloc(arr->elmFlags,
+                                   sizeof(unsigned int) * elmSz)) != NULL)
+    {
+      arr->elmFlags = elmFlags;
+    }
+    if((elmNod = (int *)AlcRealloc(arr->elmNod,
+                                   sizeof(int) * 4 * elmSz)) != NULL)
+    {
+      arr->elmNod = elmNod;
+    }
+    if((elmOpp = (int *)AlcRealloc(arr->elmOpp,
+                                   sizeof(int) * 4 * elmSz)) != NULL)
+    {
+      arr->elmOpp = elmOpp;
+    }
+    if((elmIdx == NULL) || (elmFlags == NULL) ||
+       (elmNod == NULL) || (elmOpp == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      arr->elmSz = elmSz;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes the edge use rings of the nodes of the given
+* 		compact 3D mesh from it's element nodes. Each node's
+* 		edge uses are in element, face and edge use order.
+* \param	arr			Given compact mesh.
+*/
+static WlzErrorNum WlzCMeshArrSetRing3D(WlzCMeshArr3D *arr)
+{
+  int		idE,
+  		idF,
+		idN,
+		idU;
+  int		*pos = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WlzCMeshArrFreeAdj3D(arr);
+  if((arr->ringOff = (int *)AlcCalloc(arr->maxNod + 1, sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Each node of an element has an edge use in the three faces which
+     * include it. */
+    for(idE = 0; idE < arr->maxElm; ++idE)
+    {
+      if(arr->elmIdx[idE] >= 0)
+      {
+	for(idN = 0; idN < 4; ++idN)
+	{
+	  arr->ringOff[arr->elmNod[4 * idE + idN] + 1] += 3;
+	}
+      }
+    }
+    for(idN = 0; idN < arr->maxNod; ++idN)
+    {
+      arr->ringOff[idN + 1] += arr->ringOff[idN];
+    }
+    arr->ringSz = arr->ringOff[arr->maxNod];
+    if(((pos = (int *)AlcMalloc(sizeof(int) * (arr->maxNod + 1))) == NULL) ||
+       ((arr->ringNod = (int *)
+                        AlcMalloc(sizeof(int) * (arr->ringSz + 1))) == NULL) ||
+       ((arr->ringElm = (int *)
+                        AlcMalloc(sizeof(int) * (arr->ringSz + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    (void )memcpy(pos, arr->ringOff, sizeof(int) * (arr->maxNod + 1));
+    for(idE = 0; idE < arr->maxElm; ++idE)
+    {
+      if(arr->elmIdx[idE] >= 0)
+      {
+	int	*eNod;
+
+	eNod = arr->elmNod + 4 * idE;
+	for(idF = 0; idF < 4; ++idF)
+	{
+	  for(idU = 0; idU < 3; ++idU)
+	  {
+	    int	n,
+		p;
+
+	    n = eNod[WlzCMeshArrEduNodTbl3D[idF][idU]];
+	    p = pos[n]++;
+	    arr->ringNod[p] = eNod[WlzCMeshArrEduNodTbl3D[idF][(idU + 1) % 3]];
+	    arr->ringElm[p] = (4 * idE) + idF;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(pos);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes the opposite faces of the given compact 3D mesh
+* 		using the edge use rings, which must be valid. The faces
+* 		which use each node as their lowest indexed node are
+* 		gathered from the node's edge use ring and then searched
+* 		for matching faces, with the nodes being searched in
+* 		parallel.
+* \param	arr			Given compact mesh.
+*/
+static WlzErrorNum WlzCMeshArrSetOpp3D(WlzCMeshArr3D *arr)
+{
+  int		idE,
+  		idN;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idE = 0; idE < 4 * arr->maxElm; ++idE)
+  {
+    arr->elmOpp[idE] = -1;
+  }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+  for(idN = 0; idN < arr->maxNod; ++idN)
+  {
+    int		i,
+    		j;
+
+    /* Every face which includes a node is reached through exactly one
+     * edge use in the node's ring, so search the faces for which this
+     * node is the lowest indexed. */
+    for(i = arr->ringOff[idN]; i < arr->ringOff[idN + 1]; ++i)
+    {
+      int	e0,
+      		f0;
+      int	n0[3];
+
+      e0 = arr->ringElm[i] / 4;
+      f0 = arr->ringElm[i] % 4;
+      n0[0] = arr->elmNod[4 * e0 + WlzCMeshArrEduNodTbl3D[f0][0]];
+      n0[1] = arr->elmNod[4 * e0 + WlzCMeshArrEduNodTbl3D[f0][1]];
+      n0[2] = arr->elmNod[4 * e0 + WlzCMeshArrEduNodTbl3D[f0][2]];
+      if((ALG_MIN3(n0[0], n0[1], n0[2]) == idN) &&
+         (arr->elmOpp[arr->ringElm[i]] < 0))
+      {
+	for(j = i + 1; j < arr->ringOff[idN + 1]; ++j)
+	{
+	  int	e1,
+	  	f1,
+		k,
+		m;
+
+	  e1 = arr->ringElm[j] / 4;
+	  f1 = arr->ringElm[j] % 4;
+	  if((e1 != e0) && (arr->elmOpp[arr->ringElm[j]] < 0))
+	  {
+	    for(k = 0; k < 3; ++k)
+	    {
+	      int	n1;
+
+	      n1 = arr->elmNod[4 * e1 + WlzCMeshArrEduNodTbl3D[f1][k]];
+	      for(m = 0; m < 3; ++m)
+	      {
+		if(n1 == n0[m])
+		{
+		  break;
+		}
+	      }
+	      if(m == 3)
+	      {
+		break;
+	      }
+	    }
+	    if(k == 3)
+	    {
+	      arr->elmOpp[arr->ringElm[i]] = arr->ringElm[j];
+	      arr->elmOpp[arr->ringElm[j]] = arr->ringElm[i];
+	      break;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
@@ -42,6 +42,9 @@ static char _WlzCMeshFMar_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <math.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* #define WLZ_CMESH_FMAR_DEBUG */
 
@@ -131,6 +134,15 @@ static int			WlzCMeshFMarCompute3D3(
 				  WlzCMeshNod3D *nod2,
 				  WlzCMeshNod3D *nod3,
 				  double *distances);
+static double			WlzCMeshFMarSolve3D3(
+                                  WlzDVertex3 pos0,
+				  WlzDVertex3 pos1,
+				  WlzDVertex3 pos2,
+				  WlzDVertex3 pos3,
+				  double dist0,
+				  double dist1,
+				  double dist2,
+				  double dist3);
 static WlzErrorNum 		WlzCMeshFMarAddSeeds2D(
 				  AlcHeap *queue,
 				  WlzCMesh2D *mesh, 
@@ -189,6 +201,51 @@ static WlzErrorNum 		WlzCMeshFMarElmQInit3D(
 				  AlcHeap *queue,
 				  WlzCMeshNod3D *nod,
 				  int *fmNFlags);
+static WlzErrorNum		WlzCMeshFMarInitSeeds2D(
+				  AlcHeap **dstNodQ,
+				  WlzCMesh2D *mesh,
+				  double *distances,
+				  int *fmNFlags,
+				  int nSeeds,
+				  WlzDVertex2 *seeds);
+static WlzErrorNum		WlzCMeshFMarInitSeeds3D(
+				  AlcHeap **dstNodQ,
+				  WlzCMesh3D *mesh,
+				  double *distances,
+				  int *fmNFlags,
+				  int nSeeds,
+				  WlzDVertex3 *seeds);
+static double			WlzCMeshFIMUpdate2D(
+				  WlzCMeshNod2D *nod,
+				  double *distances,
+				  int *fItr,
+				  int itr);
+static double			WlzCMeshFIMUpdate3D(
+				  WlzCMeshArr3D *arr,
+				  int idx,
+				  double *distances,
+				  int *fItr,
+				  int itr);
+static double			WlzCMeshFIMBand2D(
+				  WlzCMesh2D *mesh);
+static double			WlzCMeshFIMBand3D(
+				  WlzCMeshArr3D *arr);
+static WlzObject		*WlzCMeshDistanceFn2D(
+				  WlzObject *objG,
+				  WlzObjectType rObjType,
+				  int nSeeds,
+				  WlzDVertex2 *seeds,
+				  WlzInterpolationType interp,
+				  int fim,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzCMeshDistanceFn3D(
+				  WlzObject *objG,
+				  WlzObjectType rObjType,
+				  int nSeeds,
+				  WlzDVertex3 *seeds,
+				  WlzInterpolationType interp,
+				  int fim,
+				  WlzErrorNum *dstErr);
 
 /*!
 * \return	A 2D domain object, an empty object if the mesh has
@@ -213,10 +270,80 @@ static WlzErrorNum 		WlzCMeshFMarElmQInit3D(
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 WlzObject	*WlzCMeshDistance2D(WlzObject *objG,
-                                WlzObjectType rObjType,
+				WlzObjectType rObjType,
+				int nSeeds, WlzDVertex2 *seeds,
+				WlzInterpolationType interp,
+				WlzErrorNum *dstErr)
+{
+  return(WlzCMeshDistanceFn2D(objG, rObjType, nSeeds, seeds, interp, 0,
+                              dstErr));
+}
+
+/*!
+* \return	A 2D domain object, an empty object if the mesh has
+* 		no elements or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Computes a new 2D object with values that are the
+* 		distance from the given seeds within the given mesh,
+* 		as WlzCMeshDistance2D() does, but using the concurrent
+* 		fast iterative method of WlzCMeshFIMNodes2D() rather
+* 		than fast marching.
+* \param	objG			Given mesh object.
+* \param	rObjType		Return object type must either be
+* 					WLZ_CMESH_2D or WLZ_2D_DOMAINOBJ.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+*					are not within the mesh.
+* \param	interp			Interpolation for 3D volumes
+* 					(should be
+* 					WLZ_INTERPOLATION_BARYCENTRIC
+* 					or WLZ_INTERPOLATION_KRIG).
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzCMeshDistanceFIM2D(WlzObject *objG,
+				WlzObjectType rObjType,
 				int nSeeds, WlzDVertex2 *seeds,
 				WlzInterpolationType interp,
 				WlzErrorNum *dstErr)
+{
+  return(WlzCMeshDistanceFn2D(objG, rObjType, nSeeds, seeds, interp, 1,
+                              dstErr));
+}
+
+/*!
+* \return	A 2D domain object, an empty object if the mesh has
+* 		no elements or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Computes a new 2D object with values that are the
+* 		distance from the given seeds within the given mesh
+* 		using either fast marching or the fast iterative method.
+* \param	objG			Given mesh object.
+* \param	rObjType		Return object type must either be
+* 					WLZ_CMESH_2D or WLZ_2D_DOMAINOBJ.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+*					are not within the mesh.
+* \param	interp			Interpolation for 3D volumes
+* 					(should be
+* 					WLZ_INTERPOLATION_BARYCENTRIC
+* 					or WLZ_INTERPOLATION_KRIG).
+* \param	fim			Use the fast iterative method if
+* 					non-zero, otherwise fast marching.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzCMeshDistanceFn2D(WlzObject *objG,
+				WlzObjectType rObjType,
+				int nSeeds, WlzDVertex2 *seeds,
+				WlzInterpolationType interp,
+				int fim, WlzErrorNum *dstErr)
 {
   int		idN;
   double	*distances = NULL;
@@ -274,7 +401,9 @@ WlzObject	*WlzCMeshDistance2D(WlzObject *objG,
     }
     if(errNum == WLZ_ERR_NONE)
     {
-      errNum = WlzCMeshFMarNodes2D(mesh, distances, nSeeds, seeds);
+      errNum = (fim)?
+               WlzCMeshFIMNodes2D(mesh, distances, nSeeds, seeds):
+               WlzCMeshFMarNodes2D(mesh, distances, nSeeds, seeds);
     }
     if(errNum == WLZ_ERR_NONE)
     {
@@ -346,6 +475,76 @@ WlzObject	*WlzCMeshDistance3D(WlzObject *objG,
 				int nSeeds, WlzDVertex3 *seeds,
 				WlzInterpolationType interp,
 				WlzErrorNum *dstErr)
+{
+  return(WlzCMeshDistanceFn3D(objG, rObjType, nSeeds, seeds, interp, 0,
+                              dstErr));
+}
+
+/*!
+* \return	A 3D domain object, an empty object if the mesh has
+* 		no elements or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Computes a new 3D object with values that are the
+* 		distance from the given seeds within the given mesh,
+* 		as WlzCMeshDistance3D() does, but using the concurrent
+* 		fast iterative method of WlzCMeshFIMNodes3D() rather
+* 		than fast marching.
+* \param	objG			Given mesh object.
+* \param	rObjType		Return object type must either be
+* 					WLZ_CMESH_2D or WLZ_2D_DOMAINOBJ.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+*					are not within the mesh.
+* \param	interp			Interpolation for 3D volumes
+* 					(should be
+* 					WLZ_INTERPOLATION_BARYCENTRIC
+* 					or WLZ_INTERPOLATION_KRIG).
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzCMeshDistanceFIM3D(WlzObject *objG,
+				WlzObjectType rObjType,
+				int nSeeds, WlzDVertex3 *seeds,
+				WlzInterpolationType interp,
+				WlzErrorNum *dstErr)
+{
+  return(WlzCMeshDistanceFn3D(objG, rObjType, nSeeds, seeds, interp, 1,
+                              dstErr));
+}
+
+/*!
+* \return	A 3D domain object, an empty object if the mesh has
+* 		no elements or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Computes a new 3D object with values that are the
+* 		distance from the given seeds within the given mesh
+* 		using either fast marching or the fast iterative method.
+* \param	objG			Given mesh object.
+* \param	rObjType		Return object type must either be
+* 					WLZ_CMESH_2D or WLZ_2D_DOMAINOBJ.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+*					are not within the mesh.
+* \param	interp			Interpolation for 3D volumes
+* 					(should be
+* 					WLZ_INTERPOLATION_BARYCENTRIC
+* 					or WLZ_INTERPOLATION_KRIG).
+* \param	fim			Use the fast iterative method if
+* 					non-zero, otherwise fast marching.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzCMeshDistanceFn3D(WlzObject *objG,
+				WlzObjectType rObjType,
+				int nSeeds, WlzDVertex3 *seeds,
+				WlzInterpolationType interp,
+				int fim, WlzErrorNum *dstErr)
 {
   int		idN;
   double	*distances = NULL;
@@ -403,7 +602,9 @@ WlzObject	*WlzCMeshDistance3D(WlzObject *objG,
     }
     if(errNum == WLZ_ERR_NONE)
     {
-      errNum = WlzCMeshFMarNodes3D(mesh, distances, nSeeds, seeds);
+      errNum = (fim)?
+               WlzCMeshFIMNodes3D(mesh, distances, nSeeds, seeds):
+               WlzCMeshFMarNodes3D(mesh, distances, nSeeds, seeds);
     }
     if(errNum == WLZ_ERR_NONE)
     {
@@ -471,9 +672,7 @@ WlzErrorNum	WlzCMeshFMarNodes2D(WlzCMesh2D *mesh, double *distances,
 				int nSeeds, WlzDVertex2 *seeds)
 {
   int		idM,
-  		idN,
-  		idS,
-		cnt;
+  		idN;
   int		*fmNFlags = NULL;
   WlzCMeshNod2D	*nod0,
                 *nod1;
@@ -510,54 +709,12 @@ WlzErrorNum	WlzCMeshFMarNodes2D(WlzCMesh2D *mesh, double *distances,
   {
     WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
   }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    if((cnt = WlzCMeshCountBoundNodes2D(mesh)) <= 0)
-    {
-      errNum = WLZ_ERR_DOMAIN_DATA;
-    }
-  }
   /* Create and then initialise the active node queue using the given seed
    * or boundary nodes. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    if(nSeeds > 0)
-    {
-      errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
-                                      distances, fmNFlags, nSeeds, seeds);
-    }
-    else
-    {
-      nSeeds = cnt;
-      if((seeds = (WlzDVertex2 *)
-                  AlcMalloc(nSeeds * sizeof(WlzDVertex2))) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-      else
-      {
-	idS = 0;
-        for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
-	{
-	  nod0 = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	  if((nod0->idx >= 0) && (WlzCMeshNodIsBoundary2D(nod0) != 0))
-	  {
-	    seeds[idS] = nod0->pos;
-	    ++idS;
-	  }
-	}
-	errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
-				        distances, fmNFlags, nSeeds, seeds);
-	AlcFree(seeds);
-      }
-    }
+    errNum = WlzCMeshFMarInitSeeds2D(&nodQ, mesh, distances, fmNFlags,
+    				     nSeeds, seeds);
   }
   /* Create element queue. */
   if(errNum == WLZ_ERR_NONE)
@@ -596,7 +753,6 @@ WlzErrorNum	WlzCMeshFMarNodes2D(WlzCMesh2D *mesh, double *distances,
 	      break;
 	    }
 	  }
-	  cnt = 0;
 	  for(idM = 0; idM < 3; ++idM)
 	  {
 	    nodes[idM] = elm->edu[(idN + idM) % 3].nod;
@@ -628,93 +784,672 @@ WlzErrorNum	WlzCMeshFMarNodes2D(WlzCMesh2D *mesh, double *distances,
 		               WLZ_CMESH_NOD_FLAG_UPWIND;
 	}
       }
-      AlcHeapAllEntFree(elmQ, 0);
+      AlcHeapAllEntFree(elmQ, 0);
+    }
+  }
+  /* Clear up. */
+  AlcFree(fmNFlags);
+  AlcHeapFree(elmQ);
+  AlcHeapFree(nodQ);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a mesh by
+* 		propagating wavefronts within a 3D conforming mesh. The
+* 		wavefronts are propagated from either the mesh boundary
+* 		or a number of seed positions within the mesh.
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+* 					any seeds are not within the
+* 					mesh.
+*/
+WlzErrorNum	WlzCMeshFMarNodes3D(WlzCMesh3D *mesh, double *distances,
+				int nSeeds, WlzDVertex3 *seeds)
+{
+  int		idM,
+  		idN,
+		idP;
+  int		*fmNFlags = NULL;
+  WlzCMeshNod3D	*nod0,
+                *nod1;
+  WlzCMeshNod3D	*nodes[4];
+  WlzCMeshElm3D	*elm;
+  AlcHeap *nodQ = NULL;
+  AlcHeap *elmQ = NULL;
+  WlzCMeshFMarQEnt *nodQEntP;
+  WlzCMeshFMarElmQEnt *elmQEntP = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  /* Set distance for all mesh nodes to maximum value. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fmNFlags = (int *)AlcCalloc(mesh->res.nod.maxEnt, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Create and then initialise the active node queue using the given seed
+   * or boundary nodes. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshFMarInitSeeds3D(&nodQ, mesh, distances, fmNFlags,
+    				     nSeeds, seeds);
+  }
+  /* Create element queue. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((elmQ = AlcHeapNew(sizeof(WlzCMeshFMarElmQEnt), 1024, NULL)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Until the queue is empty: Pop the node with lowest priority (ie
+   * lowest distance) from the queue, and process it. */
+  while((errNum == WLZ_ERR_NONE) &&
+	((nodQEntP = (WlzCMeshFMarQEnt *)AlcHeapTop(nodQ)) != NULL))
+  {
+    /* Find all neighbouring nodes that are neither active nor upwind.
+     * For each of these neighbouring nodes, compute their distance, set
+     * them to active and insert them into the queue.*/
+    nod0 = (WlzCMeshNod3D *)(nodQEntP->entity);
+    AlcHeapEntFree(nodQ);
+    if((fmNFlags[nod0->idx] & WLZ_CMESH_NOD_FLAG_UPWIND) == 0)
+    {
+      errNum = WlzCMeshFMarElmQInit3D(elmQ, nod0, fmNFlags);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	/* While element list is not empty, remove element and compute all
+	 * node distances for it. */
+	while((elmQEntP = (WlzCMeshFMarElmQEnt *)AlcHeapTop(elmQ)) != NULL)
+	{
+	  elm = elmQEntP->elm.e3;
+	  AlcHeapEntFree(elmQ);
+	  /* Compute distances: Find the elements nodes, sort them by
+	   * distance and then compute the unknown node distances. */
+	  nodes[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+	  nodes[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+	  nodes[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+	  nodes[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+	  for(idM = 0; idM < 3; ++idM)
+	  {
+	    idP = idM;
+	    for(idN = idM + 1; idN < 4; ++idN)
+	    {
+	      if(distances[nodes[idN]->idx] < distances[nodes[idP]->idx])
+	      {
+	        idP = idN;
+	      }
+	    }
+	    nod1 = nodes[idM]; nodes[idM] = nodes[idP]; nodes[idP] = nod1;
+	  }
+	  if(WlzCMeshFMarCompute3D(nodes[0], nodes[1], nodes[2], nodes[3],
+				   distances, fmNFlags, elm) != 0)
+	  {
+	    errNum = WlzCMeshFMarQInsertNod3D(nodQ, nodes[3],
+					      fmNFlags + nodes[3]->idx,
+					      distances[nodes[3]->idx]);
+	    if(errNum != WLZ_ERR_NONE)
+	    {
+	      break;
+	    }
+	  }
+	}
+	/* Set the current node to be upwind. */
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  fmNFlags[nod0->idx] = (fmNFlags[nod0->idx] &
+	                        ~(WLZ_CMESH_NOD_FLAG_ACTIVE)) |
+			       WLZ_CMESH_NOD_FLAG_KNOWN |
+			       WLZ_CMESH_NOD_FLAG_UPWIND;
+	}
+      }
+      AlcHeapAllEntFree(elmQ, 0);
+    }
+  }
+  /* Clear up. */
+  AlcFree(fmNFlags);
+  AlcHeapFree(elmQ);
+  AlcHeapFree(nodQ);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a 2D conforming
+* 		mesh, as WlzCMeshFMarNodes2D() does, but using a fast
+* 		iterative method which is run concurrently.
+* 		Rather than fixing the distance of a single node at a
+* 		time in order of increasing distance, the distances of
+* 		all nodes which neighbour the nodes with changed distances
+* 		are updated together from the previous distances. This
+* 		is repeated until no distances change. Only the changed
+* 		nodes with distances within a narrow band (about an edge
+* 		length) of the smallest changed distance are used in each
+* 		iteration, so that nodes are rarely updated before the
+* 		distances of their upwind neighbours have settled. Since
+* 		each update only reads the previous distances the computed
+* 		distances do not depend on the number of threads. The distances
+* 		differ from those computed by fast marching by less than
+* 		the maximum element edge length.
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+* 					any seeds are not within the
+* 					mesh.
+*/
+WlzErrorNum	WlzCMeshFIMNodes2D(WlzCMesh2D *mesh, double *distances,
+				   int nSeeds, WlzDVertex2 *seeds)
+{
+  int		idC,
+  		idF,
+		idN,
+		nA,
+		nC,
+		nF = 0,
+		itr = 1;
+  int		*fmNFlags = NULL,
+  		*cItr = NULL,
+		*fItr = NULL;
+  double	fD,
+  		band,
+		thr;
+  double	*cDist = NULL;
+  WlzCMeshNod2D	*nod;
+  WlzCMeshNod2D	**aNod = NULL,
+  		**cNod = NULL,
+  		**fNod = NULL;
+  WlzCMeshEdgU2D *edu0,
+  		*edu1;
+  AlcHeap	*nodQ = NULL;
+  WlzCMeshFMarQEnt *nodQEntP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	relTol = 1.0e-09;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_2D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    idN = mesh->res.nod.maxEnt;
+    if(((fmNFlags = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((cItr = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((fItr = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((cDist = (double *)AlcMalloc(sizeof(double) * idN)) == NULL) ||
+       ((cNod = (WlzCMeshNod2D **)
+                AlcMalloc(sizeof(WlzCMeshNod2D *) * idN)) == NULL) ||
+       ((aNod = (WlzCMeshNod2D **)
+                AlcMalloc(sizeof(WlzCMeshNod2D *) * idN)) == NULL) ||
+       ((fNod = (WlzCMeshNod2D **)
+                AlcMalloc(sizeof(WlzCMeshNod2D *) * idN)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Set the distances of the nodes close to the seeds, these distances are
+   * fixed (known). The initial front is formed from the nodes in the node
+   * queue. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+    errNum = WlzCMeshFMarInitSeeds2D(&nodQ, mesh, distances, fmNFlags,
+    				     nSeeds, seeds);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    band = WlzCMeshFIMBand2D(mesh);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((nodQEntP = (WlzCMeshFMarQEnt *)AlcHeapTop(nodQ)) != NULL)
+    {
+      fNod[nF] = (WlzCMeshNod2D *)(nodQEntP->entity);
+      fmNFlags[fNod[nF]->idx] |= WLZ_CMESH_NOD_FLAG_ACTIVE;
+      ++nF;
+      AlcHeapEntFree(nodQ);
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (nF > 0))
+  {
+    /* Make the front nodes with distances within the band of the
+     * minimum front distance active, the other front nodes are
+     * deferred to later iterations. */
+    thr = DBL_MAX;
+    for(idF = 0; idF < nF; ++idF)
+    {
+      fD = distances[fNod[idF]->idx];
+      if(fD < thr)
+      {
+        thr = fD;
+      }
+    }
+    thr += band;
+    nA = 0;
+    idC = 0;
+    for(idF = 0; idF < nF; ++idF)
+    {
+      nod = fNod[idF];
+      if(distances[nod->idx] <= thr)
+      {
+	fItr[nod->idx] = itr;
+	fmNFlags[nod->idx] &= ~(WLZ_CMESH_NOD_FLAG_ACTIVE);
+        aNod[nA++] = nod;
+      }
+      else
+      {
+        fNod[idC++] = nod;
+      }
+    }
+    nF = idC;
+    /* Collect the nodes which share an element with an active front node
+     * and which do not have a known distance. */
+    nC = 0;
+    for(idF = 0; idF < nA; ++idF)
+    {
+      fD = distances[aNod[idF]->idx];
+      edu0 = edu1 = aNod[idF]->edu;
+      do
+      {
+	for(idN = 0; idN < 3; ++idN)
+	{
+	  nod = edu1->elm->edu[idN].nod;
+	  if(((fmNFlags[nod->idx] & WLZ_CMESH_NOD_FLAG_KNOWN) == 0) &&
+	     (cItr[nod->idx] != itr) && (distances[nod->idx] > fD))
+	  {
+	    cItr[nod->idx] = itr;
+	    cNod[nC++] = nod;
+	  }
+	}
+	edu1 = edu1->nnxt;
+      } while(edu1 != edu0);
+    }
+    /* Compute the candidate node distances. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idC = 0; idC < nC; ++idC)
+    {
+      cDist[idC] = WlzCMeshFIMUpdate2D(cNod[idC], distances, fItr, itr);
+    }
+    /* Update the distances and add the nodes with changed distances
+     * to the front. */
+    for(idC = 0; idC < nC; ++idC)
+    {
+      nod = cNod[idC];
+      if(cDist[idC] < distances[nod->idx] * (1.0 - relTol))
+      {
+        distances[nod->idx] = cDist[idC];
+	if((fmNFlags[nod->idx] & WLZ_CMESH_NOD_FLAG_ACTIVE) == 0)
+	{
+	  fmNFlags[nod->idx] |= WLZ_CMESH_NOD_FLAG_ACTIVE;
+	  fNod[nF++] = nod;
+	}
+      }
+    }
+    ++itr;
+  }
+  AlcFree(fmNFlags);
+  AlcFree(cItr);
+  AlcFree(fItr);
+  AlcFree(cDist);
+  AlcFree(aNod);
+  AlcFree(cNod);
+  AlcFree(fNod);
+  AlcHeapFree(nodQ);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Computes constrained distances within a 3D conforming
+* 		mesh, as WlzCMeshFMarNodes3D() does, but using a fast
+* 		iterative method which is run concurrently.
+* 		See WlzCMeshFIMNodes2D(). The front is propagated over a
+* 		compact copy of the mesh made by WlzCMeshArrFromCMesh3D().
+* 		The given mesh will not be modified.
+* \param	mesh			Given mesh.
+* \param	distances		Array for computed distances.
+* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seed nodes.
+* \param	seeds			Array of seed positions, may be
+* 					NULL iff the number of seed nodes
+* 					is \f$<\f$ 1. It is an error if
+* 					any seeds are not within the
+* 					mesh.
+*/
+WlzErrorNum	WlzCMeshFIMNodes3D(WlzCMesh3D *mesh, double *distances,
+				   int nSeeds, WlzDVertex3 *seeds)
+{
+  int		idC,
+  		idF,
+		idN,
+		nA,
+		nC,
+		nF = 0,
+		itr = 1;
+  int		*fmNFlags = NULL,
+  		*cItr = NULL,
+		*fItr = NULL;
+  int		*aNod = NULL,
+  		*cNod = NULL,
+  		*fNod = NULL;
+  double	fD,
+  		band,
+		thr;
+  double	*cDist = NULL;
+  WlzCMeshArr3D	*arr = NULL;
+  AlcHeap	*nodQ = NULL;
+  WlzCMeshFMarQEnt *nodQEntP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	relTol = 1.0e-09;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    idN = mesh->res.nod.maxEnt;
+    if(((fmNFlags = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((cItr = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((fItr = (int *)AlcCalloc(idN, sizeof(int))) == NULL) ||
+       ((cDist = (double *)AlcMalloc(sizeof(double) * idN)) == NULL) ||
+       ((cNod = (int *)AlcMalloc(sizeof(int) * idN)) == NULL) ||
+       ((aNod = (int *)AlcMalloc(sizeof(int) * idN)) == NULL) ||
+       ((fNod = (int *)AlcMalloc(sizeof(int) * idN)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* The front is propagated using a compact copy of the mesh, in which
+   * the nodes and elements are accessed by index. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    arr = WlzCMeshArrFromCMesh3D(mesh, &errNum);
+  }
+  /* Set the distances of the nodes close to the seeds, these distances are
+   * fixed (known). The initial front is formed from the nodes in the node
+   * queue. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
+    errNum = WlzCMeshFMarInitSeeds3D(&nodQ, mesh, distances, fmNFlags,
+    				     nSeeds, seeds);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    band = WlzCMeshFIMBand3D(arr);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((nodQEntP = (WlzCMeshFMarQEnt *)AlcHeapTop(nodQ)) != NULL)
+    {
+      fNod[nF] = ((WlzCMeshNod3D *)(nodQEntP->entity))->idx;
+      fmNFlags[fNod[nF]] |= WLZ_CMESH_NOD_FLAG_ACTIVE;
+      ++nF;
+      AlcHeapEntFree(nodQ);
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (nF > 0))
+  {
+    /* Make the front nodes with distances within the band of the
+     * minimum front distance active, the other front nodes are
+     * deferred to later iterations. */
+    thr = DBL_MAX;
+    for(idF = 0; idF < nF; ++idF)
+    {
+      fD = distances[fNod[idF]];
+      if(fD < thr)
+      {
+        thr = fD;
+      }
+    }
+    thr += band;
+    nA = 0;
+    idC = 0;
+    for(idF = 0; idF < nF; ++idF)
+    {
+      idN = fNod[idF];
+      if(distances[idN] <= thr)
+      {
+	fItr[idN] = itr;
+	fmNFlags[idN] &= ~(WLZ_CMESH_NOD_FLAG_ACTIVE);
+        aNod[nA++] = idN;
+      }
+      else
+      {
+        fNod[idC++] = idN;
+      }
+    }
+    nF = idC;
+    /* Collect the nodes which share an element with an active front node
+     * and which do not have a known distance. */
+    nC = 0;
+    for(idF = 0; idF < nA; ++idF)
+    {
+      int	idR;
+
+      fD = distances[aNod[idF]];
+      for(idR = arr->ringOff[aNod[idF]]; idR < arr->ringOff[aNod[idF] + 1];
+          ++idR)
+      {
+	int	*eNod;
+
+	eNod = arr->elmNod + 4 * (arr->ringElm[idR] / 4);
+	for(idN = 0; idN < 4; ++idN)
+	{
+	  int	cIdx;
+
+	  cIdx = eNod[idN];
+	  if(((fmNFlags[cIdx] & WLZ_CMESH_NOD_FLAG_KNOWN) == 0) &&
+	     (cItr[cIdx] != itr) && (distances[cIdx] > fD))
+	  {
+	    cItr[cIdx] = itr;
+	    cNod[nC++] = cIdx;
+	  }
+	}
+      }
+    }
+    /* Compute the candidate node distances. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idC = 0; idC < nC; ++idC)
+    {
+      cDist[idC] = WlzCMeshFIMUpdate3D(arr, cNod[idC], distances, fItr, itr);
+    }
+    /* Update the distances and add the nodes with changed distances
+     * to the front. */
+    for(idC = 0; idC < nC; ++idC)
+    {
+      idN = cNod[idC];
+      if(cDist[idC] < distances[idN] * (1.0 - relTol))
+      {
+        distances[idN] = cDist[idC];
+	if((fmNFlags[idN] & WLZ_CMESH_NOD_FLAG_ACTIVE) == 0)
+	{
+	  fmNFlags[idN] |= WLZ_CMESH_NOD_FLAG_ACTIVE;
+	  fNod[nF++] = idN;
+	}
+      }
+    }
+    ++itr;
+  }
+  WlzCMeshArrFree3D(arr);
+  AlcFree(fmNFlags);
+  AlcFree(cItr);
+  AlcFree(fItr);
+  AlcFree(cDist);
+  AlcFree(aNod);
+  AlcFree(cNod);
+  AlcFree(fNod);
+  AlcHeapFree(nodQ);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Creates a node queue and then initialises it and the
+* 		distances of the nodes close to the given seeds, or to the
+* 		boundary nodes of the mesh if there are no seeds.
+* \param	dstNodQ			Destination pointer for the new node
+* 					queue, which should be freed by the
+* 					caller even if an error is returned.
+* \param	mesh			Given mesh.
+* \param	distances		Array of distances which have all
+* 					been set to DBL_MAX.
+* \param	fmNFlags		Node flags for fast marching which
+* 					have all been cleared.
+* \param	nSeeds			Number of seeds, if \f$<\f$ 1
+* 					then all boundary nodes of the
+* 					given mesh are used as seeds.
+* \param	seeds			Array of seed positions.
+*/
+static WlzErrorNum WlzCMeshFMarInitSeeds2D(AlcHeap **dstNodQ,
+				WlzCMesh2D *mesh, double *distances,
+				int *fmNFlags, int nSeeds, WlzDVertex2 *seeds)
+{
+  int		idN,
+  		idS,
+		cnt;
+  WlzCMeshNod2D	*nod0;
+  AlcHeap	*nodQ = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((cnt = WlzCMeshCountBoundNodes2D(mesh)) <= 0)
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  else if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nSeeds > 0)
+    {
+      errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
+                                      distances, fmNFlags, nSeeds, seeds);
+    }
+    else
+    {
+      nSeeds = cnt;
+      if((seeds = (WlzDVertex2 *)
+                  AlcMalloc(nSeeds * sizeof(WlzDVertex2))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	idS = 0;
+        for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+	{
+	  nod0 = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  if((nod0->idx >= 0) && (WlzCMeshNodIsBoundary2D(nod0) != 0))
+	  {
+	    seeds[idS] = nod0->pos;
+	    ++idS;
+	  }
+	}
+	errNum = WlzCMeshFMarAddSeeds2D(nodQ, mesh, cnt + 1,
+				        distances, fmNFlags, nSeeds, seeds);
+	AlcFree(seeds);
+      }
     }
   }
-  /* Clear up. */
-  AlcFree(fmNFlags);
-  AlcHeapFree(elmQ);
-  AlcHeapFree(nodQ);
+  *dstNodQ = nodQ;
   return(errNum);
 }
 
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzMesh
-* \brief	Computes constrained distances within a mesh by
-* 		propagating wavefronts within a 3D conforming mesh. The
-* 		wavefronts are propagated from either the mesh boundary
-* 		or a number of seed positions within the mesh.
-* 		The given mesh will not be modified.
+* \brief	Creates a node queue and then initialises it and the
+* 		distances of the nodes close to the given seeds, or to the
+* 		boundary nodes of the mesh if there are no seeds.
+* \param	dstNodQ			Destination pointer for the new node
+* 					queue, which should be freed by the
+* 					caller even if an error is returned.
 * \param	mesh			Given mesh.
-* \param	distances		Array for computed distances.
-* \param	nSeeds			Number of seed nodes, if \f$<\f$ 1
+* \param	distances		Array of distances which have all
+* 					been set to DBL_MAX.
+* \param	fmNFlags		Node flags for fast marching which
+* 					have all been cleared.
+* \param	nSeeds			Number of seeds, if \f$<\f$ 1
 * 					then all boundary nodes of the
-* 					given mesh are used as seed nodes.
-* \param	seeds			Array of seed positions, may be
-* 					NULL iff the number of seed nodes
-* 					is \f$<\f$ 1. It is an error if
-* 					any seeds are not within the
-* 					mesh.
+* 					given mesh are used as seeds.
+* \param	seeds			Array of seed positions.
 */
-WlzErrorNum	WlzCMeshFMarNodes3D(WlzCMesh3D *mesh, double *distances,
-				int nSeeds, WlzDVertex3 *seeds)
+static WlzErrorNum WlzCMeshFMarInitSeeds3D(AlcHeap **dstNodQ,
+				WlzCMesh3D *mesh, double *distances,
+				int *fmNFlags, int nSeeds, WlzDVertex3 *seeds)
 {
-  int		idM,
-  		idN,
-		idP,
+  int		idN,
   		idS,
 		cnt;
-  int		*fmNFlags = NULL;
-  WlzCMeshNod3D	*nod0,
-                *nod1;
-  WlzCMeshNod3D	*nodes[4];
-  WlzCMeshElm3D	*elm;
-  AlcHeap *nodQ = NULL;
-  AlcHeap *elmQ = NULL;
-  WlzCMeshFMarQEnt *nodQEntP;
-  WlzCMeshFMarElmQEnt *elmQEntP = NULL;
+  WlzCMeshNod3D	*nod0;
+  AlcHeap	*nodQ = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if(mesh == NULL)
-  {
-    errNum = WLZ_ERR_DOMAIN_NULL;
-  }
-  else if(mesh->type != WLZ_CMESH_3D)
-  {
-    errNum = WLZ_ERR_DOMAIN_TYPE;
-  }
-  else if((distances == NULL) || ((nSeeds > 0) && (seeds == NULL)))
-  {
-    errNum = WLZ_ERR_PARAM_NULL;
-  }
-  /* Set distance for all mesh nodes to maximum value. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    WlzValueSetDouble(distances, DBL_MAX, mesh->res.nod.maxEnt);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    if((fmNFlags = (int *)AlcCalloc(mesh->res.nod.maxEnt, sizeof(int))) == NULL)
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-  }
-  if(errNum == WLZ_ERR_NONE)
+  if((cnt = WlzCMeshCountBoundNodes3D(mesh)) <= 0)
   {
-    if((cnt = WlzCMeshCountBoundNodes3D(mesh)) <= 0)
-    {
-      errNum = WLZ_ERR_DOMAIN_DATA;
-    }
+    errNum = WLZ_ERR_DOMAIN_DATA;
   }
-  /* Create and then initialise the active node queue using the given seed
-   * or boundary nodes. */
-  if(errNum == WLZ_ERR_NONE)
+  else if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
   {
-    if((nodQ = AlcHeapNew(sizeof(WlzCMeshFMarQEnt), cnt, NULL)) == NULL)
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -749,82 +1484,240 @@ WlzErrorNum	WlzCMeshFMarNodes3D(WlzCMesh3D *mesh, double *distances,
       }
     }
   }
-  /* Create element queue. */
-  if(errNum == WLZ_ERR_NONE)
+  *dstNodQ = nodQ;
+  return(errNum);
+}
+
+/*!
+* \return	Width of the distance band.
+* \ingroup	WlzMesh
+* \brief	Computes the width of the band of distances within which
+* 		front nodes are made active by WlzCMeshFIMNodes2D(). The
+* 		width is the mean length of the first edge of each node.
+* 		Restricting the active front to a narrow band avoids
+* 		repeatedly updating nodes far ahead of the nodes with
+* 		settled distances.
+* \param	mesh			Given mesh.
+*/
+static double	WlzCMeshFIMBand2D(WlzCMesh2D *mesh)
+{
+  int		idN,
+  		cnt = 0;
+  double	sum = 0.0,
+  		band = 1.0;
+  WlzDVertex2	del;
+  WlzCMeshNod2D	*nod;
+
+  for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
   {
-    if((elmQ = AlcHeapNew(sizeof(WlzCMeshFMarElmQEnt), 1024, NULL)) == NULL)
+    nod = (WlzCMeshNod2D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+    if((nod->idx >= 0) && (nod->edu != NULL))
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      WLZ_VTX_2_SUB(del, nod->edu->next->nod->pos, nod->pos);
+      sum += WLZ_VTX_2_LENGTH(del);
+      ++cnt;
     }
   }
-  /* Until the queue is empty: Pop the node with lowest priority (ie
-   * lowest distance) from the queue, and process it. */
-  while((errNum == WLZ_ERR_NONE) &&
-	((nodQEntP = (WlzCMeshFMarQEnt *)AlcHeapTop(nodQ)) != NULL))
+  if((cnt > 0) && (sum > DBL_EPSILON))
   {
-    /* Find all neighbouring nodes that are neither active nor upwind.
-     * For each of these neighbouring nodes, compute their distance, set
-     * them to active and insert them into the queue.*/
-    nod0 = (WlzCMeshNod3D *)(nodQEntP->entity);
-    AlcHeapEntFree(nodQ);
-    if((fmNFlags[nod0->idx] & WLZ_CMESH_NOD_FLAG_UPWIND) == 0)
+    band = sum / cnt;
+  }
+  return(band);
+}
+
+/*!
+* \return	Width of the distance band.
+* \ingroup	WlzMesh
+* \brief	Computes the width of the band of distances within which
+* 		front nodes are made active by WlzCMeshFIMNodes3D(). The
+* 		width is the mean length of the first edge of each node.
+* 		Restricting the active front to a narrow band avoids
+* 		repeatedly updating nodes far ahead of the nodes with
+* 		settled distances.
+* \param	arr			Compact copy of the given mesh.
+*/
+static double	WlzCMeshFIMBand3D(WlzCMeshArr3D *arr)
+{
+  int		idN,
+  		cnt = 0;
+  double	sum = 0.0,
+  		band = 1.0;
+  WlzDVertex3	del;
+
+  for(idN = 0; idN < arr->maxNod; ++idN)
+  {
+    if((arr->nodIdx[idN] >= 0) && (arr->ringOff[idN] < arr->ringOff[idN + 1]))
     {
-      errNum = WlzCMeshFMarElmQInit3D(elmQ, nod0, fmNFlags);
-      if(errNum == WLZ_ERR_NONE)
+      int	oIdx;
+
+      oIdx = arr->ringNod[arr->ringOff[idN]];
+      del.vtX = arr->nodX[oIdx] - arr->nodX[idN];
+      del.vtY = arr->nodY[oIdx] - arr->nodY[idN];
+      del.vtZ = arr->nodZ[oIdx] - arr->nodZ[idN];
+      sum += WLZ_VTX_3_LENGTH(del);
+      ++cnt;
+    }
+  }
+  if((cnt > 0) && (sum > DBL_EPSILON))
+  {
+    band = sum / cnt;
+  }
+  return(band);
+}
+
+/*!
+* \return	Updated distance of the given node.
+* \ingroup	WlzMesh
+* \brief	Computes an updated distance for the given node of a 2D
+* 		conforming mesh from the distances of the other nodes of
+* 		the elements which use it. Only elements with a node
+* 		which is in the current front are used, since the
+* 		distances computed using the other elements can not have
+* 		changed. The distances are only read so this function
+* 		may be called concurrently.
+* \param	nod			Given node.
+* \param	distances		Array of distances indexed by the
+* 					mesh node indices.
+* \param	fItr			Array of the iterations at which
+* 					the nodes were last in the front,
+* 					indexed by the mesh node indices.
+* \param	itr			Current iteration.
+*/
+static double	WlzCMeshFIMUpdate2D(WlzCMeshNod2D *nod, double *distances,
+				    int *fItr, int itr)
+{
+  double	d,
+  		d0,
+		d1,
+		dMin;
+  WlzCMeshNod2D	*nod0,
+  		*nod1;
+  WlzCMeshEdgU2D *edu0,
+  		*edu1;
+  const double	dMax = DBL_MAX / 2.0;
+
+  dMin = distances[nod->idx];
+  edu0 = edu1 = nod->edu;
+  do
+  {
+    nod0 = edu1->next->nod;
+    nod1 = edu1->next->next->nod;
+    if((fItr[nod0->idx] == itr) || (fItr[nod1->idx] == itr))
+    {
+      d0 = distances[nod0->idx];
+      d1 = distances[nod1->idx];
+      if((d0 < dMax) && (d1 < dMax))
       {
-	/* While element list is not empty, remove element and compute all
-	 * node distances for it. */
-	while((elmQEntP = (WlzCMeshFMarElmQEnt *)AlcHeapTop(elmQ)) != NULL)
-	{
-	  elm = elmQEntP->elm.e3;
-	  AlcHeapEntFree(elmQ);
-	  /* Compute distances: Find the elements nodes, sort them by
-	   * distance and then compute the unknown node distances. */
-	  nodes[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
-	  nodes[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
-	  nodes[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
-	  nodes[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
-	  for(idM = 0; idM < 3; ++idM)
-	  {
-	    idP = idM;
-	    for(idN = idM + 1; idN < 4; ++idN)
-	    {
-	      if(distances[nodes[idN]->idx] < distances[nodes[idP]->idx])
-	      {
-	        idP = idN;
-	      }
-	    }
-	    nod1 = nodes[idM]; nodes[idM] = nodes[idP]; nodes[idP] = nod1;
-	  }
-	  if(WlzCMeshFMarCompute3D(nodes[0], nodes[1], nodes[2], nodes[3],
-				   distances, fmNFlags, elm) != 0)
-	  {
-	    errNum = WlzCMeshFMarQInsertNod3D(nodQ, nodes[3],
-					      fmNFlags + nodes[3]->idx,
-					      distances[nodes[3]->idx]);
-	    if(errNum != WLZ_ERR_NONE)
-	    {
-	      break;
-	    }
-	  }
-	}
-	/* Set the current node to be upwind. */
-	if(errNum == WLZ_ERR_NONE)
+	d = WlzCMeshFMarSolve2D2(nod0->pos, nod1->pos, nod->pos, d0, d1);
+      }
+      else if(d0 < dMax)
+      {
+	d = d0 + WlzGeomDist2D(nod0->pos, nod->pos);
+      }
+      else
+      {
+	d = d1 + WlzGeomDist2D(nod1->pos, nod->pos);
+      }
+      if(d < dMin)
+      {
+	dMin = d;
+      }
+    }
+    edu1 = edu1->nnxt;
+  } while(edu1 != edu0);
+  return(dMin);
+}
+
+/*!
+* \return	Updated distance of the given node.
+* \ingroup	WlzMesh
+* \brief	Computes an updated distance for the given node of a 3D
+* 		conforming mesh from the distances of the other nodes of
+* 		the elements which use it. As for WlzCMeshFIMUpdate2D()
+* 		only elements with a node in the current front are used.
+* 		The distances are only read so this function may be
+* 		called concurrently.
+* \param	arr			Compact copy of the mesh.
+* \param	idx			Index of the given node.
+* \param	distances		Array of distances indexed by the
+* 					mesh node indices.
+* \param	fItr			Array of the iterations at which
+* 					the nodes were last in the front,
+* 					indexed by the mesh node indices.
+* \param	itr			Current iteration.
+*/
+static double	WlzCMeshFIMUpdate3D(WlzCMeshArr3D *arr, int idx,
+				    double *distances, int *fItr, int itr)
+{
+  int		idN,
+  		idR,
+  		nF,
+  		nK;
+  double	d,
+		dMin;
+  double	dK[3];
+  WlzDVertex2	q0,
+  		q1,
+		q2;
+  WlzDVertex3	pos;
+  WlzDVertex3	kPos[3];
+  const double	dMax = DBL_MAX / 2.0;
+
+  WLZ_VTX_2_SET(q0, 0.0, 0.0);
+  WLZ_VTX_3_SET(pos, arr->nodX[idx], arr->nodY[idx], arr->nodZ[idx]);
+  dMin = distances[idx];
+  for(idR = arr->ringOff[idx]; idR < arr->ringOff[idx + 1]; ++idR)
+  {
+    int		fce;
+    int		*eNod;
+
+    fce = arr->ringElm[idR] % 4;
+    eNod = arr->elmNod + 4 * (arr->ringElm[idR] / 4);
+    /* The node is in three faces of each element which uses it, so only
+     * use an element when visiting it's first face which has the node:
+     * face 0 unless the node is node 3 (which is not in face 0). */
+    if((fce == 0) || ((fce == 1) && (eNod[3] == idx)))
+    {
+      nF = 0;
+      nK = 0;
+      for(idN = 0; idN < 4; ++idN)
+      {
+	int	kIdx;
+
+	kIdx = eNod[idN];
+	if((kIdx != idx) && (distances[kIdx] < dMax))
 	{
-	  fmNFlags[nod0->idx] = (fmNFlags[nod0->idx] &
-	                        ~(WLZ_CMESH_NOD_FLAG_ACTIVE)) |
-			       WLZ_CMESH_NOD_FLAG_KNOWN |
-			       WLZ_CMESH_NOD_FLAG_UPWIND;
+	  WLZ_VTX_3_SET(kPos[nK],
+	                arr->nodX[kIdx], arr->nodY[kIdx], arr->nodZ[kIdx]);
+	  dK[nK] = distances[kIdx];
+	  nF += fItr[kIdx] == itr;
+	  ++nK;
 	}
       }
-      AlcHeapAllEntFree(elmQ, 0);
+      switch((nF > 0)? nK: 0)
+      {
+	case 1:
+	  d = dK[0] + WlzGeomDist3D(kPos[0], pos);
+	  break;
+	case 2:
+	  WlzGeomMap3DTriangleTo2D(kPos[0], kPos[1], pos, &q1, &q2);
+	  d = WlzCMeshFMarSolve2D2(q0, q1, q2, dK[0], dK[1]);
+	  break;
+	case 3:
+	  d = WlzCMeshFMarSolve3D3(kPos[0], kPos[1], kPos[2], pos,
+				   dK[0], dK[1], dK[2], dMin);
+	  break;
+	default:
+	  d = DBL_MAX;
+	  break;
+      }
+      if(d < dMin)
+      {
+	dMin = d;
+      }
     }
   }
-  /* Clear up. */
-  AlcFree(fmNFlags);
-  AlcHeapFree(elmQ);
-  AlcHeapFree(nodQ);
-  return(errNum);
+  return(dMin);
 }
 
 /*!
@@ -1378,10 +2271,11 @@ static int	WlzCMeshFMarCompute3D2(WlzCMeshNod3D *nod0,
 }
 
 /*!
-* \return	Non zero if distance computed and less than current distance.
+* \return	Distance of the unknown node, which is never greater than
+* 		the given current distance of the unknown node.
 * \ingroup	WlzMesh
-* \brief	Computes wavefront propagation time for the unknown nodes of
-* 		the given element.
+* \brief	Computes wavefront propagation time for the unknown node of
+* 		a tetrahedral element.
 * 		This function is given three known nodes and computes the
 * 		times for the remaining node using the following method.
 * 		The solution is similar to that in "Fast Sweeping Methods
@@ -1435,25 +2329,29 @@ static int	WlzCMeshFMarCompute3D2(WlzCMeshNod3D *nod0,
 *		\f$\mathbf{Q}\f$ must be within the triangle.  If this is
 *		not satisfied the time value is the minimum for the path
 *		along the other three faces.
-* \param	nod0			First (current) known node.
-* \param	nod1			Second known node.
-* \param	nod2			Third known node.
-* \param	nod3			Unknown node.
-* \param	distances		Array of distances indexed by the
-* 					mesh node indices, which will be
-* 					set for the unknown node on return.
+* 		This function does not modify the mesh or any distances
+* 		so it may be called concurrently.
+* \param	pos0			Position of the first (current) known
+* 					node.
+* \param	pos1			Position of the second known node.
+* \param	pos2			Position of the third known node.
+* \param	pos3			Position of the unknown node.
+* \param	dist0			Distance of the first known node.
+* \param	dist1			Distance of the second known node.
+* \param	dist2			Distance of the third known node.
+* \param	dist3			Current distance of the unknown node.
 */
-static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
-                                       WlzCMeshNod3D *nod1,
-                                       WlzCMeshNod3D *nod2,
-                                       WlzCMeshNod3D *nod3,
-				       double *distances)
+static double	WlzCMeshFMarSolve3D3(WlzDVertex3 pos0,
+                                     WlzDVertex3 pos1,
+                                     WlzDVertex3 pos2,
+                                     WlzDVertex3 pos3,
+				     double dist0, double dist1,
+				     double dist2, double dist3)
 {
   int		id0,
   		id1,
 		hit = 0,
-		par = 0,
-		rtn = 0;
+		par = 0;
   double	a,
 		a2,
   		b,
@@ -1468,7 +2366,9 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
 		f,
 		f2,
 		g,
-		h;
+		h,
+		tD;
+  double	dst[4];
   WlzDVertex2	q0,
   		q1,
 		q2;
@@ -1476,31 +2376,31 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
 		n1,
 		t0,
 		t1;
-  WlzDVertex3	l[4];
-  WlzCMeshNod3D	*tNod;
-  WlzCMeshNod3D	*nod[8];
-
-  /* Sort nodes 0 - 2, by time st distances[nod[0]->idx] <=
-   * distances[nod[1]->idx] <= distances[nod[2]->idx]. */
-  nod[0] = nod0;
-  nod[1] = nod1;
-  nod[2] = nod2;
-  nod[3] = nod3;
+  WlzDVertex3	tPos;
+  WlzDVertex3	l[4],
+  		pos[4];
+
+  /* Sort nodes 0 - 2, by time st dst[0] <= dst[1] <= dst[2]. */
+  pos[0] = pos0; dst[0] = dist0;
+  pos[1] = pos1; dst[1] = dist1;
+  pos[2] = pos2; dst[2] = dist2;
+  pos[3] = pos3; dst[3] = dist3;
   for(id0 = 0; id0 < 3; ++id0)
   {
     for(id1 = id0 + 1; id1 < 3; ++id1)
     {
-      if(*(distances + nod[id1]->idx) < *(distances + nod[id0]->idx))
+      if(dst[id1] < dst[id0])
       {
-        tNod = nod[id0]; nod[id0] = nod[id1]; nod[id1] = tNod;
+        tPos = pos[id0]; pos[id0] = pos[id1]; pos[id1] = tPos;
+	tD = dst[id0]; dst[id0] = dst[id1]; dst[id1] = tD;
       }
     }
   }
-  /* Compute vectors and distances relative to nod[0]. */
-  WLZ_VTX_3_SUB(l[1], nod[1]->pos, nod[0]->pos);
-  WLZ_VTX_3_SUB(l[2], nod[2]->pos, nod[0]->pos);
-  d1 = *(distances + nod[1]->idx) - *(distances + nod[0]->idx);
-  d2 = *(distances + nod[2]->idx) - *(distances + nod[0]->idx);
+  /* Compute vectors and distances relative to pos[0]. */
+  WLZ_VTX_3_SUB(l[1], pos[1], pos[0]);
+  WLZ_VTX_3_SUB(l[2], pos[2], pos[0]);
+  d1 = dst[1] - dst[0];
+  d2 = dst[2] - dst[0];
   a = WLZ_VTX_3_LENGTH(l[1]);
   b = WLZ_VTX_3_LENGTH(l[2]);
   if((a < d1) && (b < d2))
@@ -1533,16 +2433,16 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     n1.vtX =  (d + b * n1.vtZ) / a;
     /* Have two solutions for the normal: n0 and n1, choose the one that runs
      * from the centre of the triangle formed by nodes 0, 1 and 2 to node 3. */
-    WLZ_VTX_3_ADD3(t0, nod[0]->pos, nod[1]->pos, nod[2]->pos);
+    WLZ_VTX_3_ADD3(t0, pos[0], pos[1], pos[2]);
     WLZ_VTX_3_SCALE(t0, t0, 1.0 / 3.0);
-    WLZ_VTX_3_SUB(t1, nod[3]->pos, t0);
+    WLZ_VTX_3_SUB(t1, pos[3], t0);
     a = WLZ_VTX_3_DOT(n0, t1);
     if(a < 0)
     {
       n0 = n1;
     }
-    hit = WlzGeomLineTriangleIntersect3D(nod[3]->pos, n0,
-					nod[0]->pos, nod[1]->pos, nod[2]->pos,
+    hit = WlzGeomLineTriangleIntersect3D(pos[3], n0,
+					pos[0], pos[1], pos[2],
 					&par, NULL, NULL, NULL);
     if(par != 0)
     {
@@ -1552,15 +2452,14 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     {
       /* Normal is through the triangle (nodes 0, 1 and 2), so compute the
        * distance at node 3: t_3 = t_0 + n . (n_3 - n_0). */
-      WLZ_VTX_3_SUB(l[3], nod[3]->pos, nod[0]->pos);
+      WLZ_VTX_3_SUB(l[3], pos[3], pos[0]);
       d = WLZ_VTX_3_DOT(n0, l[3]);
       if(d > 0.0)
       {
-	d = *(distances + nod[0]->idx) + d;
-	if(*(distances + nod[3]->idx) > d)
+	d = dst[0] + d;
+	if(dst[3] > d)
 	{
-	  *(distances + nod[3]->idx) = d;
-	  rtn = 1;
+	  dst[3] = d;
 	}
       }
     }
@@ -1572,16 +2471,13 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     for(id0 = 0; id0 < 3; ++id0)
     {
       id1 = (id0 + 1) % 3;
-      WlzGeomMap3DTriangleTo2D(nod[id0]->pos, nod[id1]->pos,
-                               nod[3]->pos, &q1, &q2);
-      d = WlzCMeshFMarSolve2D2(q0, q1, q2,
-                          distances[nod[id0]->idx],
-			  distances[nod[id1]->idx]);
-      if(d < distances[nod[3]->idx])
+      WlzGeomMap3DTriangleTo2D(pos[id0], pos[id1],
+                               pos[3], &q1, &q2);
+      d = WlzCMeshFMarSolve2D2(q0, q1, q2, dst[id0], dst[id1]);
+      if(d < dst[3])
       {
-	distances[nod[3]->idx] = d;
+	dst[3] = d;
 	hit = 1;
-	rtn = 1;
       }
     }
   }
@@ -1590,15 +2486,47 @@ static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
     /* TIf all else fails use the minimum distance along the edges. */
     for(id0 = 0; id0 < 3; ++id0)
     {
-      WLZ_VTX_3_SUB(t0, nod[3]->pos, nod[id0]->pos);
-      d = WLZ_VTX_3_LENGTH(t0) + *(distances + nod[id0]->idx);
-      if(*(distances + nod[3]->idx) > d)
+      WLZ_VTX_3_SUB(t0, pos[3], pos[id0]);
+      d = WLZ_VTX_3_LENGTH(t0) + dst[id0];
+      if(dst[3] > d)
       {
-	rtn = 1;
-	*(distances + nod[3]->idx) = d;
+	dst[3] = d;
       }
     }
   }
+  return(dst[3]);
+}
+
+/*!
+* \return	Non zero if distance computed and less than current distance.
+* \ingroup	WlzMesh
+* \brief	Computes wavefront propagation time for the unknown node of
+* 		the given element using WlzCMeshFMarSolve3D3().
+* \param	nod0			First (current) known node.
+* \param	nod1			Second known node.
+* \param	nod2			Third known node.
+* \param	nod3			Unknown node.
+* \param	distances		Array of distances indexed by the
+* 					mesh node indices, which will be
+* 					set for the unknown node on return.
+*/
+static int	WlzCMeshFMarCompute3D3(WlzCMeshNod3D *nod0,
+                                       WlzCMeshNod3D *nod1,
+                                       WlzCMeshNod3D *nod2,
+                                       WlzCMeshNod3D *nod3,
+				       double *distances)
+{
+  int		rtn = 0;
+  double	d;
+
+  d = WlzCMeshFMarSolve3D3(nod0->pos, nod1->pos, nod2->pos, nod3->pos,
+  			   distances[nod0->idx], distances[nod1->idx],
+			   distances[nod2->idx], distances[nod3->idx]);
+  if(d < distances[nod3->idx])
+  {
+    distances[nod3->idx] = d;
+    rtn = 1;
+  }
   return(rtn);
 }
 
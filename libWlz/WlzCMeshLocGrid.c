@@ -0,0 +1,753 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzCMeshLocGrid_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzCMeshLocGrid.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Flattened uniform grids over the element bounding boxes
+* 		of conforming meshes for fast location of the element
+* 		which encloses a position.
+* \ingroup	WlzMesh
+*/
+
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+/*!
+* \def		WLZ_CMESH_LOCGRID_CPE
+* \ingroup	WlzMesh
+* \brief	Maximum number of location grid cells per mesh element.
+*/
+#define WLZ_CMESH_LOCGRID_CPE	(4)
+
+static void			WlzCMeshLocGridFree2D(
+				  WlzCMeshLocGrid2D *lGrid);
+static void			WlzCMeshLocGridFree3D(
+				  WlzCMeshLocGrid3D *lGrid);
+static WlzCMeshLocGrid2D	*WlzCMeshLocGridMake2D(
+				  WlzCMesh2D *mesh,
+				  WlzErrorNum *dstErr);
+static WlzCMeshLocGrid3D	*WlzCMeshLocGridMake3D(
+				  WlzCMesh3D *mesh,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Makes an element location grid for the given 2D mesh
+* 		unless the mesh already has one. The location grid is
+* 		used by WlzCMeshElmEnclosingPos2D() and is freed
+* 		whenever the mesh elements, cell grid or bounding box
+* 		are changed.
+* \param	mesh			Given mesh.
+*/
+WlzErrorNum	WlzCMeshSetLocGrid2D(WlzCMesh2D *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_2D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshSetLocGrid)
+#endif
+    {
+      if(mesh->lGrid == NULL)
+      {
+        mesh->lGrid = WlzCMeshLocGridMake2D(mesh, &errNum);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Makes an element location grid for the given 3D mesh
+* 		unless the mesh already has one. The location grid is
+* 		used by WlzCMeshElmEnclosingPos3D() and is freed
+* 		whenever the mesh elements, cell grid or bounding box
+* 		are changed.
+* \param	mesh			Given mesh.
+*/
+WlzErrorNum	WlzCMeshSetLocGrid3D(WlzCMesh3D *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(mesh->type != WLZ_CMESH_3D)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshSetLocGrid)
+#endif
+    {
+      if(mesh->lGrid == NULL)
+      {
+        mesh->lGrid = WlzCMeshLocGridMake3D(mesh, &errNum);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees the element location grid of the given 2D mesh
+* 		(if it has one).
+* \param	mesh			Given mesh.
+*/
+void		WlzCMeshFreeLocGrid2D(WlzCMesh2D *mesh)
+{
+  if(mesh && mesh->lGrid)
+  {
+    WlzCMeshLocGridFree2D(mesh->lGrid);
+    mesh->lGrid = NULL;
+  }
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees the element location grid of the given 3D mesh
+* 		(if it has one).
+* \param	mesh			Given mesh.
+*/
+void		WlzCMeshFreeLocGrid3D(WlzCMesh3D *mesh)
+{
+  if(mesh && mesh->lGrid)
+  {
+    WlzCMeshLocGridFree3D(mesh->lGrid);
+    mesh->lGrid = NULL;
+  }
+}
+
+/*!
+* \return	Index of the enclosing element or negative value if
+* 		no enclosing element is found.
+* \ingroup	WlzMesh
+* \brief	Uses the element location grid of the given 2D mesh
+* 		to find the element which encloses the given position.
+* 		The grid is not used if the mesh has no location grid or
+* 		if the number of elements or the bounding box of the
+* 		mesh have changed since the grid was made.
+* 		Only the elements with bounding boxes that intersect
+* 		the grid cell which contains the position are tested.
+* \param	mesh			Given mesh.
+* \param	pos			Given position.
+*/
+int		WlzCMeshLocGridElmPos2D(WlzCMesh2D *mesh, WlzDVertex2 pos)
+{
+  int		elmIdx = -1;
+  WlzCMeshLocGrid2D *lGrid;
+
+  if(((lGrid = mesh->lGrid) != NULL) &&
+     (lGrid->nElm == mesh->res.elm.numEnt) &&
+     (lGrid->bBox.xMin == mesh->bBox.xMin) &&
+     (lGrid->bBox.yMin == mesh->bBox.yMin) &&
+     (lGrid->bBox.xMax == mesh->bBox.xMax) &&
+     (lGrid->bBox.yMax == mesh->bBox.yMax))
+  {
+    double	tX,
+    		tY;
+
+    tX = (pos.vtX - lGrid->org.vtX) / lGrid->cellSz;
+    tY = (pos.vtY - lGrid->org.vtY) / lGrid->cellSz;
+    if((tX >= 0.0) && (tY >= 0.0) &&
+       (tX < lGrid->nCells.vtX) && (tY < lGrid->nCells.vtY))
+    {
+      int	idC,
+      		idI,
+		idI1;
+
+      idC = ((int )tY * lGrid->nCells.vtX) + (int )tX;
+      idI1 = lGrid->cellOff[idC + 1];
+      for(idI = lGrid->cellOff[idC]; idI < idI1; ++idI)
+      {
+	int	idE;
+	WlzDBox2 *b;
+
+	idE = lGrid->elmIdx[idI];
+	b = lGrid->elmBox + idE;
+	if((pos.vtX >= b->xMin) && (pos.vtX <= b->xMax) &&
+	   (pos.vtY >= b->yMin) && (pos.vtY <= b->yMax))
+	{
+	  WlzCMeshElm2D *elm;
+
+	  elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	  if((elm->idx == idE) && WlzCMeshElmEnclosesPos2D(elm, pos))
+	  {
+	    elmIdx = idE;
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  return(elmIdx);
+}
+
+/*!
+* \return	Index of the enclosing element or negative value if
+* 		no enclosing element is found.
+* \ingroup	WlzMesh
+* \brief	Uses the element location grid of the given 3D mesh
+* 		to find the element which encloses the given position.
+* 		The grid is not used if the mesh has no location grid or
+* 		if the number of elements or the bounding box of the
+* 		mesh have changed since the grid was made.
+* 		Only the elements with bounding boxes that intersect
+* 		the grid cell which contains the position are tested.
+* \param	mesh			Given mesh.
+* \param	pos			Given position.
+*/
+int		WlzCMeshLocGridElmPos3D(WlzCMesh3D *mesh, WlzDVertex3 pos)
+{
+  int		elmIdx = -1;
+  WlzCMeshLocGrid3D *lGrid;
+
+  if(((lGrid = mesh->lGrid) != NULL) &&
+     (lGrid->nElm == mesh->res.elm.numEnt) &&
+     (lGrid->bBox.xMin == mesh->bBox.xMin) &&
+     (lGrid->bBox.yMin == mesh->bBox.yMin) &&
+     (lGrid->bBox.zMin == mesh->bBox.zMin) &&
+     (lGrid->bBox.xMax == mesh->bBox.xMax) &&
+     (lGrid->bBox.yMax == mesh->bBox.yMax) &&
+     (lGrid->bBox.zMax == mesh->bBox.zMax))
+  {
+    double	tX,
+    		tY,
+		tZ;
+
+    tX = (pos.vtX - lGrid->org.vtX) / lGrid->cellSz;
+    tY = (pos.vtY - lGrid->org.vtY) / lGrid->cellSz;
+    tZ = (pos.vtZ - lGrid->org.vtZ) / lGrid->cellSz;
+    if((tX >= 0.0) && (tY >= 0.0) && (tZ >= 0.0) &&
+       (tX < lGrid->nCells.vtX) && (tY < lGrid->nCells.vtY) &&
+       (tZ < lGrid->nCells.vtZ))
+    {
+      int	idC,
+      		idI,
+		idI1;
+
+      idC = ((((int )tZ * lGrid->nCells.vtY) + (int )tY) *
+             lGrid->nCells.vtX) + (int )tX;
+      idI1 = lGrid->cellOff[idC + 1];
+      for(idI = lGrid->cellOff[idC]; idI < idI1; ++idI)
+      {
+	int	idE;
+	WlzDBox3 *b;
+
+	idE = lGrid->elmIdx[idI];
+	b = lGrid->elmBox + idE;
+	if((pos.vtX >= b->xMin) && (pos.vtX <= b->xMax) &&
+	   (pos.vtY >= b->yMin) && (pos.vtY <= b->yMax) &&
+	   (pos.vtZ >= b->zMin) && (pos.vtZ <= b->zMax))
+	{
+	  WlzCMeshElm3D *elm;
+
+	  elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	  if((elm->idx == idE) && WlzCMeshElmEnclosesPos3D(elm, pos))
+	  {
+	    elmIdx = idE;
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  return(elmIdx);
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees a 2D element location grid.
+* \param	lGrid			Given location grid.
+*/
+static void	WlzCMeshLocGridFree2D(WlzCMeshLocGrid2D *lGrid)
+{
+  if(lGrid)
+  {
+    AlcFree(lGrid->cellOff);
+    AlcFree(lGrid->elmIdx);
+    AlcFree(lGrid->elmBox);
+    AlcFree(lGrid);
+  }
+}
+
+/*!
+* \ingroup	WlzMesh
+* \brief	Frees a 3D element location grid.
+* \param	lGrid			Given location grid.
+*/
+static void	WlzCMeshLocGridFree3D(WlzCMeshLocGrid3D *lGrid)
+{
+  if(lGrid)
+  {
+    AlcFree(lGrid->cellOff);
+    AlcFree(lGrid->elmIdx);
+    AlcFree(lGrid->elmBox);
+    AlcFree(lGrid);
+  }
+}
+
+/*!
+* \return	New location grid or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes an element location grid for the given 2D mesh.
+* 		The cell size is the mean of the element bounding box
+* 		sizes, increased if required so that there are no more
+* 		than WLZ_CMESH_LOCGRID_CPE cells per element. The element
+* 		bounding boxes are expanded by WLZ_MESH_TOLERANCE times
+* 		the cell size so that positions on element boundaries
+* 		are found.
+* \param	mesh			Given mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzCMeshLocGrid2D *WlzCMeshLocGridMake2D(WlzCMesh2D *mesh,
+					WlzErrorNum *dstErr)
+{
+  int		idC,
+  		idE,
+		nElm = 0,
+		nCells = 0,
+		maxElm;
+  double	eps,
+		sumSz = 0.0;
+  WlzDBox2	gBox;
+  WlzCMeshLocGrid2D *lGrid = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  maxElm = mesh->res.elm.maxEnt;
+  if(((lGrid = (WlzCMeshLocGrid2D *)
+               AlcCalloc(1, sizeof(WlzCMeshLocGrid2D))) == NULL) ||
+     ((lGrid->elmBox = (WlzDBox2 *)
+                       AlcMalloc(sizeof(WlzDBox2) *
+		                 ((maxElm > 0)? maxElm: 1))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Compute the element bounding boxes and their union. */
+    gBox.xMin = gBox.yMin = DBL_MAX;
+    gBox.xMax = gBox.yMax = -DBL_MAX;
+    for(idE = 0; idE < maxElm; ++idE)
+    {
+      WlzCMeshElm2D *elm;
+
+      elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      if(elm->idx >= 0)
+      {
+	int	idN;
+	WlzDBox2 *b;
+
+	b = lGrid->elmBox + idE;
+	b->xMin = b->xMax = elm->edu[0].nod->pos.vtX;
+	b->yMin = b->yMax = elm->edu[0].nod->pos.vtY;
+	for(idN = 1; idN < 3; ++idN)
+	{
+	  WlzDVertex2 p;
+
+	  p = elm->edu[idN].nod->pos;
+	  b->xMin = ALG_MIN(b->xMin, p.vtX);
+	  b->xMax = ALG_MAX(b->xMax, p.vtX);
+	  b->yMin = ALG_MIN(b->yMin, p.vtY);
+	  b->yMax = ALG_MAX(b->yMax, p.vtY);
+	}
+	sumSz += ALG_MAX(b->xMax - b->xMin, b->yMax - b->yMin);
+	gBox.xMin = ALG_MIN(gBox.xMin, b->xMin);
+	gBox.yMin = ALG_MIN(gBox.yMin, b->yMin);
+	gBox.xMax = ALG_MAX(gBox.xMax, b->xMax);
+	gBox.yMax = ALG_MAX(gBox.yMax, b->yMax);
+	++nElm;
+      }
+    }
+    if(nElm < 1)
+    {
+      gBox.xMin = gBox.yMin = gBox.xMax = gBox.yMax = 0.0;
+      sumSz = 1.0;
+      nElm = 0;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    double	sz,
+    		ext[2];
+
+    ext[0] = gBox.xMax - gBox.xMin;
+    ext[1] = gBox.yMax - gBox.yMin;
+    sz = sumSz / ALG_MAX(nElm, 1);
+    if(sz < DBL_EPSILON)
+    {
+      sz = 1.0;
+    }
+    while(((ext[0] / sz) + 1.0) * ((ext[1] / sz) + 1.0) >
+          (double )(WLZ_CMESH_LOCGRID_CPE) * ALG_MAX(nElm, 1))
+    {
+      sz *= 1.25;
+    }
+    eps = WLZ_MESH_TOLERANCE * sz;
+    lGrid->cellSz = sz;
+    lGrid->org.vtX = gBox.xMin - eps;
+    lGrid->org.vtY = gBox.yMin - eps;
+    lGrid->nCells.vtX = (int )floor((ext[0] + 2.0 * eps) / sz) + 1;
+    lGrid->nCells.vtY = (int )floor((ext[1] + 2.0 * eps) / sz) + 1;
+    lGrid->nElm = mesh->res.elm.numEnt;
+    lGrid->bBox = mesh->bBox;
+    nCells = lGrid->nCells.vtX * lGrid->nCells.vtY;
+    if((lGrid->cellOff = (int *)
+                         AlcCalloc(nCells + 1, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		pass;
+
+    /* In the first pass count the elements which intersect each cell
+     * then in the second pass fill in the element indices. */
+    for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+    {
+      for(idE = 0; idE < maxElm; ++idE)
+      {
+	WlzCMeshElm2D *elm;
+
+	elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	if(elm->idx >= 0)
+	{
+	  WlzDBox2 *b;
+	  WlzIVertex2 c,
+	  	    c0,
+		    c1;
+
+	  b = lGrid->elmBox + idE;
+	  if(pass == 0)
+	  {
+	    b->xMin -= eps; b->yMin -= eps;
+	    b->xMax += eps; b->yMax += eps;
+	  }
+	  c0.vtX = (int )floor((b->xMin - lGrid->org.vtX) / lGrid->cellSz);
+	  c0.vtY = (int )floor((b->yMin - lGrid->org.vtY) / lGrid->cellSz);
+	  c1.vtX = (int )floor((b->xMax - lGrid->org.vtX) / lGrid->cellSz);
+	  c1.vtY = (int )floor((b->yMax - lGrid->org.vtY) / lGrid->cellSz);
+	  c0.vtX = ALG_MAX(c0.vtX, 0);
+	  c0.vtY = ALG_MAX(c0.vtY, 0);
+	  c1.vtX = ALG_MIN(c1.vtX, lGrid->nCells.vtX - 1);
+	  c1.vtY = ALG_MIN(c1.vtY, lGrid->nCells.vtY - 1);
+	  for(c.vtY = c0.vtY; c.vtY <= c1.vtY; ++c.vtY)
+	  {
+	    for(c.vtX = c0.vtX; c.vtX <= c1.vtX; ++c.vtX)
+	    {
+	      idC = (c.vtY * lGrid->nCells.vtX) + c.vtX;
+	      if(pass == 0)
+	      {
+		++(lGrid->cellOff[idC + 1]);
+	      }
+	      else
+	      {
+		lGrid->elmIdx[(lGrid->cellOff[idC + 1])++] = idE;
+	      }
+	    }
+	  }
+	}
+      }
+      if(pass == 0)
+      {
+	/* Cumulate counts into the offsets of the cell ends, then shift
+	 * them so that the second pass can use cellOff[i + 1] as the
+	 * insertion point of cell i. */
+	for(idC = 1; idC <= nCells; ++idC)
+	{
+	  lGrid->cellOff[idC] += lGrid->cellOff[idC - 1];
+	}
+	if((lGrid->elmIdx = (int *)
+	                    AlcMalloc(sizeof(int) *
+			              ALG_MAX(lGrid->cellOff[nCells], 1))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	for(idC = nCells; idC > 0; --idC)
+	{
+	  lGrid->cellOff[idC] = lGrid->cellOff[idC - 1];
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzCMeshLocGridFree2D(lGrid);
+    lGrid = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lGrid);
+}
+
+/*!
+* \return	New location grid or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes an element location grid for the given 3D mesh.
+* 		The cell size is the mean of the element bounding box
+* 		sizes, increased if required so that there are no more
+* 		than WLZ_CMESH_LOCGRID_CPE cells per element. The element
+* 		bounding boxes are expanded by WLZ_MESH_TOLERANCE times
+* 		the cell size so that positions on element boundaries
+* 		are found.
+* \param	mesh			Given mesh.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzCMeshLocGrid3D *WlzCMeshLocGridMake3D(WlzCMesh3D *mesh,
+					WlzErrorNum *dstErr)
+{
+  int		idC,
+  		idE,
+		nElm = 0,
+		nCells = 0,
+		maxElm;
+  double	eps,
+		sumSz = 0.0;
+  WlzDBox3	gBox;
+  WlzCMeshLocGrid3D *lGrid = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  maxElm = mesh->res.elm.maxEnt;
+  if(((lGrid = (WlzCMeshLocGrid3D *)
+               AlcCalloc(1, sizeof(WlzCMeshLocGrid3D))) == NULL) ||
+     ((lGrid->elmBox = (WlzDBox3 *)
+                       AlcMalloc(sizeof(WlzDBox3) *
+		                 ((maxElm > 0)? maxElm: 1))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Compute the element bounding boxes and their union. */
+    gBox.xMin = gBox.yMin = gBox.zMin = DBL_MAX;
+    gBox.xMax = gBox.yMax = gBox.zMax = -DBL_MAX;
+    for(idE = 0; idE < maxElm; ++idE)
+    {
+      WlzCMeshElm3D *elm;
+
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      if(elm->idx >= 0)
+      {
+	int	idN;
+	WlzDBox3 *b;
+	WlzCMeshNod3D *nod[4];
+
+	nod[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+	nod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+	nod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+	nod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+	b = lGrid->elmBox + idE;
+	b->xMin = b->xMax = nod[0]->pos.vtX;
+	b->yMin = b->yMax = nod[0]->pos.vtY;
+	b->zMin = b->zMax = nod[0]->pos.vtZ;
+	for(idN = 1; idN < 4; ++idN)
+	{
+	  WlzDVertex3 p;
+
+	  p = nod[idN]->pos;
+	  b->xMin = ALG_MIN(b->xMin, p.vtX);
+	  b->xMax = ALG_MAX(b->xMax, p.vtX);
+	  b->yMin = ALG_MIN(b->yMin, p.vtY);
+	  b->yMax = ALG_MAX(b->yMax, p.vtY);
+	  b->zMin = ALG_MIN(b->zMin, p.vtZ);
+	  b->zMax = ALG_MAX(b->zMax, p.vtZ);
+	}
+	sumSz += ALG_MAX3(b->xMax - b->xMin, b->yMax - b->yMin,
+	                  b->zMax - b->zMin);
+	gBox.xMin = ALG_MIN(gBox.xMin, b->xMin);
+	gBox.yMin = ALG_MIN(gBox.yMin, b->yMin);
+	gBox.zMin = ALG_MIN(gBox.zMin, b->zMin);
+	gBox.xMax = ALG_MAX(gBox.xMax, b->xMax);
+	gBox.yMax = ALG_MAX(gBox.yMax, b->yMax);
+	gBox.zMax = ALG_MAX(gBox.zMax, b->zMax);
+	++nElm;
+      }
+    }
+    if(nElm < 1)
+    {
+      gBox.xMin = gBox.yMin = gBox.zMin = 0.0;
+      gBox.xMax = gBox.yMax = gBox.zMax = 0.0;
+      sumSz = 1.0;
+      nElm = 0;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    double	sz,
+    		ext[3];
+
+    ext[0] = gBox.xMax - gBox.xMin;
+    ext[1] = gBox.yMax - gBox.yMin;
+    ext[2] = gBox.zMax - gBox.zMin;
+    sz = sumSz / ALG_MAX(nElm, 1);
+    if(sz < DBL_EPSILON)
+    {
+      sz = 1.0;
+    }
+    while(((ext[0] / sz) + 1.0) * ((ext[1] / sz) + 1.0) *
+          ((ext[2] / sz) + 1.0) >
+          (double )(WLZ_CMESH_LOCGRID_CPE) * ALG_MAX(nElm, 1))
+    {
+      sz *= 1.25;
+    }
+    eps = WLZ_MESH_TOLERANCE * sz;
+    lGrid->cellSz = sz;
+    lGrid->org.vtX = gBox.xMin - eps;
+    lGrid->org.vtY = gBox.yMin - eps;
+    lGrid->org.vtZ = gBox.zMin - eps;
+    lGrid->nCells.vtX = (int )floor((ext[0] + 2.0 * eps) / sz) + 1;
+    lGrid->nCells.vtY = (int )floor((ext[1] + 2.0 * eps) / sz) + 1;
+    lGrid->nCells.vtZ = (int )floor((ext[2] + 2.0 * eps) / sz) + 1;
+    lGrid->nElm = mesh->res.elm.numEnt;
+    lGrid->bBox = mesh->bBox;
+    nCells = lGrid->nCells.vtX * lGrid->nCells.vtY * lGrid->nCells.vtZ;
+    if((lGrid->cellOff = (int *)
+                         AlcCalloc(nCells + 1, sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		pass;
+
+    /* In the first pass count the elements which intersect each cell
+     * then in the second pass fill in the element indices. */
+    for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+    {
+      for(idE = 0; idE < maxElm; ++idE)
+      {
+	WlzCMeshElm3D *elm;
+
+	elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	if(elm->idx >= 0)
+	{
+	  WlzDBox3 *b;
+	  WlzIVertex3 c,
+	  	    c0,
+		    c1;
+
+	  b = lGrid->elmBox + idE;
+	  if(pass == 0)
+	  {
+	    b->xMin -= eps; b->yMin -= eps; b->zMin -= eps;
+	    b->xMax += eps; b->yMax += eps; b->zMax += eps;
+	  }
+	  c0.vtX = (int )floor((b->xMin - lGrid->org.vtX) / lGrid->cellSz);
+	  c0.vtY = (int )floor((b->yMin - lGrid->org.vtY) / lGrid->cellSz);
+	  c0.vtZ = (int )floor((b->zMin - lGrid->org.vtZ) / lGrid->cellSz);
+	  c1.vtX = (int )floor((b->xMax - lGrid->org.vtX) / lGrid->cellSz);
+	  c1.vtY = (int )floor((b->yMax - lGrid->org.vtY) / lGrid->cellSz);
+	  c1.vtZ = (int )floor((b->zMax - lGrid->org.vtZ) / lGrid->cellSz);
+	  c0.vtX = ALG_MAX(c0.vtX, 0);
+	  c0.vtY = ALG_MAX(c0.vtY, 0);
+	  c0.vtZ = ALG_MAX(c0.vtZ, 0);
+	  c1.vtX = ALG_MIN(c1.vtX, lGrid->nCells.vtX - 1);
+	  c1.vtY = ALG_MIN(c1.vtY, lGrid->nCells.vtY - 1);
+	  c1.vtZ = ALG_MIN(c1.vtZ, lGrid->nCells.vtZ - 1);
+	  for(c.vtZ = c0.vtZ; c.vtZ <= c1.vtZ; ++c.vtZ)
+	  {
+	    for(c.vtY = c0.vtY; c.vtY <= c1.vtY; ++c.vtY)
+	    {
+	      for(c.vtX = c0.vtX; c.vtX <= c1.vtX; ++c.vtX)
+	      {
+		idC = (((c.vtZ * lGrid->nCells.vtY) + c.vtY) *
+		       lGrid->nCells.vtX) + c.vtX;
+		if(pass == 0)
+		{
+		  ++(lGrid->cellOff[idC + 1]);
+		}
+		else
+		{
+		  lGrid->elmIdx[(lGrid->cellOff[idC + 1])++] = idE;
+		}
+	      }
+	    }
+	  }
+	}
+      }
+      if(pass == 0)
+      {
+	/* Cumulate counts into the offsets of the cell ends, then shift
+	 * them so that the second pass can use cellOff[i + 1] as the
+	 * insertion point of cell i. */
+	for(idC = 1; idC <= nCells; ++idC)
+	{
+	  lGrid->cellOff[idC] += lGrid->cellOff[idC - 1];
+	}
+	if((lGrid->elmIdx = (int *)
+	                    AlcMalloc(sizeof(int) *
+			              ALG_MAX(lGrid->cellOff[nCells], 1))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	for(idC = nCells; idC > 0; --idC)
+	{
+	  lGrid->cellOff[idC] = lGrid->cellOff[idC - 1];
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzCMeshLocGridFree3D(lGrid);
+    lGrid = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lGrid);
+}
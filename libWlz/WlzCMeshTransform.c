@@ -168,6 +168,23 @@ typedef struct _WlzCMeshScanWSp3D
   					    mesh. */
 } WlzCMeshScanWSp3D;
 
+/*!
+* \struct	_WlzCMeshScanItvBuf3D
+* \ingroup	WlzTransform
+* \brief	Buffer in which the intervals of a block of 3D conforming
+*		mesh elements are collected.
+*/
+typedef struct _WlzCMeshScanItvBuf3D
+{
+  AlcVector	*vec;			/*! Vector of intervals. */
+  int		nItv;			/*! Number of intervals in vector. */
+  int		boxSet;			/*! Non-zero once the bounding box
+  					    has been set. */
+  WlzDBox3	box;			/*! Bounding box of the displaced
+  					    nodes of the block. */
+  WlzErrorNum	errNum;			/*! Error code for the block. */
+} WlzCMeshScanItvBuf3D;
+
 static void 			WlzCMeshUpdateScanElm2D(
 				  WlzObject *mObj,
 				  WlzCMeshScanElm2D *sElm,
@@ -192,6 +209,14 @@ static void			WlzCMeshScanClearOlpBuf(
 				  int clrWidth);
 static void			WlzCMeshSqzRedundantItv3D(
 				  WlzCMeshScanWSp3D *mSWSp);
+static void			WlzCMeshUpdateScanElms3D(
+				  WlzCMeshScanWSp3D *mSWSp,
+				  int fwd);
+static int			*WlzCMeshScanPlnItvIdx3D(
+				  WlzCMeshScanWSp3D *mSWSp,
+				  int pln0,
+				  int nPln,
+				  WlzErrorNum *dstErr);
 static WlzErrorNum 		WlzCMeshInterpolateNod2DKrig(
 				  WlzGreyP dst,
 				  int ln,
@@ -315,6 +340,18 @@ static WlzErrorNum 		WlzCMeshAddItv3D(
 				  int *idI,
 				  int elmIdx,
 				  WlzDVertex3 *vtx);
+static WlzErrorNum 		WlzCMeshScanObjPlnValues3D(
+				  WlzObject *dstObj,
+				  WlzCMeshScanWSp3D *mSWSp,
+				  int idP,
+				  int mItvIdx0,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzGreyP olpBuf,
+				  int *olpCnt,
+				  int bufWidth,
+				  WlzGreyType gType,
+				  WlzPixelV bgdV,
+				  WlzInterpolationType interp);
 static WlzErrorNum 		WlzCMeshScanObjValues3D(
 				  WlzObject *dstObj,
 				  WlzObject *srcObj,
@@ -832,6 +869,7 @@ static WlzObject *WlzCMeshTransformInvert3D(WlzObject *gObj,
   		*rIxv = NULL;
   WlzCMesh3D	*gMesh = NULL,
   		*rMesh = NULL;
+  WlzCMeshArr3D	*arr = NULL;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
   if((gMesh = gObj->domain.cm3)->type != WLZ_CMESH_3D)
@@ -852,25 +890,73 @@ static WlzObject *WlzCMeshTransformInvert3D(WlzObject *gObj,
   if(((errNum == WLZ_ERR_NONE) &&
      gMesh->res.nod.numEnt > 0) && (gMesh->res.elm.numEnt > 0))
   {
-    /* Allocate new data structures. */
-    rMesh = WlzCMeshNew3D(&errNum);
+    /* Build a compact mesh with the displaced node positions and then
+     * make the inverse mesh from it. */
+    arr = WlzCMeshArrNew3D(gMesh->res.nod.numEnt, gMesh->res.elm.numEnt,
+                           &errNum);
+    if((errNum == WLZ_ERR_NONE) &&
+       ((nTbl = (int *)
+                AlcMalloc(sizeof(int) * gMesh->res.nod.maxEnt)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
     if(errNum == WLZ_ERR_NONE)
     {
-      if(((nTbl = (int *)
-                  AlcMalloc(sizeof(int) * gMesh->res.nod.numEnt)) == NULL) ||
-         (AlcVectorExtend(rMesh->res.nod.vec,
-                          gMesh->res.nod.numEnt) != ALC_ER_NONE) ||
-	 (AlcVectorExtend(rMesh->res.elm.vec,
-	                  gMesh->res.elm.numEnt) != ALC_ER_NONE))
+      int	idN;
+      double	*gDsp;
+      AlcVector	*gVec;
+      WlzCMeshNod3D *gNod;
+
+      gVec = gMesh->res.nod.vec;
+      for(idN = 0; idN < gMesh->res.nod.maxEnt; ++idN)
       {
-        errNum = WLZ_ERR_MEM_ALLOC;
+        gNod = (WlzCMeshNod3D *)AlcVectorItemGet(gVec, idN);
+	if(gNod->idx >= 0)
+	{
+	  WlzDVertex3 pos;
+
+	  gDsp = (double *)WlzIndexedValueGet(gIxv, idN);
+	  pos.vtX = gNod->pos.vtX + gDsp[0];
+	  pos.vtY = gNod->pos.vtY + gDsp[1];
+	  pos.vtZ = gNod->pos.vtZ + gDsp[2];
+	  nTbl[idN] = WlzCMeshArrNewNod3D(arr, pos, &errNum);
+	  if(errNum != WLZ_ERR_NONE)
+	  {
+	    break;
+	  }
+	}
       }
-      else
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	idE;
+      AlcVector	*gVec;
+      WlzCMeshElm3D *gElm;
+
+      gVec = gMesh->res.elm.vec;
+      for(idE = 0; idE < gMesh->res.elm.maxEnt; ++idE)
       {
-        errNum = WlzCMeshReassignGridCells3D(rMesh, gMesh->res.nod.numEnt);
+        gElm = (WlzCMeshElm3D *)AlcVectorItemGet(gVec, idE);
+	if(gElm->idx >= 0)
+	{
+	  (void )WlzCMeshArrNewElm3D(arr,
+	                     nTbl[WLZ_CMESH_ELM3D_GET_NODE_0(gElm)->idx],
+	                     nTbl[WLZ_CMESH_ELM3D_GET_NODE_1(gElm)->idx],
+	                     nTbl[WLZ_CMESH_ELM3D_GET_NODE_2(gElm)->idx],
+	                     nTbl[WLZ_CMESH_ELM3D_GET_NODE_3(gElm)->idx],
+			     &errNum);
+          if(errNum != WLZ_ERR_NONE)
+	  {
+	    break;
+	  }
+	}
       }
     }
     if(errNum == WLZ_ERR_NONE)
+    {
+      rMesh = WlzCMeshFromArr3D(arr, 1, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
     {
       WlzDomain dom;
       WlzValues val;
@@ -891,15 +977,14 @@ static WlzObject *WlzCMeshTransformInvert3D(WlzObject *gObj,
       val.x = rIxv;
       rObj->values = WlzAssignValues(val, NULL);
     }
-    /* Set node positions and displacements. */
+    /* Set the node displacements. */
     if(errNum == WLZ_ERR_NONE)
     {
       int	idN;
       double	*gDsp,
       		*rDsp;
       AlcVector	*gVec;
-      WlzCMeshNod3D *gNod,
-      		    *rNod;
+      WlzCMeshNod3D *gNod;
 
       gVec = gMesh->res.nod.vec;
       for(idN = 0; idN < gMesh->res.nod.maxEnt; ++idN)
@@ -907,59 +992,16 @@ static WlzObject *WlzCMeshTransformInvert3D(WlzObject *gObj,
         gNod = (WlzCMeshNod3D *)AlcVectorItemGet(gVec, idN);
 	if(gNod->idx >= 0)
 	{
-	  WlzDVertex3 pos;
-
 	  gDsp = (double *)WlzIndexedValueGet(gIxv, idN);
-	  pos.vtX = gNod->pos.vtX + gDsp[0];
-	  pos.vtY = gNod->pos.vtY + gDsp[1];
-	  pos.vtZ = gNod->pos.vtZ + gDsp[2];
-	  rNod = WlzCMeshNewNod3D(rMesh, pos, NULL);
-	  rDsp = (double *)WlzIndexedValueGet(rIxv, rNod->idx);
-	  nTbl[gNod->idx] = rNod->idx;
+	  rDsp = (double *)WlzIndexedValueGet(rIxv, nTbl[idN]);
 	  rDsp[0] = -(gDsp[0]);
 	  rDsp[1] = -(gDsp[1]);
 	  rDsp[2] = -(gDsp[2]);
 	}
       }
-      WlzCMeshUpdateBBox3D(rMesh);
-      errNum = WlzCMeshReassignGridCells3D(rMesh, 0);
-    }
-    /* Create the elements. */
-    if(errNum == WLZ_ERR_NONE)
-    {
-      int	idE;
-      AlcVector	*gVec,
-      		*rVec;
-      WlzCMeshElm3D *gElm;
-
-      gVec = gMesh->res.elm.vec;
-      rVec = rMesh->res.nod.vec;
-      for(idE = 0; idE < gMesh->res.elm.maxEnt; ++idE)
-      {
-        gElm = (WlzCMeshElm3D *)AlcVectorItemGet(gVec, idE);
-	if(gElm->idx >= 0)
-	{
-	  WlzCMeshNod3D *gNod;
-	  WlzCMeshNod3D *rNodes[4];
-
-	  gNod = WLZ_CMESH_ELM3D_GET_NODE_0(gElm);
-	  rNodes[0] = (WlzCMeshNod3D *)AlcVectorItemGet(rVec, nTbl[gNod->idx]);
-	  gNod = WLZ_CMESH_ELM3D_GET_NODE_1(gElm);
-	  rNodes[1] = (WlzCMeshNod3D *)AlcVectorItemGet(rVec, nTbl[gNod->idx]);
-	  gNod = WLZ_CMESH_ELM3D_GET_NODE_2(gElm);
-	  rNodes[2] = (WlzCMeshNod3D *)AlcVectorItemGet(rVec, nTbl[gNod->idx]);
-	  gNod = WLZ_CMESH_ELM3D_GET_NODE_3(gElm);
-	  rNodes[3] = (WlzCMeshNod3D *)AlcVectorItemGet(rVec, nTbl[gNod->idx]);
-	  (void )WlzCMeshNewElm3D(rMesh, rNodes[0], rNodes[1], rNodes[2],
-				  rNodes[3], 1, &errNum);
-          if(errNum != WLZ_ERR_NONE)
-	  {
-	    break;
-	  }
-	}
-      }
     }
   }
+  WlzCMeshArrFree3D(arr);
   AlcFree(nTbl);
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1110,7 +1152,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry2I(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm2;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid2D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos2D(mesh, lastElmIdx,
 			(double )(vtx[idN].vtX), (double )(vtx[idN].vtY),
@@ -1172,7 +1215,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry3I(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm3;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid3D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
 			(double )(vtx[idN].vtX), (double )(vtx[idN].vtY),
@@ -1241,7 +1285,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry2F(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm2;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid2D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos2D(mesh, lastElmIdx,
     			vtx[idN].vtX, vtx[idN].vtY,
@@ -1305,7 +1350,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry3F(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm3;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid3D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
     			vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
@@ -1371,7 +1417,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry2D(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm2;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid2D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos2D(mesh, lastElmIdx,
     			vtx[idN].vtX, vtx[idN].vtY,
@@ -1496,7 +1543,8 @@ WlzErrorNum	WlzCMeshTransformVtxAry3D(WlzObject *mObj,
   lastElmIdx = -1;
   mesh = mObj->domain.cm3;
   ixv = mObj->values.x;
-  for(idN = 0; idN < nVtx; ++idN)
+  errNum = WlzCMeshSetLocGrid3D(mesh);
+  for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < nVtx); ++idN)
   {
     if(((sE.idx = WlzCMeshElmEnclosingPos3D(mesh, lastElmIdx,
     			vtx[idN].vtX, vtx[idN].vtY, vtx[idN].vtZ,
@@ -1944,6 +1992,10 @@ static WlzObject *WlzCMeshToDomObjValues2D(WlzObject *dObj, WlzObject *mObj,
       break;
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshSetLocGrid2D(mesh);
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     rVTT = WlzGreyTableType(WLZ_GREY_TAB_RAGR, bgd.type, NULL);
     rVal.v = WlzNewValueTb(dObj, rVTT, bgd, &errNum);
@@ -2097,6 +2149,10 @@ static WlzObject *WlzCMeshToDomObjValues3D(WlzObject *dObj, WlzObject *mObj,
       break;
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshSetLocGrid3D(mesh);
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     rVTT = WlzGreyTableType(WLZ_GREY_TAB_RAGR, bgd.type, NULL);
     rVal.vox = WlzNewValuesVox(dObj, rVTT, bgd, &errNum);
@@ -4382,6 +4438,12 @@ static WlzCMeshScanWSp2D *WlzCMeshScanWSpInit2D(WlzObject *mObj,
 * \return	New conforming mesh scan workspace.
 * \ingroup	WlzTransform
 * \brief	Allocate and initialise a 3D conforming mesh scan workspace.
+*		When built with OpenMP the mesh elements are partitioned
+*		into contiguous blocks, one per thread, for which the
+*		intervals are collected concurrently. The intervals are
+*		then bucketed by plane and the planes sorted concurrently.
+*		Because the intervals are totally ordered the workspace
+*		is independent of the number of threads.
 * \param	mObj			Conforming mesh transform object.
 * \param	trans			Build workspace for transformed
 * 					mesh using the transform in the 
@@ -4391,21 +4453,25 @@ static WlzCMeshScanWSp2D *WlzCMeshScanWSpInit2D(WlzObject *mObj,
 static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
 				    	WlzErrorNum *dstErr)
 {
-  int		idE,
+  int		idB,
+  		idE,
 		idI,
-		idN,
+		idP,
   		elmCnt,
-		fstNod;
-  double	*dsp;
-  WlzDVertex3	dspP;
-  WlzDVertex3	dspPos[4];
+		nBlk = 1,
+		nItv = 0,
+		nPln = 0,
+		fstNod = 1;
+  int		*plnItvIdx = NULL;
+  WlzIBox3	pBox;
   WlzDBox3	dBox;
-  AlcVector	*itvVec = NULL;
   AlcVector	*elmVec;
-  WlzCMeshNod3D	*nodBuf[4];
   WlzCMeshElm3D	*elm;
   WlzIndexedValues *ixv = NULL;
   WlzCMesh3D	*mesh;
+  WlzCMeshScanItvBuf3D *itvBuf = NULL;
+  WlzCMeshScanItv3D *itv,
+  		*tItvs = NULL;
   WlzCMeshScanWSp3D *mSWSp = NULL;
   WlzCMeshScanElm3D *dElm;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -4449,90 +4515,150 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
   {
     elmVec = mesh->res.elm.vec;
     elmCnt = mesh->res.elm.maxEnt;
-    /* Collect the intervals in the displaced mesh. */
-    /* Create temporary vector in which to accumulate the intervals. */
-    if((itvVec = AlcVectorNew(1, sizeof(WlzCMeshScanItv3D),
-				   mesh->res.elm.vec->blkSz, NULL)) == NULL)
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nBlk = omp_get_num_threads();
+      }
+    }
+#endif
+    /* Create temporary vectors, one per block of elements, in which to
+     * accumulate the intervals. */
+    if((itvBuf = (WlzCMeshScanItvBuf3D *)
+                 AlcCalloc(nBlk, sizeof(WlzCMeshScanItvBuf3D))) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < nBlk); ++idB)
+    {
+      if((itvBuf[idB].vec = AlcVectorNew(1, sizeof(WlzCMeshScanItv3D),
+				         elmVec->blkSz, NULL)) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    idE = 0;
-    idI = 0;
-    fstNod = 1;
-    while((errNum == WLZ_ERR_NONE) && (idE < elmCnt))
+    /* Collect the intervals in the displaced mesh. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nBlk)
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
     {
-      /* Compute the displaced nodes and collect the intervals. */
-      elm = (WlzCMeshElm3D *)AlcVectorItemGet(elmVec, (size_t )idE);
-      if(elm->idx >= 0)
+      int	idE,
+      		idE1,
+		idN;
+      double	*dsp;
+      WlzDVertex3 dspP;
+      WlzDVertex3 dspPos[4];
+      WlzCMeshNod3D *nodBuf[4];
+      WlzCMeshElm3D *elm;
+      WlzCMeshScanItvBuf3D *buf;
+
+      buf = itvBuf + idB;
+      idE = (int )(((long )elmCnt * idB) / nBlk);
+      idE1 = (int )(((long )elmCnt * (idB + 1)) / nBlk);
+      while((buf->errNum == WLZ_ERR_NONE) && (idE < idE1))
       {
-	nodBuf[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
-	nodBuf[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
-	nodBuf[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
-	nodBuf[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
-        for(idN = 0; idN < 4; ++idN)
+	/* Compute the displaced nodes and collect the intervals. */
+	elm = (WlzCMeshElm3D *)AlcVectorItemGet(elmVec, (size_t )idE);
+	if(elm->idx >= 0)
 	{
-	  if(ixv == NULL)
-	  {
-	    dspP = nodBuf[idN]->pos;
-	  }
-	  else
-	  {
-	    dsp = (double *)WlzIndexedValueGet(ixv, nodBuf[idN]->idx);
-	    dspP.vtX = nodBuf[idN]->pos.vtX + dsp[0];
-	    dspP.vtY = nodBuf[idN]->pos.vtY + dsp[1];
-	    dspP.vtZ = nodBuf[idN]->pos.vtZ + dsp[2];
-	  }
-	  dspPos[idN] = dspP;
-	  if(fstNod)
-	  {
-	    dBox.xMin = dBox.xMax = dspP.vtX;
-	    dBox.yMin = dBox.yMax = dspP.vtY;
-	    dBox.zMin = dBox.zMax = dspP.vtZ;
-	    fstNod = 0;
-	  }
-	  else
+	  nodBuf[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+	  nodBuf[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+	  nodBuf[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+	  nodBuf[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+	  for(idN = 0; idN < 4; ++idN)
 	  {
-	    if(dspP.vtX < dBox.xMin)
-	    {
-	      dBox.xMin = dspP.vtX;
-	    }
-	    else if(dspP.vtX > dBox.xMax)
+	    if(ixv == NULL)
 	    {
-	      dBox.xMax = dspP.vtX;
+	      dspP = nodBuf[idN]->pos;
 	    }
-	    if(dspP.vtY < dBox.yMin)
-	    {
-	      dBox.yMin = dspP.vtY;
-	    }
-	    else if(dspP.vtY > dBox.yMax)
+	    else
 	    {
-	      dBox.yMax = dspP.vtY;
+	      dsp = (double *)WlzIndexedValueGet(ixv, nodBuf[idN]->idx);
+	      dspP.vtX = nodBuf[idN]->pos.vtX + dsp[0];
+	      dspP.vtY = nodBuf[idN]->pos.vtY + dsp[1];
+	      dspP.vtZ = nodBuf[idN]->pos.vtZ + dsp[2];
 	    }
-	    if(dspP.vtZ < dBox.zMin)
+	    dspPos[idN] = dspP;
+	    if(buf->boxSet == 0)
 	    {
-	      dBox.zMin = dspP.vtZ;
+	      buf->box.xMin = buf->box.xMax = dspP.vtX;
+	      buf->box.yMin = buf->box.yMax = dspP.vtY;
+	      buf->box.zMin = buf->box.zMax = dspP.vtZ;
+	      buf->boxSet = 1;
 	    }
-	    else if(dspP.vtZ > dBox.zMax)
+	    else
 	    {
-	      dBox.zMax = dspP.vtZ;
+	      if(dspP.vtX < buf->box.xMin)
+	      {
+		buf->box.xMin = dspP.vtX;
+	      }
+	      else if(dspP.vtX > buf->box.xMax)
+	      {
+		buf->box.xMax = dspP.vtX;
+	      }
+	      if(dspP.vtY < buf->box.yMin)
+	      {
+		buf->box.yMin = dspP.vtY;
+	      }
+	      else if(dspP.vtY > buf->box.yMax)
+	      {
+		buf->box.yMax = dspP.vtY;
+	      }
+	      if(dspP.vtZ < buf->box.zMin)
+	      {
+		buf->box.zMin = dspP.vtZ;
+	      }
+	      else if(dspP.vtZ > buf->box.zMax)
+	      {
+		buf->box.zMax = dspP.vtZ;
+	      }
 	    }
 	  }
+	  buf->errNum = WlzCMeshTetElmItv3D(buf->vec, &(buf->nItv),
+	                                    elm->idx, dspPos);
+	}
+	++idE;
+      }
+    }
+    /* Combine the block errors, interval counts and bounding boxes. */
+    for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < nBlk); ++idB)
+    {
+      WlzCMeshScanItvBuf3D *buf;
+
+      buf = itvBuf + idB;
+      errNum = buf->errNum;
+      nItv += buf->nItv;
+      if(buf->boxSet)
+      {
+        if(fstNod)
+	{
+	  dBox = buf->box;
+	  fstNod = 0;
+	}
+	else
+	{
+	  dBox.xMin = ALG_MIN(dBox.xMin, buf->box.xMin);
+	  dBox.yMin = ALG_MIN(dBox.yMin, buf->box.yMin);
+	  dBox.zMin = ALG_MIN(dBox.zMin, buf->box.zMin);
+	  dBox.xMax = ALG_MAX(dBox.xMax, buf->box.xMax);
+	  dBox.yMax = ALG_MAX(dBox.yMax, buf->box.yMax);
+	  dBox.zMax = ALG_MAX(dBox.zMax, buf->box.zMax);
 	}
-	errNum = WlzCMeshTetElmItv3D(itvVec, &idI, elm->idx, dspPos);
       }
-      ++idE;
     }
   }
   /* Create a mesh scan workspace using the collected intervals. */
   if(errNum == WLZ_ERR_NONE)
   {
-    mSWSp = WlzCMeshMakeScanWSp3D(mObj, idI, &errNum);
+    mSWSp = WlzCMeshMakeScanWSp3D(mObj, nItv, &errNum);
   }
-  /* Copy the mesh scan intervals and sort them by plane, then line and
-   * then column and then squeeze out the redundant intervals. */
+  /* Copy the mesh scan intervals, finding their range of planes. */
   if(errNum == WLZ_ERR_NONE)
   {
     mSWSp->dBox.xMin = WLZ_CMESH_POS_DTOI(dBox.xMin) - 1;
@@ -4541,13 +4667,71 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
     mSWSp->dBox.xMax = WLZ_CMESH_POS_DTOI(dBox.xMax) + 1;
     mSWSp->dBox.yMax = WLZ_CMESH_POS_DTOI(dBox.yMax) + 1;
     mSWSp->dBox.zMax = WLZ_CMESH_POS_DTOI(dBox.zMax) + 1;
-    for(idI = 0; idI < mSWSp->nItvs; ++idI)
+    itv = mSWSp->itvs;
+    pBox.zMin = pBox.zMax = 0;
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      for(idI = 0; idI < itvBuf[idB].nItv; ++idI)
+      {
+	*itv = *(WlzCMeshScanItv3D *)AlcVectorItemGet(itvBuf[idB].vec, idI);
+	if(itv == mSWSp->itvs)
+	{
+	  pBox.zMin = pBox.zMax = itv->plane;
+	}
+	else if(itv->plane < pBox.zMin)
+	{
+	  pBox.zMin = itv->plane;
+	}
+	else if(itv->plane > pBox.zMax)
+	{
+	  pBox.zMax = itv->plane;
+	}
+	++itv;
+      }
+    }
+    nPln = pBox.zMax - pBox.zMin + 1;
+    if(((plnItvIdx = (int *)AlcCalloc(nPln + 1, sizeof(int))) == NULL) ||
+       ((tItvs = (WlzCMeshScanItv3D *)
+                 AlcMalloc(sizeof(WlzCMeshScanItv3D) * 
+		           ALG_MAX(nItv, 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Sort the mesh scan intervals by plane, then line and then column,
+   * first by bucketing them by plane and then sorting the planes, and
+   * then squeeze out the redundant intervals. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idI = 0; idI < nItv; ++idI)
     {
-      *(mSWSp->itvs + idI) = *(WlzCMeshScanItv3D *)
-                             AlcVectorItemGet(itvVec, idI);
+      ++plnItvIdx[(mSWSp->itvs + idI)->plane - pBox.zMin + 1];
+    }
+    for(idP = 1; idP <= nPln; ++idP)
+    {
+      plnItvIdx[idP] += plnItvIdx[idP - 1];
+    }
+    for(idI = 0; idI < nItv; ++idI)
+    {
+      itv = mSWSp->itvs + idI;
+      *(tItvs + plnItvIdx[itv->plane - pBox.zMin]++) = *itv;
+    }
+    /* The bucket offsets have now been advanced to the end of each
+     * plane, so plane p is in the range [plnItvIdx[p - 1], plnItvIdx[p]). */
+    itv = mSWSp->itvs;
+    mSWSp->itvs = tItvs;
+    tItvs = itv;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      int	idI0;
+
+      idI0 = (idP > 0)? plnItvIdx[idP - 1]: 0;
+      qsort(mSWSp->itvs + idI0, plnItvIdx[idP] - idI0,
+            sizeof(WlzCMeshScanItv3D), WlzCMeshItv3Cmp);
     }
-    qsort(mSWSp->itvs, mSWSp->nItvs, sizeof(WlzCMeshScanItv3D),
-          WlzCMeshItv3Cmp);
     for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
     {
       elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, (size_t )idE);
@@ -4577,7 +4761,16 @@ static WlzCMeshScanWSp3D *WlzCMeshScanWSpInit3D(WlzObject *mObj, int trans,
     }
 #endif
   }
-  AlcVectorFree(itvVec);
+  if(itvBuf)
+  {
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      (void )AlcVectorFree(itvBuf[idB].vec);
+    }
+    AlcFree(itvBuf);
+  }
+  AlcFree(tItvs);
+  AlcFree(plnItvIdx);
   if(errNum != WLZ_ERR_NONE)
   {
     WlzCMeshScanWSpFree3D(mSWSp);
@@ -4637,6 +4830,85 @@ static void	WlzCMeshSqzRedundantItv3D(WlzCMeshScanWSp3D *mSWSp)
 #endif
 }
 
+/*!
+* \ingroup	WlzTransform
+* \brief	Computes the transform coefficients of all the valid
+*		scan elements in the given 3D conforming mesh scan
+*		workspace. Computing these before scanning, rather than
+*		as each element is first encountered, allows the scan
+*		workspace to be shared between threads.
+* \param	mSWSp			Mesh scan workspace.
+* \param	fwd			Non-zero for forward transform
+*					mapping source to destination,
+* 					otherwise inverse transform.
+*/
+static void	WlzCMeshUpdateScanElms3D(WlzCMeshScanWSp3D *mSWSp, int fwd)
+{
+  int		idE,
+  		maxElm;
+
+  maxElm = mSWSp->mTr->domain.cm3->res.elm.maxEnt;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idE = 0; idE < maxElm; ++idE)
+  {
+    WlzCMeshScanElm3D *sE;
+
+    sE = mSWSp->dElm + idE;
+    if(sE->idx >= 0)
+    {
+      WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, fwd);
+    }
+  }
+}
+
+/*!
+* \return	Array of nPln + 1 interval indices, NULL on error.
+* \ingroup	WlzTransform
+* \brief	Computes the index of the first mesh interval on or after
+*		each of the given planes in the (sorted) intervals of the
+*		3D conforming mesh scan workspace. The intervals of plane
+*		pln0 + p are then those with indices in the range
+*		[idx[p], idx[p + 1]).
+* \param	mSWSp			Mesh scan workspace.
+* \param	pln0			First plane.
+* \param	nPln			Number of planes.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int	*WlzCMeshScanPlnItvIdx3D(WlzCMeshScanWSp3D *mSWSp,
+					 int pln0, int nPln,
+					 WlzErrorNum *dstErr)
+{
+  int		idI,
+  		idP;
+  int		*idx = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((idx = (int *)AlcMalloc(sizeof(int) * (nPln + 1))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    idI = 0;
+    for(idP = 0; idP <= nPln; ++idP)
+    {
+      while((idI < mSWSp->nItvs) &&
+            ((mSWSp->itvs + idI)->plane < pln0 + idP))
+      {
+        ++idI;
+      }
+      idx[idP] = idI;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idx);
+}
+
 /*!
 * \return	New uninitialised 3D conforming mesh scan workspace.
 * \ingroup	WlzTransform
@@ -5379,7 +5651,10 @@ static int	WlzCMeshItv2Cmp(const void *cmp0, const void *cmp1)
 * \return	Sorting value for qsort.
 * \ingroup	WlzTransform
 * \brief	Callback function for qsort(3) to sort 3D conforming mesh
-*		element intervals by plane, line and then left column.
+*		element intervals by plane, line, left column, right
+*		column and then element index. This is a total order
+*		so the sorted intervals do not depend on their initial
+*		order.
 * \param	cmp0			Used to pass first mesh interval.
 * \param	cmp1			Used to pass second mesh interval.
 */
@@ -5397,7 +5672,10 @@ static int	WlzCMeshItv3Cmp(const void *cmp0, const void *cmp1)
     {
       if((rtn = itv0->lftI - itv1->lftI) == 0)
       {
-	rtn = itv0->rgtI - itv1->rgtI;
+	if((rtn = itv0->rgtI - itv1->rgtI) == 0)
+	{
+	  rtn = itv0->elmIdx - itv1->elmIdx;
+	}
       }
     }
   }
@@ -5751,7 +6029,8 @@ static WlzCMesh2D *WlzCMeshTransformCMesh2D(WlzCMesh2D *sMesh,
     tIxv = mTrObj->values.x;
     dNV = dMesh->res.nod.vec;
     dMaxNod = dMesh->res.nod.maxEnt;
-    for(idN = 0; idN < dMaxNod; ++idN)
+    errNum = WlzCMeshSetLocGrid2D(tMesh);
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < dMaxNod); ++idN)
     {
       int	tNearNod;
       double	*dsp;
@@ -5937,7 +6216,8 @@ static WlzCMesh3D *WlzCMeshTransformCMesh3D(WlzCMesh3D *sMesh,
     tIxv = mTrObj->values.x;
     dNV = dMesh->res.nod.vec;
     dMaxNod = dMesh->res.nod.maxEnt;
-    for(idN = 0; idN < dMaxNod; ++idN)
+    errNum = WlzCMeshSetLocGrid3D(tMesh);
+    for(idN = 0; (errNum == WLZ_ERR_NONE) && (idN < dMaxNod); ++idN)
     {
       int	tNearNod;
       double	*dsp;
@@ -6409,6 +6689,9 @@ static WlzErrorNum WlzCMeshVerifyWSp3D(WlzObject *srcObj,
 *		initialized mesh transform workspace.
 *		If the given source object is NULL a domain will be created
 *		corresponding to the given mesh transform.
+*		When built with OpenMP the planes of the new domain are
+*		partitioned between the threads, with each plane's interval
+*		domain being built by a single thread.
 * \param	srcObj			Object to be transformed, may be NULL.
 * \param	mTr			Conforming mesh transform.
 * \param	dstErr			Destination error pointer, may be NULL.
@@ -6417,23 +6700,13 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
 					   WlzCMeshScanWSp3D *mSWSp,
 					   WlzErrorNum *dstErr) 
 {
-  int		idI,
-		kol,
-		itvLnCnt = 0,
-		itvPlCnt = 0,
+  int		idP,
+		nPln,
 		itvLnWidth,
 		itvLnByteWidth;
-  WlzIVertex3	dPos,
-		sPos;
-  WlzDVertex3	tV;
-  WlzDynItvPool	itvPool;
-  WlzCMeshScanItv3D *curItv = NULL,
-  		*prvItv = NULL;
+  int		*plnItvIdx = NULL;
   WlzObjectType	dstObjType;
-  WlzCMeshScanElm3D *sE;
-  WlzUByte	*lnMsk = NULL;
-  WlzDomain	dom2,
-  		dom3;
+  WlzDomain	dom3;
   WlzValues	nullVal;
   WlzObject	*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -6441,11 +6714,8 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
   				     allocated in a single block. It is a
 				     tuning parameter, see use below. */
 
-  dom2.core = NULL;
   dom3.core = NULL;
   nullVal.core = NULL;
-  itvPool.offset = 0;
-  itvPool.itvBlock = NULL;
   if(mSWSp->nItvs < 1)
   {
     dstObj = WlzMakeEmpty(&errNum);
@@ -6455,96 +6725,125 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
     dstObjType = (srcObj == NULL)? WLZ_3D_DOMAINOBJ: srcObj->type;
     itvLnWidth = mSWSp->dBox.xMax - mSWSp->dBox.xMin + 1;
     itvLnByteWidth = (itvLnWidth + 7) / 8;
-    /* Initialize a dynamic interval pool. Any size greater than the maximum
-     * number of intervals per line will do, but for efficiency it shouldn't
-     * be too small as this will cause loads of memory allocations. */
-    itvPool.itvsInBlock = (itvLnWidth < minDynItv)? minDynItv: itvLnWidth;
+    nPln = mSWSp->dBox.zMax - mSWSp->dBox.zMin + 1;
+    /* Compute the inverse transforms of all the scan elements now so that
+     * the planes can be scanned concurrently. */
+    WlzCMeshUpdateScanElms3D(mSWSp, 0);
+    plnItvIdx = WlzCMeshScanPlnItvIdx3D(mSWSp, mSWSp->dBox.zMin, nPln,
+                                        &errNum);
     /* Create a new plane domain using the bounding box of the displaced
      * mesh. This is corrected latter. */
-    dom3.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
-				mSWSp->dBox.zMin, mSWSp->dBox.zMax,
-				mSWSp->dBox.yMin, mSWSp->dBox.yMax,
-				mSWSp->dBox.xMin, mSWSp->dBox.xMax,
-				&errNum);
     if(errNum == WLZ_ERR_NONE)
     {
-      if(AlcBit1Calloc(&lnMsk, itvLnWidth) != ALC_ER_NONE)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
+      dom3.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+				  mSWSp->dBox.zMin, mSWSp->dBox.zMax,
+				  mSWSp->dBox.yMin, mSWSp->dBox.yMax,
+				  mSWSp->dBox.xMin, mSWSp->dBox.xMax,
+				  &errNum);
     }
     if(errNum == WLZ_ERR_NONE)
     {
-      idI = 0;
-      itvLnCnt = 0;
-      itvPlCnt = 0;
-      itvPool.offset = 0;
-      itvPool.itvBlock = NULL;
-      prvItv = NULL;
-      curItv = mSWSp->itvs;
-    }
-    while((errNum == WLZ_ERR_NONE) && (idI < mSWSp->nItvs))
-    {
-      sE = mSWSp->dElm + curItv->elmIdx;
-      if(dom2.core == NULL)
-      {
-	dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
-				       mSWSp->dBox.yMin, mSWSp->dBox.yMax,
-				       mSWSp->dBox.xMin, mSWSp->dBox.xMax,
-				       &errNum);
-      }
-      dPos.vtY = curItv->line;
-      dPos.vtZ = curItv->plane;
-      for(kol = curItv->lftI; kol <= curItv->rgtI; ++kol)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for(idP = 0; idP < nPln; ++idP)
       {
-        dPos.vtX = kol;
-	if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
+	int	kol,
+		itvLnCnt = 0,
+		itvPlCnt = 0;
+	WlzIVertex3 dPos,
+		sPos;
+	WlzDVertex3 tV;
+	WlzDynItvPool itvPool;
+	WlzCMeshScanItv3D *curItv,
+		*lstItv;
+	WlzCMeshScanElm3D *sE;
+	WlzUByte *lnMsk = NULL;
+	WlzDomain dom2;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	dom2.core = NULL;
+	/* Initialize a dynamic interval pool. Any size greater than the
+	 * maximum number of intervals per line will do, but for efficiency
+	 * it shouldn't be too small as this will cause loads of memory
+	 * allocations. */
+	itvPool.offset = 0;
+	itvPool.itvBlock = NULL;
+	itvPool.itvsInBlock = (itvLnWidth < minDynItv)? minDynItv: itvLnWidth;
+	curItv = mSWSp->itvs + plnItvIdx[idP];
+	lstItv = mSWSp->itvs + plnItvIdx[idP + 1] - 1;
+	if(curItv <= lstItv)
+	{
+	  if(AlcBit1Calloc(&lnMsk, itvLnWidth) != ALC_ER_NONE)
+	  {
+	    errNum2 = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+					   mSWSp->dBox.yMin, mSWSp->dBox.yMax,
+					   mSWSp->dBox.xMin, mSWSp->dBox.xMax,
+					   &errNum2);
+	  }
+	}
+	while((errNum2 == WLZ_ERR_NONE) && (curItv <= lstItv))
 	{
-	  WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+	  sE = mSWSp->dElm + curItv->elmIdx;
+	  dPos.vtY = curItv->line;
+	  dPos.vtZ = curItv->plane;
+	  for(kol = curItv->lftI; kol <= curItv->rgtI; ++kol)
+	  {
+	    dPos.vtX = kol;
+	    tV.vtX = (sE->tr[ 0] * dPos.vtX) + (sE->tr[ 1] * dPos.vtY) +
+		     (sE->tr[ 2] * dPos.vtZ) +  sE->tr[ 3];
+	    tV.vtY = (sE->tr[ 4] * dPos.vtX) + (sE->tr[ 5] * dPos.vtY) +
+		     (sE->tr[ 6] * dPos.vtZ) +  sE->tr[ 7];
+	    tV.vtZ = (sE->tr[ 8] * dPos.vtX) + (sE->tr[ 9] * dPos.vtY) +
+		     (sE->tr[10] * dPos.vtZ) +  sE->tr[11];
+	    sPos.vtX = WLZ_CMESH_POS_DTOI(tV.vtX);
+	    sPos.vtY = WLZ_CMESH_POS_DTOI(tV.vtY);
+	    sPos.vtZ = WLZ_CMESH_POS_DTOI(tV.vtZ);
+	    if((srcObj == NULL) ||
+	       (WlzInsideDomain(srcObj, sPos.vtZ, sPos.vtY, sPos.vtX,
+	                        NULL) != 0))
+	    {
+	      ++itvLnCnt;
+	      WlzBitLnSetItv(lnMsk,
+			     kol - mSWSp->dBox.xMin, kol - mSWSp->dBox.xMin,
+			     itvLnWidth);
+	    }
+	  }
+	  if((itvLnCnt > 0) &&
+	     ((curItv == lstItv) || ((curItv + 1)->line != curItv->line)))
+	  {
+	    /* Add line to interval domain. */
+	    errNum2 = WlzDynItvLnFromBitLn(dom2.i, lnMsk, curItv->line,
+	                                   itvLnWidth, &itvPool);
+	    memset(lnMsk, 0, itvLnByteWidth);
+	    itvPlCnt += itvLnCnt;
+	    itvLnCnt = 0;
+	  }
+	  ++curItv;
 	}
-	tV.vtX = (sE->tr[ 0] * dPos.vtX) + (sE->tr[ 1] * dPos.vtY) +
-		 (sE->tr[ 2] * dPos.vtZ) +  sE->tr[ 3];
-	tV.vtY = (sE->tr[ 4] * dPos.vtX) + (sE->tr[ 5] * dPos.vtY) +
-		 (sE->tr[ 6] * dPos.vtZ) +  sE->tr[ 7];
-	tV.vtZ = (sE->tr[ 8] * dPos.vtX) + (sE->tr[ 9] * dPos.vtY) +
-		 (sE->tr[10] * dPos.vtZ) +  sE->tr[11];
-	sPos.vtX = WLZ_CMESH_POS_DTOI(tV.vtX);
-	sPos.vtY = WLZ_CMESH_POS_DTOI(tV.vtY);
-	sPos.vtZ = WLZ_CMESH_POS_DTOI(tV.vtZ);
-	if((srcObj == NULL) ||
-	   (WlzInsideDomain(srcObj, sPos.vtZ, sPos.vtY, sPos.vtX, NULL) != 0))
+	if((errNum2 == WLZ_ERR_NONE) && (itvPlCnt > 0))
 	{
-	  ++itvLnCnt;
-	  WlzBitLnSetItv(lnMsk,
-	                 kol - mSWSp->dBox.xMin, kol - mSWSp->dBox.xMin,
-			 itvLnWidth);
+	  /* Add plane to plane domain. */
+	  *(dom3.p->domains + idP) = WlzAssignDomain(dom2, NULL);
+	}
+	else
+	{
+	  (void )WlzFreeDomain(dom2);
+	}
+	AlcFree(lnMsk);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanObjPDomain3D)
+#endif
+	  {
+	    errNum = errNum2;
+	  }
 	}
-      }
-      prvItv = curItv;
-      ++idI;
-      ++curItv;
-      if((errNum == WLZ_ERR_NONE) &&
-         (itvLnCnt > 0) &&
-	 ((curItv->plane != prvItv->plane) || (curItv->line != prvItv->line)))
-      {
-	/* Add previous line to interval domain. */
-	errNum = WlzDynItvLnFromBitLn(dom2.i, lnMsk, prvItv->line, itvLnWidth,
-	                              &itvPool);
-	memset(lnMsk, 0, itvLnByteWidth);
-	itvPlCnt += itvLnCnt;
-	itvLnCnt = 0;
-      }
-      if((errNum == WLZ_ERR_NONE) &&
-         (itvPlCnt > 0) &&
-	 (curItv->plane != prvItv->plane))
-      {
-        /* Add previous plane to plane domain. */
-	*(dom3.p->domains + prvItv->plane - dom3.p->plane1) =
-				 WlzAssignDomain(dom2, NULL);
-        itvPlCnt = 0;
-	itvPool.offset = 0;
-	itvPool.itvBlock = NULL;
-        dom2.core = NULL;
       }
     }
     if(errNum == WLZ_ERR_NONE)
@@ -6566,8 +6865,7 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
     }
   }
   /* Clear up. */
-  AlcFree(lnMsk);
-  (void )WlzFreeDomain(dom2);
+  AlcFree(plnItvIdx);
   /* Clear up on error. */
   if(errNum != WLZ_ERR_NONE)
   {
@@ -6583,39 +6881,55 @@ static WlzObject *WlzCMeshScanObjPDomain3D(WlzObject *srcObj,
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzTransform
-* \brief	Fills in the destination object's values from the source
-*		object, using the mesh scan workspace.
+* \brief	Fills in the values of a single plane of the destination
+*		object from the source object, using the mesh scan
+*		workspace. Only the given plane of the destination object
+*		is written to, so this function may be called concurrently
+*		for distinct planes given distinct grey value workspaces
+*		and overlap buffers.
 * \param	dstObj			Destination object with values to be
 *					set.
-* \param	srcObj			Source object.
 * \param	mSWSp			Mesh scan workspace which was used to
 *					compute the destination object's
-*					domain.
+*					domain and in which the inverse
+*					transforms of all the scan elements
+*					have been computed.
+* \param	idP			Index of the plane relative to the
+*					first plane of the destination object.
+* \param	mItvIdx0		Index of the first mesh interval on
+*					or after the plane.
+* \param	gVWSp			Grey value workspace for the source
+*					object.
+* \param	olpBuf			Overlap grey data buffer.
+* \param	olpCnt			Overlap counter.
+* \param	bufWidth		Width of the overlap buffers.
+* \param	gType			Grey type of the source object.
+* \param	bgdV			Background value of the source object.
 * \param	interp			Interpolation type.
 */
-static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
-					WlzObject *srcObj,
+static WlzErrorNum WlzCMeshScanObjPlnValues3D(WlzObject *dstObj,
 					WlzCMeshScanWSp3D *mSWSp,
+					int idP,
+					int mItvIdx0,
+					WlzGreyValueWSpace *gVWSp,
+					WlzGreyP olpBuf,
+					int *olpCnt,
+					int bufWidth,
+					WlzGreyType gType,
+					WlzPixelV bgdV,
 					WlzInterpolationType interp)
 {
-  int		idP,
-  		idI,
+  int		idI,
   		iLft,
 		iRgt,
-		mItvIdx0,
   		mItvIdx1,
-		bufWidth,
   		itvWidth;
   double	tD0,
   		tD1,
 		tD2,
 		tD3,
 		tD4;
-  int		*olpCnt = NULL;
-  WlzGreyP	dGP,
-  		olpBuf;
-  WlzGreyType	gType;
-  WlzPixelV	bgdV;
+  WlzGreyP	dGP;
   WlzIVertex3	dPos,
   		sPos;
   WlzDVertex3	tV,
@@ -6630,587 +6944,683 @@ static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
   WlzObject	*obj2 = NULL;
   WlzGreyWSpace gWSp;
   WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
   WlzErrorNum   errNum = WLZ_ERR_NONE;
 
-  olpBuf.inp = NULL;
-  bgdV = WlzGetBackground(srcObj, &errNum);
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gType = WlzGreyTypeFromObj(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bufWidth = dstObj->domain.p->lastkl - dstObj->domain.p->kol1 + 1;
-    errNum = WlzCMeshScanMakeOlpBufs(dstObj, gType,
-                                     &olpBuf, &olpCnt, bufWidth);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    mItvIdx0 = 0;
-    mItv0 = mSWSp->itvs;
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    idP = 0;
-    dom3.p = dstObj->domain.p;
-    val3.vox = dstObj->values.vox;
-    dPos.vtZ = dom3.p->plane1;
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ < dom3.p->lastpl))
+  dom3.p = dstObj->domain.p;
+  val3.vox = dstObj->values.vox;
+  dPos.vtZ = dom3.p->plane1 + idP;
+  mItv0 = mSWSp->itvs + mItvIdx0;
+  if(((dom2 = *(dom3.p->domains + idP)).core != NULL) &&
+     (dom2.core->type != WLZ_EMPTY_DOMAIN))
+  {
+    obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+		       *(dom3.p->domains + idP),
+		       *(val3.vox->values + idP),
+		       NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      if(((dom2 = *(dom3.p->domains + idP)).core != NULL) &&
-         (dom2.core->type != WLZ_EMPTY_DOMAIN))
+      errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+    }
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
+      WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
+      dGP = gWSp.u_grintptr;
+      /* Update the mesh interval pointer so that it points to the
+       * first mesh interval on the which intersects the current grey
+       * interval. */
+      while((mItv0->plane < dPos.vtZ) && (mItvIdx0 < mSWSp->nItvs))
       {
-	(void )WlzFreeObj(obj2);
-        obj2 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	                      *(dom3.p->domains + idP),
-			      *(val3.vox->values + idP),
-			      NULL, NULL, &errNum);
-        if(errNum == WLZ_ERR_NONE)
+	++mItvIdx0;
+	++mItv0;
+      }
+      while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
+      {
+	++mItvIdx0;
+	++mItv0;
+      }
+      while((mItv0->line <= iWSp.linpos) &&
+	    (mItv0->rgtI < iWSp.lftpos) &&
+	    (mItvIdx0 < mSWSp->nItvs))
+      {
+	++mItvIdx0;
+	++mItv0;
+      }
+      if((mItv0->line == iWSp.linpos) &&
+	 (iWSp.lftpos <= mItv0->rgtI) &&
+	 (iWSp.rgtpos >= mItv0->lftI))
+      {
+	/* Mesh interval mItv0 intersects the current grey interval find
+	 * the last mesh interval mItv1 which also intersects the current
+	 * grey interval. */
+	mItv1 = mItv0;
+	mItvIdx1 = mItvIdx0;
+	while((mItv1->line == iWSp.linpos) &&
+	      (mItv1->lftI <= iWSp.rgtpos) &&
+	      (mItvIdx1 < mSWSp->nItvs))
 	{
-	  errNum = WlzInitGreyScan(obj2, &iWSp, &gWSp);
+	  ++mItvIdx1;
+	  ++mItv1;
 	}
-	while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
-        {
-          itvWidth = iWSp.rgtpos - iWSp.lftpos + 1;
-	  WlzCMeshScanClearOlpBuf(olpBuf, olpCnt, gType, bufWidth, itvWidth);
-	  dGP = gWSp.u_grintptr;
-	  /* Update the mesh interval pointer so that it points to the
-	   * first mesh interval on the which intersects the current grey
-	   * interval. */
-	  while((mItv0->plane < dPos.vtZ) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line < iWSp.linpos) && (mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  while((mItv0->line <= iWSp.linpos) &&
-		(mItv0->rgtI < iWSp.lftpos) &&
-		(mItvIdx0 < mSWSp->nItvs))
-	  {
-	    ++mItvIdx0;
-	    ++mItv0;
-	  }
-	  if((mItv0->line == iWSp.linpos) &&
-	     (iWSp.lftpos <= mItv0->rgtI) &&
-	     (iWSp.rgtpos >= mItv0->lftI))
-	  {
-	    /* Mesh interval mItv0 intersects the current grey interval find
-	     * the last mesh interval mItv1 which also intersects the current
-	     * grey interval. */
-	    mItv1 = mItv0;
-	    mItvIdx1 = mItvIdx0;
-	    while((mItv1->line == iWSp.linpos) &&
-		  (mItv1->lftI <= iWSp.rgtpos) &&
-		  (mItvIdx1 < mSWSp->nItvs))
-	    {
-	      ++mItvIdx1;
-	      ++mItv1;
-	    }
-	    mItv2 = mItv1 - 1;
-	    mItv1 = mItv0;
-	    dPos.vtY = mItv0->line;
-	    /* For each mesh interval which intersects the current grey
-	       interval. */
-	    while(mItv1 <= mItv2)
-	    {
+	mItv2 = mItv1 - 1;
+	mItv1 = mItv0;
+	dPos.vtY = mItv0->line;
+	/* For each mesh interval which intersects the current grey
+	   interval. */
+	while(mItv1 <= mItv2)
+	{
 #ifdef WLZ_CMESHTRANSFORM_DEBUG
-      (void )fprintf(stderr,
-      		     "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
-		     mItv1->elmIdx,
-		     mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
+  (void )fprintf(stderr,
+		 "WlzCMeshScanObjValues3D %d %d %d %d %d\n",
+		 mItv1->elmIdx,
+		 mItv1->lftI, mItv1->rgtI, mItv1->line, mItv1->plane);
 #endif
-	      /* Update mesh scanning. */
-	      sE = mSWSp->dElm + mItv1->elmIdx;
-	      if((sE->flags & WLZ_CMESH_SCANELM_REV) == 0)
+	  /* Scan element of the mesh interval. */
+	  sE = mSWSp->dElm + mItv1->elmIdx;
+	  tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
+		   sE->tr[ 3];
+	  tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
+		   sE->tr[ 7];
+	  tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
+		   sE->tr[11];
+	  /* Find length of intersection and set the grey pointer. */
+	  iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
+	  iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
+	  dPos.vtX = iLft;
+	  switch(interp)
+	  {
+	    case WLZ_INTERPOLATION_NEAREST:
+	      switch(gType)
 	      {
-	         WlzCMeshUpdateScanElm3D(mSWSp->mTr, sE, 0);
+		case WLZ_GREY_INT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_SHORT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_UBYTE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_FLOAT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_RGBA:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		    sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		    sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		    WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
+					     gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + bufWidth + idI) +=
+			  WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + (2 * bufWidth) + idI) +=
+			  WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
+		      *(olpBuf.inp + (3 * bufWidth) + idI) +=
+			  WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		default:
+		  errNum = WLZ_ERR_GREY_TYPE;
+		  break;
 	      }
-	      tV.vtX = (sE->tr[ 1] * dPos.vtY) + (sE->tr[ 2] * dPos.vtZ) +
-		       sE->tr[ 3];
-	      tV.vtY = (sE->tr[ 5] * dPos.vtY) + (sE->tr[ 6] * dPos.vtZ) +
-		       sE->tr[ 7];
-	      tV.vtZ = (sE->tr[ 9] * dPos.vtY) + (sE->tr[10] * dPos.vtZ) +
-		       sE->tr[11];
-	      /* Find length of intersection and set the grey pointer. */
-	      iLft = ALG_MAX(mItv1->lftI, iWSp.lftpos);
-	      iRgt = ALG_MIN(mItv1->rgtI, iWSp.rgtpos);
-	      dPos.vtX = iLft;
-	      switch(interp)
+	      break;
+	    case WLZ_INTERPOLATION_LINEAR:
+	      switch(gType)
 	      {
-		case WLZ_INTERPOLATION_NEAREST:
-		  switch(gType)
+		case WLZ_GREY_INT:
+		  while(dPos.vtX <= iRgt)
 		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).inv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).inv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).inv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_RGBA_RED_GET(
-						 gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + bufWidth + idI) +=
-			      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
 		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    }
+		    ++dPos.vtX;
 		  }
 		  break;
-		case WLZ_INTERPOLATION_LINEAR:
-		  switch(gType)
+		case WLZ_GREY_SHORT:
+		  while(dPos.vtX <= iRgt)
 		  {
-		    case WLZ_GREY_INT:
-		      while(dPos.vtX <= iRgt)
-		      {
-			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).inv * tD2 * tD3) +
-				((gVWSp->gVal[1]).inv * tD0 * tD3) +
-				((gVWSp->gVal[2]).inv * tD2 * tD1) +
-				((gVWSp->gVal[3]).inv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].inv;
-			  }
-			}
-			++dPos.vtX;
-		      }
-		      break;
-		    case WLZ_GREY_SHORT:
-		      while(dPos.vtX <= iRgt)
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).shv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).shv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).shv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).shv * tD2 * tD3) +
-				((gVWSp->gVal[1]).shv * tD0 * tD3) +
-				((gVWSp->gVal[2]).shv * tD2 * tD1) +
-				((gVWSp->gVal[3]).shv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY, sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].shv;
 		      }
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_UBYTE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).ubv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).ubv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).ubv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD0);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).ubv * tD2 * tD3) +
-				((gVWSp->gVal[1]).ubv * tD0 * tD3) +
-				((gVWSp->gVal[2]).ubv * tD2 * tD1) +
-				((gVWSp->gVal[3]).ubv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD0);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) += gVWSp->gVal[0].ubv;
 		      }
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_FLOAT:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).flv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).flv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).flv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += tD0;
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).flv * tD2 * tD3) +
-				((gVWSp->gVal[1]).flv * tD0 * tD3) +
-				((gVWSp->gVal[2]).flv * tD2 * tD1) +
-				((gVWSp->gVal[3]).flv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].flv;
 		      }
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_DOUBLE:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
+			    ((gVWSp->gVal[1]).dbv * tD0 * tD3) +
+			    ((gVWSp->gVal[2]).dbv * tD2 * tD1) +
+			    ((gVWSp->gVal[3]).dbv * tD0 * tD1);
+		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+		      idI = dPos.vtX - iWSp.lftpos;
+		      ++*(olpCnt + idI);
+		      *(olpBuf.dbp + idI) += tD0;
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD0 = ((gVWSp->gVal[0]).dbv * tD2 * tD3) +
-				((gVWSp->gVal[1]).dbv * tD0 * tD3) +
-				((gVWSp->gVal[2]).dbv * tD2 * tD1) +
-				((gVWSp->gVal[3]).dbv * tD0 * tD1);
-			  tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-			  idI = dPos.vtX - iWSp.lftpos;
-			  ++*(olpCnt + idI);
-			  *(olpBuf.dbp + idI) += tD0;
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.dbp + idI) += gVWSp->gVal[0].dbv;
 		      }
-		      break;
-		    case WLZ_GREY_RGBA:
-		      while(dPos.vtX <= iRgt)
+		    }
+		    ++dPos.vtX;
+		  }
+		  break;
+		case WLZ_GREY_RGBA:
+		  while(dPos.vtX <= iRgt)
+		  {
+		    idI = dPos.vtX - iWSp.lftpos;
+		    sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
+		    sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
+		    sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
+		    WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
+				       sPosD.vtX);
+		    if(gVWSp->bkdFlag == 0)
+		    {
+		      tD0 = sPosD.vtX - floor(sPosD.vtX);
+		      tD1 = sPosD.vtY - floor(sPosD.vtY);
+		      tD2 = 1.0 - tD0;
+		      tD3 = 1.0 - tD1;
+		      tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      ++*(olpCnt + idI);
+		      *(olpBuf.inp + idI) += WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + (2 * bufWidth) + idI) +=
+			  WLZ_NINT(tD4);
+		      tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
+			     tD2 * tD3) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
+			     tD0 * tD3) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
+			     tD2 * tD1) +
+			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
+			     tD0 * tD1);
+		      tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
+		      *(olpBuf.inp + (3 * bufWidth) + idI) +=
+			  WLZ_NINT(tD4);
+		    }
+		    else
+		    {
+		      sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
+		      sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
+		      sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
+		      WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
+				      sPos.vtX);
+		      if(gVWSp->bkdFlag == 0)
 		      {
 			idI = dPos.vtX - iWSp.lftpos;
-			sPosD.vtX = (sE->tr[ 0] * dPos.vtX) + tV.vtX;
-			sPosD.vtY = (sE->tr[ 4] * dPos.vtX) + tV.vtY;
-			sPosD.vtZ = (sE->tr[ 8] * dPos.vtX) + tV.vtZ;
-			WlzGreyValueGetCon(gVWSp, sPosD.vtZ, sPosD.vtY,
-					   sPosD.vtX);
-			if(gVWSp->bkdFlag == 0)
-			{
-			  tD0 = sPosD.vtX - floor(sPosD.vtX);
-			  tD1 = sPosD.vtY - floor(sPosD.vtY);
-			  tD2 = 1.0 - tD0;
-			  tD3 = 1.0 - tD1;
-			  tD4 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  ++*(olpCnt + idI);
-			  *(olpBuf.inp + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + bufWidth + idI) += WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + (2 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			  tD4 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-				 tD2 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-				 tD0 * tD3) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-				 tD2 * tD1) +
-				(WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-				 tD0 * tD1);
-			  tD4 = WLZ_CLAMP(tD4, 0.0, 255.0);
-			  *(olpBuf.inp + (3 * bufWidth) + idI) +=
-			      WLZ_NINT(tD4);
-			}
-			else
-			{
-			  sPos.vtX = WLZ_CMESH_POS_DTOI(sPosD.vtX);
-			  sPos.vtY = WLZ_CMESH_POS_DTOI(sPosD.vtY);
-			  sPos.vtZ = WLZ_CMESH_POS_DTOI(sPosD.vtZ);
-			  WlzGreyValueGet(gVWSp, sPos.vtZ, sPos.vtY,
-					  sPos.vtX);
-			  if(gVWSp->bkdFlag == 0)
-			  {
-			    idI = dPos.vtX - iWSp.lftpos;
-			    ++*(olpCnt + idI);
-			    *(olpBuf.inp + idI) +=
-				      WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + bufWidth + idI) +=
-				      WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (2 * bufWidth) + idI) +=
-				      WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
-			    *(olpBuf.inp + (3 * bufWidth) + idI) +=
-				      WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
-			  }
-			}
-			++dPos.vtX;
+			++*(olpCnt + idI);
+			*(olpBuf.inp + idI) +=
+				  WLZ_RGBA_RED_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + bufWidth + idI) +=
+				  WLZ_RGBA_GREEN_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (2 * bufWidth) + idI) +=
+				  WLZ_RGBA_BLUE_GET(gVWSp->gVal[0].rgbv);
+			*(olpBuf.inp + (3 * bufWidth) + idI) +=
+				  WLZ_RGBA_ALPHA_GET(gVWSp->gVal[0].rgbv);
 		      }
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
+		    }
+		    ++dPos.vtX;
 		  }
 		  break;
-		case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
-		  errNum = WLZ_ERR_UNIMPLEMENTED;
-		  break;
 		default:
-		  errNum = WLZ_ERR_INTERPOLATION_TYPE;
+		  errNum = WLZ_ERR_GREY_TYPE;
 		  break;
 	      }
-	      ++mItv1;
-	    }
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
-					     bgdV, iWSp.lftpos, iWSp.rgtpos,
-					     interp, gType);
+	      break;
+	    case WLZ_INTERPOLATION_CLASSIFY_1:     /* FALLTHROUGH */
+	      errNum = WLZ_ERR_UNIMPLEMENTED;
+	      break;
+	    default:
+	      errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	      break;
 	  }
-        }
-	if(errNum == WLZ_ERR_EOO)
-	{
-	  errNum = WLZ_ERR_NONE;
+	  ++mItv1;
 	}
       }
-      ++idP;
-      ++dPos.vtZ;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzCMeshScanFlushOlpBuf(dGP, olpBuf, olpCnt, bufWidth,
+					 bgdV, iWSp.lftpos, iWSp.rgtpos,
+					 interp, gType);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
     }
   }
   (void )WlzFreeObj(obj2);
-  AlcFree(olpBuf.inp);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Fills in the destination object's values from the source
+*		object, using the mesh scan workspace.
+*		When built with OpenMP the planes of the destination
+*		object are partitioned between the threads, each thread
+*		having its own overlap buffers. Each plane's values are
+*		only written by the thread which processes it so no
+*		locking of the output is required. A new grey value
+*		workspace is used for each plane because the values
+*		it gives for linear interpolation can depend on its
+*		previous accesses, this keeps the values independent
+*		of the number of threads.
+* \param	dstObj			Destination object with values to be
+*					set.
+* \param	srcObj			Source object.
+* \param	mSWSp			Mesh scan workspace which was used to
+*					compute the destination object's
+*					domain.
+* \param	interp			Interpolation type.
+*/
+static WlzErrorNum WlzCMeshScanObjValues3D(WlzObject *dstObj,
+					WlzObject *srcObj,
+					WlzCMeshScanWSp3D *mSWSp,
+					WlzInterpolationType interp)
+{
+  int		idP,
+  		idT,
+		nPln,
+		nThr = 1,
+		bufWidth;
+  int		*plnItvIdx = NULL;
+  int		**olpCnt = NULL;
+  WlzGreyP	*olpBuf = NULL;
+  WlzGreyType	gType;
+  WlzPixelV	bgdV;
+  WlzDomain	dom3;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  bgdV = WlzGetBackground(srcObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTypeFromObj(srcObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzValueConvertPixel(&bgdV, bgdV, gType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dom3.p = dstObj->domain.p;
+    nPln = dom3.p->lastpl - dom3.p->plane1 + 1;
+    bufWidth = dom3.p->lastkl - dom3.p->kol1 + 1;
+    plnItvIdx = WlzCMeshScanPlnItvIdx3D(mSWSp, dom3.p->plane1, nPln,
+                                        &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if(((olpCnt = (int **)AlcCalloc(nThr, sizeof(int *))) == NULL) ||
+       ((olpBuf = (WlzGreyP *)AlcCalloc(nThr, sizeof(WlzGreyP))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+    {
+      errNum = WlzCMeshScanMakeOlpBufs(dstObj, gType,
+				       olpBuf + idT, olpCnt + idT, bufWidth);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The last plane is excluded as it always has been here. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThr)
+#endif
+    for(idP = 0; idP < nPln - 1; ++idP)
+    {
+      int	thrId = 0;
+      WlzGreyValueWSpace *gVWSp;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum2);
+      if(errNum2 == WLZ_ERR_NONE)
+      {
+	errNum2 = WlzCMeshScanObjPlnValues3D(dstObj, mSWSp,
+					     idP, plnItvIdx[idP], gVWSp,
+					     olpBuf[thrId], olpCnt[thrId],
+					     bufWidth, gType, bgdV, interp);
+      }
+      WlzGreyValueFreeWSp(gVWSp);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzCMeshScanObjValues3D)
+#endif
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  for(idT = 0; idT < nThr; ++idT)
+  {
+    if(olpBuf)
+    {
+      AlcFree(olpBuf[idT].inp);
+    }
+    if(olpCnt)
+    {
+      AlcFree(olpCnt[idT]);
+    }
+  }
+  AlcFree(olpBuf);
   AlcFree(olpCnt);
-  WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(plnItvIdx);
   return(errNum);
 }
 
+
 /*!
 * \return	void
 * \ingroup	WlzTransform
@@ -53,7 +53,7 @@ static void			WlzCMeshFilterLPL2D(
 				  double lambda,
 				  int doBnd);
 static void			WlzCMeshFilterLPL3D(
-				  WlzCMesh3D *mesh,
+				  WlzCMeshArr3D *arr,
 				  WlzDVertex3 *vGIn,
 				  WlzDVertex3 *vGOut,
 				  double lambda,
@@ -64,8 +64,8 @@ static WlzDVertex2 		WlzCMeshFilterLPLDelta2D(
 				  WlzDVertex2 *vBuf,
 				  int doBnd);
 static WlzDVertex3 		WlzCMeshFilterLPLDelta3D(
-				  WlzCMesh3D *mesh,
-				  WlzCMeshNod3D *nod,
+				  WlzCMeshArr3D *arr,
+				  int idx,
 				  WlzDVertex3 *vBuf,
 				  int doBnd);
 static WlzErrorNum		WlzCMeshValuesNormalise2D(
@@ -325,6 +325,7 @@ void     	WlzCMeshUpdateBBox2D(WlzCMesh2D *mesh)
 
   if(mesh && (mesh->type == WLZ_CMESH_2D))
   {
+    WlzCMeshFreeLocGrid2D(mesh);
     /* Update the bounding box. */
     firstNod = 1;
     for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
@@ -444,6 +445,7 @@ void            WlzCMeshUpdateBBox3D(WlzCMesh3D *mesh)
 
   if(mesh && (mesh->type == WLZ_CMESH_3D))
   {
+    WlzCMeshFreeLocGrid3D(mesh);
     /* Update the bounding box. */
     firstNod = 1;
     for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
@@ -1631,6 +1633,10 @@ WlzErrorNum	WlzCMeshLaplacianSmooth2D(WlzCMesh2D *mesh,
 * \brief	Applies a Laplacian smoothing to the 3D mesh in which
 *		nodes are iteratively moved to the centroid of their
 *		imediate neighbours. See WlzCMeshLaplacianSmooth().
+*		The smoothing is done using a compact copy of the mesh
+*		which is traversed in the same order as the mesh itself,
+*		with the node positions being set in the mesh once all
+*		the iterations have been done.
 * \param	mesh			Given mesh.
 * \param	itr			Number of iterations.
 * \param	alpha			Weight factor.
@@ -1645,51 +1651,70 @@ WlzErrorNum	WlzCMeshLaplacianSmooth3D(WlzCMesh3D *mesh,
 {
   int		idI,
   		idN,
+		idR,
   		nCnt;
+  double	*nodX,
+  		*nodY,
+		*nodZ;
   WlzDVertex3	nPos;
-  WlzCMeshNod3D *nod,
-  		*oNod;
-  WlzCMeshEdgU3D *edu0,
-  		*edu1;
+  WlzCMeshArr3D	*arr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mesh && (mesh->type == WLZ_CMESH_3D))
   {
-    for(idI = 0; idI < itr; ++idI)
+    arr = WlzCMeshArrFromCMesh3D(mesh, &errNum);
+    if(errNum == WLZ_ERR_NONE)
     {
-      for(idN = 0; idN < mesh->res.nod.maxEnt; ++idN)
+      nodX = arr->nodX;
+      nodY = arr->nodY;
+      nodZ = arr->nodZ;
+      for(idI = 0; idI < itr; ++idI)
       {
-	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
-	if(nod->idx >= 0)
+	for(idN = 0; idN < arr->maxNod; ++idN)
 	{
-          if(doBnd || ((nod->flags & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
+	  if((arr->nodIdx[idN] >= 0) &&
+	     (doBnd ||
+	      ((arr->nodFlags[idN] & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0)))
 	  {
 	    nCnt = 0;
 	    nPos.vtX = nPos.vtY = nPos.vtZ = 0.0;
-	    edu0 = edu1 = nod->edu;
-	    do
+	    for(idR = arr->ringOff[idN]; idR < arr->ringOff[idN + 1]; ++idR)
 	    {
-	      oNod = edu1->next->nod;
-	      nPos.vtX += oNod->pos.vtX;
-	      nPos.vtY += oNod->pos.vtY;
-	      nPos.vtZ += oNod->pos.vtZ;
+	      int	oIdx;
+
+	      oIdx = arr->ringNod[idR];
+	      nPos.vtX += nodX[oIdx];
+	      nPos.vtY += nodY[oIdx];
+	      nPos.vtZ += nodZ[oIdx];
 	      ++nCnt;
-	      edu1 = edu1->nnxt;
-	    } while(edu0 != edu1);
+	    }
 	    if(nCnt > 0)
 	    {
-	      nod->pos.vtX = (1.0 - alpha) * nod->pos.vtX + 
-			     alpha * nPos.vtX / nCnt;
-	      nod->pos.vtY = (1.0 - alpha) * nod->pos.vtY + 
-			     alpha * nPos.vtY / nCnt;
-	      nod->pos.vtZ = (1.0 - alpha) * nod->pos.vtZ + 
-			     alpha * nPos.vtZ / nCnt;
+	      nodX[idN] = (1.0 - alpha) * nodX[idN] + alpha * nPos.vtX / nCnt;
+	      nodY[idN] = (1.0 - alpha) * nodY[idN] + alpha * nPos.vtY / nCnt;
+	      nodZ[idN] = (1.0 - alpha) * nodZ[idN] + alpha * nPos.vtZ / nCnt;
 	    }
 	  }
 	}
       }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(idN = 0; idN < arr->maxNod; ++idN)
+      {
+	if(arr->nodIdx[idN] >= 0)
+	{
+	  WlzCMeshNod3D *nod;
+
+	  nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	  nod->pos.vtX = nodX[idN];
+	  nod->pos.vtY = nodY[idN];
+	  nod->pos.vtZ = nodZ[idN];
+	}
+      }
+      WlzCMeshArrFree3D(arr);
     }
-    if(update)
+    if((errNum == WLZ_ERR_NONE) && update)
     {
       WlzCMeshUpdateBBox3D(mesh);
       WlzCMeshUpdateMaxSqEdgLen3D(mesh);
@@ -1837,12 +1862,19 @@ WlzErrorNum	WlzCMeshLPFilterLM(WlzCMeshP mesh,
 	}
 	else
 	{
-	  for(idI = 0; idI < nItr; ++idI)
+	  WlzCMeshArr3D *arr;
+
+	  arr = WlzCMeshArrFromCMesh3D(mesh.m3, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    WlzCMeshFilterLPL3D(mesh.m3, vtxBuf[0].d3, vtxBuf[1].d3,
-	                        lambda, doBnd);
-	    WlzCMeshFilterLPL3D(mesh.m3, vtxBuf[1].d3, vtxBuf[0].d3,
-	                        lambda, doBnd);
+	    for(idI = 0; idI < nItr; ++idI)
+	    {
+	      WlzCMeshFilterLPL3D(arr, vtxBuf[0].d3, vtxBuf[1].d3,
+				  lambda, doBnd);
+	      WlzCMeshFilterLPL3D(arr, vtxBuf[1].d3, vtxBuf[0].d3,
+				  lambda, doBnd);
+	    }
+	    WlzCMeshArrFree3D(arr);
 	  }
 	}
 	break;
@@ -3127,36 +3159,35 @@ static void	WlzCMeshFilterLPL2D(WlzCMesh2D *mesh,
 * \ingroup      WlzMesh
 * \brief        Filters the geometry of the verticies in a 3D mesh using
 *               the given input and output buffers for the mesh node
-*		positions.
+*		positions. The nodes are filtered in parallel using the
+*		edge use rings of the compact mesh.
 * \note         See WlzGMFilterGeomLPLM().
-* \param        model                   The given model.
+* \param        arr                     Compact copy of the mesh.
 * \param        vGIn                    Input vertex geometries.
 * \param        vGOut                   Output vertex geometries.
 * \param        lambda                  The filter parameter.
-* \param        nonMan                  If non-zero allows non manifold
+* \param        doBnd                   Filter boundary nodes if non-zero.
 */
-static void	WlzCMeshFilterLPL3D(WlzCMesh3D *mesh,
+static void	WlzCMeshFilterLPL3D(WlzCMeshArr3D *arr,
 				    WlzDVertex3 *vGIn, WlzDVertex3 *vGOut,
 				    double lambda, int doBnd)
 {
-  int           idx,
-                cnt;
-  WlzDVertex3   tV0,
-                tV1;
-  WlzCMeshNod3D  *cN;
-  AlcVector     *vec;
+  int           idx;
 
-  cnt = mesh->res.nod.maxEnt;
-  vec = mesh->res.nod.vec;
-  for(idx = 0; idx < cnt; ++idx)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idx = 0; idx < arr->maxNod; ++idx)
   {
-    cN = (WlzCMeshNod3D *)AlcVectorItemGet(vec, idx);
-    if(cN->idx >= 0)
+    if(arr->nodIdx[idx] >= 0)
     {
+      WlzDVertex3 tV0,
+      		  tV1;
+
       tV0 = *(vGIn + idx);
-      if(doBnd || ((cN->flags & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
+      if(doBnd || ((arr->nodFlags[idx] & WLZ_CMESH_NOD_FLAG_BOUNDARY) == 0))
       {
-	tV1 = WlzCMeshFilterLPLDelta3D(mesh, cN, vGIn, doBnd);
+	tV1 = WlzCMeshFilterLPLDelta3D(arr, idx, vGIn, doBnd);
 	tV0.vtX += lambda * tV1.vtX;
 	tV0.vtY += lambda * tV1.vtY;
 	tV0.vtZ += lambda * tV1.vtZ;
@@ -3223,40 +3254,35 @@ static WlzDVertex2 WlzCMeshFilterLPLDelta2D(WlzCMesh2D *mesh,
 *		from the nodes position to the mean of the directly
 *		connected neighbour node positions. All positions are
 *		taken from the vertex buffer using the nodes index value.
-* \param	mesh			The mesh.
-* \param	nod			The current node.
+* \param	arr			Compact copy of the mesh.
+* \param	idx			Index of the current node.
 * \param	vBuf			Buffer of node positions.
 * \param	doBnd			Filter boundary nodes if non-zero.
 */
-static WlzDVertex3 WlzCMeshFilterLPLDelta3D(WlzCMesh3D *mesh,
-					WlzCMeshNod3D *nod, WlzDVertex3 *vBuf,
+static WlzDVertex3 WlzCMeshFilterLPLDelta3D(WlzCMeshArr3D *arr,
+					int idx, WlzDVertex3 *vBuf,
 					int doBnd)
 {
-  int           nN = 0;
+  int           idR,
+  		nN = 0;
   double        tD0;
-  WlzCMeshNod3D	*oNod;
-  WlzCMeshEdgU3D *edu0,
-  		*edu1;
   WlzDVertex3   nP,
                 sP;
 
   sP.vtX = sP.vtY = sP.vtZ = 0.0;
-  if((nod->idx >= 0) &&
-     (doBnd || ((nod->flags & WLZ_CMESH_NOD_FLAG_BOUNDARY) != 0)))
+  if((arr->nodIdx[idx] >= 0) &&
+     (doBnd || ((arr->nodFlags[idx] & WLZ_CMESH_NOD_FLAG_BOUNDARY) != 0)))
   {
-    edu0 = edu1 = nod->edu;
-    do
+    for(idR = arr->ringOff[idx]; idR < arr->ringOff[idx + 1]; ++idR)
     {
-      oNod = edu1->next->nod;
-      nP = *(vBuf + oNod->idx);
+      nP = *(vBuf + arr->ringNod[idR]);
       WLZ_VTX_3_ADD(sP, sP, nP);
       ++nN;
-      edu1 = edu1->nnxt;
-    } while(edu0 != edu1);
+    }
     if(nN > 0)
     {
       tD0 = 1.0 / nN;
-      nP = *(vBuf + nod->idx);
+      nP = *(vBuf + idx);
       sP.vtX = (tD0 * sP.vtX) - nP.vtX;
       sP.vtY = (tD0 * sP.vtY) - nP.vtY;
       sP.vtZ = (tD0 * sP.vtZ) - nP.vtZ;
@@ -44,8 +44,14 @@ static char _WlzContour_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <string.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define WLZ_CTR_TOLERANCE	(1.0e-06)
+#define WLZ_CTR_SLAB_PLANES	(16)	/* Number of cube layers in each slab
+					 * of an iso-surface computed
+					 * concurrently. */
 
 /* #define WLZ_CONTOUR_DEBUG */
 
@@ -82,6 +88,44 @@ typedef enum _WlzContourBndSamMethod
   WLZ_CONTOUR_BNDPTS_RANDOM
 } WlzContourBndSamMethod;
 
+/*!
+* \struct	_WlzContourSxBuf
+* \ingroup	WlzContour
+* \brief	Buffer of 3D simplices (triangles) which have been
+* 		computed but not yet added to a geometric model.
+*		Typedef: ::WlzContourSxBuf.
+*/
+typedef struct _WlzContourSxBuf
+{
+  int		nSx;			/*!< Number of simplices in the
+  					     buffer. */
+  int		maxSx;			/*!< Number of simplices for which
+  					     space has been allocated. */
+  WlzDVertex3	*vtx;			/*!< Simplex vertices, three
+  					     consecutive vertices for each
+					     simplex. */
+} WlzContourSxBuf;
+
+/*!
+* \struct	_WlzContourIsoSlab3D
+* \ingroup	WlzContour
+* \brief	Workspace for computing the iso-surface simplices
+* 		within a slab of planes of a 3D object.
+*		Typedef: ::WlzContourIsoSlab3D.
+*/
+typedef struct _WlzContourIsoSlab3D
+{
+  WlzObject	*obj2D;			/*!< 2D object used to access the
+  					     planes of the 3D object. */
+  WlzUByte	**itvBuf[2];		/*!< Domain bit buffers for a pair
+  					     of planes. */
+  double	**valBuf[2];		/*!< Value buffers for a pair of
+  					     planes. */
+  WlzContourSxBuf sxBuf;		/*!< Simplices computed within the
+  					     slab. */
+  WlzErrorNum	errNum;			/*!< Error code for the slab. */
+} WlzContourIsoSlab3D;
+
 static WlzContour	*WlzContourIsoObj2D(
 			  WlzObject *srcObj,
 			  double isoVal,
@@ -212,6 +256,7 @@ static WlzErrorNum 	WlzContourGrdCube3D(
 			  WlzIVertex3 bufPos,
 			  WlzIVertex3 cbOrg);
 static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
+			  WlzContourSxBuf *sxBuf,
 			  double isoVal,
 			  double *pn0ln0,
 			  double *pn0ln1,
@@ -220,9 +265,22 @@ static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
 			  WlzDVertex3 cbOrg);
 static WlzErrorNum	WlzContourIsoTet3D(
 			  WlzContour *ctr,
+			  WlzContourSxBuf *sxBuf,
 			  double *tVal,
 			  WlzDVertex3 *tPos,
 			  WlzDVertex3 cbOrg);
+static WlzErrorNum	WlzContourIsoSlabPlanes3D(
+			  WlzObject *srcObj,
+			  WlzContourIsoSlab3D *slab,
+			  double isoVal,
+			  WlzIBox3 bBox3D,
+			  WlzIVertex2 bufSz,
+			  int pnFirst,
+			  int pnLast);
+static WlzErrorNum	WlzContourSxAdd3D(
+			  WlzContour *ctr,
+			  WlzContourSxBuf *sxBuf,
+			  WlzDVertex3 *vtx);
 static WlzErrorNum	WlzContourGrdLink2D(
 			  WlzContour *ctr,
 			  WlzUByte **grdDBuf,
@@ -1055,6 +1113,12 @@ static WlzContour *WlzContourIsoObj2D(WlzObject *srcObj, double isoVal,
 * \ingroup	WlzContour
 * \brief	Creates an iso-value contour (list of surface patches)
 *               from a 3D Woolz object's values.
+*		The planes of the object are swept in batches of slabs,
+*		with the simplices of each slab computed concurrently
+*		into a buffer. The buffered simplices are then added to
+*		the contour's model in plane order, so the model is the
+*		same as would be built by a single sweep and does not
+*		depend on the number of threads.
 * \param	srcObj			Given object from which to
 *                                       compute the contours.
 * \param	isoVal			The iso-value.
@@ -1064,31 +1128,18 @@ static WlzContour *WlzContourIsoObj2D(WlzObject *srcObj, double isoVal,
 static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 				      WlzErrorNum *dstErr)
 {
-  int		klIdx,
-  		lnIdx,
-		pnIdx,
-		klCnt,
-  		lnCnt,
-		pnCnt,
-  		bufIdx0,
-  		bufIdx1,
-		lastKlIn,
-		thisKlIn;
-  WlzObject	*obj2D = NULL;
+  int		idB,
+  		idS,
+		idX,
+  		nSlab = 1,
+		pnBat,
+		pnCnt;
   WlzValues	dummyValues;
   WlzDomain	dummyDom,
   		srcDom;
-  WlzIVertex2	bufSz,
-		bufOff;
-  WlzIBox2	bBox2D;
+  WlzIVertex2	bufSz;
   WlzIBox3	bBox3D;
-  WlzDVertex3	cbOrg;
-  WlzUByte	*tUP0,
-  		*tUP1,
-		*tUP2,
-		*tUP3;
-  WlzUByte	**itvBuf[2] = {NULL, NULL};
-  double	**valBuf[2] = {NULL, NULL};
+  WlzContourIsoSlab3D *slab = NULL;
   WlzContour 	*ctr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -1128,99 +1179,82 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   {
     bBox3D = WlzBoundingBox3I(srcObj, &errNum);
   }
-  /* Make buffers. */
+  /* Make a workspace with buffers for each of the slabs. */
   if(errNum == WLZ_ERR_NONE)
   {
+    pnCnt = srcObj->domain.p->lastpl - srcObj->domain.p->plane1 + 1;
+#ifdef _OPENMP
+    nSlab = omp_get_max_threads();
+#endif
+    idS = (pnCnt + WLZ_CTR_SLAB_PLANES - 2) / WLZ_CTR_SLAB_PLANES;
+    nSlab = WLZ_CLAMP(nSlab, 1, ALG_MAX(idS, 1));
     bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
     bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
-    if((AlcBit2Calloc(&(itvBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(itvBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+    if((slab = (WlzContourIsoSlab3D *)
+               AlcCalloc(nSlab, sizeof(WlzContourIsoSlab3D))) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < nSlab); ++idS)
+    {
+      if((AlcBit2Calloc(&(slab[idS].itvBuf[0]),
+                        bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+         (AlcBit2Calloc(&(slab[idS].itvBuf[1]),
+	                bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+         (AlcDouble2Malloc(&(slab[idS].valBuf[0]),
+	                   bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+         (AlcDouble2Malloc(&(slab[idS].valBuf[1]),
+	                   bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	slab[idS].obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
+				      NULL, NULL, &errNum);
+      }
+    }
   }
-  /* Sweep down through the object using a pair of plane buffers. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
-			NULL, NULL, &errNum);
-  }
+  /* Sweep down through the object a batch of slabs at a time, with the
+   * slabs of a batch swept concurrently and the simplices of the batch
+   * then added to the model in order. */
   if(errNum == WLZ_ERR_NONE)
   {
-    pnIdx = 0;
-    pnCnt = srcObj->domain.p->lastpl - srcObj->domain.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    pnBat = 0;
+    while((errNum == WLZ_ERR_NONE) && (pnBat < pnCnt - 1))
     {
-      cbOrg.vtZ = bBox3D.zMin + pnIdx;
-      bufIdx0 = (pnIdx + 1) % 2;
-      bufIdx1 = pnIdx % 2;
-      obj2D->domain = *(srcObj->domain.p->domains + pnIdx);
-      obj2D->values = *(srcObj->values.vox->values + pnIdx);
-      bBox2D = WlzBoundingBox2I(obj2D, &errNum);
-      if(errNum == WLZ_ERR_NONE)
-      {
-        bufOff.vtX = bBox3D.xMin;
-        bufOff.vtY = bBox3D.yMin;
-        errNum = WlzToArray2D((void ***)&(itvBuf[bufIdx1]), obj2D,
-			      bufSz, bufOff, 0, WLZ_GREY_BIT);
-      }
-      if(errNum == WLZ_ERR_NONE)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nSlab)
+#endif
+      for(idS = 0; idS < nSlab; ++idS)
       {
-        errNum = WlzToArray2D((void ***)&(valBuf[bufIdx1]), obj2D,
-			      bufSz, bufOff, 0, WLZ_GREY_DOUBLE);
+        int	pnFirst,
+		pnLast;
+
+	pnFirst = pnBat + (idS * WLZ_CTR_SLAB_PLANES);
+	pnLast = ALG_MIN(pnFirst + WLZ_CTR_SLAB_PLANES, pnCnt - 1);
+	slab[idS].sxBuf.nSx = 0;
+	if(pnFirst < pnLast)
+	{
+	  slab[idS].errNum = WlzContourIsoSlabPlanes3D(srcObj, slab + idS,
+	  				isoVal, bBox3D, bufSz,
+					pnFirst, pnLast);
+	}
       }
-      if(errNum == WLZ_ERR_NONE)
+      for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < nSlab); ++idS)
       {
-	/* Compute the intersection of the iso-value plane with each cube
-	 * of values. */
-	if(pnIdx > 0)
+	errNum = slab[idS].errNum;
+        idX = 0;
+	for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < slab[idS].sxBuf.nSx);
+	    ++idB)
 	{
-	  klCnt = bBox2D.xMax - bBox2D.xMin; 			  /* NOT + 1 */
-	  lnIdx = bBox2D.yMin - bBox3D.yMin;
-	  lnCnt = bBox2D.yMax - bBox2D.yMin; 			  /* NOT + 1 */
-	  while(lnIdx < lnCnt)
-	  {
-            cbOrg.vtY = bBox3D.yMin + lnIdx;
-	    tUP0 = *(itvBuf[bufIdx0] + lnIdx);
-	    tUP1 = *(itvBuf[bufIdx0] + lnIdx + 1);
-	    tUP2 = *(itvBuf[bufIdx1] + lnIdx);
-	    tUP3 = *(itvBuf[bufIdx1] + lnIdx + 1);
-	    klIdx = bBox2D.xMin - bBox3D.xMin;
-	    lastKlIn = (WLZ_BIT_GET(tUP0, klIdx) != 0) &&
-	    	       (WLZ_BIT_GET(tUP1, klIdx) != 0) &&
-		       (WLZ_BIT_GET(tUP2, klIdx) != 0) &&
-		       (WLZ_BIT_GET(tUP3, klIdx) != 0);
-	    while(klIdx < klCnt)
-	    {
-	      /* Check if cube is within the 3D object's domain. */
-	      thisKlIn = (WLZ_BIT_GET(tUP0, klIdx + 1) != 0) &&
-	      		 (WLZ_BIT_GET(tUP1, klIdx + 1) != 0) &&
-			 (WLZ_BIT_GET(tUP2, klIdx + 1) != 0) &&
-			 (WLZ_BIT_GET(tUP3, klIdx + 1) != 0);
-	      if(lastKlIn && thisKlIn)
-	      {
-                cbOrg.vtX = bBox3D.xMin + klIdx;
-		errNum = WlzContourIsoCube3D6T(ctr, isoVal,
-				       *(valBuf[bufIdx0] + lnIdx) + klIdx,
-				       *(valBuf[bufIdx0] + lnIdx + 1) + klIdx,
-				       *(valBuf[bufIdx1] + lnIdx) + klIdx,
-				       *(valBuf[bufIdx1] + lnIdx + 1) + klIdx,
-				       cbOrg);
-	      }
-	      lastKlIn = thisKlIn;
-	      ++klIdx;
-	    }
-	    ++lnIdx;
-	  }
+	  errNum = WlzGMModelConstructSimplex3D(ctr->model,
+	  				        slab[idS].sxBuf.vtx + idX);
+	  idX += 3;
 	}
-	++pnIdx;
       }
+      pnBat += nSlab * WLZ_CTR_SLAB_PLANES;
     }
-    obj2D->domain = dummyDom;
-    obj2D->values = dummyValues;
-    (void )WlzFreeObj(obj2D);
   }
   /* Scale model using object voxel size. */
   if(errNum == WLZ_ERR_NONE)
@@ -1233,17 +1267,31 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
     (void )WlzFreeContour(ctr);
     ctr = NULL;
   }
-  /* Free buffers. */
-  for(pnIdx = 0; pnIdx < 2; ++pnIdx)
+  /* Free the slab workspace. */
+  if(slab)
   {
-    if(itvBuf[pnIdx])
-    {
-      Alc2Free((void **)itvBuf[pnIdx]);
-    }
-    if(valBuf[pnIdx])
+    for(idS = 0; idS < nSlab; ++idS)
     {
-      Alc2Free((void **)valBuf[pnIdx]);
+      for(idB = 0; idB < 2; ++idB)
+      {
+	if(slab[idS].itvBuf[idB])
+	{
+	  Alc2Free((void **)slab[idS].itvBuf[idB]);
+	}
+	if(slab[idS].valBuf[idB])
+	{
+	  Alc2Free((void **)slab[idS].valBuf[idB]);
+	}
+      }
+      if(slab[idS].obj2D)
+      {
+	slab[idS].obj2D->domain = dummyDom;
+	slab[idS].obj2D->values = dummyValues;
+	(void )WlzFreeObj(slab[idS].obj2D);
+      }
+      AlcFree(slab[idS].sxBuf.vtx);
     }
+    AlcFree(slab);
   }
   /* Set error code. */
   if(dstErr)
@@ -1253,6 +1301,168 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   return(ctr);
 }
 
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Sweeps through a slab of the planes of a 3D object
+* 		computing the intersection of the iso-value surface
+* 		with each cube of values. The simplices are appended to
+* 		the slab's simplex buffer. The planes with indices
+* 		pnFirst to pnLast (relative to the object's first plane)
+* 		are read, so the cubes between these planes are used.
+* 		Only the given slab workspace is modified so slabs may
+* 		be swept concurrently.
+* \param	srcObj			Given 3D domain object with values.
+* \param	slab			Slab workspace.
+* \param	isoVal			The iso-value.
+* \param	bBox3D			Bounding box of the given object.
+* \param	bufSz			Size of the plane buffers.
+* \param	pnFirst			First plane index.
+* \param	pnLast			Last plane index.
+*/
+static WlzErrorNum WlzContourIsoSlabPlanes3D(WlzObject *srcObj,
+				WlzContourIsoSlab3D *slab,
+				double isoVal, WlzIBox3 bBox3D,
+				WlzIVertex2 bufSz, int pnFirst, int pnLast)
+{
+  int		klIdx,
+  		lnIdx,
+		pnIdx,
+		klCnt,
+  		lnCnt,
+  		bufIdx0,
+  		bufIdx1,
+		lastKlIn,
+		thisKlIn;
+  WlzIVertex2	bufOff;
+  WlzIBox2	bBox2D;
+  WlzDVertex3	cbOrg;
+  WlzUByte	*tUP0,
+  		*tUP1,
+		*tUP2,
+		*tUP3;
+  WlzObject	*obj2D;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj2D = slab->obj2D;
+  bufOff.vtX = bBox3D.xMin;
+  bufOff.vtY = bBox3D.yMin;
+  pnIdx = pnFirst;
+  while((errNum == WLZ_ERR_NONE) && (pnIdx <= pnLast))
+  {
+    cbOrg.vtZ = bBox3D.zMin + pnIdx;
+    bufIdx0 = (pnIdx + 1) % 2;
+    bufIdx1 = pnIdx % 2;
+    obj2D->domain = *(srcObj->domain.p->domains + pnIdx);
+    obj2D->values = *(srcObj->values.vox->values + pnIdx);
+    bBox2D = WlzBoundingBox2I(obj2D, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzToArray2D((void ***)&(slab->itvBuf[bufIdx1]), obj2D,
+			    bufSz, bufOff, 0, WLZ_GREY_BIT);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzToArray2D((void ***)&(slab->valBuf[bufIdx1]), obj2D,
+			    bufSz, bufOff, 0, WLZ_GREY_DOUBLE);
+    }
+    /* Compute the intersection of the iso-value plane with each cube
+     * of values. */
+    if((errNum == WLZ_ERR_NONE) && (pnIdx > pnFirst))
+    {
+      klCnt = bBox2D.xMax - bBox2D.xMin; 			  /* NOT + 1 */
+      lnIdx = bBox2D.yMin - bBox3D.yMin;
+      lnCnt = bBox2D.yMax - bBox2D.yMin; 			  /* NOT + 1 */
+      while((errNum == WLZ_ERR_NONE) && (lnIdx < lnCnt))
+      {
+	cbOrg.vtY = bBox3D.yMin + lnIdx;
+	tUP0 = *(slab->itvBuf[bufIdx0] + lnIdx);
+	tUP1 = *(slab->itvBuf[bufIdx0] + lnIdx + 1);
+	tUP2 = *(slab->itvBuf[bufIdx1] + lnIdx);
+	tUP3 = *(slab->itvBuf[bufIdx1] + lnIdx + 1);
+	klIdx = bBox2D.xMin - bBox3D.xMin;
+	lastKlIn = (WLZ_BIT_GET(tUP0, klIdx) != 0) &&
+		   (WLZ_BIT_GET(tUP1, klIdx) != 0) &&
+		   (WLZ_BIT_GET(tUP2, klIdx) != 0) &&
+		   (WLZ_BIT_GET(tUP3, klIdx) != 0);
+	while((errNum == WLZ_ERR_NONE) && (klIdx < klCnt))
+	{
+	  /* Check if cube is within the 3D object's domain. */
+	  thisKlIn = (WLZ_BIT_GET(tUP0, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP1, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP2, klIdx + 1) != 0) &&
+		     (WLZ_BIT_GET(tUP3, klIdx + 1) != 0);
+	  if(lastKlIn && thisKlIn)
+	  {
+	    cbOrg.vtX = bBox3D.xMin + klIdx;
+	    errNum = WlzContourIsoCube3D6T(NULL, &(slab->sxBuf), isoVal,
+				   *(slab->valBuf[bufIdx0] + lnIdx) + klIdx,
+				   *(slab->valBuf[bufIdx0] + lnIdx + 1) + klIdx,
+				   *(slab->valBuf[bufIdx1] + lnIdx) + klIdx,
+				   *(slab->valBuf[bufIdx1] + lnIdx + 1) + klIdx,
+				   cbOrg);
+	  }
+	  lastKlIn = thisKlIn;
+	  ++klIdx;
+	}
+	++lnIdx;
+      }
+    }
+    ++pnIdx;
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Adds a 3D simplex (triangle) either to the given
+* 		simplex buffer or, if the buffer is NULL, to the
+* 		contour's model.
+* \param	ctr			Contour being built, only used if
+* 					the simplex buffer is NULL.
+* \param	sxBuf			Simplex buffer, may be NULL.
+* \param	vtx			The three vertices of the simplex.
+*/
+static WlzErrorNum WlzContourSxAdd3D(WlzContour *ctr, WlzContourSxBuf *sxBuf,
+				     WlzDVertex3 *vtx)
+{
+  int		maxSx;
+  WlzDVertex3	*newVtx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(sxBuf == NULL)
+  {
+    errNum = WlzGMModelConstructSimplex3D(ctr->model, vtx);
+  }
+  else
+  {
+    if(sxBuf->nSx >= sxBuf->maxSx)
+    {
+      maxSx = (sxBuf->maxSx > 0)? 2 * sxBuf->maxSx: 1024;
+      if((newVtx = (WlzDVertex3 *)AlcRealloc(sxBuf->vtx,
+                              sizeof(WlzDVertex3) * 3 * maxSx)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        sxBuf->vtx = newVtx;
+	sxBuf->maxSx = maxSx;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      newVtx = sxBuf->vtx + (3 * sxBuf->nSx);
+      newVtx[0] = vtx[0];
+      newVtx[1] = vtx[1];
+      newVtx[2] = vtx[2];
+      ++(sxBuf->nSx);
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return				Contour , or NULL on error.
 * \ingroup	WlzContour
@@ -3361,7 +3571,7 @@ static WlzErrorNum WlzContourBndPlane3D(WlzContour *ctr, double isoVal,
 	dPn1Ln0[1] = iPn1Ln0[1];
 	dPn1Ln1[0] = iPn1Ln1[0];
 	dPn1Ln1[1] = iPn1Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(ctr, NULL, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3475,7 +3685,7 @@ static WlzErrorNum WlzContourBndEmptyPlane3D(WlzContour *ctr, double isoVal,
 	dPn0Ln0[1] = iPn0Ln0[1];
 	dPn0Ln1[0] = iPn0Ln1[0];
 	dPn0Ln1[1] = iPn0Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(ctr, NULL, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3944,7 +4154,7 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
       tI3 = tVxLUT[tIdx][3];
       tVal[1] = cVal[tI1]; tVal[2] = cVal[tI2]; tVal[3] = cVal[tI3];
       tPos[1] = cPos[tI1]; tPos[2] = cPos[tI2]; tPos[3] = cPos[tI3];
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(ctr, NULL, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -4263,6 +4473,9 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
 
 \endverbatim
 * \param	ctr			Contour being built.
+* \param	sxBuf			If non-NULL the simplices are
+* 					appended to this buffer rather
+* 					than added to the contour's model.
 * \param	isoVal			Iso-value to use.
 * \param	vPn0Ln0			Ptr to 2 data values at
 *                                       z = zPos, y = yPos and
@@ -4279,6 +4492,7 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
 * \param	cbOrg			The cube's origin.
 */
 static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
+				WlzContourSxBuf *sxBuf,
 				double isoVal,
 				double *vPn0Ln0, double *vPn0Ln1,
 				double *vPn1Ln0, double *vPn1Ln1,
@@ -4345,7 +4559,7 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 	tVal[vIdx] = cVal[tI0];
 	tPos[vIdx] = cPos[tI0];
       }
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(ctr, sxBuf, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -4361,6 +4575,9 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 *		The triangle vertices are always ordered such that
 *		when viewed from the +ve side they are in CCW order.
 * \param	ctr			Contour being built.
+* \param	sxBuf			If non-NULL the simplices are
+* 					appended to this buffer rather
+* 					than added to the contour's model.
 * \param	tVal			Values wrt the iso-value at the
 *                                       verticies of the tetrahedron.
 * \param	tPos			Positions of the tetrahedron
@@ -4368,6 +4585,7 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 * \param	cbOrg			The cube's origin.
 */
 static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
+				      WlzContourSxBuf *sxBuf,
 				      double *tVal,
 				      WlzDVertex3 *tPos,
 				      WlzDVertex3 cbOrg)
@@ -4936,15 +5154,14 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
 	sIsn[2] = tIsn[3];
 	tIsn[2] = tIsn[3];
       }
-      if((errNum = WlzGMModelConstructSimplex3D(ctr->model,
-      						tIsn)) == WLZ_ERR_NONE)
+      if((errNum = WlzContourSxAdd3D(ctr, sxBuf, tIsn)) == WLZ_ERR_NONE)
       {
-        errNum = WlzGMModelConstructSimplex3D(ctr->model, sIsn);
+        errNum = WlzContourSxAdd3D(ctr, sxBuf, sIsn);
       }
     }
     else
     {
-      errNum = WlzGMModelConstructSimplex3D(ctr->model, tIsn);
+      errNum = WlzContourSxAdd3D(ctr, sxBuf, tIsn);
     }
 #ifdef WLZ_CONTOUR_DEBUG
     (void )fprintf(stderr,
@@ -53,6 +53,20 @@ static char _WlzConvexHull3D_c[] = "University of Edinburgh $Id$";
 */
 #define WLZ_CONVHULL_EPS	(1.0e-06)
 
+/*!
+* \def	WLZ_CONVHULL_PAR_MIN
+* \brief	Minimum number of vertex-face tests for which these are
+* 		done in parallel.
+*/
+#define WLZ_CONVHULL_PAR_MIN	(4096)
+
+/*!
+* \def	WLZ_CONVHULL_PRE_MIN
+* \brief	Minimum number of vertices for which interior vertices are
+* 		filtered out before the convex hull is built.
+*/
+#define WLZ_CONVHULL_PRE_MIN	(1024)
+
 /*!
 * \struct	_WlzConvHullArc
 * \brief	A conflict arc connecting a face and a vertex these form
@@ -81,6 +95,10 @@ typedef struct _WlzConvHullVtx
 {
   int			idx;		/*!< Index of the vertex. */
   int			cvx;		/*!< Vertex is on the convex hull. */
+  int			mrk;		/*!< Mark used to avoid visiting
+  					     a vertex more than once when
+					     gathering conflict
+					     candidates. */
   struct _WlzConvHullArc *arc;		/*!< Conflict list. */
   struct _WlzConvHullVtx *nxt;		/*!< Next vertex in list. */
   struct _WlzConvHullVtx *prv;		/*!< Previous vertex in list. */
@@ -165,6 +183,11 @@ typedef struct _WlzConvHullWSp3
   int			maxHorizon;	/*!< Maximum horizon edge space. */
   int			nFceBuf;	/*!< Number of faces in face buffer. */
   int			maxFceBuf;	/*!< Maximum face buffer space. */
+  int			nCndBuf;	/*!< Number of candidate vertices
+  					     in the candidate buffer. */
+  int			maxCndBuf;	/*!< Maximum candidate buffer
+  					     space. */
+  int			vtxMrk;		/*!< Current vertex mark value. */
   WlzVertexType		vtxType;	/*!< Vertex type, either WLZ_VERTEX_I3
   					     or WLZ_VERTEX_D3. */
   WlzVertexP		vtxPos;		/*!< Pointer to vertex positions. */
@@ -178,6 +201,16 @@ typedef struct _WlzConvHullWSp3
   WlzConvHullFce	**fceBuf;	/*!< Buffer for faces to be added
   					     or deleted. */
   WlzConvHullHorEdg	*horizon;	/*!< Buffer for horizon edges. */
+  int			*cndOff;	/*!< Offsets into the candidate
+  					     buffer, with the candidates for
+					     the new face on horizon edge i
+					     being from cndOff[i] to
+					     cndOff[i + 1] - 1. */
+  WlzConvHullVtx	**cndBuf;	/*!< Buffer of pending vertices which
+  					     may conflict with new faces. */
+  char			*cndFlg;	/*!< Buffer of flags which are
+  					     non-zero for candidates which
+					     are in conflict. */
   WlzConvHullArcPool 	arcPool;	/*!< Pool for arc allocation. */
   WlzConvHullFcePool 	fcePool;	/*!< Pool for face allocation. */
   WlzConvHullVtxPool 	vtxPool;	/*!< Pool for vertex allocation. */
@@ -368,10 +401,45 @@ static WlzErrorNum		WlzConvHullHorizonExpand(
   if(wSp->maxHorizon < nMaxElm)
   {
     wSp->maxHorizon += bufInc;
-    if((wSp->horizon = (WlzConvHullHorEdg *)
-		      AlcRealloc(wSp->horizon,
-			  sizeof(WlzConvHullHorEdg) *
-			  wSp->maxHorizon)) == NULL)
+    if(((wSp->horizon = (WlzConvHullHorEdg *)
+		        AlcRealloc(wSp->horizon,
+			    sizeof(WlzConvHullHorEdg) *
+			    wSp->maxHorizon)) == NULL) ||
+       ((wSp->cndOff = (int *)
+		       AlcRealloc(wSp->cndOff,
+			   sizeof(int) * (wSp->maxHorizon + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzConvexHull
+* \brief	Expand the candidate vertex and flag buffers to at least
+* 		the given minimum number of elements.
+* \param	pool			Convex hull workspace.
+* \param	minElm			Given minimum number of elements.
+*/
+static WlzErrorNum		WlzConvHullCndBufExpand(
+				  WlzConvHullWSp3 *wSp,
+				  int nMaxElm)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	bufInc = 4096;
+
+  if(wSp->maxCndBuf < nMaxElm)
+  {
+    wSp->maxCndBuf = nMaxElm + bufInc;
+    if(((wSp->cndBuf = (WlzConvHullVtx **)
+		       AlcRealloc(wSp->cndBuf,
+			   sizeof(WlzConvHullVtx *) *
+			   wSp->maxCndBuf)) == NULL) ||
+       ((wSp->cndFlg = (char *)
+		       AlcRealloc(wSp->cndFlg,
+			   sizeof(char) * wSp->maxCndBuf)) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
@@ -543,6 +611,9 @@ static void			WlzConvHullFreeWSp3(
     AlcFree(wSp->vtxPrm);
     AlcFree(wSp->fceBuf);
     AlcFree(wSp->horizon);
+    AlcFree(wSp->cndOff);
+    AlcFree(wSp->cndBuf);
+    AlcFree(wSp->cndFlg);
     AlcBlockStackFree(wSp->arcPool.blkStk);
     AlcBlockStackFree(wSp->fcePool.blkStk);
     AlcBlockStackFree(wSp->vtxPool.blkStk);
@@ -1256,6 +1327,125 @@ static WlzErrorNum		WlzConvHullBuildHorizon(
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzConvexHull
+* \brief	Builds the buffer of candidate vertices which may be in
+* 		conflict with the new faces that are to be created on the
+* 		horizon edges. A vertex can only conflict with a new face
+* 		if it conflicts with either of the two faces which share
+* 		the face's horizon edge, ie the face to be deleted or the
+* 		face which remains. This function must be called after
+* 		WlzConvHullBuildHorizon() but before the conflicting faces
+* 		are deleted.
+* \param	wSp			Convex hull workspace.
+* \param	vtx			Vertex being added to the convex hull.
+*/
+static WlzErrorNum		WlzConvHullBuildCnd(
+				  WlzConvHullWSp3 *wSp,
+				  WlzConvHullVtx *vtx)
+{
+  int		h;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  wSp->nCndBuf = 0;
+  for(h = 0; (errNum == WLZ_ERR_NONE) && (h < wSp->nHorizon); ++h)
+  {
+    int		i;
+    WlzConvHullFce *fce[2];
+    WlzConvHullHorEdg *edg;
+
+    edg = wSp->horizon + h;
+    fce[0] = edg->fce->opp[edg->edg];
+    fce[1] = edg->fce;
+    wSp->cndOff[h] = wSp->nCndBuf;
+    ++(wSp->vtxMrk);
+    for(i = 0; (errNum == WLZ_ERR_NONE) && (i < 2); ++i)
+    {
+      WlzConvHullArc *arc;
+
+      if((arc = fce[i]->arc) != NULL)
+      {
+	do
+	{
+	  WlzConvHullVtx *cVtx;
+
+	  cVtx = arc->vtx;
+	  if((cVtx != vtx) && (cVtx->mrk != wSp->vtxMrk))
+	  {
+	    if(wSp->nCndBuf >= wSp->maxCndBuf)
+	    {
+	      errNum = WlzConvHullCndBufExpand(wSp, wSp->nCndBuf + 1);
+	      if(errNum != WLZ_ERR_NONE)
+	      {
+		break;
+	      }
+	    }
+	    cVtx->mrk = wSp->vtxMrk;
+	    wSp->cndBuf[wSp->nCndBuf] = cVtx;
+	    ++(wSp->nCndBuf);
+	  }
+	  arc = arc->nxtFce;
+	} while(arc != fce[i]->arc);
+      }
+    }
+  }
+  wSp->cndOff[wSp->nHorizon] = wSp->nCndBuf;
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzConvexHull
+* \brief	Adds conflicts between the new faces (in the face buffer)
+* 		and the candidate vertices of their horizon edges. The
+* 		vertex-face tests are independent and are done in
+* 		parallel when there are enough of them, the conflicts
+* 		are then added in order so that the conflict graph does
+* 		not depend on the number of threads.
+* \param	wSp			Convex hull workspace.
+*/
+static WlzErrorNum		WlzConvHullCndConf(
+				  WlzConvHullWSp3 *wSp)
+{
+  int		h;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) \
+		     if(wSp->nCndBuf >= WLZ_CONVHULL_PAR_MIN)
+#endif
+  for(h = 0; h < wSp->nHorizon; ++h)
+  {
+    int		c;
+    WlzConvHullFce *fce;
+
+    fce = wSp->fceBuf[h];
+    for(c = wSp->cndOff[h]; c < wSp->cndOff[h + 1]; ++c)
+    {
+      wSp->cndFlg[c] = (char )WlzConvHullFceBehind(wSp, fce,
+                                                   wSp->cndBuf[c]->idx);
+    }
+  }
+  for(h = 0; (errNum == WLZ_ERR_NONE) && (h < wSp->nHorizon); ++h)
+  {
+    int		c;
+
+    for(c = wSp->cndOff[h]; c < wSp->cndOff[h + 1]; ++c)
+    {
+      if(wSp->cndFlg[c])
+      {
+	if((errNum = WlzConvHullConfAdd(wSp, wSp->fceBuf[h],
+	                                wSp->cndBuf[c])) != WLZ_ERR_NONE)
+	{
+	  break;
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	New 3D convex hull domain.
 * \ingroup	WlzConvexHull
@@ -2186,6 +2376,241 @@ static WlzConvHullDomain3	*WlzConvexHullDegenerate3(
   return(cvh);
 }
 
+/*!
+* \return	Number of vertices remaining in the workspace permutation
+* 		table.
+* \ingroup	WlzConvexHull
+* \brief	Removes vertices which can not be on the convex hull from
+* 		the workspace permutation table using a cheap extreme point
+* 		filter (cf Akl and Toussaint's heuristic). The vertices
+* 		which are extreme along each of the 26 directions to the
+* 		neighbours of a voxel are found and their convex hull is
+* 		computed, any vertex strictly inside this polytope can not
+* 		be on the convex hull of all the vertices and is removed.
+* 		Both the search for extreme vertices and the inside tests
+* 		are done in parallel. If the extreme vertices are
+* 		degenerate then no vertices are removed.
+* \param	wSp			Convex hull workspace.
+* \param	nPnt			Number of vertices in the workspace
+* 					permutation table.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int			WlzConvHullPrefilter3(
+				  WlzConvHullWSp3 *wSp,
+				  int nPnt,
+				  WlzErrorNum *dstErr)
+{
+  int		d,
+  		nExt = 0,
+		nRmn;
+  double	tol = 0.0;
+  char		*inside = NULL;
+  double	*pDst = NULL;
+  WlzDVertex3	*pNrm = NULL;
+  WlzConvHullDomain3 *eCvh = NULL;
+  int		extIdx[26];
+  WlzDVertex3	extPos[26];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nRmn = nPnt;
+  /* Find the extreme vertices along each direction. */
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(d = 0; d < 26; ++d)
+  {
+    int		i,
+    		k,
+		iMax = 0;
+    double	pMax = -DBL_MAX;
+    WlzDVertex3	dir;
+
+    k = (d < 13)? d: d + 1;
+    WLZ_VTX_3_SET(dir, (k % 3) - 1, ((k / 3) % 3) - 1, (k / 9) - 1);
+    for(i = 0; i < nPnt; ++i)
+    {
+      double	p;
+      WlzDVertex3 pos;
+
+      if(wSp->vtxType == WLZ_VERTEX_I3)
+      {
+	WlzIVertex3 v;
+
+	v = wSp->vtxPos.i3[wSp->vtxPrm[i]];
+	WLZ_VTX_3_SET(pos, v.vtX, v.vtY, v.vtZ);
+      }
+      else
+      {
+	pos = wSp->vtxPos.d3[wSp->vtxPrm[i]];
+      }
+      p = WLZ_VTX_3_DOT(dir, pos);
+      if(p > pMax)
+      {
+	pMax = p;
+	iMax = i;
+      }
+    }
+    extIdx[d] = iMax;
+  }
+  /* Collect the distinct extreme vertices and compute their convex hull. */
+  for(d = 0; d < 26; ++d)
+  {
+    int		e;
+
+    for(e = 0; e < d; ++e)
+    {
+      if(extIdx[e] == extIdx[d])
+      {
+	break;
+      }
+    }
+    if(e == d)
+    {
+      int	i;
+
+      i = wSp->vtxPrm[extIdx[d]];
+      if(wSp->vtxType == WLZ_VERTEX_I3)
+      {
+	WlzIVertex3 v;
+
+	v = wSp->vtxPos.i3[i];
+	WLZ_VTX_3_SET(extPos[nExt], v.vtX, v.vtY, v.vtZ);
+      }
+      else
+      {
+	extPos[nExt] = wSp->vtxPos.d3[i];
+      }
+      ++nExt;
+    }
+  }
+  if(nExt >= 4)
+  {
+    WlzVertexP	ext;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    ext.d3 = extPos;
+    eCvh = WlzConvexHullFromVtx3(WLZ_VERTEX_D3, nExt, ext, &errNum2);
+    if(errNum2 != WLZ_ERR_NONE)
+    {
+      (void )WlzFreeConvexHullDomain3(eCvh);
+      eCvh = NULL;
+    }
+  }
+  /* Compute the outward directed unit normal and distance from the
+   * origin of the plane of each face of the extreme vertex convex
+   * hull. */
+  if(eCvh)
+  {
+    if(((pNrm = (WlzDVertex3 *)
+                AlcMalloc(sizeof(WlzDVertex3) * eCvh->nFaces)) == NULL) ||
+       ((pDst = (double *)AlcMalloc(sizeof(double) * eCvh->nFaces)) == NULL) ||
+       ((inside = (char *)AlcMalloc(sizeof(char) * nPnt)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	f,
+      		i;
+      WlzDVertex3 cen;
+
+      cen = eCvh->centroid.d3;
+      for(i = 0; i < eCvh->nVertices; ++i)
+      {
+        WlzDVertex3 t;
+
+	WLZ_VTX_3_SUB(t, eCvh->vertices.d3[i], cen);
+	tol = ALG_MAX(tol, WLZ_VTX_3_LENGTH(t));
+      }
+      tol = WLZ_CONVHULL_EPS * (1.0 + tol);
+      for(f = 0; f < eCvh->nFaces; ++f)
+      {
+	double	l;
+	int	*fv;
+	WlzDVertex3 n,
+		    u0,
+		    u1;
+
+	fv = eCvh->faces + (3 * f);
+	WLZ_VTX_3_SUB(u0, eCvh->vertices.d3[fv[1]], eCvh->vertices.d3[fv[0]]);
+	WLZ_VTX_3_SUB(u1, eCvh->vertices.d3[fv[2]], eCvh->vertices.d3[fv[0]]);
+	WLZ_VTX_3_CROSS(n, u0, u1);
+	l = WLZ_VTX_3_LENGTH(n);
+	if(l < WLZ_CONVHULL_EPS)
+	{
+	  /* Give a degenerate face a plane that nothing is inside. */
+	  WLZ_VTX_3_ZERO(pNrm[f]);
+	  pDst[f] = -1.0;
+	}
+	else
+	{
+	  WLZ_VTX_3_SCALE(n, n, 1.0 / l);
+	  pDst[f] = WLZ_VTX_3_DOT(n, eCvh->vertices.d3[fv[0]]);
+	  if(WLZ_VTX_3_DOT(n, cen) > pDst[f])
+	  {
+	    WLZ_VTX_3_NEGATE(n, n);
+	    pDst[f] = -pDst[f];
+	  }
+	  pNrm[f] = n;
+	}
+      }
+    }
+  }
+  /* Mark vertices strictly inside all the face planes then squeeze them
+   * out of the permutation table. */
+  if(inside)
+  {
+    int		i,
+    		j;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(i = 0; i < nPnt; ++i)
+    {
+      int	f;
+      WlzDVertex3 pos;
+
+      if(wSp->vtxType == WLZ_VERTEX_I3)
+      {
+	WlzIVertex3 v;
+
+	v = wSp->vtxPos.i3[wSp->vtxPrm[i]];
+	WLZ_VTX_3_SET(pos, v.vtX, v.vtY, v.vtZ);
+      }
+      else
+      {
+	pos = wSp->vtxPos.d3[wSp->vtxPrm[i]];
+      }
+      for(f = 0; f < eCvh->nFaces; ++f)
+      {
+	if(WLZ_VTX_3_DOT(pNrm[f], pos) - pDst[f] > -tol)
+	{
+	  break;
+	}
+      }
+      inside[i] = (f == eCvh->nFaces);
+    }
+    for(i = 0, j = 0; i < nPnt; ++i)
+    {
+      if(inside[i] == 0)
+      {
+	wSp->vtxPrm[j++] = wSp->vtxPrm[i];
+      }
+    }
+    nRmn = j;
+  }
+  AlcFree(inside);
+  AlcFree(pDst);
+  AlcFree(pNrm);
+  (void )WlzFreeConvexHullDomain3(eCvh);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nRmn);
+}
+
 /*!
 * \return	New 3D convex hull domain.
 * \ingroup	WlzConvexHull
@@ -2207,10 +2632,15 @@ static WlzConvHullDomain3	*WlzConvexHullDegenerate3(
 * 		where behind means in the half-plane defined by the
 * 		face and the body of the convex hull. In practice the
 * 		vertex-behind-face test accounts for the almost all
-* 		the CPU time. The expected run time for this algorithm
-* 		is O(n log n). On a 3GHz Intel i7 the computation time
-* 		is a ~10ms for 10^4 vertices randomly distributed over
-* 		a cube but ~1s for 10^5 vertices.
+* 		the CPU time. When a vertex is added only those vertices
+* 		which conflict with the faces on either side of the horizon
+* 		are tested against the new faces, giving an expected run
+* 		time of O(n log n). Before the convex hull is built
+* 		vertices which lie within the convex hull of a small
+* 		number of extreme vertices are filtered out, this is very
+* 		effective for vertices sampled from within a volume.
+* 		The extreme vertex filter and the vertex-face tests for
+* 		large conflict updates are done in parallel.
 * 		When given a degenerate set of vertices (all on a single plane,
 * 		all on a single line or all coincident) this function will
 * 		still compute a 3D convex hull domain but will set the error
@@ -2256,15 +2686,25 @@ WlzConvHullDomain3		*WlzConvexHullFromVtx3(
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    int 	i,
-    		j;
+    int 	i;
 
-    /* Sort the given vertices using the permutation buffer to remove
-     * duplicates. */
     for(i = 0; i < nPnt; ++i)
     {
       wSp->vtxPrm[i] = i;
     }
+    /* Remove vertices which can not be on the convex hull. */
+    if(nPnt >= WLZ_CONVHULL_PRE_MIN)
+    {
+      nPnt = WlzConvHullPrefilter3(wSp, nPnt, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int 	i,
+    		j;
+
+    /* Sort the given vertices using the permutation buffer to remove
+     * duplicates. */
     if(pType == WLZ_VERTEX_I3)
     {
       (void )AlgHeapSortIdx(pnt.i3, wSp->vtxPrm, nPnt,
@@ -2376,6 +2816,12 @@ WlzConvHullDomain3		*WlzConvexHullFromVtx3(
 	     * are to remain and while doing so build a list of faces to be
 	     * deleted. */
 	    errNum = WlzConvHullBuildHorizon(wSp, vtx);
+	    /* Gather the vertices which may conflict with the new faces
+	     * while the conflicting faces still exist. */
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = WlzConvHullBuildCnd(wSp, vtx);
+	    }
 	    if(errNum == WLZ_ERR_NONE)
 	    {
 	      /* Delete all faces which conflict with the vertex. */
@@ -2427,38 +2873,11 @@ WlzConvHullDomain3		*WlzConvexHullFromVtx3(
 		}
 	      }
 	    }
-	    /* For each of the pending vertices, check for conflicts with
-	     * each of the new faces, delete those inside the new faces and
-	     * add new conflicts. */
+	    /* Check the candidate vertices for conflicts with the new
+	     * faces, adding any new conflicts. */
 	    if(errNum == WLZ_ERR_NONE)
 	    {
-	      WlzConvHullVtx *pVtx;
-
-	      if((pVtx = wSp->vtxQue) != NULL)
-	      {
-		do
-		{
-		  WlzConvHullVtx *nxtPVtx;
-
-		  nxtPVtx = pVtx->nxt;
-		  for(f = 0; f < wSp->nFceBuf; ++f)
-		  {
-		    WlzConvHullFce *fce;
-
-		    fce = wSp->fceBuf[f];
-		    if(WlzConvHullFceBehind(wSp, fce, pVtx->idx) != 0)
-		    {
-		      errNum = WlzConvHullConfAdd(wSp, fce, pVtx);
-		    }
-		  }
-		  if((pVtx->arc == NULL) && (pVtx->cvx == 0) &&
-		     (pVtx != wSp->vtxQue))
-		  {
-		    WlzConvHullDelVtx(wSp, &(wSp->vtxQue), pVtx);
-		  }
-		  pVtx = nxtPVtx;
-		} while((errNum == WLZ_ERR_NONE) && (pVtx != wSp->vtxQue));
-	      }
+	      errNum = WlzConvHullCndConf(wSp);
 	    }
 #ifdef WLZ_CONVHULL_DEBUG_FCE
 	    if(errNum == WLZ_ERR_NONE)
@@ -2476,6 +2895,11 @@ WlzConvHullDomain3		*WlzConvexHullFromVtx3(
 	      }
 	    }
 	  }
+	  else
+	  {
+	    /* The vertex is inside the convex hull, recycle it. */
+	    WlzConvHullDelVtx(wSp, NULL, vtx);
+	  }
 	}
       }
       if(errNum == WLZ_ERR_NONE)
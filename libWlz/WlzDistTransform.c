@@ -43,9 +43,42 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <float.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_DIST_EDT_INF
+* \ingroup	WlzMorphologyOps
+* \brief	Squared distance used for positions which have no
+* 		reference position within the exact Euclidean distance
+* 		transform.
+*/
+#define WLZ_DIST_EDT_INF	(INT_MAX)
 
+static int			WlzDistEDTItvLn(
+				  WlzIntervalDomain *iDom,
+				  int ln,
+				  WlzInterval *rItv,
+				  WlzInterval **dstItv);
+static void			WlzDistEDT1D(
+				  int *f,
+				  int n,
+				  int t,
+				  int m,
+				  int *d,
+				  int *v,
+				  double *z);
+static WlzIntervalDomain	*WlzDistEDTPlaneDom(
+				  WlzObject *obj,
+				  int pl);
+static WlzErrorNum		WlzDistEuclidean(
+				  WlzObject *dstObj,
+				  WlzObject *refObj,
+				  double dMax);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
@@ -214,6 +247,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -229,6 +263,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -272,7 +307,6 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
@@ -376,6 +410,12 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
     bothObj[0] = sForObj;
     errNum = WlzGreySetValue(dstObj, dstV);
   }
+  /* The exact Euclidean distance transform is not iterative. */
+  if((errNum == WLZ_ERR_NONE) && (dFn == WLZ_EUCLIDEAN_DISTANCE))
+  {
+    errNum = WlzDistEuclidean(dstObj, sRefObj, dMax);
+    notDone = 0;
+  }
   /* Dilate the reference object while setting the distances in each
    * dilated shell. */
   while((errNum == WLZ_ERR_NONE) && notDone)
@@ -575,3 +615,492 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \return	Number of intervals in the line.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the intervals of a line of an interval domain.
+* 		The interval columns are relative to the domain's first
+* 		column.
+* \param	iDom			Given interval domain, may be NULL.
+* \param	ln			Given line.
+* \param	rItv			Space for the single interval of a
+* 					rectangular domain.
+* \param	dstItv			Destination pointer for the
+* 					intervals.
+*/
+static int	WlzDistEDTItvLn(WlzIntervalDomain *iDom, int ln,
+				WlzInterval *rItv, WlzInterval **dstItv)
+{
+  int		nItv = 0;
+
+  if(iDom && (ln >= iDom->line1) && (ln <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      nItv = 1;
+      rItv->ileft = 0;
+      rItv->iright = iDom->lastkl - iDom->kol1;
+      *dstItv = rItv;
+    }
+    else
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + ln - iDom->line1;
+      nItv = iLn->nintvs;
+      *dstItv = iLn->intvs;
+    }
+  }
+  return(nItv);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared Euclidean distance
+* 		transform of a sampled function, ie for each target
+* 		position p, \f$d(p) = \min_q (f(q) + (p - q)^2)\f$
+* 		using the lower envelope of the parabolas rooted at the
+* 		sample positions. Samples with value WLZ_DIST_EDT_INF are
+* 		ignored.
+* \param	f			Given samples at positions
+* 					\f$0, \ldots, n - 1\f$.
+* \param	n			Number of samples.
+* \param	t			First target position.
+* \param	m			Number of target positions.
+* \param	d			Destination for the m distances.
+* \param	v			Workspace for n ints.
+* \param	z			Workspace for n + 1 doubles.
+*/
+static void	WlzDistEDT1D(int *f, int n, int t, int m, int *d,
+			     int *v, double *z)
+{
+  int		i,
+		k = -1,
+		q;
+  double	s,
+		dd;
+
+  /* Compute the lower envelope. */
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] != WLZ_DIST_EDT_INF)
+    {
+      if(k < 0)
+      {
+	k = 0;
+	z[0] = -DBL_MAX;
+      }
+      else
+      {
+	for(;;)
+	{
+	  int	vk;
+
+	  vk = v[k];
+	  s = ((f[q] + ((double )q * q)) - (f[vk] + ((double )vk * vk))) /
+	      (2.0 * (q - vk));
+	  if(s > z[k])
+	  {
+	    break;
+	  }
+	  --k;
+	}
+	z[++k] = s;
+      }
+      v[k] = q;
+      z[k + 1] = DBL_MAX;
+    }
+  }
+  /* Fill in the distances from the lower envelope. */
+  if(k < 0)
+  {
+    for(i = 0; i < m; ++i)
+    {
+      d[i] = WLZ_DIST_EDT_INF;
+    }
+  }
+  else
+  {
+    k = 0;
+    for(i = 0; i < m; ++i)
+    {
+      q = t + i;
+      while(z[k + 1] < q)
+      {
+	++k;
+      }
+      dd = (double )(q - v[k]);
+      dd = (dd * dd) + f[v[k]];
+      d[i] = (dd < WLZ_DIST_EDT_INF)? (int )dd: WLZ_DIST_EDT_INF;
+    }
+  }
+}
+
+/*!
+* \return	Interval domain of the plane or NULL if the plane has no
+* 		intervals.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the interval domain of a plane of a 2 or 3D domain
+* 		object. For 2D objects the plane is ignored.
+* \param	obj			Given 2 or 3D domain object.
+* \param	pl			Given plane.
+*/
+static WlzIntervalDomain *WlzDistEDTPlaneDom(WlzObject *obj, int pl)
+{
+  WlzIntervalDomain *iDom = NULL;
+
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    iDom = obj->domain.i;
+  }
+  else if((pl >= obj->domain.p->plane1) && (pl <= obj->domain.p->lastpl))
+  {
+    iDom = obj->domain.p->domains[pl - obj->domain.p->plane1].i;
+  }
+  if((iDom != NULL) && (iDom->type == WLZ_EMPTY_DOMAIN))
+  {
+    iDom = NULL;
+  }
+  return(iDom);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the values of the given distance object to the exact
+* 		Euclidean distance from the nearest position in the
+* 		reference domain. Only plane sized buffers are used:
+* 		The planes of the union of the two domains' bounding
+* 		boxes are swept through in order while keeping the
+* 		nearest (swept) reference plane for each column. For each
+* 		plane of the distance object the squared distances to
+* 		these nearest planes are transformed through the columns
+* 		of the plane (in parallel over the columns) and then
+* 		along the lines of the distance object's domain (in
+* 		parallel over the lines) with the squared distances being
+* 		held in the distance object's values. Because the minimum
+* 		distance is the smaller of the minimum distances to the
+* 		reference positions on either side of a plane, 3D objects
+* 		are swept through twice, first with increasing and then
+* 		with decreasing planes, taking the minimum of the two
+* 		before setting the distances.
+* \param	dstObj			Distance object with integer values
+* 					which have been set to zero.
+* \param	refObj			Reference domain object which must
+* 					have the same dimension as the
+* 					distance object.
+* \param	dMax			Maximum distance, distances greater
+* 					than this are not set if it is
+* 					greater than zero.
+*/
+static WlzErrorNum WlzDistEuclidean(WlzObject *dstObj, WlzObject *refObj,
+				double dMax)
+{
+  int		idP,
+  		idT,
+		nMax = 0,
+		nPass,
+  		nThr = 1;
+  WlzIBox3	fBox,
+  		rBox,
+		uBox;
+  WlzIVertex3	fSz,
+  		uSz;
+  int		**g = NULL,
+  		**nrP = NULL,
+		**tBuf = NULL;
+  double	**tZ = NULL;
+  WlzGreyLineWSpace **tLWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	dEps = 1.0e-6;
+
+  if(refObj->type != dstObj->type)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else
+  {
+    fBox = WlzBoundingBox3I(dstObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rBox = WlzBoundingBox3I(refObj, &errNum);
+  }
+  /* Allocate plane sized buffers for the nearest reference planes and
+   * the squared distances through the columns, together with per
+   * thread buffers for the one dimensional transforms. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    uBox.xMin = ALG_MIN(fBox.xMin, rBox.xMin);
+    uBox.yMin = ALG_MIN(fBox.yMin, rBox.yMin);
+    uBox.zMin = ALG_MIN(fBox.zMin, rBox.zMin);
+    uBox.xMax = ALG_MAX(fBox.xMax, rBox.xMax);
+    uBox.yMax = ALG_MAX(fBox.yMax, rBox.yMax);
+    uBox.zMax = ALG_MAX(fBox.zMax, rBox.zMax);
+    fSz.vtX = fBox.xMax - fBox.xMin + 1;
+    fSz.vtY = fBox.yMax - fBox.yMin + 1;
+    fSz.vtZ = fBox.zMax - fBox.zMin + 1;
+    uSz.vtX = uBox.xMax - uBox.xMin + 1;
+    uSz.vtY = uBox.yMax - uBox.yMin + 1;
+    uSz.vtZ = uBox.zMax - uBox.zMin + 1;
+    nMax = ALG_MAX(uSz.vtX, uSz.vtY);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#pragma omp master
+      {
+	nThr = omp_get_num_threads();
+      }
+    }
+#endif
+    if((AlcInt2Malloc(&nrP, uSz.vtY, uSz.vtX) != ALC_ER_NONE) ||
+       (AlcInt2Malloc(&g, fSz.vtY, uSz.vtX) != ALC_ER_NONE) ||
+       ((tBuf = (int **)AlcCalloc(nThr, sizeof(int *))) == NULL) ||
+       ((tZ = (double **)AlcCalloc(nThr, sizeof(double *))) == NULL) ||
+       ((tLWSp = (WlzGreyLineWSpace **)
+                 AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+  {
+    if(((tBuf[idT] = (int *)AlcMalloc(sizeof(int) * 3 * nMax)) == NULL) ||
+       ((tZ[idT] = (double *)AlcMalloc(sizeof(double) * (nMax + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Sweep through the planes, with increasing planes and then for 3D
+   * with decreasing planes. Planes beyond the last plane of the
+   * distance object in the direction of the sweep are not needed.
+   * The line scanning workspaces are freed at the end of each pass so
+   * that any buffered (tiled) values are written back before they are
+   * read by the next pass. */
+  nPass = (uSz.vtZ > 1)? 2: 1;
+  for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nPass); ++idP)
+  {
+    int		idS,
+    		idY,
+    		nS;
+
+    for(idY = 0; idY < uSz.vtY; ++idY)
+    {
+      int	idX;
+
+      for(idX = 0; idX < uSz.vtX; ++idX)
+      {
+        nrP[idY][idX] = -1;
+      }
+    }
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+    {
+      tLWSp[idT] = WlzGreyLineScanInit(dstObj, 1, &errNum);
+    }
+    nS = (idP == 0)? fBox.zMax - uBox.zMin + 1: uBox.zMax - fBox.zMin + 1;
+    for(idS = 0; (errNum == WLZ_ERR_NONE) && (idS < nS); ++idS)
+    {
+      int	idX,
+		idZ,
+		pl;
+      WlzIntervalDomain *rIDom;
+
+      idZ = (idP == 0)? idS: uSz.vtZ - 1 - idS;
+      pl = uBox.zMin + idZ;
+      /* Update the nearest reference planes from this plane of the
+       * reference domain. */
+      if((rIDom = WlzDistEDTPlaneDom(refObj, pl)) != NULL)
+      {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	for(idY = 0; idY < uSz.vtY; ++idY)
+	{
+	  int	  idI,
+		  nItv;
+	  WlzInterval rItv;
+	  WlzInterval *itv = NULL;
+
+	  nItv = WlzDistEDTItvLn(rIDom, uBox.yMin + idY, &rItv, &itv);
+	  for(idI = 0; idI < nItv; ++idI)
+	  {
+	    int	  kl,
+		  kr;
+	    int   *nrPP;
+
+	    nrPP = nrP[idY] + rIDom->kol1 - uBox.xMin;
+	    kr = itv[idI].iright;
+	    for(kl = itv[idI].ileft; kl <= kr; ++kl)
+	    {
+	      nrPP[kl] = idZ;
+	    }
+	  }
+	}
+      }
+      if((pl >= fBox.zMin) && (pl <= fBox.zMax) &&
+         (WlzDistEDTPlaneDom(dstObj, pl) != NULL))
+      {
+	/* Squared distances through the columns from the squared
+	 * distances to the nearest reference planes. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	for(idX = 0; idX < uSz.vtX; ++idX)
+	{
+	  int	  idQ,
+		  thrId = 0;
+	  int	  *f,
+		  *v,
+		  *d;
+
+#ifdef _OPENMP
+	  thrId = omp_get_thread_num();
+#endif
+	  f = tBuf[thrId];
+	  v = f + nMax;
+	  d = v + nMax;
+	  for(idQ = 0; idQ < uSz.vtY; ++idQ)
+	  {
+	    int	  dZ;
+
+	    dZ = ALG_ABS(idZ - nrP[idQ][idX]);
+	    /* 46341 is the smallest distance with a square > INT_MAX. */
+	    f[idQ] = ((nrP[idQ][idX] < 0) || (dZ >= 46341))?
+		     WLZ_DIST_EDT_INF: dZ * dZ;
+	  }
+	  WlzDistEDT1D(f, uSz.vtY, fBox.yMin - uBox.yMin, fSz.vtY, d, v,
+		       tZ[thrId]);
+	  for(idQ = 0; idQ < fSz.vtY; ++idQ)
+	  {
+	    g[idQ][idX] = d[idQ];
+	  }
+	}
+	/* Squared distances along the lines of the distance object's
+	 * domain, taking the minimum with those of the previous pass
+	 * and setting the distances on the last pass. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	for(idY = 0; idY < fSz.vtY; ++idY)
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    int	  idI,
+		  kl = 0,
+		  thrId = 0;
+	    int	  *v,
+		  *d;
+	    WlzGreyLineWSpace *lWSp;
+	    WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	    thrId = omp_get_thread_num();
+#endif
+	    v = tBuf[thrId] + nMax;
+	    d = v + nMax;
+	    lWSp = tLWSp[thrId];
+	    errNum2 = WlzGreyLineScanLine(lWSp, pl, fBox.yMin + idY);
+	    if((errNum2 == WLZ_ERR_NONE) && (lWSp->nItv > 0))
+	    {
+	      if(lWSp->gType != WLZ_GREY_INT)
+	      {
+		errNum2 = WLZ_ERR_GREY_TYPE;
+	      }
+	      else
+	      {
+		kl = lWSp->itv[0].ileft;
+		WlzDistEDT1D(g[idY], uSz.vtX, kl - uBox.xMin,
+			     lWSp->itv[lWSp->nItv - 1].iright - kl + 1,
+			     d, v, tZ[thrId]);
+	      }
+	    }
+	    for(idI = 0; (errNum2 == WLZ_ERR_NONE) && (idI < lWSp->nItv);
+	        ++idI)
+	    {
+	      int	idK,
+	      		nK;
+	      int	*dP,
+	      		*sqdP;
+
+	      dP = d + lWSp->itv[idI].ileft - kl;
+	      sqdP = lWSp->val[idI].inp;
+	      nK = lWSp->itv[idI].iright - lWSp->itv[idI].ileft + 1;
+	      for(idK = 0; idK < nK; ++idK)
+	      {
+		int	sqd;
+
+		sqd = dP[idK];
+		if((idP > 0) && (sqdP[idK] < sqd))
+		{
+		  sqd = sqdP[idK];
+		}
+		if(idP < nPass - 1)
+		{
+		  sqdP[idK] = sqd;
+		}
+		else
+		{
+		  sqdP[idK] = 0;
+		  if(sqd != WLZ_DIST_EDT_INF)
+		  {
+		    double	dst;
+
+		    dst = sqrt((double )sqd);
+		    if((dMax < dEps) || (dst <= dMax))
+		    {
+		      sqdP[idK] = WLZ_NINT(dst);
+		    }
+		  }
+		}
+	      }
+	    }
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzDistEuclidean)
+#endif
+	      {
+		if(errNum == WLZ_ERR_NONE)
+		{
+		  errNum = errNum2;
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyLineScanFree(tLWSp[idT]);
+      tLWSp[idT] = NULL;
+    }
+  }
+  AlcFree(tLWSp);
+  if(tBuf)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      AlcFree(tBuf[idT]);
+    }
+    AlcFree(tBuf);
+  }
+  if(tZ)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      AlcFree(tZ[idT]);
+    }
+    AlcFree(tZ);
+  }
+  if(nrP)
+  {
+    (void )Alc2Free((void **)nrP);
+  }
+  if(g)
+  {
+    (void )Alc2Free((void **)g);
+  }
+  return(errNum);
+}
@@ -70,9 +70,10 @@ static WlzCompoundArray 	*WlzFourierTransformObjCpx3D(
 * 		transforms the objects frequently have their grey
 * 		values modified so that the mean value is zero; this
 * 		is not done in this function.
-*		The transformed data are scaled, see AlgFour1D(),
-*		AlgFourReal1D(), AlgFour2D() AlgFourReal2D(),
-*		AlgFour3D() and AlgFourReal3D().
+*		The transforms are computed using cached transform
+*		plans and the transformed data are not scaled, see
+*		AlgFourPlanExecReal2D(), AlgFourPlanExecReal3D(),
+*		AlgFourPlanExec2D() and AlgFourPlanExec3D().
 * \param	iObj			Input Woolz object.
 * \param	fwd			Non-zero if the transform is a
 * 					forward transform, zero if it is to
@@ -198,17 +199,16 @@ static WlzObject *WlzFourierTransformObj2D(WlzObject *iObj, int fwd,
     if(errNum == WLZ_ERR_NONE)
     {
       AlgError	algErr = ALG_ERR_NONE;
+      AlgFourPlan *pX = NULL,
+      		*pY = NULL;
 
-      if(fwd)
+      if(((pX = AlgFourPlanGet(oSz.vtX, &algErr)) != NULL) &&
+         ((pY = AlgFourPlanGet(oSz.vtY, &algErr)) != NULL))
       {
-	{
-	  algErr = AlgFourReal2D((double **)array, 1, oSz.vtX, oSz.vtY);
-	}
-      }
-      else
-      {
-	algErr = AlgFourRealInv2D((double **)array, 1, oSz.vtX, oSz.vtY);
+	algErr = AlgFourPlanExecReal2D(pX, pY, (double **)array, !fwd);
       }
+      AlgFourPlanFree(pX);
+      AlgFourPlanFree(pY);
       errNum = WlzErrorFromAlg(algErr);
     }
   }
@@ -292,19 +292,19 @@ static WlzObject *WlzFourierTransformObj3D(WlzObject *iObj, int fwd,
     if(errNum == WLZ_ERR_NONE)
     {
       AlgError	algErr = ALG_ERR_NONE;
+      AlgFourPlan *pX = NULL,
+      		*pY = NULL,
+		*pZ = NULL;
 
-      if(fwd)
-      {
-	{
-	  algErr = AlgFourReal3D((double ***)array, 1,
-	                         oSz.vtX, oSz.vtY, oSz.vtZ);
-	}
-      }
-      else
+      if(((pX = AlgFourPlanGet(oSz.vtX, &algErr)) != NULL) &&
+         ((pY = AlgFourPlanGet(oSz.vtY, &algErr)) != NULL) &&
+         ((pZ = AlgFourPlanGet(oSz.vtZ, &algErr)) != NULL))
       {
-	algErr = AlgFourRealInv3D((double ***)array, 1,
-	                          oSz.vtX, oSz.vtY, oSz.vtZ);
+	algErr = AlgFourPlanExecReal3D(pX, pY, pZ, (double ***)array, !fwd);
       }
+      AlgFourPlanFree(pX);
+      AlgFourPlanFree(pY);
+      AlgFourPlanFree(pZ);
       errNum = WlzErrorFromAlg(algErr);
     }
   }
@@ -407,17 +407,17 @@ static WlzCompoundArray *WlzFourierTransformObjCpx2D(WlzCompoundArray *iObj,
   if(errNum == WLZ_ERR_NONE)
   {
     AlgError	algErr = ALG_ERR_NONE;
+    AlgFourPlan	*pX = NULL,
+    		*pY = NULL;
 
-    if(fwd)
+    if(((pX = AlgFourPlanGet(oSz.vtX, &algErr)) != NULL) &&
+       ((pY = AlgFourPlanGet(oSz.vtY, &algErr)) != NULL))
     {
-      algErr = AlgFour2D((double **)real, (double **)imag, 1,
-			 oSz.vtX, oSz.vtY);
-    }
-    else
-    {
-      algErr = AlgFourInv2D((double **)real, (double **)imag, 1,
-                            oSz.vtX, oSz.vtY);
+      algErr = AlgFourPlanExec2D(pX, pY, (double **)real, (double **)imag,
+                                 !fwd);
     }
+    AlgFourPlanFree(pX);
+    AlgFourPlanFree(pY);
     errNum = WlzErrorFromAlg(algErr);
   }
   if(errNum == WLZ_ERR_NONE)
@@ -546,17 +546,20 @@ static WlzCompoundArray *WlzFourierTransformObjCpx3D(WlzCompoundArray *iObj,
   if(errNum == WLZ_ERR_NONE)
   {
     AlgError	algErr = ALG_ERR_NONE;
+    AlgFourPlan	*pX = NULL,
+    		*pY = NULL,
+		*pZ = NULL;
 
-    if(fwd)
-    {
-      algErr = AlgFour3D((double ***)real, (double ***)imag, 1,
-			 oSz.vtX, oSz.vtY, oSz.vtZ);
-    }
-    else
+    if(((pX = AlgFourPlanGet(oSz.vtX, &algErr)) != NULL) &&
+       ((pY = AlgFourPlanGet(oSz.vtY, &algErr)) != NULL) &&
+       ((pZ = AlgFourPlanGet(oSz.vtZ, &algErr)) != NULL))
     {
-      algErr = AlgFourInv3D((double ***)real, (double ***)imag, 1,
-                            oSz.vtX, oSz.vtY, oSz.vtZ);
+      algErr = AlgFourPlanExec3D(pX, pY, pZ, (double ***)real,
+                                 (double ***)imag, !fwd);
     }
+    AlgFourPlanFree(pX);
+    AlgFourPlanFree(pY);
+    AlgFourPlanFree(pZ);
     errNum = WlzErrorFromAlg(algErr);
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8092,21 +8092,6 @@ static WlzErrorNum WlzGMModelJoin3V0E2S3D(WlzGMModel *model,
     eShell = tShell[idx];
     dShell = (tShell[idx] == tShell[(idx + 1) % 3])?
              tShell[(idx + 2) % 3]: tShell[(idx + 1) % 3];
-    if(tShell[0] == tShell[1])
-    {
-      eShell = tShell[0];
-      dShell = tShell[2];
-    }
-    else if(tShell[1] == tShell[2])
-    {
-      eShell = tShell[1];
-      dShell = tShell[0];
-    }
-    else /* tShell[2] == tShell[0] */
-    {
-      eShell = tShell[2];
-      dShell = tShell[1];
-    }
     /* New vertex topology elements. */
     for(idx = 0; idx < 3; ++idx)
     {
@@ -8546,8 +8531,11 @@ static WlzErrorNum WlzGMModelJoin3V1E2S3D(WlzGMModel *model,
   int		idx,
   		nIdx,
 		pIdx;
+  double	dVol,
+  		eVol;
   WlzGMShell	*dShell,
-  		*eShell;
+  		*eShell,
+		*tShell;
   WlzGMFace	*nF;
   WlzGMLoopT	*nLT[2];
   WlzGMEdge	*nE[2];
@@ -8580,9 +8568,19 @@ static WlzErrorNum WlzGMModelJoin3V1E2S3D(WlzGMModel *model,
      ((nVT1[1] = WlzGMModelNewVT(model, &errNum)) != NULL) &&
      ((nVT1[2] = WlzGMModelNewVT(model, &errNum)) != NULL))
   {
-    /* Get shells that are to be extended and deleted. */
+    /* Get shells that are to be extended and deleted. As in
+     * WlzGMModelJoin3V0E2S3D() keep the shell with the greatest bounding
+     * box volume (and hopefully the greatest number of loops) since the
+     * cost of joining the shells is proportional to the number of loops
+     * in the shell that's deleted. */
     eShell = WlzGMEdgeGetShell(eE);
     dShell = WlzGMVertexGetShell(sV);
+    (void )WlzGMShellGetGBBV3D(eShell, &eVol);
+    (void )WlzGMShellGetGBBV3D(dShell, &dVol);
+    if(eVol < dVol)
+    {
+      tShell = eShell; eShell = dShell; dShell = tShell;
+    }
     /* Get verticies. */
     eV[0] = eE->edgeT->vertexT->diskT->vertex;
     eV[1] = eE->edgeT->opp->vertexT->diskT->vertex;
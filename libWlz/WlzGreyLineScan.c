@@ -0,0 +1,568 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzGreyLineScan_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzGreyLineScan.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Batched line by line scanning of grey valued objects.
+* \ingroup	WlzValuesUtils
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+static WlzErrorNum		WlzGreyLineScanSetPlane(
+				  WlzGreyLineWSpace *lWSp,
+				  int pl);
+static WlzErrorNum		WlzGreyLineScanFill(
+				  WlzGreyLineWSpace *lWSp);
+static WlzGreyP			WlzGreyLineScanGreyP(
+				  WlzGreyType gType,
+				  WlzGreyP gP,
+				  long off);
+
+/*!
+* \return	New batched line scanning workspace or NULL on error.
+* \ingroup	WlzValuesUtils
+* \brief	Creates a workspace for batched line by line scanning of
+* 		the given 2 or 3D domain object, which must have grey
+* 		values. After a call to WlzGreyLineScanNext() or
+* 		WlzGreyLineScanLine() the workspace holds all the
+* 		intervals of a line (with absolute column coordinates)
+* 		together with pointers to the contiguous grey values of
+* 		each interval. Scanning is always in the standard
+* 		direction (increasing planes, lines and columns).
+*
+* 		Each workspace is independent of all others so multiple
+* 		threads may scan the same object using one workspace
+* 		per thread, provided that only disjoint lines are
+* 		written.
+*
+* 		Rectangular, ragged rectangle, interval and tiled
+* 		value tables are all supported. For tiled value tables
+* 		the values of a line are buffered and (if the write
+* 		flag is set) are written back to the tiles when the
+* 		workspace moves on to another line or is freed.
+* \param	obj			Given object.
+* \param	write			Non-zero if the grey values are to
+* 					be modified.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzGreyLineWSpace *WlzGreyLineScanInit(WlzObject *obj, int write,
+				       WlzErrorNum *dstErr)
+{
+  WlzGreyLineWSpace *lWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(obj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+        break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+	else if((WlzGreyTableIsTiled(obj->values.core->type) == 0) &&
+	        (obj->values.core->type != WLZ_VOXELVALUETABLE_GREY))
+	{
+	  errNum = WLZ_ERR_VALUES_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((lWSp = (WlzGreyLineWSpace *)
+               AlcCalloc(1, sizeof(WlzGreyLineWSpace))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      lWSp->obj = obj;
+      lWSp->write = write;
+      lWSp->gType = WLZ_GREY_ERROR;
+      if(WlzGreyTableIsTiled(obj->values.core->type))
+      {
+	lWSp->tvb = WlzMakeTiledValueBuffer(obj->values.t, &errNum);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGreyLineScanSetPlane(lWSp, (obj->type == WLZ_2D_DOMAINOBJ)?
+                                           0: obj->domain.p->plane1);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzGreyLineScanFree(lWSp);
+    lWSp = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lWSp);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Frees a batched line scanning workspace, first writing back
+* 		any buffered values if the workspace was created for
+* 		writing.
+* \param	lWSp			Given workspace, may be NULL.
+*/
+void		WlzGreyLineScanFree(WlzGreyLineWSpace *lWSp)
+{
+  if(lWSp)
+  {
+    if(lWSp->tvb)
+    {
+      if(lWSp->write && lWSp->tvb->valid)
+      {
+        WlzTiledValueBufferFlush(lWSp->tvb, lWSp->obj->values.t);
+      }
+      WlzFreeTiledValueBuffer(lWSp->tvb);
+    }
+    AlcFree(lWSp->itv);
+    AlcFree(lWSp->val);
+    AlcFree(lWSp);
+  }
+}
+
+/*!
+* \return	Woolz error code, WLZ_ERR_EOO when there are no more lines.
+* \ingroup	WlzValuesUtils
+* \brief	Moves the workspace on to the next line of the object which
+* 		has at least one interval, filling in the intervals and
+* 		their grey value pointers.
+* \param	lWSp			Given workspace.
+*/
+WlzErrorNum	WlzGreyLineScanNext(WlzGreyLineWSpace *lWSp)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(lWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    int		lastPl;
+
+    lastPl = (lWSp->obj->type == WLZ_2D_DOMAINOBJ)?
+             0: lWSp->obj->domain.p->lastpl;
+    if(lWSp->started == 0)
+    {
+      lWSp->started = 1;
+      lWSp->ln = (lWSp->iDom)? lWSp->iDom->line1 - 1: 0;
+    }
+    do
+    {
+      if((lWSp->iDom == NULL) || (lWSp->ln >= lWSp->iDom->lastln))
+      {
+	/* Find the next plane with a non empty domain. */
+	do
+	{
+	  if(lWSp->pln >= lastPl)
+	  {
+	    errNum = WLZ_ERR_EOO;
+	  }
+	  else
+	  {
+	    errNum = WlzGreyLineScanSetPlane(lWSp, lWSp->pln + 1);
+	  }
+	} while((errNum == WLZ_ERR_NONE) && (lWSp->iDom == NULL));
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  lWSp->ln = lWSp->iDom->line1;
+	}
+      }
+      else
+      {
+        ++(lWSp->ln);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzGreyLineScanFill(lWSp);
+      }
+    } while((errNum == WLZ_ERR_NONE) && (lWSp->nItv == 0));
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the workspace to the given line of the given plane
+* 		(which is ignored for 2D objects), filling in the intervals
+* 		and their grey value pointers. It is not an error for the
+* 		line to lie outside the object, in which case the number
+* 		of intervals will be zero. This allows lines to be accessed
+* 		in any order, eg by threads each having their own
+* 		workspace. A subsequent call to WlzGreyLineScanNext()
+* 		continues from the given line.
+* \param	lWSp			Given workspace.
+* \param	pl			Given plane.
+* \param	ln			Given line.
+*/
+WlzErrorNum	WlzGreyLineScanLine(WlzGreyLineWSpace *lWSp, int pl, int ln)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(lWSp == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    if(lWSp->obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      pl = 0;
+    }
+    else if((pl < lWSp->obj->domain.p->plane1) ||
+            (pl > lWSp->obj->domain.p->lastpl))
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+    if((errNum == WLZ_ERR_NONE) && (pl != lWSp->pln))
+    {
+      errNum = WlzGreyLineScanSetPlane(lWSp, pl);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      lWSp->started = 1;
+      lWSp->ln = ln;
+      errNum = WlzGreyLineScanFill(lWSp);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Sets the current plane of the workspace, finding it's
+* 		interval domain, values and grey type. If the plane has
+* 		an empty domain or no values then the workspace's interval
+* 		domain is set to NULL.
+* \param	lWSp			Given workspace.
+* \param	pl			Given plane (ignored for 2D objects).
+*/
+static WlzErrorNum WlzGreyLineScanSetPlane(WlzGreyLineWSpace *lWSp, int pl)
+{
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = lWSp->obj;
+  if(lWSp->tvb && lWSp->write && lWSp->tvb->valid)
+  {
+    WlzTiledValueBufferFlush(lWSp->tvb, obj->values.t);
+    lWSp->tvb->valid = 0;
+  }
+  lWSp->nItv = 0;
+  lWSp->pln = pl;
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    dom = obj->domain;
+    val = obj->values;
+  }
+  else
+  {
+    dom = obj->domain.p->domains[pl - obj->domain.p->plane1];
+    if(lWSp->tvb)
+    {
+      val = obj->values;
+    }
+    else
+    {
+      WlzVoxelValues *vox;
+
+      vox = obj->values.vox;
+      val.core = ((pl < vox->plane1) || (pl > vox->lastpl))?
+                 NULL: vox->values[pl - vox->plane1].core;
+    }
+  }
+  if((dom.core == NULL) || (dom.core->type == WLZ_EMPTY_DOMAIN) ||
+     (val.core == NULL))
+  {
+    /* Planes without a domain or values are treated as empty. */
+    lWSp->iDom = NULL;
+  }
+  else if((dom.core->type != WLZ_INTERVALDOMAIN_INTVL) &&
+          (dom.core->type != WLZ_INTERVALDOMAIN_RECT))
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    lWSp->iDom = dom.i;
+    lWSp->values = val;
+    lWSp->gType = WlzGreyTableTypeToGreyType(val.core->type, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      lWSp->gTabType = WlzGreyTableTypeToTableType(val.core->type, &errNum);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Fills in the intervals and grey value pointers for the
+* 		workspace's current plane and line.
+* \param	lWSp			Given workspace.
+*/
+static WlzErrorNum WlzGreyLineScanFill(WlzGreyLineWSpace *lWSp)
+{
+  int		idx,
+  		nItv = 0;
+  WlzInterval	rectItv;
+  WlzInterval	*itv = NULL;
+  WlzIntervalDomain *iDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  iDom = lWSp->iDom;
+  if(lWSp->tvb && lWSp->write && lWSp->tvb->valid)
+  {
+    WlzTiledValueBufferFlush(lWSp->tvb, lWSp->obj->values.t);
+    lWSp->tvb->valid = 0;
+  }
+  if((iDom != NULL) &&
+     (lWSp->ln >= iDom->line1) && (lWSp->ln <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      nItv = 1;
+      rectItv.ileft = 0;
+      rectItv.iright = iDom->lastkl - iDom->kol1;
+      itv = &rectItv;
+    }
+    else
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + lWSp->ln - iDom->line1;
+      nItv = iLn->nintvs;
+      itv = iLn->intvs;
+    }
+  }
+  if(nItv > lWSp->maxItv)
+  {
+    int		maxItv;
+    WlzInterval	*newItv;
+    WlzGreyP	*newVal = NULL;
+
+    /* Only replace the buffers on success so that they are not lost
+     * if a reallocation fails. */
+    maxItv = (nItv < 16)? 16: 2 * nItv;
+    if((newItv = (WlzInterval *)
+                 AlcRealloc(lWSp->itv,
+		            maxItv * sizeof(WlzInterval))) != NULL)
+    {
+      lWSp->itv = newItv;
+      newVal = (WlzGreyP *)AlcRealloc(lWSp->val, maxItv * sizeof(WlzGreyP));
+    }
+    if(newVal == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      lWSp->val = newVal;
+      lWSp->maxItv = maxItv;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    nItv = 0;
+  }
+  for(idx = 0; idx < nItv; ++idx)
+  {
+    lWSp->itv[idx].ileft = iDom->kol1 + itv[idx].ileft;
+    lWSp->itv[idx].iright = iDom->kol1 + itv[idx].iright;
+  }
+  if(nItv > 0)
+  {
+    WlzValues	val;
+
+    val = lWSp->values;
+    switch(lWSp->gTabType)
+    {
+      case WLZ_GREY_TAB_RAGR:
+	{
+	  WlzValueLine *vLn;
+
+	  vLn = val.v->vtblines + lWSp->ln - val.v->line1;
+	  for(idx = 0; idx < nItv; ++idx)
+	  {
+	    lWSp->val[idx] = WlzGreyLineScanGreyP(lWSp->gType, vLn->values,
+	                         lWSp->itv[idx].ileft - val.v->kol1 -
+				 vLn->vkol1);
+	  }
+	}
+	break;
+      case WLZ_GREY_TAB_RECT:
+	{
+	  long lnOff;
+
+	  lnOff = (long )(lWSp->ln - val.r->line1) * val.r->width;
+	  for(idx = 0; idx < nItv; ++idx)
+	  {
+	    lWSp->val[idx] = WlzGreyLineScanGreyP(lWSp->gType, val.r->values,
+	                         lnOff + lWSp->itv[idx].ileft - val.r->kol1);
+	  }
+	}
+	break;
+      case WLZ_GREY_TAB_INTL:
+	{
+	  int	idV = 0;
+	  WlzValueIntervalLine *vil;
+
+	  /* Both the domain and value intervals are ordered so walk them
+	   * together. */
+	  vil = val.i->vil + lWSp->ln - val.i->line1;
+	  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nItv); ++idx)
+	  {
+	    int		kol;
+
+	    kol = lWSp->itv[idx].ileft - val.i->kol1;
+	    while((idV < vil->nintvs) && (vil->vtbint[idV].vlastkl < kol))
+	    {
+	      ++idV;
+	    }
+	    if((idV >= vil->nintvs) || (vil->vtbint[idV].vkol1 > kol))
+	    {
+	      errNum = WLZ_ERR_VALUES_DATA;
+	    }
+	    else
+	    {
+	      lWSp->val[idx] = WlzGreyLineScanGreyP(lWSp->gType,
+	                           vil->vtbint[idV].values,
+				   kol - vil->vtbint[idV].vkol1);
+	    }
+	  }
+	}
+	break;
+      case WLZ_GREY_TAB_TILED:
+	{
+	  WlzTiledValues *tv;
+	  WlzTiledValueBuffer *tvb;
+
+	  tv = val.t;
+	  tvb = lWSp->tvb;
+	  tvb->pl = (tv->dim == 2)? 0: lWSp->pln - tv->plane1;
+	  tvb->ln = lWSp->ln - tv->line1;
+	  tvb->kl[0] = lWSp->itv[0].ileft - tv->kol1;
+	  tvb->kl[1] = lWSp->itv[nItv - 1].iright - tv->kol1;
+	  errNum = WlzTiledValueBufferFill(tvb, tv);
+	  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nItv); ++idx)
+	  {
+	    lWSp->val[idx] = WlzGreyLineScanGreyP(lWSp->gType, tvb->lnbuf,
+	                         lWSp->itv[idx].ileft - tv->kol1);
+	  }
+	}
+	break;
+      default:
+	errNum = WLZ_ERR_VALUES_TYPE;
+	break;
+    }
+  }
+  lWSp->nItv = (errNum == WLZ_ERR_NONE)? nItv: 0;
+  return(errNum);
+}
+
+/*!
+* \return	Offset grey pointer.
+* \ingroup	WlzValuesUtils
+* \brief	Offsets the given grey pointer by the given number of values
+* 		of the given grey type.
+* \param	gType			Given grey type.
+* \param	gP			Given grey pointer.
+* \param	off			Offset in values.
+*/
+static WlzGreyP	WlzGreyLineScanGreyP(WlzGreyType gType, WlzGreyP gP,
+				     long off)
+{
+  switch(gType)
+  {
+    case WLZ_GREY_LONG:
+      gP.lnp += off;
+      break;
+    case WLZ_GREY_INT:
+      gP.inp += off;
+      break;
+    case WLZ_GREY_SHORT:
+      gP.shp += off;
+      break;
+    case WLZ_GREY_UBYTE:
+      gP.ubp += off;
+      break;
+    case WLZ_GREY_FLOAT:
+      gP.flp += off;
+      break;
+    case WLZ_GREY_DOUBLE:
+      gP.dbp += off;
+      break;
+    case WLZ_GREY_RGBA:
+      gP.rgbp += off;
+      break;
+    default:
+      gP.v = NULL;
+      break;
+  }
+  return(gP);
+}
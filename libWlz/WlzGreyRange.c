@@ -44,14 +44,40 @@ static char _WlzGreyRange_c[] = "University of Edinburgh $Id$";
 #include <stdlib.h>
 #include <Wlz.h>
 
+/*!
+* \ingroup	WlzValuesFilters
+* \brief	Updates the minimum and maximum values using the N
+* 		contiguous values of an interval. The following
+* 		parameters are required:
+*  		<ul>
+*  		  <li>P</li> Pointer to the interval's values.
+*  		  <li>N</li> Number of values in the interval.
+*  		  <li>MN</li> Minimum value.
+*  		  <li>MX</li> Maximum value.
+*  		  <li>K</li> Column index.
+*  		</ul>
+*/
+#define WLZ_GREYRANGE_ITV(P,N,MN,MX,K) \
+{ \
+  for((K)=0;(K)<(N);++(K)) \
+  { \
+    (MN)=((P)[(K)]<(MN))?(P)[(K)]:(MN); \
+    (MX)=((P)[(K)]>(MX))?(P)[(K)]:(MX); \
+  } \
+}
+
 /* function:     WlzGreyRange    */
 /*! 
 * \ingroup      WlzValuesFilters
 * \brief        compute grey-range of a pixel/voxel object.
 *
+* 		The object's values are scanned a line at a time using
+* 		WlzGreyLineScanNext() so that the grey type is only
+* 		dispatched once per line and all value table types
+* 		(including tiled values) are supported.
 * \return       Woolz error number: WLZ_ERR_NONE, WLZ_ERR_OBJECT_NULL,
  WLZ_ERR_DOMAIN_NULL, WLZ_ERR_VALUES_NULL, WLZ_ERR_GREY_TYPE, 
-WLZ_ERR_VOXELVALUES_TYPE, WLZ_ERR_PLANEDOMAIN_TYPE, WLZ_ERR_OBJECT_TYPE
+WLZ_ERR_VALUES_TYPE, WLZ_ERR_DOMAIN_TYPE, WLZ_ERR_OBJECT_TYPE
 * \param    obj	grey-level input object
 * \param    min	minimum values return
 * \param    max	maximum values return.
@@ -62,344 +88,149 @@ WlzErrorNum WlzGreyRange(WlzObject	*obj,
 			 WlzPixelV	*min,
 			 WlzPixelV	*max)
 {
-  WlzGreyV		v;
+  int			idI,
+  			idK,
+			len,
+  			init_flag = 0;
   WlzGreyP		g;
-  int			i, nplanes, init_flag;
-  WlzPixelV		lmin, lmax, Min, Max;
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  WlzObject		tempobj;
-  WlzPlaneDomain	*planedm;
-  WlzValues 		*values;
-  WlzDomain		*domains;
-  WlzGreyType		gType;
-  WlzErrorNum		errNum;
+  WlzPixelV		lmin,
+  			lmax;
+  WlzUInt		cmin[4],
+  			cmax[4];
+  WlzGreyLineWSpace	*lWSp = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* check for NULL object */
   if( obj == NULL ){
     return( WLZ_ERR_OBJECT_NULL );
   }
-
-  /* check for NULL domain or values */
-  if( obj->domain.core == NULL ){
-    return( WLZ_ERR_DOMAIN_NULL );
-  }
-  if( obj->values.core == NULL ){
-    return( WLZ_ERR_VALUES_NULL );
-  }
-  if( WlzGreyTableIsTiled(obj->values.core->type) ){
-    return( WLZ_ERR_VALUES_TYPE );
-  }
-    
-  init_flag = 0;
   switch( obj->type ){
 
-  case WLZ_2D_DOMAINOBJ:
-    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-    if(errNum == WLZ_ERR_NONE) {
-      lmin.type = gwsp.pixeltype;
-      lmax.type = gwsp.pixeltype;
-      while( (errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE ){
-	g = gwsp.u_grintptr;
-	switch( gwsp.pixeltype ){
-
-	case WLZ_GREY_INT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.inv = *g.inp++;
-	    if( !init_flag ){
-	      lmin.v.inv = v.inv;
-	      lmax.v.inv = v.inv;
-	      init_flag = 1;
-	    }
-	    else if( v.inv > lmax.v.inv ){
-	      lmax.v.inv = v.inv;
-	    }
-	    else if( v.inv < lmin.v.inv ){
-	      lmin.v.inv = v.inv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_SHORT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.shv = *g.shp++;
-	    if( !init_flag ){
-	      lmin.v.shv = v.shv;
-	      lmax.v.shv = v.shv;
-	      init_flag = 1;
-	    }
-	    else if( v.shv > lmax.v.shv ){
-	      lmax.v.shv = v.shv;
-	    }
-	    else if( v.shv < lmin.v.shv ){
-	      lmin.v.shv = v.shv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_UBYTE:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.ubv = *g.ubp++;
-	    if( !init_flag ){
-	      lmin.v.ubv = v.ubv;
-	      lmax.v.ubv = v.ubv;
-	      init_flag = 1;
-	    }
-	    else if( v.ubv > lmax.v.ubv ){
-	      lmax.v.ubv = v.ubv;
-	    }
-	    else if( v.ubv < lmin.v.ubv ){
-	      lmin.v.ubv = v.ubv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_FLOAT:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.flv = *g.flp++;
-	    if( !init_flag ){
-	      lmin.v.flv = v.flv;
-	      lmax.v.flv = v.flv;
-	      init_flag = 1;
-	    }
-	    else if( v.flv > lmax.v.flv ){
-	      lmax.v.flv = v.flv;
-	    }
-	    else if( v.flv < lmin.v.flv ){
-	      lmin.v.flv = v.flv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_DOUBLE:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.dbv = *g.dbp++;
-	    if( !init_flag ){
-	      lmin.v.dbv = v.dbv;
-	      lmax.v.dbv = v.dbv;
-	      init_flag = 1;
-	    }
-	    else if( v.dbv > lmax.v.dbv ){
-	      lmax.v.dbv = v.dbv;
-	    }
-	    else if( v.dbv < lmin.v.dbv ){
-	      lmin.v.dbv = v.dbv;
-	    }
-	  }
-	  break;
-
-	case WLZ_GREY_RGBA:
-	  for(i=0; i<iwsp.colrmn; i++){
-	    v.rgbv = *g.rgbp++;
-	    if( !init_flag ){
-	      lmin.v.rgbv = v.rgbv;
-	      lmax.v.rgbv = v.rgbv;
-	      init_flag = 1;
-	    }
-	    else {
-	      /* red */
-	      if( (v.rgbv&0xff) > (lmax.v.rgbv&0xff) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffffff00) + (v.rgbv&0xff);
-	      }
-	      else if( (v.rgbv&0xff) < (lmin.v.rgbv&0xff) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xffffff00) + (v.rgbv&0xff);
-	      }
+  case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
+  case WLZ_3D_DOMAINOBJ:
+    break;
 
-	      /* green */
-	      if( (v.rgbv&0xff00) > (lmax.v.rgbv&0xff00) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffff00ff) + (v.rgbv&0xff00);
-	      }
-	      else if( (v.rgbv&0xff00) < (lmin.v.rgbv&0xff00) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xffff00ff) + (v.rgbv&0xff00);
-	      }
+  case WLZ_TRANS_OBJ:
+    return( WlzGreyRange(obj->values.obj, min, max) );
 
-	      /* blue */
-	      if( (v.rgbv&0xff0000) > (lmax.v.rgbv&0xff0000) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xff00ffff) + (v.rgbv&0xff0000);
-	      }
-	      else if( (v.rgbv&0xff0000) < (lmin.v.rgbv&0xff0000) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0xff00ffff) + (v.rgbv&0xff0000);
-	      }
+  case WLZ_EMPTY_OBJ:
+    return WLZ_ERR_NONE;
 
-	      /* alpha */
-	      if( (v.rgbv&0xff000000) > (lmax.v.rgbv&0xff000000) ){
-		lmax.v.rgbv = (lmax.v.rgbv&0xffffff00) + (v.rgbv&0xff000000);
-	      }
-	      else if( (v.rgbv&0xff000000) < (lmin.v.rgbv&0xff000000) ){
-		lmin.v.rgbv = (lmin.v.rgbv&0x00ffffff) + (v.rgbv&0xff000000);
-	      }
-	    }
-	  }
-	  break;
+  default:
+    return( WLZ_ERR_OBJECT_TYPE );
 
-	default:
-	  return( WLZ_ERR_GREY_TYPE );
+  }
 
-	}
-      }
-      (void )WlzEndGreyScan(&iwsp, &gwsp);
-      if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
-      {
-	errNum = WLZ_ERR_NONE;
+  lWSp = WlzGreyLineScanInit(obj, 0, &errNum);
+  if( errNum == WLZ_ERR_NONE ){
+    lmin.type = lmax.type = lWSp->gType;
+    lmin.v.dbv = lmax.v.dbv = 0.0;
+    cmin[0] = cmin[1] = cmin[2] = cmin[3] = 0;
+    cmax[0] = cmax[1] = cmax[2] = cmax[3] = 0;
+  }
+  while((errNum == WLZ_ERR_NONE) &&
+        ((errNum = WlzGreyLineScanNext(lWSp)) == WLZ_ERR_NONE)){
+    if( !init_flag ){
+      /* Initialise the range using the first value. */
+      init_flag = 1;
+      lmin.type = lmax.type = lWSp->gType;
+      g = lWSp->val[0];
+      switch( lWSp->gType ){
+      case WLZ_GREY_INT:
+	lmin.v.inv = lmax.v.inv = *g.inp;
+	break;
+      case WLZ_GREY_SHORT:
+	lmin.v.shv = lmax.v.shv = *g.shp;
+	break;
+      case WLZ_GREY_UBYTE:
+	lmin.v.ubv = lmax.v.ubv = *g.ubp;
+	break;
+      case WLZ_GREY_FLOAT:
+	lmin.v.flv = lmax.v.flv = *g.flp;
+	break;
+      case WLZ_GREY_DOUBLE:
+	lmin.v.dbv = lmax.v.dbv = *g.dbp;
+	break;
+      case WLZ_GREY_RGBA:
+	cmin[0] = cmax[0] = WLZ_RGBA_RED_GET(*g.rgbp);
+	cmin[1] = cmax[1] = WLZ_RGBA_GREEN_GET(*g.rgbp);
+	cmin[2] = cmax[2] = WLZ_RGBA_BLUE_GET(*g.rgbp);
+	cmin[3] = cmax[3] = WLZ_RGBA_ALPHA_GET(*g.rgbp);
+	break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
       }
     }
-    *min = lmin;
-    *max = lmax;
-    break;
-
-  case WLZ_3D_DOMAINOBJ:
-    planedm = obj->domain.p;
-    switch( planedm->type ){
-
-    case WLZ_PLANEDOMAIN_DOMAIN:
-      nplanes = planedm->lastpl - planedm->plane1 + 1;
-      domains = planedm->domains;
-      if( obj->values.vox->type != WLZ_VOXELVALUETABLE_GREY ){
-	return( WLZ_ERR_VOXELVALUES_TYPE );
-      }
-      values = obj->values.vox->values;
-      tempobj.type = WLZ_2D_DOMAINOBJ;
-      tempobj.plist = NULL;
-      tempobj.assoc = NULL;
-      for(i=0; i < nplanes; i++, domains++, values++){
-	if( (*domains).core == NULL || (*values).core == NULL ){
-	  continue;
-	}
-
-	tempobj.domain = *domains;
-	tempobj.values = *values;
-	errNum = WlzGreyRange(&tempobj, &Min, &Max);
-	if( errNum != WLZ_ERR_NONE ){
-	  return( errNum );
-	}
-	if( !init_flag ){
-	  lmin = Min;
-	  lmax = Max;
-	  init_flag = 1;
-	  continue;
-	}
-	
-	gType = WlzGreyTableTypeToGreyType((*values).v->type, &errNum);
-	if(errNum != WLZ_ERR_NONE)
-	{
-	  return(errNum);
+    else if( lWSp->gType != lmin.type ){
+      /* All planes of a 3D object must have the same grey type. */
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+    for(idI = 0; (errNum == WLZ_ERR_NONE) && (idI < lWSp->nItv); ++idI){
+      g = lWSp->val[idI];
+      len = lWSp->itv[idI].iright - lWSp->itv[idI].ileft + 1;
+      switch( lWSp->gType ){
+
+      case WLZ_GREY_INT:
+	WLZ_GREYRANGE_ITV(g.inp, len, lmin.v.inv, lmax.v.inv, idK);
+	break;
+
+      case WLZ_GREY_SHORT:
+	WLZ_GREYRANGE_ITV(g.shp, len, lmin.v.shv, lmax.v.shv, idK);
+	break;
+
+      case WLZ_GREY_UBYTE:
+	WLZ_GREYRANGE_ITV(g.ubp, len, lmin.v.ubv, lmax.v.ubv, idK);
+	break;
+
+      case WLZ_GREY_FLOAT:
+	WLZ_GREYRANGE_ITV(g.flp, len, lmin.v.flv, lmax.v.flv, idK);
+	break;
+
+      case WLZ_GREY_DOUBLE:
+	WLZ_GREYRANGE_ITV(g.dbp, len, lmin.v.dbv, lmax.v.dbv, idK);
+	break;
+
+      case WLZ_GREY_RGBA:
+	/* Independent range for each of the red, green, blue and alpha
+	 * channels. */
+	for(idK = 0; idK < len; ++idK){
+	  WlzUInt	c[4];
+
+	  c[0] = WLZ_RGBA_RED_GET(g.rgbp[idK]);
+	  c[1] = WLZ_RGBA_GREEN_GET(g.rgbp[idK]);
+	  c[2] = WLZ_RGBA_BLUE_GET(g.rgbp[idK]);
+	  c[3] = WLZ_RGBA_ALPHA_GET(g.rgbp[idK]);
+	  cmin[0] = (c[0] < cmin[0])? c[0]: cmin[0];
+	  cmin[1] = (c[1] < cmin[1])? c[1]: cmin[1];
+	  cmin[2] = (c[2] < cmin[2])? c[2]: cmin[2];
+	  cmin[3] = (c[3] < cmin[3])? c[3]: cmin[3];
+	  cmax[0] = (c[0] > cmax[0])? c[0]: cmax[0];
+	  cmax[1] = (c[1] > cmax[1])? c[1]: cmax[1];
+	  cmax[2] = (c[2] > cmax[2])? c[2]: cmax[2];
+	  cmax[3] = (c[3] > cmax[3])? c[3]: cmax[3];
 	}
-	switch(gType){
-
-	case WLZ_GREY_INT:
-	  if( Min.v.inv < lmin.v.inv ){
-	    lmin.v.inv = Min.v.inv;
-	  }
-	  if( Max.v.inv > lmax.v.inv ){
-	    lmax.v.inv = Max.v.inv;
-	  }
-	  break;
-
-	case WLZ_GREY_SHORT:
-	  if( Min.v.shv < lmin.v.shv ){
-	    lmin.v.shv = Min.v.shv;
-	  }
-	  if( Max.v.shv > lmax.v.shv ){
-	    lmax.v.shv = Max.v.shv;
-	  }
-	  break;
+	break;
 
-	case WLZ_GREY_UBYTE:
-	  if( Min.v.ubv < lmin.v.ubv ){
-	    lmin.v.ubv = Min.v.ubv;
-	  }
-	  if( Max.v.ubv > lmax.v.ubv ){
-	    lmax.v.ubv = Max.v.ubv;
-	  }
-	  break;
+      default:
+	errNum = WLZ_ERR_GREY_TYPE;
+	break;
 
-	case WLZ_GREY_FLOAT:
-	  if( Min.v.flv < lmin.v.flv ){
-	    lmin.v.flv = Min.v.flv;
-	  }
-	  if( Max.v.flv > lmax.v.flv ){
-	    lmax.v.flv = Max.v.flv;
-	  }
-	  break;
-
-	case WLZ_GREY_DOUBLE:
-	  if( Min.v.dbv < lmin.v.dbv ){
-	    lmin.v.dbv = Min.v.dbv;
-	  }
-	  if( Max.v.dbv > lmax.v.dbv ){
-	    lmax.v.dbv = Max.v.dbv;
-	  }
-	  break;
-
-	case WLZ_GREY_RGBA:
-	  /* red */
-	  if( (Min.v.rgbv&0xff) < (lmin.v.rgbv&0xff) ){
-	    lmin.v.rgbv &= ~0xff;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff);
-	  }
-	  if( (Max.v.rgbv&0xff) > (lmax.v.rgbv&0xff) ){
-	    lmin.v.rgbv &= ~0xff;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff);
-	  }
-
-	  /* green */
-	  if( (Min.v.rgbv&0xff00) < (lmin.v.rgbv&0xff00) ){
-	    lmin.v.rgbv &= ~0xff00;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff00);
-	  }
-	  if( (Max.v.rgbv&0xff00) > (lmax.v.rgbv&0xff00) ){
-	    lmin.v.rgbv &= ~0xff00;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff00);
-	  }
-
-	  /* blue */
-	  if( (Min.v.rgbv&0xff0000) < (lmin.v.rgbv&0xff0000) ){
-	    lmin.v.rgbv &= ~0xff0000;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff0000);
-	  }
-	  if( (Max.v.rgbv&0xff0000) > (lmax.v.rgbv&0xff0000) ){
-	    lmin.v.rgbv &= ~0xff0000;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff0000);
-	  }
-
-	  /* alpha */
-	  if( (Min.v.rgbv&0xff000000) < (lmin.v.rgbv&0xff000000) ){
-	    lmin.v.rgbv &= ~0xff000000;
-	    lmin.v.rgbv |= (Min.v.rgbv&0xff000000);
-	  }
-	  if( (Max.v.rgbv&0xff000000) > (lmax.v.rgbv&0xff000000) ){
-	    lmin.v.rgbv &= ~0xff000000;
-	    lmin.v.rgbv |= (Max.v.rgbv&0xff000000);
-	  }
-
-	  break;
-
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  return(errNum);
-	  /* break; */
-	}
       }
-      break;
-
-    default:
-      return( WLZ_ERR_PLANEDOMAIN_TYPE );
-
+    }
+  }
+  WlzGreyLineScanFree(lWSp);
+  if( errNum == WLZ_ERR_EOO ){
+    errNum = WLZ_ERR_NONE;
+  }
+  if( errNum == WLZ_ERR_NONE ){
+    if( init_flag && (lmin.type == WLZ_GREY_RGBA) ){
+      WLZ_RGBA_RGBA_SET(lmin.v.rgbv, cmin[0], cmin[1], cmin[2], cmin[3]);
+      WLZ_RGBA_RGBA_SET(lmax.v.rgbv, cmax[0], cmax[1], cmax[2], cmax[3]);
     }
     *min = lmin;
     *max = lmax;
-    break;
-
-  case WLZ_TRANS_OBJ:
-    return( WlzGreyRange(obj->values.obj, min, max) );
-
-  case WLZ_EMPTY_OBJ:
-    return WLZ_ERR_NONE;
-
-  default:
-    return( WLZ_ERR_OBJECT_TYPE );
-
   }
 
-  return( WLZ_ERR_NONE );
+  return( errNum );
 }
@@ -399,7 +399,7 @@ WlzGreyInterval(WlzIntervalWSpace *iwsp)
 	tvb->ln = iwsp->linpos - tv->line1;
 	off = tvb->kl[0] = iwsp->lftpos - tv->kol1;
 	tvb->kl[1] = iwsp->rgtpos - tv->kol1;
-	WlzTiledValueBufferFill(tvb, tv);
+	errNum = WlzTiledValueBufferFill(tvb, tv);
 	switch (gwsp->pixeltype)
 	{
 	  case WLZ_GREY_INT:
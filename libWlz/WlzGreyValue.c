@@ -42,11 +42,29 @@ static char _WlzGreyValue_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
+#include <math.h>
 #include <Wlz.h>
 #ifndef WLZ_FAST_CODE
 #define WLZ_FAST_CODE
 #endif
 
+/*!
+* \struct	_WlzGreyValueHint
+* \ingroup	WlzAccess
+* \brief	Interval search state kept between the points of a
+* 		batched grey value lookup, see WlzGreyValueGetN().
+*		Typedef: ::WlzGreyValueHint.
+*/
+typedef struct _WlzGreyValueHint
+{
+  WlzIntervalDomain *iDom;		/*!< Interval domain of the last
+  					     point or NULL. */
+  int		line;			/*!< Line of the last point. */
+  int		itvIdx;			/*!< Index of the interval nearest
+  					     to the last point. */
+} WlzGreyValueHint;
+
 static void			WlzGreyValueSetBkdP(
 				  WlzGreyV *gVP,
 				  WlzGreyP *gPP,
@@ -70,16 +88,22 @@ static void			WlzGreyValueComputeGreyP2D(
 				  WlzGreyValueWSpace *gVWSp,
 				  int line,
 				  int kol);
+static WlzErrorNum		WlzGreyValueTileWriteBack(
+				  WlzGreyValueWSpace *gVWSp);
+static WlzGreyP			WlzGreyValueTile(
+				  WlzGreyValueWSpace *gVWSp,
+				  size_t idx,
+				  size_t *offset);
 static void			WlzGreyValueComputeGreyPTiled2D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
 				  int line,
 				  int kol);
 static void			WlzGreyValueComputeGreyPTiled3D(
 				  WlzGreyP *baseGVP,
 				  size_t *offset,
-				  WlzTiledValues *tVal,
+				  WlzGreyValueWSpace *gVWSp,
 				  int plane,
 				  int line,
 				  int kol);
@@ -116,12 +140,43 @@ static void			WlzGreyValueGetTransCon(
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueGetHRow(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzGreyValueHint *hint,
+				  int plane,
+				  int line,
+				  int kol,
+				  int n,
+				  double *val);
+static double			WlzGreyValueGreyPToD(
+				  WlzGreyType gType,
+				  WlzGreyP gP,
+				  size_t off);
+static void			WlzGreyValueCubicWeights(
+				  double *w,
+				  double t);
+static void			WlzGreyValueAddN(
+				  double *v,
+				  int rgba,
+				  int n,
+				  double wR,
+				  double *wK,
+				  double *r);
+static double			WlzGreyValueEndN(
+				  double *v,
+				  int rgba);
 /*!
 * \return	Grey value work space or NULL on error.
 * \ingroup	WlzAccess
 * \brief	Creates a grey value work space from the given object.
 *		The resulting grey value work space should be freed
 *		using WlzGreyValueFreeWSp().
+*		If the object has tiled values which are accessed through
+*		a tile cache (see WlzMakeTiledValueCache()) then the grey
+*		pointers of the work space point into a private copy of
+*		the current tile, values set through them are written
+*		back to the tiled values when another tile is accessed
+*		or the work space is freed.
 * \param	obj			Given object.
 * \param	dstErrNum		Destination error pointer, may be NULL.
 */
@@ -423,6 +478,20 @@ WlzGreyValueWSpace *WlzGreyValueMakeWSp(WlzObject *obj,
 	break;
     }
   }
+  /* Tiled values which are accessed through a tile cache need a buffer
+   * for a copy of the current tile, followed by the tile as it was read
+   * so that modified tiles can be found and written back. */
+  if((errNum == WLZ_ERR_NONE) &&
+     (gVWSp->gTabType == WLZ_GREY_TAB_TILED) &&
+     (gVWSp->values.t->cache != NULL) && (gVWSp->tileBuf.v == NULL))
+  {
+    gVWSp->tileIdx = gVWSp->values.t->numTiles;
+    if((gVWSp->tileBuf.v = AlcMalloc(
+                           2 * gVWSp->values.t->cache->tileBytes)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   if((errNum != WLZ_ERR_NONE) && (gVWSp != NULL))
   {
     WlzGreyValueFreeWSp(gVWSp);
@@ -454,6 +523,11 @@ void		WlzGreyValueFreeWSp(WlzGreyValueWSpace *gVWSp)
   {
     (void )WlzFreeAffineTransform(gVWSp->invTrans);
     AlcFree((void *)(gVWSp->gTabTypes3D));
+    if(gVWSp->tileBuf.v)
+    {
+      (void )WlzGreyValueTileWriteBack(gVWSp);
+      AlcFree(gVWSp->tileBuf.v);
+    }
     AlcFree(gVWSp);
   }
   WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
@@ -766,6 +840,207 @@ void		WlzGreyValueGetDir(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	Gets grey values for an array of points from the object
+* 		with which the given work space was initialised. Unlike
+* 		WlzGreyValueGet() the values are returned as doubles in
+* 		the given array and the work space's grey values and
+* 		pointers are not set.
+*		Interval search state is kept from one point to the next
+*		for each of the lines of the interpolation neighbourhood,
+*		so points which are sorted (eg by plane, line and then
+*		column) or which are otherwise close to their predecessors
+*		are found more quickly than when randomly ordered.
+*		Points outside of the object's domain have the
+*		background value. For linear and cubic interpolation
+*		neighbouring values outside of the domain are also the
+*		background value.
+*		Linear interpolation is bi/tri-linear between the
+*		values at integer coordinates about the point, cubic
+*		interpolation is separable Catmull-Rom interpolation using
+*		the 4 x 4 (x 4) values about the point.
+*		For RGBA values the packed RGBA value is returned, with
+*		linear and cubic interpolation applied to each of the
+*		channels independently and the channel values then
+*		clamped to [0-255] and rounded.
+*		For 2D objects the z coordinates of the points are ignored.
+* \param	gVWSp			Grey value work space.
+* \param	interp			Interpolation method, which must be
+* 					one of WLZ_INTERPOLATION_NEAREST,
+* 					WLZ_INTERPOLATION_LINEAR or
+* 					WLZ_INTERPOLATION_CUBIC.
+* \param	n			Number of points.
+* \param	pos			Array of n point positions.
+* \param	val			Array for the n grey values.
+*/
+WlzErrorNum	WlzGreyValueGetN(WlzGreyValueWSpace *gVWSp,
+				 WlzInterpolationType interp,
+				 size_t n, WlzDVertex3 *pos, double *val)
+{
+  size_t	idN;
+  int		dim,
+  		rgba;
+  WlzGreyValueHint hint[16];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((gVWSp == NULL) || ((n > 0) && ((pos == NULL) || (val == NULL))))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((gVWSp->objType != WLZ_2D_DOMAINOBJ) &&
+          (gVWSp->objType != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else
+  {
+    switch(interp)
+    {
+      case WLZ_INTERPOLATION_NEAREST:
+        break;
+      case WLZ_INTERPOLATION_LINEAR: /* FALLTHROUGH */
+      case WLZ_INTERPOLATION_CUBIC:
+	break;
+      default:
+        errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idN = 0; idN < 16; ++idN)
+    {
+      hint[idN].iDom = NULL;
+      hint[idN].line = 0;
+      hint[idN].itvIdx = 0;
+    }
+    dim = (gVWSp->objType == WLZ_2D_DOMAINOBJ)? 2: 3;
+    rgba = gVWSp->gType == WLZ_GREY_RGBA;
+    for(idN = 0; idN < n; ++idN)
+    {
+      WlzDVertex3	p;
+
+      p = pos[idN];
+      if(gVWSp->invTrans)
+      {
+	if(dim == 2)
+	{
+	  WlzDVertex2 p2;
+
+	  p2.vtX = p.vtX;
+	  p2.vtY = p.vtY;
+	  p2 = WlzAffineTransformVertexD2(gVWSp->invTrans, p2, NULL);
+	  p.vtX = p2.vtX;
+	  p.vtY = p2.vtY;
+	}
+	else
+	{
+	  p = WlzAffineTransformVertexD3(gVWSp->invTrans, p, NULL);
+	}
+      }
+      if(dim == 2)
+      {
+	p.vtZ = 0.0;
+      }
+      switch(interp)
+      {
+	case WLZ_INTERPOLATION_NEAREST:
+	  WlzGreyValueGetHRow(gVWSp, hint, WLZ_NINT(p.vtZ),
+			      WLZ_NINT(p.vtY), WLZ_NINT(p.vtX), 1, val + idN);
+	  break;
+	case WLZ_INTERPOLATION_LINEAR:
+	  {
+	    int		iL,
+			  iP,
+			  nP;
+	    double	v[4],
+	    		wK[2];
+	    WlzIVertex3	p0;
+	    WlzDVertex3	f;
+
+	    p0.vtX = (int )floor(p.vtX);
+	    p0.vtY = (int )floor(p.vtY);
+	    p0.vtZ = (int )floor(p.vtZ);
+	    f.vtX = p.vtX - p0.vtX;
+	    f.vtY = p.vtY - p0.vtY;
+	    f.vtZ = p.vtZ - p0.vtZ;
+	    wK[0] = 1.0 - f.vtX;
+	    wK[1] = f.vtX;
+	    nP = dim - 1;
+	    v[0] = v[1] = v[2] = v[3] = 0.0;
+	    for(iP = 0; iP < nP; ++iP)
+	    {
+	      double	wP;
+
+	      wP = (nP == 1)? 1.0: ((iP)? f.vtZ: 1.0 - f.vtZ);
+	      for(iL = 0; iL < 2; ++iL)
+	      {
+		double	wL;
+
+		double	r[2];
+
+		wL = wP * ((iL)? f.vtY: 1.0 - f.vtY);
+		WlzGreyValueGetHRow(gVWSp, hint + (iP * 2) + iL,
+				    p0.vtZ + iP, p0.vtY + iL, p0.vtX, 2, r);
+		WlzGreyValueAddN(v, rgba, 2, wL, wK, r);
+	      }
+	    }
+	    val[idN] = WlzGreyValueEndN(v, rgba);
+	  }
+	  break;
+	case WLZ_INTERPOLATION_CUBIC:
+	  {
+	    int		iL,
+			  iP,
+			  nP;
+	    double	v[4];
+	    double	wK[4],
+			  wL[4],
+			  wP[4];
+	    WlzIVertex3	p0;
+
+	    p0.vtX = (int )floor(p.vtX);
+	    p0.vtY = (int )floor(p.vtY);
+	    p0.vtZ = (int )floor(p.vtZ);
+	    WlzGreyValueCubicWeights(wK, p.vtX - p0.vtX);
+	    WlzGreyValueCubicWeights(wL, p.vtY - p0.vtY);
+	    if(dim == 2)
+	    {
+	      nP = 1;
+	      wP[0] = 1.0;
+	    }
+	    else
+	    {
+	      nP = 4;
+	      p0.vtZ -= 1;
+	      WlzGreyValueCubicWeights(wP, p.vtZ - (p0.vtZ + 1));
+	    }
+	    v[0] = v[1] = v[2] = v[3] = 0.0;
+	    for(iP = 0; iP < nP; ++iP)
+	    {
+	      for(iL = 0; iL < 4; ++iL)
+	      {
+		double	r[4];
+
+		WlzGreyValueGetHRow(gVWSp, hint + (iP * 4) + iL,
+				    p0.vtZ + iP, p0.vtY + iL - 1, p0.vtX - 1,
+				    4, r);
+		WlzGreyValueAddN(v, rgba, 4, wP[iP] * wL[iL], wK, r);
+	      }
+	    }
+	    val[idN] = WlzGreyValueEndN(v, rgba);
+	  }
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -1014,14 +1289,131 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
       }
       break;
     case WLZ_GREY_TAB_TILED:
-      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp->values.t,
-                                      line, kol);
+      WlzGreyValueComputeGreyPTiled2D(baseGVP, offset, gVWSp, line, kol);
       break;
     default:
       break;
   }
 }
 
+/*!
+* \return	Base pointer for the tile's values.
+* \ingroup	WlzAccess
+* \brief	Computes the base pointer and offset to the first value
+* 		of the tile with the given index within a tiled value
+* 		table. If the tiled values are accessed through a tile
+* 		cache then the tile is copied into the work space's tile
+* 		buffer (unless it is already there) and the pointer is to
+* 		the buffer. On error a NULL pointer is returned.
+* \param	gVWSp			Grey value work space.
+* \param	idx			Index of the tile.
+* \param	offset			Destination pointer for the
+*                                       offset from base pointer.
+*/
+static WlzGreyP	WlzGreyValueTile(WlzGreyValueWSpace *gVWSp, size_t idx,
+				 size_t *offset)
+{
+  WlzGreyP	base;
+  WlzTiledValues *tVal;
+
+  tVal = gVWSp->values.t;
+  if(tVal->cache == NULL)
+  {
+    base = tVal->tiles;
+    *offset = idx * tVal->tileSz;
+  }
+  else
+  {
+    base = gVWSp->tileBuf;
+    *offset = 0;
+    if((idx != gVWSp->tileIdx) ||
+       (gVWSp->tileVer != tVal->cache->tileVer[idx]))
+    {
+      size_t	tSz;
+      unsigned int ver = 0;
+      WlzErrorNum errNum;
+
+      tSz = tVal->cache->tileBytes;
+      errNum = WlzGreyValueTileWriteBack(gVWSp);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	ver = tVal->cache->tileVer[idx];
+	errNum = WlzTiledValueCacheAccess(tVal->cache, idx, 0, tSz,
+					  base.v, 0);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )memcpy(base.ubp + tSz, base.ubp, tSz);
+	gVWSp->tileIdx = idx;
+	gVWSp->tileVer = ver;
+      }
+      else
+      {
+        gVWSp->tileIdx = tVal->numTiles;
+	base.v = NULL;
+      }
+    }
+  }
+  return(base);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAccess
+* \brief	If the work space's tile buffer holds a tile which has
+* 		been modified (through the work space's grey pointers)
+* 		since it was read then the modified values are written
+* 		back through the tile cache. Only runs of modified values
+* 		are written so that values of the same tile which have
+* 		been set through other work spaces are not overwritten.
+* \param	gVWSp			Grey value work space with tiled
+* 					values accessed through a tile
+* 					cache.
+*/
+static WlzErrorNum WlzGreyValueTileWriteBack(WlzGreyValueWSpace *gVWSp)
+{
+  size_t	gSz,
+  		tSz;
+  WlzTiledValues *tVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tVal = gVWSp->values.t;
+  gSz = tVal->cache->gSz;
+  tSz = tVal->cache->tileBytes;
+  if(gVWSp->tileIdx < tVal->numTiles)
+  {
+    size_t	off = 0;
+    WlzUByte	*buf,
+    		*org;
+
+    buf = gVWSp->tileBuf.ubp;
+    org = buf + tSz;
+    while((errNum == WLZ_ERR_NONE) && (off < tSz))
+    {
+      size_t	end;
+
+      /* Find the next run of modified values. */
+      while((off < tSz) && (memcmp(buf + off, org + off, gSz) == 0))
+      {
+        off += gSz;
+      }
+      end = off;
+      while((end < tSz) && (memcmp(buf + end, org + end, gSz) != 0))
+      {
+        end += gSz;
+      }
+      if(end > off)
+      {
+	errNum = WlzTiledValueCacheAccess(tVal->cache, gVWSp->tileIdx,
+					  off, end - off, buf + off, 1);
+      }
+      off = end;
+    }
+    gVWSp->tileIdx = tVal->numTiles;
+  }
+  return(errNum);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
@@ -1037,14 +1429,16 @@ static void	WlzGreyValueComputeGreyP2D(WlzGreyP *baseGVP,
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
 				int line, int kol)
 {
   WlzIVertex2 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
   *offset = 0;
   (*baseGVP).v = NULL;
+  tVal = gVWSp->values.t;
   rPos.vtX = kol - tVal->kol1;
   tIdx.vtX = rPos.vtX / tVal->tileWidth;
 #ifdef WLZ_FAST_CODE
@@ -1077,8 +1471,8 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 	tOff.vtX = rPos.vtX % tVal->tileWidth;
 	tOff.vtY = rPos.vtY % tVal->tileWidth;
 	off = (tOff.vtY * tVal->tileWidth) + tOff.vtX;
-	(*baseGVP).v = tVal->tiles.v;
-	*offset = (idx * tVal->tileSz) + off;
+	*baseGVP = WlzGreyValueTile(gVWSp, idx, offset);
+	*offset += off;
       }
     }
   }
@@ -1100,14 +1494,16 @@ static void	WlzGreyValueComputeGreyPTiled2D(WlzGreyP *baseGVP,
 * \param	kol			Column coordinate of point.
 */
 static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
-				size_t *offset, WlzTiledValues *tVal,
+				size_t *offset, WlzGreyValueWSpace *gVWSp,
 				int plane, int line, int kol)
 {
   WlzIVertex3 	rPos,
 		tIdx;
+  WlzTiledValues *tVal;
 
   *offset = 0;
   (*baseGVP).v = NULL;
+  tVal = gVWSp->values.t;
   rPos.vtX = kol - tVal->kol1;
   tIdx.vtX = rPos.vtX / tVal->tileWidth;
 #ifdef WLZ_FAST_CODE
@@ -1151,8 +1547,8 @@ static void	WlzGreyValueComputeGreyPTiled3D(WlzGreyP *baseGVP,
 	  tOff.vtZ = rPos.vtZ % tVal->tileWidth;
 	  off = ((tOff.vtZ * tVal->tileWidth + tOff.vtY) * tVal->tileWidth) +
 	        tOff.vtX;
-	  (*baseGVP).v = tVal->tiles.v;
-	  *offset = (idx * tVal->tileSz) + off;
+	  *baseGVP = WlzGreyValueTile(gVWSp, idx, offset);
+	  *offset += off;
 	}
       }
     }
@@ -1324,8 +1720,7 @@ static void	WlzGreyValueGet3DTiled(WlzGreyValueWSpace *gVWSp,
 	    size_t   	offset;
 	    WlzGreyP 	baseGVP;
 
-	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset,
-					    gVWSp->values.t,
+	    WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset, gVWSp,
 					    plane, line, kol);
 	    WlzGreyValueSetGreyP(gVWSp->gVal, gVWSp->gPtr, gVWSp->gType,
 				 baseGVP, offset);
@@ -1510,6 +1905,10 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 * \ingroup	WlzAccess
 * \brief	Gets eight grey value/pointers for the given point
 *               from the 3D values and domain in the work space.
+*               The four values of each of the two planes are found
+*               using WlzGreyValueGet2DCon() with the work space's
+*               current plane set to the plane, so that the values
+*               never depend on the previous use of the work space.
 * \param	gVWSp			Grey value work space.
 * \param	plane			Plane coordinate of point.
 * \param	line			Line coordinate of point.
@@ -1518,93 +1917,69 @@ static void	WlzGreyValueGet2DCon(WlzGreyValueWSpace *gVWSp,
 static void	WlzGreyValueGet3DCon(WlzGreyValueWSpace *gVWSp,
 				   int plane, int line, int kol)
 {
-  int		tI0,
-  		planeOff,
-		planeRel,
-		savePlane = 0;
-  WlzDomain	*domP;
-  WlzValues	*valP;
-  WlzObjectType	saveGTabType2D = WLZ_NULL;
-  WlzIntervalDomain *saveIDom2D = NULL;
-  WlzValues	saveValues2D;
-  int		planeSet[2];
-  WlzGreyP	saveGPtr[4];
-  WlzGreyV	saveGVal[4];
-
-  planeOff = 0;
-  while(planeOff < 2)
+  int		idN,
+  		idP;
+  unsigned	bkdFlag = 0;
+  WlzGreyP	gPtr[8];
+  WlzGreyV	gVal[8];
+
+  for(idP = 0; idP < 2; ++idP)
   {
-    planeSet[planeOff] = 0;
+    int		pl,
+    		plRel,
+		valSet = 0;
+
+    pl = plane + idP;
+    plRel = pl - gVWSp->domain.p->plane1;
 #ifdef WLZ_FAST_CODE
-    if((unsigned int )(plane - gVWSp->domain.p->plane1 - 1) <=
-       (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1 - 2))
+    if((unsigned )plRel <= (unsigned )(gVWSp->domain.p->lastpl -
+				       gVWSp->domain.p->plane1))
 #else
-    if((plane > gVWSp->domain.p->plane1) && (plane < gVWSp->domain.p->lastpl))
+    if((plRel >= 0) && (pl <= gVWSp->domain.p->lastpl))
 #endif
     {
-      if(plane == gVWSp->plane)
-      {
-	WlzGreyValueGet2DCon(gVWSp, line, kol);
-	planeSet[planeOff] = 1;
-      }
-      else
+      if(gVWSp->plane != pl)
       {
-	planeRel = plane - gVWSp->domain.p->plane1;
-	domP = gVWSp->domain.p->domains + planeRel;
-	valP = gVWSp->values.vox->values + planeRel;
-	if(domP && valP)
+	WlzDomain *domP;
+	WlzValues *valP;
+
+	domP = gVWSp->domain.p->domains + plRel;
+	valP = gVWSp->values.vox->values + plRel;
+	/* Check for non-NULL domain and valuetable pointers until empty
+	 * obj consistently implemented. */
+	if(domP && valP && (*domP).core && (*valP).core)
 	{
-          if(planeSet[0])
-	  {
-	    savePlane = gVWSp->plane;
-	    saveIDom2D = gVWSp->iDom2D;
-	    saveValues2D = gVWSp->values2D;
-	    saveGTabType2D = gVWSp->gTabType2D;
-	  }
-	  gVWSp->plane = plane;
+	  gVWSp->plane = pl;
 	  gVWSp->iDom2D = (*domP).i;
 	  gVWSp->values2D = (*valP);
-	  gVWSp->gTabType2D = gVWSp->gTabTypes3D[planeRel];
-	  WlzGreyValueGet2D1(gVWSp, line, kol);
-	  planeSet[planeOff] = 1;
+	  gVWSp->gTabType2D = gVWSp->gTabTypes3D[plRel];
 	}
       }
-    }
-    if(planeOff == 0)
-    {
-      if(planeSet[0])
+      if(gVWSp->plane == pl)
       {
-	tI0 = 4;
-	while(--tI0 >= 0)
-	{
-	  saveGPtr[tI0] = gVWSp->gPtr[tI0];
-	  saveGVal[tI0] = gVWSp->gVal[tI0];
-	}
-      }
-      else
-      {
-        WlzGreyValueSetBkdPN(saveGVal, saveGPtr,
-			     gVWSp->gType, gVWSp->gBkd, 4);
+	WlzGreyValueGet2DCon(gVWSp, line, kol);
+	bkdFlag |= (gVWSp->bkdFlag & 0xf) << (4 * idP);
+	valSet = 1;
       }
     }
-    ++plane;
-    ++planeOff;
-  }
-  if(planeSet[0] && planeSet[1])
-  {
-    gVWSp->plane = savePlane;
-    gVWSp->iDom2D = saveIDom2D;
-    gVWSp->values2D = saveValues2D;
-    gVWSp->gTabType2D = saveGTabType2D;
+    if(valSet == 0)
+    {
+      WlzGreyValueSetBkdPN(gVWSp->gVal, gVWSp->gPtr,
+			   gVWSp->gType, gVWSp->gBkd, 4);
+      bkdFlag |= 0xf << (4 * idP);
+    }
+    for(idN = 0; idN < 4; ++idN)
+    {
+      gPtr[(4 * idP) + idN] = gVWSp->gPtr[idN];
+      gVal[(4 * idP) + idN] = gVWSp->gVal[idN];
+    }
   }
-  tI0 = 4;
-  while(--tI0 >= 0)
+  for(idN = 0; idN < 8; ++idN)
   {
-    gVWSp->gPtr[tI0 + 4] = gVWSp->gPtr[tI0];
-    gVWSp->gPtr[tI0] = saveGPtr[tI0];
-    gVWSp->gVal[tI0 + 4] = gVWSp->gVal[tI0];
-    gVWSp->gVal[tI0] = saveGVal[tI0];
+    gVWSp->gPtr[idN] = gPtr[idN];
+    gVWSp->gVal[idN] = gVal[idN];
   }
+  gVWSp->bkdFlag = bkdFlag;
 }
 
 /*!
@@ -1635,7 +2010,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
     pl = plane + idP;
     plRel = pl - gVWSp->domain.p->plane1;
 #ifdef WLZ_FAST_CODE
-    if((unsigned int )plRel >=
+    if((unsigned int )plRel <=
        (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
 #else
     if((plRel >= 0) && (pl <= gVWSp->domain.p->lastpl))
@@ -1664,7 +2039,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 #endif
 	  {
 #ifdef WLZ_FAST_CODE
-	    if((unsigned int )(iDom->kol1 - kol - 1) <=
+	    if((unsigned int )(kol + 1 - iDom->kol1) <=
 	       (unsigned int )(iDom->lastkl - iDom->kol1 + 1))
 #else
 	    if((kol + 1 >= iDom->kol1) && (kol <= iDom->lastkl))
@@ -1698,6 +2073,7 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 		    valMsk |= ((klRel >= itv->ileft) |
 		               ((klRel < itv->iright) << 1)) << idV;
 		  }
+		  ++itv;
 		}
 	      }
 	    }
@@ -1742,12 +2118,16 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
 	  }
 	  else
 	  {
+	    WlzGreyP	tile;
+
             rPos.vtX = kol - tVal->kol1 + idK;
 	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
             tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
-            offset = *(tVal->indices + tIdx.vtX) * tVal->tileSz + tOff.vtX;
+	    tile = WlzGreyValueTile(gVWSp, *(tVal->indices + tIdx.vtX),
+	                            &offset);
+	    offset += tOff.vtX;
 	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
-	                         gVWSp->gType, tVal->tiles, offset);
+	                         gVWSp->gType, tile, offset);
 	  }
 	  ++idV;
 	}
@@ -1841,3 +2221,342 @@ static void	WlzGreyValueGetTransCon(WlzGreyValueWSpace *gVWSp,
       break;
   }
 }
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets a run of grey values along a line, starting at the
+* 		given point, for a batched grey value lookup. The interval
+* 		search starts from the interval found for the previous
+* 		point when the point is on the same line, otherwise the
+* 		line's intervals are binary searched. Values which lie
+* 		within a single interval of a rectangular or ragged
+* 		rectangle value table are read without further searching.
+* \param	gVWSp			Grey value work space.
+* \param	hint			Interval search state.
+* \param	plane			Plane coordinate of point, ignored
+* 					for 2D objects.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of the first point.
+* \param	n			Number of values required.
+* \param	val			Destination for the n values at
+* 					columns kol, kol + 1, ..., kol + n - 1.
+*/
+static void	WlzGreyValueGetHRow(WlzGreyValueWSpace *gVWSp,
+				    WlzGreyValueHint *hint,
+				    int plane, int line, int kol,
+				    int n, double *val)
+{
+  int		idV = 0;
+  WlzIntervalDomain *iDom = NULL;
+
+  if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+  {
+    iDom = gVWSp->iDom2D;
+  }
+  else
+  {
+    int		plRel;
+
+    plRel = plane - gVWSp->domain.p->plane1;
+#ifdef WLZ_FAST_CODE
+    if((unsigned int )plRel <=
+       (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
+#else
+    if((plRel >= 0) && (plane <= gVWSp->domain.p->lastpl))
+#endif
+    {
+      WlzDomain	*domP;
+
+      domP = gVWSp->domain.p->domains + plRel;
+      if(gVWSp->gTabType == WLZ_GREY_TAB_TILED)
+      {
+        iDom = (*domP).i;
+      }
+      else if(gVWSp->plane == plane)
+      {
+        iDom = gVWSp->iDom2D;
+      }
+      else
+      {
+        WlzValues *valP;
+
+	valP = gVWSp->values.vox->values + plRel;
+	if((*domP).core && (*valP).core)
+	{
+	  gVWSp->plane = plane;
+	  gVWSp->iDom2D = (*domP).i;
+	  gVWSp->values2D = (*valP);
+	  gVWSp->gTabType2D = gVWSp->gTabTypes3D[plRel];
+	  iDom = gVWSp->iDom2D;
+	}
+      }
+    }
+  }
+  if(iDom && ((line < iDom->line1) || (line > iDom->lastln)))
+  {
+    iDom = NULL;
+  }
+  while(idV < n)
+  {
+    int		k,
+    		run = 0;
+    size_t	offset = 0;
+    WlzGreyP	baseGVP;
+
+    baseGVP.v = NULL;
+    k = kol + idV;
+    if(iDom && (k >= iDom->kol1) && (k <= iDom->lastkl))
+    {
+      if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+      {
+	run = iDom->lastkl - k + 1;
+      }
+      else
+      {
+	int	idx,
+		kolRel;
+	WlzIntervalLine *itvLn;
+
+	kolRel = k - iDom->kol1;
+	itvLn = iDom->intvlines + line - iDom->line1;
+	if(itvLn->nintvs > 0)
+	{
+	  WlzInterval *itv;
+
+	  itv = itvLn->intvs;
+	  if((hint->iDom == iDom) && (hint->line == line))
+	  {
+	    idx = hint->itvIdx;
+	    while((idx > 0) && (kolRel < itv[idx].ileft))
+	    {
+	      --idx;
+	    }
+	    while((idx < itvLn->nintvs - 1) && (kolRel > itv[idx].iright))
+	    {
+	      ++idx;
+	    }
+	  }
+	  else
+	  {
+	    int	idx0,
+		idx1;
+
+	    idx0 = 0;
+	    idx1 = itvLn->nintvs - 1;
+	    while(idx0 < idx1)
+	    {
+	      idx = (idx0 + idx1) / 2;
+	      if(kolRel > itv[idx].iright)
+	      {
+		idx0 = idx + 1;
+	      }
+	      else
+	      {
+		idx1 = idx;
+	      }
+	    }
+	    idx = idx0;
+	  }
+	  hint->iDom = iDom;
+	  hint->line = line;
+	  hint->itvIdx = idx;
+	  if((kolRel >= itv[idx].ileft) && (kolRel <= itv[idx].iright))
+	  {
+	    run = itv[idx].iright - kolRel + 1;
+	  }
+	}
+      }
+    }
+    if(run > 0)
+    {
+      if(gVWSp->gTabType == WLZ_GREY_TAB_TILED)
+      {
+	if(gVWSp->objType == WLZ_2D_DOMAINOBJ)
+	{
+	  WlzGreyValueComputeGreyPTiled2D(&baseGVP, &offset, gVWSp, line, k);
+	}
+	else
+	{
+	  WlzGreyValueComputeGreyPTiled3D(&baseGVP, &offset, gVWSp,
+					  plane, line, k);
+	}
+	run = 1;
+      }
+      else
+      {
+	WlzGreyValueComputeGreyP2D(&baseGVP, &offset, gVWSp, line, k);
+	if((gVWSp->gTabType2D != WLZ_GREY_TAB_RAGR) &&
+	   (gVWSp->gTabType2D != WLZ_GREY_TAB_RECT))
+	{
+	  run = 1;
+	}
+      }
+    }
+    if(baseGVP.v == NULL)
+    {
+      baseGVP.v = &(gVWSp->gBkd);
+      val[idV++] = WlzGreyValueGreyPToD(gVWSp->gType, baseGVP, 0);
+    }
+    else
+    {
+      if(run > n - idV)
+      {
+        run = n - idV;
+      }
+      while(run-- > 0)
+      {
+	val[idV++] = WlzGreyValueGreyPToD(gVWSp->gType, baseGVP, offset++);
+      }
+    }
+  }
+}
+
+/*!
+* \return	Grey value as a double.
+* \ingroup	WlzAccess
+* \brief	Gets the grey value at the given offset from the given
+* 		grey pointer as a double.
+* \param	gType			Grey type.
+* \param	gP			Grey pointer.
+* \param	off			Offset from the grey pointer.
+*/
+static double	WlzGreyValueGreyPToD(WlzGreyType gType, WlzGreyP gP,
+				     size_t off)
+{
+  double	val = 0.0;
+
+  switch(gType)
+  {
+    case WLZ_GREY_LONG:
+      val = gP.lnp[off];
+      break;
+    case WLZ_GREY_INT:
+      val = gP.inp[off];
+      break;
+    case WLZ_GREY_SHORT:
+      val = gP.shp[off];
+      break;
+    case WLZ_GREY_UBYTE:
+      val = gP.ubp[off];
+      break;
+    case WLZ_GREY_FLOAT:
+      val = gP.flp[off];
+      break;
+    case WLZ_GREY_DOUBLE:
+      val = gP.dbp[off];
+      break;
+    case WLZ_GREY_RGBA:
+      val = gP.rgbp[off];
+      break;
+    default:
+      break;
+  }
+  return(val);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Computes the four Catmull-Rom cubic interpolation weights
+* 		for the samples at -1, 0, 1 and 2 given the fractional
+* 		position of the point between samples 0 and 1.
+* \param	w			Array for the four weights.
+* \param	t			Fractional position in [0, 1).
+*/
+static void	WlzGreyValueCubicWeights(double *w, double t)
+{
+  double	t2,
+  		t3;
+
+  t2 = t * t;
+  t3 = t2 * t;
+  w[0] = 0.5 * (-t3 + (2.0 * t2) - t);
+  w[1] = 0.5 * ((3.0 * t3) - (5.0 * t2) + 2.0);
+  w[2] = 0.5 * ((-3.0 * t3) + (4.0 * t2) + t);
+  w[3] = 0.5 * (t3 - t2);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Adds a weighted row of neighbourhood values to the
+* 		interpolation sums of WlzGreyValueGetN(). For RGBA values
+* 		each of the four channels has its own sum, otherwise
+* 		only the first sum is used.
+* \param	v			The four interpolation sums.
+* \param	rgba			Non-zero if the values are packed
+* 					RGBA values.
+* \param	n			Number of values in the row.
+* \param	wR			Weight of the row.
+* \param	wK			Weights of the values within the row.
+* \param	r			The row of n values.
+*/
+static void	WlzGreyValueAddN(double *v, int rgba, int n, double wR,
+				 double *wK, double *r)
+{
+  int		idK;
+
+  if(rgba)
+  {
+    for(idK = 0; idK < n; ++idK)
+    {
+      double	w;
+      WlzUInt	u;
+
+      w = wR * wK[idK];
+      u = (WlzUInt )(r[idK]);
+      v[0] += w * WLZ_RGBA_RED_GET(u);
+      v[1] += w * WLZ_RGBA_GREEN_GET(u);
+      v[2] += w * WLZ_RGBA_BLUE_GET(u);
+      v[3] += w * WLZ_RGBA_ALPHA_GET(u);
+    }
+  }
+  else
+  {
+    double	s = 0.0;
+
+    for(idK = 0; idK < n; ++idK)
+    {
+      s += wK[idK] * r[idK];
+    }
+    v[0] += wR * s;
+  }
+}
+
+/*!
+* \return	Interpolated value.
+* \ingroup	WlzAccess
+* \brief	Gives the interpolated value from the interpolation sums
+* 		of WlzGreyValueGetN(). For RGBA values the channel sums
+* 		are clamped to [0-255], rounded and packed.
+* \param	v			The four interpolation sums.
+* \param	rgba			Non-zero if the values are packed
+* 					RGBA values.
+*/
+static double	WlzGreyValueEndN(double *v, int rgba)
+{
+  double	d;
+
+  if(rgba)
+  {
+    int		idC;
+    int		c[4];
+    WlzUInt	u;
+
+    for(idC = 0; idC < 4; ++idC)
+    {
+      double	t;
+
+      t = WLZ_CLAMP(v[idC], 0.0, 255.0);
+      c[idC] = WLZ_NINT(t);
+    }
+    WLZ_RGBA_RGBA_SET(u, c[0], c[1], c[2], c[3]);
+    d = u;
+  }
+  else
+  {
+    d = v[0];
+  }
+  return(d);
+}
@@ -42,6 +42,9 @@ static char _WlzIntersect3d_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* function:     WlzIntersect3d    */
 /*! 
@@ -67,13 +70,13 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
 			  WlzErrorNum   *wlzErr)
 {
   /* local variables */
-  WlzObject 		**objlist, *newObj;
+  WlzObject 		*newObj;
   WlzPlaneDomain 	*pdom, *newpdom;
-  WlzVoxelValues	*voxtab, *newvoxtab;
+  WlzVoxelValues	*newvoxtab;
   WlzDomain 		*domains, domain;
   WlzValues 		*values = NULL, vals;
   WlzPixelV		bgd;
-  int 			i, p, np, min_plane, max_plane, emptyFlag;
+  int 			i, min_plane, max_plane;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* all objects have been checked by WlzIntersectN therefore do not need
@@ -154,26 +157,6 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
     return WlzMakeEmpty(wlzErr);
   }
 
-  /* allocate space for a working object array */
-  if( (objlist = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n)) == NULL){
-    if(wlzErr) {
-      *wlzErr = WLZ_ERR_MEM_ALLOC;
-    }
-    return NULL;
-  }
-  domain.core = NULL;
-  vals.core = NULL;
-  for(i=0; (i < n) && (errNum == WLZ_ERR_NONE); i++){
-    objlist[i] = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, vals, NULL, NULL,
-    			     &errNum);
-  }
-  if(errNum != WLZ_ERR_NONE) {
-    if(wlzErr) {
-      *wlzErr = errNum;
-    }
-    return NULL;
-  }
-
   /* make a new planedomain and valuetable if required */
   newpdom = WlzMakePlaneDomain(pdom->type, min_plane, max_plane, 0, 0, 0, 0,
   			       &errNum);
@@ -196,56 +179,81 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
     return NULL;
   }
 
-  /* find intersection at each plane */
-  for(p=min_plane; (p <= max_plane) && (errNum == WLZ_ERR_NONE); p++){
-    np = 0;
-    for(i=0; i < n; i++){
-      pdom = objs[i]->domain.p;
-
-      objlist[np]->domain.i = (pdom->domains)[p - pdom->plane1].i;
-      if( uvt ){
-	voxtab = objs[i]->values.vox;
-	objlist[np]->values.v = (voxtab->values)[p - voxtab->plane1].v;
-      }
-      if( objlist[np]->domain.i ){
-	np++;
-      }
-    }
+  /* find intersection at each plane, with the planes processed
+     concurrently and each thread using it's own working object array */
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    int		pp, ii;
+    WlzObject	*pObj = NULL, **pObjs = NULL;
+    WlzErrorNum	errP = WLZ_ERR_NONE;
 
-    newObj = NULL;
-    if( np == n ){
-      newObj = WlzIntersectN(np, objlist, uvt, &errNum);
-    }
-    else {
-      newObj = WlzMakeEmpty(NULL);
-    }
-    if(newObj) {
-      emptyFlag = (newObj->type == WLZ_EMPTY_OBJ);
+    if(((pObj = (WlzObject *) AlcCalloc(n, sizeof(WlzObject))) == NULL) ||
+       ((pObjs = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n)) == NULL)){
+      errP = WLZ_ERR_MEM_ALLOC;
     }
     else {
-      if(wlzErr) {
-	*wlzErr = errNum;
+      for(ii=0; ii < n; ii++){
+	pObj[ii].type = WLZ_2D_DOMAINOBJ;
       }
-      return NULL;
     }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(pp=min_plane; pp <= max_plane; pp++){
+      int		pn = 0;
+      WlzObject		*pNewObj = NULL;
+      WlzPlaneDomain	*pPDom;
 
-    if(emptyFlag){
-      domains[p - min_plane].core = NULL;
-      if( uvt ){
-	values[p - min_plane].core = NULL;
+      if( errP != WLZ_ERR_NONE ){
+	continue;
       }
-    }
-    else {
-      domains[p - min_plane] = WlzAssignDomain(newObj->domain, &errNum);
-
+      for(ii=0; ii < n; ii++){
+	pPDom = objs[ii]->domain.p;
 
+	pObjs[pn] = pObj + pn;
+	pObjs[pn]->domain.i = (pPDom->domains)[pp - pPDom->plane1].i;
+	if( uvt ){
+	  WlzVoxelValues *pVox = objs[ii]->values.vox;
+	  pObjs[pn]->values.v = (pVox->values)[pp - pVox->plane1].v;
+	}
+	if( pObjs[pn]->domain.i ){
+	  pn++;
+	}
+      }
 
+      if( pn == n ){
+	pNewObj = WlzIntersectN(pn, pObjs, uvt, &errP);
+      }
+      else {
+	pNewObj = WlzMakeEmpty(&errP);
+      }
 
-      if(uvt && (errNum == WLZ_ERR_NONE)){
-	values[p - min_plane] = WlzAssignValues(newObj->values, &errNum);
+      if( (pNewObj == NULL) || (pNewObj->type == WLZ_EMPTY_OBJ) ){
+	domains[pp - min_plane].core = NULL;
+	if( uvt ){
+	  values[pp - min_plane].core = NULL;
+	}
+      }
+      else {
+	domains[pp - min_plane] = WlzAssignDomain(pNewObj->domain, NULL);
+	if( uvt ){
+	  values[pp - min_plane] = WlzAssignValues(pNewObj->values, NULL);
+	}
+      }
+      if( pNewObj ){
+	WlzFreeObj(pNewObj);
       }
     }
-    WlzFreeObj(newObj);
+    AlcFree(pObjs);
+    AlcFree(pObj);
+    if( errP != WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp critical (WlzIntersect3d)
+#endif
+      errNum = errP;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -263,13 +271,12 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
   }
   else {
     newObj = NULL;
+    (void )WlzFreePlaneDomain(newpdom);
+    if(newvoxtab) {
+      (void )WlzFreeVoxelValueTb(newvoxtab);
+    }
   }
 
-  /* free allocated memory and return */
-  for(i=0; i < n; i++){
-    AlcFree(objlist[i]);
-  }
-  AlcFree( objlist );
   if(wlzErr) {
     *wlzErr = errNum;
   }
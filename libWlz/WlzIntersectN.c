@@ -40,12 +40,43 @@ static char _WlzIntersectN_c[] = "University of Edinburgh $Id$";
 */
 
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzIntersectNCursor
+* \ingroup	WlzBinaryOps
+* \brief	Cursor through the intervals of a single line of one of
+* 		the objects being intersected.
+* 		Typedef: ::WlzIntersectNCursor.
+*/
+typedef struct _WlzIntersectNCursor
+{
+  int		kol1;		/*!< Column offset of the intervals. */
+  int		nItv;		/*!< Number of intervals remaining. */
+  WlzInterval	*itv;		/*!< Current interval. */
+  WlzInterval	rItv;		/*!< Interval for rectangular domains. */
+} WlzIntersectNCursor;
 
 extern WlzObject *WlzIntersect3d(WlzObject	**objs,
 				 int		n,
 				 int		uvt,
 				 WlzErrorNum	 *dstErr);
 
+static int			WlzIntersectNLine(
+				  int n,
+				  WlzObject **objs,
+				  int ln,
+				  int kol1,
+				  WlzIntersectNCursor *cur,
+				  WlzInterval *dItv);
+static WlzErrorNum		WlzIntersectNIntervals(
+				  int n,
+				  WlzObject **objs,
+				  WlzIntervalDomain *iDom,
+				  WlzInterval *iItv);
+
 
 /* function:     WlzIntersectN    */
 /*! 
@@ -54,6 +85,7 @@ extern WlzObject *WlzIntersect3d(WlzObject	**objs,
  uvt=0 calculate domain only, uvt=1 calculate the mmean grey-value at
  each point. Input objects must be all non-NULL and domain objects of
  the same type i.e. either 2D or 3D otherwise an error is returned.
+ Lines (and the planes of 3D objects) are intersected concurrently.
 *
 * \return       Intersection object with grey-table as required, if the intersection is empty returns WLZ_EMPTY_OBJ, NULL on error.
 * \param    n	number of input objects
@@ -71,7 +103,7 @@ WlzObject *WlzIntersectN(
 {
   WlzObject 		*obj = NULL;
   WlzIntervalDomain 	*idom;
-  WlzInterval 		*itvl, *jtvl;
+  WlzInterval 		*itvl;
   WlzIntervalWSpace 	*iwsp;
   WlzIntervalWSpace 	*biwsp,*tiwsp,niwsp;
   WlzGreyWSpace 	*gwsp,ngwsp;
@@ -81,7 +113,7 @@ WlzObject *WlzIntersectN(
   WlzPixelV		backg;
   WlzGreyP		greyptr;
   WlzGreyV		gv;
-  int 			i, j, k, l, inttot, change, lwas, nints;
+  int 			i, k, l, inttot, nints;
   int 			line1, lastln;
   int 			kol1, lastkl;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
@@ -267,9 +299,6 @@ WlzObject *WlzIntersectN(
   }
 
   idom->freeptr = AlcFreeStackPush(idom->freeptr, (void *)itvl, NULL);
-  lwas = line1;
-  jtvl = itvl;
-  nints = 0;
   domain.i = idom;
   values.v = NULL;
   if( (obj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
@@ -297,130 +326,10 @@ WlzObject *WlzIntersectN(
   tiwsp = biwsp + n;
 
   /*
-   * Construct the intersection object's table of intervals.
-   * Initialise scanning on each object/workspace combination.
-   * Scan synchronously, setting up the intersection of
-   * overlapping intervals.  Needs a clear head !!
+   * Construct the intersection object's table of intervals, with the
+   * lines intersected concurrently.
    */
-  for (i=0; (i < n) && (errNum == WLZ_ERR_NONE); i++) {
-    errNum = WlzInitRasterScan(objs[i],iwsp,WLZ_RASTERDIR_ILIC);
-    if(errNum == WLZ_ERR_NONE) {
-      errNum = WlzNextInterval(iwsp++);
-    }
-  }
-  if(errNum != WLZ_ERR_NONE) {
-    WlzFreeObj( obj );
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-
-  l = lwas;
-  for (;;) {
-    /*
-     * find next line of intersection
-     */
-    do {
-      change = 0;
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	if (iwsp->linpos > l) {
-	  l = iwsp->linpos;
-        }
-      }
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	while (iwsp->linpos < l) {
-	  if ((errNum = WlzNextInterval(iwsp)) != WLZ_ERR_NONE) {
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	    goto firstfinished;
-	  }
-	  if (iwsp->linpos > l) {
-	    change = 1;
-	  }
-	}
-      }
-    } while (change != 0);
-    /*
-     * find next interval of intersection
-     */
-    kol1 = biwsp->lftpos;
-    lastkl = biwsp->rgtpos;
-    while(errNum == WLZ_ERR_NONE) {
-      do {
-	change = 0;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++)
-	  if (iwsp->lftpos > lastkl) {
-	    kol1 = iwsp->lftpos;
-	    lastkl = iwsp->rgtpos;
-	  } else if (iwsp->lftpos > kol1)
-	    kol1 = iwsp->lftpos;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	  while (iwsp->rgtpos < kol1) {
-	    if ((errNum = WlzNextInterval(iwsp)) != WLZ_ERR_NONE) {
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	      goto firstfinished;
-	    }
-	    if (iwsp->linpos != l) {
-	      l = iwsp->linpos;
-	      goto jumpline;
-	    }
-	    if (iwsp->lftpos > kol1)
-	      change = 1;
-	  }
-	}
-      } while ((change != 0) && (errNum == WLZ_ERR_NONE));
-      if(errNum == WLZ_ERR_NONE)
-      {
-	for (iwsp=biwsp; iwsp < tiwsp; iwsp++) {
-	  if (iwsp->rgtpos <= lastkl) {
-	    lastkl = iwsp->rgtpos;
-	  }
-	}
-	if (lastkl >= kol1) {
-	  itvl->ileft = kol1 - idom->kol1;
-	  itvl->iright = lastkl - idom->kol1;
-	  if (l == lwas) {
-	    nints++;
-	  } else {
-	    errNum = WlzMakeInterval(lwas,idom,nints,jtvl);
-	    for (j = lwas+1; (j < l) && (errNum == WLZ_ERR_NONE); j++) {
-	      errNum = WlzMakeInterval(j,idom,0,NULL);
-	    }
-	    if(errNum == WLZ_ERR_NONE) {
-	      lwas = l;
-	      nints = 1;
-	      jtvl = itvl;
-	    }
-	  }
-	  itvl++;
-	}
-	kol1 = lastkl+1;
-      }
-    }
-
-  jumpline:
-    ;
-  }
-
-firstfinished:
-  if(errNum != WLZ_ERR_NONE) {
-    WlzFreeObj(obj);
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-
-  errNum = WlzMakeInterval(lwas,idom,nints,jtvl);
-  for (j = lwas+1; (j <= lastln) && (errNum == WLZ_ERR_NONE); j++) {
-    errNum = WlzMakeInterval(j,idom,0,NULL);
-  }
+  errNum = WlzIntersectNIntervals(n, objs, idom, itvl);
   if(errNum != WLZ_ERR_NONE)
   {
     WlzFreeObj(obj);
@@ -650,3 +559,230 @@ firstfinished:
   }
   return obj;
 }
+
+/*!
+* \return	Number of intervals in the intersection of the line.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the intersection of a single line of the given
+* 		objects. A candidate column is leapfrogged through the
+* 		objects, each of which skips intervals which end before
+* 		it, until it lies within an interval of every object.
+* 		The intersection interval then extends to the first end
+* 		of these intervals. The cost is proportional to the
+* 		number of objects for each intersection interval plus the
+* 		number of intervals skipped. The intersection stops as
+* 		soon as the intervals of any object are exhausted.
+* \param	n			Number of objects.
+* \param	objs			The 2D domain objects.
+* \param	ln			The line.
+* \param	kol1			First column of the intersection
+* 					domain.
+* \param	cur			Workspace for n cursors.
+* \param	dItv			Destination for the intervals of the
+* 					line with columns relative to kol1,
+* 					which must have space for the
+* 					number of intervals in the line
+* 					of all the objects.
+*/
+static int			WlzIntersectNLine(
+				  int n,
+				  WlzObject **objs,
+				  int ln,
+				  int kol1,
+				  WlzIntersectNCursor *cur,
+				  WlzInterval *dItv)
+{
+  int		i,
+		x,
+  		nAgree = 0,
+		nD = 0;
+
+  for(i = 0; i < n; ++i)
+  {
+    WlzIntervalDomain *iDom;
+    WlzIntersectNCursor *c;
+
+    c = cur + i;
+    iDom = objs[i]->domain.i;
+    c->kol1 = iDom->kol1;
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      c->nItv = 1;
+      c->rItv.ileft = 0;
+      c->rItv.iright = iDom->lastkl - iDom->kol1;
+      c->itv = &(c->rItv);
+    }
+    else
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + ln - iDom->line1;
+      c->nItv = iLn->nintvs;
+      c->itv = iLn->intvs;
+    }
+    if(c->nItv < 1)
+    {
+      return(0);
+    }
+  }
+  x = cur[0].itv->ileft + cur[0].kol1;
+  i = 0;
+  for(;;)
+  {
+    WlzIntersectNCursor *c;
+
+    c = cur + i;
+    while(c->itv->iright + c->kol1 < x)
+    {
+      ++(c->itv);
+      if(--(c->nItv) == 0)
+      {
+        return(nD);
+      }
+    }
+    if(c->itv->ileft + c->kol1 > x)
+    {
+      x = c->itv->ileft + c->kol1;
+      nAgree = 1;
+    }
+    else if(++nAgree == n)
+    {
+      int	j,
+      		rgt;
+
+      /* Column x is within an interval of every object. */
+      rgt = cur[0].itv->iright + cur[0].kol1;
+      for(j = 1; j < n; ++j)
+      {
+        int	r;
+
+	r = cur[j].itv->iright + cur[j].kol1;
+	if(r < rgt)
+	{
+	  rgt = r;
+	}
+      }
+      dItv[nD].ileft = x - kol1;
+      dItv[nD].iright = rgt - kol1;
+      ++nD;
+      x = rgt + 1;
+      nAgree = 0;
+    }
+    i = (i + 1 < n)? i + 1: 0;
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Sets the intervals of the given intersection interval
+* 		domain from the intersection of the given objects. Space
+* 		for the intervals of each line is reserved in the given
+* 		interval buffer using the number of intervals in the line
+* 		of all the objects, so that the lines may be intersected
+* 		concurrently without further allocation.
+* \param	n			Number of objects.
+* \param	objs			The non-empty 2D domain objects, each
+* 					of which must cover all the lines
+* 					of the intersection domain.
+* \param	iDom			The intersection interval domain with
+* 					it's line and column bounds set.
+* \param	iItv			Interval buffer with space for all
+* 					the intervals of the objects.
+*/
+static WlzErrorNum		WlzIntersectNIntervals(
+				  int n,
+				  WlzObject **objs,
+				  WlzIntervalDomain *iDom,
+				  WlzInterval *iItv)
+{
+  int		i,
+  		nLn;
+  int		*lnOff = NULL,
+  		*lnCnt = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nLn = iDom->lastln - iDom->line1 + 1;
+  if((lnOff = (int *)AlcCalloc((2 * nLn) + 1, sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    lnCnt = lnOff + nLn + 1;
+    for(i = 0; (i < n) && (errNum == WLZ_ERR_NONE); ++i)
+    {
+      int	l,
+      		o;
+      WlzIntervalDomain *oDom;
+
+      oDom = objs[i]->domain.i;
+      o = iDom->line1 - oDom->line1;
+      switch(oDom->type)
+      {
+        case WLZ_INTERVALDOMAIN_INTVL:
+	  for(l = 0; l < nLn; ++l)
+	  {
+	    lnOff[l + 1] += oDom->intvlines[o + l].nintvs;
+	  }
+	  break;
+	case WLZ_INTERVALDOMAIN_RECT:
+	  for(l = 0; l < nLn; ++l)
+	  {
+	    lnOff[l + 1] += 1;
+	  }
+	  break;
+	default:
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	  break;
+      }
+    }
+    for(i = 0; i < nLn; ++i)
+    {
+      lnOff[i + 1] += lnOff[i];
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	idL;
+      WlzIntersectNCursor *cur = NULL;
+      WlzErrorNum errT = WLZ_ERR_NONE;
+
+      if((cur = (WlzIntersectNCursor *)
+                AlcMalloc(n * sizeof(WlzIntersectNCursor))) == NULL)
+      {
+        errT = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idL = 0; idL < nLn; ++idL)
+      {
+	if(errT == WLZ_ERR_NONE)
+	{
+	  lnCnt[idL] = WlzIntersectNLine(n, objs, iDom->line1 + idL,
+	  				 iDom->kol1, cur, iItv + lnOff[idL]);
+	}
+      }
+      AlcFree(cur);
+      if(errT != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzIntersectNIntervals)
+#endif
+	errNum = errT;
+      }
+    }
+  }
+  for(i = 0; (i < nLn) && (errNum == WLZ_ERR_NONE); ++i)
+  {
+    errNum = WlzMakeInterval(iDom->line1 + i, iDom, lnCnt[i],
+			     (lnCnt[i] > 0)? iItv + lnOff[i]: NULL);
+  }
+  AlcFree(lnOff);
+  return(errNum);
+}
@@ -40,8 +40,20 @@ static char _WlzLabel_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <Wlz.h>
 
+/*!
+* \def		WLZ_LABEL_BAND_MINLN
+* \ingroup	WlzBinaryOps
+* \brief	Minimum number of lines in each of the bands which are
+* 		labeled concurrently, objects with fewer lines are labeled
+* 		using the sequential algorithm.
+*/
+#define WLZ_LABEL_BAND_MINLN	(16)
+
 /*
  * The allocation list contains the interval end-points of the intervals of
  * the current and previous lines.  Its length therefore needs to be twice the
@@ -73,6 +85,23 @@ typedef struct _WlzAllocChunk {
   WlzLLink *chunk_base;
 } WlzAllocChunk;
 
+/*
+ * A labeled component used by the concurrent labeling: Its line and column
+ * bounds, number of intervals, rank in the returned objects array (or -1
+ * if not yet ranked and -2 if ignored), offset into the component ordered
+ * interval index array and count of intervals placed in that array.
+ */
+typedef struct _WlzLabelCmp {
+  int ln0;
+  int ln1;
+  int kl0;
+  int kl1;
+  int nItv;
+  int rank;
+  int off;
+  int fill;
+} WlzLabelCmp;
+
 static int 			mintcount(
 				  WlzIntervalDomain *idom,
 				  int *maxinline);
@@ -122,13 +151,37 @@ static WlzLLink 		*newchain2(
 				  WlzLLink *chainbase,
 				  int entry1,
 				  int entry2);
+static WlzErrorNum		WlzLabelBands2D(
+				  WlzObject *obj,
+				  int *mm,
+				  WlzObject **objlist,
+				  int maxNumObjs,
+				  int ignlns,
+				  int jdqt,
+				  int nBand);
+static void			WlzLabelBandLnUnion(
+				  AlcUFTree *uft,
+				  WlzInterval *itv,
+				  int i0,
+				  int i1,
+				  int j0,
+				  int j1,
+				  int dist,
+				  int *nod,
+				  int offI,
+				  int offJ);
 
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzBinaryOps
 * \brief	Segments a domain into connected parts. Connectivity is
 * 		defined by the connect parameter and can be 4- or 8-connected
-* 		for 2D objects and 6-, 18- or 26-connected for 3D objects. Note
+* 		for 2D objects and 6-, 18- or 26-connected for 3D objects.
+* 		When more than one thread is available 2D objects are
+* 		split into bands of lines which are labeled concurrently,
+* 		with the components of neighbouring bands then being merged.
+* 		The objects are returned in the same order by both the
+* 		sequential and concurrent algorithms. Note
 * 		this version requires that there is sufficient space in the
 * 		objects array defined by maxNumObjs and this is not extended.
 * 		This should be changed in future so that the array is extended
@@ -287,6 +340,24 @@ WlzErrorNum 			WlzLabel(
     default:
       return(WLZ_ERR_PARAM_DATA);
   }
+  /* Use the concurrent labeling if more than one thread is available
+   * and the object is big enough. */
+#ifdef _OPENMP
+  if(!omp_in_parallel())
+  {
+    int		nBand,
+    		nLn;
+
+    nBand = omp_get_max_threads();
+    nLn = obj->domain.i->lastln - obj->domain.i->line1 + 1;
+    nBand = WLZ_MIN(nBand, nLn / WLZ_LABEL_BAND_MINLN);
+    if(nBand > 1)
+    {
+      return(WlzLabelBands2D(obj, mm, objlist, maxNumObjs, ignlns,
+      			     jdqt, nBand));
+    }
+  }
+#endif
   /*
    * Allocate and initialise the working spaces.
    *
@@ -623,6 +694,468 @@ LOOPEND:
 } 
 
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Labels a 2D domain object with an interval domain by
+* 		splitting it into bands of lines, labeling the bands
+* 		concurrently and then merging the components which
+* 		connect across the band boundaries using union-find
+* 		trees. The objects are returned in the same order as
+* 		by the sequential labeling of WlzLabel(), which is that
+* 		in which the objects are completed when the lines are
+* 		scanned in order: By last line and then by the column
+* 		of the first interval in that line.
+* \param	obj			Given 2D domain object with an
+* 					interval domain.
+* \param	mm			Destination pointer for the
+* 					number of objects.
+* \param	objlist			Array for the objects.
+* \param	maxNumObjs		Maximum number of objects.
+* \param	ignlns			Ignore objects with num lines <=
+* 					ignlns.
+* \param	jdqt			One for 4-connected, zero for
+* 					8-connected.
+* \param	nBand			Number of bands, must be greater than
+* 					one and not more than the number of
+* 					lines.
+*/
+static WlzErrorNum WlzLabelBands2D(WlzObject *obj, int *mm,
+				   WlzObject **objlist, int maxNumObjs,
+				   int ignlns, int jdqt, int nBand)
+{
+  int		idB,
+		idC,
+		idI,
+		idL,
+		nLn,
+		dist,
+		nRank = 0,
+		nSCmp = 0,
+		nCmp = 0,
+		nItv = 0;
+  int		*lnOff = NULL,
+		*itvLn = NULL,
+		*lbl = NULL,
+		*bndLn = NULL,
+		*bndOff = NULL,
+		*cmpId = NULL,
+		*ord = NULL;
+  WlzErrorNum	*bndErr = NULL;
+  WlzInterval	*itv = NULL;
+  WlzLabelCmp	*cmp = NULL;
+  AlcUFTree	*sUft = NULL;
+  WlzIntervalDomain *idom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  *mm = 0;
+  idom = obj->domain.i;
+  nLn = idom->lastln - idom->line1 + 1;
+  dist = 1 - jdqt;
+  if(objlist == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if(((lnOff = (int *)AlcMalloc((nLn + 1) * sizeof(int))) == NULL) ||
+          ((bndLn = (int *)AlcMalloc((nBand + 1) * sizeof(int))) == NULL) ||
+          ((bndOff = (int *)AlcMalloc((nBand + 1) * sizeof(int))) == NULL) ||
+          ((bndErr = (WlzErrorNum *)
+	             AlcMalloc(nBand * sizeof(WlzErrorNum))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Gather the intervals, with their absolute columns, in line order. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      lnOff[idL] = nItv;
+      nItv += idom->intvlines[idL].nintvs;
+    }
+    lnOff[nLn] = nItv;
+    if(nItv > 0)
+    {
+      if(((itv = (WlzInterval *)
+                 AlcMalloc(nItv * sizeof(WlzInterval))) == NULL) ||
+	 ((itvLn = (int *)AlcMalloc(nItv * sizeof(int))) == NULL) ||
+	 ((lbl = (int *)AlcMalloc(nItv * sizeof(int))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      int	n;
+      WlzInterval *iP;
+
+      iP = idom->intvlines[idL].intvs;
+      n = idom->intvlines[idL].nintvs;
+      for(idI = 0; idI < n; ++idI)
+      {
+	itv[lnOff[idL] + idI].ileft = iP[idI].ileft + idom->kol1;
+	itv[lnOff[idL] + idI].iright = iP[idI].iright + idom->kol1;
+	itvLn[lnOff[idL] + idI] = idom->line1 + idL;
+      }
+    }
+    /* Split the lines into bands with similar numbers of intervals. */
+    bndLn[0] = 0;
+    for(idB = 1; idB < nBand; ++idB)
+    {
+      int	tgt;
+
+      tgt = (int )(((long long )nItv * idB) / nBand);
+      idL = bndLn[idB - 1] + 1;
+      while((idL < nLn - (nBand - idB)) && (lnOff[idL] < tgt))
+      {
+        ++idL;
+      }
+      bndLn[idB] = idL;
+    }
+    bndLn[nBand] = nLn;
+    /* Label each band independently, giving each interval the index of
+     * it's component within the band. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nBand)
+#endif
+    for(idB = 0; idB < nBand; ++idB)
+    {
+      int	i,
+		l,
+		i0,
+		i1,
+		n = 0;
+      AlcUFTree	*uft = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      i0 = lnOff[bndLn[idB]];
+      i1 = lnOff[bndLn[idB + 1]];
+      if(i1 > i0)
+      {
+	if((uft = AlcUFTreeNew(i1 - i0, i1 - i0)) == NULL)
+	{
+	  errNum2 = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  for(l = bndLn[idB] + 1; l < bndLn[idB + 1]; ++l)
+	  {
+	    WlzLabelBandLnUnion(uft, itv, lnOff[l - 1], lnOff[l],
+				lnOff[l], lnOff[l + 1], dist, NULL, i0, i0);
+	  }
+	  for(i = i0; i < i1; ++i)
+	  {
+	    if(uft->pr[i - i0] == i - i0)
+	    {
+	      lbl[i] = n++;
+	    }
+	  }
+	  for(i = i0; i < i1; ++i)
+	  {
+	    lbl[i] = lbl[i0 + AlcUFTreeFind(uft, i - i0)];
+	  }
+	  AlcUFTreeFree(uft);
+	}
+      }
+      bndOff[idB] = n;
+      bndErr[idB] = errNum2;
+    }
+    for(idB = 0; idB < nBand; ++idB)
+    {
+      int	n;
+
+      if(bndErr[idB] != WLZ_ERR_NONE)
+      {
+        errNum = bndErr[idB];
+      }
+      n = bndOff[idB];
+      bndOff[idB] = nSCmp;
+      nSCmp += n;
+    }
+    bndOff[nBand] = nSCmp;
+  }
+  /* Merge the band components which connect across the band boundaries
+   * and then give each interval it's component index. */
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    if(((sUft = AlcUFTreeNew(nSCmp, nSCmp)) == NULL) ||
+       ((cmpId = (int *)AlcMalloc(nSCmp * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    for(idB = 1; idB < nBand; ++idB)
+    {
+      idL = bndLn[idB];
+      WlzLabelBandLnUnion(sUft, itv, lnOff[idL - 1], lnOff[idL],
+      			  lnOff[idL], lnOff[idL + 1], dist, lbl,
+			  bndOff[idB - 1], bndOff[idB]);
+    }
+    for(idC = 0; idC < nSCmp; ++idC)
+    {
+      if(sUft->pr[idC] == idC)
+      {
+        cmpId[idC] = nCmp++;
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nBand)
+#endif
+    for(idB = 0; idB < nBand; ++idB)
+    {
+      int	i;
+
+      for(i = lnOff[bndLn[idB]]; i < lnOff[bndLn[idB + 1]]; ++i)
+      {
+        lbl[i] = cmpId[AlcUFTreeFind(sUft, bndOff[idB] + lbl[i])];
+      }
+    }
+    if((cmp = (WlzLabelCmp *)AlcCalloc(nCmp, sizeof(WlzLabelCmp))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Find the bounds of the components and then rank them in the order
+   * in which they are completed. */
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    int		nOrd = 0;
+
+    for(idI = 0; idI < nItv; ++idI)
+    {
+      WlzLabelCmp *c;
+
+      c = cmp + lbl[idI];
+      if(c->nItv == 0)
+      {
+        c->ln0 = itvLn[idI];
+	c->kl0 = itv[idI].ileft;
+	c->kl1 = itv[idI].iright;
+	c->rank = -1;
+      }
+      else
+      {
+        c->kl0 = WLZ_MIN(c->kl0, itv[idI].ileft);
+        c->kl1 = WLZ_MAX(c->kl1, itv[idI].iright);
+      }
+      c->ln1 = itvLn[idI];
+      ++(c->nItv);
+    }
+    for(idI = 0; idI < nItv; ++idI)
+    {
+      WlzLabelCmp *c;
+
+      c = cmp + lbl[idI];
+      if((c->rank == -1) && (itvLn[idI] == c->ln1))
+      {
+	if((c->ln1 - c->ln0 < ignlns) || (c->kl1 - c->kl0 < ignlns))
+	{
+	  c->rank = -2;
+	}
+	else if(nRank >= maxNumObjs)
+	{
+	  c->rank = -2;
+	  errNum = WLZ_ERR_PARAM_DATA;
+	}
+	else
+	{
+	  c->rank = nRank++;
+	  c->off = nOrd;
+	  nOrd += c->nItv;
+	}
+      }
+    }
+    if((nOrd > 0) && ((ord = (int *)AlcMalloc(nOrd * sizeof(int))) == NULL))
+    {
+      nRank = 0;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Make the objects concurrently, with the intervals of each in line
+   * order. */
+  if(nRank > 0)
+  {
+    WlzValues	values;
+    WlzErrorNum errNum3 = WLZ_ERR_NONE;
+
+    values.v = obj->values.v;
+    for(idI = 0; idI < nItv; ++idI)
+    {
+      WlzLabelCmp *c;
+
+      c = cmp + lbl[idI];
+      if(c->rank >= 0)
+      {
+        ord[c->off + c->fill++] = idI;
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+    for(idC = 0; idC < nCmp; ++idC)
+    {
+      WlzLabelCmp *c;
+
+      c = cmp + idC;
+      if(c->rank >= 0)
+      {
+	int	i,
+		i0;
+	WlzDomain domain;
+	WlzInterval *cItv = NULL;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	objlist[c->rank] = NULL;
+	domain.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+					 c->ln0, c->ln1, c->kl0, c->kl1,
+					 &errNum2);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  if((cItv = (WlzInterval *)
+	             AlcMalloc(c->nItv * sizeof(WlzInterval))) == NULL)
+	  {
+	    (void )WlzFreeIntervalDomain(domain.i);
+	    errNum2 = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    domain.i->freeptr = AlcFreeStackPush(domain.i->freeptr,
+	                                         (void *)cItv, NULL);
+	  }
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  i0 = 0;
+	  for(i = 0; i < c->nItv; ++i)
+	  {
+	    int	j;
+
+	    j = ord[c->off + i];
+	    cItv[i].ileft = itv[j].ileft - c->kl0;
+	    cItv[i].iright = itv[j].iright - c->kl0;
+	    if((i + 1 == c->nItv) || (itvLn[ord[c->off + i + 1]] != itvLn[j]))
+	    {
+	      (void )WlzMakeInterval(itvLn[j], domain.i, i + 1 - i0,
+	      			     cItv + i0);
+	      i0 = i + 1;
+	    }
+	  }
+	  objlist[c->rank] = WlzAssignObject(
+	  		     WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, values,
+			     		 NULL, obj, &errNum2), NULL);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+	    (void )WlzFreeIntervalDomain(domain.i);
+	  }
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzLabelBands2D)
+	  {
+#endif
+	    errNum3 = errNum2;
+#ifdef _OPENMP
+	  }
+#endif
+	}
+      }
+    }
+    if(errNum3 == WLZ_ERR_NONE)
+    {
+      *mm = nRank;
+    }
+    else
+    {
+      for(idI = 0; idI < nRank; ++idI)
+      {
+        (void )WlzFreeObj(objlist[idI]);
+      }
+      errNum = errNum3;
+    }
+  }
+  AlcUFTreeFree(sUft);
+  AlcFree(lnOff);
+  AlcFree(bndLn);
+  AlcFree(bndOff);
+  AlcFree(bndErr);
+  AlcFree(itv);
+  AlcFree(itvLn);
+  AlcFree(lbl);
+  AlcFree(cmpId);
+  AlcFree(cmp);
+  AlcFree(ord);
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Forms the union of the union-find tree nodes of all
+* 		intervals in one line which connect to intervals in the
+* 		next line. Connecting intervals are found by a single
+* 		sweep through both lines.
+* \param	uft			Union-find tree.
+* \param	itv			Intervals with absolute columns.
+* \param	i0			Index of the first interval in the
+* 					first line.
+* \param	i1			One more than the index of the last
+* 					interval in the first line.
+* \param	j0			Index of the first interval in the
+* 					second line.
+* \param	j1			One more than the index of the last
+* 					interval in the second line.
+* \param	dist			Column distance at which intervals
+* 					are connected, one for 8-connected
+* 					and zero for 4-connected.
+* \param	nod			If non-NULL the tree node of each
+* 					interval relative to the offsets,
+* 					if NULL the tree node of each
+* 					interval is it's index less the
+* 					offset.
+* \param	offI			Node offset for the first line.
+* \param	offJ			Node offset for the second line.
+*/
+static void			WlzLabelBandLnUnion(
+				  AlcUFTree *uft,
+				  WlzInterval *itv,
+				  int i0,
+				  int i1,
+				  int j0,
+				  int j1,
+				  int dist,
+				  int *nod,
+				  int offI,
+				  int offJ)
+{
+  int		i,
+  		j,
+		k;
+
+  k = j0;
+  for(i = i0; i < i1; ++i)
+  {
+    while((k < j1) && (itv[k].iright + dist < itv[i].ileft))
+    {
+      ++k;
+    }
+    for(j = k; (j < j1) && (itv[j].ileft <= itv[i].iright + dist); ++j)
+    {
+      if(nod)
+      {
+        AlcUFTreeUnion(uft, offI + nod[i], offJ + nod[j]);
+      }
+      else
+      {
+        AlcUFTreeUnion(uft, i - offI, j - offJ);
+      }
+    }
+  }
+}
+
 /*
  * make a new chain: extract a link from the free-list pointed to by
  * "chainbase", link it to itself, add appropriate entries.
@@ -45,12 +45,68 @@ static char _WlzLabel3D_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+/*!
+* \struct	_WlzLabel3DItv
+* \ingroup	WlzBinaryOps
+* \brief	An interval of a fragment (2D labeled object) within a
+* 		plane.
+* 		Typedef: ::WlzLabel3DItv.
+*/
+typedef struct _WlzLabel3DItv
+{
+  int		kl0;			/*!< First column of the interval. */
+  int		kl1;			/*!< Last column of the interval. */
+  int		frg;			/*!< Fragment index within the plane. */
+} WlzLabel3DItv;
+
+/*!
+* \struct	_WlzLabel3DPln
+* \ingroup	WlzBinaryOps
+* \brief	The intervals of all the fragments within a plane sorted
+* 		by line and then column.
+* 		Typedef: ::WlzLabel3DPln.
+*/
+typedef struct _WlzLabel3DPln
+{
+  int		line1;			/*!< First line. */
+  int		nLn;			/*!< Number of lines. */
+  int		*lnOff;			/*!< Offsets into the intervals for
+  					     each line and the last line + 1. */
+  WlzLabel3DItv	*itv;			/*!< The sorted intervals. */
+} WlzLabel3DPln;
+
+static int			WlzLabel3DItvCmp(
+				  const void *p0,
+				  const void *p1);
+static int			WlzLabel3DPairCmp(
+				  const void *p0,
+				  const void *p1);
+static void			WlzLabel3DPlnFree(
+				  WlzLabel3DPln *pln);
+static WlzErrorNum		WlzLabel3DPlnMake(
+				  WlzLabel3DPln *pln,
+				  int nFrg,
+				  WlzObject **frg);
+static WlzErrorNum		WlzLabel3DPlnPairs(
+				  int *dstNPair,
+				  int **dstPair,
+				  WlzLabel3DPln *plnP,
+				  WlzLabel3DPln *plnQ,
+				  int dist);
+
 /*!
 * \return	A compund array object containing the labeled object
 * 		components of the given object.
 * \ingroup	WlzBinaryOps
 * \brief	Labels (segments) a 3D domain object into connected component
 * 		objects using their connectivity. 
+* 		The planes are labeled concurrently, then the connectivity
+* 		of the 2D fragments in adjacent planes is found concurrently
+* 		by sweeping through their intervals, with the fragments
+* 		being merged into 3D objects using a union-find tree.
+* 		The union-find tree is always built in the same order so
+* 		that the order of the labeled objects does not depend on
+* 		the number of threads.
 * \param	gObj		Given object to be labeled.
 * \param	maxObj		Maximum number of objects to be found in any
 * 				plane.
@@ -68,19 +124,13 @@ WlzObject			*WlzLabel3D(
 {
   int		nPln,		/* Number of planes in the input object. */
   		nObjs = 0,	/* Number of 3D objects found by labeling. */
-		totNFrg = 0,	/* Total number of 2D fragment objects found
+		totNFrg = 0;	/* Total number of 2D fragment objects found
 				 * by labeling the planes. */
-		maxFrgPln = 0;  /* Maximum number of 2D fragment objects in
-				 * any plane. */
-  size_t	objBufSz = 0;
   WlzObject	*lObj = NULL;	/* The return compound object. */
   WlzConnectType con2 = WLZ_0_CONNECTED,
   		 con3 = WLZ_0_CONNECTED;
   AlcUFTree	*uft = NULL;	/* Union-find tree for grouping the framents
   				 * into 3D objects. */
-  WlzObject	**frgObjBuf = NULL; /* Buffer big enough for all the fragment
-  				     * objects of any single plane for each
-				     * thread. */
   WlzObject	***frgTbl = NULL; /* Objects in each plane, indexed by plane
   				   * then fragment within plane. */
   int		*nFrgTbl = NULL, /* Table of the number of fragments per plane,
@@ -221,10 +271,6 @@ WlzObject			*WlzLabel3D(
 
       nFrg = nFrgTbl[p];
       cNFrgTbl[p] = totNFrg;
-      if(nFrg > maxFrgPln)
-      {
-	maxFrgPln = nFrg;
-      }
       totNFrg += nFrg;
     }
   }
@@ -251,16 +297,21 @@ WlzObject			*WlzLabel3D(
 	  break;
 	}
       }
+      nObjs = 1;
       dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
 				 gObj->domain.p->plane1 + p,
-				 gObj->domain.p->lastpl + p,
+				 gObj->domain.p->plane1 + p,
 				 obj2->domain.i->line1,
 				 obj2->domain.i->lastln,
 				 obj2->domain.i->kol1,
 				 obj2->domain.i->lastkl,
 				 &errNum);
-      objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, 1, NULL,
-				  WLZ_3D_DOMAINOBJ, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        *(dom.p->domains) = WlzAssignDomain(obj2->domain, NULL);
+	objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, 1, NULL,
+				    WLZ_3D_DOMAINOBJ, &errNum);
+      }
       if(errNum == WLZ_ERR_NONE)
       {
         objs->n = 1;
@@ -280,97 +331,109 @@ WlzObject			*WlzLabel3D(
 	  errNum = WLZ_ERR_MEM_ALLOC;
 	}
       }
-      /* Walk down through the planes checking for conectivity between
-       * the fragments of the current plane and the previous plane updating
-       * the union-find tree to build the connectivity. */
+      /* Find the connectivity between the fragments of each plane and
+       * those of the previous plane, concurrently, by sweeping through
+       * their intervals. Then update the union-find tree with the pairs
+       * of connected fragments, always in the same order. */
       if(errNum == WLZ_ERR_NONE)
       {
-	int		p;		/* Current plane */
+	int		p,		/* Current plane */
+			dist;
+	int		*nPairTbl = NULL, /* Number of connected fragment pairs
+					   * for each plane. */
+			**pairTbl = NULL; /* Connected fragment pairs for each
+					   * plane. */
+	WlzLabel3DPln	*plnTbl = NULL;	/* Fragment intervals of each plane. */
 
+	dist = (con3 == WLZ_0_CONNECTED)? 0: 1;
+	if(((plnTbl = (WlzLabel3DPln *)
+	              AlcCalloc(nPln, sizeof(WlzLabel3DPln))) == NULL) ||
+	   ((nPairTbl = (int *)AlcCalloc(nPln, sizeof(int))) == NULL) ||
+	   ((pairTbl = (int **)AlcCalloc(nPln, sizeof(int *))) == NULL))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
 #ifdef _OPENMP
-#pragma omp parallel for shared(nFrgTbl,cNFrgTbl,con3,uft)
+#pragma omp parallel for schedule(dynamic)
 #endif
-	for(p = 1; p < nPln; ++p)
-	{
-
-	  if(errNum == WLZ_ERR_NONE)
+	  for(p = 0; p < nPln; ++p)
 	  {
-	    int	q,		/* Previous plane. */
-		    nFrgP,	/* Number of fgragment objects on plane p */
-		    nFrgQ; 	/* Number of fgragment objects on plane q */
-	    WlzErrorNum errNum2 = WLZ_ERR_NONE;
+	    WlzErrorNum errNum2;
 
-	    q = p - 1;
-	    nFrgP = nFrgTbl[p];
-	    nFrgQ = nFrgTbl[q];
-	    if((nFrgP > 0) && (nFrgQ > 0))
+	    errNum2 = WlzLabel3DPlnMake(plnTbl + p, nFrgTbl[p], frgTbl[p]);
+	    if(errNum2 != WLZ_ERR_NONE)
 	    {
-	      int	  fP;	/* Fragment within the current plane p */
-	      WlzObject **frgP,	/* Array of fragment objects on plane p */
-			**frgQ;	/* Array of fragment objects on plane q */
-
-	      frgP = frgTbl[p];
-	      frgQ = frgTbl[q];
-	      for(fP = 0; (errNum2 == WLZ_ERR_NONE) && (fP < nFrgP); ++fP)
-	      {
-		int	fQ;
-		WlzObject *fObjP;
-
-		if(con3 == WLZ_0_CONNECTED)
-		{
-		  fObjP = WlzAssignObject(frgP[fP], NULL);
-		}
-		else
-		{
-		  fObjP = WlzDilation(frgP[fP], con3, &errNum2);
-		}
-		if((fObjP != NULL) &&
-		   (fObjP->type == WLZ_2D_DOMAINOBJ) &&
-		   (fObjP->domain.core != NULL))
-		{
-		  for(fQ = 0; (errNum2 == WLZ_ERR_NONE) && (fQ < nFrgQ); ++fQ)
-		  {
-		    WlzObject *fObjQ;
-
-		     fObjQ = frgQ[fQ];
-		    /* Avoid calling WlzHasIntersection() if possible, saves
-		     * a significant amount of CPU time. */
-		    if((fObjQ != NULL) &&
-		       (fObjQ->type == WLZ_2D_DOMAINOBJ) &&
-		       (fObjQ->domain.core != NULL) &&
-		       (fObjP->domain.i->kol1 < fObjQ->domain.i->lastkl) &&
-		       (fObjQ->domain.i->kol1 < fObjP->domain.i->lastkl) &&
-		       (fObjP->domain.i->line1 < fObjQ->domain.i->lastln) &&
-		       (fObjQ->domain.i->line1 < fObjP->domain.i->lastln) &&
-		       WlzHasIntersection(fObjQ, fObjP, &errNum2))
-		    {
 #ifdef _OPENMP
 #pragma omp critical
-		      {
+	      {
 #endif
-			AlcUFTreeUnion(uft, cNFrgTbl[q] + fQ, cNFrgTbl[p] + fP);
+		errNum = errNum2;
 #ifdef _OPENMP
-		      }
-#endif
-		    }
-		  }
-		}
-		(void )WlzFreeObj(fObjP);
 	      }
+#endif
 	    }
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
 #ifdef _OPENMP
-#pragma omp critical
-	    {
+#pragma omp parallel for schedule(dynamic)
 #endif
-	      if((errNum == WLZ_ERR_NONE) && (errNum2 != WLZ_ERR_NONE))
+	  for(p = 1; p < nPln; ++p)
+	  {
+	    WlzErrorNum errNum2;
+
+	    errNum2 = WlzLabel3DPlnPairs(nPairTbl + p, pairTbl + p,
+	                                 plnTbl + p, plnTbl + p - 1, dist);
+	    if(errNum2 != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical
 	      {
+#endif
 		errNum = errNum2;
-	      }
 #ifdef _OPENMP
-	    }
+	      }
 #endif
+	    }
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  for(p = 1; p < nPln; ++p)
+	  {
+	    int	i,
+	    	q;
+	    int	*pair;
+
+	    q = p - 1;
+	    pair = pairTbl[p];
+	    for(i = 0; i < nPairTbl[p]; ++i)
+	    {
+	      AlcUFTreeUnion(uft, cNFrgTbl[q] + pair[1], cNFrgTbl[p] + pair[0]);
+	      pair += 2;
+	    }
+	  }
+	}
+	if(plnTbl)
+	{
+	  for(p = 0; p < nPln; ++p)
+	  {
+	    WlzLabel3DPlnFree(plnTbl + p);
 	  }
+	  AlcFree(plnTbl);
 	}
+	if(pairTbl)
+	{
+	  for(p = 0; p < nPln; ++p)
+	  {
+	    AlcFree(pairTbl[p]);
+	  }
+	  AlcFree(pairTbl);
+	}
+	AlcFree(nPairTbl);
       }
       /* The union-find tree now holds the connectivity of all the fragments.
        * Create a simple table which maps the fragment index to the 3D labeled
@@ -405,18 +468,9 @@ WlzObject			*WlzLabel3D(
       }
       /* Finished with the union-find tree so free it. */
       AlcUFTreeFree(uft);
-      /* Create a buffer large enough to hold all fragments on any plane (for
-       * each thread if using OpenMP) and a compound array object for the
-       * labeled 3D objects initialise them with the bounding box of the given
-       * object. The plane domains will be fixed later. */
-      if(errNum == WLZ_ERR_NONE)
-      {
-	objBufSz = maxFrgPln * sizeof(WlzObject *);
-	if((frgObjBuf = (WlzObject **)AlcMalloc(objBufSz)) == NULL)
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-      }
+      /* Create a compound array object for the labeled 3D objects
+       * initialise them with the bounding box of the given object. The
+       * plane domains will be fixed later. */
       if(errNum == WLZ_ERR_NONE)
       {
 	objs = WlzMakeCompoundArray(WLZ_COMPOUND_ARR_1, 1, nObjs, NULL,
@@ -447,59 +501,89 @@ WlzObject			*WlzLabel3D(
 	}
       }
       /* Use the fragment to object index table to allocate the fragments
-       * within each plane to the appropriate object.*/
+       * within each plane to the appropriate object. Each plane is done
+       * concurrently, with the fragments of the plane being sorted by
+       * object index so that all those of the same object are together. */
       if(errNum == WLZ_ERR_NONE)
       {
 	int		p;		/* Current plane */
 
-	for(p = 0; (errNum == WLZ_ERR_NONE) && (p < nPln); ++p)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+	for(p = 0; p < nPln; ++p)
 	{
-	  int	fP,		/* Fragment within current plane p */
-		  nFrgP,
-		  frgIdxP; 	/* Index of the first fragment on plane p */
-	  WlzObject **frgP;
+	  int	nFrgP;
+	  WlzErrorNum errNum2 = WLZ_ERR_NONE;
 
-	  frgP = frgTbl[p];
 	  nFrgP = nFrgTbl[p];
-	  frgIdxP = cNFrgTbl[p];
-	  for(fP = 0; (errNum == WLZ_ERR_NONE) && (fP < nFrgP); ++fP)
+	  if((errNum == WLZ_ERR_NONE) && (nFrgP > 0))
 	  {
-	    if(frgP[fP])
+	    int	fP,		/* Fragment within current plane p */
+		fP1,
+		frgIdxP; 	/* Index of the first fragment on plane p */
+	    int	*srt = NULL;	/* Object and fragment index pairs. */
+	    WlzObject **frgP,
+	    	      **frgBuf = NULL;
+
+	    frgP = frgTbl[p];
+	    frgIdxP = cNFrgTbl[p];
+	    if(((srt = (int *)AlcMalloc(2 * nFrgP * sizeof(int))) == NULL) ||
+	       ((frgBuf = (WlzObject **)
+	                  AlcMalloc(nFrgP * sizeof(WlzObject *))) == NULL))
+	    {
+	      errNum2 = WLZ_ERR_MEM_ALLOC;
+	    }
+	    else
 	    {
+	      for(fP = 0; fP < nFrgP; ++fP)
+	      {
+		srt[2 * fP] = frgToObjTb[frgIdxP + fP];
+		srt[2 * fP + 1] = fP;
+	      }
+	      qsort(srt, nFrgP, 2 * sizeof(int), WlzLabel3DPairCmp);
 	      /* Put all fragments on this plane which are part of the same
 	       * labeled 3D object into a buffer. Form their union and the
 	       * add the domain to the 3D object. */
-	      int	  fP1,
-		    objIdx,
-		    frgBufIdx;
-	      WlzObject *obj2 = NULL;
-
-	      frgBufIdx = 0;
-	      objIdx = frgToObjTb[frgIdxP + fP];
-	      for(fP1 = fP; fP1 < nFrgP; ++fP1)
+	      for(fP = 0; (errNum2 == WLZ_ERR_NONE) && (fP < nFrgP); fP = fP1)
 	      {
-		if(objIdx == frgToObjTb[frgIdxP + fP1])
+		int	  objIdx,
+			  frgBufIdx = 0;
+		WlzObject *obj2 = NULL;
+
+		objIdx = srt[2 * fP];
+		for(fP1 = fP; (fP1 < nFrgP) && (srt[2 * fP1] == objIdx); ++fP1)
 		{
-		  frgObjBuf[frgBufIdx++] = frgP[fP1];
-		  frgP[fP1] = NULL;
+		  frgBuf[frgBufIdx++] = frgP[srt[2 * fP1 + 1]];
 		}
-	      }
-	      if(frgBufIdx > 0)
-	      {
 		obj2 = WlzAssignObject(
-		       WlzUnionN(frgBufIdx, frgObjBuf, 0, &errNum), NULL);
-	      }
-	      if(obj2)
-	      {
-		objs->o[objIdx]->domain.p->domains[p] =
-		    WlzAssignDomain(obj2->domain, NULL);
-		(void )WlzFreeObj(obj2);
-	      }
-	      for(fP1 = 0; fP1 < frgBufIdx; ++fP1)
-	      {
-		(void )WlzFreeObj(frgObjBuf[fP1]);
+		       WlzUnionN(frgBufIdx, frgBuf, 0, &errNum2), NULL);
+		if(obj2)
+		{
+		  objs->o[objIdx]->domain.p->domains[p] =
+		      WlzAssignDomain(obj2->domain, NULL);
+		  (void )WlzFreeObj(obj2);
+		}
 	      }
 	    }
+	    for(fP = 0; fP < nFrgP; ++fP)
+	    {
+	      (void )WlzFreeObj(frgP[fP]);
+	      frgP[fP] = NULL;
+	    }
+	    AlcFree(srt);
+	    AlcFree(frgBuf);
+	  }
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical
+	    {
+#endif
+	      errNum = errNum2;
+#ifdef _OPENMP
+	    }
+#endif
 	  }
 	}
       }
@@ -580,7 +664,6 @@ WlzObject			*WlzLabel3D(
   }
   /* Free the buffers, array of fragments per plane and the fragment
    * table. */
-  AlcFree(frgObjBuf);
   AlcFree(frgToObjTb);
   if(frgTbl)
   {
@@ -588,7 +671,16 @@ WlzObject			*WlzLabel3D(
 
     for(p = 0; p < nPln; ++p)
     {
-      AlcFree(frgTbl[p]);
+      if(frgTbl[p])
+      {
+        int	f;
+
+	for(f = 0; f < nFrgTbl[p]; ++f)
+	{
+	  (void )WlzFreeObj(frgTbl[p][f]);
+	}
+	AlcFree(frgTbl[p]);
+      }
     }
     AlcFree(frgTbl);
   }
@@ -609,3 +701,278 @@ WlzObject			*WlzLabel3D(
   return(lObj);
 }
 
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Builds a table of the intervals of all the given fragments
+* 		of a plane, sorted by line and then by column, with each
+* 		interval tagged with the index of it's fragment.
+* \param	pln		Plane interval table to be set.
+* \param	nFrg		Number of fragments in the plane.
+* \param	frg		The fragments (2D domain objects) of the
+* 				plane.
+*/
+static WlzErrorNum		WlzLabel3DPlnMake(
+				  WlzLabel3DPln *pln,
+				  int nFrg,
+				  WlzObject **frg)
+{
+  int		f,
+  		l,
+		nItv = 0,
+		lastln;
+  int		*fill = NULL;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nFrg < 1)
+  {
+    return(errNum);
+  }
+  pln->line1 = frg[0]->domain.i->line1;
+  lastln = frg[0]->domain.i->lastln;
+  for(f = 0; f < nFrg; ++f)
+  {
+    WlzIntervalDomain *iDom;
+
+    iDom = frg[f]->domain.i;
+    pln->line1 = ALG_MIN(pln->line1, iDom->line1);
+    lastln = ALG_MAX(lastln, iDom->lastln);
+    nItv += WlzIntervalCount(iDom, NULL);
+  }
+  pln->nLn = lastln - pln->line1 + 1;
+  if(((pln->lnOff = (int *)AlcCalloc(pln->nLn + 1, sizeof(int))) == NULL) ||
+     ((pln->itv = (WlzLabel3DItv *)
+                  AlcMalloc(nItv * sizeof(WlzLabel3DItv))) == NULL) ||
+     ((fill = (int *)AlcMalloc(pln->nLn * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Count the intervals on each line, form the line offsets and then
+   * fill in the intervals. */
+  for(f = 0; (errNum == WLZ_ERR_NONE) && (f < nFrg); ++f)
+  {
+    errNum = WlzInitRasterScan(frg[f], &iWSp, WLZ_RASTERDIR_ILIC);
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      ++(pln->lnOff[iWSp.linpos - pln->line1 + 1]);
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(l = 0; l < pln->nLn; ++l)
+    {
+      pln->lnOff[l + 1] += pln->lnOff[l];
+      fill[l] = pln->lnOff[l];
+    }
+  }
+  for(f = 0; (errNum == WLZ_ERR_NONE) && (f < nFrg); ++f)
+  {
+    errNum = WlzInitRasterScan(frg[f], &iWSp, WLZ_RASTERDIR_ILIC);
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      WlzLabel3DItv *itv;
+
+      itv = pln->itv + fill[iWSp.linpos - pln->line1]++;
+      itv->kl0 = iWSp.lftpos;
+      itv->kl1 = iWSp.rgtpos;
+      itv->frg = f;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(l = 0; l < pln->nLn; ++l)
+    {
+      int	n;
+
+      if((n = pln->lnOff[l + 1] - pln->lnOff[l]) > 1)
+      {
+        qsort(pln->itv + pln->lnOff[l], n, sizeof(WlzLabel3DItv),
+	      WlzLabel3DItvCmp);
+      }
+    }
+  }
+  AlcFree(fill);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzBinaryOps
+* \brief	Frees the line offset and interval tables of the given
+* 		plane interval table but not the plane interval table
+* 		itself.
+* \param	pln		Given plane interval table.
+*/
+static void			WlzLabel3DPlnFree(
+				  WlzLabel3DPln *pln)
+{
+  AlcFree(pln->lnOff);
+  AlcFree(pln->itv);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Finds all pairs of connected fragments in a pair of adjacent
+* 		planes by sweeping through the sorted intervals of the
+* 		planes. The pairs are returned as (fragment in plane P,
+* 		fragment in plane Q) index pairs, sorted and without
+* 		duplicates.
+* \param	dstNPair	Destination pointer for the number of pairs.
+* \param	dstPair		Destination pointer for the array of pairs,
+* 				which should be freed using AlcFree().
+* \param	plnP		First plane.
+* \param	plnQ		Second plane.
+* \param	dist		Distance within which intervals are connected,
+* 				zero for face connectivity and one for
+* 				connectivity which includes edges and vertices.
+*/
+static WlzErrorNum		WlzLabel3DPlnPairs(
+				  int *dstNPair,
+				  int **dstPair,
+				  WlzLabel3DPln *plnP,
+				  WlzLabel3DPln *plnQ,
+				  int dist)
+{
+  int		l,
+  		nPair = 0,
+		maxPair = 0;
+  int		*pair = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((plnP->itv == NULL) || (plnQ->itv == NULL))
+  {
+    return(errNum);
+  }
+  for(l = 0; (errNum == WLZ_ERR_NONE) && (l < plnP->nLn); ++l)
+  {
+    int		d;
+
+    for(d = -dist; (errNum == WLZ_ERR_NONE) && (d <= dist); ++d)
+    {
+      int	lQ;
+
+      lQ = plnP->line1 + l + d - plnQ->line1;
+      if((lQ >= 0) && (lQ < plnQ->nLn))
+      {
+	int	iP,
+		iP1,
+		iQ0,
+		iQ1;
+
+	iP1 = plnP->lnOff[l + 1];
+	iQ0 = plnQ->lnOff[lQ];
+	iQ1 = plnQ->lnOff[lQ + 1];
+	for(iP = plnP->lnOff[l]; (errNum == WLZ_ERR_NONE) && (iP < iP1); ++iP)
+	{
+	  int	iQ;
+	  WlzLabel3DItv *itvP;
+
+	  itvP = plnP->itv + iP;
+	  /* Intervals within a line of a plane are disjoint, so an interval
+	   * of Q which lies before this interval of P also lies before all
+	   * of the following intervals of P. */
+	  while((iQ0 < iQ1) && (plnQ->itv[iQ0].kl1 + dist < itvP->kl0))
+	  {
+	    ++iQ0;
+	  }
+	  for(iQ = iQ0; (iQ < iQ1) &&
+	                (plnQ->itv[iQ].kl0 <= itvP->kl1 + dist); ++iQ)
+	  {
+	    if(nPair >= maxPair)
+	    {
+	      maxPair = (maxPair < 64)? 64: 2 * maxPair;
+	      if((pair = (int *)AlcRealloc(pair,
+				   2 * maxPair * sizeof(int))) == NULL)
+	      {
+		errNum = WLZ_ERR_MEM_ALLOC;
+		break;
+	      }
+	    }
+	    pair[2 * nPair] = itvP->frg;
+	    pair[2 * nPair + 1] = plnQ->itv[iQ].frg;
+	    ++nPair;
+	  }
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nPair > 1))
+  {
+    int		i,
+    		n = 1;
+
+    qsort(pair, nPair, 2 * sizeof(int), WlzLabel3DPairCmp);
+    for(i = 1; i < nPair; ++i)
+    {
+      if((pair[2 * i] != pair[2 * (n - 1)]) ||
+         (pair[2 * i + 1] != pair[2 * (n - 1) + 1]))
+      {
+        pair[2 * n] = pair[2 * i];
+        pair[2 * n + 1] = pair[2 * i + 1];
+	++n;
+      }
+    }
+    nPair = n;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    *dstNPair = nPair;
+    *dstPair = pair;
+  }
+  else
+  {
+    AlcFree(pair);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzBinaryOps
+* \brief	Compares intervals by their first column.
+* \param	p0		Pointer to first interval.
+* \param	p1		Pointer to second interval.
+*/
+static int			WlzLabel3DItvCmp(
+				  const void *p0,
+				  const void *p1)
+{
+  return(((WlzLabel3DItv *)p0)->kl0 - ((WlzLabel3DItv *)p1)->kl0);
+}
+
+/*!
+* \return	Sort value for qsort().
+* \ingroup	WlzBinaryOps
+* \brief	Compares pairs of integers lexicographically.
+* \param	p0		Pointer to first pair.
+* \param	p1		Pointer to second pair.
+*/
+static int			WlzLabel3DPairCmp(
+				  const void *p0,
+				  const void *p1)
+{
+  int		cmp;
+  const int	*i0,
+  		*i1;
+
+  i0 = (const int *)p0;
+  i1 = (const int *)p1;
+  if((cmp = i0[0] - i1[0]) == 0)
+  {
+    cmp = i0[1] - i1[1];
+  }
+  return(cmp);
+}
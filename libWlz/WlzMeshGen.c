@@ -51,6 +51,14 @@ static char _WlzMeshGen_c[] = "University of Edinburgh $Id$";
 #define WLZ_FAST_CODE
 #endif
 
+/*!
+* \def		WLZ_CMESH_WALK_MAXSTEP
+* \ingroup	WlzMesh
+* \brief	Maximum number of elements visited by a walk search
+* 		before falling back to a location grid or jump search.
+*/
+#define WLZ_CMESH_WALK_MAXSTEP	(32)
+
 /*!
 * \enum		_WlzCMeshConformAction
 * \ingroup	WlzMesh
@@ -131,6 +139,41 @@ static WlzErrorNum 		WlzCMeshAddElmToGrid2D5(
 static WlzErrorNum 		WlzCMeshAddElmToGrid3D(
 				  WlzCMesh3D *mesh,
 				  WlzCMeshElm3D *elm);
+static WlzErrorNum 		WlzCMeshAddElmsToGrid3D(
+				  WlzCMesh3D *mesh);
+static WlzErrorNum 		WlzCMeshLinkElmCell3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshElm3D *elm,
+				  WlzCMeshCell3D *cell);
+static int			WlzCMeshElmCellIsct3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshElm3D *elm,
+				  WlzIVertex3 idx);
+static WlzIBox3			WlzCMeshElmCellBox3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshElm3D *elm);
+static WlzErrorNum 		WlzCMeshSetElmFce3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshElm3D *elm,
+				  WlzCMeshNod3D *nod0,
+				  WlzCMeshNod3D *nod1,
+				  WlzCMeshNod3D *nod2,
+				  WlzCMeshNod3D *nod3,
+				  int allowFlip,
+				  int findOpp);
+static WlzErrorNum 		WlzCMeshSetOppFces3D(
+				  WlzCMesh3D *mesh);
+static WlzCMesh3D 		*WlzCMeshBuildFromBalLBTDom3D(
+				  WlzLBTDomain3D *lDom,
+				  WlzObject *iObj,
+				  WlzErrorNum *dstErr);
+static WlzCMeshElm3D 		*WlzCMeshNewLBTElm3D(
+				  WlzCMesh3D *mesh,
+				  WlzCMeshNod3D *nod0,
+				  WlzCMeshNod3D *nod1,
+				  WlzCMeshNod3D *nod2,
+				  WlzCMeshNod3D *nod3,
+				  WlzErrorNum *dstErr);
 static WlzErrorNum 		WlzCMeshElmFuse2D2(
 				  WlzCMesh2D *mesh,
 				  WlzCMeshElm2D *gElm,
@@ -159,6 +202,14 @@ static int			WlzCMeshElmWalkPos3D(
 				  WlzCMesh3D *mesh,
 				  int elmIdx,
 				  WlzDVertex3 gPos);
+static int			WlzCMeshElmClosestNod2D(
+				  WlzCMesh2D *mesh,
+				  int elmIdx,
+				  WlzDVertex2 gPos);
+static int			WlzCMeshElmClosestNod3D(
+				  WlzCMesh3D *mesh,
+				  int elmIdx,
+				  WlzDVertex3 gPos);
 static int			WlzCMeshElmJumpPos2D(
 				  WlzCMesh2D *mesh,
 				  WlzDVertex2 gPos,
@@ -1145,6 +1196,7 @@ static WlzErrorNum WlzCMeshAddElmToGrid2D(WlzCMesh2D *mesh, WlzCMeshElm2D *elm)
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	eps = 0.001;
 
+  WlzCMeshFreeLocGrid2D(mesh);
   elm->cElm = NULL;
   delta = eps * mesh->cGrid.cellSz;
   /* Find grid cells that may be intersected by the element on the basis
@@ -1286,31 +1338,23 @@ RETURN:
 }
 
 /*!
-* \return	Woolz error code.
+* \return	Box of cell grid indices.
 * \ingroup	WlzMesh
-* \brief	Adds a new 3D mesh element to the mesh's cell grid.
-* 		It is assumed that the given element is not already in the
-* 		cell grid but this is not checked for.
+* \brief	Computes the range of grid cells that may be intersected
+* 		by the given 3D mesh element on the basis of the element's
+* 		axis aligned bounding box. The range is clamped to the
+* 		cell grid.
 * \param	mesh			The mesh.
-* \param	elm			Element to add to the cell grid.
+* \param	elm			Given mesh element.
 */
-static WlzErrorNum WlzCMeshAddElmToGrid3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm)
+static WlzIBox3	WlzCMeshElmCellBox3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm)
 {
   double	delta;
-  WlzIVertex3	idx;
-  WlzDVertex3	cBoxMin,
-  		cBoxMax;
   WlzIBox3	cBox;
   WlzDBox3	eBox;
-  WlzCMeshCell3D *cell;
-  WlzCMeshCellElm3D *cElm;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	eps = 0.001;
 
-  elm->cElm = NULL;
   delta = eps * mesh->cGrid.cellSz;
-  /* Find grid cells that may be intersected by the element on the basis
-   * of this element's axis aligned bounding box. */
   eBox = WlzCMeshElmBBox3D(elm);
   cBox.xMin = (int )floor((eBox.xMin - mesh->bBox.xMin - delta) /
                           mesh->cGrid.cellSz);
@@ -1330,40 +1374,105 @@ static WlzErrorNum WlzCMeshAddElmToGrid3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm)
   cBox.yMax = WLZ_CLAMP(cBox.yMax, 0,  mesh->cGrid.nCells.vtY - 1);
   cBox.zMin = WLZ_CLAMP(cBox.zMin, 0,  mesh->cGrid.nCells.vtZ - 1);
   cBox.zMax = WLZ_CLAMP(cBox.zMax, 0,  mesh->cGrid.nCells.vtZ - 1);
+  return(cBox);
+}
+
+/*!
+* \return	Non-zero if the element intersects the cell.
+* \ingroup	WlzMesh
+* \brief	Tests for an intersection between the given 3D mesh element
+* 		and the grid cell with the given index.
+* \param	mesh			The mesh.
+* \param	elm			Given mesh element.
+* \param	idx			Index of the grid cell.
+*/
+static int	WlzCMeshElmCellIsct3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
+				      WlzIVertex3 idx)
+{
+  int		isct;
+  WlzDVertex3	cBoxMin,
+  		cBoxMax;
+
+  cBoxMin.vtX = mesh->bBox.xMin + (idx.vtX * mesh->cGrid.cellSz);
+  cBoxMin.vtY = mesh->bBox.yMin + (idx.vtY * mesh->cGrid.cellSz);
+  cBoxMin.vtZ = mesh->bBox.zMin + (idx.vtZ * mesh->cGrid.cellSz);
+  cBoxMax.vtX = mesh->bBox.xMin + ((idx.vtX + 1) * mesh->cGrid.cellSz);
+  cBoxMax.vtY = mesh->bBox.yMin + ((idx.vtY + 1) * mesh->cGrid.cellSz);
+  cBoxMax.vtZ = mesh->bBox.zMin + ((idx.vtZ + 1) * mesh->cGrid.cellSz);
+  /* Faster to test using AABB(cell)/AABB(element) only and incur
+   * false positives. */
+  isct = WlzGeomTetrahedronAABBIntersect3D(elm->face[0].edu[0].nod->pos,
+					   elm->face[0].edu[1].nod->pos,
+					   elm->face[0].edu[2].nod->pos,
+					   elm->face[1].edu[1].nod->pos,
+					   cBoxMin, cBoxMax, 1);
+  return(isct);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Links a new grid cell element into the lists of both the
+* 		given mesh element and grid cell.
+* \param	mesh			The mesh.
+* \param	elm			Given mesh element.
+* \param	cell			Given grid cell.
+*/
+static WlzErrorNum WlzCMeshLinkElmCell3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
+					 WlzCMeshCell3D *cell)
+{
+  WlzCMeshCellElm3D *cElm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((cElm = WlzCMeshNewCElm3D(mesh, &errNum)) != NULL)
+  {
+    cElm->elm = elm;
+    cElm->cell = cell;
+    /* Next element of this cell. */
+    cElm->next = cell->cElm; cell->cElm = cElm;
+    /* Next cell of this element. */
+    cElm->nextCell = elm->cElm; elm->cElm = cElm;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Adds a new 3D mesh element to the mesh's cell grid.
+* 		It is assumed that the given element is not already in the
+* 		cell grid but this is not checked for.
+* \param	mesh			The mesh.
+* \param	elm			Element to add to the cell grid.
+*/
+static WlzErrorNum WlzCMeshAddElmToGrid3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm)
+{
+  WlzIVertex3	idx;
+  WlzIBox3	cBox;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  WlzCMeshFreeLocGrid3D(mesh);
+  elm->cElm = NULL;
+  /* Find grid cells that may be intersected by the element on the basis
+   * of this element's axis aligned bounding box. */
+  cBox = WlzCMeshElmCellBox3D(mesh, elm);
   /* For each of the grid cells found, check for an intersection with the
    * element and then if there is an intersection add a grid cell element
    * to the cell. */
   for(idx.vtZ = cBox.zMin; idx.vtZ <= cBox.zMax; ++idx.vtZ)
   {
-    cBoxMin.vtZ = mesh->bBox.zMin + (idx.vtZ * mesh->cGrid.cellSz);
-    cBoxMax.vtZ = mesh->bBox.zMin + ((idx.vtZ + 1) * mesh->cGrid.cellSz);
     for(idx.vtY = cBox.yMin; idx.vtY <= cBox.yMax; ++idx.vtY)
     {
-      cBoxMin.vtY = mesh->bBox.yMin + (idx.vtY * mesh->cGrid.cellSz);
-      cBoxMax.vtY = mesh->bBox.yMin + ((idx.vtY + 1) * mesh->cGrid.cellSz);
       for(idx.vtX = cBox.xMin; idx.vtX <= cBox.xMax; ++idx.vtX)
       {
-	cBoxMin.vtX = mesh->bBox.xMin + (idx.vtX * mesh->cGrid.cellSz);
-	cBoxMax.vtX = mesh->bBox.xMin + ((idx.vtX + 1) * mesh->cGrid.cellSz);
-	/* Faster to test using AABB(cell)/AABB(element) only and incur
-	 * false positives. */
-	if(WlzGeomTetrahedronAABBIntersect3D(elm->face[0].edu[0].nod->pos,
-					     elm->face[0].edu[1].nod->pos,
-					     elm->face[0].edu[2].nod->pos,
-					     elm->face[1].edu[1].nod->pos,
-					     cBoxMin, cBoxMax, 1) != 0)
+	if(WlzCMeshElmCellIsct3D(mesh, elm, idx) != 0)
 	{
-	  if((cElm = WlzCMeshNewCElm3D(mesh, &errNum)) == NULL)
+	  errNum = WlzCMeshLinkElmCell3D(mesh, elm,
+	                 *(*(mesh->cGrid.cells + idx.vtZ) + idx.vtY) + idx.vtX);
+	  if(errNum != WLZ_ERR_NONE)
 	  {
 	    goto RETURN;
 	  }
-	  cElm->elm = elm;
-	  cell = *(*(mesh->cGrid.cells + idx.vtZ) + idx.vtY) + idx.vtX;
-	  cElm->cell = cell;
-	  /* Next element of this cell. */
-	  cElm->next = cell->cElm; cell->cElm = cElm;
-	  /* Next cell of this element. */
-	  cElm->nextCell = elm->cElm; elm->cElm = cElm;
 	}
       }
     }
@@ -1372,6 +1481,153 @@ RETURN:
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Adds all the valid elements of the given 3D mesh to the
+* 		mesh's cell grid. The result is the same as calling
+* 		WlzCMeshAddElmToGrid3D() for each element in index order,
+* 		but the expensive element / cell intersection tests are
+* 		done in parallel for blocks of elements, with the cell
+* 		elements then being linked serially in element order.
+* 		It is assumed that none of the elements are already in the
+* 		cell grid but this is not checked for.
+* \param	mesh			The mesh.
+*/
+static WlzErrorNum WlzCMeshAddElmsToGrid3D(WlzCMesh3D *mesh)
+{
+  int		idE,
+  		idE0,
+		idE1,
+		nCXY;
+  size_t	nCand,
+  		maxCand = 0;
+  int		*cnt = NULL,
+  		*cIdx = NULL;
+  size_t	*off = NULL;
+  WlzIBox3	*cBox = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	blkSz = 65536;    /* Elements per block. */
+  const size_t	blkCand = 1 << 20; /* Candidate cells per block. */
+
+  WlzCMeshFreeLocGrid3D(mesh);
+  nCXY = mesh->cGrid.nCells.vtX * mesh->cGrid.nCells.vtY;
+  if(((cnt = (int *)AlcMalloc(sizeof(int) * blkSz)) == NULL) ||
+     ((off = (size_t *)AlcMalloc(sizeof(size_t) * (blkSz + 1))) == NULL) ||
+     ((cBox = (WlzIBox3 *)AlcMalloc(sizeof(WlzIBox3) * blkSz)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  idE0 = 0;
+  while((errNum == WLZ_ERR_NONE) && (idE0 < mesh->res.elm.maxEnt))
+  {
+    /* Find a block of elements with a bounded number of candidate cells,
+     * and the offsets of their candidate cells. */
+    nCand = 0;
+    idE1 = idE0;
+    while((idE1 < mesh->res.elm.maxEnt) && (idE1 - idE0 < blkSz) &&
+          ((idE1 == idE0) || (nCand < blkCand)))
+    {
+      WlzCMeshElm3D *elm;
+
+      off[idE1 - idE0] = nCand;
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE1);
+      if(elm->idx >= 0)
+      {
+	WlzIBox3 *b;
+
+	elm->cElm = NULL;
+	b = cBox + idE1 - idE0;
+        *b = WlzCMeshElmCellBox3D(mesh, elm);
+	nCand += (size_t )(b->xMax - b->xMin + 1) *
+	         (size_t )(b->yMax - b->yMin + 1) *
+		 (size_t )(b->zMax - b->zMin + 1);
+      }
+      ++idE1;
+    }
+    off[idE1 - idE0] = nCand;
+    if(nCand > maxCand)
+    {
+      maxCand = nCand;
+      AlcFree(cIdx);
+      if((cIdx = (int *)AlcMalloc(sizeof(int) * maxCand)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+    }
+    /* Test the candidate cells of each element in parallel, recording
+     * the intersected cells. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
+    for(idE = idE0; idE < idE1; ++idE)
+    {
+      int	n;
+      int	*c;
+      WlzIBox3	*b;
+      WlzIVertex3 idx;
+      WlzCMeshElm3D *elm;
+
+      n = 0;
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      if(elm->idx >= 0)
+      {
+	b = cBox + idE - idE0;
+	c = cIdx + off[idE - idE0];
+	for(idx.vtZ = b->zMin; idx.vtZ <= b->zMax; ++idx.vtZ)
+	{
+	  for(idx.vtY = b->yMin; idx.vtY <= b->yMax; ++idx.vtY)
+	  {
+	    for(idx.vtX = b->xMin; idx.vtX <= b->xMax; ++idx.vtX)
+	    {
+	      if(WlzCMeshElmCellIsct3D(mesh, elm, idx) != 0)
+	      {
+		c[n++] = (idx.vtZ * nCXY) +
+		         (idx.vtY * mesh->cGrid.nCells.vtX) + idx.vtX;
+	      }
+	    }
+	  }
+	}
+      }
+      cnt[idE - idE0] = n;
+    }
+    /* Link the cell elements in element order. */
+    for(idE = idE0; (errNum == WLZ_ERR_NONE) && (idE < idE1); ++idE)
+    {
+      int	idC,
+      		n;
+      int	*c;
+      WlzCMeshElm3D *elm;
+
+      n = cnt[idE - idE0];
+      c = cIdx + off[idE - idE0];
+      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+      for(idC = 0; idC < n; ++idC)
+      {
+	int	z,
+		y;
+
+	z = c[idC] / nCXY;
+	y = (c[idC] % nCXY) / mesh->cGrid.nCells.vtX;
+	errNum = WlzCMeshLinkElmCell3D(mesh, elm,
+			   *(*(mesh->cGrid.cells + z) + y) +
+			   (c[idC] % mesh->cGrid.nCells.vtX));
+	if(errNum != WLZ_ERR_NONE)
+	{
+	  break;
+	}
+      }
+    }
+    idE0 = idE1;
+  }
+  AlcFree(cnt);
+  AlcFree(off);
+  AlcFree(cBox);
+  AlcFree(cIdx);
+  return(errNum);
+}
+
 /*!
 * \return	New mesh cell element.
 * \ingroup	WlzMesh
@@ -1653,6 +1909,7 @@ static void	WlzCMeshRemElmFromGrid2D(WlzCMesh2D *mesh, WlzCMeshElm2D *elm)
 		*cElm2;
   WlzCMeshCell2D *cell;
 
+  WlzCMeshFreeLocGrid2D(mesh);
   cElm0 = elm->cElm;
   while(cElm0 != NULL)
   {
@@ -1736,6 +1993,7 @@ static void	WlzCMeshRemElmFromGrid3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm)
 		*cElm2;
   WlzCMeshCell3D *cell;
 
+  WlzCMeshFreeLocGrid3D(mesh);
   cElm0 = elm->cElm;
   while(cElm0 != NULL)
   {
@@ -1996,6 +2254,47 @@ WlzCMeshElm3D 	*WlzCMeshNewElm3D(WlzCMesh3D *mesh,
   return(nElm);
 }
 
+/*!
+* \return	New 3D mesh element.
+* \ingroup	WlzMesh
+* \brief	Creates a new 3D mesh element connecting the given mesh
+*		nodes while building a mesh from an LBT domain. This
+*		differs from WlzCMeshNewElm3D() in that the element is
+*		neither added to the cell grid, connected to it's opposite
+*		elements nor passed to any callbacks, these all being
+*		done for all the mesh elements in bulk once the mesh
+*		has been built.
+* \param	mesh			The mesh for resources.
+* \param	nod0			First mesh node.
+* \param	nod1			Second mesh node.
+* \param	nod2			Third mesh node.
+* \param	nod3			Fourth mesh node.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzCMeshElm3D *WlzCMeshNewLBTElm3D(WlzCMesh3D *mesh,
+				  WlzCMeshNod3D *nod0, WlzCMeshNod3D *nod1,
+				  WlzCMeshNod3D *nod2, WlzCMeshNod3D *nod3,
+				  WlzErrorNum *dstErr)
+{
+  WlzCMeshElm3D	*nElm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((nElm = WlzCMeshAllocElm3D(mesh)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    nElm->cElm = NULL;
+    errNum = WlzCMeshSetElmFce3D(mesh, nElm, nod0, nod1, nod2, nod3, 0, 0);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nElm);
+}
+
 /*!
 * \return	New 2D mesh element or NULL on error.
 * \ingroup	WlzMesh
@@ -2249,11 +2548,10 @@ WlzErrorNum  	WlzCMeshSetElm2D5(WlzCMesh2D5 *mesh, WlzCMeshElm2D5 *elm,
 * \return	Woolz error code.
 * \ingroup	WlzMesh
 * \brief	Sets up the edge and node connectivities within the given
-*		3D mesh element. No opposites are changed.
-*		The geometry of the element is checked to make sure that
-*		it's volume is greater than the mesh tolerance, ie that
-*		the nodes are correclty ordered and are not co planar.
-*		If this test fails an error is returned.
+*		3D mesh element as for WlzCMeshSetElm3D(), but with the
+*		search for opposite faces being optional. When building
+*		a mesh in bulk the opposite faces are found for all
+*		elements in a single pass by WlzCMeshSetOppFces3D().
 * \param	mesh			The mesh.
 * \param	elm			Given mesh element.
 * \param	nod0			First mesh node of element.
@@ -2262,11 +2560,12 @@ WlzErrorNum  	WlzCMeshSetElm2D5(WlzCMesh2D5 *mesh, WlzCMeshElm2D5 *elm,
 * \param	nod3			Fourth mesh node of element.
 * \param	allowFlip		Allow flipping of node order to get
 * 					valid element.
+* \param	findOpp			Find opposite faces if non-zero.
 */
-WlzErrorNum  	WlzCMeshSetElm3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
-				     WlzCMeshNod3D *nod0, WlzCMeshNod3D *nod1,
-				     WlzCMeshNod3D *nod2, WlzCMeshNod3D *nod3,
-				     int allowFlip)
+static WlzErrorNum WlzCMeshSetElmFce3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
+				       WlzCMeshNod3D *nod0, WlzCMeshNod3D *nod1,
+				       WlzCMeshNod3D *nod2, WlzCMeshNod3D *nod3,
+				       int allowFlip, int findOpp)
 {
   int		idE,
   		idF,
@@ -2334,12 +2633,15 @@ WlzErrorNum  	WlzCMeshSetElm3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
       fce->opp = NULL;
       fce->elm = elm;
     }
-    for(idF = 0; idF < 4; ++idF)
+    if(findOpp)
     {
-      fce = elm->face + idF;
-      if((fce->opp = WlzCMeshFindOppFce(fce)) != NULL)
+      for(idF = 0; idF < 4; ++idF)
       {
-        fce->opp->opp = fce;
+	fce = elm->face + idF;
+	if((fce->opp = WlzCMeshFindOppFce(fce)) != NULL)
+	{
+	  fce->opp->opp = fce;
+	}
       }
     }
     /* Check for maximum edge length. */
@@ -2358,6 +2660,36 @@ WlzErrorNum  	WlzCMeshSetElm3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
   return(errNum);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Sets up the edge and node connectivities within the given
+*		3D mesh element. No opposites are changed.
+*		The geometry of the element is checked to make sure that
+*		it's volume is greater than the mesh tolerance, ie that
+*		the nodes are correclty ordered and are not co planar.
+*		If this test fails an error is returned.
+* \param	mesh			The mesh.
+* \param	elm			Given mesh element.
+* \param	nod0			First mesh node of element.
+* \param	nod1			Second mesh node of element.
+* \param	nod2			Third mesh node of element.
+* \param	nod3			Fourth mesh node of element.
+* \param	allowFlip		Allow flipping of node order to get
+* 					valid element.
+*/
+WlzErrorNum  	WlzCMeshSetElm3D(WlzCMesh3D *mesh, WlzCMeshElm3D *elm,
+				     WlzCMeshNod3D *nod0, WlzCMeshNod3D *nod1,
+				     WlzCMeshNod3D *nod2, WlzCMeshNod3D *nod3,
+				     int allowFlip)
+{
+  WlzErrorNum	errNum;
+
+  errNum = WlzCMeshSetElmFce3D(mesh, elm, nod0, nod1, nod2, nod3,
+                               allowFlip, 1);
+  return(errNum);
+}
+
 /*!
 * \return	Opposite face or NULL.
 * \ingroup	WlzMesh
@@ -2435,6 +2767,141 @@ static WlzCMeshFace *WlzCMeshFindOppFce(WlzCMeshFace *gFce)
   return(oFce);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMesh
+* \brief	Finds the opposite faces for all the faces of all the
+* 		elements of the given 3D mesh in a single pass. It is
+* 		assumed that none of the face opposites have been set.
+* 		Rather than walking the edge uses around the nodes for
+* 		each face (as in WlzCMeshFindOppFce()) the faces are
+* 		bucketed by their lowest node index, so that opposite
+* 		faces always share a bucket, and then the buckets are
+* 		searched in parallel.
+* \param	mesh			The mesh.
+*/
+static WlzErrorNum WlzCMeshSetOppFces3D(WlzCMesh3D *mesh)
+{
+  int		idB,
+  		idE,
+  		idF,
+		nBkt;
+  int		*bkt = NULL;
+  WlzCMeshFace	**fce = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nBkt = mesh->res.nod.maxEnt;
+  if(((bkt = (int *)AlcCalloc(nBkt + 1, sizeof(int))) == NULL) ||
+     ((fce = (WlzCMeshFace **)AlcMalloc(sizeof(WlzCMeshFace *) * 4 *
+                                        mesh->res.elm.numEnt)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		pass;
+
+    /* Count the faces in each bucket, then fill the buckets. */
+    for(pass = 0; pass < 2; ++pass)
+    {
+      for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
+      {
+	WlzCMeshElm3D *elm;
+
+	elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
+	if(elm->idx >= 0)
+	{
+	  for(idF = 0; idF < 4; ++idF)
+	  {
+	    int	  b;
+	    WlzCMeshFace *f;
+
+	    f = elm->face + idF;
+	    b = ALG_MIN3(f->edu[0].nod->idx, f->edu[1].nod->idx,
+	                 f->edu[2].nod->idx);
+	    if(pass == 0)
+	    {
+	      ++bkt[b + 1];
+	    }
+	    else
+	    {
+	      fce[bkt[b]++] = f;
+	    }
+	  }
+	}
+      }
+      if(pass == 0)
+      {
+	for(idB = 0; idB < nBkt; ++idB)
+	{
+	  bkt[idB + 1] += bkt[idB];
+	}
+      }
+      else
+      {
+	/* Filling has shifted the bucket offsets, shift them back. */
+	for(idB = nBkt; idB > 0; --idB)
+	{
+	  bkt[idB] = bkt[idB - 1];
+	}
+	bkt[0] = 0;
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+    for(idB = 0; idB < nBkt; ++idB)
+    {
+      int	  i,
+		  j;
+
+      for(i = bkt[idB]; i < bkt[idB + 1]; ++i)
+      {
+	WlzCMeshFace *f;
+
+	f = fce[i];
+	if(f->opp == NULL)
+	{
+	  for(j = i + 1; j < bkt[idB + 1]; ++j)
+	  {
+	    int	  k,
+		  m;
+	    WlzCMeshFace *g;
+
+	    g = fce[j];
+	    if((g->opp == NULL) && (g->elm != f->elm))
+	    {
+	      for(k = 0; k < 3; ++k)
+	      {
+		for(m = 0; m < 3; ++m)
+		{
+		  if(g->edu[k].nod == f->edu[m].nod)
+		  {
+		    break;
+		  }
+		}
+		if(m == 3)
+		{
+		  break;
+		}
+	      }
+	      if(k == 3)
+	      {
+		f->opp = g;
+		g->opp = f;
+		break;
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(bkt);
+  AlcFree(fce);
+  return(errNum);
+}
+
 /*!
 * \ingroup	WlzMesh
 * \brief	Adds an edge use to the circular linked list of edges
@@ -2507,6 +2974,7 @@ WlzErrorNum	WlzCMeshFree2D(WlzCMesh2D *mesh)
   }
   else if(WlzUnlink(&(mesh->linkcount), &errNum))
   {
+    WlzCMeshFreeLocGrid2D(mesh);
     (void )AlcVectorFree(mesh->res.elm.vec);
     (void )AlcVectorFree(mesh->res.nod.vec);
     (void )AlcBlockStackFree(mesh->cGrid.allCE);
@@ -2557,6 +3025,7 @@ WlzErrorNum	WlzCMeshFree3D(WlzCMesh3D *mesh)
   }
   else if(WlzUnlink(&(mesh->linkcount), &errNum))
   {
+    WlzCMeshFreeLocGrid3D(mesh);
     (void )AlcVectorFree(mesh->res.elm.vec);
     (void )AlcVectorFree(mesh->res.nod.vec);
     (void )AlcBlockStackFree(mesh->cGrid.allCE);
@@ -3954,6 +4423,7 @@ WlzErrorNum 	WlzCMeshReassignGridCells2D(WlzCMesh2D *mesh, int newNumNod)
                                      allocate space. */
   const double	nodPerCell = 2.0; /* Number of nodes per cell on average. */
 
+  WlzCMeshFreeLocGrid2D(mesh);
   if(newNumNod <= 0)
   {
     newNumNod = (mesh->res.nod.numEnt < nodBSz)?
@@ -4119,7 +4589,6 @@ WlzErrorNum 	WlzCMeshReassignGridCells3D(WlzCMesh3D *mesh, int newNumNod)
   		idN;
   WlzDVertex3	mSz;
   WlzCMeshNod3D	*nod;
-  WlzCMeshElm3D	*elm;
   AlcBlockStack *bStack;
   WlzCMeshCellGrid3D *cGrid;
   WlzCMeshCellElm3D *cElm;
@@ -4128,6 +4597,7 @@ WlzErrorNum 	WlzCMeshReassignGridCells3D(WlzCMesh3D *mesh, int newNumNod)
                                      allocate space. */
   const double	nodPerCell = 1.0; /* Number of nodes per cell on average. */
 
+  WlzCMeshFreeLocGrid3D(mesh);
   if(newNumNod <= 0)
   {
     newNumNod = (mesh->res.nod.numEnt < nodBSz)?
@@ -4175,17 +4645,7 @@ WlzErrorNum 	WlzCMeshReassignGridCells3D(WlzCMesh3D *mesh, int newNumNod)
   /* Add all elements to grid of cells. */
   if(errNum == WLZ_ERR_NONE)
   {
-    for(idE = 0; idE < mesh->res.elm.maxEnt; ++idE)
-    {
-      elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, idE);
-      if(elm->idx >= 0)
-      {
-	if((errNum = WlzCMeshAddElmToGrid3D(mesh, elm)) != WLZ_ERR_NONE)
-	{
-	  break;
-	}
-      }
-    }
+    errNum = WlzCMeshAddElmsToGrid3D(mesh);
   }
   return(errNum);
 }
@@ -4826,11 +5286,15 @@ int             WlzCMeshElmEnclosingPos(WlzCMeshP mesh,
 * \brief	Locates the element of the conforming mesh which encloses
 *		the given position.
 *
-*		If a valid last element index is given then a search is
-*		made for the enclosing element both within this element
-*		and then, if not found, within it's immediate edge
-*		neighbours.
-*		If this simple 'walk search' fails to locate the enclosing
+*		If a valid last element index is given then a 'walk
+*		search' is made for the enclosing element, starting with
+*		this element and crossing the edges of elements towards
+*		the position. This is efficient when successive positions
+*		are close together.
+*		If the walk search fails and the mesh has a location grid
+*		(see WlzCMeshSetLocGrid2D()) then the elements in the
+*		grid cell containing the position are searched.
+*		If these fail to locate the enclosing
 *		element a 'jump search' is used in which the grid cells
 *		of the conforming mesh are searched.
 *		For jump search to work coreectly the maximum edge
@@ -4847,7 +5311,12 @@ int             WlzCMeshElmEnclosingPos(WlzCMeshP mesh,
 * 					debuging.
 * \param	dstCloseNod		If non NULL, then the value is set
 * 					to the index of the closest node
-* 					to the given position.
+* 					to the given position when the
+* 					jump search is used. If an element
+* 					is found using the location grid it
+* 					is set to the closest node of the
+* 					element and it is not set by the
+* 					walk search.
 */
 int             WlzCMeshElmEnclosingPos2D(WlzCMesh2D *mesh,
                                         int lastElmIdx,
@@ -4869,6 +5338,14 @@ int             WlzCMeshElmEnclosingPos2D(WlzCMesh2D *mesh,
     {
       elmIdx = WlzCMeshElmWalkPos2D(mesh, lastElmIdx, gPos);
     }
+    if((elmIdx < 0) && mesh->lGrid)
+    {
+      if(((elmIdx = WlzCMeshLocGridElmPos2D(mesh, gPos)) >= 0) &&
+         (dstCloseNod != NULL))
+      {
+	*dstCloseNod = WlzCMeshElmClosestNod2D(mesh, elmIdx, gPos);
+      }
+    }
     if(elmIdx < 0)
     {
       elmIdx = WlzCMeshElmJumpPos2D(mesh, gPos, dstCloseNod);
@@ -4932,11 +5409,15 @@ int             WlzCMeshElmEnclosingPos2D5(WlzCMesh2D5 *mesh,
 * \brief	Locates the element of the conforming mesh which encloses
 *		the given position.
 *
-*		If a valid last element index is given then a search is
-*		made for the enclosing element both within this element
-*		and then, if not found, within it's immediate edge
-*		neighbours.
-*		If this simple 'walk search' fails to locate the enclosing
+*		If a valid last element index is given then a 'walk
+*		search' is made for the enclosing element, starting with
+*		this element and crossing the faces of elements towards
+*		the position. This is efficient when successive positions
+*		are close together.
+*		If the walk search fails and the mesh has a location grid
+*		(see WlzCMeshSetLocGrid3D()) then the elements in the
+*		grid cell containing the position are searched.
+*		If these fail to locate the enclosing
 *		element a 'jump search' is used in which the grid cells
 *		of the conforming mesh are searched.
 *		For jump search to work coreectly the maximum edge
@@ -4954,7 +5435,12 @@ int             WlzCMeshElmEnclosingPos2D5(WlzCMesh2D5 *mesh,
 * 					debuging.
 * \param	dstCloseNod		If non NULL, then the value is set
 * 					to the index of the closest node
-* 					to the given position.
+* 					to the given position when the
+* 					jump search is used. If an element
+* 					is found using the location grid it
+* 					is set to the closest node of the
+* 					element and it is not set by the
+* 					walk search.
 */
 int             WlzCMeshElmEnclosingPos3D(WlzCMesh3D *mesh,
                                         int lastElmIdx,
@@ -4977,6 +5463,14 @@ int             WlzCMeshElmEnclosingPos3D(WlzCMesh3D *mesh,
     {
       elmIdx = WlzCMeshElmWalkPos3D(mesh, lastElmIdx, gPos);
     }
+    if((elmIdx < 0) && mesh->lGrid)
+    {
+      if(((elmIdx = WlzCMeshLocGridElmPos3D(mesh, gPos)) >= 0) &&
+         (dstCloseNod != NULL))
+      {
+	*dstCloseNod = WlzCMeshElmClosestNod3D(mesh, elmIdx, gPos);
+      }
+    }
     if(elmIdx < 0)
     {
       elmIdx = WlzCMeshElmJumpPos3D(mesh, gPos, dstCloseNod);
@@ -5408,8 +5902,12 @@ static double	WlzCMeshAddTolToBndAndClamp(double b, double c, double t)
 * \return	Element index or negative value if no enclosing element found.
 * \ingroup	WlzMesh
 * \brief	Locates the element of the conforming mesh which encloses
-*		the given position by testing the given element and it's
-*		immediate edge neighbours.
+*		the given position by walking from the given element
+*		towards the position. At each step the walk crosses the
+*		edge for which the barycentric coordinate of the position
+*		(with respect to the edge's opposite node) is most
+*		negative. The walk fails if it reaches the mesh boundary
+*		or if it takes more than WLZ_CMESH_WALK_MAXSTEP steps.
 * \param	mesh			The mesh.
 * \param	elmIdx			Index of first element to test.
 * \param	gPos			Test position.
@@ -5417,31 +5915,60 @@ static double	WlzCMeshAddTolToBndAndClamp(double b, double c, double t)
 static int	WlzCMeshElmWalkPos2D(WlzCMesh2D *mesh, int elmIdx,
 				     WlzDVertex2 gPos)
 {
-  int		idE;
-  WlzCMeshElm2D	*elm0,
-  		*elm1;
+  int		idS,
+  		fndIdx = -1;
+  WlzCMeshElm2D	*elm;
 
   if((elmIdx >= 0) && (elmIdx < mesh->res.elm.maxEnt))
   {
-    elm0 = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
-    if(WlzCMeshElmEnclosesPos2D(elm0, gPos) == 0)
+    elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
+    for(idS = 0; (elm != NULL) && (elm->idx >= 0) &&
+                 (idS < WLZ_CMESH_WALK_MAXSTEP); ++idS)
     {
-      elmIdx = -1;
+      int	idE,
+      		minE = -1;
+      double	a,
+      		minB = 0.0;
+
+      /* Find the edge across which the position lies furthest. */
+      if((a = WlzGeomTriangleSnArea2(elm->edu[0].nod->pos,
+				     elm->edu[1].nod->pos,
+				     elm->edu[2].nod->pos)) == 0.0)
+      {
+        break;
+      }
       for(idE = 0; idE < 3; ++idE)
       {
-	if(elm0->edu[idE].opp)
+	double	b;
+	WlzCMeshEdgU2D *edu;
+
+	edu = elm->edu + idE;
+	b = WlzGeomTriangleSnArea2(edu->nod->pos, edu->next->nod->pos,
+				   gPos) / a;
+	if(b < minB)
 	{
-	  elm1 = elm0->edu[idE].opp->elm;
-	  if(WlzCMeshElmEnclosesPos2D(elm1, gPos) != 0)
-	  {
-	    elmIdx = elm1->idx;
-	    break;
-	  }
+	  minB = b;
+	  minE = idE;
+	}
+      }
+      if(minE < 0)
+      {
+        fndIdx = elm->idx;
+	break;
+      }
+      else if(elm->edu[minE].opp == NULL)
+      {
+	/* On or beyond the mesh boundary. */
+	if(WlzCMeshElmEnclosesPos2D(elm, gPos))
+	{
+	  fndIdx = elm->idx;
 	}
+	break;
       }
+      elm = elm->edu[minE].opp->elm;
     }
   }
-  return(elmIdx);
+  return(fndIdx);
 }
 
 /*!
@@ -5629,8 +6156,12 @@ static int	WlzCMeshElmExhaustivePos3D(WlzCMesh3D *mesh, WlzDVertex3 gPos,
 * \return	Element index or negative value if no enclosing element found.
 * \ingroup	WlzMesh
 * \brief	Locates the element of the conforming mesh which encloses
-*		the given position by testing the given element and it's
-*		immediate face neighbours.
+*		the given position by walking from the given element
+*		towards the position. At each step the walk crosses the
+*		face for which the barycentric coordinate of the position
+*		(with respect to the face's opposite node) is most
+*		negative. The walk fails if it reaches the mesh boundary
+*		or if it takes more than WLZ_CMESH_WALK_MAXSTEP steps.
 * \param	mesh			The mesh.
 * \param	elmIdx			Index of first element to test.
 * \param	gPos			Test position.
@@ -5638,31 +6169,152 @@ static int	WlzCMeshElmExhaustivePos3D(WlzCMesh3D *mesh, WlzDVertex3 gPos,
 static int	WlzCMeshElmWalkPos3D(WlzCMesh3D *mesh, int elmIdx,
 				     WlzDVertex3 gPos)
 {
-  int		idF;
-  WlzCMeshElm3D	*elm0,
-  		*elm1;
+  int		idS,
+  		fndIdx = -1;
+  WlzCMeshElm3D	*elm;
 
   if((elmIdx >= 0) && (elmIdx < mesh->res.elm.maxEnt))
   {
-    elm0 = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
-    if(WlzCMeshElmEnclosesPos3D(elm0, gPos) == 0)
-    {
-      elmIdx = -1;
+    elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
+    for(idS = 0; (elm != NULL) && (elm->idx >= 0) &&
+                 (idS < WLZ_CMESH_WALK_MAXSTEP); ++idS)
+    {
+      int	idF,
+      		minF = -1;
+      double	minB = 0.0;
+      WlzDVertex3 cen;
+      WlzCMeshNod3D *nod[4];
+
+      /* Find the face across which the position lies furthest, using
+       * the centroid in place of the face's opposite node since it
+       * has a barycentric coordinate of 1/4. */
+      nod[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+      nod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+      nod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+      nod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+      cen.vtX = 0.25 * (nod[0]->pos.vtX + nod[1]->pos.vtX +
+                        nod[2]->pos.vtX + nod[3]->pos.vtX);
+      cen.vtY = 0.25 * (nod[0]->pos.vtY + nod[1]->pos.vtY +
+                        nod[2]->pos.vtY + nod[3]->pos.vtY);
+      cen.vtZ = 0.25 * (nod[0]->pos.vtZ + nod[1]->pos.vtZ +
+                        nod[2]->pos.vtZ + nod[3]->pos.vtZ);
       for(idF = 0; idF < 4; ++idF)
       {
-	if(elm0->face[idF].opp)
+	double	b,
+		v;
+	WlzCMeshFace *fce;
+
+	fce = elm->face + idF;
+	v = WlzGeomTetraSnVolume6(fce->edu[0].nod->pos, fce->edu[1].nod->pos,
+				  fce->edu[2].nod->pos, cen);
+	if(v == 0.0)
 	{
-	  elm1 = elm0->face[idF].opp->elm;
-	  if(WlzCMeshElmEnclosesPos3D(elm1, gPos) != 0)
-	  {
-	    elmIdx = elm1->idx;
-	    break;
-	  }
+	  minF = -2;
+	  break;
+	}
+	b = 0.25 * WlzGeomTetraSnVolume6(fce->edu[0].nod->pos,
+					 fce->edu[1].nod->pos,
+					 fce->edu[2].nod->pos, gPos) / v;
+	if(b < minB)
+	{
+	  minB = b;
+	  minF = idF;
+	}
+      }
+      if(minF == -2)
+      {
+        break;
+      }
+      else if(minF < 0)
+      {
+        fndIdx = elm->idx;
+	break;
+      }
+      else if((elm->face[minF].opp == NULL) ||
+	      (elm->face[minF].opp->elm == NULL))
+      {
+	/* On or beyond the mesh boundary. */
+	if(WlzCMeshElmEnclosesPos3D(elm, gPos))
+	{
+	  fndIdx = elm->idx;
 	}
+	break;
       }
+      elm = elm->face[minF].opp->elm;
     }
   }
-  return(elmIdx);
+  return(fndIdx);
+}
+
+/*!
+* \return	Index of the closest node of the element.
+* \ingroup	WlzMesh
+* \brief	Finds the node of the given 2D mesh element which is
+* 		closest to the given position.
+* \param	mesh			The mesh.
+* \param	elmIdx			Index of a valid element.
+* \param	gPos			Given position.
+*/
+static int	WlzCMeshElmClosestNod2D(WlzCMesh2D *mesh, int elmIdx,
+					WlzDVertex2 gPos)
+{
+  int		idN,
+  		nodIdx = -1;
+  double	d,
+  		minD = DBL_MAX;
+  WlzDVertex2	del;
+  WlzCMeshElm2D	*elm;
+
+  elm = (WlzCMeshElm2D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
+  for(idN = 0; idN < 3; ++idN)
+  {
+    WLZ_VTX_2_SUB(del, elm->edu[idN].nod->pos, gPos);
+    d = WLZ_VTX_2_SQRLEN(del);
+    if(d < minD)
+    {
+      minD = d;
+      nodIdx = elm->edu[idN].nod->idx;
+    }
+  }
+  return(nodIdx);
+}
+
+/*!
+* \return	Index of the closest node of the element.
+* \ingroup	WlzMesh
+* \brief	Finds the node of the given 3D mesh element which is
+* 		closest to the given position.
+* \param	mesh			The mesh.
+* \param	elmIdx			Index of a valid element.
+* \param	gPos			Given position.
+*/
+static int	WlzCMeshElmClosestNod3D(WlzCMesh3D *mesh, int elmIdx,
+					WlzDVertex3 gPos)
+{
+  int		idN,
+  		nodIdx = -1;
+  double	d,
+  		minD = DBL_MAX;
+  WlzDVertex3	del;
+  WlzCMeshElm3D	*elm;
+  WlzCMeshNod3D *nod[4];
+
+  elm = (WlzCMeshElm3D *)AlcVectorItemGet(mesh->res.elm.vec, elmIdx);
+  nod[0] = WLZ_CMESH_ELM3D_GET_NODE_0(elm);
+  nod[1] = WLZ_CMESH_ELM3D_GET_NODE_1(elm);
+  nod[2] = WLZ_CMESH_ELM3D_GET_NODE_2(elm);
+  nod[3] = WLZ_CMESH_ELM3D_GET_NODE_3(elm);
+  for(idN = 0; idN < 4; ++idN)
+  {
+    WLZ_VTX_3_SUB(del, nod[idN]->pos, gPos);
+    d = WLZ_VTX_3_SQRLEN(del);
+    if(d < minD)
+    {
+      minD = d;
+      nodIdx = nod[idN]->idx;
+    }
+  }
+  return(nodIdx);
 }
 
 /*!
@@ -6862,7 +7514,9 @@ WlzCMesh3D	*WlzCMeshFromObj3D(WlzObject *obj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    mesh = WlzCMeshFromBalLBTDom3D(lDom, idxObj, &errNum);
+    /* The elements are added to the cell grid once the mesh has been
+     * scaled. */
+    mesh = WlzCMeshBuildFromBalLBTDom3D(lDom, idxObj, &errNum);
   }
   (void )WlzFreeLBTDomain3D(lDom);
   WlzFreeObj(idxObj); idxObj = NULL;
@@ -6885,12 +7539,15 @@ WlzCMesh3D	*WlzCMeshFromObj3D(WlzObject *obj,
     /* Don't use the increment method of WlzCMeshBoundConform3D() it may
      * give zero volume elements, instead use the bisection method. */
     errNum = WlzCMeshBoundConform3D(mesh, obj, 0, 0.5);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    WlzCMeshUpdateBBox3D(mesh);
-    WlzCMeshUpdateMaxSqEdgLen3D(mesh);
-    errNum = WlzCMeshReassignGridCells3D(mesh, 0);
+    /* The bounding box, maximum edge length and cell grid are only
+     * invalid if the boundary has been conformed, as they are already
+     * updated by WlzCMeshAffineTransformMesh3D(). */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzCMeshUpdateBBox3D(mesh);
+      WlzCMeshUpdateMaxSqEdgLen3D(mesh);
+      errNum = WlzCMeshReassignGridCells3D(mesh, 0);
+    }
   }
   if(dstErr)
   {
@@ -7288,6 +7945,37 @@ WlzCMesh2D	*WlzCMeshFromBalLBTDom2D(WlzLBTDomain2D *lDom, WlzObject *iObj,
 */
 WlzCMesh3D	*WlzCMeshFromBalLBTDom3D(WlzLBTDomain3D *lDom, WlzObject *iObj,
 				         WlzErrorNum *dstErr)
+{
+  WlzCMesh3D	*mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  mesh = WlzCMeshBuildFromBalLBTDom3D(lDom, iObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshAddElmsToGrid3D(mesh);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
+/*!
+* \return	New mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Builds a 3D mesh from the given balanced LBT domain as
+*		described for WlzCMeshFromBalLBTDom3D(), but without adding
+*		the mesh elements to the cell grid. The nodes are in the
+*		cell grid and all element connectivities are set.
+*		The elements are created without being located, with their
+*		opposite faces then being found in a single pass.
+* \param	lDom			Linear binary tree domain.
+* \param	iObj			Index object for lDom.
+* \param        dstErr			Destination error pointer may be NULL.
+*/
+static WlzCMesh3D *WlzCMeshBuildFromBalLBTDom3D(WlzLBTDomain3D *lDom,
+					WlzObject *iObj, WlzErrorNum *dstErr)
 {
   int		idN;
   WlzIVertex3	bSz;
@@ -7343,6 +8031,11 @@ WlzCMesh3D	*WlzCMeshFromBalLBTDom3D(WlzLBTDomain3D *lDom, WlzObject *iObj,
       ++idN;
     }
   }
+  /* Connect the opposite faces of all the elements together. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshSetOppFces3D(mesh);
+  }
   /* Free temporary storage. */
   WlzGreyValueFreeWSp(iGVWSp);
   if(dstErr)
@@ -7352,6 +8045,165 @@ WlzCMesh3D	*WlzCMeshFromBalLBTDom3D(WlzLBTDomain3D *lDom, WlzObject *iObj,
   return(mesh);
 }
 
+/*!
+* \return	New mesh or NULL on error.
+* \ingroup	WlzMesh
+* \brief	Makes a new 3D conforming mesh from the given compact 3D
+* 		mesh. The node and element indices of the compact mesh are
+* 		preserved, with free nodes and elements of the compact mesh
+* 		being deleted nodes and elements of the new mesh. If the
+* 		compact mesh adjacencies are valid then each node's edge
+* 		use ring starts at the first edge use of the node's ring
+* 		in the compact mesh. As for the LBT domain mesh builder
+* 		the elements are created without being located, with their
+* 		opposite faces being found and the nodes and elements
+* 		added to the cell grid in bulk once all the elements have
+* 		been created.
+* \param	arr			Given compact mesh.
+* \param	allowFlip		Allow flipping of element node order
+* 					to get valid elements.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzCMesh3D	*WlzCMeshFromArr3D(WlzCMeshArr3D *arr, int allowFlip,
+				   WlzErrorNum *dstErr)
+{
+  int		idE,
+  		idN;
+  WlzCMesh3D	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(arr == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    mesh = WlzCMeshNew3D(&errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((AlcVectorExtend(mesh->res.nod.vec, arr->maxNod) != ALC_ER_NONE) ||
+       (AlcVectorExtend(mesh->res.elm.vec, arr->maxElm) != ALC_ER_NONE))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Create the nodes, these are added to the cell grid once it has been
+   * sized using the mesh bounding box. */
+  idN = 0;
+  while((errNum == WLZ_ERR_NONE) && (idN < arr->maxNod))
+  {
+    WlzCMeshNod3D *nod;
+
+    if((nod = WlzCMeshAllocNod3D(mesh)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      nod->flags = arr->nodFlags[idN];
+      nod->pos.vtX = arr->nodX[idN];
+      nod->pos.vtY = arr->nodY[idN];
+      nod->pos.vtZ = arr->nodZ[idN];
+      nod->edu = NULL;
+      nod->next = NULL;
+      if(arr->nodIdx[idN] < 0)
+      {
+        WlzCMeshNodFree3D(mesh, nod);
+      }
+    }
+    ++idN;
+  }
+  /* Create the elements. */
+  idE = 0;
+  while((errNum == WLZ_ERR_NONE) && (idE < arr->maxElm))
+  {
+    WlzCMeshElm3D *elm;
+
+    if((elm = WlzCMeshAllocElm3D(mesh)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      elm->cElm = NULL;
+      if(arr->elmIdx[idE] >= 0)
+      {
+	int	*eNod;
+	AlcVector *vec;
+
+	vec = mesh->res.nod.vec;
+	eNod = arr->elmNod + 4 * idE;
+	errNum = WlzCMeshSetElmFce3D(mesh, elm,
+			(WlzCMeshNod3D *)AlcVectorItemGet(vec, eNod[0]),
+			(WlzCMeshNod3D *)AlcVectorItemGet(vec, eNod[1]),
+			(WlzCMeshNod3D *)AlcVectorItemGet(vec, eNod[2]),
+			(WlzCMeshNod3D *)AlcVectorItemGet(vec, eNod[3]),
+			allowFlip, 0);
+	elm->flags = arr->elmFlags[idE];
+      }
+      else
+      {
+	WlzCMeshElmFree3D(mesh, elm);
+      }
+    }
+    ++idE;
+  }
+  /* If the compact mesh has valid edge use rings then start each node's
+   * edge use ring at the same edge use. */
+  if((errNum == WLZ_ERR_NONE) && arr->adjValid)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idN = 0; idN < arr->maxNod; ++idN)
+    {
+      if((arr->nodIdx[idN] >= 0) &&
+         (arr->ringOff[idN] < arr->ringOff[idN + 1]))
+      {
+	int	idU,
+		r;
+	WlzCMeshNod3D *nod;
+	WlzCMeshFace *fce;
+
+	r = arr->ringElm[arr->ringOff[idN]];
+	nod = (WlzCMeshNod3D *)AlcVectorItemGet(mesh->res.nod.vec, idN);
+	fce = ((WlzCMeshElm3D *)
+	       AlcVectorItemGet(mesh->res.elm.vec, r / 4))->face + (r % 4);
+	for(idU = 0; idU < 3; ++idU)
+	{
+	  if(fce->edu[idU].nod == nod)
+	  {
+	    nod->edu = fce->edu + idU;
+	    break;
+	  }
+	}
+      }
+    }
+  }
+  /* Connect the opposite faces, then add the nodes and elements to
+   * the cell grid. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzCMeshSetOppFces3D(mesh);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzCMeshUpdateBBox3D(mesh);
+    errNum = WlzCMeshReassignGridCells3D(mesh, 0);
+  }
+  if((errNum != WLZ_ERR_NONE) && (mesh != NULL))
+  {
+    (void )WlzCMeshFree3D(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
 /*!
 * \return       Woolz error code.
 * \ingroup      WlzMesh
@@ -8488,10 +9340,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D0(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8572,10 +9424,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D1(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8657,10 +9509,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D2(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8742,10 +9594,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D3(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8828,10 +9680,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D4(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -8915,10 +9767,10 @@ static WlzErrorNum WlzCMeshElmsFromLBTNode3D5(WlzCMesh3D *mesh,
   idE = 0;
   while((errNum == WLZ_ERR_NONE) && (idE < nElm))
   {
-    mElm[idE] = WlzCMeshNewElm3D(mesh, mNod[nodTbl[idE][0]],
-                                       mNod[nodTbl[idE][1]],
-				       mNod[nodTbl[idE][2]],
-				       mNod[nodTbl[idE][3]], 0, &errNum);
+    mElm[idE] = WlzCMeshNewLBTElm3D(mesh, mNod[nodTbl[idE][0]],
+                                          mNod[nodTbl[idE][1]],
+				          mNod[nodTbl[idE][2]],
+				          mNod[nodTbl[idE][3]], &errNum);
     ++idE;
   }
   if(errNum == WLZ_ERR_NONE)
@@ -666,6 +666,15 @@ extern WlzAffineTransform 	*WlzAffineTransformLSqDQ3D(
 				  WlzDVertex3 *nT,
 				  WlzDVertex3 *nS,
 				  WlzErrorNum *dstErr);
+extern WlzAffineTransform 	*WlzAffineTransformLSqPlane(
+				  WlzVertexType vType,
+				  int nV,
+				  WlzVertexP vT,
+				  WlzVertexP nT,
+				  WlzVertexP vS,
+				  double *vW,
+				  WlzTransformType trType,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -1186,6 +1195,9 @@ extern WlzErrorNum		WlzBasisFnSetCMesh3D(
 				  WlzBasisFnTransform *basisTr);
 extern WlzErrorNum 		WlzBasisFnFreeTransform(
 				  WlzBasisFnTransform *basisTr);
+extern WlzErrorNum		WlzBasisFnTransformSetTol(
+				  WlzBasisFnTransform *basisTr,
+				  double tol);
 extern WlzObject		*WlzBasisFnTransformObj(
 				  WlzObject *srcObj,
 				  WlzBasisFnTransform *basisTr,
@@ -1238,6 +1250,22 @@ extern WlzBasisFnTransform 	*WlzBasisFnTrFromCPts3D(
 				  WlzCMesh3D *mesh,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzBasisFnTree.c							*
+************************************************************************/
+extern WlzBasisFnTree		*WlzBasisFnTreeMake(
+				  WlzBasisFn *basisFn,
+				  double tol,
+				  WlzErrorNum *dstErr);
+extern void			WlzBasisFnTreeFree(
+				  WlzBasisFnTree *tree);
+extern WlzErrorNum		WlzBasisFnSetTree(
+				  WlzBasisFn *basisFn,
+				  double tol);
+extern WlzDVertex3		WlzBasisFnTreeSum(
+				  WlzBasisFnTree *tree,
+				  WlzDVertex3 pos);
+
 /************************************************************************
 * WlzBoundaryUtils.c							*
 ************************************************************************/
@@ -1450,6 +1478,40 @@ extern WlzObject		*WlzClipObjToBox3D(
 				  WlzIBox3 clipBox,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzCMeshArr.c								*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzCMeshArr3D		*WlzCMeshArrNew3D(
+				  int nodSz,
+				  int elmSz,
+				  WlzErrorNum *dstErr);
+extern void			WlzCMeshArrFree3D(
+				  WlzCMeshArr3D *arr);
+extern int			WlzCMeshArrNewNod3D(
+				  WlzCMeshArr3D *arr,
+				  WlzDVertex3 pos,
+				  WlzErrorNum *dstErr);
+extern int			WlzCMeshArrNewElm3D(
+				  WlzCMeshArr3D *arr,
+				  int nod0,
+				  int nod1,
+				  int nod2,
+				  int nod3,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzCMeshArrDelNod3D(
+				  WlzCMeshArr3D *arr,
+				  int idx);
+extern WlzErrorNum		WlzCMeshArrDelElm3D(
+				  WlzCMeshArr3D *arr,
+				  int idx);
+extern WlzErrorNum		WlzCMeshArrSetAdj3D(
+				  WlzCMeshArr3D *arr);
+extern WlzCMeshArr3D		*WlzCMeshArrFromCMesh3D(
+				  WlzCMesh3D *mesh,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzCMeshCurvature.c							*
 ************************************************************************/
@@ -1501,6 +1563,26 @@ extern WlzDVertex2		WlzCMeshClosePointDom2D5(
 				  double scale,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzCMeshLocGrid.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzCMeshSetLocGrid2D(
+				  WlzCMesh2D *mesh);
+extern WlzErrorNum		WlzCMeshSetLocGrid3D(
+				  WlzCMesh3D *mesh);
+extern void			WlzCMeshFreeLocGrid2D(
+				  WlzCMesh2D *mesh);
+extern void			WlzCMeshFreeLocGrid3D(
+				  WlzCMesh3D *mesh);
+extern int			WlzCMeshLocGridElmPos2D(
+				  WlzCMesh2D *mesh,
+				  WlzDVertex2 pos);
+extern int			WlzCMeshLocGridElmPos3D(
+				  WlzCMesh3D *mesh,
+				  WlzDVertex3 pos);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzCMeshScan.c							*
 ************************************************************************/
@@ -1565,6 +1647,16 @@ extern WlzErrorNum     		WlzCMeshFMarNodes3D(
 				  double *distances,
 				  int sizeArraySeedPos,
 				  WlzDVertex3 *arraySeedPos);
+extern WlzErrorNum     		WlzCMeshFIMNodes2D(
+				  WlzCMesh2D *mesh,
+				  double *distances,
+				  int sizeArraySeedPos,
+				  WlzDVertex2 *arraySeedPos);
+extern WlzErrorNum     		WlzCMeshFIMNodes3D(
+				  WlzCMesh3D *mesh,
+				  double *distances,
+				  int sizeArraySeedPos,
+				  WlzDVertex3 *arraySeedPos);
 #endif /* WLZ_EXT_BIND */
 extern WlzObject		*WlzCMeshDistance2D(
 				  WlzObject *mObj,
@@ -1580,6 +1672,22 @@ extern WlzObject		*WlzCMeshDistance3D(
 				  WlzDVertex3 *arraySeeds,
                                   WlzInterpolationType itp,
 				  WlzErrorNum *dstErr);
+#ifndef WLZ_EXT_BIND
+extern WlzObject		*WlzCMeshDistanceFIM2D(
+				  WlzObject *mObj,
+				  WlzObjectType rObjType,
+				  int sizeArraySeeds,
+				  WlzDVertex2 *arraySeeds,
+                                  WlzInterpolationType itp,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzCMeshDistanceFIM3D(
+				  WlzObject *mObj,
+				  WlzObjectType rObjType,
+				  int sizeArraySeeds,
+				  WlzDVertex3 *arraySeeds,
+                                  WlzInterpolationType itp,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
 
 /************************************************************************
 * WlzCMeshTransform.c							*
@@ -3560,6 +3668,24 @@ extern WlzErrorNum 		WlzGreyInvertMinMax(
 				  WlzPixelV min,
 				  WlzPixelV max);
 
+/************************************************************************
+* WlzGreyLineScan.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzGreyLineWSpace	*WlzGreyLineScanInit(
+				  WlzObject *obj,
+				  int write,
+				  WlzErrorNum *dstErr);
+extern void			WlzGreyLineScanFree(
+				  WlzGreyLineWSpace *lWSp);
+extern WlzErrorNum		WlzGreyLineScanNext(
+				  WlzGreyLineWSpace *lWSp);
+extern WlzErrorNum		WlzGreyLineScanLine(
+				  WlzGreyLineWSpace *lWSp,
+				  int pl,
+				  int ln);
+#endif /* !WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzGreyMask.c								*
 ************************************************************************/
@@ -3742,6 +3868,12 @@ extern void	                WlzGreyValueGetDir(
 				  int plane,
 				  int line,
 				  int kol);
+extern WlzErrorNum		WlzGreyValueGetN(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzInterpolationType interp,
+				  size_t n,
+				  WlzDVertex3 *pos,
+				  double *val);
 
 
 /************************************************************************
@@ -4680,6 +4812,12 @@ extern WlzCMesh3D               *WlzCMeshFromBalLBTDom3D(
                                   WlzLBTDomain3D *lDom,
                                   WlzObject *iObj,
                                   WlzErrorNum *dstErr);
+#ifndef WLZ_EXT_BIND
+extern WlzCMesh3D		*WlzCMeshFromArr3D(
+				  WlzCMeshArr3D *arr,
+				  int allowFlip,
+				  WlzErrorNum *dstErr);
+#endif /* WLZ_EXT_BIND */
 extern WlzCMeshP		WlzCMeshFromObj(
 				  WlzObject *obj,
 				  double minElmSz,
@@ -5560,6 +5698,25 @@ extern WlzAffineTransform	*WlzRegICPVertices(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr);
+extern WlzAffineTransform	*WlzRegICPVerticesExt(
+				  WlzVertexP tVx,
+				  WlzVertexP tNr,
+				  int tCnt,
+				  WlzVertexP sVx,
+				  WlzVertexP sNr,
+				  int sCnt,
+				  WlzVertexType vType,
+				  int sgnNrm,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  int *dstConv,
+				  int *dstItr,
+				  int maxItr,
+				  double delta,
+				  double minDistWgt,
+				  int ptPlane,
+				  double trim,
+				  WlzErrorNum *dstErr);
 extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
 				  AlcKDTTree *tree,
 				  WlzTransformType trType,
@@ -5583,6 +5740,31 @@ extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr); 
+extern WlzAffineTransform	*WlzRegICPTreeAndVerticesExt(
+				  AlcKDTTree *tree,
+				  WlzTransformType trType,
+				  WlzVertexType vType,
+				  int sgnNrm,
+				  int nT,
+				  WlzVertexP tVx,
+				  WlzVertexP tNr,
+				  int nS,
+				  int *sIdx,
+				  WlzVertexP sVx,
+				  WlzVertexP sNr,
+				  WlzVertexP tVxBuf,
+				  WlzVertexP sVxBuf,
+				  double *wgtBuf,
+				  int maxItr,
+				  WlzAffineTransform *initTr,
+				  int *dstConv,
+				  WlzRegICPUsrWgtFn usrWgtFn,
+				  void *usrWgtData,
+				  double delta,
+				  double minDistWgt,
+				  int ptPlane,
+				  double trim,
+				  WlzErrorNum *dstErr);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6058,6 +6240,10 @@ extern WlzObject 		*WlzStructDilation(
 				  WlzObject *obj,
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
+extern WlzObject 		*WlzStructGreyDilation(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzStructErosion.c							*
@@ -6065,6 +6251,29 @@ extern WlzObject 		*WlzStructDilation(
 extern WlzObject 		*WlzStructErosion(WlzObject *obj,
 				  WlzObject *structElm,
 				  WlzErrorNum *dstErr);
+extern WlzObject 		*WlzStructGreyErosion(
+				  WlzObject *obj,
+				  WlzObject *structElm,
+				  WlzErrorNum *dstErr);
+
+/************************************************************************
+* WlzStructRuns.c							*
+************************************************************************/
+extern int			WlzStructRunsApplicable(
+				  WlzObject *obj,
+				  WlzObject *sObj,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzStructRunsDomain(
+				  WlzObject *obj,
+				  WlzObject *sObj,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzStructRunsGrey(
+				  WlzObject *gObj,
+				  WlzObject *sObj,
+				  int dilate,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzRGBAConvert.c							*
@@ -6234,6 +6443,26 @@ extern WlzObject 		*WlzThreshold(
 				  WlzThresholdType highlow,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzTiledValueCodec.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzTiledValueTileEncode(
+				  WlzTiledValueCodec codec,
+				  size_t gSz,
+				  size_t nBytes,
+				  void *src,
+				  void *dst,
+				  size_t *dstSz);
+extern WlzErrorNum		WlzTiledValueTileDecode(
+				  WlzTiledValueCodec codec,
+				  size_t gSz,
+				  size_t nBytes,
+				  void *src,
+				  size_t srcSz,
+				  void *dst);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzTiledValues.c							*
 ************************************************************************/
@@ -6263,9 +6492,24 @@ extern void			WlzFreeTiledValueBuffer(
 extern void			WlzTiledValueBufferFlush(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
-extern void			WlzTiledValueBufferFill(
+extern WlzErrorNum		WlzTiledValueBufferFill(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
+extern WlzErrorNum		WlzMakeTiledValueCache(
+				  WlzTiledValues *tv,
+				  size_t maxSz,
+				  int nPrefetch);
+extern WlzErrorNum		WlzFreeTiledValueCache(
+				  WlzTiledValueCache *tc);
+extern WlzErrorNum		WlzTiledValueCacheFlush(
+				  WlzTiledValueCache *tc);
+extern WlzErrorNum		WlzTiledValueCacheAccess(
+				  WlzTiledValueCache *tc,
+				  size_t idx,
+				  size_t off,
+				  size_t n,
+				  void *buf,
+				  int write);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
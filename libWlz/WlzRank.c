@@ -46,43 +46,93 @@ static char _WlzRank_c[] = "University of Edinburgh $Id$";
 #include <limits.h>
 #include <string.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzRankWSp
+* \ingroup	WlzValuesFilters
+* \brief	Workspace for rank filtering. This holds a circular buffer
+* 		of the planes within the filter window, with the values
+* 		of each plane held either as histogram bin indices (for
+* 		unsigned byte and short grey values) or as double values
+* 		(for all other grey types) together with a mask of the
+* 		voxels which are within the object's domain. A 2D object
+* 		is treated as a single plane.
+* 		Typedef: ::WlzRankWSp.
+*/
+typedef struct _WlzRankWSp
+{
+  int		dim;		/*!< Dimension of the object, 2 or 3. */
+  int		fSz;		/*!< Filter size. */
+  int		fSz2;		/*!< Filter offset, half the filter size. */
+  int		nBufPl;		/*!< Number of planes in the circular
+  				     buffers, fSz for 3D objects and 1
+				     for 2D objects. */
+  int		nBin;		/*!< Number of fine histogram bins or zero
+  				     if values are ranked by selection. */
+  int		binShift;	/*!< Right shift from a fine histogram bin
+  				     index to a coarse histogram bin
+				     index. */
+  int		binOff;		/*!< Offset added to a grey value to give
+  				     it's histogram bin index. */
+  double	rank;		/*!< Required rank. */
+  WlzGreyType	gType;		/*!< Grey type of the object. */
+  WlzIVertex3	org;		/*!< Origin of the object's bounding box. */
+  WlzIVertex3	sz;		/*!< Size of the object's bounding box. */
+  WlzUByte	**mBuf;		/*!< Circular buffer of plane masks. */
+  unsigned short **bBuf;	/*!< Circular buffer of planes of bin
+  				     indices, may be NULL. */
+  double	**dBuf;		/*!< Circular buffer of planes of values,
+  				     may be NULL. */
+  unsigned short *bOut;		/*!< Filtered plane of bin indices, may
+  				     be NULL. */
+  double	*dOut;		/*!< Filtered plane of values, may be
+  				     NULL. */
+} WlzRankWSp;
 
-static WlzErrorNum 		WlzRankFilterDomObj2D(
+static void			WlzRankFreeWSp(
+				  WlzRankWSp *wSp);
+static void			WlzRankFilterLnHist(
+				  WlzRankWSp *wSp,
+				  int pl,
+				  int ln,
+				  WlzUByte **mRow,
+				  unsigned short **bRow,
+				  int *hist,
+				  int *coarse);
+static void			WlzRankFilterLnSel(
+				  WlzRankWSp *wSp,
+				  int pl,
+				  int ln,
+				  WlzUByte **mRow,
+				  double **dRow,
+				  double *vBuf);
+static WlzErrorNum 		WlzRankFilterDomObj(
 				  WlzObject *gObj,
 				  int fSz,
 				  double rank);
-static WlzErrorNum 		WlzRankFilterDomObj3D(
+static WlzErrorNum		WlzRankFilterGetPlane(
+				  WlzRankWSp *wSp,
+				  WlzObject *gObj,
+				  int pl);
+static WlzErrorNum		WlzRankFilterSetPlane(
+				  WlzRankWSp *wSp,
+				  WlzObject *gObj,
+				  int pl);
+static WlzErrorNum		WlzRankFilterPlane(
+				  WlzRankWSp *wSp,
+				  int pl);
+static WlzRankWSp		*WlzRankMakeWSp(
 				  WlzObject *gObj,
 				  int fSz,
-				  double rank);
-static void     		WlzRankFilterValLn(WlzObject *gObj,
-				  WlzGreyValueWSpace *gVWSp,
-				  void **vBuf,
-				  WlzUByte **iBuf,
-				  void *rBuf,
-				  int lnPos,
-				  WlzGreyType vType,
-				  WlzIVertex2 bufSz,
-				  double rank);
-static void			WlzRankFilterValPl(
+				  double rank,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzRankFilterPlaneObj(
 				  WlzObject *gObj,
-				  WlzGreyValueWSpace *gVWSp,
-				  void ***vBuf,
-				  WlzUByte ***iBuf,
-				  void *rBuf,
-				  int plane,
-				  WlzGreyType vType,
-				  WlzIVertex3 bufSz,
-				  double rank);
-static void			WlzRankFilterValues(
-				  WlzGreyValueWSpace *gVWSp,
-				  int posZ,
-				  int posY,
-				  int posX,
-				  WlzGreyType vType,
-				  void *values,
-				  int nValues,
-				  double rank);
+				  int pl,
+				  WlzErrorNum *dstErr);
 
 /*!
 * \return	Woolz error code.
@@ -91,7 +141,15 @@ static void			WlzRankFilterValues(
 *		Each value of the given object is replaced by the n'th
 *		ranked value of the values in it's immediate neighborhood,
 *		where the neighborhood is a simple axis aligned cuboid
-*		with the size.
+*		with the size. Only values within the object's domain
+*		are ranked.
+*		Unsigned byte and short grey values are ranked using a
+*		sliding window histogram, so that the cost per value
+*		grows with the area of the window's face rather than with
+*		it's volume. Other grey values are ranked by selection.
+*		Lines of each plane are filtered in parallel and the
+*		object may have tiled values. RGBA values are not
+*		filtered.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
@@ -114,10 +172,6 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
   {
     errNum = WLZ_ERR_VALUES_NULL;
   }
-  else if(WlzGreyTableIsTiled(gObj->values.core->type))
-  {
-    errNum = WLZ_ERR_VALUES_TYPE;
-  }
   else if(fSz < 0)
   {
     errNum = WLZ_ERR_PARAM_DATA;
@@ -134,11 +188,9 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
     }
     switch(gObj->type)
     {
-      case WLZ_2D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
-	break;
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
+	errNum = WlzRankFilterDomObj(gObj, fSz, rank);
 	break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
@@ -151,100 +203,153 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
 /*!
 * \return	Woolz error code.
 * \ingroup      WlzValuesFilters
-* \brief	Applies a rank filter in place to the given Woolz object.
-*		Each value of the given object is replaced by the n'th
-*		ranked value of the values in it's immediate neighborhood,
-*		where the neighborhood is a simple axis aligned cube
-*		with the given size.
+* \brief	Applies a rank filter in place to the given 2D or 3D
+*		domain object. The planes which are within the filter
+*		window are read into the workspace's circular buffer,
+*		each plane is filtered and it's filtered values are then
+*		written back to the object. Because the filtered values
+*		of a plane are only written back once all planes which
+*		use it's values have been read, the filter uses only
+*		the given values.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
 *					0.0 minimum, 0.5 median and
 *					1.0 maximum.
 */
-static WlzErrorNum WlzRankFilterDomObj2D(WlzObject *gObj, int fSz,
-				         double rank)
+static WlzErrorNum WlzRankFilterDomObj(WlzObject *gObj, int fSz,
+				       double rank)
 {
-  int		bufLft,
-		bufRgt,
-		inLn,
-		fSz2,
-		itvWidth,
-		iBufWidth, 	      /* No of bytes in interval buffer line */
-		bufLn = 0,
-		outLn = 0;
-  void		*rBuf = NULL;
-  void		**vBuf = NULL;
-  WlzUByte	**iBuf = NULL;
-  WlzIVertex2	bufSz;
-  WlzGreyType	vType;
-  WlzDomain	gDom;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzGreyType	gType;
+  WlzRankWSp	*wSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  if(gObj->values.core == NULL)
+  gType = WlzGreyTypeFromObj(gObj, &errNum);
+  /* A filter of size one or less leaves the values unchanged and RGBA
+   * values are not filtered. */
+  if((errNum == WLZ_ERR_NONE) && (fSz > 1) && (gType != WLZ_GREY_RGBA))
   {
-    errNum = WLZ_ERR_VALUES_NULL;
+    wSp = WlzRankMakeWSp(gObj, fSz, rank, &errNum);
+  }
+  if(wSp)
+  {
+    int		inPl,
+    		outPl,
+		lastPl;
+
+    inPl = wSp->org.vtZ;
+    lastPl = wSp->org.vtZ + wSp->sz.vtZ - 1;
+    for(outPl = wSp->org.vtZ;
+        (errNum == WLZ_ERR_NONE) && (outPl <= lastPl); ++outPl)
+    {
+      int	reqPl;
+
+      /* Read all the planes needed to filter the output plane. */
+      reqPl = (wSp->dim == 2)? outPl: outPl + fSz - 1 - wSp->fSz2;
+      while((errNum == WLZ_ERR_NONE) && (inPl <= reqPl) &&
+	    (inPl <= lastPl))
+      {
+        errNum = WlzRankFilterGetPlane(wSp, gObj, inPl);
+	++inPl;
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzRankFilterPlane(wSp, outPl);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	errNum = WlzRankFilterSetPlane(wSp, gObj, outPl);
+      }
+    }
+  }
+  WlzRankFreeWSp(wSp);
+  return(errNum);
+}
+
+/*!
+* \return	New rank filter workspace.
+* \ingroup      WlzValuesFilters
+* \brief	Makes a new rank filter workspace for the given object.
+* \param	gObj			Given 2D or 3D domain object.
+* \param	fSz			Rank filter size.
+* \param	rank			Required rank.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzRankWSp		*WlzRankMakeWSp(
+				  WlzObject *gObj,
+				  int fSz,
+				  double rank,
+				  WlzErrorNum *dstErr)
+{
+  int		nPlVal = 0;
+  WlzRankWSp	*wSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((wSp = (WlzRankWSp *)AlcCalloc(1, sizeof(WlzRankWSp))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
   else
   {
-    fSz2 = fSz / 2;
-    gDom = gObj->domain;
-    bufSz.vtX = gDom.i->lastkl - gDom.i->kol1 + (2 * fSz2) + 1;
-    bufSz.vtY = fSz;
-    iBufWidth = (bufSz.vtX + 7) / 8;
-    vType = WlzGreyTypeFromObj(gObj, &errNum);
-    switch(vType)
+    wSp->fSz = fSz;
+    wSp->fSz2 = fSz / 2;
+    wSp->rank = rank;
+    wSp->gType = WlzGreyTypeFromObj(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzDomain	dom;
+
+    dom = gObj->domain;
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      wSp->dim = 2;
+      wSp->nBufPl = 1;
+      wSp->org.vtZ = 0;
+      wSp->sz.vtZ = 1;
+      wSp->org.vtY = dom.i->line1;
+      wSp->sz.vtY = dom.i->lastln - dom.i->line1 + 1;
+      wSp->org.vtX = dom.i->kol1;
+      wSp->sz.vtX = dom.i->lastkl - dom.i->kol1 + 1;
+    }
+    else
+    {
+      if(dom.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+      {
+        errNum = WLZ_ERR_DOMAIN_TYPE;
+      }
+      else
+      {
+	wSp->dim = 3;
+	wSp->nBufPl = ALG_MIN(fSz, dom.p->lastpl - dom.p->plane1 + 1);
+	wSp->org.vtZ = dom.p->plane1;
+	wSp->sz.vtZ = dom.p->lastpl - dom.p->plane1 + 1;
+	wSp->org.vtY = dom.p->line1;
+	wSp->sz.vtY = dom.p->lastln - dom.p->line1 + 1;
+	wSp->org.vtX = dom.p->kol1;
+	wSp->sz.vtX = dom.p->lastkl - dom.p->kol1 + 1;
+      }
+    }
+    nPlVal = wSp->sz.vtX * wSp->sz.vtY;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(wSp->gType)
     {
       case WLZ_GREY_UBYTE:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(WlzUByte))) == NULL) ||
-	   (AlcUnchar2Malloc((WlzUByte ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
+        wSp->nBin = 256;
+	wSp->binShift = 4;
+	wSp->binOff = 0;
 	break;
       case WLZ_GREY_SHORT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(short))) == NULL) ||
-	   (AlcShort2Malloc((short ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_INT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(int))) == NULL) ||
-	   (AlcInt2Malloc((int ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_FLOAT:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(float))) == NULL) ||
-	   (AlcFloat2Malloc((float ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
+        wSp->nBin = 65536;
+	wSp->binShift = 8;
+	wSp->binOff = 32768;
 	break;
+      case WLZ_GREY_INT:    /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT:  /* FALLTHROUGH */
       case WLZ_GREY_DOUBLE:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(double))) == NULL) ||
-	   (AlcDouble2Malloc((double ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_RGBA:
-	if(((rBuf = AlcMalloc(fSz * fSz * sizeof(WlzUInt))) == NULL) ||
-	   (AlcInt2Malloc((int ***)&vBuf,
-	   		     bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
+        wSp->nBin = 0;
 	break;
       default:
         errNum = WLZ_ERR_GREY_TYPE;
@@ -253,738 +358,650 @@ static WlzErrorNum WlzRankFilterDomObj2D(WlzObject *gObj, int fSz,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    if(AlcBit2Calloc(&iBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    if(AlcUnchar2Malloc(&(wSp->mBuf), wSp->nBufPl, nPlVal) != ALC_ER_NONE)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    else if(wSp->nBin > 0)
+    {
+      if((AlcShort2Malloc((short ***)&(wSp->bBuf), wSp->nBufPl,
+                          nPlVal) != ALC_ER_NONE) ||
+         ((wSp->bOut = (unsigned short *)
+	               AlcMalloc(sizeof(unsigned short) * nPlVal)) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    else
+    {
+      if((AlcDouble2Malloc(&(wSp->dBuf), wSp->nBufPl,
+                           nPlVal) != ALC_ER_NONE) ||
+         ((wSp->dOut = (double *)
+	               AlcMalloc(sizeof(double) * nPlVal)) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
   }
-  if(errNum == WLZ_ERR_NONE)
+  if(errNum != WLZ_ERR_NONE)
   {
-    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
+    WlzRankFreeWSp(wSp);
+    wSp = NULL;
   }
-  /* Work down through the object. */
-  if(errNum == WLZ_ERR_NONE)
+  if(dstErr)
   {
-    errNum = WlzInitGreyScan(gObj, &iWSp, &gWSp);
+    *dstErr = errNum;
   }
-  if(errNum == WLZ_ERR_NONE)
+  return(wSp);
+}
+
+/*!
+* \ingroup      WlzValuesFilters
+* \brief	Frees the given rank filter workspace.
+* \param	wSp			Given workspace, may be NULL.
+*/
+static void			WlzRankFreeWSp(
+				  WlzRankWSp *wSp)
+{
+  if(wSp)
+  {
+    (void )Alc2Free((void **)(wSp->mBuf));
+    (void )Alc2Free((void **)(wSp->bBuf));
+    (void )Alc2Free((void **)(wSp->dBuf));
+    AlcFree(wSp->bOut);
+    AlcFree(wSp->dOut);
+    AlcFree(wSp);
+  }
+}
+
+/*!
+* \return	New 2D domain object or NULL if the plane is empty.
+* \ingroup      WlzValuesFilters
+* \brief	Makes a 2D domain object which shares the domain and values
+* 		of the given plane of the given object. For a 2D object
+* 		it shares the domain and values of the given object
+* 		rather than assigning it, so that freeing it can not
+* 		free a given object which has not been assigned. Tiled
+* 		values are shared as a whole and must be scanned with
+* 		the plane position set in the interval workspace.
+* \param	gObj			Given 2D or 3D domain object.
+* \param	pl			Plane.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzRankFilterPlaneObj(
+				  WlzObject *gObj,
+				  int pl,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*obj2D = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
   {
-    inLn = gDom.i->line1 - 1;
-    while((errNum == WLZ_ERR_NONE) &&
-	  ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, gObj->domain, gObj->values,
+    			NULL, NULL, &errNum);
+  }
+  else
+  {
+    int		idx;
+    WlzDomain	dom2D;
+    WlzValues	val2D;
+
+    idx = pl - gObj->domain.p->plane1;
+    dom2D = gObj->domain.p->domains[idx];
+    if(WlzGreyTableIsTiled(gObj->values.core->type))
     {
-      if(iWSp.nwlpos)
-      {
-	while(inLn < iWSp.linpos)
-	{
-	  outLn = inLn - fSz2 - 1; 	         /* -1 because previous line */
-	  if(outLn >= gDom.i->line1)
-	  {
-	    WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf,
-			       outLn, vType, bufSz, rank);
-	  }
-	  ++inLn;
-	  bufLn = (inLn + bufSz.vtY - gDom.i->line1) % bufSz.vtY;
-	  WlzValueSetUByte(iBuf[bufLn], 0, iBufWidth);
-	}
-      }
-      bufLft = iWSp.lftpos + fSz2 - gDom.i->kol1;
-      bufRgt = iWSp.rgtpos + fSz2 - gDom.i->kol1;
-      itvWidth = bufRgt - bufLft + 1;
-      /* Set bits in the interval buffer */
-      WlzBitLnSetItv(iBuf[bufLn], bufLft, bufRgt, bufSz.vtX);
-      /* Copy values to value buffer. */
-      switch(vType)
-      {
-        case WLZ_GREY_UBYTE:
-	  (void )memcpy(*(((WlzUByte **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.ubp, itvWidth);
-          break;
-        case WLZ_GREY_SHORT:
-	  (void )memcpy(*(((short **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.shp, itvWidth * sizeof(short));
-          break;
-        case WLZ_GREY_INT:
-	  (void )memcpy(*(((int **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.inp, itvWidth * sizeof(int));
-          break;
-        case WLZ_GREY_FLOAT:
-	  (void )memcpy(*(((float **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.flp, itvWidth * sizeof(float));
-          break;
-        case WLZ_GREY_DOUBLE:
-	  (void )memcpy(*(((double **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.dbp, itvWidth * sizeof(double));
-          break;
-        case WLZ_GREY_RGBA:
-	  (void )memcpy(*(((WlzUInt **)vBuf) + bufLn) + bufLft,
-	                gWSp.u_grintptr.rgbp, itvWidth * sizeof(WlzUInt));
-          break;
-        default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
-      }
+      val2D = gObj->values;
     }
-    if(errNum == WLZ_ERR_EOO)
+    else
     {
-      errNum = WLZ_ERR_NONE;
+      val2D = gObj->values.vox->values[idx];
     }
+    if((dom2D.core != NULL) && (dom2D.core->type != WLZ_EMPTY_DOMAIN) &&
+       (val2D.core != NULL))
+    {
+      obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2D, val2D, NULL, NULL,
+                          &errNum);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj2D);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Reads the values of the given plane of the object into
+* 		the workspace's circular buffer, setting the plane's
+* 		mask.
+* \param	wSp			Rank filter workspace.
+* \param	gObj			Given object.
+* \param	pl			Plane to read.
+*/
+static WlzErrorNum		WlzRankFilterGetPlane(
+				  WlzRankWSp *wSp,
+				  WlzObject *gObj,
+				  int pl)
+{
+  int		bIdx;
+  WlzObject	*obj2D;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bIdx = (pl - wSp->org.vtZ) % wSp->nBufPl;
+  (void )memset(wSp->mBuf[bIdx], 0, wSp->sz.vtX * wSp->sz.vtY);
+  obj2D = WlzRankFilterPlaneObj(gObj, pl, &errNum);
+  if(obj2D)
+  {
+    WlzGreyWSpace gWSp;
+    WlzIntervalWSpace iWSp;
+
+    errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
     if(errNum == WLZ_ERR_NONE)
     {
-      while(++outLn <= gDom.i->lastln)
+      iWSp.plnpos = pl;
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	i,
+		off,
+		len;
+	WlzGreyP gP;
+
+	gP = gWSp.u_grintptr;
+	len = iWSp.rgtpos - iWSp.lftpos + 1;
+	off = ((iWSp.linpos - wSp->org.vtY) * wSp->sz.vtX) +
+	      iWSp.lftpos - wSp->org.vtX;
+	(void )memset(wSp->mBuf[bIdx] + off, 1, len);
+	switch(wSp->gType)
+	{
+	  case WLZ_GREY_UBYTE:
+	    for(i = 0; i < len; ++i)
+	    {
+	      wSp->bBuf[bIdx][off + i] = gP.ubp[i];
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      wSp->bBuf[bIdx][off + i] = gP.shp[i] + wSp->binOff;
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      wSp->dBuf[bIdx][off + i] = gP.inp[i];
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      wSp->dBuf[bIdx][off + i] = gP.flp[i];
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    (void )memcpy(wSp->dBuf[bIdx] + off, gP.dbp,
+	                  sizeof(double) * len);
+	    break;
+	  default:
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
       {
-	WlzRankFilterValLn(gObj, gVWSp, vBuf, iBuf, rBuf, 
-			   outLn, vType, bufSz, rank);
-	bufLn = (++inLn + bufSz.vtY - gDom.i->line1) % bufSz.vtY;
-        WlzValueSetUByte(iBuf[bufLn], 0, iBufWidth);
+        errNum = WLZ_ERR_NONE;
       }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
     }
-    WlzEndGreyScan(&iWSp, &gWSp);
+    (void )WlzFreeObj(obj2D);
   }
-  AlcFree(rBuf);
-  Alc2Free((void **)iBuf);
-  Alc2Free(vBuf);
-  WlzGreyValueFreeWSp(gVWSp);
   return(errNum);
 }
 
 /*!
 * \return	Woolz error code.
 * \ingroup      WlzValuesFilters
-* \brief	Applies a rank filter in place to the given Woolz object.
-*		Each value of the given object is replaced by the n'th
-*		ranked value of the values in it's immediate neighborhood,
-*		where the neighborhood is a simple axis aligned cuboid
-*		with the given width.
+* \brief	Writes the filtered values of the given plane from the
+* 		workspace back to the object.
+* \param	wSp			Rank filter workspace.
 * \param	gObj			Given object.
-* \param	fSz			Rank filter size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \param	pl			Plane to write.
 */
-static WlzErrorNum WlzRankFilterDomObj3D(WlzObject *gObj, int fSz,
-				         double rank)
+static WlzErrorNum		WlzRankFilterSetPlane(
+				  WlzRankWSp *wSp,
+				  WlzObject *gObj,
+				  int pl)
 {
-  int		bufPl,
-		plIdx,
-		pnCnt,
-		outPl,
-		fSz2;
-  void		*rBuf = NULL;
-  void		***vBuf = NULL;
-  WlzUByte	***iBuf = NULL;
-  WlzObject	*obj2D = NULL;
-  WlzValues	dummyValues;
-  WlzDomain	dummyDom,
-  		gDom;
-  WlzIVertex3	bufSz;
-  WlzIVertex2	bufOrg2D,
-  		bufSz2D;
-  WlzGreyType	vType;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzObject	*obj2D;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  dummyDom.core = NULL;
-  dummyValues.core = NULL;
-  if(gObj->values.core == NULL)
-  {
-    errNum = WLZ_ERR_VALUES_NULL;
-  }
-  if(errNum == WLZ_ERR_NONE)
+  obj2D = WlzRankFilterPlaneObj(gObj, pl, &errNum);
+  if(obj2D)
   {
-    fSz2 = fSz / 2;
-    gDom = gObj->domain;
-    bufSz2D.vtX = bufSz.vtX = gDom.p->lastkl - gDom.p->kol1 + (2 * fSz2) + 1;
-    bufSz2D.vtY = bufSz.vtY = gDom.p->lastln - gDom.p->line1 + (2 * fSz2) + 1;
-    bufSz.vtZ = fSz;
-    vType = WlzGreyTypeFromObj(gObj, &errNum);
-    switch(vType)
+    WlzGreyWSpace gWSp;
+    WlzIntervalWSpace iWSp;
+
+    errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
+    if(errNum == WLZ_ERR_NONE)
     {
-      case WLZ_GREY_UBYTE:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(WlzUByte))) == NULL) ||
-	   (AlcUnchar3Malloc((WlzUByte ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_SHORT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(short))) == NULL) ||
-	   (AlcShort3Malloc((short ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_INT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(int))) == NULL) ||
-	   (AlcInt3Malloc((int ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_FLOAT:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(float))) == NULL) ||
-	   (AlcFloat3Malloc((float ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_DOUBLE:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(double))) == NULL) ||
-	   (AlcDouble3Malloc((double ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
-	}
-	break;
-      case WLZ_GREY_RGBA:
-	if(((rBuf = AlcMalloc(fSz * fSz * fSz * sizeof(WlzUInt))) == NULL) ||
-	   (AlcInt3Malloc((int ****)&vBuf,
-	   		     bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+      iWSp.plnpos = pl;
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	i,
+		off,
+		len;
+	WlzGreyP gP;
+
+	gP = gWSp.u_grintptr;
+	len = iWSp.rgtpos - iWSp.lftpos + 1;
+	off = ((iWSp.linpos - wSp->org.vtY) * wSp->sz.vtX) +
+	      iWSp.lftpos - wSp->org.vtX;
+	switch(wSp->gType)
 	{
-	  errNum = WLZ_ERR_MEM_ALLOC;
+	  case WLZ_GREY_UBYTE:
+	    for(i = 0; i < len; ++i)
+	    {
+	      gP.ubp[i] = (WlzUByte )(wSp->bOut[off + i]);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      gP.shp[i] = (short )(wSp->bOut[off + i] - wSp->binOff);
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      gP.inp[i] = (int )(wSp->dOut[off + i]);
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(i = 0; i < len; ++i)
+	    {
+	      gP.flp[i] = (float )(wSp->dOut[off + i]);
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    (void )memcpy(gP.dbp, wSp->dOut + off, sizeof(double) * len);
+	    break;
+	  default:
+	    break;
 	}
-	break;
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
     }
+    (void )WlzFreeObj(obj2D);
   }
-  if(errNum == WLZ_ERR_NONE)
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Rank filters the given plane, with all the planes within
+* 		the filter window already in the workspace's circular
+* 		buffer, putting the filtered values into the workspace's
+* 		output plane. The lines of the plane are filtered in
+* 		parallel, with each thread having it's own histograms
+* 		or selection buffer.
+* \param	wSp			Rank filter workspace.
+* \param	pl			Plane to filter.
+*/
+static WlzErrorNum		WlzRankFilterPlane(
+				  WlzRankWSp *wSp,
+				  int pl)
+{
+  int		nRow;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nRow = (wSp->dim == 2)? wSp->fSz: wSp->fSz * wSp->fSz;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
   {
-    if(AlcBit3Calloc(&iBuf, bufSz.vtZ, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    int		*hist = NULL;
+    double	*vBuf = NULL;
+    WlzUByte	**mRow = NULL;
+    void	**vRow = NULL;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    if(((mRow = (WlzUByte **)AlcMalloc(sizeof(WlzUByte *) * nRow)) == NULL) ||
+       ((vRow = (void **)AlcMalloc(sizeof(void *) * nRow)) == NULL))
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      errNum2 = WLZ_ERR_MEM_ALLOC;
     }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
-    			NULL, NULL, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
-  }
-  /* Work down through the object. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    plIdx = 0;
-    outPl = gDom.p->plane1 + plIdx - fSz2;
-    pnCnt = gDom.p->lastpl - gDom.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    else if(wSp->nBin > 0)
     {
-      if((errNum == WLZ_ERR_NONE) && (outPl >= gDom.p->plane1))
+      /* Fine histogram followed by the coarse histogram. */
+      if((hist = (int *)AlcCalloc(wSp->nBin + (wSp->nBin >> wSp->binShift),
+                                  sizeof(int))) == NULL)
       {
-        WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			   outPl, vType, bufSz, rank);
+        errNum2 = WLZ_ERR_MEM_ALLOC;
       }
-      bufPl = (gDom.p->plane1 + plIdx) % bufSz.vtZ;
-      obj2D->domain = *(gObj->domain.p->domains + plIdx);
-      obj2D->values = *(gObj->values.vox->values + plIdx);
-      if(errNum == WLZ_ERR_NONE)
+    }
+    else
+    {
+      if((vBuf = (double *)AlcMalloc(sizeof(double) * nRow *
+                                     wSp->fSz)) == NULL)
       {
-        bufOrg2D.vtX = obj2D->domain.i->kol1 - fSz2;
-	bufOrg2D.vtY = obj2D->domain.i->line1 - fSz2;
-	errNum = WlzToArray2D((void ***)(iBuf + bufPl), obj2D,
-			      bufSz2D, bufOrg2D, 0, WLZ_GREY_BIT);
+        errNum2 = WLZ_ERR_MEM_ALLOC;
       }
-      if(errNum == WLZ_ERR_NONE)
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      int	ln;
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(ln = 0; ln < wSp->sz.vtY; ++ln)
       {
-        errNum = WlzToArray2D((void ***)(vBuf + bufPl), obj2D,
-			      bufSz2D, bufOrg2D, 0, vType);
+	if(wSp->nBin > 0)
+	{
+	  WlzRankFilterLnHist(wSp, pl, ln, mRow, (unsigned short **)vRow,
+			      hist, hist + wSp->nBin);
+	}
+	else
+	{
+	  WlzRankFilterLnSel(wSp, pl, ln, mRow, (double **)vRow, vBuf);
+	}
       }
-      ++plIdx;
-      ++outPl;
     }
-    while((errNum == WLZ_ERR_NONE) && (outPl <= gDom.p->lastpl))
+    else
     {
-      WlzRankFilterValPl(gObj, gVWSp, vBuf, iBuf, rBuf,
-			 outPl, vType, bufSz, rank);
-      ++outPl;
+#ifdef _OPENMP
+#pragma omp critical
+      {
+#endif
+        errNum = errNum2;
+#ifdef _OPENMP
+      }
+#endif
     }
+    AlcFree(hist);
+    AlcFree(vBuf);
+    AlcFree(mRow);
+    AlcFree(vRow);
   }
-  if(obj2D)
+  return(errNum);
+}
+
+/*!
+* \return	Number of rows within the filter window.
+* \ingroup      WlzValuesFilters
+* \brief	Sets pointers to the mask and value rows (lines of the
+* 		buffered planes) which are within the filter window
+* 		centred on the given line and plane.
+* \param	wSp			Rank filter workspace.
+* \param	pl			Plane of the window centre.
+* \param	ln			Line of the window centre relative
+* 					to the workspace origin.
+* \param	mRow			Destination for mask row pointers.
+* \param	vRow			Destination for value row pointers.
+*/
+static int			WlzRankFilterRows(
+				  WlzRankWSp *wSp,
+				  int pl,
+				  int ln,
+				  WlzUByte **mRow,
+				  void **vRow)
+{
+  int		y,
+		z,
+  		y0,
+  		y1,
+  		z0,
+		z1,
+		nRow = 0;
+
+  y0 = ALG_MAX(ln - wSp->fSz2, 0);
+  y1 = ALG_MIN(ln - wSp->fSz2 + wSp->fSz - 1, wSp->sz.vtY - 1);
+  if(wSp->dim == 2)
   {
-    obj2D->domain = dummyDom;
-    obj2D->values = dummyValues;
-    WlzFreeObj(obj2D);
+    z0 = z1 = pl;
   }
-  AlcFree(rBuf);
-  Alc3Free((void ***)iBuf);
-  Alc3Free(vBuf);
-  WlzGreyValueFreeWSp(gVWSp);
-  return(errNum);
+  else
+  {
+    z0 = ALG_MAX(pl - wSp->fSz2, wSp->org.vtZ);
+    z1 = ALG_MIN(pl - wSp->fSz2 + wSp->fSz - 1,
+                 wSp->org.vtZ + wSp->sz.vtZ - 1);
+  }
+  for(z = z0; z <= z1; ++z)
+  {
+    int		bIdx;
+
+    bIdx = (z - wSp->org.vtZ) % wSp->nBufPl;
+    for(y = y0; y <= y1; ++y)
+    {
+      int	off;
+
+      off = y * wSp->sz.vtX;
+      mRow[nRow] = wSp->mBuf[bIdx] + off;
+      vRow[nRow] = (wSp->nBin > 0)? (void *)(wSp->bBuf[bIdx] + off):
+                                    (void *)(wSp->dBuf[bIdx] + off);
+      ++nRow;
+    }
+  }
+  return(nRow);
 }
 
 /*!
-* \return	void
 * \ingroup      WlzValuesFilters
-* \brief	Rank filter the buffer values for a single line.
-*		If possible the buffer of values to be ranked just has
-*		the values no longer used replaced by new values, rather
-*		than all the values in the buffer being re-entered.
-* \param	gObj			The object being filtered, needed 
-*					for random pixel access.
-* \param	gVWSp			Grey value workspace, needed for
-*					random pixel access.
-* \param	vBuf			Circular buffer of lines of grey
-*					values.
-* \param	iBuf			Circular buffer of lines of bits
-*					used to encode intervals.
-* \param	rBuf			A buffer used to rank pixels.
-* \param	line			The current line, with both past
-*					and future lines valid.
-* \param	vType			The grey value type.
-* \param	bufSz			The buffer size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \brief	Rank filters a single line of a plane using a sliding
+* 		window histogram (cf Huang, Yang and Tang's median filter).
+* 		The histogram has fine bins (one per grey value) and coarse
+* 		bins (each of which counts the values in a contiguous
+* 		run of fine bins). As the window moves along the line the
+* 		column of values leaving the window is removed from the
+* 		histogram and the column entering it is added. The coarse
+* 		bin holding the required rank and the count of values
+* 		below it are tracked incrementally, so only the fine bins
+* 		of a single coarse bin are searched for each value.
+* 		The histograms are left cleared for the next line.
+* \param	wSp			Rank filter workspace.
+* \param	pl			Plane being filtered.
+* \param	ln			Line being filtered, relative to the
+* 					workspace origin.
+* \param	mRow			Buffer for mask row pointers.
+* \param	bRow			Buffer for bin row pointers.
+* \param	hist			Cleared fine histogram.
+* \param	coarse			Cleared coarse histogram.
 */
-static void	WlzRankFilterValLn(WlzObject *gObj, WlzGreyValueWSpace *gVWSp,
-				   void **vBuf, WlzUByte **iBuf, void *rBuf,
-				   int line, WlzGreyType vType,
-				   WlzIVertex2 bufSz, double rank)
+static void			WlzRankFilterLnHist(
+				  WlzRankWSp *wSp,
+				  int pl,
+				  int ln,
+				  WlzUByte **mRow,
+				  unsigned short **bRow,
+				  int *hist,
+				  int *coarse)
 {
-  int		idK,
-		idX,
-		idY,
-		fSz2,
-		sameRCnt,
-		rCnt = 0;
-  WlzGreyV	gV0,
-  		gV1;
-  WlzGreyP	gP0,
-  		gP1;
-  WlzDomain	gDom;
-  WlzIVertex2	bufPos0,
-		bufPos1,
-  		objPos;
+  int		r,
+  		x,
+		x0,
+		x1,
+		c0,
+		c1,
+		nRow,
+		cIdx = 0,
+		cCnt = 0,
+		n = 0;
+  WlzUByte	*mOut;
+  unsigned short *bOut;
+  const int	shift = wSp->binShift;
 
-  gP0.v = gP1.v = NULL;
-  gDom = gObj->domain;
-  fSz2 = bufSz.vtY / 2;
-  bufPos1.vtY = line - gDom.i->line1 - fSz2 + bufSz.vtY;
-  for(idK = fSz2; idK < bufSz.vtX - fSz2; ++idK)
+  mOut = wSp->mBuf[(pl - wSp->org.vtZ) % wSp->nBufPl] + (ln * wSp->sz.vtX);
+  bOut = wSp->bOut + (ln * wSp->sz.vtX);
+  /* Find the first and last values of the line within the domain. */
+  for(x0 = 0; (x0 < wSp->sz.vtX) && (mOut[x0] == 0); ++x0)
   {
-    objPos.vtX = gDom.i->kol1 + idK - fSz2;
-    objPos.vtY = line;
-    bufPos0.vtX = idK;
-    bufPos0.vtY = (line - gDom.i->line1 + bufSz.vtY) % bufSz.vtY;
-    if(WLZ_BIT_GET(iBuf[bufPos0.vtY], bufPos0.vtX) != 0)
+    ;
+  }
+  for(x1 = wSp->sz.vtX - 1; (x1 > x0) && (mOut[x1] == 0); --x1)
+  {
+    ;
+  }
+  if(x0 >= wSp->sz.vtX)
+  {
+    return;
+  }
+  nRow = WlzRankFilterRows(wSp, pl, ln, mRow, (void **)bRow);
+  /* Columns c0 to c1 inclusive are in the histogram. */
+  c0 = ALG_MAX(x0 - wSp->fSz2, 0);
+  c1 = c0 - 1;
+  for(x = x0; x <= x1; ++x)
+  {
+    int		cN;
+
+    /* Remove columns which have left the window. */
+    while(c0 < x - wSp->fSz2)
     {
-      bufPos0.vtX = idK - fSz2 - 1;
-      sameRCnt = bufPos0.vtX > 0;
-      if(sameRCnt)
+      for(r = 0; r < nRow; ++r)
       {
-	idY = 0;
-	bufPos1.vtX = bufPos0.vtX + bufSz.vtY;
-	while((idY < bufSz.vtY) && sameRCnt)
+	if(mRow[r][c0])
 	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  gP1.ubp = *(iBuf + bufPos0.vtY); 
-	  sameRCnt = WLZ_BIT_GET(gP1.ubp, bufPos0.vtX) &&
-		     WLZ_BIT_GET(gP1.ubp, bufPos1.vtX);
-	  ++idY;
+	  int	b;
+
+	  b = bRow[r][c0];
+	  --(hist[b]);
+	  --(coarse[b >> shift]);
+	  cCnt -= (b >> shift) < cIdx;
+	  --n;
 	}
       }
-      if(sameRCnt)
+      ++c0;
+    }
+    /* Add columns which have entered the window. */
+    cN = ALG_MIN(x - wSp->fSz2 + wSp->fSz - 1, wSp->sz.vtX - 1);
+    while(c1 < cN)
+    {
+      ++c1;
+      for(r = 0; r < nRow; ++r)
       {
-	for(idY = 0; idY < bufSz.vtY; ++idY)
+	if(mRow[r][c1])
 	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      gP0.ubp = (WlzUByte *)rBuf;
-	      gP1.ubp = *((WlzUByte **)vBuf + bufPos0.vtY);
-	      gV0.ubv = *(gP1.ubp + bufPos0.vtX);
-	      gV1.ubv = *(gP1.ubp + bufPos1.vtX);
-	      while(*(gP0.ubp) != gV0.ubv)
-	      {
-	        ++(gP0.ubp);
-	      }
-	      *(gP0.ubp) = gV1.ubv;
-	      break;
-	    case WLZ_GREY_SHORT:
-	      gP0.shp = (short *)rBuf;
-	      gP1.shp = *((short **)vBuf + bufPos0.vtY);
-	      gV0.shv = *(gP1.shp + bufPos0.vtX);
-	      gV1.shv = *(gP1.shp + bufPos1.vtX);
-	      while(*(gP0.shp) != gV0.shv)
-	      {
-	        ++(gP0.shp);
-	      }
-	      *(gP0.shp) = gV1.shv;
-	      break;
-	    case WLZ_GREY_INT:
-	      gP0.inp = (int *)rBuf;
-	      gP1.inp = *((int **)vBuf + bufPos0.vtY);
-	      gV0.inv = *(gP1.inp + bufPos0.vtX);
-	      gV1.inv = *(gP1.inp + bufPos1.vtX);
-	      while(*(gP0.inp) != gV0.inv)
-	      {
-	        ++(gP0.inp);
-	      }
-	      *(gP0.inp) = gV1.inv;
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      gP0.flp = (float *)rBuf;
-	      gP1.flp = *((float **)vBuf + bufPos0.vtY);
-	      gV0.flv = *(gP1.flp + bufPos0.vtX);
-	      gV1.flv = *(gP1.flp + bufPos1.vtX);
-	      while(*(gP0.flp) != gV0.flv)
-	      {
-	        ++(gP0.flp);
-	      }
-	      *(gP0.flp) = gV1.flv;
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      gP0.dbp = (double *)rBuf;
-	      gP1.dbp = *((double **)vBuf + bufPos0.vtY);
-	      gV0.dbv = *(gP1.dbp + bufPos0.vtX);
-	      gV1.dbv = *(gP1.dbp + bufPos1.vtX);
-	      while(*(gP0.dbp) != gV0.dbv)
-	      {
-	        ++(gP0.dbp);
-	      }
-	      *(gP0.dbp) = gV1.dbv;
-	      break;
-	    case WLZ_GREY_RGBA:
-	      gP0.rgbp = (WlzUInt *)rBuf;
-	      gP1.rgbp = *((WlzUInt **)vBuf + bufPos0.vtY);
-	      gV0.rgbv = *(gP1.rgbp + bufPos0.vtX);
-	      gV1.rgbv = *(gP1.rgbp + bufPos1.vtX);
-	      while(*(gP0.rgbp) != gV0.rgbv)
-	      {
-	        ++(gP0.rgbp);
-	      }
-	      *(gP0.rgbp) = gV1.rgbv;
-	      break;
-	    default:
-	      break;
-	  }
+	  int	b;
+
+	  b = bRow[r][c1];
+	  ++(hist[b]);
+	  ++(coarse[b >> shift]);
+	  cCnt += (b >> shift) < cIdx;
+	  ++n;
 	}
       }
-      else
+    }
+    if(mOut[x])
+    {
+      int	b,
+		cnt,
+		rankI;
+
+      /* Find the coarse bin then the fine bin holding the required
+       * rank. */
+      rankI = (int )floor(n * wSp->rank);
+      while(cCnt > rankI)
       {
-        rCnt = 0;
-	for(idY = 0; idY < bufSz.vtY; ++idY)
-	{
-	  bufPos0.vtY = (bufPos1.vtY + idY) % bufSz.vtY;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      gP0.ubp = *((WlzUByte **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      gP0.shp = *((short **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_INT:
-	      gP0.inp = *((int **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      gP0.flp = *((float **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      gP0.dbp = *((double **)vBuf + bufPos0.vtY);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      gP0.rgbp = *((WlzUInt **)vBuf + bufPos0.vtY);
-	      break;
-	    default:
-	      break;
-	  }
-	  bufPos0.vtX = idK - fSz2;
-	  switch(vType)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((WlzUByte *)rBuf + rCnt++) = *(gP0.ubp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_SHORT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((short *)rBuf + rCnt++) = *(gP0.shp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_INT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((int *)rBuf + rCnt++) = *(gP0.inp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((float *)rBuf + rCnt++) = *(gP0.flp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      for(idX = 0; idX < bufSz.vtY; ++idX)
-	      {
-		if(WLZ_BIT_GET(*(iBuf + bufPos0.vtY), bufPos0.vtX) != 0)
-		{
-		  *((double *)rBuf + rCnt++) = *(gP0.dbp + bufPos0.vtX);
-		}
-		++(bufPos0.vtX);
-	      }
-	      break;
-	  case WLZ_GREY_RGBA: /* RGBA to be done - what to do? RAB */
-	    return;
-	  default:
-	    break;
-	  }
-	}
+	--cIdx;
+	cCnt -= coarse[cIdx];
+      }
+      while(cCnt + coarse[cIdx] <= rankI)
+      {
+	cCnt += coarse[cIdx];
+	++cIdx;
+      }
+      cnt = cCnt;
+      b = cIdx << shift;
+      while(cnt + hist[b] <= rankI)
+      {
+	cnt += hist[b];
+	++b;
       }
+      bOut[x] = (unsigned short )b;
     }
-    /* Do the rank filtering. */
-    if(rCnt > 1)
+  }
+  /* Clear the histograms for the next line. */
+  for(x = c0; x <= c1; ++x)
+  {
+    for(r = 0; r < nRow; ++r)
     {
-      WlzRankFilterValues(gVWSp, 0, objPos.vtY, objPos.vtX,
-      			  vType, rBuf, rCnt, rank);
+      if(mRow[r][x])
+      {
+	int	b;
+
+	b = bRow[r][x];
+	--(hist[b]);
+	--(coarse[b >> shift]);
+      }
     }
   }
 }
 
 /*!
-* \return	void
 * \ingroup      WlzValuesFilters
-* \brief	Rank filter the buffer values for a single plane.
-*		always popolate the rank buffer afresh, as quick experiments
-*		have shown that trying to replace values does not speed up
-*		the computation for a 3D buffer.
-* \param	gObj			The object being filtered, needed 
-*					for random pixel access.
-* \param	gVWSp			Grey value workspace, needed for
-*					random pixel access.
-* \param	vBuf			Circular buffer of planes of grey
-*					values.
-* \param	iBuf			Circular buffer of planes of bits
-*					used to encode intervals.
-* \param	rBuf			A buffer used to rank pixels.
-* \param	plane			The current plane, with both past
-*					and future planes valid.
-* \param	vType			The grey value type.
-* \param	bufSz			The buffer size.
-* \param	rank			Required rank with values:
-*					0.0 minimum, 0.5 median and
-*					1.0 maximum.
+* \brief	Rank filters a single line of a plane by gathering the
+* 		values within the filter window of each value into a
+* 		buffer and then selecting the required rank.
+* \param	wSp			Rank filter workspace.
+* \param	pl			Plane being filtered.
+* \param	ln			Line being filtered, relative to the
+* 					workspace origin.
+* \param	mRow			Buffer for mask row pointers.
+* \param	dRow			Buffer for value row pointers.
+* \param	vBuf			Buffer for the values to be ranked.
 */
-static void	WlzRankFilterValPl(WlzObject *gObj, WlzGreyValueWSpace *gVWSp,
-				   void ***vBuf, WlzUByte ***iBuf, void *rBuf,
-				   int plane, WlzGreyType vType,
-				   WlzIVertex3 bufSz, double rank)
+static void			WlzRankFilterLnSel(
+				  WlzRankWSp *wSp,
+				  int pl,
+				  int ln,
+				  WlzUByte **mRow,
+				  double **dRow,
+				  double *vBuf)
 {
-  int		idK,
-		idL,
-		idX,
-		idY,
-		idZ,
-		rCnt,
-		fSz2;
-  WlzUByte	*iP0;
-  WlzGreyP	gP0;
-  WlzDomain	gDom;
-  WlzIVertex3	bufPos0,
-		bufPos1,
-  		objPos;
+  int		x,
+		nRow;
+  WlzUByte	*mOut;
+  double	*dOut;
 
-  gP0.v = NULL;
-  gDom = gObj->domain;
-  fSz2 = bufSz.vtZ / 2;
-  bufPos1.vtZ = plane - gDom.p->plane1 - fSz2 + bufSz.vtZ;
-  for(idL = fSz2; idL < bufSz.vtY - fSz2; ++idL)
+  mOut = wSp->mBuf[(pl - wSp->org.vtZ) % wSp->nBufPl] + (ln * wSp->sz.vtX);
+  dOut = wSp->dOut + (ln * wSp->sz.vtX);
+  nRow = WlzRankFilterRows(wSp, pl, ln, mRow, (void **)dRow);
+  for(x = 0; x < wSp->sz.vtX; ++x)
   {
-    for(idK = fSz2; idK < bufSz.vtX - fSz2; ++idK)
+    if(mOut[x])
     {
-      rCnt = 0;
-      objPos.vtX = gDom.p->kol1 + idK - fSz2;
-      objPos.vtY = gDom.p->line1 + idL - fSz2;
-      objPos.vtZ = plane;
-      bufPos0.vtX = idK;
-      bufPos0.vtY = idL;
-      bufPos0.vtZ = (plane - gDom.p->plane1 + bufSz.vtZ) % bufSz.vtZ;
-      if(WLZ_BIT_GET(*(*(iBuf + bufPos0.vtZ) + bufPos0.vtY), bufPos0.vtX) != 0)
+      int	r,
+      		c0,
+		c1,
+		rankI,
+		n = 0;
+
+      c0 = ALG_MAX(x - wSp->fSz2, 0);
+      c1 = ALG_MIN(x - wSp->fSz2 + wSp->fSz - 1, wSp->sz.vtX - 1);
+      for(r = 0; r < nRow; ++r)
       {
-	for(idZ = 0; idZ < bufSz.vtZ; ++idZ)
+	int	c;
+
+	for(c = c0; c <= c1; ++c)
 	{
-	  bufPos0.vtZ = (bufPos1.vtZ + idZ) % bufSz.vtZ;
-	  for(idY = 0; idY < bufSz.vtZ; ++idY)
+	  if(mRow[r][c])
 	  {
-	    bufPos0.vtY = idL + idY - fSz2;
-	    switch(vType)
-	    {
-	      case WLZ_GREY_UBYTE:
-		gP0.ubp = *(*((WlzUByte ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_SHORT:
-		gP0.shp = *(*((short ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_INT:
-		gP0.inp = *(*((int ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_FLOAT:
-		gP0.flp = *(*((float ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_DOUBLE:
-		gP0.dbp = *(*((double ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      case WLZ_GREY_RGBA:
-		gP0.rgbp = *(*((WlzUInt ***)vBuf + bufPos0.vtZ) + bufPos0.vtY);
-		break;
-	      default:
-	        break;
-	    }
-	    iP0 = *(*(iBuf + bufPos0.vtZ) + bufPos0.vtY);
-	    bufPos0.vtX = idK - fSz2;
-	    switch(vType)
-	    {
-	      case WLZ_GREY_UBYTE:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((WlzUByte *)rBuf + rCnt) = *(gP0.ubp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((short *)rBuf + rCnt) = *(gP0.shp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_INT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((int *)rBuf + rCnt) = *(gP0.inp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((float *)rBuf + rCnt) = *(gP0.flp + bufPos0.vtX);
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-		for(idX = 0; idX < bufSz.vtZ; ++idX)
-		{
-		  if(WLZ_BIT_GET(iP0, bufPos0.vtX) != 0)
-		  {
-		    *((double *)rBuf + rCnt) = *(gP0.dbp + bufPos0.vtX);
-		    ++rCnt;
-		  }
-		  ++(bufPos0.vtX);
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        /* TODO RGBA to be done - what to do? RAB */
-		return;
-	      default:
-	        break;
-	    }
+	    vBuf[n++] = dRow[r][c];
 	  }
 	}
       }
-      /* Do the rank filtering. */
-      if(rCnt > 1)
-      {
-	WlzRankFilterValues(gVWSp, objPos.vtZ, objPos.vtY, objPos.vtX,
-	    		    vType, rBuf, rCnt, rank);
-      }
+      rankI = (int )floor(n * wSp->rank);
+      AlgRankSelectD(vBuf, n, rankI);
+      dOut[x] = vBuf[rankI];
     }
   }
 }
 
-/*!
-* \return	void
-* \ingroup      WlzValuesFilters
-* \brief	Replace the single pixel/voxel in the object used to
-*		initialize the given grey value work space with the
-*		rank filtered value.
-* \param	gVWSp			Given grey value work space.
-* \param	posZ			Plane position.
-* \param	posY			Line position.
-* \param	posX			Column position.
-* \param	vType			Grey value type.
-* \param	values			Buffer of values to be ranked.
-* \param	nValues			Number of values in buffer.
-* \param	rank			Required rank.
-*/
-static void	WlzRankFilterValues(WlzGreyValueWSpace *gVWSp,
-				    int posZ, int posY, int posX,
-				    WlzGreyType vType, void *values,
-				    int nValues, double rank)
-{
-  int		rankI;
-
-  rankI = (int )floor(nValues * rank);
-  WlzGreyValueGet(gVWSp, posZ, posY, posX);
-  switch(vType)
-  {
-    case WLZ_GREY_UBYTE:
-      AlgRankSelectUB((WlzUByte *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].ubp) = *((WlzUByte *)values + rankI);
-      break;
-    case WLZ_GREY_SHORT:
-      AlgRankSelectS((short *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].shp) = *((short *)values + rankI);
-      break;
-    case WLZ_GREY_INT:
-      AlgRankSelectI((int *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].inp) = *((int *)values + rankI);
-      break;
-    case WLZ_GREY_FLOAT:
-      AlgRankSelectF((float *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].flp) = *((float *)values + rankI);
-      break;
-    case WLZ_GREY_DOUBLE:
-      AlgRankSelectD((double *)values, nValues, rankI);
-      *(gVWSp->gPtr[0].dbp) = *((double *)values + rankI);
-      break;
-    default:
-      break;
-  }
-}
-
 /* #define WLZ_RANK_TEST */
 #ifdef WLZ_RANK_TEST
 
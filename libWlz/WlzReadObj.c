@@ -51,6 +51,7 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #endif
 
 /* #define WLZ_DEBUG_READOBJ */
+#define WLZ_TILED_VALUES_PREFETCH (4)
 #define WLZ_OLD_CMESH_TRANS_SUPPORT
 
 #if defined(_WIN32) && !defined(__x86)
@@ -83,6 +84,10 @@ static WlzErrorNum 		WlzReadTiledValues(
 				  int dim,
 				  WlzObjectType type,
 				  int map);
+static WlzErrorNum		WlzReadCompressedTiles(
+				  FILE *fP,
+				  WlzTiledValues *tVal,
+				  size_t gSz);
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
 				  WlzObject *obj);
@@ -2149,13 +2154,22 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
 * 					encodes both the grey type and the
 * 					value table type.
 * \param	map			If non zero the tiles are memory
-* 					mapped rather than read.
+* 					mapped rather than read. If the
+* 					environment variable
+* 					WLZ_TILED_VALUES_CACHE is set to a
+* 					positive number of mega bytes then
+* 					the tiles are instead read on demand
+* 					through a tile cache of this size,
+* 					with WLZ_TILED_VALUES_PREFETCH (if
+* 					set) giving the number of following
+* 					tiles to read with each tile.
 */
 static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 				      int dim, WlzObjectType type,
 				      int map)
 {
   WlzGreyType	gType;
+  WlzTiledValueCodec codec = WLZ_TILED_CODEC_NONE;
   WlzTiledValues *tVal = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -2164,7 +2178,10 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   {
     int		tDim;
 
-    if((tDim = getc(fP)) != dim)
+    /* The tile codec is encoded in the upper bits of the dimension. */
+    tDim = getc(fP);
+    codec = (WlzTiledValueCodec )((tDim >> 4) & 0x0f);
+    if(((tDim & 0x0f) != dim) || (codec >= WLZ_TILED_CODEC_COUNT))
     {
       errNum = WLZ_ERR_READ_INCOMPLETE;
     }
@@ -2177,6 +2194,7 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   {
     tVal->type = type;
     tVal->dim = dim;
+    tVal->codec = codec;
     tVal->kol1 = getword(fP);
     tVal->lastkl = getword(fP);
     tVal->line1 = getword(fP);
@@ -2241,10 +2259,53 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
     size_t	gSz,
       		tSz;
 
+    size_t	cacheSz = 0;
+
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(map == 0)
+#ifdef WLZ_USE_MMAP
+    if(map != 0)
+    {
+      char	*envStr;
+
+      /* If a tile cache size (in MB) is given by the environment then
+       * the tiles are read on demand through a tile cache rather than
+       * being mapped or read. */
+      if(((envStr = getenv("WLZ_TILED_VALUES_CACHE")) != NULL) &&
+	 (atol(envStr) > 0))
+      {
+	cacheSz = (size_t )atol(envStr) * 1024 * 1024;
+      }
+    }
+#endif /* WLZ_USE_MMAP */
+    if(cacheSz > 0)
+    {
+#ifdef WLZ_USE_MMAP
+      if((tVal->fd = dup(fileno(fP))) < 0)
+      {
+	errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else
+      {
+	int	nPrefetch = WLZ_TILED_VALUES_PREFETCH;
+	char	*envStr;
+
+	if((envStr = getenv("WLZ_TILED_VALUES_PREFETCH")) != NULL)
+	{
+	  nPrefetch = atoi(envStr);
+	}
+	errNum = WlzMakeTiledValueCache(tVal, cacheSz, nPrefetch);
+	if(errNum != WLZ_ERR_NONE)
+	{
+	  (void )close(tVal->fd);
+	  tVal->fd = -1;
+	}
+      }
+#endif /* WLZ_USE_MMAP */
+    }
+    else if((map == 0) || (tVal->codec != WLZ_TILED_CODEC_NONE))
     {
+      /* Compressed tiles can not be mapped so they are always read. */
       tVal->fd = -1;
       if((tVal->tiles.v = AlcMalloc(tSz * gSz)) == NULL)
       {
@@ -2259,8 +2320,12 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
       }
       if(errNum == WLZ_ERR_NONE)
       {
+	if(tVal->codec != WLZ_TILED_CODEC_NONE)
+	{
+	  errNum = WlzReadCompressedTiles(fP, tVal, gSz);
+	}
 	/* The tiles are stored using native byte ordering. */
-	if(fread(tVal->tiles.v, gSz, tSz, fP) != tSz)
+	else if(fread(tVal->tiles.v, gSz, tSz, fP) != tSz)
 	{
 	  errNum = WLZ_ERR_READ_INCOMPLETE;
 	}
@@ -2360,6 +2425,82 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
   return(errNum);
 }
 
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads and decompresses all the compressed tiles of a tiled
+* 		value table. The file is known to be positioned at the
+* 		start of the tiles, where there is a table of the
+* 		numTiles + 1 offsets (each a pair of words) of the
+* 		compressed tiles relative to the tile offset.
+* \param	fP			Input file.
+* \param	tVal			Tiled value table with the tiles
+* 					allocated.
+* \param	gSz			Size of the grey values in bytes.
+*/
+static WlzErrorNum WlzReadCompressedTiles(FILE *fP, WlzTiledValues *tVal,
+				          size_t gSz)
+{
+  size_t	idx,
+  		tBytes;
+  long		*tOff = NULL;
+  char		*buf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tBytes = tVal->tileSz * gSz;
+  if(((tOff = (long *)AlcMalloc((tVal->numTiles + 1) *
+                                sizeof(long))) == NULL) ||
+     ((buf = (char *)AlcMalloc(tBytes)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx <= tVal->numTiles); ++idx)
+  {
+    WlzLong	off[2];
+
+    off[0] = (unsigned int )getword(fP);
+    off[1] = (unsigned int )getword(fP);
+    if((sizeof(long) < 8) && (off[1] != 0))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      tOff[idx] = (long )((off[1] << 32) | off[0]);
+      if((idx > 0) &&
+         ((tOff[idx] < tOff[idx - 1]) ||
+	  ((size_t )(tOff[idx] - tOff[idx - 1]) > tBytes)))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     (feof(fP) || (fseek(fP, tVal->tileOffset + tOff[0], SEEK_SET) != 0)))
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  /* The compressed tiles are stored contiguously. */
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+  {
+    size_t	cSz;
+
+    cSz = tOff[idx + 1] - tOff[idx];
+    if(fread(buf, 1, cSz, fP) != cSz)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      errNum = WlzTiledValueTileDecode(tVal->codec, gSz, tBytes, buf, cSz,
+                                       tVal->tiles.ubp + (idx * tBytes));
+    }
+  }
+  AlcFree(buf);
+  AlcFree(tOff);
+  return(errNum);
+}
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
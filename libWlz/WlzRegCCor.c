@@ -45,6 +45,46 @@ static char _WlzRegCCor_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 
 /* #define WLZ_REGCCOR_DEBUG */
+
+/*!
+* \def		WLZ_REGCCOR_MAXROTCAND
+* \ingroup	WlzRegistration
+* \brief	Maximum number of candidate rotations which are registered
+* 		for translation concurrently at each iteration. The number
+* 		used is also limited by the number of threads available.
+*/
+#define WLZ_REGCCOR_MAXROTCAND	(4)
+
+/*!
+* \struct	_WlzRegCCorWSp
+* \ingroup	WlzRegistration
+* \brief	Workspace for the target and source cross-correlation
+* 		arrays. The arrays are kept between cross-correlations
+* 		and only reallocated when larger arrays are required.
+* 		Typedef: ::WlzRegCCorWSp.
+*/
+typedef struct _WlzRegCCorWSp
+{
+  int		maxRows;		/*!< Number of array rows allocated. */
+  size_t	maxElms;		/*!< Number of array elements
+  					     allocated. */
+  double	**ar[2];		/*!< Target and source arrays. */
+} WlzRegCCorWSp;
+
+static void			WlzRegCCorWSpFree(
+				  WlzRegCCorWSp *wSp);
+static WlzErrorNum		WlzRegCCorWSpArrays(
+				  WlzRegCCorWSp *wSp,
+				  WlzIVertex2 aSz);
+static int			WlzRegCCorRotCandidates(
+				  double *rot,
+				  int maxCand,
+				  int peakY,
+				  double angInc,
+				  double **data,
+				  WlzIVertex2 aSz,
+				  WlzIVertex2 pad,
+				  WlzErrorNum *dstErr);
 static WlzObject 		*WlzRegCCorNormaliseObj2D(
 				  WlzObject *obj,
 				  int inv,
@@ -78,6 +118,8 @@ static WlzAffineTransform 	*WlzRegCCorObjs2D1(
 				  int maxItr,
 				  WlzWindowFnType winFn,
 				  int noise,
+				  int nCand,
+				  WlzRegCCorWSp *wSp,
 				  int *dstConv,
 				  double *dstCCor,
 				  WlzErrorNum *dstErr);
@@ -88,15 +130,19 @@ static WlzDVertex2		WlzRegCCorObjs2DTran(
 				  WlzDVertex2 maxTran,
 				  WlzWindowFnType winFn,
 				  int noise,
+				  WlzRegCCorWSp *wSp,
 				  double *dstCCor,
 				  WlzErrorNum *dstErr);
-static double			WlzRegCCorObjs2DRot(
+static int			WlzRegCCorObjs2DRot(
 				  WlzObject *tObj,
 				  WlzObject *sObj,
 				  WlzAffineTransform *initTr,
 				  double maxRot,
 				  WlzWindowFnType winFn,
 				  int noise,
+				  int maxCand,
+				  double *dstRot,
+				  WlzRegCCorWSp *wSp,
 				  WlzErrorNum *dstErr);
 
 /*!
@@ -110,8 +156,9 @@ static double			WlzRegCCorObjs2DRot(
 *               which when applied to the source object takes it into
 *		register with the target object.
 *		Because frequency domain cross correlation (which relies on
-*		the FFT) is used the objects are padded out to arrays which
-*		are an integer power of two in size. This padding introduces
+*		the FFT) is used the objects are padded out to arrays with
+*		sizes that have only small prime factors (see
+*		AlgFourPlanNiceNum()). This padding introduces
 *		significant influence of the objects boundaries and in many
 *		cases the registration will be dominated by the boundaries.
 *		To avoid the boundary problem, two methods are available -
@@ -347,6 +394,9 @@ static WlzObject *WlzRegCCorPProcessObj2D(WlzObject *obj,
 *               A resolution pyramid is built from the given objects
 *               and used to register the objects, progressing from
 *               a low resolution towards the full resolution objects.
+*		The target and source pyramids are built concurrently
+*		and the cross correlation arrays are reused through
+*		all levels of the pyramid.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -386,6 +436,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
   int		tI1,
 		samIdx,
 		conv,
+		nCand = 1,
   		nSam = 0;
   double	rot0,
 		rot1,
@@ -401,6 +452,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
   WlzIBox2	sBox,
   		tBox;
   int		*samFac = NULL;
+  WlzRegCCorWSp	*wSp = NULL;
   WlzObject	**sTObj = NULL,
   		**sSObj = NULL;
   WlzAffineTransform *samRegTr0 = NULL,
@@ -450,32 +502,56 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
-  /* Compute subsampled objects and make sure the background value is zero. */
+  /* Allocate workspaces, one for each of the candidate rotations. The
+   * number of candidates is fixed so that the registration does not
+   * depend on the number of threads. */
   if(errNum == WLZ_ERR_NONE)
   {
-    samIdx = 0;
+    nCand = WLZ_REGCCOR_MAXROTCAND;
+    if((wSp = (WlzRegCCorWSp *)
+              AlcCalloc(nCand, sizeof(WlzRegCCorWSp))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Compute subsampled objects and make sure the background value is zero.
+   * The target and source object pyramids are computed concurrently. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		oIdx;
+    WlzErrorNum	oErr[2];
+
     *samFac = 1;
+    for(samIdx = 1; samIdx < nSam; ++samIdx)
+    {
+      *(samFac + samIdx) = *(samFac + samIdx - 1) * samFacStep;
+    }
     samFacV.vtX = samFacV.vtY = samFacStep;
     *(sTObj + 0) = WlzAssignObject(tObj, NULL);
     *(sSObj + 0) = WlzAssignObject(sObj, NULL);
-    while((errNum == WLZ_ERR_NONE) && (++samIdx < nSam))
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+    for(oIdx = 0; oIdx < 2; ++oIdx)
     {
-      *(samFac + samIdx) = *(samFac + samIdx - 1) * samFacStep;
-      *(sTObj + samIdx) = WlzAssignObject(
-      			  WlzSampleObj(*(sTObj + samIdx - 1), samFacV,
-      				       WLZ_SAMPLEFN_GAUSS, &errNum), NULL);
-      if(errNum == WLZ_ERR_NONE)
-      {
-	(void )WlzSetBackground(*(sTObj + samIdx), zeroBgd);
-        *(sSObj + samIdx) = WlzAssignObject(
-			    WlzSampleObj(*(sSObj + samIdx - 1), samFacV,
-			       	         WLZ_SAMPLEFN_GAUSS, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
+      int	oSamIdx = 0;
+      WlzObject	**oSObj;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      oSObj = (oIdx == 0)? sTObj: sSObj;
+      while((errNum2 == WLZ_ERR_NONE) && (++oSamIdx < nSam))
       {
-        (void )WlzSetBackground(*(sSObj + samIdx), zeroBgd);
+	*(oSObj + oSamIdx) = WlzAssignObject(
+			     WlzSampleObj(*(oSObj + oSamIdx - 1), samFacV,
+					  WLZ_SAMPLEFN_GAUSS, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  (void )WlzSetBackground(*(oSObj + oSamIdx), zeroBgd);
+	}
       }
+      oErr[oIdx] = errNum2;
     }
+    errNum = (oErr[0] != WLZ_ERR_NONE)? oErr[0]: oErr[1];
   }
   /* Register the subsampled objects starting with the lowest resolution
    * (highest subsampling) and progressing to the unsampled objects. */
@@ -515,7 +591,7 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
 	samRegTr1 = WlzRegCCorObjs2D1(*(sTObj + samIdx), *(sSObj + samIdx),
 				      samRegTr0,
 				      trType, sMaxTran, sMaxRot, maxItr,
-				      winFn, noise,
+				      winFn, noise, nCand, wSp,
 				      &conv, &cCor, &errNum);
         
       }
@@ -558,6 +634,18 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
     }
     regTr = samRegTr0;
   }
+  else
+  {
+    (void )WlzFreeAffineTransform(samRegTr0);
+  }
+  if(wSp)
+  {
+    for(samIdx = 0; samIdx < nCand; ++samIdx)
+    {
+      WlzRegCCorWSpFree(wSp + samIdx);
+    }
+    AlcFree(wSp);
+  }
   AlcFree(samFac);
   /* Free subsampled objects. */
   if(sTObj)
@@ -590,6 +678,10 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
 *               frequency domain cross correlation.  An affine transform
 *               is computed, which when applied to the source object
 *               takes it into register with the target object.
+*		At each iteration the best few candidate rotations
+*		are found and then registered for translation
+*		concurrently, the candidate with the highest cross
+*		correlation value being kept.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -609,6 +701,10 @@ static WlzAffineTransform *WlzRegCCorObjs2D(WlzObject *tObj, WlzObject *sObj,
 					iterations are allowed.
 * \param	winFn			Window function.
 * \param	noise			Use Gaussian noise if non-zero.
+* \param	nCand			Maximum number of candidate
+* 					rotations to register for
+* 					translation at each iteration.
+* \param	wSp			Array of nCand workspaces.
 * \param	dstConv			Destination ptr for the
 *                                       convergence flag (non zero
 *                                       on convergence), may be NULL.
@@ -623,24 +719,33 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 					     WlzDVertex2 maxTran,
 					     double maxRot, int maxItr,
 					     WlzWindowFnType winFn, int noise,
+					     int nCand, WlzRegCCorWSp *wSp,
 					     int *dstConv, double *dstCCor, 
 					     WlzErrorNum *dstErr)
 {
-  int		itr,
-		conv;
+  int		idx,
+  		itr,
+		conv,
+		nRot,
+		bestRot;
   WlzAffineTransform *tTr0 = NULL,
   		*tTr1 = NULL,
 		*curTr = NULL,
 		*regTr = NULL;
-  double	rot,
-  		cCor;
+  double	cCor;
   WlzDVertex2	tran;
+  double	rot[WLZ_REGCCOR_MAXROTCAND],
+  		rotCCor[WLZ_REGCCOR_MAXROTCAND];
+  WlzDVertex2	rotTran[WLZ_REGCCOR_MAXROTCAND];
+  WlzErrorNum	rotErr[WLZ_REGCCOR_MAXROTCAND];
+  WlzAffineTransform *rotTr[WLZ_REGCCOR_MAXROTCAND];
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	tranTol = 0.5;
 
+  nCand = WLZ_CLAMP(nCand, 1, WLZ_REGCCOR_MAXROTCAND);
   /* Register for translation. */
   tran = WlzRegCCorObjs2DTran(tObj, sObj, initTr, maxTran, winFn, noise,
-  			      &cCor, &errNum);
+  			      wSp, &cCor, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
     tTr0 = WlzAffineTransformFromPrimVal(WLZ_TRANSFORM_2D_AFFINE,
@@ -662,7 +767,6 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
     /* Iterate until translation is less tahn tollerance value or
      * number of itterations exceeds the maximum. */
     itr = 0;
-    rot = 0.0;
     /* The convergence test must only test the translation and not the
      * rotation too, as the rotation has already been applied when
      * finding the translation. */
@@ -671,31 +775,70 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 	           (fabs(tran.vtY) <= tranTol)) == 0) &&
 	  ((maxItr < 0) || (itr++ < maxItr)))
     {
-      /* Register for rotation. */
-      rot = WlzRegCCorObjs2DRot(tObj, sObj, curTr, 
-				maxRot, winFn, noise, &errNum);
+      /* Register for rotation, finding candidate rotations with the best
+       * first. */
+      nRot = WlzRegCCorObjs2DRot(tObj, sObj, curTr, maxRot, winFn, noise,
+				 nCand, rot, wSp, &errNum);
+      /* Register each candidate rotation for translation, concurrently
+       * and each with it's own workspace, keeping the candidate with the
+       * highest cross correlation value. When noise is used the
+       * candidates are registered in order, as the noise values come
+       * from a single (not thread safe) pseudo-random sequence. */
       if(errNum == WLZ_ERR_NONE)
       {
-	tTr0 = WlzAffineTransformFromPrimVal(WLZ_TRANSFORM_2D_AFFINE,
-					     0.0, 0.0, 0.0,
-					     1.0, rot, 0.0, 0.0, 0.0, 0.0, 0,
-					     &errNum);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	tTr1 = WlzAffineTransformProduct(curTr, tTr0, &errNum);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	(void )WlzFreeAffineTransform(tTr0); tTr0 = NULL;
-	(void )WlzFreeAffineTransform(curTr);
-	curTr = tTr1; tTr1 = NULL;
-      }
-      /* Register for translation. */
-      if(errNum == WLZ_ERR_NONE)
-      {
-	tran = WlzRegCCorObjs2DTran(tObj, sObj, curTr, maxTran, winFn, noise,
-				    &cCor, &errNum);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nRot) if((nRot > 1) && (noise == 0))
+#endif
+	for(idx = 0; idx < nRot; ++idx)
+	{
+	  WlzAffineTransform *rTr = NULL;
+	  WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	  rotTr[idx] = NULL;
+	  rotCCor[idx] = 0.0;
+	  rTr = WlzAffineTransformFromPrimVal(WLZ_TRANSFORM_2D_AFFINE,
+					      0.0, 0.0, 0.0,
+					      1.0, rot[idx],
+					      0.0, 0.0, 0.0, 0.0, 0,
+					      &errNum2);
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    rotTr[idx] = WlzAffineTransformProduct(curTr, rTr, &errNum2);
+	    (void )WlzFreeAffineTransform(rTr);
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    rotTran[idx] = WlzRegCCorObjs2DTran(tObj, sObj, rotTr[idx],
+	    					maxTran, winFn, noise,
+						wSp + idx, rotCCor + idx,
+						&errNum2);
+	  }
+	  rotErr[idx] = errNum2;
+	}
+	bestRot = 0;
+	for(idx = 0; idx < nRot; ++idx)
+	{
+	  if(rotErr[idx] != WLZ_ERR_NONE)
+	  {
+	    errNum = rotErr[idx];
+	  }
+	  else if(rotCCor[idx] > rotCCor[bestRot])
+	  {
+	    bestRot = idx;
+	  }
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  tran = rotTran[bestRot];
+	  cCor = rotCCor[bestRot];
+	  (void )WlzFreeAffineTransform(curTr);
+	  curTr = rotTr[bestRot];
+	  rotTr[bestRot] = NULL;
+	}
+	for(idx = 0; idx < nRot; ++idx)
+	{
+	  (void )WlzFreeAffineTransform(rotTr[idx]);
+	}
       }
       if(errNum == WLZ_ERR_NONE)
       {
@@ -756,6 +899,8 @@ static WlzAffineTransform *WlzRegCCorObjs2D1(WlzObject *tObj, WlzObject *sObj,
 * \param	maxTran			Maximum translation.
 * \param	winFn			Window function.
 * \param	noise			Use Gaussian noise if non-zero.
+* \param	wSp			Workspace for the cross correlation
+* 					arrays.
 * \param	dstCCor			Destination ptr for the cross
 *                                       correlation value, may be NULL.
 * \param	dstErr			Destination error pointer,
@@ -765,6 +910,7 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
 					WlzAffineTransform *initTr,
 					WlzDVertex2 maxTran,
 					WlzWindowFnType winFn, int noise,
+					WlzRegCCorWSp *wSp,
 					double *dstCCor, WlzErrorNum *dstErr)
 {
   int		oIdx;
@@ -772,16 +918,14 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
   double	sSq[2];
   double	**oAr[2];
   WlzIBox2	aBox;
-  WlzIBox2	oBox[2],
-  		pBox[2];
+  WlzIBox2	pBox[2];
   WlzIVertex2	aSz,
   		aOrg,
-		centre,
-		radius,
 		tran;
   WlzDVertex2	dstTran;
   WlzObject	*oObj[2],
   		*pObj[2];
+  WlzErrorNum	oErr[2];
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstTran.vtX = 0.0;
@@ -789,53 +933,55 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
   oAr[0] = oAr[1] = NULL;
   oObj[0] = oObj[1] = NULL;
   pObj[0] = pObj[1] = NULL;
-  oObj[0] = WlzAssignObject(tObj, NULL);
-  /* Transform source object. */
-  if((initTr == NULL) || WlzAffineTransformIsIdentity(initTr, NULL))
-  {
-    oObj[1] = WlzAssignObject(sObj, NULL);
-  }
-  else
-  {
-    oObj[1] = WlzAssignObject(
-              WlzAffineTransformObj(sObj, initTr, WLZ_INTERPOLATION_NEAREST,
-				    &errNum), NULL);
-  }
-  /* Preprocess the objects. */
-  if(errNum == WLZ_ERR_NONE)
+  /* Transform the source object and preprocess both objects, with the
+   * target and source objects processed concurrently. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+  for(oIdx = 0; oIdx < 2; ++oIdx)
   {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    WlzIBox2	oBox;
+    WlzIVertex2	centre,
+    		radius;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    if(oIdx == 0)
     {
-      oBox[oIdx] = WlzBoundingBox2I(oObj[oIdx], &errNum);
-      ++oIdx;
+      oObj[oIdx] = WlzAssignObject(tObj, NULL);
     }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    else if((initTr == NULL) || WlzAffineTransformIsIdentity(initTr, NULL))
+    {
+      oObj[oIdx] = WlzAssignObject(sObj, NULL);
+    }
+    else
+    {
+      oObj[oIdx] = WlzAssignObject(
+		   WlzAffineTransformObj(sObj, initTr,
+					 WLZ_INTERPOLATION_NEAREST,
+					 &errNum2), NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
     {
-      centre.vtX = (oBox[oIdx].xMin + oBox[oIdx].xMax) / 2;
-      centre.vtY = (oBox[oIdx].yMin + oBox[oIdx].yMax) / 2;
-      radius.vtX = (oBox[oIdx].xMax - oBox[oIdx].xMin) / 2;
-      radius.vtY = (oBox[oIdx].yMax - oBox[oIdx].yMin) / 2;
+      oBox = WlzBoundingBox2I(oObj[oIdx], &errNum2);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      centre.vtX = (oBox.xMin + oBox.xMax) / 2;
+      centre.vtY = (oBox.yMin + oBox.yMax) / 2;
+      radius.vtX = (oBox.xMax - oBox.xMin) / 2;
+      radius.vtY = (oBox.yMax - oBox.yMin) / 2;
       pObj[oIdx] = WlzAssignObject(
                    WlzRegCCorPProcessObj2D(oObj[oIdx], winFn, centre, radius,
-      					   &errNum), NULL);
-      ++oIdx;
+      					   &errNum2), NULL);
     }
-  }
-  /* Create double arrays. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    if(errNum2 == WLZ_ERR_NONE)
     {
-      pBox[oIdx] = WlzBoundingBox2I(pObj[oIdx], &errNum);
-      ++oIdx;
+      pBox[oIdx] = WlzBoundingBox2I(pObj[oIdx], &errNum2);
     }
+    oErr[oIdx] = errNum2;
   }
+  errNum = (oErr[0] != WLZ_ERR_NONE)? oErr[0]: oErr[1];
+  /* Create double arrays. */
   if(errNum == WLZ_ERR_NONE)
   {
     aBox.xMin = WLZ_MIN(pBox[0].xMin, pBox[1].xMin) - (int )(maxTran.vtX) + 1;
@@ -846,11 +992,13 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourPlanNiceNum(aSz.vtX);
+    aSz.vtY = AlgFourPlanNiceNum(aSz.vtY);
+    errNum = WlzRegCCorWSpArrays(wSp, aSz);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
+      oAr[oIdx] = wSp->ar[oIdx];
       errNum = WlzToArray2D((void ***)&(oAr[oIdx]), pObj[oIdx], aSz, aOrg,
       			    noise, WLZ_GREY_DOUBLE);
       ++oIdx;
@@ -948,7 +1096,6 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
   {
     (void )WlzFreeObj(oObj[oIdx]);
     (void )WlzFreeObj(pObj[oIdx]);
-    AlcDouble2Free(oAr[oIdx]);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -968,13 +1115,17 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
 }
 
 /*!
-* \return	Angle of roatation.
+* \return	Number of candidate angles of rotation.
 * \ingroup	WlzRegistration
 * \brief	Polar samples then registers the given 2D domain objects
 *               using a frequency domain cross correlation, to find
-*               the angle of rotation about the given centre of rotation
-*               which has the highest cross correlation value.
+*               the angles of rotation about the given centre of rotation
+*               which have the highest cross correlation values.
 *		The rotation is always about the objects cente of mass.
+*		The angle with the highest cross correlation value is
+*		always the first of the candidate angles, any further
+*		candidates are at other local maxima of the cross
+*		correlation in order of decreasing value.
 * \param	tObj			The target object. Must have
 *                                       been assigned.
 * \param	sObj			The source object to be
@@ -986,113 +1137,115 @@ static WlzDVertex2 WlzRegCCorObjs2DTran(WlzObject *tObj, WlzObject *sObj,
 * \param	maxRot			Maximum rotation.
 * \param	winFn			Window function.
 * \param	noise			Use Gaussian noise if non-zero.
+* \param	maxCand			Maximum number of candidate angles.
+* \param	dstRot			Destination array for at least
+* 					maxCand candidate angles.
+* \param	wSp			Workspace for the cross correlation
+* 					arrays.
 * \param	dstErr			Destination error pointer,
 *                                       may be NULL.
 */
-static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
+static int	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
 				    WlzAffineTransform *initTr, double maxRot,
 				    WlzWindowFnType winFn, int noise,
+				    int maxCand, double *dstRot,
+				    WlzRegCCorWSp *wSp,
 				    WlzErrorNum *dstErr)
 {
   int		oIdx,
-  		angCnt;
-  double	angInc,
-  		dstRot = 0.0;
+  		angCnt,
+		nRot = 1;
+  double	angInc;
   WlzIBox2	aBox;
   WlzIBox2	oBox[2];
   WlzIVertex2	rot,
   		aSz,
   		aOrg,
-		winRad,
-		winOrg,
-		rotPad,
-		rotCentreI;
+		rotPad;
   double	**oAr[2];
   WlzObject	*oObj[2],
   		*pObj[2],
 		*wObj[2];
+  WlzErrorNum	oErr[2];
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const int	rotCnt = 500;
   const double	distInc = 1.0;
 
-  /* Assign the target and transform source objects. */
-  oAr[0] = oAr[1] = NULL;
+  *dstRot = 0.0;
   oAr[0] = oAr[1] = NULL;
   oObj[0] = oObj[1] = NULL;
   pObj[0] = pObj[1] = NULL;
   wObj[0] = wObj[1] = NULL;
-  oObj[0] = WlzAssignObject(tObj, NULL);
-  if((initTr == NULL) || WlzAffineTransformIsIdentity(initTr, NULL))
-  {
-    oObj[1] = WlzAssignObject(sObj, NULL);
-  }
-  else
-  {
-    oObj[1] = WlzAssignObject(
-    	      WlzAffineTransformObj(sObj, initTr, WLZ_INTERPOLATION_NEAREST,
-				   &errNum), NULL);
-  }
-  if(errNum == WLZ_ERR_NONE)
+  angInc = (2.0 * (maxRot + WLZ_M_PI)) / rotCnt;
+  angCnt = (2.0 * WLZ_M_PI) / angInc;
+  /* Assign the target and transform source objects, compute their
+   * autocorrelations, the rectangular to polar transformation and
+   * preprocess the polar sampled objects using windows or noise.
+   * The target and source objects are processed concurrently. */
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+  for(oIdx = 0; oIdx < 2; ++oIdx)
   {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    WlzIBox2	pBox;
+    WlzIVertex2	winRad,
+		winOrg,
+		rotCentreI;
+    WlzObject	*aObj = NULL;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    if(oIdx == 0)
     {
-      tObj = WlzAutoCor(oObj[oIdx], &errNum);
-      (void )WlzFreeObj(oObj[oIdx]);
       oObj[oIdx] = WlzAssignObject(tObj, NULL);
-      ++oIdx;
     }
-  }
-  /* Compute rectangular to polar transformation. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    angInc = (2.0 * (maxRot + WLZ_M_PI)) / rotCnt;
-    angCnt = (2.0 * WLZ_M_PI) / angInc;
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    else if((initTr == NULL) || WlzAffineTransformIsIdentity(initTr, NULL))
+    {
+      oObj[oIdx] = WlzAssignObject(sObj, NULL);
+    }
+    else
+    {
+      oObj[oIdx] = WlzAssignObject(
+		   WlzAffineTransformObj(sObj, initTr,
+		   			 WLZ_INTERPOLATION_NEAREST,
+					 &errNum2), NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      aObj = WlzAutoCor(oObj[oIdx], &errNum2);
+      (void )WlzFreeObj(oObj[oIdx]);
+      oObj[oIdx] = WlzAssignObject(aObj, NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
     {
       rotCentreI.vtX = 0;
       rotCentreI.vtY = 0;
-      if(errNum == WLZ_ERR_NONE)
-      {
-	pObj[oIdx] = WlzAssignObject(
-		     WlzPolarSample(oObj[oIdx], rotCentreI, angInc, distInc,
-				    angCnt, 0, &errNum), NULL);
-      }
-      ++oIdx;
+      pObj[oIdx] = WlzAssignObject(
+		   WlzPolarSample(oObj[oIdx], rotCentreI, angInc, distInc,
+				  angCnt, 0, &errNum2), NULL);
     }
-  }
-  /* Preproccess the objects using windows or noise. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    if(errNum2 == WLZ_ERR_NONE)
     {
-      oBox[oIdx] = WlzBoundingBox2I(pObj[oIdx], &errNum);
-      if(errNum == WLZ_ERR_NONE)
-      {
-	winOrg.vtX = (oBox[oIdx].xMax + oBox[oIdx].xMin) / 2;
-	winOrg.vtY = (oBox[oIdx].yMax + oBox[oIdx].yMin) / 2;
-	winRad.vtX = (oBox[oIdx].xMax - oBox[oIdx].xMin) / 2;
-	winRad.vtY = (oBox[oIdx].yMax - oBox[oIdx].yMin) / 2;
-	wObj[oIdx] = WlzAssignObject(
-		     WlzRegCCorPProcessObj2D(pObj[oIdx], winFn,
-					     winOrg, winRad, 
-					     &errNum), NULL);
-      }
-      ++oIdx;
+      pBox = WlzBoundingBox2I(pObj[oIdx], &errNum2);
     }
-  }
-  /* Create 2D double arrays from the polar sampled objects. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    oIdx = 0;
-    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    if(errNum2 == WLZ_ERR_NONE)
     {
-      oBox[oIdx] = WlzBoundingBox2I(wObj[oIdx], &errNum);
-      ++oIdx;
+      winOrg.vtX = (pBox.xMax + pBox.xMin) / 2;
+      winOrg.vtY = (pBox.yMax + pBox.yMin) / 2;
+      winRad.vtX = (pBox.xMax - pBox.xMin) / 2;
+      winRad.vtY = (pBox.yMax - pBox.yMin) / 2;
+      wObj[oIdx] = WlzAssignObject(
+		   WlzRegCCorPProcessObj2D(pObj[oIdx], winFn,
+					   winOrg, winRad, 
+					   &errNum2), NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      oBox[oIdx] = WlzBoundingBox2I(wObj[oIdx], &errNum2);
     }
+    oErr[oIdx] = errNum2;
   }
+  errNum = (oErr[0] != WLZ_ERR_NONE)? oErr[0]: oErr[1];
+  /* Create 2D double arrays from the polar sampled objects. */
   if(errNum == WLZ_ERR_NONE)
   {
     aBox.xMin = WLZ_MIN(oBox[0].xMin, oBox[1].xMin);
@@ -1107,11 +1260,13 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     aOrg.vtY = aBox.yMin;
     aSz.vtX = aBox.xMax - aBox.xMin + 1;
     aSz.vtY = aBox.yMax - aBox.yMin + 1;
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtX), aSz.vtX);
-    (void )AlgBitNextPowerOfTwo((unsigned int *)&(aSz.vtY), aSz.vtY);
+    aSz.vtX = AlgFourPlanNiceNum(aSz.vtX);
+    aSz.vtY = AlgFourPlanNiceNum(aSz.vtY);
+    errNum = WlzRegCCorWSpArrays(wSp, aSz);
     oIdx = 0;
     while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
     {
+      oAr[oIdx] = wSp->ar[oIdx];
       errNum = WlzToArray2D((void ***)&(oAr[oIdx]), wObj[oIdx], aSz, aOrg,
       			    noise, WLZ_GREY_DOUBLE);
       ++oIdx;
@@ -1149,8 +1304,13 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     (void )AlgCrossCorrelate2D(oAr[0], oAr[1], aSz.vtX, aSz.vtY);
     AlgCrossCorrPeakXY(&(rot.vtX), &(rot.vtY), NULL, oAr[0],
 		       aSz.vtX, aSz.vtY, rotPad.vtX, rotPad.vtY);
-    dstRot = rot.vtY * angInc;
-    /* dstRot = -(rot.vtY) * angInc; */
+    *dstRot = rot.vtY * angInc;
+    /* *dstRot = -(rot.vtY) * angInc; */
+    if(maxCand > 1)
+    {
+      nRot = WlzRegCCorRotCandidates(dstRot, maxCand, rot.vtY, angInc,
+      				     oAr[0], aSz, rotPad, &errNum);
+    }
   }
 #ifdef WLZ_REGCCOR_DEBUG
   if(errNum == WLZ_ERR_NONE)
@@ -1191,11 +1351,195 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
     (void )WlzFreeObj(oObj[oIdx]);
     (void )WlzFreeObj(pObj[oIdx]);
     (void )WlzFreeObj(wObj[oIdx]);
-    AlcDouble2Free(oAr[oIdx]);
   }
   if(dstErr)
   {
     *dstErr = errNum;
   }
-  return(dstRot);
+  return(nRot);
+}
+
+/*!
+* \return	Number of candidate angles of rotation.
+* \ingroup	WlzRegistration
+* \brief	Finds candidate angles of rotation from the polar
+* 		sampled cross correlation data. The first candidate is
+* 		always that of the given peak, further candidates are
+* 		taken from the other local maxima of the cross correlation
+* 		(with respect to rotation) in order of decreasing value.
+* \param	rot			Array for at least maxCand angles
+* 					of rotation, the first of which
+* 					is set from the given peak.
+* \param	maxCand			Maximum number of candidates.
+* \param	peakY			Line offset of the cross correlation
+* 					peak.
+* \param	angInc			Angle increment of the polar sampling.
+* \param	data			Cross correlation data in wrap-around
+* 					order.
+* \param	aSz			Size of the cross correlation data.
+* \param	pad			Search range within the data.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static int	WlzRegCCorRotCandidates(double *rot, int maxCand, int peakY,
+					double angInc, double **data,
+					WlzIVertex2 aSz, WlzIVertex2 pad,
+					WlzErrorNum *dstErr)
+{
+  int		idx,
+		idC,
+  		idX,
+		best,
+		nRot = 1,
+		nLn;
+  double	*lnMax = NULL;
+  int		candLn[WLZ_REGCCOR_MAXROTCAND];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rot[0] = peakY * angInc;
+  maxCand = WLZ_MIN(maxCand, WLZ_REGCCOR_MAXROTCAND);
+  nLn = 2 * pad.vtY;
+  candLn[0] = peakY + pad.vtY;
+  if((maxCand > 1) && (nLn > 2))
+  {
+    if((lnMax = (double *)AlcMalloc(nLn * sizeof(double))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(lnMax)
+  {
+    /* Find the maximum value for each line offset within the search
+     * range. */
+    for(idx = 0; idx < nLn; ++idx)
+    {
+      int	lnOff;
+      double	*left,
+      		*right;
+
+      lnOff = idx - pad.vtY;
+      left = *(data + ((lnOff < 0)? aSz.vtY + lnOff: lnOff));
+      right = left + aSz.vtX - 1;
+      lnMax[idx] = *left;
+      for(idX = 0; idX < pad.vtX; ++idX)
+      {
+        lnMax[idx] = WLZ_MAX(lnMax[idx], *left);
+        lnMax[idx] = WLZ_MAX(lnMax[idx], *right);
+	++left;
+	--right;
+      }
+    }
+    /* Select the highest remaining local maxima. */
+    while(nRot < maxCand)
+    {
+      best = -1;
+      for(idx = 1; idx < nLn - 1; ++idx)
+      {
+        if((lnMax[idx] > lnMax[idx - 1]) && (lnMax[idx] >= lnMax[idx + 1]) &&
+	   ((best < 0) || (lnMax[idx] > lnMax[best])))
+	{
+	  for(idC = 0; (idC < nRot) && (candLn[idC] != idx); ++idC);
+	  if(idC == nRot)
+	  {
+	    best = idx;
+	  }
+	}
+      }
+      if(best < 0)
+      {
+        break;
+      }
+      candLn[nRot] = best;
+      rot[nRot] = (best - pad.vtY) * angInc;
+      ++nRot;
+    }
+    AlcFree(lnMax);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nRot);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzRegistration
+* \brief	Makes sure that the workspace has target and source
+* 		arrays of (at least) the given size, reallocating the
+* 		arrays only if they are too small. The arrays are
+* 		contiguous with rows of the given size.
+* \param	wSp			Given workspace.
+* \param	aSz			Required array size.
+*/
+static WlzErrorNum WlzRegCCorWSpArrays(WlzRegCCorWSp *wSp, WlzIVertex2 aSz)
+{
+  int		idx,
+  		idY;
+  size_t	nElm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nElm = (size_t )(aSz.vtX) * aSz.vtY;
+  if((aSz.vtY > wSp->maxRows) || (nElm > wSp->maxElms))
+  {
+    WlzRegCCorWSpFree(wSp);
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+    {
+      if((wSp->ar[idx] = (double **)
+                         AlcMalloc(aSz.vtY * sizeof(double *))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else if((*(wSp->ar[idx]) = (double *)
+                                 AlcMalloc(nElm * sizeof(double))) == NULL)
+      {
+	AlcFree(wSp->ar[idx]);
+	wSp->ar[idx] = NULL;
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      wSp->maxRows = aSz.vtY;
+      wSp->maxElms = nElm;
+    }
+    else
+    {
+      WlzRegCCorWSpFree(wSp);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < 2; ++idx)
+    {
+      for(idY = 1; idY < aSz.vtY; ++idY)
+      {
+        *(wSp->ar[idx] + idY) = *(wSp->ar[idx] + idY - 1) + aSz.vtX;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzRegistration
+* \brief	Frees the arrays of the given workspace, but not the
+* 		workspace itself.
+* \param	wSp			Given workspace.
+*/
+static void	WlzRegCCorWSpFree(WlzRegCCorWSp *wSp)
+{
+  int		idx;
+
+  for(idx = 0; idx < 2; ++idx)
+  {
+    if(wSp->ar[idx])
+    {
+      (void )AlcDouble2Free(wSp->ar[idx]);
+      wSp->ar[idx] = NULL;
+    }
+  }
+  wSp->maxRows = 0;
+  wSp->maxElms = 0;
 }
@@ -51,6 +51,9 @@ static char _WlzRegICP_c[] = "University of Edinburgh $Id$";
 
 #include <float.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /*!
 * \struct	_WlzRegICPWSp
@@ -84,8 +87,17 @@ typedef struct _WlzRegICPWSp
   WlzVertexP    tSVx;		/*!< Transformed source vertices. */
   WlzVertexP    tSNr;		/*!< Transformed source normals. */
   WlzVertexP    nNTVx;		/*!< NN ordered target vertices. */
+  WlzVertexP    nNTNr;		/*!< NN ordered target normals, only used
+  				     for point to plane registration. */
   /* Match weighting */
   double	*wgt;		/*!< Weights for matches */
+  int		ptPlane;	/*!< Non zero for point to plane rather
+  				     than point to point registration. */
+  double	trim;		/*!< Fraction of the matches, those with
+  				     the greatest distances, which are
+				     rejected as outliers. */
+  double	*trimBuf;	/*!< Workspace for finding the trimming
+  				     distance, only used if trim > 0. */
   /* Affine transform. */
   WlzAffineTransform *prvTr;	/*!< Previous affine transform */
   WlzAffineTransform *curTr;	/*!< Current affine transform */
@@ -104,6 +116,11 @@ static int			WlzRegICPItr(
 static double			WlzRegICPWeight(
 				  WlzRegICPWSp *wSp,
 				  double minDistWgt);
+static double			WlzRegICPTrimDist(
+				  int n,
+				  double *dist,
+				  double trim,
+				  double *buf);
 static WlzErrorNum		WlzRegICPCompTransform(
 				  WlzRegICPWSp *wSp,
 				  WlzTransformType trType);
@@ -137,6 +154,8 @@ static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  int ptPlane,
+				  double trim,
 				  WlzErrorNum *dstErr);
 
 /*!
@@ -705,6 +724,8 @@ static WlzErrorNum WlzRegICPCheckVertices(WlzVertexP *vData, int *vCnt,
 *		takes it into register with the target vertices.
 *		The vertices and their normals are known to be either
 *		WlzDVertex2 or WlzDVertex3.
+*		This function is equivalent to WlzRegICPVerticesExt()
+*		for point to point registration without trimming.
 * \param	tVx			Target vertices.
 * \param	tNr			Target normals, may be NULL.
 * \param	tCnt			Number of target vertices.
@@ -745,6 +766,79 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
 				     	    double delta,
 					    double minDistWgt,
 					    WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *regTr;
+
+  regTr = WlzRegICPVerticesExt(tVx, tNr, tCnt, sVx, sNr, sCnt,
+  			       vType, sgnNrm, initTr, trType,
+			       dstConv, dstItr, maxItr, delta, minDistWgt,
+			       0, 0.0, dstErr);
+  return(regTr);
+}
+
+/*!
+* \return				Affine transform which brings
+*					the two sets of vertices into
+*					register.
+* \ingroup	WlzTransform
+* \brief	Registers the two given sets of vertices using the
+*		iterative closest point algorithm. An affine transform
+*		is computed, which when applied to the source vertices
+*		takes it into register with the target vertices.
+*		The vertices and their normals are known to be either
+*		WlzDVertex2 or WlzDVertex3.
+*		Unlike WlzRegICPVertices() this function may also be
+*		used for point to plane registration and for trimmed
+*		registration in which outliers are rejected.
+* \param	tVx			Target vertices.
+* \param	tNr			Target normals, may be NULL.
+* \param	tCnt			Number of target vertices.
+* \param	sVx			Source vertices.
+* \param	sNr			Source normals, may be NULL.
+* \param	sCnt			Number of source vertices.
+* \param	vType			Type of the vertices.
+* \param	sgnNrm			Non zero if the normals have reliably
+*					signed components.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to using the ICP
+*					algorithm. May be NULL.
+* \param	trType			Required transform type.
+* \param	dstConv			Destination ptr for the
+*					convergence flag (non zero
+*					on convergence), may be NULL.
+* \param	dstItr			Destination ptr for the number
+*					of iterations, may be NULL.
+* \param	maxItr			Maximum number of iterations,
+*					if <= 0 then infinite iterations
+*					are allowed.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	ptPlane			Non zero for point to plane rather
+* 					than point to point registration,
+* 					in which case the target normals
+* 					must be given.
+* \param	trim			Fraction of the matches, those with
+* 					the greatest distances, which are
+* 					rejected as outliers at each
+* 					iteration, range [0-1).
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform	*WlzRegICPVerticesExt(WlzVertexP tVx, WlzVertexP tNr,
+					    int tCnt,
+					    WlzVertexP sVx, WlzVertexP sNr,
+					    int sCnt,
+					    WlzVertexType vType, int sgnNrm,
+					    WlzAffineTransform *initTr,
+					    WlzTransformType trType,
+					    int *dstConv, int *dstItr,
+					    int maxItr,
+				     	    double delta,
+					    double minDistWgt,
+					    int ptPlane, double trim,
+					    WlzErrorNum *dstErr)
 {
   int		conv = 0,
 		maxCnt = 0;
@@ -773,13 +867,27 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   wSp.tSVx.v = NULL;
   wSp.tSNr.v = NULL;
   wSp.nNTVx.v = NULL;
+  wSp.nNTNr.v = NULL;
   wSp.wgt = NULL;
+  wSp.ptPlane = ptPlane;
+  wSp.trim = trim;
+  wSp.trimBuf = NULL;
   wSp.prvTr = NULL;
   wSp.curTr = NULL;
   maxCnt = WLZ_MAX(tCnt, sCnt);
-  if(((wSp.sNN = (int *)AlcMalloc(sizeof(int) * maxCnt)) == NULL) ||
+  if((trim < 0.0) || (trim >= 1.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(ptPlane && (tNr.v == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(((wSp.sNN = (int *)AlcMalloc(sizeof(int) * maxCnt)) == NULL) ||
      ((wSp.dist = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
-     ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL))
+     ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
+     ((trim > 0.0) &&
+      ((wSp.trimBuf = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL)))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
@@ -820,6 +928,14 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
 	  errNum = WLZ_ERR_MEM_ALLOC;
 	}
       }
+      if((errNum == WLZ_ERR_NONE) && ptPlane)
+      {
+	if((wSp.nNTNr.d2 = (WlzDVertex2 *)AlcMalloc(sizeof(WlzDVertex2) *
+						maxCnt)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
     }
     else /* vType == WLZ_VERTEX_D3 */
     {
@@ -838,6 +954,14 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
 	  errNum = WLZ_ERR_MEM_ALLOC;
 	}
       }
+      if((errNum == WLZ_ERR_NONE) && ptPlane)
+      {
+	if((wSp.nNTNr.d3 = (WlzDVertex3 *)AlcMalloc(sizeof(WlzDVertex3) *
+						maxCnt)) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
     }
   }
   if(errNum == WLZ_ERR_NONE)
@@ -882,9 +1006,11 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.sNN);
   AlcFree(wSp.dist);
   AlcFree(wSp.wgt);
+  AlcFree(wSp.trimBuf);
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
+  AlcFree(wSp.nNTNr.v);
   (void )WlzFreeAffineTransform(wSp.prvTr);
   if(wSp.curTr)
   {
@@ -981,7 +1107,11 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   wSp.tSVx.v = NULL;
   wSp.tSNr.v = NULL;
   wSp.nNTVx.v = NULL;
+  wSp.nNTNr.v = NULL;
   wSp.wgt = NULL;
+  wSp.ptPlane = 0;
+  wSp.trim = 0.0;
+  wSp.trimBuf = NULL;
   wSp.curTr = NULL;
   maxCnt = WLZ_MAX(tCnt, sCnt);
   if((fabs(xStep) < DBL_EPSILON) ||
@@ -1119,7 +1249,6 @@ static WlzErrorNum WlzRegICPBuildTree(WlzRegICPWSp *wSp)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  /* Use wSp->sNN as a temporay buffer of shuffling indcies. */
   wSp->tTree = WlzVerticesBuildTree(wSp->vType, wSp->nT, wSp->gTVx,
   				     wSp->sNN, &errNum);
   return(errNum);
@@ -1198,14 +1327,14 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 
   if(wSp->vType == WLZ_VERTEX_D2)
   {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d2 + idx) = WlzAffineTransformVertexD2(wSp->curTr,
       						*(wSp->gSVx.d2 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d2 + idx) = WlzAffineTransformNormalD2(wSp->curTr,
 						*(wSp->gSNr.d2 + idx), NULL);
@@ -1214,14 +1343,14 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
   }
   else /* wSp->vType == WLZ_VERTEX_D3 */
   {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
     for(idx = 0; idx < wSp->nS; ++idx)
     {
       *(wSp->tSVx.d3 + idx) = WlzAffineTransformVertexD3(wSp->curTr,
       						*(wSp->gSVx.d3 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d3 + idx) = WlzAffineTransformNormalD3(wSp->curTr,
 						*(wSp->gSNr.d3 + idx), NULL);
@@ -1235,42 +1364,54 @@ static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 * \ingroup	WlzTransform
 * \brief	Finds nearest neighbour matches in the target tree for
 *		the source vertices, sets the nearest neighbour
-*		indicies and permutes the NN ordered target vertices in
-*		the workspace.
+*		indicies and permutes the NN ordered target vertices
+*		(and normals for point to plane registration) in
+*		the workspace. The tree is only read so the matches
+*		are found concurrently.
 * \param	wSp			ICP registration workspace.
 */
 static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 {
   int		idx;
-  WlzDVertex2	tVD2;
-  WlzDVertex3	tVD3;
-  double	datD[3];
-  AlcKDTNode	*node;
 
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    int		tIdx;
+    double	datD[3];
+    AlcKDTNode	*node = NULL;
+
     if(wSp->vType == WLZ_VERTEX_D2)
     {
-      tVD2 = *(wSp->tSVx.d2 + idx);
-      datD[0] = tVD2.vtX;
-      datD[1] = tVD2.vtY;
+      datD[0] = (wSp->tSVx.d2 + idx)->vtX;
+      datD[1] = (wSp->tSVx.d2 + idx)->vtY;
     }
     else /* wSp->vType == WLZ_VERTEX_D3 */
     {
-      tVD3 = *(wSp->tSVx.d3 + idx);
-      datD[0] = tVD3.vtX;
-      datD[1] = tVD3.vtY;
-      datD[2] = tVD3.vtZ;
+      datD[0] = (wSp->tSVx.d3 + idx)->vtX;
+      datD[1] = (wSp->tSVx.d3 + idx)->vtY;
+      datD[2] = (wSp->tSVx.d3 + idx)->vtZ;
     }
-    node = AlcKDTGetNN(wSp->tTree, datD, wSp->maxDist, wSp->dist + idx, NULL);
-    *(wSp->sNN + idx) = node->idx;
+    (void )AlcKDTGetKNN(wSp->tTree, datD, 1, wSp->maxDist, &node,
+    			wSp->dist + idx, NULL);
+    tIdx = *(wSp->sNN + idx) = node->idx;
     if(wSp->vType == WLZ_VERTEX_D2)
     {
-      *(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + node->idx);
+      *(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + tIdx);
+      if(wSp->ptPlane)
+      {
+        *(wSp->nNTNr.d2 + idx) = *(wSp->gTNr.d2 + tIdx);
+      }
     }
     else /* wSp->vType == WLZ_VERTEX_D3 */
     {
-      *(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + node->idx);
+      *(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + tIdx);
+      if(wSp->ptPlane)
+      {
+        *(wSp->nNTNr.d3 + idx) = *(wSp->gTNr.d3 + tIdx);
+      }
     }
   }
 }
@@ -1310,6 +1451,11 @@ static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
 *		registration, with \f$W_{min} = 0\f$ giving good
 *		localisation and \f$W_{min} = 0.25\f$ giving a more
 *		global registration.
+*
+*		If the workspace has a trimming fraction then the
+*		matches with distances greater than the corresponding
+*		quantile are given zero weight and the maximum distance
+*		is that of the quantile.
 * \param	wSp			ICP registration workspace.
 * \param	minVxWgt		Minimum distance weighting
 * 					\f$W_{min}\f$, range [0-1].
@@ -1325,10 +1471,16 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 		minDist,
 		maxDist,
 		wNr = 0.0,
+		trimDist = DBL_MAX,
 		meanSumWgt = 0.0;
   WlzVertex	sV,
   		tV;
 
+  if(wSp->trim > 0.0)
+  {
+    trimDist = WlzRegICPTrimDist(wSp->nMatch, wSp->dist, wSp->trim,
+    				 wSp->trimBuf);
+  }
   /* Find the maximum and minimum distances. */
   minDist = maxDist = *(wSp->dist + 0);
   for(idx = 1; idx < wSp->nMatch; ++idx)
@@ -1342,6 +1494,10 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
       maxDist = tD0;
     }
   }
+  if(maxDist > trimDist)
+  {
+    maxDist = trimDist;
+  }
   /* Compute weights. */
   w0 = maxDist - minDist;
   w1 = 1.0 - minVxWgt;
@@ -1380,7 +1536,11 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
         wNr = 0.0;
       }
     }
-    if(wSp->sgnNrm)
+    if(*(wSp->dist + idx) > trimDist)
+    {
+      tD0 = 0.0;
+    }
+    else if(wSp->sgnNrm)
     {
       tD0 = wVx * wNr;
     }
@@ -1395,6 +1555,36 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
   return(meanSumWgt);
 }
 
+/*!
+* \return	Trimming distance.
+* \ingroup	WlzTransform
+* \brief	Finds the distance below which the given fraction of
+*		the nearest neighbour distances lie, so that matches
+*		at greater distances can be rejected as outliers.
+* \param	n			Number of distances.
+* \param	dist			The distances, which are not
+*					modified.
+* \param	trim			Fraction of the distances to be
+*					trimmed, range [0-1).
+* \param	buf			Workspace with room for at least n
+*					doubles.
+*/
+static double	WlzRegICPTrimDist(int n, double *dist, double trim,
+				  double *buf)
+{
+  int		rank;
+  double	trimDist = DBL_MAX;
+
+  rank = (int )ceil((1.0 - trim) * n) - 1;
+  if((rank >= 0) && (rank < n - 1))
+  {
+    WlzValueCopyDoubleToDouble(buf, dist, n);
+    AlgRankSelectD(buf, n, rank);
+    trimDist = buf[rank];
+  }
+  return(trimDist);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzTransform
@@ -1470,10 +1660,19 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
   /* Compute new affine trasform. */
   if(errNum == WLZ_ERR_NONE)
   {
-    newTr = WlzAffineTransformLSq(wSp->vType, wSp->nMatch, wSp->nNTVx,
-				  wSp->nMatch, wSp->tSVx,
-				  wSp->nMatch, wSp->wgt,
-				  trType, &errNum);
+    if(wSp->ptPlane)
+    {
+      newTr = WlzAffineTransformLSqPlane(wSp->vType, wSp->nMatch,
+      					 wSp->nNTVx, wSp->nNTNr, wSp->tSVx,
+					 wSp->wgt, trType, &errNum);
+    }
+    else
+    {
+      newTr = WlzAffineTransformLSq(wSp->vType, wSp->nMatch, wSp->nNTVx,
+				    wSp->nMatch, wSp->tSVx,
+				    wSp->nMatch, wSp->wgt,
+				    trType, &errNum);
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1503,6 +1702,9 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
 *		kD-tree and the given buffers.
 *		This function will attempt to find a rigid body registration
 *		before attempting a general affine registration.
+*		This function is equivalent to
+*		WlzRegICPTreeAndVerticesExt() for point to point
+*		registration without trimming.
 * \param	tree			Given kD-tree populated by the
 *					target vertices such that the
 *					nodes of the tree have the same
@@ -1555,6 +1757,89 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
 				WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *regTr;
+
+  regTr = WlzRegICPTreeAndVerticesExt(tree, trType, vType, sgnNrm,
+  				      nT, tVx, tNr, nS, sIdx, sVx, sNr,
+				      tVxBuf, sVxBuf, wgtBuf, maxItr,
+				      initTr, dstConv, usrWgtFn, usrWgtData,
+				      delta, minDistWgt, 0, 0.0, dstErr);
+  return(regTr);
+}
+
+/*!
+* \return	Affine transform found.
+* \ingroup	WlzTransform
+* \brief	Registers the given vertices using the already built
+*		kD-tree and the given buffers.
+*		This function will attempt to find a rigid body registration
+*		before attempting a general affine registration.
+*		Unlike WlzRegICPTreeAndVertices() this function may
+*		also be used for point to plane registration and for
+*		trimmed registration in which outliers are rejected.
+* \param	tree			Given kD-tree populated by the
+*					target vertices such that the
+*					nodes of the tree have the same
+*					indicies as the given target vertices
+*					and normals.
+* \param	trType			The required type of transform,
+*					must be either WLZ_TRANSFORM_2D_REG,
+*					or WLZ_TRANSFORM_2D_AFFINE.
+* \param	vType			Vertex type.
+* \param	sgnNrm			Non zero if sign of normal components
+* 					is meaningful.
+* \param	nT			Number of target vertices.
+* \param	tVx			The target vertices.
+* \param	tNr			The target normals.
+* \param        nS			Number of source vertices.
+* \param	sIdx			Indicies of the source
+*					vertices/normals.
+* \param        sVx 			The source vertices.
+* \param	sNr			The source normals.
+* \param	tVxBuf			A buffer with room for at least
+*					nS vertices.
+* \param	sVxBuf			A buffer with room for at least
+*					nS vertices.
+* \param	wgtBuf			A buffer with room for at least
+*					nS doubles.
+* \param	maxItr			Maximum number of iterations.
+* \param	initTr			Initial affine transform.
+* \param	dstConv			Destination pointer for a
+*					convergence flag which is set to
+*					a non zero value if the registration
+*					converges.
+* \param	usrWgtFn		User supplied weight function, may be
+* 					NULL.
+* \param	usrWgtData		User supplied weight data, may be NULL.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	ptPlane			Non zero for point to plane
+*					registration in which the distances
+*					of the source vertices from the
+*					tangent planes of their matched
+*					target vertices are minimised.
+* \param	trim			Fraction of the matches with the
+*					greatest distances which are rejected
+*					as outliers at each iteration, range
+*					[0-1), zero for no trimming.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform *WlzRegICPTreeAndVerticesExt(AlcKDTTree *tree,
+				WlzTransformType trType,
+				WlzVertexType vType, int sgnNrm,
+				int nT, WlzVertexP tVx, WlzVertexP tNr,
+				int nS, int *sIdx,
+				WlzVertexP sVx, WlzVertexP sNr,
+				WlzVertexP tVxBuf, WlzVertexP sVxBuf,
+				double *wgtBuf, int maxItr,
+				WlzAffineTransform *initTr, int *dstConv,
+				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
+				double delta, double minDistWgt,
+				int ptPlane, double trim,
+				WlzErrorNum *dstErr)
 {
   int		conv = 0;
   double	prvMetric = DBL_MAX,
@@ -1578,6 +1863,10 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
       errNum = WLZ_ERR_TRANSFORM_TYPE;
       break;
   }
+  if((errNum == WLZ_ERR_NONE) && ((trim < 0.0) || (trim >= 1.0)))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     newTr0 = WlzRegICPTreeAndVerticesSimple(tree, trType0, vType, sgnNrm,
@@ -1586,7 +1875,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 maxItr, initTr,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
-					 delta, minDistWgt,
+					 delta, minDistWgt, ptPlane, trim,
 					 &errNum);
 #ifdef WLZ_REGICP_DEBUG
     (void )fprintf(stderr, "WlzRegICP newTr0->mat = \n");
@@ -1601,7 +1890,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 maxItr, newTr0,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
-					 delta, minDistWgt,
+					 delta, minDistWgt, ptPlane, trim,
 					 &errNum);
     (void )WlzFreeAffineTransform(newTr0);
     newTr0 = newTr1;
@@ -1669,6 +1958,15 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	ptPlane			Non zero for point to plane
+*					registration in which the distances
+*					of the source vertices from the
+*					tangent planes of their matched
+*					target vertices are minimised.
+* \param	trim			Fraction of the matches with the
+*					greatest distances which are rejected
+*					as outliers at each iteration, range
+*					[0-1), zero for no trimming.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -1685,43 +1983,61 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 				int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				int ptPlane, double trim,
 				WlzErrorNum *dstErr)
 {
   int		idS,
   		idM,
-		idV,
 		itr = 0,
 		conv = 0;
-  AlcKDTNode	*tNode;
   WlzAffineTransform *invTr = NULL,
 		*prvTr = NULL,
   		*curTr = NULL,
   		*newTr = NULL;
   WlzVertex	dV,
   		sV,
-		sN,
 		sTV,
-		sTN,
-  		tV,
-		tN;
+  		tV;
   double	wgt0,
 		wgt1,
 		wgt2,
 		wMaxDist,
 		wMinDist,
+		trimDist,
 		dist,
   		wNr,
 		wVx,
 		prvMetric = 0.0,
 		curMetric = 0.0;
-  double	vxD[3];
+  double	*dstBuf = NULL,
+  		*selBuf = NULL;
+  WlzVertexP	tNrBuf;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
  
+  tNrBuf.v = NULL;
   curTr = (initTr == NULL)?
   	  WlzMakeAffineTransform(WLZ_TRANSFORM_2D_AFFINE, &errNum):
 	  WlzAffineTransformCopy(initTr, &errNum);
   curMetric = *gCurMetric;
   if(errNum == WLZ_ERR_NONE)
+  {
+    if(((dstBuf = (double *)AlcMalloc(sizeof(double) * nS)) == NULL) ||
+       ((trim > 0.0) &&
+        ((selBuf = (double *)AlcMalloc(sizeof(double) * nS)) == NULL)))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(ptPlane)
+    {
+      tNrBuf.v = AlcMalloc(nS * ((vType == WLZ_VERTEX_D2)?
+                                 sizeof(WlzDVertex2): sizeof(WlzDVertex3)));
+      if(tNrBuf.v == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     invTr = WlzAffineTransformInverse(curTr, &errNum);
   }
@@ -1735,60 +2051,116 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
       prvMetric = curMetric;
       curMetric = 0.0;
       /* Populate the buffers with source vertices, nearest neighbours
-       * in the target tree and scalar product of vertex normals. While
-       * doinf this also find maximum and minimum source - target vertex
-       * distances */
+       * in the target tree and scalar product of vertex normals. The
+       * tree is only read so the matches are found concurrently, with
+       * the buffers indexed by source vertex and a negative distance
+       * for unmatched vertices. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 256)
+#endif
       for(idS = 0; idS < nS; ++idS)
       {
+	int	   idV;
+	double	   nnDist;
+	double	   vxD[3];
+	AlcKDTNode *tNode = NULL;
+	WlzVertex  sTVx,
+		   sTN,
+		   tN;
+
 	idV = *(sIdx + idS);
 	if(vType == WLZ_VERTEX_D2)
 	{
-	  sV.d2 = *(sVx.d2 + idV);
-	  sN.d2 = *(sNr.d2 + idV);
-	  sTV.d2 = WlzAffineTransformVertexD2(curTr, sV.d2, NULL);
-	  sTN.d2 = WlzAffineTransformNormalD2(curTr, sN.d2, NULL);
-	  *(sTVxBuf.d2 + idM) = sTV.d2;
-	  vxD[0] = sTV.d2.vtX;
-	  vxD[1] = sTV.d2.vtY;
+	  sTVx.d2 = WlzAffineTransformVertexD2(curTr, *(sVx.d2 + idV), NULL);
+	  sTN.d2 = WlzAffineTransformNormalD2(curTr, *(sNr.d2 + idV), NULL);
+	  *(sTVxBuf.d2 + idS) = sTVx.d2;
+	  vxD[0] = sTVx.d2.vtX;
+	  vxD[1] = sTVx.d2.vtY;
 	}
 	else /* vType == WLZ_VERTEX_D3 */
 	{
-	  sV.d3 = *(sVx.d3 + idV);
-	  sN.d3 = *(sNr.d3 + idV);
-	  sTV.d3 = WlzAffineTransformVertexD3(curTr, sV.d3, NULL);
-	  sTN.d3 = WlzAffineTransformNormalD3(curTr, sN.d3, NULL);
-	  *(sTVxBuf.d3 + idM) = sTV.d3;
-	  vxD[0] = sTV.d3.vtX;
-	  vxD[1] = sTV.d3.vtY;
-	  vxD[2] = sTV.d3.vtZ;
+	  sTVx.d3 = WlzAffineTransformVertexD3(curTr, *(sVx.d3 + idV), NULL);
+	  sTN.d3 = WlzAffineTransformNormalD3(curTr, *(sNr.d3 + idV), NULL);
+	  *(sTVxBuf.d3 + idS) = sTVx.d3;
+	  vxD[0] = sTVx.d3.vtX;
+	  vxD[1] = sTVx.d3.vtY;
+	  vxD[2] = sTVx.d3.vtZ;
 	}
-	if((tNode = AlcKDTGetNN(tree, vxD, DBL_MAX, &dist, NULL)) != NULL)
+	*(dstBuf + idS) = -1.0;
+	if(AlcKDTGetKNN(tree, vxD, 1, DBL_MAX, &tNode, &nnDist, NULL) > 0)
 	{
-	  if(wMinDist > dist)
-	  {
-	    wMinDist = dist;
-	  }
-	  else if(wMaxDist < dist)
-	  {
-	    wMaxDist = dist;
-	  }
+	  *(dstBuf + idS) = nnDist;
 	  if(vType == WLZ_VERTEX_D2)
 	  {
-	    tV.d2 = *(tVx.d2 + tNode->idx);
 	    tN.d2 = *(tNr.d2 + tNode->idx);
-	    *(tVxBuf.d2 + idM) = tV.d2;
-	    *(wgtBuf + idM) = WLZ_VTX_2_DOT(sTN.d2, tN.d2);
+	    *(tVxBuf.d2 + idS) = *(tVx.d2 + tNode->idx);
+	    *(wgtBuf + idS) = WLZ_VTX_2_DOT(sTN.d2, tN.d2);
+	    if(ptPlane)
+	    {
+	      *(tNrBuf.d2 + idS) = tN.d2;
+	    }
 	  }
 	  else /* vType == WLZ_VERTEX_D3 */
 	  {
-	    tV.d3 = *(tVx.d3 + tNode->idx);
 	    tN.d3 = *(tNr.d3 + tNode->idx);
-	    *(tVxBuf.d3 + idM) = tV.d3;
-	    *(wgtBuf + idM) = WLZ_VTX_3_DOT(sTN.d3, tN.d3);
+	    *(tVxBuf.d3 + idS) = *(tVx.d3 + tNode->idx);
+	    *(wgtBuf + idS) = WLZ_VTX_3_DOT(sTN.d3, tN.d3);
+	    if(ptPlane)
+	    {
+	      *(tNrBuf.d3 + idS) = tN.d3;
+	    }
+	  }
+	}
+      }
+      /* Compact the matched vertices, keeping their order, and find the
+       * maximum and minimum source - target vertex distances. */
+      for(idS = 0; idS < nS; ++idS)
+      {
+        if((dist = *(dstBuf + idS)) >= 0.0)
+	{
+	  if(dist < wMinDist)
+	  {
+	    wMinDist = dist;
+	  }
+	  if(dist > wMaxDist)
+	  {
+	    wMaxDist = dist;
+	  }
+	  if(idM != idS)
+	  {
+	    *(dstBuf + idM) = dist;
+	    *(wgtBuf + idM) = *(wgtBuf + idS);
+	    if(vType == WLZ_VERTEX_D2)
+	    {
+	      *(sTVxBuf.d2 + idM) = *(sTVxBuf.d2 + idS);
+	      *(tVxBuf.d2 + idM) = *(tVxBuf.d2 + idS);
+	      if(ptPlane)
+	      {
+	        *(tNrBuf.d2 + idM) = *(tNrBuf.d2 + idS);
+	      }
+	    }
+	    else /* vType == WLZ_VERTEX_D3 */
+	    {
+	      *(sTVxBuf.d3 + idM) = *(sTVxBuf.d3 + idS);
+	      *(tVxBuf.d3 + idM) = *(tVxBuf.d3 + idS);
+	      if(ptPlane)
+	      {
+	        *(tNrBuf.d3 + idM) = *(tNrBuf.d3 + idS);
+	      }
+	    }
 	  }
 	  ++idM;
 	}
       }
+      trimDist = DBL_MAX;
+      if((idM > 0) && (trim > 0.0))
+      {
+        trimDist = WlzRegICPTrimDist(idM, dstBuf, trim, selBuf);
+	if(wMaxDist > trimDist)
+	{
+	  wMaxDist = trimDist;
+	}
+      }
       if(idM == 0)
       {
         errNum = WLZ_ERR_ALG_CONVERGENCE;
@@ -1828,7 +2200,11 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  {
 	    wNr = 0.0;
 	  }
-	  if(usrWgtFn)
+	  if(*(dstBuf + idS) > trimDist)
+	  {
+	    *(wgtBuf + idS) = 0.0;
+	  }
+	  else if(usrWgtFn)
 	  {
 	    if(vType == WLZ_VERTEX_D2)
 	    {
@@ -1865,10 +2241,19 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	else
 	{
 	  /* Compute the transform. */
-	  newTr = WlzAffineTransformLSq(vType, idM, tVxBuf,
-					idM, sTVxBuf,
-					idM, wgtBuf,
-					trType, &errNum);
+	  if(ptPlane)
+	  {
+	    newTr = WlzAffineTransformLSqPlane(vType, idM, tVxBuf, tNrBuf,
+	    				       sTVxBuf, wgtBuf, trType,
+					       &errNum);
+	  }
+	  else
+	  {
+	    newTr = WlzAffineTransformLSq(vType, idM, tVxBuf,
+					  idM, sTVxBuf,
+					  idM, wgtBuf,
+					  trType, &errNum);
+	  }
 	  if(errNum == WLZ_ERR_PARAM_DATA)
 	  {
 	    /* If the registration failed because of the given vertex
@@ -1914,6 +2299,9 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
     errNum = WLZ_ERR_NONE;
     conv = 0;
   }
+  AlcFree(dstBuf);
+  AlcFree(selBuf);
+  AlcFree(tNrBuf.v);
   (void )WlzFreeAffineTransform(invTr);
   (void )WlzFreeAffineTransform(prvTr);
   *gPrvMetric = prvMetric;
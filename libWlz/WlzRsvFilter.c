@@ -43,16 +43,26 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 #include <stdio.h>
 #include <float.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* These tests are for debuging only. */
 /* #define WLZ_RSVFILTER_TEST_1D */
 /* #define WLZ_RSVFILTER_TEST_2D */
 /* #define WLZ_RSVFILTER_TEST_3D */
 
+static int	WlzRsvFilterNThreads(void);
 static WlzObject *WlzRsvFilterObj2DX(WlzObject *, WlzRsvFilter *,
 				     WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj2DY(WlzObject *, WlzRsvFilter *,
 				     WlzErrorNum *);
+static WlzErrorNum WlzRsvFilterObj2DYBand(WlzRsvFilter *,
+				      WlzIntervalDomain *,
+				      WlzGreyLineWSpace *,
+				      WlzGreyLineWSpace *,
+				      double **, double **, WlzUByte **,
+				      int, int);
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *, WlzRsvFilter *,
 			              int, WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
@@ -605,6 +615,7 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 	  f0 = *fP0;
 	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
 	  *fP2++ = c * (f0 + *fP0++);
+	  ++dP0;
 	}
 	kol += 8;
 	cnt0 -= 8;
@@ -789,6 +800,7 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 	  f0 = *fP0;
 	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
 	  *fP2++ = c * (f0 + *fP0++);
+	  ++dP0;
 	}
 	kol += 8;
 	cnt0 -= 8;
@@ -870,6 +882,30 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
   }
 }
 
+/*!
+* \return	Number of threads available.
+* \ingroup	WlzValueFilters
+* \brief	Finds the number of threads that will be used by a
+* 		parallel region, this is always one if OpenMP is not
+* 		enabled or if called from within a parallel region
+* 		(nested parallelism being disabled).
+*/
+static int	WlzRsvFilterNThreads(void)
+{
+  int		nThr = 1;
+
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  return(nThr);
+}
+
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
@@ -887,25 +923,19 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 				     WlzErrorNum *dstErr)
 {
-  int		bufSz,
-		bufSpace,
-		itvLen;
-  WlzGreyType	bufType,
-  		srcGType,
+  int		idT,
+  		bufSz,
+		nThr = 1;
+  WlzGreyType	srcGType,
   		dstGType;
   WlzObjectType	vType;
-  WlzGreyP	bufGP;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		*lnBuf0 = NULL,
-  		*lnBuf1 = NULL,
-  		*datBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  double	**thrBuf = NULL;
+  WlzGreyLineWSpace **srcLWSp = NULL,
+  		**dstLWSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -961,65 +991,116 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the working buffers. */
+  /* Make the working buffers and line workspaces, one set for each
+   * thread. */
   if(errNum == WLZ_ERR_NONE)
   {
+    nThr = WlzRsvFilterNThreads();
     bufSz = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSpace = sizeof(double) * bufSz;
-    if(((datBuf = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf0 = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf1 = AlcMalloc(bufSpace)) ==  NULL))
+    if((AlcDouble2Malloc(&thrBuf, nThr, 3 * bufSz) != ALC_ER_NONE) ||
+       ((srcLWSp = (WlzGreyLineWSpace **)
+                   AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL) ||
+       ((dstLWSp = (WlzGreyLineWSpace **)
+                   AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+    {
+      if((srcLWSp[idT] = WlzGreyLineScanInit(srcObj, 0, &errNum)) != NULL)
+      {
+        dstLWSp[idT] = WlzGreyLineScanInit(dstObj, 1, &errNum);
+      }
+    }
   }
-  /* Work down through the object from the first line to last. */
+  /* Filter the lines of the object, each line being independent of all
+   * others. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufType = WLZ_GREY_DOUBLE;
-    bufGP.dbp = (double *)datBuf;
-    if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp,
-    					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE) &&
-       ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp,
-       					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE))
+    int		idL,
+    		nLn;
+
+    nLn = srcDom.i->lastln - srcDom.i->line1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(idL = 0; idL < nLn; ++idL)
     {
-      while((errNum == WLZ_ERR_NONE) &&
-            ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+      if(errNum == WLZ_ERR_NONE)
       {
-	/* Copy interval to working buffer. */
-	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
-			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-			       itvLen);
-	/* Apply filter. */
-	WlzRsvFilterFilterBufXF(ftr, (double *)datBuf,
-			        (double *)lnBuf0, (double *)lnBuf1,
-				itvLen);
-	/* Clamp data from buffer into the dst interval. */
-	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-			          bufGP, 0, bufType, itvLen);
+	int	idI,
+		ln,
+		thrId = 0;
+	double	*datBuf;
+	WlzGreyP bufGP;
+	WlzGreyLineWSpace *sLWSp,
+		*dLWSp;
+	WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	ln = srcDom.i->line1 + idL;
+	sLWSp = srcLWSp[thrId];
+	dLWSp = dstLWSp[thrId];
+	datBuf = thrBuf[thrId];
+	bufGP.dbp = datBuf;
+	if(((errNum2 = WlzGreyLineScanLine(sLWSp, 0, ln)) == WLZ_ERR_NONE) &&
+	   ((errNum2 = WlzGreyLineScanLine(dLWSp, 0, ln)) == WLZ_ERR_NONE))
+	{
+	  for(idI = 0; idI < sLWSp->nItv; ++idI)
+	  {
+	    int	itvLen;
+
+	    /* Copy interval to working buffer. */
+	    itvLen = sLWSp->itv[idI].iright - sLWSp->itv[idI].ileft + 1;
+	    WlzValueCopyGreyToGrey(bufGP, 0, WLZ_GREY_DOUBLE,
+				   sLWSp->val[idI], 0, sLWSp->gType,
+				   itvLen);
+	    /* Apply filter. */
+	    WlzRsvFilterFilterBufXF(ftr, datBuf,
+				    datBuf + bufSz, datBuf + (2 * bufSz),
+				    itvLen);
+	    /* Clamp data from buffer into the dst interval. */
+	    WlzValueClampGreyIntoGrey(dLWSp->val[idI], 0, dLWSp->gType,
+				      bufGP, 0, WLZ_GREY_DOUBLE, itvLen);
+	  }
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DX)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
       }
     }
-    if(errNum == WLZ_ERR_EOO)
-    {
-      errNum = WLZ_ERR_NONE;
-    }
   }
-  /* Free buffers. */
-  if(datBuf)
+  /* Free buffers and workspaces. */
+  if(srcLWSp)
   {
-    AlcFree(datBuf);
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyLineScanFree(srcLWSp[idT]);
+    }
+    AlcFree(srcLWSp);
   }
-  if(lnBuf0)
+  if(dstLWSp)
   {
-    AlcFree(lnBuf0);
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyLineScanFree(dstLWSp[idT]);
+    }
+    AlcFree(dstLWSp);
   }
-  if(lnBuf1)
+  if(thrBuf)
   {
-    AlcFree(lnBuf1);
+    Alc2Free((void **)thrBuf);
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1036,6 +1117,135 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   return(dstObj);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValueFilters
+* \brief	Applies a recursive filter through the columns of a
+* 		band of columns of a 2D domain object, working down and
+* 		then back up through the lines. Intervals are clipped to
+* 		the band so that bands may be filtered concurrently, each
+* 		with it's own buffers and line workspaces.
+* \param	ftr			Recursive filter.
+* \param	iDom			Interval domain of the object.
+* \param	srcLWSp			Line workspace for the source
+* 					object.
+* \param	dstLWSp			Line workspace for the destination
+* 					object.
+* \param	srcBuf			Three line source buffer.
+* \param	wrkBuf			Three line working buffer.
+* \param	itvBuf			Three line within interval bit
+* 					buffer.
+* \param	bnd0			First column of the band relative
+* 					to the domain's first column, which
+* 					must be a multiple of eight.
+* \param	bnd1			Last column of the band relative
+* 					to the domain's first column.
+*/
+static WlzErrorNum WlzRsvFilterObj2DYBand(WlzRsvFilter *ftr,
+				      WlzIntervalDomain *iDom,
+				      WlzGreyLineWSpace *srcLWSp,
+				      WlzGreyLineWSpace *dstLWSp,
+				      double **srcBuf, double **wrkBuf,
+				      WlzUByte **itvBuf,
+				      int bnd0, int bnd1)
+{
+  int		idD,
+  		idI,
+		idL,
+		idN,
+		nLn,
+		width,
+		bufLnIdx,
+		dstLnIdx,
+		bndByte0,
+		bndBytes;
+  WlzIVertex2	bufPos;
+  WlzGreyP	dstBufGP,
+  		srcBufGP,
+  		wrkBufGP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nLn = iDom->lastln - iDom->line1 + 1;
+  width = iDom->lastkl - iDom->kol1 + 1;
+  bndByte0 = bnd0 >> 3;
+  bndBytes = (bnd1 >> 3) - bndByte0 + 1;
+  for(idD = 0; (errNum == WLZ_ERR_NONE) && (idD < 2); ++idD)
+  {
+    /* Initialise buffers. */
+    for(idN = 0; idN < 3; ++idN)
+    {
+      WlzValueSetUByte(*(itvBuf + idN) + bndByte0, 0, bndBytes);
+    }
+    for(idL = 0; (errNum == WLZ_ERR_NONE) && (idL < nLn); ++idL)
+    {
+      bufPos.vtY = (idD == 0)? idL: nLn - 1 - idL;
+      bufLnIdx = bufPos.vtY % 3;
+      dstLnIdx = (bufPos.vtY + 2) % 3;
+      /* Clear this line's interval bit buffer, the line may be empty. */
+      WlzValueSetUByte(*(itvBuf + bufLnIdx) + bndByte0, 0, bndBytes);
+      if(((errNum = WlzGreyLineScanLine(srcLWSp, 0,
+                                        iDom->line1 + bufPos.vtY)) ==
+	  WLZ_ERR_NONE) &&
+	 ((errNum = WlzGreyLineScanLine(dstLWSp, 0,
+	                                iDom->line1 + bufPos.vtY)) ==
+	  WLZ_ERR_NONE))
+      {
+	srcBufGP.dbp = *(srcBuf + bufLnIdx);
+	wrkBufGP.dbp = *(wrkBuf + bufLnIdx);
+	dstBufGP.dbp = *(wrkBuf + dstLnIdx);
+	for(idI = 0; idI < srcLWSp->nItv; ++idI)
+	{
+	  int	lft,
+	  	rgt,
+		off = 0,
+		itvLen;
+
+	  /* Clip the interval to the band. */
+	  lft = srcLWSp->itv[idI].ileft - iDom->kol1;
+	  rgt = srcLWSp->itv[idI].iright - iDom->kol1;
+	  if(lft > bnd1)
+	  {
+	    break;
+	  }
+	  if(lft < bnd0)
+	  {
+	    off = bnd0 - lft;
+	    lft = bnd0;
+	  }
+	  if(rgt > bnd1)
+	  {
+	    rgt = bnd1;
+	  }
+	  if(lft <= rgt)
+	  {
+	    itvLen = rgt - lft + 1;
+	    bufPos.vtX = lft;
+	    /* Copy interval to buffer. */
+	    WlzBitLnSetItv(*(itvBuf + bufLnIdx), lft, rgt, width);
+	    WlzValueCopyGreyToGrey(srcBufGP, lft, WLZ_GREY_DOUBLE,
+				   srcLWSp->val[idI], off, srcLWSp->gType,
+				   itvLen);
+	    if(idD)
+	    {
+	      WlzValueCopyGreyToGrey(wrkBufGP, lft, WLZ_GREY_DOUBLE,
+				     dstLWSp->val[idI], off, dstLWSp->gType,
+				     itvLen);
+	    }
+	    /* Apply filter to this interval. */
+	    WlzRsvFilterFilterBufYF(ftr, wrkBuf, srcBuf, itvBuf,
+				    bufPos, itvLen, idD);
+	    /* Clamp data buffer into the dst interval. */
+	    WlzValueClampGreyIntoGrey(dstLWSp->val[idI], off, dstLWSp->gType,
+				      (idD)? dstBufGP: wrkBufGP, lft,
+				      WLZ_GREY_DOUBLE, itvLen);
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
@@ -1053,33 +1263,22 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			             WlzErrorNum *dstErr)
 {
-  int		idD,
-  		idN,
-		bufLnIdx,
-		dstLnIdx,
-  		itvLen,
-		itvBufWidth;
-  WlzRasterDir	rasDir;
-  WlzGreyType	bufType,
-  		srcGType,
+  int		idB,
+		nBnd = 0,
+		bndWidth;
+  WlzGreyType	srcGType,
 		dstGType;
-  WlzIVertex2	bufPos,
-  		bufSz;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
+  WlzIVertex2	bufSz;
   WlzObjectType	vType;
   WlzPixelV	bgdPix;
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		**srcBuf = NULL,
-  		**wrkBuf = NULL;
-  WlzUByte	**itvBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  double	***srcBuf = NULL,
+  		***wrkBuf = NULL;
+  WlzUByte	***itvBuf = NULL;
+  WlzGreyLineWSpace **srcLWSp = NULL,
+  		**dstLWSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   /* Gather information about the source object. */
@@ -1135,115 +1334,110 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the buffers. */
+  /* Make the buffers and line workspaces. Columns are independent of
+   * each other so the columns are partitioned into bands, one for
+   * each thread, with each band having it's own buffers. The bands
+   * are aligned to whole bytes of the interval bit buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
+    int		nThr;
+
+    nThr = WlzRsvFilterNThreads();
     bufSz.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
     bufSz.vtY = 3;
-    if(AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    bndWidth = (((bufSz.vtX + nThr - 1) / nThr) + 7) & ~7;
+    nBnd = (bufSz.vtX + bndWidth - 1) / bndWidth;
+    if(((itvBuf = (WlzUByte ***)
+                  AlcCalloc(nBnd, sizeof(WlzUByte **))) == NULL) ||
+       ((srcBuf = (double ***)AlcCalloc(nBnd, sizeof(double **))) == NULL) ||
+       ((wrkBuf = (double ***)AlcCalloc(nBnd, sizeof(double **))) == NULL) ||
+       ((srcLWSp = (WlzGreyLineWSpace **)
+                   AlcCalloc(nBnd, sizeof(WlzGreyLineWSpace *))) == NULL) ||
+       ((dstLWSp = (WlzGreyLineWSpace **)
+                   AlcCalloc(nBnd, sizeof(WlzGreyLineWSpace *))) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bufType = WLZ_GREY_DOUBLE;
-    if((AlcDouble2Malloc((double ***)&srcBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc((double ***)&wrkBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+    for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < nBnd); ++idB)
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      if((AlcBit2Malloc(itvBuf + idB, bufSz.vtY,
+                        bufSz.vtX) != ALC_ER_NONE) ||
+         (AlcDouble2Malloc(srcBuf + idB, bufSz.vtY,
+	                   bufSz.vtX) != ALC_ER_NONE) ||
+         (AlcDouble2Malloc(wrkBuf + idB, bufSz.vtY,
+	                   bufSz.vtX) != ALC_ER_NONE))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else if((srcLWSp[idB] = WlzGreyLineScanInit(srcObj, 0,
+                                                  &errNum)) != NULL)
+      {
+        dstLWSp[idB] = WlzGreyLineScanInit(dstObj, 1, &errNum);
+      }
     }
   }
-  /* Work down and then back up through the object. */
+  /* Filter each band of columns. */
   if(errNum == WLZ_ERR_NONE)
   {
-    idD = 0;
-    bufLnIdx = 0;
-    dstLnIdx = 0;
-    itvBufWidth = (bufSz.vtX + 7) / 8;
-    while((errNum == WLZ_ERR_NONE) && (idD < 2))
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idB = 0; idB < nBnd; ++idB)
     {
-      /* Initialise buffers. */
-      for(idN = 0; idN < 3; ++idN)
+      int	bnd1;
+      WlzErrorNum errNum2;
+
+      bnd1 = ((idB + 1) * bndWidth) - 1;
+      if(bnd1 >= bufSz.vtX)
       {
-	WlzValueSetUByte(*(itvBuf + idN), 0, itvBufWidth);
+        bnd1 = bufSz.vtX - 1;
       }
-      rasDir = (idD == 0)? WLZ_RASTERDIR_ILIC: WLZ_RASTERDIR_DLIC;
-      if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp, rasDir,
-					  0)) == WLZ_ERR_NONE) &&
-	 ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp, rasDir,
-					  0)) == WLZ_ERR_NONE))
+      errNum2 = WlzRsvFilterObj2DYBand(ftr, srcDom.i,
+				       srcLWSp[idB], dstLWSp[idB],
+				       srcBuf[idB], wrkBuf[idB], itvBuf[idB],
+				       idB * bndWidth, bnd1);
+      if(errNum2 != WLZ_ERR_NONE)
       {
-	while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj2DY)
+#endif
 	{
-	  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	  bufPos.vtX = srcIWSp.lftpos - srcDom.i->kol1;
-	  /* Process any lines between this and the last. */
-	  if(srcIWSp.nwlpos > 0)
-	  {
-	    idN = (srcIWSp.nwlpos >= 3)? 3: srcIWSp.nwlpos;
-	    while(--idN >= 0)
-	    {
-	      bufPos.vtY = srcIWSp.linpos - srcDom.i->line1 - idN;
-	      bufLnIdx = (3 + bufPos.vtY) % 3;
-	      WlzValueSetUByte(*(itvBuf + bufLnIdx), 0, itvBufWidth);
-	    }
-	    dstLnIdx = (bufPos.vtY + 3 + ((idD)? 2: - 2)) % 3;
-	  }
-	  /* Copy interval to buffer. */
-	  srcBufGP.dbp = *((double **)srcBuf + bufLnIdx);
-	  wrkBufGP.dbp = *((double **)wrkBuf + bufLnIdx);
-	  dstBufGP.dbp = *((double **)wrkBuf + dstLnIdx);
-	  WlzBitLnSetItv(*(itvBuf + bufLnIdx),
-	  		 bufPos.vtX, bufPos.vtX + itvLen - 1, bufSz.vtX);
-	  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-				 srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-				 itvLen);
-	  if(rasDir == WLZ_RASTERDIR_DLIC)
-	  {
-	    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-	    			   dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				   itvLen);
-	  }
-	  /* Apply filter to this interval. */
-	  WlzRsvFilterFilterBufYF(ftr, (double **)wrkBuf, (double **)srcBuf,
-				itvBuf, bufPos, itvLen, idD);
-	  /* Clamp data buffer into the dst interval. */
-	  if(rasDir == WLZ_RASTERDIR_ILIC)
-	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      wrkBufGP, bufPos.vtX, bufType, itvLen);
-	  }
-	  else
+	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      dstBufGP, bufPos.vtX, bufType, itvLen);
+	    errNum = errNum2;
 	  }
 	}
       }
-      if(errNum == WLZ_ERR_EOO)
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      ++idD;
     }
   }
-  if(itvBuf)
-  {
-    Alc2Free((void **)itvBuf);
-  }
-  if(srcBuf)
+  for(idB = 0; idB < nBnd; ++idB)
   {
-    Alc2Free(srcBuf);
-  }
-  if(wrkBuf)
-  {
-    Alc2Free(wrkBuf);
+    if(itvBuf && itvBuf[idB])
+    {
+      Alc2Free((void **)itvBuf[idB]);
+    }
+    if(srcBuf && srcBuf[idB])
+    {
+      Alc2Free((void **)srcBuf[idB]);
+    }
+    if(wrkBuf && wrkBuf[idB])
+    {
+      Alc2Free((void **)wrkBuf[idB]);
+    }
+    if(srcLWSp)
+    {
+      WlzGreyLineScanFree(srcLWSp[idB]);
+    }
+    if(dstLWSp)
+    {
+      WlzGreyLineScanFree(dstLWSp[idB]);
+    }
   }
+  AlcFree(itvBuf);
+  AlcFree(srcBuf);
+  AlcFree(wrkBuf);
+  AlcFree(srcLWSp);
+  AlcFree(dstLWSp);
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
@@ -1279,9 +1473,7 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			              int actionMsk, WlzErrorNum *dstErr)
 {
   int		nPlanes;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
+  WlzObject	*dstObj = NULL;
   WlzDomain 	*srcDom2D;
   WlzValues	*srcVal2D,
   		*dstVal2D;
@@ -1303,40 +1495,50 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstVal2D = dstVal.vox->values;
     dstObj = WlzMakeMain(srcObj->type, srcDom, dstVal, NULL, NULL, &errNum);
   }
-  while((errNum == WLZ_ERR_NONE) &&
-        (nPlanes-- > 0))
+  /* Filter the planes, each of which is independent of all others. */
+  if(errNum == WLZ_ERR_NONE)
   {
-    srcObj2D = NULL;
-    dstObj2D = NULL;
-    if(srcDom2D->core)
+    int		idP;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPlanes; ++idP)
     {
-      dstObj2D = NULL;
-      srcObj2D = WlzAssignObject(
-      		 WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D++, *srcVal2D++,
-			     NULL, NULL, &errNum), NULL);
-      if(errNum == WLZ_ERR_NONE)
-      {
-	dstObj2D = WlzAssignObject(
-		   WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	*dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
-      }
-      if(srcObj2D)
-      {
-        WlzFreeObj(srcObj2D);
-      }
-      if(dstObj2D)
+      if((errNum == WLZ_ERR_NONE) && srcDom2D[idP].core)
       {
-        WlzFreeObj(dstObj2D);
+	WlzObject *srcObj2D,
+		  *dstObj2D = NULL;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	srcObj2D = WlzAssignObject(
+		   WlzMakeMain(WLZ_2D_DOMAINOBJ, srcDom2D[idP], srcVal2D[idP],
+			       NULL, NULL, &errNum2), NULL);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstObj2D = WlzAssignObject(
+		     WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum2), NULL);
+	}
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  dstVal2D[idP] = WlzAssignValues(dstObj2D->values, NULL);
+	}
+	(void )WlzFreeObj(srcObj2D);
+	(void )WlzFreeObj(dstObj2D);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DXY)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
       }
     }
-    else
-    {
-      dstVal2D->core = NULL;
-    }
-    ++dstVal2D;
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1377,10 +1579,10 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   		idD,
 		idN,
   		idP,
-		itvLen,
-		dstPnIdx,
+		idT,
 		bufPlIdx,
   		nPlanes,
+		nThr = 0,
 		itvBufArea;
   WlzIVertex3	bufPos,
   		bufSz;
@@ -1390,30 +1592,19 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 		dstVal;
   WlzObjectType	dstValTbType2D;
   WlzGreyType	tmpGType,
-		bufType,
   		srcGType = WLZ_GREY_ERROR,
   		dstGType = WLZ_GREY_ERROR;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
-  void		***srcBuf = NULL,
+  double	***srcBuf = NULL,
   		***wrkBuf = NULL;
-  void		**srcBuf2D,
-		**dstBuf2D,
-  		**wrkBuf2D;
   WlzUByte	***itvBuf = NULL;
   WlzUByte	**itvBuf2D;
   WlzDomain	*srcDom2D;
-  WlzValues	*srcVal2D,
-  		*dstVal2D;
+  WlzValues	*srcVal2D;
   WlzObject	*srcObj2D,
-  		*dstObj2D,
 		*dstObj = NULL;
   WlzPixelV	bgdPix;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  WlzGreyLineWSpace **srcLWSp = NULL,
+  		**dstLWSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
@@ -1515,11 +1706,10 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
       }
       if(errNum == WLZ_ERR_NONE)
       {
-	bufType = WLZ_GREY_DOUBLE;
-	if((AlcDouble3Malloc((double ****)&srcBuf,
+	if((AlcDouble3Malloc(&srcBuf,
 			     bufSz.vtZ, bufSz.vtY,
 			     bufSz.vtX) != ALC_ER_NONE) ||
-	   (AlcDouble3Malloc((double ****)&wrkBuf,
+	   (AlcDouble3Malloc(&wrkBuf,
 			     bufSz.vtZ, bufSz.vtY,
 			     bufSz.vtX) != ALC_ER_NONE))
 	{
@@ -1527,7 +1717,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	}
       }
       /* Make destination object with it's own voxel value table but with a
-       * shared domain. The 2D values are created/added later. */
+       * shared domain, then add new 2D values for all non-empty planes. */
       if(errNum == WLZ_ERR_NONE)
       {
 	dstVal.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
@@ -1539,7 +1729,48 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			    NULL, &errNum);
       }
-      /* Work down and then back up through the object's planes. */
+      for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nPlanes); ++idP)
+      {
+	srcDom2D = srcDom.p->domains + idP;
+	if(srcDom2D->core)
+	{
+	  srcObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D,
+	  			 srcVal.vox->values[idP], NULL, NULL, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    tVal0.v  = WlzNewValueTb(srcObj2D, dstValTbType2D,
+				     bgdPix, &errNum);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    dstVal.vox->values[idP] = WlzAssignValues(tVal0, NULL);
+	  }
+	  (void )WlzFreeObj(srcObj2D);
+	}
+      }
+      /* Make line workspaces, one pair for each thread. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nThr = WlzRsvFilterNThreads();
+	if(((srcLWSp = (WlzGreyLineWSpace **)
+		       AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL) ||
+	   ((dstLWSp = (WlzGreyLineWSpace **)
+		       AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+	{
+	  if((srcLWSp[idT] = WlzGreyLineScanInit(srcObj, 0,
+	                                         &errNum)) != NULL)
+	  {
+	    dstLWSp[idT] = WlzGreyLineScanInit(dstObj, 1, &errNum);
+	  }
+	}
+      }
+      /* Work down and then back up through the object's planes. Within
+       * each plane the lines are independent and so are filtered
+       * concurrently. */
       if(errNum == WLZ_ERR_NONE)
       {
 	idD = 0;
@@ -1555,101 +1786,101 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	  while((errNum == WLZ_ERR_NONE) && (idP < nPlanes))
 	  {
 	    bufPlIdx = (bufPos.vtZ + 3 + 0) % 3;
-	    dstPnIdx = (bufPos.vtZ + 3 + 2) % 3;
 	    srcDom2D = srcDom.p->domains + bufPos.vtZ;
-	    srcVal2D = srcVal.vox->values + bufPos.vtZ;
-	    dstVal2D = dstVal.vox->values + bufPos.vtZ;
 	    itvBuf2D = *(itvBuf + bufPlIdx);
-	    srcBuf2D = *(srcBuf + bufPlIdx); 
-	    wrkBuf2D = *(wrkBuf + bufPlIdx);
-	    dstBuf2D = *(wrkBuf + dstPnIdx);
 	    /* Clear this plane's interval buffer bit mask. */
 	    WlzValueSetUByte(*itvBuf2D, 0, itvBufArea);
 	    /* Process non-empty planes. */
 	    if(srcDom2D->core)
 	    {
-	      /* Make a 2D object from current source plane. */
-	      srcObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *srcVal2D,
-				     NULL, NULL, &errNum);
-	      if((errNum == WLZ_ERR_NONE) && (idD == 0))
+	      int	idL,
+	      		pln,
+	      		nLn;
+	      WlzIntervalDomain *iDom2D;
+
+	      iDom2D = srcDom2D->i;
+	      pln = srcDom.p->plane1 + bufPos.vtZ;
+	      nLn = iDom2D->lastln - iDom2D->line1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+	      for(idL = 0; idL < nLn; ++idL)
 	      {
-		/* If first pass through object (going down through planes)
-		 * then make a new 2D value table. */
-		tVal0.v  = WlzNewValueTb(srcObj2D, dstValTbType2D,
-					 bgdPix, &errNum);
 		if(errNum == WLZ_ERR_NONE)
 		{
-		  *dstVal2D = WlzAssignValues(tVal0, NULL);
-		}
-	      }
-	      /* Make a 2D object from destination plane. */
-	      dstObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *dstVal2D,
-				     NULL, NULL, &errNum);
-	      /* Process each interval of this plane. */
-	      if(((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
-	      				    &srcGWSp)) == WLZ_ERR_NONE) &&
-	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
-	      				    &dstGWSp)) == WLZ_ERR_NONE))
-	      {
-		while((errNum == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&srcIWSp)) == WLZ_ERR_NONE) &&
-		      ((errNum = WlzNextGreyInterval(
-		      			&dstIWSp)) == WLZ_ERR_NONE))
-		{
-		  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-		  bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
-		  bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
-		  /* Copy interval to buffer. */
-		  srcBufGP.dbp = *((double **)srcBuf2D + bufPos.vtY);
-		  wrkBufGP.dbp = *((double **)wrkBuf2D + bufPos.vtY);
-		  dstBufGP.dbp = *((double **)dstBuf2D + bufPos.vtY);
-		  WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
-		  		 bufPos.vtX, bufPos.vtX + itvLen - 1,
-				 bufSz.vtX);
-		  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-		  			 srcGWSp.u_grintptr, 0,
-					 srcGWSp.pixeltype,
-					 itvLen);
-		  if(idD)
-		  {
-		    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-					   dstGWSp.u_grintptr, 0,
-					   dstGWSp.pixeltype,
-					   itvLen);
-		  }
-		  /* Apply filter to this interval. */
-		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
-					  (double ***)srcBuf, itvBuf,
-					  bufPos, itvLen, idD);
-		  /* Clamp data buffer back into the destination plane. */
-		  if(idD == 0)
+		  int	idI,
+		  	thrId = 0;
+		  WlzIVertex3 bufPosL;
+		  WlzGreyP dstBufGP,
+			srcBufGP,
+			wrkBufGP;
+		  WlzGreyLineWSpace *sLWSp,
+		  	*dLWSp;
+		  WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+		  thrId = omp_get_thread_num();
+#endif
+		  sLWSp = srcLWSp[thrId];
+		  dLWSp = dstLWSp[thrId];
+		  bufPosL.vtZ = bufPos.vtZ;
+		  bufPosL.vtY = iDom2D->line1 + idL - srcDom.p->line1;
+		  srcBufGP.dbp = srcBuf[bufPlIdx][bufPosL.vtY];
+		  wrkBufGP.dbp = wrkBuf[bufPlIdx][bufPosL.vtY];
+		  dstBufGP.dbp = wrkBuf[(bufPos.vtZ + 3 + 2) % 3][bufPosL.vtY];
+		  if(((errNum2 = WlzGreyLineScanLine(sLWSp, pln,
+		  			iDom2D->line1 + idL)) ==
+		      WLZ_ERR_NONE) &&
+		     ((errNum2 = WlzGreyLineScanLine(dLWSp, pln,
+		     			iDom2D->line1 + idL)) ==
+		      WLZ_ERR_NONE))
 		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      wrkBufGP, bufPos.vtX, bufType,
-					      itvLen);
+		    for(idI = 0; idI < sLWSp->nItv; ++idI)
+		    {
+		      int	itvLen;
+
+		      itvLen = sLWSp->itv[idI].iright -
+		               sLWSp->itv[idI].ileft + 1;
+		      bufPosL.vtX = sLWSp->itv[idI].ileft - srcDom.p->kol1;
+		      /* Copy interval to buffer. */
+		      WlzBitLnSetItv(*(itvBuf2D + bufPosL.vtY),
+				     bufPosL.vtX, bufPosL.vtX + itvLen - 1,
+				     bufSz.vtX);
+		      WlzValueCopyGreyToGrey(srcBufGP, bufPosL.vtX,
+		      			     WLZ_GREY_DOUBLE,
+					     sLWSp->val[idI], 0, sLWSp->gType,
+					     itvLen);
+		      if(idD)
+		      {
+			WlzValueCopyGreyToGrey(wrkBufGP, bufPosL.vtX,
+					       WLZ_GREY_DOUBLE,
+					       dLWSp->val[idI], 0,
+					       dLWSp->gType, itvLen);
+		      }
+		      /* Apply filter to this interval. */
+		      WlzRsvFilterFilterBufZF(ftr, wrkBuf, srcBuf, itvBuf,
+					      bufPosL, itvLen, idD);
+		      /* Clamp data buffer back into the destination plane. */
+		      WlzValueClampGreyIntoGrey(dLWSp->val[idI], 0,
+						dLWSp->gType,
+						(idD)? dstBufGP: wrkBufGP,
+						bufPosL.vtX, WLZ_GREY_DOUBLE,
+						itvLen);
+		    }
 		  }
-		  else
+		  if(errNum2 != WLZ_ERR_NONE)
 		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      dstBufGP, bufPos.vtX, bufType,
-					      itvLen);
+#ifdef _OPENMP
+#pragma omp critical (WlzRsvFilterObj3DZ)
+#endif
+		    {
+		      if(errNum == WLZ_ERR_NONE)
+		      {
+			errNum = errNum2;
+		      }
+		    }
 		  }
 		}
-		if(errNum == WLZ_ERR_EOO)
-		{
-		  errNum = WLZ_ERR_NONE;
-		}
-	      }
-	      if(srcObj2D)
-	      {
-	        WlzFreeObj(srcObj2D);
-	      }
-	      if(dstObj2D)
-	      {
-	        WlzFreeObj(dstObj2D);
 	      }
 	    }
 	    ++idP;
@@ -1660,17 +1891,33 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
       }
     }
   }
+  if(srcLWSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyLineScanFree(srcLWSp[idT]);
+    }
+    AlcFree(srcLWSp);
+  }
+  if(dstLWSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyLineScanFree(dstLWSp[idT]);
+    }
+    AlcFree(dstLWSp);
+  }
   if(itvBuf)
   {
     Alc3Free((void ***)itvBuf);
   }
   if(srcBuf)
   {
-    Alc3Free(srcBuf);
+    Alc3Free((void ***)srcBuf);
   }
   if(wrkBuf)
   {
-    Alc3Free(wrkBuf);
+    Alc3Free((void ***)wrkBuf);
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -854,145 +854,146 @@ static WlzObject *WlzScalarMulAdd3D(WlzObject *iObj, WlzPixelV m, WlzPixelV a,
 * \brief	Sets the values of the return object from the input object
 * 		using simple linear scaling, see WlzScalarMulAdd(). The
 * 		objects are known to be 2D, have the same domain.
-* \param	rObj
-* \param	iObj
-* \param	m
-* \param	a
+* 		The objects are scanned a line at a time so that the
+* 		grey types are only dispatched once per line.
+* \param	rObj			Return object.
+* \param	iObj			Input object.
+* \param	m			Value to multiply object values by.
+* \param	a			Value to add to product.
 */
 static WlzErrorNum WlzScalarMulAddSet2D(WlzObject *rObj, WlzObject *iObj,
 				     double m, double a)
 {
   int		bufLen;
-  WlzGreyWSpace iGWSp,
-  		rGWSp;
-  WlzIntervalWSpace iIWSp = {0},
-  		    rIWSp = {0};
+  WlzGreyLineWSpace *iLWSp = NULL,
+  		*rLWSp = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   bufLen = iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1;
-  if((bufLen != iObj->domain.i->lastkl - iObj->domain.i->kol1 + 1) ||
-     (bufLen < 0))
+  if(bufLen < 0)
   {
     errNum = WLZ_ERR_DOMAIN_DATA;
   }
   else if(bufLen > 0)
   {
-    if(errNum == WLZ_ERR_NONE)
+    double	*buf = NULL;
+
+    if((buf = AlcMalloc(sizeof(double) * bufLen)) == NULL)
     {
-      errNum = WlzInitGreyScan(iObj, &iIWSp, &iGWSp);
+      errNum = WLZ_ERR_MEM_ALLOC;
     }
     if(errNum == WLZ_ERR_NONE)
     {
-      errNum = WlzInitGreyScan(rObj, &rIWSp, &rGWSp);
+      iLWSp = WlzGreyLineScanInit(iObj, 0, &errNum);
     }
     if(errNum == WLZ_ERR_NONE)
     {
-      double	*buf = NULL;
+      rLWSp = WlzGreyLineScanInit(rObj, 1, &errNum);
+    }
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzGreyLineScanNext(iLWSp)) == WLZ_ERR_NONE) &&
+          ((errNum = WlzGreyLineScanNext(rLWSp)) == WLZ_ERR_NONE))
+    {
+      int	idI;
 
-      if((buf = AlcMalloc(sizeof(double) * bufLen)) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-      else
+      for(idI = 0; idI < iLWSp->nItv; ++idI)
       {
-	while((errNum = WlzNextGreyInterval(&iIWSp)) == WLZ_ERR_NONE)
+	int	t,
+		idN,
+		itvLen;
+	double	f;
+	WlzGreyP iGP,
+		 rGP;
+
+	iGP = iLWSp->val[idI];
+	rGP = rLWSp->val[idI];
+	itvLen = iLWSp->itv[idI].iright - iLWSp->itv[idI].ileft + 1;
+	switch(iLWSp->gType)
 	{
-	  int	t,
-	  	idN,
-	  	itvLen;
-	  double f;
-
-
-	  itvLen = iIWSp.colrmn;
-	  (void )WlzNextGreyInterval(&rIWSp);
-	  switch(iGWSp.pixeltype)
-	  {
-	    case WLZ_GREY_INT:
-	      WlzValueCopyIntToDouble(buf, iGWSp.u_grintptr.inp, itvLen);
-	      break;
-	    case WLZ_GREY_SHORT:
-	      WlzValueCopyShortToDouble(buf, iGWSp.u_grintptr.shp, itvLen);
-	      break;
-	    case WLZ_GREY_UBYTE:
-	      WlzValueCopyUByteToDouble(buf, iGWSp.u_grintptr.ubp, itvLen);
-	      break;
-	    case WLZ_GREY_FLOAT:
-	      WlzValueCopyFloatToDouble(buf, iGWSp.u_grintptr.flp, itvLen);
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      WlzValueCopyDoubleToDouble(buf, iGWSp.u_grintptr.dbp, itvLen);
-	      break;
-	    case WLZ_GREY_RGBA:
-	      WlzValueCopyRGBAToDouble(buf, iGWSp.u_grintptr.rgbp, itvLen);
-	      break;
-	    default:
-	      break;
-	  }
-	  switch(rGWSp.pixeltype)
-	  {
-	    case WLZ_GREY_UBYTE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		rGWSp.u_grintptr.ubp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_SHORT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, SHRT_MIN, SHRT_MAX);
-		rGWSp.u_grintptr.shp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_INT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, INT_MIN, INT_MAX);
-		rGWSp.u_grintptr.inp[idN] = WLZ_NINT(f);
-	      }
-	      break;
-	    case WLZ_GREY_RGBA:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		WlzUInt	u;
-
-		f = (buf[idN] * m) + a;
-		f = WLZ_CLAMP(f, 0, 255);
-		t = WLZ_NINT(f);
-                WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
-		rGWSp.u_grintptr.inp[idN] = u;
-	      }
-	    case WLZ_GREY_FLOAT:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		double	t;
-
-		t = (buf[idN] * m) + a;
-		rGWSp.u_grintptr.flp[idN] = WLZ_CLAMP(t, -(FLT_MAX), FLT_MAX);
-	      }
-	      break;
-	    case WLZ_GREY_DOUBLE:
-	      for(idN = 0; idN < itvLen; ++idN)
-	      {
-		rGWSp.u_grintptr.dbp[idN] = (buf[idN] * m) + a;
-	      }
-	      break;
-	    default:
-	      break;
-	  }
+	  case WLZ_GREY_INT:
+	    WlzValueCopyIntToDouble(buf, iGP.inp, itvLen);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    WlzValueCopyShortToDouble(buf, iGP.shp, itvLen);
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    WlzValueCopyUByteToDouble(buf, iGP.ubp, itvLen);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    WlzValueCopyFloatToDouble(buf, iGP.flp, itvLen);
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    WlzValueCopyDoubleToDouble(buf, iGP.dbp, itvLen);
+	    break;
+	  case WLZ_GREY_RGBA:
+	    WlzValueCopyRGBAToDouble(buf, iGP.rgbp, itvLen);
+	    break;
+	  default:
+	    break;
 	}
-	if(errNum == WLZ_ERR_EOO)
+	switch(rLWSp->gType)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  case WLZ_GREY_UBYTE:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, 0, 255);
+	      rGP.ubp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_SHORT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, SHRT_MIN, SHRT_MAX);
+	      rGP.shp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_INT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, INT_MIN, INT_MAX);
+	      rGP.inp[idN] = WLZ_NINT(f);
+	    }
+	    break;
+	  case WLZ_GREY_RGBA:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      WlzUInt	u;
+
+	      f = (buf[idN] * m) + a;
+	      f = WLZ_CLAMP(f, 0, 255);
+	      t = WLZ_NINT(f);
+	      WLZ_RGBA_RGBA_SET(u, t, t, t, 255);
+	      rGP.rgbp[idN] = u;
+	    }
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      f = (buf[idN] * m) + a;
+	      rGP.flp[idN] = WLZ_CLAMP(f, -(FLT_MAX), FLT_MAX);
+	    }
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    for(idN = 0; idN < itvLen; ++idN)
+	    {
+	      rGP.dbp[idN] = (buf[idN] * m) + a;
+	    }
+	    break;
+	  default:
+	    break;
 	}
       }
-      AlcFree(buf);
     }
-    (void )WlzEndGreyScan(&iIWSp, &iGWSp);
-    (void )WlzEndGreyScan(&rIWSp, &rGWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    WlzGreyLineScanFree(iLWSp);
+    WlzGreyLineScanFree(rLWSp);
+    AlcFree(buf);
   }
   return(errNum);
 }
@@ -41,6 +41,17 @@ static char _WlzSepTrans_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static WlzErrorNum 		WlzSepTransLines(
+				  WlzObject *obj,
+				  WlzIntervalConvFunc fun,
+				  void *params,
+				  WlzSepTransWSpace *stwspc);
+static WlzErrorNum 		WlzSepTransCopyBack(
+				  WlzSepTransWSpace *stwspc);
 
 /* function:     WlzSepTrans    */
 /*! 
@@ -49,6 +60,10 @@ static char _WlzSepTrans_c[] = "University of Edinburgh $Id$";
 * 		It is the users responsibility to ensure that the grey-value
 * 		types are appropriate.
 * 		Now extended to include compound objects.
+* 		The lines of the object are transformed concurrently
+* 		(when OpenMP is enabled) so the convolution functions
+* 		must be reentrant. The result does not depend on the
+* 		number of threads used.
 *
 * \return       Pointer to transformed object
 * \param    obj	Input object pointer
@@ -68,8 +83,6 @@ WlzObject *WlzSepTrans(
   void			*y_params,
   WlzErrorNum		*dstErr)
 {
-  WlzIntervalWSpace	iwspace;
-  WlzGreyWSpace		gwspace;
   WlzSepTransWSpace	stwspc;
   WlzValues		values;
   WlzObject		*obj1, *obj2;
@@ -79,7 +92,6 @@ WlzObject *WlzSepTrans(
 
   /* check object pointers and type */
   obj2 = NULL;
-  stwspc.outbuf.p.dbp = NULL;
   if( obj == NULL ){
     errNum = WLZ_ERR_OBJECT_NULL;
   }
@@ -138,7 +150,8 @@ WlzObject *WlzSepTrans(
     }
   }
 
-  /* make space for a calculation buffer - assume worst case of doubles */
+  /* set up the transform workspace, the buffers are allocated for each
+     thread using the maximum interval length */
   if( errNum == WLZ_ERR_NONE ){
     width  = obj->domain.i->lastkl - obj->domain.i->kol1 + 1;
     height = obj->domain.i->lastln - obj->domain.i->line1 + 1;
@@ -157,10 +170,7 @@ WlzObject *WlzSepTrans(
       break;
     }
 
-    if( (stwspc.outbuf.p.dbp = (double *) 
-	 AlcMalloc(sizeof(double)*(width>height?width:height))) == NULL){
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    stwspc.len = (width > height)? width: height;
   }
 
   /* tranpose the object - interchange x & y coordinates */
@@ -169,49 +179,10 @@ WlzObject *WlzSepTrans(
   }
 
   /* perform the y convolution */
-  if((errNum == WLZ_ERR_NONE) &&
-     ((errNum = WlzInitGreyScan(obj1, &iwspace, &gwspace)) == WLZ_ERR_NONE))
-  {
-    while( (errNum = WlzNextGreyInterval(&iwspace)) == WLZ_ERR_NONE ){
-      stwspc.inbuf.p.inp = gwspace.u_grintptr.inp;
-      stwspc.len = iwspace.rgtpos - iwspace.lftpos + 1;
-      if((errNum = (*y_fun)(&stwspc, y_params)) == WLZ_ERR_NONE){
-	switch(  stwspc.inbuf.type ){
-	case WLZ_GREY_INT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.inp++)
-	    *stwspc.inbuf.p.inp = stwspc.outbuf.p.inp[i];
-	  break;
-	case WLZ_GREY_SHORT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.shp++)
-	    *stwspc.inbuf.p.shp = (short )(stwspc.outbuf.p.inp[i]);
-	  break;
-	case WLZ_GREY_UBYTE:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.ubp++)
-	    *stwspc.inbuf.p.ubp = (WlzUByte )(stwspc.outbuf.p.inp[i]);
-	  break;
-	case WLZ_GREY_FLOAT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.flp++)
-	    *stwspc.inbuf.p.flp = stwspc.outbuf.p.flp[i];
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.dbp++)
-	    *stwspc.inbuf.p.dbp = stwspc.outbuf.p.dbp[i];
-	  break;
-	case WLZ_GREY_RGBA:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.rgbp++)
-	    *stwspc.inbuf.p.rgbp = stwspc.outbuf.p.rgbp[i];
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
-	}
-      }
-      else {
-	break; /* break from the while loop */
-      }
-    }
-    if( errNum == WLZ_ERR_EOO ){
-      errNum = WLZ_ERR_NONE;
+  if( errNum == WLZ_ERR_NONE ){
+    if((errNum = WlzSepTransLines(obj1, y_fun, y_params,
+				  &stwspc)) != WLZ_ERR_NONE){
+      WlzFreeObj(obj1);
     }
   }
 
@@ -222,60 +193,176 @@ WlzObject *WlzSepTrans(
   }
 
   /* perform x convolution */
-  if((errNum == WLZ_ERR_NONE) &&
-     ((errNum = WlzInitGreyScan(obj2, &iwspace, &gwspace)) == WLZ_ERR_NONE))
+  if( errNum == WLZ_ERR_NONE ){
+    if((errNum = WlzSepTransLines(obj2, x_fun, x_params,
+				  &stwspc)) != WLZ_ERR_NONE){
+      WlzFreeObj(obj2);
+      obj2 = NULL;
+    }
+  }
+
+  /* return transformed object */
+  if( dstErr ){
+    *dstErr = errNum;
+  }
+  return obj2;
+}
+
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Applies the given convolution function to every interval
+* 		of the given 2D object, replacing the object's values with
+* 		the transformed values. Lines are independent of each other
+* 		and are processed concurrently, with each thread having
+* 		it's own line workspace and output buffer.
+* \param	obj			Given 2D domain object.
+* \param	fun			Convolution function.
+* \param	params			Parameters for the convolution
+* 					function.
+* \param	stwspc			Separable transform workspace with
+* 					the grey types and background set
+* 					and the length set to the maximum
+* 					interval length.
+*/
+static WlzErrorNum WlzSepTransLines(
+  WlzObject		*obj,
+  WlzIntervalConvFunc	fun,
+  void			*params,
+  WlzSepTransWSpace	*stwspc)
+{
+  int			idL, idT, nLn,
+  			nThr = 1;
+  WlzSepTransWSpace	*thrWSp = NULL;
+  WlzGreyLineWSpace	**lWSp = NULL;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+#ifdef _OPENMP
+#pragma omp parallel
   {
-    while((errNum = WlzNextGreyInterval(&iwspace)) == WLZ_ERR_NONE){
-      stwspc.inbuf.p.inp = gwspace.u_grintptr.inp;
-      stwspc.len = iwspace.rgtpos - iwspace.lftpos + 1;
-      if( (errNum = (*x_fun)(&stwspc, x_params)) == WLZ_ERR_NONE ){
-	switch(  gwspace.pixeltype ){
-	case WLZ_GREY_INT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.inp++)
-	    *stwspc.inbuf.p.inp = stwspc.outbuf.p.inp[i];
-	  break;
-	case WLZ_GREY_SHORT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.shp++)
-	    *stwspc.inbuf.p.shp = (short )(stwspc.outbuf.p.inp[i]);
-	  break;
-	case WLZ_GREY_UBYTE:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.ubp++)
-	    *stwspc.inbuf.p.ubp = (WlzUByte )(stwspc.outbuf.p.inp[i]);
-	  break;
-	case WLZ_GREY_FLOAT:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.flp++)
-	    *stwspc.inbuf.p.flp = stwspc.outbuf.p.flp[i];
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.dbp++)
-	    *stwspc.inbuf.p.dbp = stwspc.outbuf.p.dbp[i];
-	  break;
-	case WLZ_GREY_RGBA:
-	  for(i=0; i < stwspc.len; i++, stwspc.inbuf.p.rgbp++)
-	    *stwspc.inbuf.p.rgbp = stwspc.outbuf.p.rgbp[i];
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  if(((thrWSp = (WlzSepTransWSpace *)
+                AlcCalloc(nThr, sizeof(WlzSepTransWSpace))) == NULL) ||
+     ((lWSp = (WlzGreyLineWSpace **)
+              AlcCalloc(nThr, sizeof(WlzGreyLineWSpace *))) == NULL)){
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* make space for a calculation buffer for each thread - assume worst
+     case of doubles */
+  for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); idT++){
+    thrWSp[idT] = *stwspc;
+    if((thrWSp[idT].outbuf.p.dbp = (double *)
+        AlcMalloc(sizeof(double) * stwspc->len)) == NULL){
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else {
+      lWSp[idT] = WlzGreyLineScanInit(obj, 1, &errNum);
+    }
+  }
+  if( errNum == WLZ_ERR_NONE ){
+    nLn = obj->domain.i->lastln - obj->domain.i->line1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(idL = 0; idL < nLn; idL++){
+      if( errNum == WLZ_ERR_NONE ){
+	int			idI,
+				thrId = 0;
+	WlzSepTransWSpace	*tWSp;
+	WlzGreyLineWSpace	*tLWSp;
+	WlzErrorNum		errNum2;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	tWSp = thrWSp + thrId;
+	tLWSp = lWSp[thrId];
+	errNum2 = WlzGreyLineScanLine(tLWSp, 0, obj->domain.i->line1 + idL);
+	for(idI = 0; (errNum2 == WLZ_ERR_NONE) && (idI < tLWSp->nItv);
+	    idI++){
+	  tWSp->inbuf.p = tLWSp->val[idI];
+	  tWSp->len = tLWSp->itv[idI].iright - tLWSp->itv[idI].ileft + 1;
+	  if((errNum2 = (*fun)(tWSp, params)) == WLZ_ERR_NONE){
+	    errNum2 = WlzSepTransCopyBack(tWSp);
+	  }
+	}
+	if( errNum2 != WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp critical (WlzSepTransLines)
+#endif
+	  {
+	    if( errNum == WLZ_ERR_NONE ){
+	      errNum = errNum2;
+	    }
+	  }
 	}
-      }
-      else {
-	break; /* break from the while loop */
       }
     }
   }
-  if( errNum == WLZ_ERR_EOO ){
-    errNum = WLZ_ERR_NONE;
+  if( thrWSp ){
+    for(idT = 0; idT < nThr; idT++){
+      AlcFree(thrWSp[idT].outbuf.p.dbp);
+    }
+    AlcFree(thrWSp);
   }
-
-  /* free the buffer and return transformed object */
-  if( stwspc.outbuf.p.dbp ){
-    AlcFree((void *) stwspc.outbuf.p.dbp);
+  if( lWSp ){
+    for(idT = 0; idT < nThr; idT++){
+      WlzGreyLineScanFree(lWSp[idT]);
+    }
+    AlcFree(lWSp);
   }
+  return errNum;
+}
 
-  if( dstErr ){
-    *dstErr = errNum;
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Copies the transformed values of an interval from the
+* 		output buffer back into the interval's grey values.
+* \param	stwspc			Separable transform workspace.
+*/
+static WlzErrorNum WlzSepTransCopyBack(
+  WlzSepTransWSpace	*stwspc)
+{
+  int		i;
+  WlzGreyP	gP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gP = stwspc->inbuf.p;
+  switch( stwspc->inbuf.type ){
+  case WLZ_GREY_INT:
+    for(i=0; i < stwspc->len; i++)
+      gP.inp[i] = stwspc->outbuf.p.inp[i];
+    break;
+  case WLZ_GREY_SHORT:
+    for(i=0; i < stwspc->len; i++)
+      gP.shp[i] = (short )(stwspc->outbuf.p.inp[i]);
+    break;
+  case WLZ_GREY_UBYTE:
+    for(i=0; i < stwspc->len; i++)
+      gP.ubp[i] = (WlzUByte )(stwspc->outbuf.p.inp[i]);
+    break;
+  case WLZ_GREY_FLOAT:
+    for(i=0; i < stwspc->len; i++)
+      gP.flp[i] = stwspc->outbuf.p.flp[i];
+    break;
+  case WLZ_GREY_DOUBLE:
+    for(i=0; i < stwspc->len; i++)
+      gP.dbp[i] = stwspc->outbuf.p.dbp[i];
+    break;
+  case WLZ_GREY_RGBA:
+    for(i=0; i < stwspc->len; i++)
+      gP.rgbp[i] = stwspc->outbuf.p.rgbp[i];
+    break;
+  default:
+    errNum = WLZ_ERR_GREY_TYPE;
+    break;
   }
-  return obj2;
+  return errNum;
 }
-
@@ -1445,6 +1445,9 @@ const char	*WlzStringFromInterpolationType(WlzInterpolationType iType,
     case WLZ_INTERPOLATION_CALLBACK:
       iStr = "WLZ_INTERPOLATION_CALLBACK";
       break;
+    case WLZ_INTERPOLATION_CUBIC:
+      iStr = "WLZ_INTERPOLATION_CUBIC";
+      break;
     default:
       errNum = WLZ_ERR_PARAM_DATA;
       break;
@@ -1477,6 +1480,7 @@ WlzInterpolationType WlzStringToInterpolationType(const char *iStr,
 		 "WLZ_INTERPOLATION_LINEAR", WLZ_INTERPOLATION_LINEAR,
 		 "WLZ_INTERPOLATION_CLASSIFY_1", WLZ_INTERPOLATION_CLASSIFY_1,
 		 "WLZ_INTERPOLATION_CALLBACK", WLZ_INTERPOLATION_CALLBACK,
+		 "WLZ_INTERPOLATION_CUBIC", WLZ_INTERPOLATION_CUBIC,
 		 NULL))
   {
     iType = (WlzInterpolationType )tI0;
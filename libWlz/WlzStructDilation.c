@@ -171,6 +171,12 @@ WlzObject *WlzStructDilation(
     }
   }
 
+  /* Boxes and large spheres are applied as runs when this is faster. */
+  if((errNum == WLZ_ERR_NONE) &&
+     WlzStructRunsApplicable(obj, structElm, 1, NULL)){
+    return WlzStructRunsDomain(obj, structElm, 1, dstErr);
+  }
+
   if( errNum == WLZ_ERR_NONE ){
     /*
      * use smaller object as the structuring element
@@ -328,6 +334,34 @@ WlzObject *WlzStructDilation(
 }
 
 
+/*!
+* \return	Object with the domain of the given object and new grey
+* 		values, NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the flat grey level dilation of the given object
+* 		with respect to the given structuring element. The value
+* 		at each position \f$p\f$ of the object's domain is the
+* 		maximum of the values at \f$p - s\f$ for all \f$s\f$ in the
+* 		structuring element for which these positions are within
+* 		the object's domain. The structuring element is
+* 		decomposed into runs, see WlzStructRunsGrey().
+* \param    obj	Input object with grey values.
+* \param    structElm	Structuring element.
+* \param    dstErr	Error return.
+* \par      Source:
+*                WlzStructDilation.c
+*/
+WlzObject *WlzStructGreyDilation(
+  WlzObject	*obj,
+  WlzObject	*structElm,
+  WlzErrorNum	*dstErr)
+{
+  if( structElm && (structElm->type == WLZ_TRANS_OBJ) ){
+    return WlzStructGreyDilation(obj, structElm->values.obj, dstErr);
+  }
+  return WlzStructRunsGrey(obj, structElm, 1, dstErr);
+}
+
 static int unionitvs(
   WlzIntervalLine	*itva,
   WlzIntervalLine	*itvb,
@@ -626,6 +660,12 @@ static WlzObject *WlzStructDilation3d(
     }
   }
 
+  /* boxes and large spheres are applied as runs when this is faster */
+  if( (errNum == WLZ_ERR_NONE) && !rtnObj &&
+      WlzStructRunsApplicable(obj, structElm, 1, NULL) ){
+    rtnObj = WlzStructRunsDomain(obj, structElm, 1, &errNum);
+  }
+
   /* this far with no errors and no rtnObj then the object and structuring
      element are 3D and have non-null and non-empty plane domains.
      We assume that the structuring element and object are standardised
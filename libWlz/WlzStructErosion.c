@@ -172,6 +172,12 @@ WlzObject *WlzStructErosion(
     }
   }
 
+  /* Boxes and large spheres are applied as runs when this is faster. */
+  if((errNum == WLZ_ERR_NONE) &&
+     WlzStructRunsApplicable(obj, structElm, 0, NULL)){
+    return WlzStructRunsDomain(obj, structElm, 0, dstErr);
+  }
+
   /* If we get this far we have 2D object and structuring element of
      domain type and with non-null domains */
   if(errNum == WLZ_ERR_NONE)
@@ -305,6 +311,34 @@ WlzObject *WlzStructErosion(
   return rtnObj;
 }
 
+
+/*!
+* \return	Object with the domain of the given object and new grey
+* 		values, NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the flat grey level erosion of the given object
+* 		with respect to the given structuring element. The value
+* 		at each position \f$p\f$ of the object's domain is the
+* 		minimum of the values at \f$p + s\f$ for all \f$s\f$ in the
+* 		structuring element for which these positions are within
+* 		the object's domain. The structuring element is
+* 		decomposed into runs, see WlzStructRunsGrey().
+* \param    obj	Input object with grey values.
+* \param    structElm	Structuring element.
+* \param    dstErr	Error return.
+* \par      Source:
+*                WlzStructErosion.c
+*/
+WlzObject *WlzStructGreyErosion(
+  WlzObject	*obj,
+  WlzObject	*structElm,
+  WlzErrorNum	*dstErr)
+{
+  if( structElm && (structElm->type == WLZ_TRANS_OBJ) ){
+    return WlzStructGreyErosion(obj, structElm->values.obj, dstErr);
+  }
+  return WlzStructRunsGrey(obj, structElm, 0, dstErr);
+}
 /*!
 * \return
 * \ingroup 	WlzMorphologyOpsitva
@@ -489,6 +523,7 @@ static WlzObject *WlzStructErosion3d(
   WlzDomain	domain, *domains = NULL, *domains1 = NULL, *domains2 = NULL;
   WlzValues	values;
   int		i, j, p, plane1, lastpl, nStructPlanes;
+  int		emptyPlanes = 0;
   WlzErrorNum	errNum=WLZ_ERR_NONE;
 
   /* the object is definitely 3D but the domain needs checking */
@@ -599,6 +634,19 @@ static WlzObject *WlzStructErosion3d(
     }
   }
 
+  /* boxes and large spheres are applied as runs when this is faster,
+     an empty result is returned as a plane domain with empty planes
+     just as the erosion below would return it */
+  if( (errNum == WLZ_ERR_NONE) && !rtnObj &&
+      WlzStructRunsApplicable(obj, structElm, 0, NULL) ){
+    rtnObj = WlzStructRunsDomain(obj, structElm, 0, &errNum);
+    if( rtnObj && (rtnObj->type == WLZ_EMPTY_OBJ) ){
+      WlzFreeObj(rtnObj);
+      rtnObj = NULL;
+      emptyPlanes = 1;
+    }
+  }
+
   /* now finally do the erosion */
   if( (errNum == WLZ_ERR_NONE) && !rtnObj ){
     domain.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
@@ -620,7 +668,7 @@ static WlzObject *WlzStructErosion3d(
       structElm->domain.p->plane1 + 1;
     objList = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * nStructPlanes);
 
-    for(p=plane1; p <= lastpl; p++, domains++){
+    for(p=plane1; !emptyPlanes && (p <= lastpl); p++, domains++){
       for(i=0; i < nStructPlanes; i++){
 	j = p + structElm->domain.p->plane1 + i - obj->domain.p->plane1;
 	if( domains1[j].core ){
@@ -0,0 +1,3389 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzStructRuns_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzStructRuns.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Dilation and erosion of domains and grey values using
+* 		structuring elements which are decomposed into runs
+* 		(intervals along single lines).
+*
+* 		A structuring element is decomposed into the runs of
+* 		it's domain. When every line of the element has at most
+* 		a single run (as for boxes, lines, discs, spheres and the
+* 		standard structuring elements) the element is row
+* 		convex and if all of it's runs are the same and fill it's
+* 		bounding box then it is a box.
+* 		Box elements are separable and are applied by passes
+* 		along the columns, lines and planes using the
+* 		van Herk/Gil-Werman algorithm, so that the cost of the
+* 		operation is independent of the size of the element.
+* 		Other elements are applied run by run to each output
+* 		line, so that the cost of the operation is independent
+* 		of the length of the element's runs. Discs and spheres
+* 		are mostly covered by a digital Euclidean ball, which
+* 		is applied by thresholding an exact squared distance
+* 		transform with a cost independent of it's radius,
+* 		leaving only a few residual runs to be applied run by
+* 		run.
+* 		See: M. van Herk. "A fast algorithm for local minimum and
+* 		maximum filters on rectangular and octagonal kernels"
+* 		Pattern Recognition Letters 13:517-521, 1992 and
+* 		J. Gil and M. Werman. "Computing 2-D min, median, and max
+* 		filters" IEEE PAMI 15(5):504-507, 1993.
+* \ingroup	WlzMorphologyOps
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <float.h>
+#include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_STRUCTRUNS_EDT_BLK
+* \ingroup	WlzMorphologyOps
+* \brief	Number of columns which are gathered together when
+* 		computing distance transforms through the lines or
+* 		planes of a buffer.
+*/
+#define WLZ_STRUCTRUNS_EDT_BLK	(16)
+
+/*!
+* \def		WLZ_STRUCTRUNS_BOX_MIN
+* \ingroup	WlzMorphologyOps
+* \brief	Minimum width or height of a 2D box structuring element
+* 		for which the van Herk/Gil-Werman passes are used in
+* 		preference to WlzStructDilation() and WlzStructErosion().
+*/
+#define WLZ_STRUCTRUNS_BOX_MIN	(32)
+
+/*!
+* \def		WLZ_STRUCTRUNS_BALL_GAIN
+* \ingroup	WlzMorphologyOps
+* \brief	A 3D Euclidean ball is only applied using a distance
+* 		transform when the number of runs it covers exceeds this
+* 		multiple of the width of the domain (in columns) which
+* 		the distance transform is computed over.
+*/
+#define WLZ_STRUCTRUNS_BALL_GAIN	(8)
+
+/*!
+* \struct	_WlzStructRun
+* \ingroup	WlzMorphologyOps
+* \brief	A single run of a structuring element, with coordinates
+* 		relative to the structuring element's origin.
+* 		Typedef: ::WlzStructRun.
+*/
+typedef struct _WlzStructRun
+{
+  int		pl;		/*!< Plane offset. */
+  int		ln;		/*!< Line offset. */
+  int		kl0;		/*!< First column offset. */
+  int		kl1;		/*!< Last column offset. */
+} WlzStructRun;
+
+/*!
+* \struct	_WlzStructRunSet
+* \ingroup	WlzMorphologyOps
+* \brief	A structuring element decomposed into runs, with the runs
+* 		ordered by plane, then line and then column.
+* 		Typedef: ::WlzStructRunSet.
+*/
+typedef struct _WlzStructRunSet
+{
+  int		nRun;		/*!< Number of runs. */
+  int		rowConvex;	/*!< Non-zero if no line has more than a
+  				     single run. */
+  int		box;		/*!< Non-zero if the runs fill the bounding
+  				     box. */
+  WlzIBox3	bBox;		/*!< Bounding box of the runs. */
+  WlzStructRun	*run;		/*!< The runs. */
+} WlzStructRunSet;
+
+/*!
+* \struct	_WlzStructRunRow
+* \ingroup	WlzMorphologyOps
+* \brief	The intervals of a single line of a domain, with absolute
+* 		column coordinates. The intervals are ordered, disjoint
+* 		and not adjacent.
+* 		Typedef: ::WlzStructRunRow.
+*/
+typedef struct _WlzStructRunRow
+{
+  int		nItv;		/*!< Number of intervals. */
+  WlzInterval	*itv;		/*!< Intervals, NULL if there are none. */
+} WlzStructRunRow;
+
+/*!
+* \struct	_WlzStructRunGrid
+* \ingroup	WlzMorphologyOps
+* \brief	The lines of a 2D or 3D domain held as a grid of rows
+* 		indexed by plane and then line. A 2D domain has a single
+* 		plane at zero.
+* 		Typedef: ::WlzStructRunGrid.
+*/
+typedef struct _WlzStructRunGrid
+{
+  int		pl1;		/*!< First plane. */
+  int		nPl;		/*!< Number of planes. */
+  int		ln1;		/*!< First line. */
+  int		nLn;		/*!< Number of lines. */
+  int		kol1;		/*!< First column of any interval. */
+  int		lastkl;		/*!< Last column of any interval. */
+  WlzStructRunRow *row;		/*!< Rows, nPl x nLn. */
+} WlzStructRunGrid;
+
+static void			WlzStructRunSetFree(
+				  WlzStructRunSet *rSet);
+static void			WlzStructRunGridFree(
+				  WlzStructRunGrid *grd);
+static void			WlzStructRunSetBound(
+				  WlzStructRunSet *rSet);
+static void			WlzStructRunGridShiftX(
+				  WlzStructRunGrid *grd,
+				  int kl0,
+				  int kl1,
+				  int dilate);
+static void			WlzStructRunsVHG1D(
+				  double *src,
+				  int n,
+				  int a,
+				  int b,
+				  int dilate,
+				  double *dst,
+				  double *g,
+				  double *h);
+static void			WlzStructRunsEDT1D(
+				  int *f,
+				  int n,
+				  int lim,
+				  int *d,
+				  int *v,
+				  double *z);
+static void			WlzStructRunsEDTCols(
+				  int **rows,
+				  int n,
+				  int nX,
+				  int lim,
+				  int *f,
+				  int *d,
+				  int *v,
+				  double *z);
+static int			WlzStructRunsISqrt(
+				  int q);
+static int			WlzStructRunsBallCheaper(
+				  WlzStructRunSet *rSet,
+				  WlzStructRunSet *eSet,
+				  int rho,
+				  int width,
+				  int dilate);
+static int			WlzStructRunsItvLn(
+				  WlzIntervalDomain *iDom,
+				  int ln,
+				  WlzInterval *rItv,
+				  WlzInterval **dstItv);
+static int			WlzStructRunsItvUnion(
+				  WlzInterval *a,
+				  int nA,
+				  WlzInterval *b,
+				  int nB,
+				  WlzInterval *c);
+static int			WlzStructRunsItvIntersect(
+				  WlzInterval *a,
+				  int nA,
+				  WlzInterval *b,
+				  int nB,
+				  WlzInterval *c);
+static WlzErrorNum		WlzStructRunRowOp(
+				  WlzStructRunRow *a,
+				  WlzStructRunRow *b,
+				  int dilate,
+				  WlzStructRunRow *c);
+static WlzErrorNum		WlzStructRunsGreyIO(
+				  WlzObject *gObj,
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  int pl,
+				  double **pln,
+				  double bgd,
+				  int set);
+static WlzErrorNum		WlzStructRunsGreyBox(
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  WlzStructRunSet *rSet,
+				  int dilate);
+static WlzErrorNum		WlzStructRunsGreyPlane(
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  WlzStructRunSet *rSet,
+				  int dilate,
+				  int pl,
+				  double **pln);
+static WlzObject		*WlzStructRunGridToObj(
+				  WlzStructRunGrid *grd,
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzStructRunsPlaneObj(
+				  WlzObject *gObj,
+				  int pl,
+				  WlzErrorNum *dstErr);
+static WlzStructRunSet		*WlzStructRunSetMake(
+				  WlzObject *sObj,
+				  WlzErrorNum *dstErr);
+static WlzStructRunSet		*WlzStructRunSetBall(
+				  WlzStructRunSet *rSet,
+				  int *dstRho,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridMake(
+				  int pl1,
+				  int nPl,
+				  int ln1,
+				  int nLn,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridFromObj(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridVHG(
+				  WlzStructRunGrid *gIn,
+				  int alongPl,
+				  int o0,
+				  int o1,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridRuns(
+				  WlzStructRunGrid *gIn,
+				  WlzStructRunSet *rSet,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridBall(
+				  WlzStructRunGrid *gIn,
+				  int ball3D,
+				  int rho,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+static WlzStructRunGrid		*WlzStructRunGridCombine(
+				  WlzStructRunGrid *gA,
+				  WlzStructRunGrid *gB,
+				  int dilate,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	Non-zero if WlzStructRunsDomain() is expected to be
+* 		faster than WlzStructDilation() or WlzStructErosion().
+* \ingroup	WlzMorphologyOps
+* \brief	Decides whether the given object should be dilated or
+* 		eroded by the given structuring element using
+* 		WlzStructRunsDomain(). This is so for 3D box elements,
+* 		for 2D box elements of at least ::WLZ_STRUCTRUNS_BOX_MIN
+* 		columns or lines, for 3D elements which are mostly
+* 		covered by a Euclidean ball (such as large spheres),
+* 		see ::WLZ_STRUCTRUNS_BALL_GAIN, and for erosions by an
+* 		element which is larger than the object. The interval
+* 		based WlzStructDilation() and WlzStructErosion() are
+* 		faster for small elements and for discs.
+* \param	obj			Given 2D or 3D domain object.
+* \param	sObj			Given structuring element.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+int		WlzStructRunsApplicable(WlzObject *obj, WlzObject *sObj,
+					int dilate, WlzErrorNum *dstErr)
+{
+  int		use = 0;
+  WlzIBox3	oBox;
+  WlzStructRunSet *rSet = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj == NULL) || (sObj == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(((obj->type != WLZ_2D_DOMAINOBJ) &&
+           (obj->type != WLZ_3D_DOMAINOBJ)) ||
+	  ((obj->type == WLZ_2D_DOMAINOBJ) &&
+	   (sObj->type != WLZ_2D_DOMAINOBJ)))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((obj->domain.core == NULL) || (sObj->domain.core == NULL))
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    oBox = WlzBoundingBox3I(obj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rSet = WlzStructRunSetMake(sObj, &errNum);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (rSet->nRun > 0))
+  {
+    if((dilate == 0) &&
+       ((rSet->bBox.xMax - rSet->bBox.xMin > oBox.xMax - oBox.xMin) ||
+        (rSet->bBox.yMax - rSet->bBox.yMin > oBox.yMax - oBox.yMin) ||
+        (rSet->bBox.zMax - rSet->bBox.zMin > oBox.zMax - oBox.zMin)))
+    {
+      use = 1;
+    }
+    else if(rSet->box)
+    {
+      use = (obj->type == WLZ_3D_DOMAINOBJ) ||
+            (rSet->bBox.xMax - rSet->bBox.xMin >= WLZ_STRUCTRUNS_BOX_MIN) ||
+            (rSet->bBox.yMax - rSet->bBox.yMin >= WLZ_STRUCTRUNS_BOX_MIN);
+    }
+    else
+    {
+      int	rho = -1;
+      WlzStructRunSet *eSet;
+
+      eSet = WlzStructRunSetBall(rSet, &rho, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	use = WlzStructRunsBallCheaper(rSet, eSet, rho,
+				       oBox.xMax - oBox.xMin + 1, dilate);
+      }
+      WlzStructRunSetFree(eSet);
+    }
+  }
+  WlzStructRunSetFree(rSet);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(use);
+}
+
+/*!
+* \return	New domain object or an empty object, NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the domain of the given object using the
+* 		given structuring element decomposed into runs.
+* 		The dilated domain is the union of the structuring element
+* 		placed at every position of the object's domain and the
+* 		eroded domain is the set of positions at which the
+* 		structuring element lies entirely within the object's
+* 		domain.
+* 		If the structuring element is a box then the domain is
+* 		dilated or eroded by separable van Herk/Gil-Werman passes
+* 		along the columns, lines and planes, with the cost of the
+* 		operation independent of the size of the box. Otherwise
+* 		each output line is computed from the runs of the
+* 		structuring element and the corresponding input lines,
+* 		except that when a structuring element (such as a disc
+* 		or sphere) is mostly covered by a Euclidean ball the
+* 		ball is applied using a squared distance transform and
+* 		only the residual runs are applied to each output line.
+* 		In both cases lines (or planes) are processed in
+* 		parallel.
+* \param	obj			Given 2D or 3D domain object.
+* \param	sObj			Given non-empty structuring element
+* 					with the same dimension as the object,
+* 					or a 2D structuring element for a 3D
+* 					object.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzStructRunsDomain(WlzObject *obj, WlzObject *sObj,
+				     int dilate, WlzErrorNum *dstErr)
+{
+  WlzObject	*rObj = NULL;
+  WlzStructRunSet *rSet = NULL;
+  WlzStructRunGrid *grd = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj == NULL) || (sObj == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(((obj->type != WLZ_2D_DOMAINOBJ) &&
+           (obj->type != WLZ_3D_DOMAINOBJ)) ||
+	  ((obj->type == WLZ_2D_DOMAINOBJ) &&
+	   (sObj->type != WLZ_2D_DOMAINOBJ)))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((rSet = WlzStructRunSetMake(sObj, &errNum)) != NULL)
+  {
+    if(rSet->nRun < 1)
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+    else
+    {
+      grd = WlzStructRunGridFromObj(obj, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((dilate == 0) &&
+       ((rSet->bBox.xMax - rSet->bBox.xMin > grd->lastkl - grd->kol1) ||
+	(rSet->bBox.yMax - rSet->bBox.yMin >= grd->nLn) ||
+	(rSet->bBox.zMax - rSet->bBox.zMin >= grd->nPl)))
+    {
+      /* The structuring element can not fit within the object. */
+      WlzStructRunGridFree(grd);
+      grd = NULL;
+    }
+    else if(rSet->box)
+    {
+      WlzStructRunGrid *tGrd;
+
+      WlzStructRunGridShiftX(grd, rSet->bBox.xMin, rSet->bBox.xMax, dilate);
+      if(rSet->bBox.yMax > rSet->bBox.yMin)
+      {
+        tGrd = WlzStructRunGridVHG(grd, 0, rSet->bBox.yMin, rSet->bBox.yMax,
+				   dilate, &errNum);
+	WlzStructRunGridFree(grd);
+	grd = tGrd;
+      }
+      else if(rSet->bBox.yMin != 0)
+      {
+        grd->ln1 += (dilate)? rSet->bBox.yMin: -(rSet->bBox.yMin);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	if(rSet->bBox.zMax > rSet->bBox.zMin)
+	{
+	  tGrd = WlzStructRunGridVHG(grd, 1, rSet->bBox.zMin,
+				     rSet->bBox.zMax, dilate, &errNum);
+	  WlzStructRunGridFree(grd);
+	  grd = tGrd;
+	}
+	else if(rSet->bBox.zMin != 0)
+	{
+	  grd->pl1 += (dilate)? rSet->bBox.zMin: -(rSet->bBox.zMin);
+	}
+      }
+    }
+    else
+    {
+      int	rho = -1;
+      WlzStructRunSet *eSet;
+      WlzStructRunGrid *tGrd = NULL;
+
+      /* Discs and spheres are covered by a Euclidean ball, which is
+       * applied using a distance transform, and a few residual runs.
+       * The ball is used when this is cheaper than applying all the
+       * runs to each output line. */
+      eSet = WlzStructRunSetBall(rSet, &rho, &errNum);
+      if((errNum == WLZ_ERR_NONE) &&
+         WlzStructRunsBallCheaper(rSet, eSet, rho,
+	 			  grd->lastkl - grd->kol1 + 1, dilate))
+      {
+        WlzStructRunGrid *bGrd,
+			*eGrd = NULL;
+
+	bGrd = WlzStructRunGridBall(grd, 1, rho, dilate, &errNum);
+	if((errNum == WLZ_ERR_NONE) && (eSet->nRun > 0))
+	{
+	  eGrd = WlzStructRunGridRuns(grd, eSet, dilate, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    tGrd = WlzStructRunGridCombine(bGrd, eGrd, dilate, &errNum);
+	  }
+	  WlzStructRunGridFree(bGrd);
+	  WlzStructRunGridFree(eGrd);
+	}
+	else
+	{
+	  tGrd = bGrd;
+	}
+      }
+      else if(errNum == WLZ_ERR_NONE)
+      {
+	tGrd = WlzStructRunGridRuns(grd, rSet, dilate, &errNum);
+      }
+      WlzStructRunSetFree(eSet);
+      WlzStructRunGridFree(grd);
+      grd = tGrd;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(grd == NULL)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else
+    {
+      rObj = WlzStructRunGridToObj(grd, obj, &errNum);
+    }
+  }
+  WlzStructRunGridFree(grd);
+  WlzStructRunSetFree(rSet);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New object with the domain of the given object and new
+* 		grey values, NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the flat grey level dilation or erosion of the
+* 		given object using the given structuring element
+* 		decomposed into runs. Only values within the object's
+* 		domain are used, so that the dilated value at \f$p\f$ is
+* 		the maximum of the values at \f$p - s\f$ and the eroded
+* 		value is the minimum of the values at \f$p + s\f$, for
+* 		all \f$s\f$ in the structuring element for which these
+* 		positions are within the object's domain. Positions for
+* 		which there are no such values are set to the background
+* 		value.
+* 		For a box structuring element the values are filtered
+* 		using separable van Herk/Gil-Werman maximum or minimum
+* 		filters along the columns, lines and planes, with the
+* 		cost independent of the size of the box. For other
+* 		structuring elements the maximum or minimum along each
+* 		run is found using a van Herk/Gil-Werman filter, so that
+* 		the cost is proportional to the number of runs rather
+* 		than the number of pixels in the structuring element.
+* 		The values are held in a buffer of doubles which covers
+* 		the object's bounding box.
+* \param	gObj			Given 2D or 3D domain object with
+* 					values which are not of RGBA type.
+* \param	sObj			Given structuring element with the
+* 					same dimension as the object, or a 2D
+* 					structuring element for a 3D object.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzStructRunsGrey(WlzObject *gObj, WlzObject *sObj,
+				   int dilate, WlzErrorNum *dstErr)
+{
+  int		pl;
+  double	bgd = 0.0;
+  double	**pln = NULL;
+  double	***vol = NULL;
+  WlzIBox3	bBox;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  WlzPixelV	bgdV;
+  WlzValues	val;
+  WlzObject	*rObj = NULL;
+  WlzStructRunSet *rSet = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  val.core = NULL;
+  bBox.xMin = bBox.yMin = bBox.zMin = 0;
+  bBox.xMax = bBox.yMax = bBox.zMax = -1;
+  if((gObj == NULL) || (sObj == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(((gObj->type != WLZ_2D_DOMAINOBJ) &&
+           (gObj->type != WLZ_3D_DOMAINOBJ)) ||
+	  ((gObj->type == WLZ_2D_DOMAINOBJ) &&
+	   (sObj->type != WLZ_2D_DOMAINOBJ)))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(gObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(gObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(gObj->domain.core->type == WLZ_EMPTY_DOMAIN)
+  {
+    return(WlzMakeEmpty(dstErr));
+  }
+  else if((gObj->type == WLZ_3D_DOMAINOBJ) &&
+          (gObj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN))
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    gType = WlzGreyTypeFromObj(gObj, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (gType == WLZ_GREY_RGBA))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV = WlzGetBackground(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzPixelV	tV;
+
+    tV = bgdV;
+    (void )WlzValueConvertPixel(&tV, tV, WLZ_GREY_DOUBLE);
+    bgd = tV.v.dbv;
+    rSet = WlzStructRunSetMake(sObj, &errNum);
+  }
+  /* Create the new values and the new object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObjectType gTType;
+
+    gTType = WlzGreyTableType(WLZ_GREY_TAB_RAGR, gType, NULL);
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      val.v = WlzNewValueTb(gObj, gTType, bgdV, &errNum);
+    }
+    else
+    {
+      val.vox = WlzNewValuesVox(gObj, gTType, bgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzMakeMain(gObj->type, gObj->domain, val, NULL, NULL, &errNum);
+    if(rObj == NULL)
+    {
+      (void )WlzFreeValues(val);
+    }
+  }
+  /* Read the given values into a buffer covering the bounding box with
+   * the positions outside of the domain set to the neutral value. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      bBox.xMin = gObj->domain.i->kol1;
+      bBox.xMax = gObj->domain.i->lastkl;
+      bBox.yMin = gObj->domain.i->line1;
+      bBox.yMax = gObj->domain.i->lastln;
+      bBox.zMin = bBox.zMax = 0;
+    }
+    else
+    {
+      bBox.xMin = gObj->domain.p->kol1;
+      bBox.xMax = gObj->domain.p->lastkl;
+      bBox.yMin = gObj->domain.p->line1;
+      bBox.yMax = gObj->domain.p->lastln;
+      bBox.zMin = gObj->domain.p->plane1;
+      bBox.zMax = gObj->domain.p->lastpl;
+    }
+    if(AlcDouble3Malloc(&vol, bBox.zMax - bBox.zMin + 1,
+                        bBox.yMax - bBox.yMin + 1,
+			bBox.xMax - bBox.xMin + 1) != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      size_t	idx,
+      		nVal;
+      double	nul;
+
+      nul = (dilate)? -DBL_MAX: DBL_MAX;
+      nVal = (size_t )(bBox.zMax - bBox.zMin + 1) *
+             (bBox.yMax - bBox.yMin + 1) * (bBox.xMax - bBox.xMin + 1);
+      for(idx = 0; idx < nVal; ++idx)
+      {
+        vol[0][0][idx] = nul;
+      }
+    }
+  }
+  for(pl = bBox.zMin; (errNum == WLZ_ERR_NONE) && (pl <= bBox.zMax); ++pl)
+  {
+    errNum = WlzStructRunsGreyIO(gObj, vol, bBox, pl, NULL, bgd, 0);
+  }
+  /* Filter and then write the values to the new object. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(rSet->box)
+    {
+      errNum = WlzStructRunsGreyBox(vol, bBox, rSet, dilate);
+      for(pl = bBox.zMin; (errNum == WLZ_ERR_NONE) && (pl <= bBox.zMax);
+          ++pl)
+      {
+	errNum = WlzStructRunsGreyIO(rObj, vol, bBox, pl,
+				     vol[pl - bBox.zMin], bgd, 1);
+      }
+    }
+    else
+    {
+      if(AlcDouble2Malloc(&pln, bBox.yMax - bBox.yMin + 1,
+                          bBox.xMax - bBox.xMin + 1) != ALC_ER_NONE)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      for(pl = bBox.zMin; (errNum == WLZ_ERR_NONE) && (pl <= bBox.zMax);
+          ++pl)
+      {
+	errNum = WlzStructRunsGreyPlane(vol, bBox, rSet, dilate, pl, pln);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzStructRunsGreyIO(rObj, vol, bBox, pl, pln, bgd, 1);
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  (void )Alc2Free((void **)pln);
+  (void )Alc3Free((void ***)vol);
+  WlzStructRunSetFree(rSet);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	New run set or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Decomposes the given structuring element into runs.
+* \param	sObj			Given 2D or 3D domain structuring
+* 					element.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunSet		*WlzStructRunSetMake(
+				  WlzObject *sObj,
+				  WlzErrorNum *dstErr)
+{
+  int		pl,
+		pl1 = 0,
+		lastpl = 0,
+		pass,
+		nRun = 0;
+  WlzDomain	*doms = NULL;
+  WlzStructRunSet *rSet = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(sObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(sObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(sObj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	doms = &(sObj->domain);
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(sObj->domain.core->type == WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  pl1 = sObj->domain.p->plane1;
+	  lastpl = sObj->domain.p->lastpl;
+	  doms = sObj->domain.p->domains;
+	}
+	else if(sObj->domain.core->type != WLZ_EMPTY_DOMAIN)
+	{
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((rSet = (WlzStructRunSet *)
+               AlcCalloc(1, sizeof(WlzStructRunSet))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      rSet->rowConvex = 1;
+    }
+  }
+  /* Count the runs on the first pass and then set them on the second. */
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (doms != NULL) && (pass < 2);
+      ++pass)
+  {
+    nRun = 0;
+    for(pl = pl1; pl <= lastpl; ++pl)
+    {
+      int	ln;
+      WlzIntervalDomain *iDom;
+
+      iDom = doms[pl - pl1].i;
+      if((iDom == NULL) || (iDom->type == WLZ_EMPTY_DOMAIN))
+      {
+        continue;
+      }
+      for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+      {
+	int	  idI,
+		  nItv;
+	WlzInterval rItv;
+	WlzInterval *itv = NULL;
+
+	nItv = WlzStructRunsItvLn(iDom, ln, &rItv, &itv);
+	if(pass == 0)
+	{
+	  if(nItv > 1)
+	  {
+	    rSet->rowConvex = 0;
+	  }
+	}
+	else
+	{
+	  for(idI = 0; idI < nItv; ++idI)
+	  {
+	    WlzStructRun *run;
+
+	    run = rSet->run + nRun + idI;
+	    run->pl = pl;
+	    run->ln = ln;
+	    run->kl0 = iDom->kol1 + itv[idI].ileft;
+	    run->kl1 = iDom->kol1 + itv[idI].iright;
+	  }
+	}
+	nRun += nItv;
+      }
+    }
+    if((pass == 0) && (nRun > 0))
+    {
+      if((rSet->run = (WlzStructRun *)
+                      AlcMalloc(sizeof(WlzStructRun) * nRun)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rSet->nRun = nRun;
+    WlzStructRunSetBound(rSet);
+  }
+  else
+  {
+    WlzStructRunSetFree(rSet);
+    rSet = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rSet);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the bounding box of the given run set and whether
+* 		it is a box.
+* \param	rSet			Given run set with it's runs and
+* 					row convex flag set.
+*/
+static void			WlzStructRunSetBound(
+				  WlzStructRunSet *rSet)
+{
+  int		idR;
+  WlzIBox3	*b;
+
+  b = &(rSet->bBox);
+  b->xMin = b->xMax = b->yMin = b->yMax = b->zMin = b->zMax = 0;
+  for(idR = 0; idR < rSet->nRun; ++idR)
+  {
+    WlzStructRun *run;
+
+    run = rSet->run + idR;
+    if(idR == 0)
+    {
+      b->xMin = run->kl0;
+      b->xMax = run->kl1;
+      b->yMin = b->yMax = run->ln;
+      b->zMin = b->zMax = run->pl;
+    }
+    else
+    {
+      b->xMin = ALG_MIN(b->xMin, run->kl0);
+      b->xMax = ALG_MAX(b->xMax, run->kl1);
+      b->yMin = ALG_MIN(b->yMin, run->ln);
+      b->yMax = ALG_MAX(b->yMax, run->ln);
+      b->zMin = ALG_MIN(b->zMin, run->pl);
+      b->zMax = ALG_MAX(b->zMax, run->pl);
+    }
+  }
+  /* A row convex set of runs is a box if it has a run on every line
+   * of it's bounding box and every run spans the bounding box. */
+  rSet->box = (rSet->nRun > 0) && rSet->rowConvex &&
+              (rSet->nRun == (b->yMax - b->yMin + 1) *
+                             (b->zMax - b->zMin + 1));
+  for(idR = 0; rSet->box && (idR < rSet->nRun); ++idR)
+  {
+    rSet->box = (rSet->run[idR].kl0 == b->xMin) &&
+                (rSet->run[idR].kl1 == b->xMax);
+  }
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Frees a run set.
+* \param	rSet			Given run set, may be NULL.
+*/
+static void			WlzStructRunSetFree(
+				  WlzStructRunSet *rSet)
+{
+  if(rSet)
+  {
+    AlcFree(rSet->run);
+    AlcFree(rSet);
+  }
+}
+
+/*!
+* \return	Number of intervals in the line.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the intervals of a line of an interval domain.
+* 		The interval columns are relative to the domain's first
+* 		column.
+* \param	iDom			Given interval domain.
+* \param	ln			Given line.
+* \param	rItv			Space for the single interval of a
+* 					rectangular domain.
+* \param	dstItv			Destination pointer for the
+* 					intervals.
+*/
+static int			WlzStructRunsItvLn(
+				  WlzIntervalDomain *iDom,
+				  int ln,
+				  WlzInterval *rItv,
+				  WlzInterval **dstItv)
+{
+  int		nItv = 0;
+
+  if((ln >= iDom->line1) && (ln <= iDom->lastln))
+  {
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      nItv = 1;
+      rItv->ileft = 0;
+      rItv->iright = iDom->lastkl - iDom->kol1;
+      *dstItv = rItv;
+    }
+    else
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + ln - iDom->line1;
+      nItv = iLn->nintvs;
+      *dstItv = iLn->intvs;
+    }
+  }
+  return(nItv);
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a new row grid in which all rows are empty.
+* \param	pl1			First plane.
+* \param	nPl			Number of planes, may be zero.
+* \param	ln1			First line.
+* \param	nLn			Number of lines, may be zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridMake(
+				  int pl1,
+				  int nPl,
+				  int ln1,
+				  int nLn,
+				  WlzErrorNum *dstErr)
+{
+  WlzStructRunGrid *grd = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((grd = (WlzStructRunGrid *)
+            AlcCalloc(1, sizeof(WlzStructRunGrid))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    grd->pl1 = pl1;
+    grd->ln1 = ln1;
+    grd->nPl = ALG_MAX(nPl, 0);
+    grd->nLn = ALG_MAX(nLn, 0);
+    if((grd->nPl > 0) && (grd->nLn > 0))
+    {
+      if((grd->row = (WlzStructRunRow *)
+                     AlcCalloc((size_t )(grd->nPl) * grd->nLn,
+		               sizeof(WlzStructRunRow))) == NULL)
+      {
+        AlcFree(grd);
+	grd = NULL;
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(grd);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Frees a row grid and the intervals of it's rows.
+* \param	grd			Given row grid, may be NULL.
+*/
+static void			WlzStructRunGridFree(
+				  WlzStructRunGrid *grd)
+{
+  if(grd)
+  {
+    if(grd->row)
+    {
+      size_t	idx,
+      		nRow;
+
+      nRow = (size_t )(grd->nPl) * grd->nLn;
+      for(idx = 0; idx < nRow; ++idx)
+      {
+        AlcFree(grd->row[idx].itv);
+      }
+      AlcFree(grd->row);
+    }
+    AlcFree(grd);
+  }
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a row grid from the domain of the given object.
+* \param	obj			Given 2D or 3D domain object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridFromObj(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr)
+{
+  int		pl,
+  		pl1 = 0,
+  		lastpl = 0,
+		ln1 = 0,
+		lastln = -1;
+  WlzDomain	*doms = NULL;
+  WlzStructRunGrid *grd = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    doms = &(obj->domain);
+    if(obj->domain.core->type != WLZ_EMPTY_DOMAIN)
+    {
+      ln1 = obj->domain.i->line1;
+      lastln = obj->domain.i->lastln;
+    }
+  }
+  else if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else
+  {
+    doms = obj->domain.p->domains;
+    pl1 = obj->domain.p->plane1;
+    lastpl = obj->domain.p->lastpl;
+    ln1 = obj->domain.p->line1;
+    lastln = obj->domain.p->lastln;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    grd = WlzStructRunGridMake(pl1, lastpl - pl1 + 1, ln1, lastln - ln1 + 1,
+                               &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		first = 1;
+
+    for(pl = pl1; (errNum == WLZ_ERR_NONE) && (pl <= lastpl); ++pl)
+    {
+      int	ln;
+      WlzIntervalDomain *iDom;
+
+      iDom = doms[pl - pl1].i;
+      if((iDom == NULL) || (iDom->type == WLZ_EMPTY_DOMAIN))
+      {
+	continue;
+      }
+      for(ln = iDom->line1; ln <= iDom->lastln; ++ln)
+      {
+	int	  idI,
+		  nItv;
+	WlzInterval rItv;
+	WlzInterval *itv = NULL;
+	WlzStructRunRow *row;
+
+	nItv = WlzStructRunsItvLn(iDom, ln, &rItv, &itv);
+	if(nItv > 0)
+	{
+	  row = grd->row + ((pl - pl1) * grd->nLn) + ln - ln1;
+	  if((row->itv = (WlzInterval *)
+	                 AlcMalloc(sizeof(WlzInterval) * nItv)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	    break;
+	  }
+	  row->nItv = nItv;
+	  for(idI = 0; idI < nItv; ++idI)
+	  {
+	    row->itv[idI].ileft = iDom->kol1 + itv[idI].ileft;
+	    row->itv[idI].iright = iDom->kol1 + itv[idI].iright;
+	  }
+	  if(first)
+	  {
+	    first = 0;
+	    grd->kol1 = row->itv[0].ileft;
+	    grd->lastkl = row->itv[nItv - 1].iright;
+	  }
+	  else
+	  {
+	    grd->kol1 = ALG_MIN(grd->kol1, row->itv[0].ileft);
+	    grd->lastkl = ALG_MAX(grd->lastkl, row->itv[nItv - 1].iright);
+	  }
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzStructRunGridFree(grd);
+    grd = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(grd);
+}
+
+/*!
+* \return	New object with an interval or plane domain or an empty
+* 		object, NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a new domain object from the given row grid. The
+* 		planes of a 3D domain are made in parallel.
+* \param	grd			Given row grid.
+* \param	obj			Object from which the row grid was
+* 					derived, used for the object type and
+* 					voxel size.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructRunGridToObj(
+				  WlzStructRunGrid *grd,
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr)
+{
+  int		idP,
+		nNonEmpty = 0;
+  WlzDomain	dom;
+  WlzDomain	*doms = NULL;
+  WlzValues	val;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if((grd->nPl < 1) || (grd->nLn < 1))
+  {
+    rObj = WlzMakeEmpty(&errNum);
+  }
+  else if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    doms = &dom;
+  }
+  else
+  {
+    if((dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+                                   grd->pl1, grd->pl1 + grd->nPl - 1,
+				   grd->ln1, grd->ln1 + grd->nLn - 1,
+				   grd->kol1, grd->lastkl,
+				   &errNum)) != NULL)
+    {
+      dom.p->voxel_size[0] = obj->domain.p->voxel_size[0];
+      dom.p->voxel_size[1] = obj->domain.p->voxel_size[1];
+      dom.p->voxel_size[2] = obj->domain.p->voxel_size[2];
+      doms = dom.p->domains;
+    }
+  }
+  if(doms)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:nNonEmpty)
+#endif
+    for(idP = 0; idP < grd->nPl; ++idP)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	  idL,
+		  ln1 = 0,
+		  lastln = -1,
+		  kol1 = 0,
+		  lastkl = 0;
+	size_t	  nItv = 0;
+	WlzDomain d2;
+	WlzStructRunRow *rows;
+	WlzInterval *itv = NULL;
+	WlzIntervalDomain *iDom = NULL;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	/* Find the bounding box and number of intervals of the plane. */
+	rows = grd->row + idP * grd->nLn;
+	for(idL = 0; idL < grd->nLn; ++idL)
+	{
+	  if(rows[idL].nItv > 0)
+	  {
+	    WlzInterval *rI;
+
+	    rI = rows[idL].itv;
+	    if(nItv == 0)
+	    {
+	      ln1 = idL;
+	      kol1 = rI[0].ileft;
+	      lastkl = rI[rows[idL].nItv - 1].iright;
+	    }
+	    else
+	    {
+	      kol1 = ALG_MIN(kol1, rI[0].ileft);
+	      lastkl = ALG_MAX(lastkl, rI[rows[idL].nItv - 1].iright);
+	    }
+	    lastln = idL;
+	    nItv += rows[idL].nItv;
+	  }
+	}
+	if(nItv > 0)
+	{
+	  if((iDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+	                                   grd->ln1 + ln1, grd->ln1 + lastln,
+					   kol1, lastkl, &errNum2)) != NULL)
+	  {
+	    if((itv = (WlzInterval *)
+	              AlcMalloc(sizeof(WlzInterval) * nItv)) == NULL)
+	    {
+	      errNum2 = WLZ_ERR_MEM_ALLOC;
+	      (void )WlzFreeIntervalDomain(iDom);
+	      iDom = NULL;
+	    }
+	    else
+	    {
+	      iDom->freeptr = AlcFreeStackPush(iDom->freeptr, (void *)itv,
+	                                       NULL);
+	    }
+	  }
+	  if(errNum2 == WLZ_ERR_NONE)
+	  {
+	    for(idL = ln1; idL <= lastln; ++idL)
+	    {
+	      int	idI,
+	      		n;
+
+	      n = rows[idL].nItv;
+	      for(idI = 0; idI < n; ++idI)
+	      {
+	        itv[idI].ileft = rows[idL].itv[idI].ileft - kol1;
+	        itv[idI].iright = rows[idL].itv[idI].iright - kol1;
+	      }
+	      (void )WlzMakeInterval(grd->ln1 + idL, iDom, n, itv);
+	      itv += n;
+	    }
+	    d2.i = iDom;
+	    doms[idP] = (obj->type == WLZ_2D_DOMAINOBJ)?
+	                d2: WlzAssignDomain(d2, NULL);
+	    ++nNonEmpty;
+	  }
+	}
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridToObj)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (rObj == NULL))
+  {
+    if(nNonEmpty == 0)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      rObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+    }
+    else
+    {
+      errNum = WlzStandardPlaneDomain(dom.p, NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        rObj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+      }
+    }
+  }
+  if((rObj == NULL) || (rObj->type == WLZ_EMPTY_OBJ))
+  {
+    if(obj->type == WLZ_2D_DOMAINOBJ)
+    {
+      if(dom.core)
+      {
+        (void )WlzFreeDomain(dom);
+      }
+    }
+    else if(dom.core)
+    {
+      (void )WlzFreePlaneDomain(dom.p);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes all the rows of the given grid in place
+* 		by a run along the lines. The dilated intervals are
+* 		merged where they overlap or are adjacent, while eroded
+* 		intervals are removed if they become empty.
+* \param	grd			Given row grid.
+* \param	kl0			First column offset of the run.
+* \param	kl1			Last column offset of the run.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+*/
+static void			WlzStructRunGridShiftX(
+				  WlzStructRunGrid *grd,
+				  int kl0,
+				  int kl1,
+				  int dilate)
+{
+  int		idR,
+  		nRow;
+
+  nRow = grd->nPl * grd->nLn;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(idR = 0; idR < nRow; ++idR)
+  {
+    int		idI,
+    		nI = 0;
+    WlzStructRunRow *row;
+
+    row = grd->row + idR;
+    for(idI = 0; idI < row->nItv; ++idI)
+    {
+      int	lft,
+      		rgt;
+
+      if(dilate)
+      {
+	lft = row->itv[idI].ileft + kl0;
+	rgt = row->itv[idI].iright + kl1;
+	if((nI > 0) && (lft <= row->itv[nI - 1].iright + 1))
+	{
+	  row->itv[nI - 1].iright = rgt;
+	}
+	else
+	{
+	  row->itv[nI].ileft = lft;
+	  row->itv[nI].iright = rgt;
+	  ++nI;
+	}
+      }
+      else
+      {
+	lft = row->itv[idI].ileft - kl0;
+	rgt = row->itv[idI].iright - kl1;
+	if(lft <= rgt)
+	{
+	  row->itv[nI].ileft = lft;
+	  row->itv[nI].iright = rgt;
+	  ++nI;
+	}
+      }
+    }
+    row->nItv = nI;
+    if(nI == 0)
+    {
+      AlcFree(row->itv);
+      row->itv = NULL;
+    }
+  }
+  if(dilate)
+  {
+    grd->kol1 += kl0;
+    grd->lastkl += kl1;
+  }
+  else
+  {
+    grd->kol1 -= kl0;
+    grd->lastkl -= kl1;
+  }
+}
+
+/*!
+* \return	Number of intervals in the union.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the union of two ordered sets of disjoint, non
+* 		adjacent intervals, merging overlapping and adjacent
+* 		intervals.
+* \param	a			First set of intervals.
+* \param	nA			Number of intervals in the first set.
+* \param	b			Second set of intervals.
+* \param	nB			Number of intervals in the second set.
+* \param	c			Destination for the union which must
+* 					have room for nA + nB intervals.
+*/
+static int			WlzStructRunsItvUnion(
+				  WlzInterval *a,
+				  int nA,
+				  WlzInterval *b,
+				  int nB,
+				  WlzInterval *c)
+{
+  int		iA = 0,
+  		iB = 0,
+		nC = 0;
+
+  while((iA < nA) || (iB < nB))
+  {
+    WlzInterval	*t;
+
+    if((iB >= nB) || ((iA < nA) && (a[iA].ileft <= b[iB].ileft)))
+    {
+      t = a + iA++;
+    }
+    else
+    {
+      t = b + iB++;
+    }
+    if((nC > 0) && (t->ileft <= c[nC - 1].iright + 1))
+    {
+      if(t->iright > c[nC - 1].iright)
+      {
+        c[nC - 1].iright = t->iright;
+      }
+    }
+    else
+    {
+      c[nC++] = *t;
+    }
+  }
+  return(nC);
+}
+
+/*!
+* \return	Number of intervals in the intersection.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the intersection of two ordered sets of disjoint,
+* 		non adjacent intervals.
+* \param	a			First set of intervals.
+* \param	nA			Number of intervals in the first set.
+* \param	b			Second set of intervals.
+* \param	nB			Number of intervals in the second set.
+* \param	c			Destination for the intersection which
+* 					must have room for nA + nB intervals.
+*/
+static int			WlzStructRunsItvIntersect(
+				  WlzInterval *a,
+				  int nA,
+				  WlzInterval *b,
+				  int nB,
+				  WlzInterval *c)
+{
+  int		iA = 0,
+  		iB = 0,
+		nC = 0;
+
+  while((iA < nA) && (iB < nB))
+  {
+    int		lft,
+    		rgt;
+
+    lft = ALG_MAX(a[iA].ileft, b[iB].ileft);
+    rgt = ALG_MIN(a[iA].iright, b[iB].iright);
+    if(lft <= rgt)
+    {
+      c[nC].ileft = lft;
+      c[nC].iright = rgt;
+      ++nC;
+    }
+    if(a[iA].iright < b[iB].iright)
+    {
+      ++iA;
+    }
+    else
+    {
+      ++iB;
+    }
+  }
+  return(nC);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the destination row to the union (for dilation) or
+* 		intersection (for erosion) of two rows, either of which
+* 		may be NULL for an empty row. The destination row's
+* 		intervals are allocated.
+* \param	a			First row, may be NULL.
+* \param	b			Second row, may be NULL.
+* \param	dilate			Union if non-zero, otherwise
+* 					intersection.
+* \param	c			Destination row.
+*/
+static WlzErrorNum		WlzStructRunRowOp(
+				  WlzStructRunRow *a,
+				  WlzStructRunRow *b,
+				  int dilate,
+				  WlzStructRunRow *c)
+{
+  int		nA,
+  		nB;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  c->nItv = 0;
+  c->itv = NULL;
+  nA = (a)? a->nItv: 0;
+  nB = (b)? b->nItv: 0;
+  if((dilate && (nA + nB > 0)) || (!dilate && (nA > 0) && (nB > 0)))
+  {
+    if((c->itv = (WlzInterval *)
+                 AlcMalloc(sizeof(WlzInterval) * (nA + nB))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      c->nItv = (dilate)?
+                WlzStructRunsItvUnion((a)? a->itv: NULL, nA,
+		                      (b)? b->itv: NULL, nB, c->itv):
+                WlzStructRunsItvIntersect(a->itv, nA, b->itv, nB, c->itv);
+      if(c->nItv == 0)
+      {
+        AlcFree(c->itv);
+	c->itv = NULL;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given row grid by a run through the
+* 		lines or through the planes, using the van Herk/Gil-Werman
+* 		algorithm with row union (for dilation) or intersection
+* 		(for erosion) as the operator. Each output row is found
+* 		from a suffix and a prefix within blocks of the run length
+* 		so that the number of row operations is independent of
+* 		the run length. The columns of rows (the planes when
+* 		operating through the lines and the lines when operating
+* 		through the planes) are processed in parallel.
+* \param	gIn			Given row grid.
+* \param	alongPl			Operate through the planes if
+* 					non-zero, otherwise through the
+* 					lines.
+* \param	o0			First offset of the run.
+* \param	o1			Last offset of the run.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridVHG(
+				  WlzStructRunGrid *gIn,
+				  int alongPl,
+				  int o0,
+				  int o1,
+				  int dilate,
+				  WlzErrorNum *dstErr)
+{
+  int		n,
+  		w,
+		nOut,
+		nCol,
+		off,
+		idC;
+  WlzStructRunGrid *gOut = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  n = (alongPl)? gIn->nPl: gIn->nLn;
+  nCol = (alongPl)? gIn->nLn: gIn->nPl;
+  w = o1 - o0 + 1;
+  nOut = (dilate)? n + w - 1: n - w + 1;
+  off = (dilate)? -(w - 1): 0;
+  if(alongPl)
+  {
+    gOut = WlzStructRunGridMake((dilate)? gIn->pl1 + o0: gIn->pl1 - o0, nOut,
+                                gIn->ln1, gIn->nLn, &errNum);
+  }
+  else
+  {
+    gOut = WlzStructRunGridMake(gIn->pl1, gIn->nPl,
+                                (dilate)? gIn->ln1 + o0: gIn->ln1 - o0, nOut,
+                                &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (nOut > 0) && (nCol > 0))
+  {
+    gOut->kol1 = gIn->kol1;
+    gOut->lastkl = gIn->lastkl;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	nPad;
+      WlzStructRunRow *g = NULL,
+      		*h = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      nPad = nOut + w - 1;
+      if(((g = (WlzStructRunRow *)
+               AlcCalloc(nPad, sizeof(WlzStructRunRow))) == NULL) ||
+         ((h = (WlzStructRunRow *)
+	       AlcCalloc(nPad, sizeof(WlzStructRunRow))) == NULL))
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(idC = 0; idC < nCol; ++idC)
+      {
+	int	  idT,
+		  idO;
+
+	if((errNum2 != WLZ_ERR_NONE) || (errNum != WLZ_ERR_NONE))
+	{
+	  continue;
+	}
+	/* Prefixes and suffixes within the blocks. */
+	for(idT = 0; (errNum2 == WLZ_ERR_NONE) && (idT < nPad); ++idT)
+	{
+	  int	  idS;
+	  WlzStructRunRow *s = NULL;
+
+	  idS = idT + off;
+	  if((idS >= 0) && (idS < n))
+	  {
+	    s = (alongPl)? gIn->row + (idS * gIn->nLn) + idC:
+	                   gIn->row + (idC * gIn->nLn) + idS;
+	  }
+	  if((idT % w) == 0)
+	  {
+	    errNum2 = WlzStructRunRowOp(NULL, s, 1, g + idT);
+	  }
+	  else
+	  {
+	    errNum2 = WlzStructRunRowOp(g + idT - 1, s, dilate, g + idT);
+	  }
+	}
+	for(idT = nPad - 1; (errNum2 == WLZ_ERR_NONE) && (idT >= 0); --idT)
+	{
+	  int	  idS,
+		  last;
+	  WlzStructRunRow *s = NULL;
+
+	  idS = idT + off;
+	  if((idS >= 0) && (idS < n))
+	  {
+	    s = (alongPl)? gIn->row + (idS * gIn->nLn) + idC:
+	                   gIn->row + (idC * gIn->nLn) + idS;
+	  }
+	  last = ((idT % w) == (w - 1)) || (idT == nPad - 1);
+	  if(last)
+	  {
+	    errNum2 = WlzStructRunRowOp(NULL, s, 1, h + idT);
+	  }
+	  else
+	  {
+	    errNum2 = WlzStructRunRowOp(h + idT + 1, s, dilate, h + idT);
+	  }
+	}
+	/* Each output is the operator applied to a suffix and a prefix. */
+	for(idO = 0; (errNum2 == WLZ_ERR_NONE) && (idO < nOut); ++idO)
+	{
+	  WlzStructRunRow *o;
+
+	  o = (alongPl)? gOut->row + (idO * gOut->nLn) + idC:
+	                 gOut->row + (idC * gOut->nLn) + idO;
+	  errNum2 = WlzStructRunRowOp(h + idO, g + idO + w - 1, dilate, o);
+	}
+	for(idT = 0; idT < nPad; ++idT)
+	{
+	  AlcFree(g[idT].itv);
+	  AlcFree(h[idT].itv);
+	  g[idT].itv = h[idT].itv = NULL;
+	  g[idT].nItv = h[idT].nItv = 0;
+	}
+      }
+      AlcFree(g);
+      AlcFree(h);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridVHG)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzStructRunGridFree(gOut);
+    gOut = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gOut);
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given row grid by the runs of the
+* 		given run set. For each output row the intervals of the
+* 		corresponding input row of every run are dilated (or
+* 		eroded) by the run and accumulated in a difference array
+* 		along the output row. Dilated positions are those with a
+* 		non-zero count and eroded positions are those with a
+* 		count equal to the number of runs. The output rows are
+* 		computed in parallel.
+* \param	gIn			Given row grid.
+* \param	rSet			Run set.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridRuns(
+				  WlzStructRunGrid *gIn,
+				  WlzStructRunSet *rSet,
+				  int dilate,
+				  WlzErrorNum *dstErr)
+{
+  int		idR,
+  		nRow,
+		kol1,
+  		lastkl;
+  WlzStructRunGrid *gOut = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(dilate)
+  {
+    kol1 = gIn->kol1 + rSet->bBox.xMin;
+    lastkl = gIn->lastkl + rSet->bBox.xMax;
+    gOut = WlzStructRunGridMake(gIn->pl1 + rSet->bBox.zMin,
+    			gIn->nPl + rSet->bBox.zMax - rSet->bBox.zMin,
+			gIn->ln1 + rSet->bBox.yMin,
+			gIn->nLn + rSet->bBox.yMax - rSet->bBox.yMin,
+			&errNum);
+  }
+  else
+  {
+    kol1 = gIn->kol1 - rSet->bBox.xMin;
+    lastkl = gIn->lastkl - rSet->bBox.xMax;
+    gOut = WlzStructRunGridMake(gIn->pl1 - rSet->bBox.zMin,
+    			gIn->nPl - rSet->bBox.zMax + rSet->bBox.zMin,
+			gIn->ln1 - rSet->bBox.yMin,
+			gIn->nLn - rSet->bBox.yMax + rSet->bBox.yMin,
+			&errNum);
+  }
+  nRow = (gOut)? gOut->nPl * gOut->nLn: 0;
+  if((errNum == WLZ_ERR_NONE) && (nRow > 0) && (kol1 <= lastkl))
+  {
+    gOut->kol1 = kol1;
+    gOut->lastkl = lastkl;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	wid;
+      int	*cnt = NULL;
+      WlzInterval *buf = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      wid = lastkl - kol1 + 1;
+      if(((cnt = (int *)AlcCalloc(wid + 1, sizeof(int))) == NULL) ||
+         ((buf = (WlzInterval *)
+	         AlcMalloc(sizeof(WlzInterval) * (wid / 2 + 1))) == NULL))
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idR = 0; idR < nRow; ++idR)
+      {
+	int	  idS,
+		  pl,
+		  ln,
+		  lo,
+		  hi,
+		  full = 1;
+
+	if((errNum2 != WLZ_ERR_NONE) || (errNum != WLZ_ERR_NONE))
+	{
+	  continue;
+	}
+	pl = gOut->pl1 + idR / gOut->nLn;
+	ln = gOut->ln1 + idR % gOut->nLn;
+	lo = wid;
+	hi = -1;
+	for(idS = 0; full && (idS < rSet->nRun); ++idS)
+	{
+	  int	  idI,
+		  sPl,
+		  sLn;
+	  WlzStructRun *run;
+	  WlzStructRunRow *row = NULL;
+
+	  run = rSet->run + idS;
+	  sPl = (dilate)? pl - run->pl: pl + run->pl;
+	  sLn = (dilate)? ln - run->ln: ln + run->ln;
+	  if((sPl >= gIn->pl1) && (sPl < gIn->pl1 + gIn->nPl) &&
+	     (sLn >= gIn->ln1) && (sLn < gIn->ln1 + gIn->nLn))
+	  {
+	    row = gIn->row + ((sPl - gIn->pl1) * gIn->nLn) + sLn - gIn->ln1;
+	  }
+	  if((row == NULL) || (row->nItv == 0))
+	  {
+	    /* For erosion every run must have an input row. */
+	    full = dilate;
+	    continue;
+	  }
+	  for(idI = 0; idI < row->nItv; ++idI)
+	  {
+	    int	  lft,
+		  rgt;
+
+	    if(dilate)
+	    {
+	      lft = row->itv[idI].ileft + run->kl0 - kol1;
+	      rgt = row->itv[idI].iright + run->kl1 - kol1;
+	    }
+	    else
+	    {
+	      lft = ALG_MAX(row->itv[idI].ileft - run->kl0 - kol1, 0);
+	      rgt = ALG_MIN(row->itv[idI].iright - run->kl1 - kol1, wid - 1);
+	    }
+	    if(lft <= rgt)
+	    {
+	      ++cnt[lft];
+	      --cnt[rgt + 1];
+	      lo = ALG_MIN(lo, lft);
+	      hi = ALG_MAX(hi, rgt + 1);
+	    }
+	  }
+	}
+	if(hi >= 0)
+	{
+	  int	  idK,
+		  c = 0,
+		  nI = 0,
+		  in = 0,
+		  req;
+
+	  req = (dilate)? 1: rSet->nRun;
+	  for(idK = lo; idK <= hi; ++idK)
+	  {
+	    c += cnt[idK];
+	    cnt[idK] = 0;
+	    if(full && (c >= req))
+	    {
+	      if(!in)
+	      {
+	        in = 1;
+		buf[nI].ileft = kol1 + idK;
+	      }
+	    }
+	    else if(in)
+	    {
+	      in = 0;
+	      buf[nI++].iright = kol1 + idK - 1;
+	    }
+	  }
+	  if(nI > 0)
+	  {
+	    WlzStructRunRow *o;
+
+	    o = gOut->row + idR;
+	    if((o->itv = (WlzInterval *)
+	                 AlcMalloc(sizeof(WlzInterval) * nI)) == NULL)
+	    {
+	      errNum2 = WLZ_ERR_MEM_ALLOC;
+	    }
+	    else
+	    {
+	      o->nItv = nI;
+	      (void )memcpy(o->itv, buf, sizeof(WlzInterval) * nI);
+	    }
+	  }
+	}
+      }
+      AlcFree(cnt);
+      AlcFree(buf);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridRuns)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  else if(gOut)
+  {
+    /* Erosion has removed all the columns. */
+    gOut->nPl = 0;
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzStructRunGridFree(gOut);
+    gOut = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gOut);
+}
+
+/*!
+* \return	Residual run set or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the largest digital Euclidean ball, ie the set of
+* 		positions \f$v\f$ with \f$|v|^2 \leq \rho\f$, which is
+* 		centred on the origin and lies within the given row
+* 		convex run set, together with the residual runs of the
+* 		run set which are not covered by the ball. The ball is
+* 		3D if the run set has runs off the zero plane and is
+* 		otherwise 2D. Discs and spheres are covered by such a
+* 		ball except for a few residual runs at their boundary.
+* 		If the origin is not within the run set then the
+* 		squared radius is negative and all the runs are
+* 		residual.
+* \param	rSet			Given row convex run set.
+* \param	dstRho			Destination pointer for the squared
+* 					radius of the ball.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunSet		*WlzStructRunSetBall(
+				  WlzStructRunSet *rSet,
+				  int *dstRho,
+				  WlzErrorNum *dstErr)
+{
+  int		idR,
+		rho = -1;
+  WlzIBox3	*b;
+  WlzStructRunSet *eSet = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  b = &(rSet->bBox);
+  for(idR = 0; idR < rSet->nRun; ++idR)
+  {
+    WlzStructRun *run;
+
+    run = rSet->run + idR;
+    if((run->pl == 0) && (run->ln == 0) && (run->kl0 <= 0) && (run->kl1 >= 0))
+    {
+      break;
+    }
+  }
+  if(idR < rSet->nRun)
+  {
+    int		pl,
+    		ln,
+		pl0,
+		lastpl,
+		nLn,
+		best = INT_MAX;
+    int		*tbl = NULL;
+
+    /* Find the nearest position to the origin which is not in the run
+     * set, searching the lines of the bounding box grown by a line
+     * (and a plane for a 3D ball) using a table of the run on each
+     * line. */
+    pl0 = ((b->zMin == 0) && (b->zMax == 0))? 0: b->zMin - 1;
+    lastpl = ((b->zMin == 0) && (b->zMax == 0))? 0: b->zMax + 1;
+    nLn = b->yMax - b->yMin + 3;
+    if((tbl = (int *)AlcMalloc(sizeof(int) *
+                               (lastpl - pl0 + 1) * nLn)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idR = 0; idR < (lastpl - pl0 + 1) * nLn; ++idR)
+      {
+        tbl[idR] = -1;
+      }
+      for(idR = 0; idR < rSet->nRun; ++idR)
+      {
+        WlzStructRun *run;
+
+	run = rSet->run + idR;
+	tbl[((run->pl - pl0) * nLn) + run->ln - b->yMin + 1] = idR;
+      }
+      for(pl = pl0; pl <= lastpl; ++pl)
+      {
+        for(ln = b->yMin - 1; ln <= b->yMax + 1; ++ln)
+	{
+	  int	  d2,
+	  	  t;
+
+	  d2 = (pl * pl) + (ln * ln);
+	  if((t = tbl[((pl - pl0) * nLn) + ln - b->yMin + 1]) >= 0)
+	  {
+	    WlzStructRun *run;
+
+	    run = rSet->run + t;
+	    if((run->kl0 <= 0) && (run->kl1 >= 0))
+	    {
+	      d2 += ALG_MIN((run->kl0 - 1) * (run->kl0 - 1),
+	                    (run->kl1 + 1) * (run->kl1 + 1));
+	    }
+	  }
+	  best = ALG_MIN(best, d2);
+	}
+      }
+      rho = best - 1;
+      AlcFree(tbl);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((eSet = (WlzStructRunSet *)
+                AlcCalloc(1, sizeof(WlzStructRunSet))) == NULL) ||
+       ((eSet->run = (WlzStructRun *)
+                     AlcMalloc(sizeof(WlzStructRun) *
+		               2 * rSet->nRun)) == NULL))
+    {
+      AlcFree(eSet);
+      eSet = NULL;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Each run may leave a residual run either side of the ball. */
+    eSet->rowConvex = 0;
+    for(idR = 0; idR < rSet->nRun; ++idR)
+    {
+      int	q,
+      		w;
+      WlzStructRun *run,
+      		*eRun;
+
+      run = rSet->run + idR;
+      eRun = eSet->run + eSet->nRun;
+      q = rho - (run->pl * run->pl) - (run->ln * run->ln);
+      if(q < 0)
+      {
+        *eRun = *run;
+	++(eSet->nRun);
+      }
+      else
+      {
+        w = WlzStructRunsISqrt(q);
+	if(run->kl0 < -w)
+	{
+	  *eRun = *run;
+	  eRun->kl1 = -w - 1;
+	  ++eRun;
+	  ++(eSet->nRun);
+	}
+	if(run->kl1 > w)
+	{
+	  *eRun = *run;
+	  eRun->kl0 = w + 1;
+	  ++(eSet->nRun);
+	}
+      }
+    }
+    WlzStructRunSetBound(eSet);
+  }
+  *dstRho = rho;
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(eSet);
+}
+
+/*!
+* \return	Integer square root.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the largest integer with a square which is not
+* 		greater than the given non-negative integer.
+* \param	q			Given integer.
+*/
+static int			WlzStructRunsISqrt(
+				  int q)
+{
+  int		w;
+
+  w = (int )sqrt((double )q);
+  while(w * w > q)
+  {
+    --w;
+  }
+  while((w + 1) * (w + 1) <= q)
+  {
+    ++w;
+  }
+  return(w);
+}
+
+/*!
+* \return	Non-zero if the ball should be used.
+* \ingroup	WlzMorphologyOps
+* \brief	Decides whether a structuring element should be applied
+* 		as a Euclidean ball (using a distance transform) together
+* 		with it's residual runs rather than run by run. The
+* 		distance transform costs a few passes over a buffer
+* 		which, for dilation, is wider than the domain by the
+* 		ball's diameter, whereas each run covered by the ball
+* 		costs an interval operation per output line. Only 3D
+* 		balls are used, as for 2D elements the run by run
+* 		application is always faster.
+* \param	rSet			Runs of the structuring element.
+* \param	eSet			Residual runs not covered by the ball.
+* \param	rho			Squared radius of the ball, negative if
+* 					there is no ball.
+* \param	width			Width of the domain in columns.
+* \param	dilate			Non-zero for dilation.
+*/
+static int			WlzStructRunsBallCheaper(
+				  WlzStructRunSet *rSet,
+				  WlzStructRunSet *eSet,
+				  int rho,
+				  int width,
+				  int dilate)
+{
+  int		use = 0;
+
+  if((rho > 0) && (rSet->bBox.zMin < 0) && (rSet->bBox.zMax > 0))
+  {
+    if(dilate)
+    {
+      width += 2 * WlzStructRunsISqrt(rho);
+    }
+    use = rSet->nRun - eSet->nRun > WLZ_STRUCTRUNS_BALL_GAIN * width;
+  }
+  return(use);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared Euclidean distance
+* 		transform of a sampled function, ie for each position
+* 		p, \f$d(p) = \min_q (f(q) + (p - q)^2)\f$ using the lower
+* 		envelope of the parabolas rooted at the sample positions.
+* 		Samples with values not less than the given limit are
+* 		ignored and distances not less than the limit are set
+* 		to the limit.
+* \param	f			Given samples at positions
+* 					\f$0, \ldots, n - 1\f$.
+* \param	n			Number of samples.
+* \param	lim			Limit value.
+* \param	d			Destination for the n distances.
+* \param	v			Workspace for n ints.
+* \param	z			Workspace for n + 1 doubles.
+*/
+static void			WlzStructRunsEDT1D(
+				  int *f,
+				  int n,
+				  int lim,
+				  int *d,
+				  int *v,
+				  double *z)
+{
+  int		k = -1,
+		q;
+  double	s = 0.0;
+
+  /* Compute the lower envelope. */
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] < lim)
+    {
+      if(k < 0)
+      {
+	k = 0;
+	z[0] = -DBL_MAX;
+      }
+      else
+      {
+	for(;;)
+	{
+	  int	vk;
+
+	  vk = v[k];
+	  s = ((f[q] + ((double )q * q)) - (f[vk] + ((double )vk * vk))) /
+	      (2.0 * (q - vk));
+	  if(s > z[k])
+	  {
+	    break;
+	  }
+	  --k;
+	}
+	z[++k] = s;
+      }
+      v[k] = q;
+      z[k + 1] = DBL_MAX;
+    }
+  }
+  /* Fill in the distances from the lower envelope. */
+  if(k < 0)
+  {
+    for(q = 0; q < n; ++q)
+    {
+      d[q] = lim;
+    }
+  }
+  else
+  {
+    k = 0;
+    for(q = 0; q < n; ++q)
+    {
+      double	dd;
+
+      while(z[k + 1] < q)
+      {
+	++k;
+      }
+      dd = (double )(q - v[k]);
+      dd = (dd * dd) + f[v[k]];
+      d[q] = (dd < lim)? (int )dd: lim;
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared Euclidean distance
+* 		transform through the given rows, ie along each column,
+* 		in place. The columns are gathered in blocks so that
+* 		each row is accessed contiguously and columns without
+* 		any values less than the limit are left unchanged.
+* \param	rows			Given rows.
+* \param	n			Number of rows.
+* \param	nX			Number of columns.
+* \param	lim			Limit value.
+* \param	f			Workspace for n x
+* 					WLZ_STRUCTRUNS_EDT_BLK ints.
+* \param	d			Workspace for n x
+* 					WLZ_STRUCTRUNS_EDT_BLK ints.
+* \param	v			Workspace for n ints.
+* \param	z			Workspace for n + 1 doubles.
+*/
+static void			WlzStructRunsEDTCols(
+				  int **rows,
+				  int n,
+				  int nX,
+				  int lim,
+				  int *f,
+				  int *d,
+				  int *v,
+				  double *z)
+{
+  int		idB,
+  		idN,
+		idX,
+		nB;
+  int		any[WLZ_STRUCTRUNS_EDT_BLK];
+
+  for(idX = 0; idX < nX; idX += WLZ_STRUCTRUNS_EDT_BLK)
+  {
+    nB = ALG_MIN(WLZ_STRUCTRUNS_EDT_BLK, nX - idX);
+    for(idB = 0; idB < nB; ++idB)
+    {
+      any[idB] = 0;
+    }
+    for(idN = 0; idN < n; ++idN)
+    {
+      int	*r;
+
+      r = rows[idN] + idX;
+      for(idB = 0; idB < nB; ++idB)
+      {
+        f[(idB * n) + idN] = r[idB];
+	any[idB] |= r[idB] < lim;
+      }
+    }
+    for(idB = 0; idB < nB; ++idB)
+    {
+      if(any[idB])
+      {
+        WlzStructRunsEDT1D(f + (idB * n), n, lim, d + (idB * n), v, z);
+      }
+    }
+    for(idN = 0; idN < n; ++idN)
+    {
+      int	*r;
+
+      r = rows[idN] + idX;
+      for(idB = 0; idB < nB; ++idB)
+      {
+        if(any[idB])
+	{
+	  r[idB] = d[(idB * n) + idN];
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Dilates or erodes the given row grid by the digital
+* 		Euclidean ball with the given squared radius, with the
+* 		cost of the operation independent of the radius.
+* 		Dilated positions are those with a squared distance to
+* 		the grid's domain which is not greater than the squared
+* 		radius, while eroded positions are those with a squared
+* 		distance to the complement of the domain which is
+* 		greater than the squared radius. The squared distances,
+* 		limited to the squared radius plus one, are computed
+* 		within a buffer which covers the output. First the
+* 		squared distances along each line are found directly
+* 		from the intervals and then these are transformed
+* 		through the columns (both of these in parallel over the
+* 		planes) and then (for a 3D ball) through the planes (in
+* 		parallel over the lines).
+* \param	gIn			Given row grid.
+* \param	ball3D			Non-zero for a 3D ball, otherwise
+* 					the ball is a 2D disc.
+* \param	rho			Squared radius of the ball, which
+* 					must not be negative.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridBall(
+				  WlzStructRunGrid *gIn,
+				  int ball3D,
+				  int rho,
+				  int dilate,
+				  WlzErrorNum *dstErr)
+{
+  int		idP,
+  		idR,
+		lim,
+		nRow,
+		wB,
+		wP;
+  WlzIBox3	bBox;
+  WlzIVertex3	bSz;
+  int		***sqd = NULL;
+  WlzStructRunGrid *gOut = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* The buffer covers the dilated domain or, for erosion, the domain
+   * and a border of the complement. */
+  lim = rho + 1;
+  wB = WlzStructRunsISqrt(rho);
+  wP = (dilate)? wB: 1;
+  bBox.xMin = gIn->kol1 - wP;
+  bBox.xMax = gIn->lastkl + wP;
+  bBox.yMin = gIn->ln1 - wP;
+  bBox.yMax = gIn->ln1 + gIn->nLn - 1 + wP;
+  bBox.zMin = gIn->pl1 - ((ball3D)? wP: 0);
+  bBox.zMax = gIn->pl1 + gIn->nPl - 1 + ((ball3D)? wP: 0);
+  bSz.vtX = bBox.xMax - bBox.xMin + 1;
+  bSz.vtY = bBox.yMax - bBox.yMin + 1;
+  bSz.vtZ = bBox.zMax - bBox.zMin + 1;
+  if(dilate)
+  {
+    gOut = WlzStructRunGridMake(bBox.zMin, bSz.vtZ, bBox.yMin, bSz.vtY,
+    				&errNum);
+  }
+  else
+  {
+    gOut = WlzStructRunGridMake(gIn->pl1, gIn->nPl, gIn->ln1, gIn->nLn,
+    				&errNum);
+  }
+  nRow = (gOut)? gOut->nPl * gOut->nLn: 0;
+  if((errNum != WLZ_ERR_NONE) || (nRow < 1) || (gIn->kol1 > gIn->lastkl))
+  {
+    if(gOut)
+    {
+      gOut->nPl = 0;
+    }
+  }
+  else
+  {
+    gOut->kol1 = (dilate)? bBox.xMin: gIn->kol1;
+    gOut->lastkl = (dilate)? bBox.xMax: gIn->lastkl;
+    if(AlcInt3Malloc(&sqd, bSz.vtZ, bSz.vtY, bSz.vtX) != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Squared distances along the lines and then through the columns
+   * for each plane. */
+  if(sqd)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	nBuf;
+      int	*f = NULL,
+		*d = NULL,
+		*v = NULL;
+      int	**col = NULL;
+      double	*z = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      nBuf = ALG_MAX(bSz.vtY, bSz.vtZ);
+      if(((f = (int *)AlcMalloc(sizeof(int) * nBuf *
+      				WLZ_STRUCTRUNS_EDT_BLK)) == NULL) ||
+	 ((d = (int *)AlcMalloc(sizeof(int) * nBuf *
+	 			WLZ_STRUCTRUNS_EDT_BLK)) == NULL) ||
+	 ((v = (int *)AlcMalloc(sizeof(int) * nBuf)) == NULL) ||
+	 ((z = (double *)AlcMalloc(sizeof(double) * (nBuf + 1))) == NULL) ||
+	 ((col = (int **)AlcMalloc(sizeof(int *) * nBuf)) == NULL))
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(idP = 0; idP < bSz.vtZ; ++idP)
+      {
+	int	  idX,
+		  idY,
+		  gPl,
+		  any = 0;
+	int	  **sqd2;
+
+	if((errNum2 != WLZ_ERR_NONE) || (errNum != WLZ_ERR_NONE))
+	{
+	  continue;
+	}
+	sqd2 = sqd[idP];
+	gPl = bBox.zMin + idP - gIn->pl1;
+	for(idY = 0; idY < bSz.vtY; ++idY)
+	{
+	  int	  idI = 0,
+		  gLn,
+		  nItv = 0;
+	  int	  *sqdP;
+	  WlzInterval *itv = NULL;
+
+	  gLn = bBox.yMin + idY - gIn->ln1;
+	  if((gPl >= 0) && (gPl < gIn->nPl) && (gLn >= 0) && (gLn < gIn->nLn))
+	  {
+	    WlzStructRunRow *row;
+
+	    row = gIn->row + (gPl * gIn->nLn) + gLn;
+	    nItv = row->nItv;
+	    itv = row->itv;
+	  }
+	  sqdP = sqd2[idY];
+	  for(idX = 0; idX < bSz.vtX; ++idX)
+	  {
+	    int	  kl,
+		  dst;
+
+	    kl = bBox.xMin + idX;
+	    while((idI < nItv) && (itv[idI].iright < kl))
+	    {
+	      ++idI;
+	    }
+	    if(dilate)
+	    {
+	      /* Distance to the nearest interval. */
+	      if((idI < nItv) && (itv[idI].ileft <= kl))
+	      {
+		dst = 0;
+	      }
+	      else
+	      {
+		dst = INT_MAX;
+		if(idI > 0)
+		{
+		  dst = kl - itv[idI - 1].iright;
+		}
+		if(idI < nItv)
+		{
+		  dst = ALG_MIN(dst, itv[idI].ileft - kl);
+		}
+	      }
+	    }
+	    else
+	    {
+	      /* Distance to the nearest column outside the intervals. */
+	      dst = 0;
+	      if((idI < nItv) && (itv[idI].ileft <= kl))
+	      {
+		dst = ALG_MIN(kl - itv[idI].ileft, itv[idI].iright - kl) + 1;
+	      }
+	    }
+	    sqdP[idX] = (dst <= wB)? dst * dst: lim;
+	    any |= sqdP[idX] < lim;
+	  }
+	}
+	if(any)
+	{
+	  WlzStructRunsEDTCols(sqd2, bSz.vtY, bSz.vtX, lim, f, d, v, z);
+	}
+      }
+      /* Squared distances through the planes for each line. */
+      if(ball3D)
+      {
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+	for(idR = 0; idR < bSz.vtY; ++idR)
+	{
+	  int	  idZ;
+
+	  if((errNum2 != WLZ_ERR_NONE) || (errNum != WLZ_ERR_NONE))
+	  {
+	    continue;
+	  }
+	  for(idZ = 0; idZ < bSz.vtZ; ++idZ)
+	  {
+	    col[idZ] = sqd[idZ][idR];
+	  }
+	  WlzStructRunsEDTCols(col, bSz.vtZ, bSz.vtX, lim, f, d, v, z);
+	}
+      }
+      AlcFree(f);
+      AlcFree(d);
+      AlcFree(v);
+      AlcFree(z);
+      AlcFree(col);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridBall)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  /* Threshold the squared distances to give the output rows. */
+  if(sqd && (errNum == WLZ_ERR_NONE))
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	wid;
+      WlzInterval *buf = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      wid = gOut->lastkl - gOut->kol1 + 1;
+      if((buf = (WlzInterval *)
+		AlcMalloc(sizeof(WlzInterval) * (wid / 2 + 1))) == NULL)
+      {
+	errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idR = 0; idR < nRow; ++idR)
+      {
+	int	  idK,
+		  nI = 0,
+		  in = 0;
+	int	  *sqdP;
+
+	if((errNum2 != WLZ_ERR_NONE) || (errNum != WLZ_ERR_NONE))
+	{
+	  continue;
+	}
+	sqdP = sqd[gOut->pl1 + (idR / gOut->nLn) - bBox.zMin]
+		  [gOut->ln1 + (idR % gOut->nLn) - bBox.yMin] +
+	       gOut->kol1 - bBox.xMin;
+	for(idK = 0; idK <= wid; ++idK)
+	{
+	  if((idK < wid) && ((dilate)? (sqdP[idK] <= rho): (sqdP[idK] > rho)))
+	  {
+	    if(!in)
+	    {
+	      in = 1;
+	      buf[nI].ileft = gOut->kol1 + idK;
+	    }
+	  }
+	  else if(in)
+	  {
+	    in = 0;
+	    buf[nI++].iright = gOut->kol1 + idK - 1;
+	  }
+	}
+	if(nI > 0)
+	{
+	  WlzStructRunRow *o;
+
+	  o = gOut->row + idR;
+	  if((o->itv = (WlzInterval *)
+		       AlcMalloc(sizeof(WlzInterval) * nI)) == NULL)
+	  {
+	    errNum2 = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    o->nItv = nI;
+	    (void )memcpy(o->itv, buf, sizeof(WlzInterval) * nI);
+	  }
+	}
+      }
+      AlcFree(buf);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridBall)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  (void )AlcInt3Free(sqd);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzStructRunGridFree(gOut);
+    gOut = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gOut);
+}
+
+/*!
+* \return	New row grid or NULL on error.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the union (for dilation) or intersection (for
+* 		erosion) of two row grids, with the rows computed in
+* 		parallel.
+* \param	gA			First row grid.
+* \param	gB			Second row grid.
+* \param	dilate			Union if non-zero, otherwise
+* 					intersection.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzStructRunGrid		*WlzStructRunGridCombine(
+				  WlzStructRunGrid *gA,
+				  WlzStructRunGrid *gB,
+				  int dilate,
+				  WlzErrorNum *dstErr)
+{
+  int		idR,
+  		nRow,
+		emA,
+		emB;
+  WlzIBox3	b;
+  WlzStructRunGrid *gOut = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  emA = (gA->nPl < 1) || (gA->nLn < 1);
+  emB = (gB->nPl < 1) || (gB->nLn < 1);
+  b.zMin = b.zMax = b.yMin = b.yMax = b.xMin = b.xMax = 0;
+  if(emA || emB)
+  {
+    if(dilate && !(emA && emB))
+    {
+      WlzStructRunGrid *g;
+
+      g = (emA)? gB: gA;
+      b.zMin = g->pl1;
+      b.zMax = g->pl1 + g->nPl - 1;
+      b.yMin = g->ln1;
+      b.yMax = g->ln1 + g->nLn - 1;
+      b.xMin = g->kol1;
+      b.xMax = g->lastkl;
+    }
+    else
+    {
+      b.zMax = -1;
+    }
+  }
+  else if(dilate)
+  {
+    b.zMin = ALG_MIN(gA->pl1, gB->pl1);
+    b.zMax = ALG_MAX(gA->pl1 + gA->nPl, gB->pl1 + gB->nPl) - 1;
+    b.yMin = ALG_MIN(gA->ln1, gB->ln1);
+    b.yMax = ALG_MAX(gA->ln1 + gA->nLn, gB->ln1 + gB->nLn) - 1;
+    b.xMin = ALG_MIN(gA->kol1, gB->kol1);
+    b.xMax = ALG_MAX(gA->lastkl, gB->lastkl);
+  }
+  else
+  {
+    b.zMin = ALG_MAX(gA->pl1, gB->pl1);
+    b.zMax = ALG_MIN(gA->pl1 + gA->nPl, gB->pl1 + gB->nPl) - 1;
+    b.yMin = ALG_MAX(gA->ln1, gB->ln1);
+    b.yMax = ALG_MIN(gA->ln1 + gA->nLn, gB->ln1 + gB->nLn) - 1;
+    b.xMin = ALG_MAX(gA->kol1, gB->kol1);
+    b.xMax = ALG_MIN(gA->lastkl, gB->lastkl);
+  }
+  gOut = WlzStructRunGridMake(b.zMin, b.zMax - b.zMin + 1,
+  			      b.yMin, b.yMax - b.yMin + 1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gOut->kol1 = b.xMin;
+    gOut->lastkl = b.xMax;
+    nRow = gOut->nPl * gOut->nLn;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for(idR = 0; idR < nRow; ++idR)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int	  pl,
+		  ln;
+	WlzStructRunRow *rA = NULL,
+			*rB = NULL;
+	WlzErrorNum errNum2;
+
+	pl = gOut->pl1 + idR / gOut->nLn;
+	ln = gOut->ln1 + idR % gOut->nLn;
+	if(!emA && (pl >= gA->pl1) && (pl < gA->pl1 + gA->nPl) &&
+	   (ln >= gA->ln1) && (ln < gA->ln1 + gA->nLn))
+	{
+	  rA = gA->row + ((pl - gA->pl1) * gA->nLn) + ln - gA->ln1;
+	}
+	if(!emB && (pl >= gB->pl1) && (pl < gB->pl1 + gB->nPl) &&
+	   (ln >= gB->ln1) && (ln < gB->ln1 + gB->nLn))
+	{
+	  rB = gB->row + ((pl - gB->pl1) * gB->nLn) + ln - gB->ln1;
+	}
+	errNum2 = WlzStructRunRowOp(rA, rB, dilate, gOut->row + idR);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunGridCombine)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    WlzStructRunGridFree(gOut);
+    gOut = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(gOut);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the maximum (for dilation) or minimum (for
+* 		erosion) of the given values within the window
+* 		\f$[i + a, i + b]\f$ for each \f$i \in [0, n - 1]\f$
+* 		using the van Herk/Gil-Werman algorithm. Positions
+* 		outside of \f$[0, n - 1]\f$ are ignored and windows with
+* 		no values give the neutral value (-DBL_MAX or DBL_MAX).
+* \param	src			Given values.
+* \param	n			Number of values.
+* \param	a			First offset of the window.
+* \param	b			Last offset of the window.
+* \param	dilate			Maximum if non-zero, otherwise
+* 					minimum.
+* \param	dst			Destination for the n filtered values.
+* \param	g			Workspace for 3n doubles.
+* \param	h			Workspace for 3n doubles.
+*/
+static void			WlzStructRunsVHG1D(
+				  double *src,
+				  int n,
+				  int a,
+				  int b,
+				  int dilate,
+				  double *dst,
+				  double *g,
+				  double *h)
+{
+  int		i,
+  		t,
+		w,
+		nPad;
+  double	nul;
+
+  nul = (dilate)? -DBL_MAX: DBL_MAX;
+  if((b < 1 - n) || (a > n - 1))
+  {
+    for(i = 0; i < n; ++i)
+    {
+      dst[i] = nul;
+    }
+  }
+  else
+  {
+    /* Clamp the window since values beyond the ends are ignored. */
+    a = ALG_MAX(a, 1 - n);
+    b = ALG_MIN(b, n - 1);
+    w = b - a + 1;
+    nPad = n + w - 1;
+    for(t = 0; t < nPad; ++t)
+    {
+      double	v;
+
+      i = t + a;
+      v = ((i >= 0) && (i < n))? src[i]: nul;
+      if((t % w) == 0)
+      {
+        g[t] = v;
+      }
+      else
+      {
+        g[t] = (dilate)? ALG_MAX(g[t - 1], v): ALG_MIN(g[t - 1], v);
+      }
+    }
+    for(t = nPad - 1; t >= 0; --t)
+    {
+      double	v;
+
+      i = t + a;
+      v = ((i >= 0) && (i < n))? src[i]: nul;
+      if(((t % w) == w - 1) || (t == nPad - 1))
+      {
+        h[t] = v;
+      }
+      else
+      {
+        h[t] = (dilate)? ALG_MAX(h[t + 1], v): ALG_MIN(h[t + 1], v);
+      }
+    }
+    for(i = 0; i < n; ++i)
+    {
+      dst[i] = (dilate)? ALG_MAX(h[i], g[i + w - 1]):
+                         ALG_MIN(h[i], g[i + w - 1]);
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Filters the values of the buffer in place using separable
+* 		van Herk/Gil-Werman maximum or minimum filters along the
+* 		columns, lines and planes for the box run set. Each pass
+* 		is computed in parallel.
+* \param	vol			Value buffer covering the bounding
+* 					box.
+* \param	bBox			Bounding box of the buffer.
+* \param	rSet			Box run set.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+*/
+static WlzErrorNum		WlzStructRunsGreyBox(
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  WlzStructRunSet *rSet,
+				  int dilate)
+{
+  int		pass;
+  WlzIVertex3	sz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sz.vtX = bBox.xMax - bBox.xMin + 1;
+  sz.vtY = bBox.yMax - bBox.yMin + 1;
+  sz.vtZ = bBox.zMax - bBox.zMin + 1;
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 3); ++pass)
+  {
+    int		n,
+    		a,
+		b,
+		nLine,
+		idL;
+
+    switch(pass)
+    {
+      case 0:
+        n = sz.vtX;
+	a = rSet->bBox.xMin;
+	b = rSet->bBox.xMax;
+	nLine = sz.vtY * sz.vtZ;
+	break;
+      case 1:
+        n = sz.vtY;
+	a = rSet->bBox.yMin;
+	b = rSet->bBox.yMax;
+	nLine = sz.vtX * sz.vtZ;
+	break;
+      default:
+        n = sz.vtZ;
+	a = rSet->bBox.zMin;
+	b = rSet->bBox.zMax;
+	nLine = sz.vtX * sz.vtY;
+	break;
+    }
+    if((a == 0) && (b == 0))
+    {
+      continue;
+    }
+    if(dilate)
+    {
+      int	t;
+
+      t = a;
+      a = -b;
+      b = -t;
+    }
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      double	*buf = NULL;
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      if((buf = (double *)AlcMalloc(sizeof(double) * 8 * n)) == NULL)
+      {
+        errNum2 = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idL = 0; idL < nLine; ++idL)
+      {
+	int	  i;
+	double	  *src,
+		  *dst;
+
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+	  continue;
+	}
+	src = buf;
+	dst = buf + n;
+	switch(pass)
+	{
+	  case 0:
+	    src = vol[idL / sz.vtY][idL % sz.vtY];
+	    WlzStructRunsVHG1D(src, n, a, b, dilate, dst, buf + 2 * n,
+			       buf + 5 * n);
+	    (void )memcpy(src, dst, sizeof(double) * n);
+	    break;
+	  case 1:
+	    for(i = 0; i < n; ++i)
+	    {
+	      src[i] = vol[idL / sz.vtX][i][idL % sz.vtX];
+	    }
+	    WlzStructRunsVHG1D(src, n, a, b, dilate, dst, buf + 2 * n,
+			       buf + 5 * n);
+	    for(i = 0; i < n; ++i)
+	    {
+	      vol[idL / sz.vtX][i][idL % sz.vtX] = dst[i];
+	    }
+	    break;
+	  default:
+	    for(i = 0; i < n; ++i)
+	    {
+	      src[i] = vol[i][idL / sz.vtX][idL % sz.vtX];
+	    }
+	    WlzStructRunsVHG1D(src, n, a, b, dilate, dst, buf + 2 * n,
+			       buf + 5 * n);
+	    for(i = 0; i < n; ++i)
+	    {
+	      vol[i][idL / sz.vtX][idL % sz.vtX] = dst[i];
+	    }
+	    break;
+	}
+      }
+      AlcFree(buf);
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunsGreyBox)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes a single plane of the grey level dilation or
+* 		erosion by a run set. Each output line is the maximum
+* 		(or minimum) over the runs of the van Herk/Gil-Werman
+* 		filtered input line of the run. The lines are computed
+* 		in parallel.
+* \param	vol			Value buffer covering the bounding
+* 					box.
+* \param	bBox			Bounding box of the buffer.
+* \param	rSet			Run set.
+* \param	dilate			Dilate if non-zero, otherwise erode.
+* \param	pl			Plane to compute.
+* \param	pln			Destination plane buffer.
+*/
+static WlzErrorNum		WlzStructRunsGreyPlane(
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  WlzStructRunSet *rSet,
+				  int dilate,
+				  int pl,
+				  double **pln)
+{
+  int		idL,
+  		nX,
+		nY;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nX = bBox.xMax - bBox.xMin + 1;
+  nY = bBox.yMax - bBox.yMin + 1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    double	*buf = NULL;
+    WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+    if((buf = (double *)AlcMalloc(sizeof(double) * 7 * nX)) == NULL)
+    {
+      errNum2 = WLZ_ERR_MEM_ALLOC;
+    }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(idL = 0; idL < nY; ++idL)
+    {
+      int	idS,
+      		idK;
+      double	*dst;
+
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+        continue;
+      }
+      dst = pln[idL];
+      for(idK = 0; idK < nX; ++idK)
+      {
+        dst[idK] = (dilate)? -DBL_MAX: DBL_MAX;
+      }
+      for(idS = 0; idS < rSet->nRun; ++idS)
+      {
+	int	  sPl,
+		  sLn;
+	WlzStructRun *run;
+
+	run = rSet->run + idS;
+	sPl = (dilate)? pl - run->pl: pl + run->pl;
+	sLn = (dilate)? bBox.yMin + idL - run->ln: bBox.yMin + idL + run->ln;
+	if((sPl >= bBox.zMin) && (sPl <= bBox.zMax) &&
+	   (sLn >= bBox.yMin) && (sLn <= bBox.yMax))
+	{
+	  double *tmp;
+
+	  tmp = buf;
+	  if(dilate)
+	  {
+	    WlzStructRunsVHG1D(vol[sPl - bBox.zMin][sLn - bBox.yMin], nX,
+			       -(run->kl1), -(run->kl0), 1, tmp,
+			       buf + nX, buf + 4 * nX);
+	    for(idK = 0; idK < nX; ++idK)
+	    {
+	      dst[idK] = ALG_MAX(dst[idK], tmp[idK]);
+	    }
+	  }
+	  else
+	  {
+	    WlzStructRunsVHG1D(vol[sPl - bBox.zMin][sLn - bBox.yMin], nX,
+			       run->kl0, run->kl1, 0, tmp,
+			       buf + nX, buf + 4 * nX);
+	    for(idK = 0; idK < nX; ++idK)
+	    {
+	      dst[idK] = ALG_MIN(dst[idK], tmp[idK]);
+	    }
+	  }
+	}
+      }
+    }
+    AlcFree(buf);
+    if(errNum2 != WLZ_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp critical (WlzStructRunsGreyPlane)
+#endif
+      {
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New 2D domain object or NULL if the plane is empty.
+* \ingroup	WlzMorphologyOps
+* \brief	Makes a 2D domain object which shares the domain and values
+* 		of the given plane of the given object. For a 2D object
+* 		it shares the domain and values of the given object
+* 		rather than assigning it, so that freeing it can not
+* 		free a given object which has not been assigned. Tiled
+* 		values are shared as a whole and must be scanned with
+* 		the plane position set in the interval workspace.
+* \param	gObj			Given 2D or 3D domain object.
+* \param	pl			Plane.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject		*WlzStructRunsPlaneObj(
+				  WlzObject *gObj,
+				  int pl,
+				  WlzErrorNum *dstErr)
+{
+  WlzObject	*obj2D = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, gObj->domain, gObj->values,
+    			NULL, NULL, &errNum);
+  }
+  else
+  {
+    int		idx;
+    WlzDomain	dom2D;
+    WlzValues	val2D;
+
+    idx = pl - gObj->domain.p->plane1;
+    dom2D = gObj->domain.p->domains[idx];
+    if(WlzGreyTableIsTiled(gObj->values.core->type))
+    {
+      val2D = gObj->values;
+    }
+    else
+    {
+      val2D = gObj->values.vox->values[idx];
+    }
+    if((dom2D.core != NULL) && (dom2D.core->type != WLZ_EMPTY_DOMAIN) &&
+       (val2D.core != NULL))
+    {
+      obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2D, val2D, NULL, NULL,
+                          &errNum);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj2D);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Either reads the values of a plane of the given object
+* 		into the value buffer or sets the values of a plane of
+* 		the given object from a plane buffer. When setting values
+* 		any neutral value (-DBL_MAX or DBL_MAX) is replaced by the
+* 		background value.
+* \param	gObj			Given object.
+* \param	vol			Value buffer covering the bounding
+* 					box.
+* \param	bBox			Bounding box of the buffer.
+* \param	pl			Plane.
+* \param	pln			Plane buffer, only used when setting
+* 					values.
+* \param	bgd			Background value.
+* \param	set			Set the object's values if non-zero,
+* 					otherwise read them.
+*/
+static WlzErrorNum		WlzStructRunsGreyIO(
+				  WlzObject *gObj,
+				  double ***vol,
+				  WlzIBox3 bBox,
+				  int pl,
+				  double **pln,
+				  double bgd,
+				  int set)
+{
+  WlzObject	*obj2D;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj2D = WlzStructRunsPlaneObj(gObj, pl, &errNum);
+  if(obj2D)
+  {
+    WlzGreyWSpace gWSp;
+    WlzIntervalWSpace iWSp;
+
+    errNum = WlzInitGreyScan(obj2D, &iWSp, &gWSp);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      iWSp.plnpos = pl;
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	int	i,
+		len;
+	double	*p;
+	WlzGreyP gP;
+
+	gP = gWSp.u_grintptr;
+	len = iWSp.rgtpos - iWSp.lftpos + 1;
+	p = (set)? pln[iWSp.linpos - bBox.yMin]:
+	           vol[pl - bBox.zMin][iWSp.linpos - bBox.yMin];
+	p += iWSp.lftpos - bBox.xMin;
+	if(set)
+	{
+	  for(i = 0; i < len; ++i)
+	  {
+	    double v;
+
+	    v = ((p[i] == DBL_MAX) || (p[i] == -DBL_MAX))? bgd: p[i];
+	    switch(gWSp.pixeltype)
+	    {
+	      case WLZ_GREY_UBYTE:
+		gP.ubp[i] = (WlzUByte )v;
+		break;
+	      case WLZ_GREY_SHORT:
+		gP.shp[i] = (short )v;
+		break;
+	      case WLZ_GREY_INT:
+		gP.inp[i] = (int )v;
+		break;
+	      case WLZ_GREY_FLOAT:
+		gP.flp[i] = (float )v;
+		break;
+	      case WLZ_GREY_DOUBLE:
+		gP.dbp[i] = v;
+		break;
+	      default:
+		break;
+	    }
+	  }
+	}
+	else
+	{
+	  switch(gWSp.pixeltype)
+	  {
+	    case WLZ_GREY_UBYTE:
+	      for(i = 0; i < len; ++i)
+	      {
+		p[i] = gP.ubp[i];
+	      }
+	      break;
+	    case WLZ_GREY_SHORT:
+	      for(i = 0; i < len; ++i)
+	      {
+		p[i] = gP.shp[i];
+	      }
+	      break;
+	    case WLZ_GREY_INT:
+	      for(i = 0; i < len; ++i)
+	      {
+		p[i] = gP.inp[i];
+	      }
+	      break;
+	    case WLZ_GREY_FLOAT:
+	      for(i = 0; i < len; ++i)
+	      {
+		p[i] = gP.flp[i];
+	      }
+	      break;
+	    case WLZ_GREY_DOUBLE:
+	      (void )memcpy(p, gP.dbp, sizeof(double) * len);
+	      break;
+	    default:
+	      break;
+	  }
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+        errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+    }
+    (void )WlzFreeObj(obj2D);
+  }
+  return(errNum);
+}
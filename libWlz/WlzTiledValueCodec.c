@@ -0,0 +1,359 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTiledValueCodec_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzTiledValueCodec.c
+* \author       Bill Hill
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2012],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Codecs for compressing the tiles of tiled value tables.
+* \ingroup	WlzValuesUtils
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+static size_t			WlzTiledValueRLEEncode(
+				  WlzUByte *dst,
+				  size_t maxSz,
+				  WlzUByte *src,
+				  size_t nBytes);
+static WlzErrorNum		WlzTiledValueRLEDecode(
+				  WlzUByte *dst,
+				  size_t nBytes,
+				  WlzUByte *src,
+				  size_t srcSz);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Compresses a single tile of a tiled value table using the
+* 		given codec. If the compressed tile would not be smaller
+* 		than the tile then the tile is copied uncompressed and
+* 		the compressed size is set to the tile size, which
+* 		WlzTiledValueTileDecode() recognises.
+* \param	codec			Given codec.
+* \param	gSz			Size of the grey values in bytes.
+* \param	nBytes			Number of bytes in the tile.
+* \param	src			The tile's values.
+* \param	dst			Destination buffer for the compressed
+* 					tile which must have space for at
+* 					least nBytes bytes.
+* \param	dstSz			Destination pointer for the size
+* 					of the compressed tile.
+*/
+WlzErrorNum	WlzTiledValueTileEncode(WlzTiledValueCodec codec,
+				        size_t gSz, size_t nBytes,
+					void *src, void *dst, size_t *dstSz)
+{
+  size_t	sz = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((src == NULL) || (dst == NULL) || (dstSz == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((gSz < 1) || ((nBytes % gSz) != 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(codec)
+    {
+      case WLZ_TILED_CODEC_NONE:
+        break;
+      case WLZ_TILED_CODEC_DRLE:
+	{
+	  size_t	idP,
+			idN,
+			nVal;
+	  WlzUByte	*buf,
+			*sP;
+
+	  /* Split the values into byte planes, each of which is delta
+	   * encoded, then run length encode all the planes. */
+	  if((buf = (WlzUByte *)AlcMalloc(nBytes)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    nVal = nBytes / gSz;
+	    for(idP = 0; idP < gSz; ++idP)
+	    {
+	      WlzUByte	prv = 0;
+	      WlzUByte	*dP;
+
+	      sP = (WlzUByte *)src + idP;
+	      dP = buf + (idP * nVal);
+	      for(idN = 0; idN < nVal; ++idN)
+	      {
+		*dP++ = *sP - prv;
+		prv = *sP;
+		sP += gSz;
+	      }
+	    }
+	    sz = WlzTiledValueRLEEncode((WlzUByte *)dst, nBytes - 1,
+	                                buf, nBytes);
+	    AlcFree(buf);
+	  }
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_PARAM_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(sz == 0)
+    {
+      (void )memcpy(dst, src, nBytes);
+      sz = nBytes;
+    }
+    *dstSz = sz;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Decompresses a single tile of a tiled value table which
+* 		was compressed using WlzTiledValueTileEncode().
+* \param	codec			Codec used to compress the tile.
+* \param	gSz			Size of the grey values in bytes.
+* \param	nBytes			Number of bytes in the tile.
+* \param	src			The compressed tile.
+* \param	srcSz			Size of the compressed tile.
+* \param	dst			Destination buffer for the tile's
+* 					values which must have space for
+* 					nBytes bytes.
+*/
+WlzErrorNum	WlzTiledValueTileDecode(WlzTiledValueCodec codec,
+				        size_t gSz, size_t nBytes,
+					void *src, size_t srcSz, void *dst)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((src == NULL) || (dst == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((gSz < 1) || ((nBytes % gSz) != 0) || (srcSz > nBytes))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(srcSz == nBytes)
+  {
+    (void )memcpy(dst, src, nBytes);
+  }
+  else
+  {
+    switch(codec)
+    {
+      case WLZ_TILED_CODEC_DRLE:
+	{
+	  size_t	idP,
+			idN,
+			nVal;
+	  WlzUByte	*buf;
+
+	  if((buf = (WlzUByte *)AlcMalloc(nBytes)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    errNum = WlzTiledValueRLEDecode(buf, nBytes,
+	                                    (WlzUByte *)src, srcSz);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    nVal = nBytes / gSz;
+	    for(idP = 0; idP < gSz; ++idP)
+	    {
+	      WlzUByte	prv = 0;
+	      WlzUByte	*sP,
+	      		*dP;
+
+	      sP = buf + (idP * nVal);
+	      dP = (WlzUByte *)dst + idP;
+	      for(idN = 0; idN < nVal; ++idN)
+	      {
+		prv += *sP++;
+		*dP = prv;
+		dP += gSz;
+	      }
+	    }
+	  }
+	  AlcFree(buf);
+	}
+        break;
+      default:
+        errNum = WLZ_ERR_PARAM_TYPE;
+	break;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of bytes in the encoded data or zero if the encoded
+* 		data would exceed the maximum size.
+* \ingroup	WlzValuesUtils
+* \brief	Run length encodes the given bytes. Each run starts with a
+* 		control byte \f$c\f$: If \f$c < 128\f$ then \f$c + 1\f$
+* 		literal bytes follow, otherwise the next byte is repeated
+* 		\f$c - 125\f$ times.
+* \param	dst			Destination buffer.
+* \param	maxSz			Maximum number of bytes to encode
+* 					in the destination buffer.
+* \param	src			Bytes to encode.
+* \param	nBytes			Number of bytes to encode.
+*/
+static size_t	WlzTiledValueRLEEncode(WlzUByte *dst, size_t maxSz,
+				       WlzUByte *src, size_t nBytes)
+{
+  size_t	idS = 0,
+  		idD = 0;
+
+  while((idS < nBytes) && (idD < maxSz))
+  {
+    size_t	nRun = 1;
+
+    while((idS + nRun < nBytes) && (nRun < 130) &&
+          (src[idS + nRun] == src[idS]))
+    {
+      ++nRun;
+    }
+    if(nRun >= 3)
+    {
+      if(idD + 2 > maxSz)
+      {
+        idD = maxSz;
+      }
+      else
+      {
+        dst[idD++] = (WlzUByte )(nRun + 125);
+	dst[idD++] = src[idS];
+	idS += nRun;
+      }
+    }
+    else
+    {
+      size_t	nLit = 0;
+
+      /* Literal bytes up to the start of the next run of at least
+       * three equal bytes. */
+      while((idS + nLit < nBytes) && (nLit < 128) &&
+	    !((idS + nLit + 2 < nBytes) &&
+	      (src[idS + nLit] == src[idS + nLit + 1]) &&
+	      (src[idS + nLit] == src[idS + nLit + 2])))
+      {
+        ++nLit;
+      }
+      if(idD + nLit + 1 > maxSz)
+      {
+        idD = maxSz;
+      }
+      else
+      {
+	dst[idD++] = (WlzUByte )(nLit - 1);
+	(void )memcpy(dst + idD, src + idS, nLit);
+	idD += nLit;
+	idS += nLit;
+      }
+    }
+  }
+  return((idS < nBytes)? 0: idD);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Decodes bytes which were run length encoded by
+* 		WlzTiledValueRLEEncode().
+* \param	dst			Destination buffer.
+* \param	nBytes			Number of decoded bytes.
+* \param	src			Encoded bytes.
+* \param	srcSz			Number of encoded bytes.
+*/
+static WlzErrorNum WlzTiledValueRLEDecode(WlzUByte *dst, size_t nBytes,
+				          WlzUByte *src, size_t srcSz)
+{
+  size_t	idS = 0,
+  		idD = 0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (idS < srcSz))
+  {
+    size_t	n;
+    WlzUByte	c;
+
+    c = src[idS++];
+    if(c < 128)
+    {
+      n = c + 1;
+      if((idS + n > srcSz) || (idD + n > nBytes))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      else
+      {
+        (void )memcpy(dst + idD, src + idS, n);
+	idS += n;
+	idD += n;
+      }
+    }
+    else
+    {
+      n = c - 125;
+      if((idS >= srcSz) || (idD + n > nBytes))
+      {
+        errNum = WLZ_ERR_VALUES_DATA;
+      }
+      else
+      {
+        (void )memset(dst + idD, src[idS++], n);
+	idD += n;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (idD != nBytes))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  return(errNum);
+}
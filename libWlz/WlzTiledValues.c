@@ -40,11 +40,13 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 #include <Wlz.h>
 
 #ifdef HAVE_MMAP
 #define WLZ_USE_MMAP
+#include <errno.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -68,6 +70,37 @@ static WlzObject  		*WlzMakeTiledValuesObj3D(
 				  WlzGreyType gType,
 				  WlzPixelV bgdV,
 				  WlzErrorNum *dstErr);
+static unsigned int		WlzTiledValueCacheKey(
+				  AlcLRUCache *lru,
+				  void *entry);
+static int			WlzTiledValueCacheCmp(
+				  const void *entry0,
+				  const void *entry1);
+static void			WlzTiledValueCacheUnlink(
+				  AlcLRUCache *lru,
+				  void *entry);
+static int			WlzTiledValueCacheCopy(
+				  WlzTiledValueCache *tc,
+				  size_t idx,
+				  size_t off,
+				  size_t n,
+				  void *buf,
+				  int write);
+static WlzErrorNum		WlzTiledValueCacheReadTiles(
+				  WlzTiledValueCache *tc,
+				  WlzTiledValueCacheTile **tiles,
+				  size_t idx,
+				  int nTiles);
+static WlzErrorNum		WlzTiledValueCacheWriteTile(
+				  WlzTiledValueCache *tc,
+				  WlzTiledValueCacheTile *tile);
+static WlzErrorNum		WlzTiledValueCacheRead(
+				  WlzTiledValueCache *tc,
+				  void *buf,
+				  size_t n,
+				  long pos);
+static WlzErrorNum		WlzTiledValueCacheReadOffsets(
+				  WlzTiledValueCache *tc);
 
 /*!
 * \return	New tiled values.
@@ -131,7 +164,17 @@ WlzErrorNum	WlzFreeTiledValues(WlzTiledValues *tVal)
     {
       AlcFree(tVal->indices);
       AlcFree(tVal->nIdx);
-      if(tVal->tiles.v)
+      if(tVal->cache)
+      {
+        errNum = WlzFreeTiledValueCache(tVal->cache);
+#ifdef WLZ_USE_MMAP
+	if(tVal->fd >= 0)
+	{
+	  (void )close(tVal->fd);
+	}
+#endif /* WLZ_USE_MMAP */
+      }
+      else if(tVal->tiles.v)
       {
 #ifdef WLZ_USE_MMAP
 	if(tVal->fd >= 0)
@@ -283,6 +326,11 @@ int		WlzTiledValuesMode(WlzTiledValues *tv, WlzErrorNum *dstErr)
     {
       flags = WLZ_IOFLAGS_READ | WLZ_IOFLAGS_WRITE;
     }
+    else if((tv->cache != NULL) && (tv->cache->codec != WLZ_TILED_CODEC_NONE))
+    {
+      /* Compressed tiles can not be modified in place. */
+      flags = WLZ_IOFLAGS_READ;
+    }
     else
     {
       int	mod;
@@ -414,23 +462,31 @@ void		WlzTiledValueBufferFlush(WlzTiledValueBuffer *tvb,
     while(kol <= tvb->kl[1])
     {
       int	i,
+		ii,
       		io,
-		itc = 0,
+		itc,
 		rmn;
-      size_t	ii;
 
       ti = kol / tv->tileWidth;
       to = kol % tv->tileWidth;
       io = tvb->lo + to;
+      rmn = tvb->kl[1] - kol + 1;
+      itc = tv->tileWidth - to;
+      if(itc > rmn)
+      {
+	itc = rmn;
+      }
       ii = *(tv->indices + tvb->li + ti);
-      if(ii > 0)
+      if((ii >= 0) && (tv->cache != NULL))
+      {
+	size_t	gSz;
+
+	gSz = WlzGreySize(tvb->gtype);
+	(void )WlzTiledValueCacheAccess(tv->cache, ii, io * gSz, itc * gSz,
+					tvb->lnbuf.ubp + (kol * gSz), 1);
+      }
+      else if(ii >= 0)
       {
-	rmn = tvb->kl[1] - kol + 1;
-	itc = tv->tileWidth - to;
-	if(itc > rmn)
-	{
-	  itc = rmn;
-	}
 	switch(tvb->gtype)
 	{
 	  case WLZ_GREY_LONG:
@@ -534,18 +590,22 @@ void		WlzTiledValueBufferFlush(WlzTiledValueBuffer *tvb,
 }
 
 /*!
+* \return	Woolz error code.
 * \ingroup	WlzValuesUtils
 * \brief	Fills the tiled values buffer using values from the tiled
-* 		values table.
+* 		values table. If the tiles are read through a tile cache
+* 		and a tile can not be read then the error is returned and
+* 		the buffer is not valid.
 * \param	tvb			Given tiled values buffer.
 * \param	tv			Given tiled values table.
 */
-void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
+WlzErrorNum	WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
 				WlzTiledValues *tv)
 {
   int		kol;
   int		ti[3],
   		to[3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   kol = tvb->kl[0];
   ti[1] = tvb->ln / tv->tileWidth;
@@ -564,7 +624,7 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
   }
   if((tvb->mode & WLZ_IOFLAGS_READ) != 0)
   {
-    while(kol <= tvb->kl[1])
+    while((errNum == WLZ_ERR_NONE) && (kol <= tvb->kl[1]))
     {
       int	i,
 		ii,
@@ -582,6 +642,17 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       }
       io = tvb->lo + to[0];
       ii = *(tv->indices + tvb->li + ti[0]);
+      if((ii >= 0) && (tv->cache != NULL))
+      {
+	size_t	gSz;
+
+	/* Read the values through the tile cache. */
+	gSz = WlzGreySize(tvb->gtype);
+	errNum = WlzTiledValueCacheAccess(tv->cache, ii, io * gSz, itc * gSz,
+				          tvb->lnbuf.ubp + (kol * gSz), 0);
+	kol += itc;
+	continue;
+      }
       switch(tvb->gtype)
       {
 	case WLZ_GREY_LONG:
@@ -758,7 +829,354 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
       kol += itc;
     }
   }
-  tvb->valid = 1;
+  tvb->valid = (errNum == WLZ_ERR_NONE);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Makes a tile cache for the given tiled values so that the
+* 		tiles are read from (and modified tiles written back to)
+* 		the file as they are required, with at most the given
+* 		number of bytes of tiles held in memory. The tiled values
+* 		must have a valid file descriptor (which must have been
+* 		opened for read and write if the values are to be
+* 		modified) and no tiles in memory. The file descriptor
+* 		is closed when the tiled values are freed.
+* 		If the tiled values have a codec set then the tiles in
+* 		the file are compressed, they are decompressed as they
+* 		are read into the cache and can not be modified. Because
+* 		of this a file descriptor which was opened for writing
+* 		is not accepted for compressed tiles. Tile indices are
+* 		used as the cache keys so the number of tiles must not
+* 		exceed UINT_MAX.
+* \param	tv			Given tiled values.
+* \param	maxSz			Maximum number of bytes of tiles
+* 					to hold in memory, at least one
+* 					tile is always held.
+* \param	nPrefetch		Number of tiles (which follow the
+* 					required tile along the lines of
+* 					the value table) to read along with
+* 					each tile which is not in the cache.
+*/
+WlzErrorNum	WlzMakeTiledValueCache(WlzTiledValues *tv, size_t maxSz,
+				       int nPrefetch)
+{
+  size_t	gSz = 0;
+  unsigned int	maxItem;
+  WlzTiledValueCache *tc = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tv == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tv->type) != WLZ_GREY_TAB_TILED)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((tv->fd < 0) || (tv->tiles.v != NULL) || (tv->cache != NULL) ||
+          (tv->tileSz < 1) || (tv->numTiles > UINT_MAX))
+  {
+    errNum = WLZ_ERR_VALUES_DATA;
+  }
+  else
+  {
+    gSz = WlzGreySize(WlzGreyTableTypeToGreyType(tv->type, NULL));
+    if(gSz <= 0)
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+  }
+#ifdef WLZ_USE_MMAP
+  if((errNum == WLZ_ERR_NONE) && (tv->codec != WLZ_TILED_CODEC_NONE))
+  {
+    int		mod;
+
+    /* Values set in compressed tiles could never be written back, so
+     * refuse a file which was opened for writing. */
+    mod = fcntl(tv->fd, F_GETFL);
+    if(mod < 0)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else if((mod & O_ACCMODE) != O_RDONLY)
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+  }
+#else
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WLZ_ERR_UNIMPLEMENTED;
+  }
+#endif /* WLZ_USE_MMAP */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((tc = (WlzTiledValueCache *)
+             AlcCalloc(1, sizeof(WlzTiledValueCache))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      tc->fd = tv->fd;
+      tc->tileOffset = tv->tileOffset;
+      tc->numTiles = tv->numTiles;
+      tc->tileBytes = tv->tileSz * gSz;
+      tc->gSz = gSz;
+      tc->codec = tv->codec;
+      maxItem = ALG_MAX(maxSz / tc->tileBytes, 1);
+      tc->nPrefetch = ALG_MAX(ALG_MIN(nPrefetch, (int )maxItem - 1), 0);
+      /* The cache is limited by the number of tiles which all have the
+       * same size, so no limit is given for the total entry size. */
+      if(((tc->tileVer = (unsigned int *)
+                         AlcCalloc(tc->numTiles, sizeof(unsigned int))) ==
+	  NULL) ||
+         ((tc->lru = AlcLRUCacheNew(maxItem, 0,
+                                    WlzTiledValueCacheKey,
+				    WlzTiledValueCacheCmp,
+				    WlzTiledValueCacheUnlink, NULL)) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (tc->codec != WLZ_TILED_CODEC_NONE))
+  {
+    errNum = WlzTiledValueCacheReadOffsets(tc);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tv->cache = tc;
+  }
+  else if(tc)
+  {
+    (void )WlzFreeTiledValueCache(tc);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code which will be that of the first error
+* 		(if any) encountered reading or writing tiles.
+* \ingroup	WlzAllocation
+* \brief	Writes back any modified tiles and then frees the given
+* 		tile cache. The file descriptor is not closed.
+* \param	tc			Given tile cache.
+*/
+WlzErrorNum	WlzFreeTiledValueCache(WlzTiledValueCache *tc)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tc)
+  {
+    if(tc->lru)
+    {
+      AlcLRUCacheFree(tc->lru, 1);
+    }
+    errNum = tc->errNum;
+    AlcFree(tc->tileOff);
+    AlcFree(tc->tileVer);
+    AlcFree(tc);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code which will be that of the first error
+* 		(if any) encountered reading or writing tiles.
+* \ingroup	WlzValuesUtils
+* \brief	Writes any modified tiles in the given tile cache back to
+* 		the file, leaving them in the cache.
+* \param	tc			Given tile cache.
+*/
+WlzErrorNum	WlzTiledValueCacheFlush(WlzTiledValueCache *tc)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tc == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValueCache)
+#endif
+    {
+      AlcLRUCItem *item;
+
+      for(item = tc->lru->rankHead; item != NULL; item = item->rankNxt)
+      {
+	WlzTiledValueCacheTile *tile;
+
+	tile = (WlzTiledValueCacheTile *)(item->entry);
+	if(tile->dirty)
+	{
+	  (void )WlzTiledValueCacheWriteTile(tc, tile);
+	}
+      }
+      errNum = tc->errNum;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Copies bytes between a buffer and a tile of a tile cache,
+* 		reading the tile (and those following it) if it is not
+* 		already in the cache. This function may be called
+* 		concurrently, with the tiles being read outside of any
+* 		critical section. Modified tiles which are removed from
+* 		the cache are written back within the critical section.
+* 		A tile which was modified or written back while it was
+* 		being read is discarded and (if it is the required tile)
+* 		found again. Because each tile has it's own version,
+* 		access is only repeated when another thread changed the
+* 		required tile.
+* \param	tc			Given tile cache.
+* \param	idx			Index of the tile.
+* \param	off			Offset into the tile (bytes).
+* \param	n			Number of bytes to copy.
+* \param	buf			Buffer to copy to or from.
+* \param	write			Copy from the buffer to the tile
+* 					if non-zero, otherwise copy from
+* 					the tile to the buffer. Tiles
+* 					which are compressed in the file
+* 					can not be written, the error is
+* 					kept by the cache so that it is
+* 					also given by
+* 					WlzTiledValueCacheFlush().
+*/
+WlzErrorNum	WlzTiledValueCacheAccess(WlzTiledValueCache *tc, size_t idx,
+				         size_t off, size_t n, void *buf,
+					 int write)
+{
+  int		done = 0;
+  unsigned int	*ver = NULL;
+  WlzTiledValueCacheTile **tiles = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tc == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if((idx >= tc->numTiles) || (off + n > tc->tileBytes))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(write && (tc->codec != WLZ_TILED_CODEC_NONE))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValueCache)
+#endif
+    {
+      if(tc->errNum == WLZ_ERR_NONE)
+      {
+	tc->errNum = errNum;
+      }
+    }
+  }
+  while((errNum == WLZ_ERR_NONE) && (done == 0))
+  {
+    int		idT,
+    		nTiles = 0;
+
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValueCache)
+#endif
+    {
+      done = WlzTiledValueCacheCopy(tc, idx, off, n, buf, write);
+      if((done == 0) && (ver != NULL))
+      {
+        WlzTiledValueCacheTile key;
+
+	/* Find the run of tiles, starting with the required tile, which
+	 * are not in the cache and keep their versions. */
+	nTiles = 1;
+	while((nTiles <= tc->nPrefetch) && (idx + nTiles < tc->numTiles))
+	{
+	  key.idx = idx + nTiles;
+	  if(AlcLRUCItemFind(tc->lru, (unsigned int )(key.idx), &key) != NULL)
+	  {
+	    break;
+	  }
+	  ++nTiles;
+	}
+	for(idT = 0; idT < nTiles; ++idT)
+	{
+	  ver[idT] = tc->tileVer[idx + idT];
+	}
+      }
+    }
+    if((done == 0) && (ver == NULL))
+    {
+      /* Allocate space for the most tiles that are ever read, the
+       * tiles are then found again with their versions. */
+      if(((ver = (unsigned int *)AlcMalloc((tc->nPrefetch + 1) *
+                                           sizeof(unsigned int))) == NULL) ||
+         ((tiles = (WlzTiledValueCacheTile **)
+	           AlcCalloc(tc->nPrefetch + 1,
+		             sizeof(WlzTiledValueCacheTile *))) == NULL))
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    else if(done == 0)
+    {
+      /* Read the tiles without blocking other cache access. */
+      errNum = WlzTiledValueCacheReadTiles(tc, tiles, idx, nTiles);
+      if(errNum == WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzTiledValueCache)
+#endif
+	{
+	  /* Only add the tiles which have not been changed while they
+	   * were being read, others may be stale. Tiles are added in
+	   * reverse order so that the required tile is the most recently
+	   * used. If the required tile was stale then it is found again. */
+	  for(idT = nTiles - 1; idT >= 0; --idT)
+	  {
+	    int	newFlg = 0;
+
+	    if(ver[idT] == tc->tileVer[idx + idT])
+	    {
+	      (void )AlcLRUCEntryAddWithKey(tc->lru, tc->tileBytes,
+					    tiles[idT],
+					    (unsigned int )(tiles[idT]->idx),
+					    &newFlg);
+	    }
+	    if(newFlg)
+	    {
+	      tiles[idT] = NULL;
+	    }
+	  }
+	  if(ver[0] == tc->tileVer[idx])
+	  {
+	    if((done = WlzTiledValueCacheCopy(tc, idx, off, n,
+					      buf, write)) == 0)
+	    {
+	      errNum = WLZ_ERR_MEM_ALLOC;
+	    }
+	  }
+	}
+      }
+      for(idT = 0; idT < nTiles; ++idT)
+      {
+	AlcFree(tiles[idT]);
+	tiles[idT] = NULL;
+      }
+    }
+  }
+  AlcFree(ver);
+  AlcFree(tiles);
+  return(errNum);
 }
 
 /*!
@@ -1211,3 +1629,313 @@ static WlzObject  *WlzMakeTiledValuesObj3D(WlzObject *gObj, size_t tileSz,
   }
   return(tObj);
 }
+
+/*!
+* \return	Cache key for the tile.
+* \ingroup	WlzValuesUtils
+* \brief	Computes the key of a tile cache entry, which is just
+* 		the tile index.
+* \param	lru			The cache (unused).
+* \param	entry			Tile cache entry.
+*/
+static unsigned int WlzTiledValueCacheKey(AlcLRUCache *lru, void *entry)
+{
+  return((unsigned int )(((WlzTiledValueCacheTile *)entry)->idx));
+}
+
+/*!
+* \return	Zero iff the entries have the same tile index.
+* \ingroup	WlzValuesUtils
+* \brief	Compares two tile cache entries.
+* \param	entry0			First tile cache entry.
+* \param	entry1			Second tile cache entry.
+*/
+static int	WlzTiledValueCacheCmp(const void *entry0, const void *entry1)
+{
+  return(((const WlzTiledValueCacheTile *)entry0)->idx !=
+         ((const WlzTiledValueCacheTile *)entry1)->idx);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Called when a tile is removed from the tile cache: Writes
+* 		the tile back to the file if it has been modified and then
+* 		frees it.
+* \param	lru			The cache (unused).
+* \param	entry			Tile cache entry.
+*/
+static void	WlzTiledValueCacheUnlink(AlcLRUCache *lru, void *entry)
+{
+  WlzTiledValueCacheTile *tile;
+
+  tile = (WlzTiledValueCacheTile *)entry;
+  if(tile->dirty)
+  {
+    (void )WlzTiledValueCacheWriteTile(tile->cache, tile);
+  }
+  AlcFree(tile);
+}
+
+/*!
+* \return	Non-zero if the tile was in the cache and the bytes were
+* 		copied.
+* \ingroup	WlzValuesUtils
+* \brief	Copies bytes between a buffer and a tile if the tile is
+* 		in the cache, making it the most recently used tile. This
+* 		function must only be called from within a critical
+* 		section.
+* \param	tc			Given tile cache.
+* \param	idx			Index of the tile.
+* \param	off			Offset into the tile (bytes).
+* \param	n			Number of bytes to copy.
+* \param	buf			Buffer to copy to or from.
+* \param	write			Copy from the buffer to the tile
+* 					if non-zero.
+*/
+static int	WlzTiledValueCacheCopy(WlzTiledValueCache *tc, size_t idx,
+				       size_t off, size_t n, void *buf,
+				       int write)
+{
+  WlzTiledValueCacheTile key;
+  WlzTiledValueCacheTile *tile;
+
+  key.idx = idx;
+  tile = (WlzTiledValueCacheTile *)
+         AlcLRUCEntryGetWithKey(tc->lru, (unsigned int )idx, &key);
+  if(tile)
+  {
+    if(write)
+    {
+      (void )memcpy((char *)(tile->data) + off, buf, n);
+      tile->dirty = 1;
+      ++(tc->tileVer[idx]);
+    }
+    else
+    {
+      (void )memcpy(buf, (char *)(tile->data) + off, n);
+    }
+  }
+  return(tile != NULL);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Allocates and reads a run of consecutive tiles from the
+* 		tile cache's file using a single read, decompressing them
+* 		if required. On error any tiles allocated are left in the
+* 		given array for the caller to free.
+* \param	tc			Given tile cache.
+* \param	tiles			Array for the new tiles.
+* \param	idx			Index of the first tile.
+* \param	nTiles			Number of tiles to read.
+*/
+static WlzErrorNum WlzTiledValueCacheReadTiles(WlzTiledValueCache *tc,
+				      WlzTiledValueCacheTile **tiles,
+				      size_t idx, int nTiles)
+{
+  int		idT;
+  size_t	bufSz;
+  long		pos;
+  char		*buf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tc->tileOff)
+  {
+    pos = tc->tileOffset + tc->tileOff[idx];
+    bufSz = tc->tileOff[idx + nTiles] - tc->tileOff[idx];
+  }
+  else
+  {
+    pos = tc->tileOffset + (long )(idx * tc->tileBytes);
+    bufSz = nTiles * tc->tileBytes;
+  }
+  if((buf = (char *)AlcMalloc(bufSz)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    errNum = WlzTiledValueCacheRead(tc, buf, bufSz, pos);
+  }
+  for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nTiles); ++idT)
+  {
+    WlzTiledValueCacheTile *tile;
+
+    /* Each tile and it's data are allocated together. */
+    if((tile = (WlzTiledValueCacheTile *)
+               AlcMalloc(sizeof(WlzTiledValueCacheTile) +
+	                 tc->tileBytes)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      tiles[idT] = tile;
+      tile->idx = idx + idT;
+      tile->dirty = 0;
+      tile->data = (void *)(tile + 1);
+      tile->cache = tc;
+      if(tc->tileOff)
+      {
+	size_t	tIdx;
+
+	tIdx = tile->idx;
+	errNum = WlzTiledValueTileDecode(tc->codec, tc->gSz, tc->tileBytes,
+			  buf + (tc->tileOff[tIdx] - tc->tileOff[idx]),
+			  tc->tileOff[tIdx + 1] - tc->tileOff[tIdx],
+			  tile->data);
+      }
+      else
+      {
+        (void )memcpy(tile->data, buf + (idT * tc->tileBytes),
+	              tc->tileBytes);
+      }
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Reads bytes from the tile cache's file at the given
+* 		position, without changing the file position so that the
+* 		file may be read concurrently.
+* \param	tc			Given tile cache.
+* \param	buf			Buffer for the bytes read.
+* \param	n			Number of bytes to read.
+* \param	pos			Position in the file.
+*/
+static WlzErrorNum WlzTiledValueCacheRead(WlzTiledValueCache *tc,
+				      void *buf, size_t n, long pos)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef WLZ_USE_MMAP
+  size_t	cnt = 0;
+
+  while((errNum == WLZ_ERR_NONE) && (cnt < n))
+  {
+    ssize_t	rd;
+
+    rd = pread(tc->fd, (char *)buf + cnt, n - cnt, (off_t )(pos + cnt));
+    if(rd > 0)
+    {
+      cnt += rd;
+    }
+    else if((rd == 0) || (errno != EINTR))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+  }
+#else /* WLZ_USE_MMAP */
+  errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* WLZ_USE_MMAP */
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Reads the table of compressed tile offsets which is at the
+* 		start of the compressed tiles in the tile cache's file.
+* 		Each of the numTiles + 1 offsets is stored as a pair of
+* 		least significant byte first 32 bit words, with the least
+* 		significant word first.
+* \param	tc			Given tile cache.
+*/
+static WlzErrorNum WlzTiledValueCacheReadOffsets(WlzTiledValueCache *tc)
+{
+  size_t	idx,
+  		nOff;
+  WlzUByte	*buf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nOff = tc->numTiles + 1;
+  if(((buf = (WlzUByte *)AlcMalloc(nOff * 8)) == NULL) ||
+     ((tc->tileOff = (long *)AlcMalloc(nOff * sizeof(long))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    errNum = WlzTiledValueCacheRead(tc, buf, nOff * 8, tc->tileOffset);
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nOff); ++idx)
+  {
+    int		idB;
+    unsigned long off = 0;
+    WlzUByte	*bP;
+
+    bP = buf + (idx * 8);
+    if((sizeof(long) < 8) && ((bP[4] | bP[5] | bP[6] | bP[7]) != 0))
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else
+    {
+      for(idB = (sizeof(long) < 8)? 3: 7; idB >= 0; --idB)
+      {
+	off = (off << 8) | bP[idB];
+      }
+      tc->tileOff[idx] = (long )off;
+      if((idx > 0) &&
+         ((tc->tileOff[idx] < tc->tileOff[idx - 1]) ||
+	  ((size_t )(tc->tileOff[idx] - tc->tileOff[idx - 1]) >
+	   tc->tileBytes)))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Writes a modified tile back to the tile cache's file,
+* 		recording any error in the cache. This function must only
+* 		be called from within a critical section.
+* \param	tc			Given tile cache.
+* \param	tile			Given tile.
+*/
+static WlzErrorNum WlzTiledValueCacheWriteTile(WlzTiledValueCache *tc,
+				      WlzTiledValueCacheTile *tile)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+#ifdef WLZ_USE_MMAP
+  size_t	cnt = 0;
+  off_t		pos;
+
+  pos = (off_t )(tc->tileOffset) + (off_t )(tile->idx * tc->tileBytes);
+  while((errNum == WLZ_ERR_NONE) && (cnt < tc->tileBytes))
+  {
+    ssize_t	wr;
+
+    wr = pwrite(tc->fd, (char *)(tile->data) + cnt, tc->tileBytes - cnt,
+                pos + cnt);
+    if(wr > 0)
+    {
+      cnt += wr;
+    }
+    else if((wr == 0) || (errno != EINTR))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+#else /* WLZ_USE_MMAP */
+  errNum = WLZ_ERR_UNIMPLEMENTED;
+#endif /* WLZ_USE_MMAP */
+  tile->dirty = 0;
+  ++(tc->tileVer[tile->idx]);
+  if((errNum != WLZ_ERR_NONE) && (tc->errNum == WLZ_ERR_NONE))
+  {
+    tc->errNum = errNum;
+  }
+  return(errNum);
+}
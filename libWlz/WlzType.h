@@ -816,7 +816,9 @@ typedef enum _WlzInterpolationType
 					     each interpolated value. */
   WLZ_INTERPOLATION_ORDER_2,		/*!< Second order interpolation. */
   WLZ_INTERPOLATION_BARYCENTRIC,	/*!< Barycentric mesh interpolation. */
-  WLZ_INTERPOLATION_KRIG 	        /*!< Kriging mesh interpolation. */
+  WLZ_INTERPOLATION_KRIG, 	        /*!< Kriging mesh interpolation. */
+  WLZ_INTERPOLATION_CUBIC		/*!< Cubic or tri-cubic (Catmull-Rom)
+  					     interpolation. */
 } WlzInterpolationType;
 
 /*!
@@ -3026,6 +3028,92 @@ typedef struct _WlzIndexedValues
   AlcVector     *values;                /*!< The indexed values. */
 } WlzIndexedValues;
 
+/*!
+* \enum		_WlzTiledValueCodec
+* \ingroup	WlzType
+* \brief	Codecs used to compress the tiles of a tiled value table
+* 		when they are stored in a file. Each tile is compressed
+* 		independently so that tiles may still be read at random.
+* 		Typedef: ::WlzTiledValueCodec.
+*/
+typedef enum _WlzTiledValueCodec
+{
+  WLZ_TILED_CODEC_NONE		= 0,	/*!< Tiles are not compressed. */
+  WLZ_TILED_CODEC_DRLE		= 1,	/*!< The bytes of each tile's values
+  					     are split into byte planes which
+					     are delta then run length
+					     encoded. */
+  WLZ_TILED_CODEC_COUNT			/*!< Not a codec but the number of
+  					     codecs. Keep this last. */
+} WlzTiledValueCodec;
+
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzTiledValueCacheTile
+* \ingroup	WlzType
+* \brief	A single tile held in a tiled value cache.
+* 		Typedef: ::WlzTiledValueCacheTile.
+*/
+typedef struct _WlzTiledValueCacheTile
+{
+  size_t	idx;			/*!< Index of the tile within the
+  					     tiles of the tiled values. */
+  int		dirty;			/*!< Non-zero if the tile's values
+  					     have been modified but not yet
+					     written back to the file. */
+  void		*data;			/*!< The tile's values. */
+  struct _WlzTiledValueCache *cache;	/*!< The cache which holds the
+  					     tile. */
+} WlzTiledValueCacheTile;
+
+/*!
+* \struct	_WlzTiledValueCache
+* \ingroup	WlzType
+* \brief	A least recently used cache of tiles which allows the
+* 		tiles of a tiled value table to be read from the file as
+* 		they are required rather than reading or memory mapping
+* 		all of the tiles. Modified tiles are written back to the
+* 		file when they are removed from the cache. When a tile
+* 		which is not in the cache is required the following
+* 		tiles (which are those that follow it along the lines of
+* 		the value table) are read with it.
+* 		The cache may be accessed concurrently.
+* 		Typedef: ::WlzTiledValueCache.
+*/
+typedef struct _WlzTiledValueCache
+{
+  AlcLRUCache	*lru;			/*!< Cache of tiles keyed by the
+  					     tile index. */
+  int		fd;			/*!< File descriptor for the file
+  					     with the tiles. */
+  long		tileOffset;		/*!< Offset from the start of the
+  					     file to the tiles. */
+  size_t	numTiles;		/*!< The total number of tiles. */
+  size_t	tileBytes;		/*!< Number of bytes in each tile. */
+  int		nPrefetch;		/*!< Number of following tiles to
+  					     read along with a tile which
+					     is not in the cache. */
+  unsigned int	*tileVer;		/*!< Version of each tile, which is
+  					     incremented each time the tile
+					     is modified in the cache or
+					     written back to the file, used
+					     to detect stale tile copies. */
+  WlzTiledValueCodec codec;		/*!< Codec used to compress the
+  					     tiles in the file. Tiles of a
+					     compressed file are read only. */
+  size_t	gSz;			/*!< Size of the grey values in
+  					     bytes, used by the codec. */
+  long		*tileOff;		/*!< Offsets of the compressed tiles
+  					     from the tile offset, with
+					     numTiles + 1 entries so that
+					     each tile's compressed size is
+					     known. NULL if the tiles are not
+					     compressed. */
+  WlzErrorNum	errNum;			/*!< First error (if any) reading
+  					     or writing tiles. */
+} WlzTiledValueCache;
+#endif /* WLZ_EXT_BIND */
+
 /*!
 * \struct       _WlzTiledValues
 * \ingroup      WlzType
@@ -3063,6 +3151,17 @@ typedef struct _WlzIndexedValues
 * 		memory in which case the file descriptor will have a
 * 		non-negative value. This can be used to close the file.
 *
+* 		Alternatively the tiles may be read on demand through a
+* 		tile cache (see WlzMakeTiledValueCache()), in which case
+* 		the tiles pointer is NULL, the file descriptor is valid and
+* 		only the cached tiles are held in memory.
+*
+* 		The tiles may be compressed when stored in a file (see
+* 		::WlzTiledValueCodec), in which case they are decompressed
+* 		when read, either all at once into memory or individually
+* 		by the tile cache. Compressed tiles can not be memory
+* 		mapped or modified in place within the file.
+*
 * 		A memory mapped tiled values object can only have it's
 * 		grey values changed if the file was opened for writing
 * 		attempting to change the grey values of an object only
@@ -3110,6 +3209,13 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+  struct _WlzTiledValueCache *cache;	/*!< Tile cache, which if non-NULL
+  					     is used to access the tiles
+					     which are then not in memory
+					     (tiles is NULL). */
+  WlzTiledValueCodec codec;		/*!< Codec used to compress the
+  					     tiles when they are stored in
+					     a file. */
 } WlzTiledValues;
 
 /*!
@@ -4018,6 +4124,128 @@ typedef struct _WlzCMeshCellGrid3D
   AlcBlockStack	*allCE;                 /*! Allocated cell elements. */
 } WlzCMeshCellGrid3D;
 
+/*!
+* \struct       _WlzCMeshLocGrid2D
+* \ingroup      WlzMesh
+* \brief        A flattened uniform grid of square cells over the bounding
+* 		boxes of the elements of a 2D mesh, which is used for fast
+* 		location of the element enclosing a position.
+* 		The indices of the elements with bounding boxes which
+* 		intersect the cell with index i are stored contiguously
+* 		in elmIdx[cellOff[i]] to elmIdx[cellOff[i + 1] - 1],
+* 		with \f$i = y n_x + x\f$.
+*               Typedef: ::WlzCMeshLocGrid2D.
+*/
+typedef struct _WlzCMeshLocGrid2D
+{
+  WlzIVertex2	nCells;			/*!< Dimensions of the grid in
+  					     terms of the number of cells. */
+  WlzDVertex2	org;			/*!< Origin of the grid. */
+  double	cellSz;			/*!< Side length of the cells. */
+  int		nElm;			/*!< Number of valid elements in the
+  					     mesh when the grid was made. */
+  WlzDBox2	bBox;			/*!< Mesh bounding box when the grid
+  					     was made. */
+  int		*cellOff;		/*!< Offsets of the cells' element
+  					     indices. */
+  int		*elmIdx;		/*!< Element indices. */
+  WlzDBox2	*elmBox;		/*!< Element bounding boxes, indexed
+  					     by element index. */
+} WlzCMeshLocGrid2D;
+
+/*!
+* \struct       _WlzCMeshLocGrid3D
+* \ingroup      WlzMesh
+* \brief        A flattened uniform grid of cubic cells over the bounding
+* 		boxes of the elements of a 3D mesh, which is used for fast
+* 		location of the element enclosing a position.
+* 		The indices of the elements with bounding boxes which
+* 		intersect the cell with index i are stored contiguously
+* 		in elmIdx[cellOff[i]] to elmIdx[cellOff[i + 1] - 1],
+* 		with \f$i = (z n_y + y) n_x + x\f$.
+*               Typedef: ::WlzCMeshLocGrid3D.
+*/
+typedef struct _WlzCMeshLocGrid3D
+{
+  WlzIVertex3	nCells;			/*!< Dimensions of the grid in
+  					     terms of the number of cells. */
+  WlzDVertex3	org;			/*!< Origin of the grid. */
+  double	cellSz;			/*!< Side length of the cells. */
+  int		nElm;			/*!< Number of valid elements in the
+  					     mesh when the grid was made. */
+  WlzDBox3	bBox;			/*!< Mesh bounding box when the grid
+  					     was made. */
+  int		*cellOff;		/*!< Offsets of the cells' element
+  					     indices. */
+  int		*elmIdx;		/*!< Element indices. */
+  WlzDBox3	*elmBox;		/*!< Element bounding boxes, indexed
+  					     by element index. */
+} WlzCMeshLocGrid3D;
+
+/*!
+* \struct       _WlzCMeshArr3D
+* \ingroup      WlzMesh
+* \brief        A compact array based representation of a 3D conforming
+* 		mesh in which the node positions, element nodes and
+* 		adjacencies are held in contiguous (structure of arrays)
+* 		arrays indexed by the node and element indices, rather
+* 		than in linked node, element and edge use structures.
+* 		Nodes and elements are allocated from pools: the index
+* 		array entry of a valid entity is it's own index, while
+* 		the entry of a free entity is \f$-2 - n\f$, where
+* 		\f$n\f$ is the index of the next free entity
+* 		(\f$-1\f$ at the end of the free list).
+* 		The nodes of element e are elmNod[4e] to elmNod[4e + 3]
+* 		in the order of WLZ_CMESH_ELM3D_GET_NODE_0() to
+* 		WLZ_CMESH_ELM3D_GET_NODE_3(), with the face f of element
+* 		e having elmOpp[4e + f] = 4 o + g where face g of element
+* 		o is the opposite face, or -1 if there is none.
+* 		The edge use ring of node n is held in ringNod[i] and
+* 		ringElm[i] for ringOff[n] <= i < ringOff[n + 1], with
+* 		ringNod[i] being the index of the node at the other end
+* 		of the edge use and ringElm[i] = 4 e + f, where the edge
+* 		use is in face f of element e.
+* 		The adjacencies (elmOpp and the ring) are only valid if
+* 		adjValid is non-zero, see WlzCMeshArrSetAdj3D().
+*               Typedef: ::WlzCMeshArr3D.
+*/
+typedef struct _WlzCMeshArr3D
+{
+  int		nNod;			/*!< Number of valid nodes. */
+  int		maxNod;			/*!< Number of node indices used,
+  					     all node indices are less
+					     than this. */
+  int		nodSz;			/*!< Space allocated for nodes. */
+  int		nodFree;		/*!< First free node or -1. */
+  int		nElm;			/*!< Number of valid elements. */
+  int		maxElm;			/*!< Number of element indices used,
+  					     all element indices are less
+					     than this. */
+  int		elmSz;			/*!< Space allocated for elements. */
+  int		elmFree;		/*!< First free element or -1. */
+  int		adjValid;		/*!< Non-zero if the adjacencies are
+  					     valid. */
+  int		ringSz;			/*!< Number of entries in the edge
+  					     use rings. */
+  int		*nodIdx;		/*!< Node indices. */
+  unsigned int	*nodFlags;		/*!< Node flags. */
+  double	*nodX;			/*!< Node column positions. */
+  double	*nodY;			/*!< Node line positions. */
+  double	*nodZ;			/*!< Node plane positions. */
+  int		*elmIdx;		/*!< Element indices. */
+  unsigned int	*elmFlags;		/*!< Element flags. */
+  int		*elmNod;		/*!< Element nodes, four per
+  					     element. */
+  int		*elmOpp;		/*!< Opposite faces, four per
+  					     element. */
+  int		*ringOff;		/*!< Offsets of the nodes' edge use
+  					     rings. */
+  int		*ringNod;		/*!< Nodes at the other ends of the
+  					     edge uses. */
+  int		*ringElm;		/*!< Elements and faces of the edge
+  					     uses. */
+} WlzCMeshArr3D;
+
 #ifndef WLZ_EXT_BIND
 /*!
 * \typedef	WlzCMeshCbFn
@@ -4122,6 +4350,9 @@ typedef struct _WlzCMesh2D
   WlzCMeshCellGrid2D cGrid;		/*!< Cell grid for fast node and
   					     element location queries. */
   struct _WlzCMeshRes res;              /*!< Mesh resources. */
+  struct _WlzCMeshLocGrid2D *lGrid;	/*!< Optional element location grid,
+  					     see WlzCMeshSetLocGrid2D(),
+					     may be NULL. */
 
 } WlzCMesh2D;
 
@@ -4180,6 +4411,9 @@ typedef struct _WlzCMesh3D
   WlzCMeshCellGrid3D cGrid;		/*!< Cell grid for fast node and
   					     element location queries. */
   struct _WlzCMeshRes res;              /*!< Mesh resources. */
+  struct _WlzCMeshLocGrid3D *lGrid;	/*!< Optional element location grid,
+  					     see WlzCMeshSetLocGrid3D(),
+					     may be NULL. */
 
 } WlzCMesh3D;
 
@@ -4260,6 +4494,72 @@ typedef void *WlzBasisDistFn;
 typedef double (*WlzBasisDistFn)(void *, int, WlzVertex, void *);
 #endif /* WLZ_EXT_BIND */
 
+/*!
+* \struct	_WlzBasisFnTreeNod
+* \ingroup	WlzFunction
+* \brief	A node of a basis function evaluation tree. Each node
+* 		holds a cluster of control points together with the
+* 		moments (to second order) of the basis function
+* 		coefficients about the centre of the cluster.
+* 		Typedef: ::WlzBasisFnTreeNod.
+*/
+typedef struct _WlzBasisFnTreeNod
+{
+  int		idx;			/*!< Index of the first of the
+  					     node's control points in the
+					     tree's (permuted) arrays. */
+  int		nPts;			/*!< Number of control points. */
+  int		chd[2];			/*!< Indices of the child nodes,
+  					     both are -1 for leaf nodes. */
+  double	rad;			/*!< Radius of a sphere about the
+  					     centre which contains all the
+					     control points. */
+  double	wgt;			/*!< Sum over the control points of
+  					     the maximum absolute coefficient
+					     component. */
+  double	m3;			/*!< Sum over the control points of
+  					     the maximum absolute coefficient
+					     component times the cube of the
+					     distance from the centre. */
+  WlzDVertex3	cen;			/*!< Centre of the cluster. */
+  WlzDVertex3	m0;			/*!< Sum of coefficients. */
+  WlzDVertex3	m1[3];			/*!< First moments, for each
+  					     coefficient component the sum
+					     of the coefficients times the
+					     offsets from the centre. */
+  double	m2[3][6];		/*!< Second moments, for each
+  					     coefficient component the sum of
+					     the coefficients times the
+					     offset outer products (xx, xy,
+					     xz, yy, yz, zz). */
+} WlzBasisFnTreeNod;
+
+/*!
+* \struct	_WlzBasisFnTree
+* \ingroup	WlzFunction
+* \brief	A tree of control point clusters used for the approximate
+* 		evaluation of radial basis functions with a bounded
+* 		error. See WlzBasisFnTreeMake().
+* 		Typedef: ::WlzBasisFnTree.
+*/
+typedef struct _WlzBasisFnTree
+{
+  WlzFnType	type;			/*!< Type of basis function. */
+  int		nPts;			/*!< Number of control points. */
+  int		nNod;			/*!< Number of tree nodes. */
+  int		maxNod;			/*!< Space allocated for nodes. */
+  double	delta;			/*!< Basis function delta parameter
+  					     (multiquadrics only). */
+  double	tol;			/*!< Maximum absolute error of the
+  					     evaluated basis function. */
+  double	tolSum;			/*!< Maximum absolute error of the
+  					     sum of basis function terms. */
+  WlzDVertex3	*pts;			/*!< Control points in tree order. */
+  WlzDVertex3	*co;			/*!< Coefficients in tree order. */
+  WlzBasisFnTreeNod *nod;		/*!< The tree nodes, with the root
+  					     node first. */
+} WlzBasisFnTree;
+
 /*!
 * \struct	_WlzBasisFn
 * \ingroup	WlzFunction
@@ -4335,6 +4635,9 @@ typedef struct _WlzBasisFn
 					     Athough the number of control
 					     points may vary the number of
 					     mesh nodes must remain constant. */
+  WlzBasisFnTree *tree;			/*!< Optional tree used for the
+  					     approximate evaluation of the
+					     basis function, may be NULL. */
 } WlzBasisFn;
 
 /*!
@@ -4799,6 +5102,55 @@ typedef struct _WlzGreyWSpace
 					     raster. */
 } WlzGreyWSpace;
 
+/*!
+* \struct	_WlzGreyLineWSpace
+* \ingroup	WlzAccess
+* \brief	A workspace for batched line scanning of domain objects
+* 		with grey values. Rather than handing out one interval
+* 		at a time (as with WlzNextGreyInterval()) the workspace
+* 		holds all the intervals of a line together with pointers
+* 		to their contiguous grey values so that kernels can run
+* 		tight loops with the grey type dispatched once per line.
+*		Typedef: ::WlzGreyLineWSpace.
+*/
+typedef struct _WlzGreyLineWSpace
+{
+  WlzObject	*obj;			/*!< The object being scanned, either
+  					     a 2D or 3D domain object. The
+					     object is not assigned by the
+					     workspace. */
+  int		write;			/*!< Non-zero if the values are to
+  					     be modified, in which case any
+					     buffered values (tiled value
+					     tables) are written back. */
+  WlzGreyType	gType;			/*!< Grey type of the current
+  					     plane's values. */
+  WlzObjectType	gTabType;		/*!< Value table type of the current
+  					     plane's values. */
+  WlzIntervalDomain *iDom;		/*!< Domain of the current plane,
+  					     may be NULL for empty planes. */
+  WlzValues	values;			/*!< Values of the current plane or
+  					     the tiled values table. */
+  WlzTiledValueBuffer *tvb;		/*!< Line buffer for tiled values,
+  					     NULL for other value tables. */
+  int		started;		/*!< Non-zero once a line has been
+  					     scanned. */
+  int		pln;			/*!< Current plane, always zero
+  					     for 2D objects. */
+  int		ln;			/*!< Current line. */
+  int		nItv;			/*!< Number of intervals in the
+  					     current line. */
+  int		maxItv;			/*!< Space allocated for intervals
+  					     and value pointers. */
+  WlzInterval	*itv;			/*!< Intervals of the current line
+  					     with absolute column
+					     coordinates. */
+  WlzGreyP	*val;			/*!< Pointers to the grey value
+  					     of the first (left most) column
+					     of each interval. The values of
+					     each interval are contiguous. */
+} WlzGreyLineWSpace;
+
 
 /*!
 * \struct	_WlzIterateWSpace
@@ -4878,6 +5230,12 @@ typedef struct _WlzGreyValueWSpace
 					     which values are background.
 					     Value is 0 if there are no
 					     background values. */
+  WlzGreyP	tileBuf;		/*!< Copy of a single tile, only
+  					     used for tiled values accessed
+					     through a tile cache. */
+  size_t	tileIdx;		/*!< Index of the tile in tileBuf. */
+  unsigned int	tileVer;		/*!< Version of the tile in the tile
+  					     cache when tileBuf was copied. */
 } WlzGreyValueWSpace;
 
 /************************************************************************
@@ -41,6 +41,9 @@ static char _WlzUnion3d_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* function:     WlzUnion3d    */
 /*! 
@@ -61,12 +64,12 @@ WlzObject *WlzUnion3d(int	n,
 		      WlzErrorNum *dstErr)
 {
   /* local variables */
-  WlzObject 		**objlist = NULL, *newobj = NULL;
+  WlzObject 		*newobj = NULL;
   WlzPlaneDomain 	*pdom = NULL, *newpdom = NULL;
-  WlzVoxelValues 	*voxtab = NULL, *newvoxtab = NULL;
+  WlzVoxelValues 	*newvoxtab = NULL;
   WlzDomain 		*domains = NULL, domain;
   WlzValues	 	*values = NULL, vals;
-  int 			i, p, np, min_plane, max_plane;
+  int 			i, min_plane, max_plane;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
     /* all objects have been checked by WlzUnionN therefore do not need
@@ -122,23 +125,6 @@ WlzObject *WlzUnion3d(int	n,
     }
   }
 
-  /* allocate space for a working object array */
-  objlist = NULL;
-  if( errNum == WLZ_ERR_NONE ){
-    if( (objlist = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n))
-       == NULL){
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-    else {
-      domain.core = NULL;
-      vals.core = NULL;
-      for(i=0; i < n; i++){
-	objlist[i] = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, vals,
-				 NULL, NULL, &errNum);
-      }
-    }
-  }
-
   /* make a new planedomain and valuetable if required */
   if((errNum == WLZ_ERR_NONE) &&
      (newpdom = WlzMakePlaneDomain(pdom->type, min_plane, max_plane,
@@ -155,58 +141,95 @@ WlzObject *WlzUnion3d(int	n,
     }
   }
 
-  /* find union at each plane */
+  /* find union at each plane, with the planes processed concurrently
+     and each thread using it's own working object array */
   if( errNum == WLZ_ERR_NONE ){
-    for(p=min_plane; p <= max_plane; p++){
-      np = 0;
-      for(i=0; i < n; i++){
-	pdom = objs[i]->domain.p;
-	if( pdom->plane1 > p || pdom->lastpl < p )
-	{
-	  continue;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int		pp, ii;
+      WlzObject		*pObj = NULL, **pObjs = NULL;
+      WlzErrorNum	errP = WLZ_ERR_NONE;
+
+      if(((pObj = (WlzObject *) AlcCalloc(n, sizeof(WlzObject))) == NULL) ||
+	 ((pObjs = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n))
+	  == NULL)){
+	errP = WLZ_ERR_MEM_ALLOC;
+      }
+      else {
+	for(ii=0; ii < n; ii++){
+	  pObj[ii].type = WLZ_2D_DOMAINOBJ;
 	}
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(pp=min_plane; pp <= max_plane; pp++){
+	int		pn = 0;
+	WlzObject	*pNewObj = NULL;
+	WlzPlaneDomain	*pPDom;
 
-	if( (pdom->domains)[p - pdom->plane1].i == NULL )
-	{
+	if( errP != WLZ_ERR_NONE ){
 	  continue;
 	}
-
-	objlist[np]->domain.i = (pdom->domains)[p - pdom->plane1].i;
-	if( uvt ){
-	  voxtab = objs[i]->values.vox;
-	  objlist[np]->values.v = (voxtab->values)[p - voxtab->plane1].v;
+	for(ii=0; ii < n; ii++){
+	  pPDom = objs[ii]->domain.p;
+	  if( pPDom->plane1 > pp || pPDom->lastpl < pp )
+	  {
+	    continue;
+	  }
+
+	  if( (pPDom->domains)[pp - pPDom->plane1].i == NULL )
+	  {
+	    continue;
+	  }
+
+	  pObjs[pn] = pObj + pn;
+	  pObjs[pn]->domain.i = (pPDom->domains)[pp - pPDom->plane1].i;
+	  if( uvt ){
+	    WlzVoxelValues *pVox = objs[ii]->values.vox;
+	    pObjs[pn]->values.v = (pVox->values)[pp - pVox->plane1].v;
+	  }
+	  pn++;
 	}
-	np++;
-      }
 
-      newobj = NULL;
-      if( np ){
-	newobj = WlzUnionN(np, objlist, uvt, &errNum);
-      }
+	if( pn ){
+	  pNewObj = WlzUnionN(pn, pObjs, uvt, &errP);
+	}
 
-      /* when np is 1, WlzUnionN does not return a copy. */
-      if( newobj != NULL ){
-	if (1 == np)
-	  domains[p - min_plane] = 
-	    WlzAssignDomain(WlzCopyDomain(newobj->type, newobj->domain,
-					  &errNum), NULL);
-	else
-	  domains[p - min_plane] = WlzAssignDomain(newobj->domain, NULL);
-	if( uvt ){
-	  if (1 == np)
-	    values[p - min_plane] =
-	      WlzAssignValues(WlzCopyValues(newobj->type, newobj->values,
-					    newobj->domain, &errNum), NULL);
+	/* when pn is 1, WlzUnionN does not return a copy. */
+	if( pNewObj != NULL ){
+	  if (1 == pn)
+	    domains[pp - min_plane] =
+	      WlzAssignDomain(WlzCopyDomain(pNewObj->type, pNewObj->domain,
+					    &errP), NULL);
 	  else
-	    values[p - min_plane] = WlzAssignValues(newobj->values, NULL);
-	}
-	WlzFreeObj(newobj);
-      } else {
-	domains[p - min_plane].i = NULL;
-	if( uvt ){
-	  values[p - min_plane].v = NULL;
+	    domains[pp - min_plane] = WlzAssignDomain(pNewObj->domain, NULL);
+	  if( uvt ){
+	    if (1 == pn)
+	      values[pp - min_plane] =
+		WlzAssignValues(WlzCopyValues(pNewObj->type, pNewObj->values,
+					      pNewObj->domain, &errP), NULL);
+	    else
+	      values[pp - min_plane] = WlzAssignValues(pNewObj->values, NULL);
+	  }
+	  WlzFreeObj(pNewObj);
+	} else {
+	  domains[pp - min_plane].i = NULL;
+	  if( uvt ){
+	    values[pp - min_plane].v = NULL;
+	  }
 	}
       }
+      AlcFree(pObjs);
+      AlcFree(pObj);
+      if( errP != WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp critical (WlzUnion3d)
+#endif
+	errNum = errP;
+      }
     }
   }
 
@@ -223,12 +246,6 @@ WlzObject *WlzUnion3d(int	n,
     vals.vox = newvoxtab;
     newobj = WlzMakeMain(WLZ_3D_DOMAINOBJ, domain, vals,
 			 NULL, NULL, &errNum);
-
-  /* free allocated memory and return */
-    for(i=0; i < n; i++){
-      AlcFree(objlist[i]);
-    }
-    AlcFree( objlist );
   }
 
   if( dstErr ){
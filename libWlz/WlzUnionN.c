@@ -40,12 +40,50 @@ static char _WlzUnionN_c[] = "University of Edinburgh $Id$";
 */
 
 #include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzUnionNCursor
+* \ingroup	WlzBinaryOps
+* \brief	Cursor through the intervals of a single line of one of
+* 		the objects being merged.
+* 		Typedef: ::WlzUnionNCursor.
+*/
+typedef struct _WlzUnionNCursor
+{
+  int		kol1;		/*!< Column offset of the intervals. */
+  int		nItv;		/*!< Number of intervals remaining. */
+  WlzInterval	*itv;		/*!< Next interval. */
+  WlzInterval	rItv;		/*!< Interval for rectangular domains. */
+} WlzUnionNCursor;
 
 extern WlzObject *WlzUnion3d(int 	n,
 			     WlzObject 	**objs,
 			     int 	uvt,
 			     WlzErrorNum *dstErr);
 
+static void			WlzUnionNSift(
+				  WlzUnionNCursor *cur,
+				  int *heap,
+				  int nHeap,
+				  int idx);
+static int			WlzUnionNLine(
+				  int nLnObj,
+				  int *lnObj,
+				  WlzObject **objs,
+				  int ln,
+				  int kol1,
+				  WlzUnionNCursor *cur,
+				  int *heap,
+				  WlzInterval *dItv);
+static WlzErrorNum		WlzUnionNIntervals(
+				  int n,
+				  WlzObject **objs,
+				  WlzIntervalDomain *uDom,
+				  WlzInterval *uItv);
+
 /* function:     WlzUnionN    */
 /*! 
 * \ingroup      WlzBinaryOps
@@ -57,6 +95,10 @@ extern WlzObject *WlzUnion3d(int 	n,
 
  This function may modify the order of the objects in the array it is
  passed if the array contains empty objects.
+
+ The intervals of each line are merged by a k-way heap merge of the
+ intervals of the objects which cover the line, with lines (and the
+ planes of 3D objects) processed concurrently.
 *
 * \return       Union of the array of object.
 * \param    n	number of input objects
@@ -76,13 +118,13 @@ WlzObject *WlzUnionN(
   WlzDomain		domain;
   WlzValues		values;
   WlzIntervalDomain	*idom;
-  WlzInterval		*itvl = NULL, *jtvl = NULL;
+  WlzInterval		*itvl = NULL;
   WlzIntervalWSpace	*iwsp;
   WlzIntervalWSpace	*biwsp = NULL, *tiwsp, niwsp;
   WlzGreyWSpace		*gwsp, ngwsp;
   WlzObjectType		type;
   int 			i, j, k, l;
-  int			inttot, numactive, change, lwas = 0, nints, noverlap;
+  int			inttot, noverlap;
   WlzPixelV		backg;
   int			line1, lastln;
   int			kol1,lastkl;
@@ -265,9 +307,6 @@ WlzObject *WlzUnionN(
     }
     else {
       idom->freeptr = AlcFreeStackPush(idom->freeptr, (void *)itvl, NULL);
-      lwas = line1;
-      jtvl = itvl;
-      nints = 0;
       domain.i = idom;
       values.v = NULL;
       if( (obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, values,
@@ -299,85 +338,18 @@ WlzObject *WlzUnionN(
   }
 
   /*
-   * Construct the union object's table of intervals.
-   * Initialise scanning on each object/workspace combination.
-   * Scan synchronously, setting up the union of adjacent and
-   * overlapping intervals.  Needs a clear head !!
+   * Construct the union object's table of intervals. The intervals
+   * of each line are merged using a heap ordered by their first
+   * column and the lines are merged concurrently.
    */
   if( errNum == WLZ_ERR_NONE ){
-    for (i=0; i<n; i++) {
-      WlzInitRasterScan(objs[i], iwsp, WLZ_RASTERDIR_ILIC);
-      WlzNextInterval(iwsp++);
-    }
-    numactive = n;
-
-    /*
-     * find next line and left hand end of next interval of union
-     */
-    while (numactive > 0) {
-      /*
-       * find first remaining active object
-       */
-      iwsp = biwsp;
-      while( iwsp->linrmn < 0 ){
-	iwsp++;
-      }
-      /*
-       * find minimum line number of remaining active intervals
-       */
-      l = iwsp->linpos;
-      kol1 = iwsp->lftpos;
-      lastkl = iwsp->rgtpos;
-      for (iwsp++; iwsp<tiwsp; iwsp++)
-	if (iwsp->linrmn >= 0 && iwsp->linpos < l) {
-	  l = iwsp->linpos;
-	  kol1 = iwsp->lftpos;
-	  lastkl = iwsp->rgtpos;
-	}
-      /*
-       * find left-most interval in this line
-       */
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++)
-	if (iwsp->linrmn >= 0 && iwsp->linpos == l && iwsp->lftpos < kol1) {
-	  kol1 = iwsp->lftpos;
-	  lastkl = iwsp->rgtpos;
-	}
-      /*
-       * construct maximal interval with current left end-point
-       */
-      do {
-	change = 0;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	  while( iwsp->linrmn >= 0 && iwsp->linpos == l
-		&& iwsp->lftpos <= lastkl+1 ){
-	    if (iwsp->rgtpos > lastkl) {
-	      lastkl = iwsp->rgtpos;
-	      change = 1;
-	    }
-	    if (WlzNextInterval(iwsp) != WLZ_ERR_NONE) {
-	      numactive--;
-	    }
-	  }
-	}
-      } while (change == 1);
-      itvl->ileft = kol1 - idom->kol1;
-      itvl->iright = lastkl - idom->kol1;
-      if (l == lwas)
-	nints++;
-      else {
-	(void) WlzMakeInterval(lwas,idom,nints,jtvl);
-	for (j = lwas+1; j<l; j++) {
-	  (void) WlzMakeInterval(j,idom,0,NULL);
-	}
-	lwas = l;
-	nints = 1;
-	jtvl = itvl;
-      }
-      itvl++;
-    }
-    (void) WlzMakeInterval(lwas,idom,nints,jtvl);
-    for (j = lwas+1; j<=lastln; j++) {
-      (void) WlzMakeInterval(j,idom,0,NULL);
+    errNum = WlzUnionNIntervals(n, objs, idom, itvl);
+    if( errNum != WLZ_ERR_NONE ){
+      WlzFreeObj( obj );
+      AlcFree((void *) locbuffs);
+      AlcFree((void *) locbuff);
+      AlcFree((void *) biwsp);
+      obj = NULL;
     }
   }
 
@@ -585,3 +557,305 @@ WlzObject *WlzUnionN(
   }
   return( obj );
 }
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Restores the heap order of the given heap of cursor
+* 		indices below the given heap index. Cursors are ordered
+* 		by the first column of their next interval.
+* \param	cur			The cursors.
+* \param	heap			Heap of cursor indices.
+* \param	nHeap			Number of entries in the heap.
+* \param	idx			Heap index to sift down from.
+*/
+static void			WlzUnionNSift(
+				  WlzUnionNCursor *cur,
+				  int *heap,
+				  int nHeap,
+				  int idx)
+{
+  int		c,
+  		h;
+  WlzUnionNCursor *cH;
+
+  h = heap[idx];
+  cH = cur + h;
+  while((c = (2 * idx) + 1) < nHeap)
+  {
+    WlzUnionNCursor *cC;
+
+    cC = cur + heap[c];
+    if(c + 1 < nHeap)
+    {
+      WlzUnionNCursor *cD;
+
+      cD = cur + heap[c + 1];
+      if(cD->itv->ileft + cD->kol1 < cC->itv->ileft + cC->kol1)
+      {
+        ++c;
+	cC = cD;
+      }
+    }
+    if(cC->itv->ileft + cC->kol1 >= cH->itv->ileft + cH->kol1)
+    {
+      break;
+    }
+    heap[idx] = heap[c];
+    idx = c;
+  }
+  heap[idx] = h;
+}
+
+/*!
+* \return	Number of intervals in the union of the line.
+* \ingroup	WlzBinaryOps
+* \brief	Computes the union of a single line of the given objects
+* 		by a k-way merge of their intervals. Adjacent and
+* 		overlapping intervals are joined.
+* \param	nLnObj			Number of objects which cover the
+* 					line.
+* \param	lnObj			Indices of the objects which cover
+* 					the line.
+* \param	objs			The 2D domain objects.
+* \param	ln			The line.
+* \param	kol1			First column of the union domain.
+* \param	cur			Workspace for nLnObj cursors.
+* \param	heap			Workspace for nLnObj ints.
+* \param	dItv			Destination for the intervals of the
+* 					line with columns relative to kol1,
+* 					which must have space for the
+* 					number of intervals in the line
+* 					of all the objects.
+*/
+static int			WlzUnionNLine(
+				  int nLnObj,
+				  int *lnObj,
+				  WlzObject **objs,
+				  int ln,
+				  int kol1,
+				  WlzUnionNCursor *cur,
+				  int *heap,
+				  WlzInterval *dItv)
+{
+  int		i,
+		nD = 0,
+  		nHeap = 0;
+
+  for(i = 0; i < nLnObj; ++i)
+  {
+    WlzUnionNCursor *c;
+    WlzIntervalDomain *iDom;
+
+    c = cur + nHeap;
+    iDom = objs[lnObj[i]]->domain.i;
+    c->kol1 = iDom->kol1;
+    if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      c->nItv = 1;
+      c->rItv.ileft = 0;
+      c->rItv.iright = iDom->lastkl - iDom->kol1;
+      c->itv = &(c->rItv);
+    }
+    else
+    {
+      WlzIntervalLine *iLn;
+
+      iLn = iDom->intvlines + ln - iDom->line1;
+      c->nItv = iLn->nintvs;
+      c->itv = iLn->intvs;
+    }
+    if(c->nItv > 0)
+    {
+      heap[nHeap] = nHeap;
+      ++nHeap;
+    }
+  }
+  for(i = (nHeap / 2) - 1; i >= 0; --i)
+  {
+    WlzUnionNSift(cur, heap, nHeap, i);
+  }
+  while(nHeap > 0)
+  {
+    int		lft,
+    		rgt;
+    WlzUnionNCursor *c;
+
+    c = cur + heap[0];
+    lft = c->itv->ileft + c->kol1 - kol1;
+    rgt = c->itv->iright + c->kol1 - kol1;
+    if((nD > 0) && (lft <= dItv[nD - 1].iright + 1))
+    {
+      if(rgt > dItv[nD - 1].iright)
+      {
+        dItv[nD - 1].iright = rgt;
+      }
+    }
+    else
+    {
+      dItv[nD].ileft = lft;
+      dItv[nD].iright = rgt;
+      ++nD;
+    }
+    ++(c->itv);
+    if(--(c->nItv) == 0)
+    {
+      heap[0] = heap[--nHeap];
+    }
+    if(nHeap > 1)
+    {
+      WlzUnionNSift(cur, heap, nHeap, 0);
+    }
+  }
+  return(nD);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Sets the intervals of the given union interval domain
+* 		from the union of the given objects. Space for the
+* 		intervals of each line is reserved in the given interval
+* 		buffer using the number of intervals in the line of all
+* 		the objects, so that the lines may be merged concurrently
+* 		without further allocation. The objects which cover each
+* 		line are listed first, so that the cost of merging a line
+* 		does not depend on the total number of objects.
+* \param	n			Number of objects.
+* \param	objs			The non-empty 2D domain objects.
+* \param	uDom			The union interval domain with it's
+* 					line and column bounds set.
+* \param	uItv			Interval buffer with space for all
+* 					the intervals of the objects.
+*/
+static WlzErrorNum		WlzUnionNIntervals(
+				  int n,
+				  WlzObject **objs,
+				  WlzIntervalDomain *uDom,
+				  WlzInterval *uItv)
+{
+  int		i,
+  		nLn;
+  int		*lnOff = NULL,
+  		*lnCnt = NULL,
+		*lnObjOff = NULL,
+		*lnObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nLn = uDom->lastln - uDom->line1 + 1;
+  if((lnOff = (int *)AlcCalloc((3 * nLn) + 2, sizeof(int))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    lnCnt = lnOff + nLn + 1;
+    lnObjOff = lnCnt + nLn;
+    for(i = 0; (i < n) && (errNum == WLZ_ERR_NONE); ++i)
+    {
+      int	l,
+      		o;
+      WlzIntervalDomain *iDom;
+
+      iDom = objs[i]->domain.i;
+      o = iDom->line1 - uDom->line1 + 1;
+      switch(iDom->type)
+      {
+        case WLZ_INTERVALDOMAIN_INTVL:
+	  for(l = 0; l <= iDom->lastln - iDom->line1; ++l)
+	  {
+	    lnOff[o + l] += iDom->intvlines[l].nintvs;
+	    lnObjOff[o + l] += 1;
+	  }
+	  break;
+	case WLZ_INTERVALDOMAIN_RECT:
+	  for(l = 0; l <= iDom->lastln - iDom->line1; ++l)
+	  {
+	    lnOff[o + l] += 1;
+	    lnObjOff[o + l] += 1;
+	  }
+	  break;
+	default:
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	  break;
+      }
+    }
+    for(i = 0; i < nLn; ++i)
+    {
+      lnOff[i + 1] += lnOff[i];
+      lnObjOff[i + 1] += lnObjOff[i];
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((lnObj = (int *)AlcMalloc((lnObjOff[nLn] + 1) * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      /* List the objects which cover each line, using the line counts
+       * as fill positions until the lines are merged. */
+      for(i = 0; i < n; ++i)
+      {
+	int	l,
+		o;
+	WlzIntervalDomain *iDom;
+
+	iDom = objs[i]->domain.i;
+	o = iDom->line1 - uDom->line1;
+	for(l = 0; l <= iDom->lastln - iDom->line1; ++l)
+	{
+	  lnObj[lnObjOff[o + l] + lnCnt[o + l]++] = i;
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      int	idL;
+      int	*heap = NULL;
+      WlzUnionNCursor *cur = NULL;
+      WlzErrorNum errT = WLZ_ERR_NONE;
+
+      if(((cur = (WlzUnionNCursor *)
+                 AlcMalloc(n * sizeof(WlzUnionNCursor))) == NULL) ||
+         ((heap = (int *)AlcMalloc(n * sizeof(int))) == NULL))
+      {
+        errT = WLZ_ERR_MEM_ALLOC;
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+      for(idL = 0; idL < nLn; ++idL)
+      {
+	if(errT == WLZ_ERR_NONE)
+	{
+	  lnCnt[idL] = WlzUnionNLine(lnCnt[idL], lnObj + lnObjOff[idL], objs,
+				     uDom->line1 + idL, uDom->kol1,
+				     cur, heap, uItv + lnOff[idL]);
+	}
+      }
+      AlcFree(cur);
+      AlcFree(heap);
+      if(errT != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzUnionNIntervals)
+#endif
+	errNum = errT;
+      }
+    }
+  }
+  for(i = 0; (i < nLn) && (errNum == WLZ_ERR_NONE); ++i)
+  {
+    errNum = WlzMakeInterval(uDom->line1 + i, uDom, lnCnt[i],
+			     (lnCnt[i] > 0)? uItv + lnOff[i]: NULL);
+  }
+  AlcFree(lnObj);
+  AlcFree(lnOff);
+  return(errNum);
+}
@@ -2177,14 +2177,17 @@ static WlzDVertex2 WlzVerticesNormTriple2(WlzDVertex2 vA, WlzDVertex2 vB,
 /*!
 * \ingroup      WlzFeatures
 * \return				Woolz error code
-* \brief	Allocates and populates a k-D tree from the given vertices.
+* \brief	Allocates and populates a balanced k-D tree from the given
+* 		vertices using AlcKDTTreeBuild().
 * 		The vertices are either WlzDVertex2 orWlzDVertex3
+* 		and the index of each node in the tree is the index
+* 		of it's vertex.
 * \param	vType 			Type of vertices.
 * \param	nV 			Number of vertices.
 * \param	vtx 			The vertices.
-* \param	shfBuf			Workspace with at least nV ints
-*					used to shuffle vertices for
-*					randomized input to the K-D tree.
+* \param	shfBuf			Unused workspace, previously used
+*					to shuffle the vertices, may be
+*					NULL.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -2193,12 +2196,9 @@ AlcKDTTree	*WlzVerticesBuildTree(WlzVertexType vType, int nV,
 				      WlzErrorNum *dstErr)
 {
   int		idx,
-		sIdx,
   		treeDim;
-  double	datD[3];
+  double	*datD = NULL;
   AlcKDTTree	*tree = NULL;
-  AlcKDTNode	*node = NULL;
-  WlzVertexP	tVP;
   AlcErrno	alcErr = ALC_ER_NONE;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -2214,68 +2214,44 @@ AlcKDTTree	*WlzVerticesBuildTree(WlzVertexType vType, int nV,
       errNum = WLZ_ERR_PARAM_TYPE;
       break;
   }
-  /* Create tree. */
   if(errNum == WLZ_ERR_NONE)
   {
-    if((tree = AlcKDTTreeNew(ALC_POINTTYPE_DBL, treeDim, -1.0, nV,
-				   NULL)) == NULL)
+    if((datD = (double *)AlcMalloc(sizeof(double) * treeDim *
+                                   ((nV > 0)? nV: 1))) == NULL)
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
+  /* Pack the vertex coordinates and build the tree from them. */
   if(errNum == WLZ_ERR_NONE)
   {
-    (void )AlgShuffleIdx(nV, shfBuf, 0);
-  }
-  /* Populate tree using a shuffle index to get the behaviour of a randomized
-   * k-D tree, making sure that the indicies of nodes of the tree are not
-   * shuffled too. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    idx = 0;
-    switch(vType)
+    if(vType == WLZ_VERTEX_D2)
     {
-      case WLZ_VERTEX_D2:
-	while((alcErr == ALC_ER_NONE) && (idx < nV))
-	{
-	  sIdx = *(shfBuf + idx);
-	  tVP.d2 = (vtx.d2 + sIdx);
-	  datD[0] = tVP.d2->vtX;
-	  datD[1] = tVP.d2->vtY;
-	  if((node = AlcKDTInsert(tree, datD, NULL, &alcErr)) != NULL)
-	  {
-	    node->idx = sIdx;
-	  }
-	  ++idx;
-	}
-	break;
-      case WLZ_VERTEX_D3:
-	while((alcErr == ALC_ER_NONE) && (idx < nV))
-	{
-	  sIdx = *(shfBuf + idx);
-	  tVP.d3 = (vtx.d3 + sIdx);
-	  datD[0] = tVP.d3->vtX;
-	  datD[1] = tVP.d3->vtY;
-	  datD[2] = tVP.d3->vtZ;
-	  if((node = AlcKDTInsert(tree, datD, NULL, &alcErr)) != NULL)
-	  {
-	    node->idx = sIdx;
-	  }
-	  ++idx;
-	}
-	break;
-      default:
-	errNum = WLZ_ERR_PARAM_TYPE;
-        break;
+      for(idx = 0; idx < nV; ++idx)
+      {
+        *(datD + (2 * idx)) = (vtx.d2 + idx)->vtX;
+        *(datD + (2 * idx) + 1) = (vtx.d2 + idx)->vtY;
+      }
     }
-    if(dstErr)
+    else /* vType == WLZ_VERTEX_D3 */
     {
-      if(alcErr != ALC_ER_NONE)
+      for(idx = 0; idx < nV; ++idx)
       {
-	errNum = WLZ_ERR_MEM_ALLOC;
+        *(datD + (3 * idx)) = (vtx.d3 + idx)->vtX;
+        *(datD + (3 * idx) + 1) = (vtx.d3 + idx)->vtY;
+        *(datD + (3 * idx) + 2) = (vtx.d3 + idx)->vtZ;
       }
-      *dstErr = errNum;
     }
+    if((tree = AlcKDTTreeBuild(ALC_POINTTYPE_DBL, treeDim, -1.0, nV, datD,
+    			       &alcErr)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  AlcFree(datD);
+  if(dstErr)
+  {
+    *dstErr = errNum;
   }
   return(tree);
 }
@@ -70,6 +70,11 @@ static WlzErrorNum		WlzWriteValueTable(
 static WlzErrorNum		WlzWriteVoxelValueTable(
 				  FILE *fP,
 				  WlzObject *obj);
+static WlzErrorNum		WlzWriteCompressedTiles(
+				  FILE *fP,
+				  WlzTiledValues *tVal,
+				  size_t gSz,
+				  long tMrk);
 static WlzErrorNum		WlzWriteTiledValueTable(
 				  FILE *fP,
 				  WlzObject *obj,
@@ -3349,7 +3354,8 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    putc(tVal->dim, fP);
+    /* The tile codec is encoded in the upper bits of the dimension. */
+    putc(tVal->dim | (tVal->codec << 4), fP);
     putword(tVal->kol1, fP);
     putword(tVal->lastkl, fP);
     putword(tVal->line1, fP);
@@ -3399,13 +3405,41 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
 
     gSz = WlzGreySize(gType);
     tSz = tVal->numTiles * tVal->tileSz;
-    if(tVal->tiles.v != NULL)
+    if(tVal->codec != WLZ_TILED_CODEC_NONE)
+    {
+      errNum = WlzWriteCompressedTiles(fP, tVal, gSz, tMrk);
+    }
+    else if(tVal->tiles.v != NULL)
     {
       if(fwrite(tVal->tiles.v, gSz, tSz, fP) != tSz)
       {
         errNum = WLZ_ERR_WRITE_INCOMPLETE;
       }
     }
+    else if(tVal->cache != NULL)
+    {
+      size_t	idx;
+      void	*buf;
+
+      /* Tiles are accessed through a tile cache so copy them to the
+       * file one at a time. */
+      if((buf = AlcMalloc(tVal->cache->tileBytes)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+      {
+        errNum = WlzTiledValueCacheAccess(tVal->cache, idx, 0,
+					  tVal->cache->tileBytes, buf, 0);
+	if((errNum == WLZ_ERR_NONE) &&
+	   (fwrite(buf, 1, tVal->cache->tileBytes, fP) !=
+	    tVal->cache->tileBytes))
+	{
+	  errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	}
+      }
+      AlcFree(buf);
+    }
     else if(writeTiles != 0)
     {
       /* No tile data so reserve tile space in the file by seeking
@@ -3471,6 +3505,109 @@ static WlzErrorNum WlzWriteTiledValueTable(FILE *fP, WlzObject *obj,
   return(errNum);
 }
 
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Compresses and writes all the tiles of a tiled value table.
+* 		The tiles start with a table of the numTiles + 1 offsets
+* 		(each a pair of words) of the compressed tiles relative to
+* 		the tile offset, this is followed by the compressed tiles.
+* 		Tiles are taken from memory, the tile cache or if neither
+* 		are available are written as zero tiles.
+* \param	fP			Given file pointer which is known
+* 					to be positioned at the tile offset.
+* \param	tVal			Tiled value table with a codec.
+* \param	gSz			Size of the grey values in bytes.
+* \param	tMrk			The tile offset.
+*/
+static WlzErrorNum WlzWriteCompressedTiles(FILE *fP, WlzTiledValues *tVal,
+					   size_t gSz, long tMrk)
+{
+  size_t	idx,
+  		tBytes;
+  long		*tOff = NULL;
+  WlzUByte	*sBuf = NULL,
+  		*dBuf = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tBytes = tVal->tileSz * gSz;
+  if(((tOff = (long *)AlcMalloc((tVal->numTiles + 1) *
+                                sizeof(long))) == NULL) ||
+     ((sBuf = (WlzUByte *)AlcCalloc(tBytes, 1)) == NULL) ||
+     ((dBuf = (WlzUByte *)AlcMalloc(tBytes)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    /* Reserve space for the offsets table. */
+    tOff[0] = 8 * (tVal->numTiles + 1);
+    if(fseek(fP, tMrk + tOff[0], SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < tVal->numTiles); ++idx)
+  {
+    size_t	cSz;
+    WlzUByte	*tP;
+
+    tP = sBuf;
+    if(tVal->tiles.v != NULL)
+    {
+      tP = tVal->tiles.ubp + (idx * tBytes);
+    }
+    else if(tVal->cache != NULL)
+    {
+      errNum = WlzTiledValueCacheAccess(tVal->cache, idx, 0, tBytes,
+      					sBuf, 0);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTiledValueTileEncode(tVal->codec, gSz, tBytes, tP,
+				       dBuf, &cSz);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(fwrite(dBuf, 1, cSz, fP) != cSz)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      tOff[idx + 1] = tOff[idx] + cSz;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fseek(fP, tMrk, SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx <= tVal->numTiles); ++idx)
+    {
+      WlzLong	off;
+
+      off = tOff[idx];
+      if((putword((unsigned int )(off & 0xffffffff), fP) != 4) ||
+         (putword((unsigned int )((sizeof(long) > 4)? off >> 32: 0),
+	          fP) != 4))
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fseek(fP, tMrk + tOff[tVal->numTiles], SEEK_SET) != 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  AlcFree(tOff);
+  AlcFree(sBuf);
+  AlcFree(dBuf);
+  return(errNum);
+}
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO